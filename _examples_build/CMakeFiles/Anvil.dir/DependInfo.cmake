@@ -0,0 +1,108 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/misc/base_pipeline_create_info.cpp" "CMakeFiles/Anvil.dir/src/misc/base_pipeline_create_info.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/misc/base_pipeline_create_info.cpp.o.d"
+  "/root/repo/src/misc/base_pipeline_manager.cpp" "CMakeFiles/Anvil.dir/src/misc/base_pipeline_manager.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/misc/base_pipeline_manager.cpp.o.d"
+  "/root/repo/src/misc/buffer_create_info.cpp" "CMakeFiles/Anvil.dir/src/misc/buffer_create_info.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/misc/buffer_create_info.cpp.o.d"
+  "/root/repo/src/misc/buffer_ring_allocator.cpp" "CMakeFiles/Anvil.dir/src/misc/buffer_ring_allocator.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/misc/buffer_ring_allocator.cpp.o.d"
+  "/root/repo/src/misc/buffer_view_create_info.cpp" "CMakeFiles/Anvil.dir/src/misc/buffer_view_create_info.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/misc/buffer_view_create_info.cpp.o.d"
+  "/root/repo/src/misc/command_stream.cpp" "CMakeFiles/Anvil.dir/src/misc/command_stream.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/misc/command_stream.cpp.o.d"
+  "/root/repo/src/misc/compute_pipeline_create_info.cpp" "CMakeFiles/Anvil.dir/src/misc/compute_pipeline_create_info.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/misc/compute_pipeline_create_info.cpp.o.d"
+  "/root/repo/src/misc/debug.cpp" "CMakeFiles/Anvil.dir/src/misc/debug.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/misc/debug.cpp.o.d"
+  "/root/repo/src/misc/debug_marker.cpp" "CMakeFiles/Anvil.dir/src/misc/debug_marker.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/misc/debug_marker.cpp.o.d"
+  "/root/repo/src/misc/debug_messenger_create_info.cpp" "CMakeFiles/Anvil.dir/src/misc/debug_messenger_create_info.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/misc/debug_messenger_create_info.cpp.o.d"
+  "/root/repo/src/misc/descriptor_set_create_info.cpp" "CMakeFiles/Anvil.dir/src/misc/descriptor_set_create_info.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/misc/descriptor_set_create_info.cpp.o.d"
+  "/root/repo/src/misc/dummy_window.cpp" "CMakeFiles/Anvil.dir/src/misc/dummy_window.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/misc/dummy_window.cpp.o.d"
+  "/root/repo/src/misc/event_create_info.cpp" "CMakeFiles/Anvil.dir/src/misc/event_create_info.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/misc/event_create_info.cpp.o.d"
+  "/root/repo/src/misc/external_handle.cpp" "CMakeFiles/Anvil.dir/src/misc/external_handle.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/misc/external_handle.cpp.o.d"
+  "/root/repo/src/misc/fence_create_info.cpp" "CMakeFiles/Anvil.dir/src/misc/fence_create_info.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/misc/fence_create_info.cpp.o.d"
+  "/root/repo/src/misc/fence_pool.cpp" "CMakeFiles/Anvil.dir/src/misc/fence_pool.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/misc/fence_pool.cpp.o.d"
+  "/root/repo/src/misc/formats.cpp" "CMakeFiles/Anvil.dir/src/misc/formats.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/misc/formats.cpp.o.d"
+  "/root/repo/src/misc/fp16.cpp" "CMakeFiles/Anvil.dir/src/misc/fp16.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/misc/fp16.cpp.o.d"
+  "/root/repo/src/misc/frame_context.cpp" "CMakeFiles/Anvil.dir/src/misc/frame_context.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/misc/frame_context.cpp.o.d"
+  "/root/repo/src/misc/frame_graph.cpp" "CMakeFiles/Anvil.dir/src/misc/frame_graph.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/misc/frame_graph.cpp.o.d"
+  "/root/repo/src/misc/framebuffer_create_info.cpp" "CMakeFiles/Anvil.dir/src/misc/framebuffer_create_info.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/misc/framebuffer_create_info.cpp.o.d"
+  "/root/repo/src/misc/glsl_to_spirv.cpp" "CMakeFiles/Anvil.dir/src/misc/glsl_to_spirv.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/misc/glsl_to_spirv.cpp.o.d"
+  "/root/repo/src/misc/graphics_pipeline_create_info.cpp" "CMakeFiles/Anvil.dir/src/misc/graphics_pipeline_create_info.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/misc/graphics_pipeline_create_info.cpp.o.d"
+  "/root/repo/src/misc/image_create_info.cpp" "CMakeFiles/Anvil.dir/src/misc/image_create_info.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/misc/image_create_info.cpp.o.d"
+  "/root/repo/src/misc/image_view_create_info.cpp" "CMakeFiles/Anvil.dir/src/misc/image_view_create_info.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/misc/image_view_create_info.cpp.o.d"
+  "/root/repo/src/misc/io.cpp" "CMakeFiles/Anvil.dir/src/misc/io.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/misc/io.cpp.o.d"
+  "/root/repo/src/misc/library.cpp" "CMakeFiles/Anvil.dir/src/misc/library.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/misc/library.cpp.o.d"
+  "/root/repo/src/misc/memalloc_backends/backend_oneshot.cpp" "CMakeFiles/Anvil.dir/src/misc/memalloc_backends/backend_oneshot.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/misc/memalloc_backends/backend_oneshot.cpp.o.d"
+  "/root/repo/src/misc/memalloc_backends/backend_tlsf.cpp" "CMakeFiles/Anvil.dir/src/misc/memalloc_backends/backend_tlsf.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/misc/memalloc_backends/backend_tlsf.cpp.o.d"
+  "/root/repo/src/misc/memalloc_backends/backend_vma.cpp" "CMakeFiles/Anvil.dir/src/misc/memalloc_backends/backend_vma.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/misc/memalloc_backends/backend_vma.cpp.o.d"
+  "/root/repo/src/misc/memory_allocator.cpp" "CMakeFiles/Anvil.dir/src/misc/memory_allocator.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/misc/memory_allocator.cpp.o.d"
+  "/root/repo/src/misc/memory_block_create_info.cpp" "CMakeFiles/Anvil.dir/src/misc/memory_block_create_info.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/misc/memory_block_create_info.cpp.o.d"
+  "/root/repo/src/misc/object_tracker.cpp" "CMakeFiles/Anvil.dir/src/misc/object_tracker.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/misc/object_tracker.cpp.o.d"
+  "/root/repo/src/misc/page_tracker.cpp" "CMakeFiles/Anvil.dir/src/misc/page_tracker.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/misc/page_tracker.cpp.o.d"
+  "/root/repo/src/misc/parallel_command_buffer_recorder.cpp" "CMakeFiles/Anvil.dir/src/misc/parallel_command_buffer_recorder.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/misc/parallel_command_buffer_recorder.cpp.o.d"
+  "/root/repo/src/misc/pools.cpp" "CMakeFiles/Anvil.dir/src/misc/pools.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/misc/pools.cpp.o.d"
+  "/root/repo/src/misc/render_pass_create_info.cpp" "CMakeFiles/Anvil.dir/src/misc/render_pass_create_info.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/misc/render_pass_create_info.cpp.o.d"
+  "/root/repo/src/misc/resource_state_tracker.cpp" "CMakeFiles/Anvil.dir/src/misc/resource_state_tracker.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/misc/resource_state_tracker.cpp.o.d"
+  "/root/repo/src/misc/sampler_create_info.cpp" "CMakeFiles/Anvil.dir/src/misc/sampler_create_info.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/misc/sampler_create_info.cpp.o.d"
+  "/root/repo/src/misc/semaphore_create_info.cpp" "CMakeFiles/Anvil.dir/src/misc/semaphore_create_info.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/misc/semaphore_create_info.cpp.o.d"
+  "/root/repo/src/misc/shader_module_cache.cpp" "CMakeFiles/Anvil.dir/src/misc/shader_module_cache.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/misc/shader_module_cache.cpp.o.d"
+  "/root/repo/src/misc/sparse_memory_binding_accumulator.cpp" "CMakeFiles/Anvil.dir/src/misc/sparse_memory_binding_accumulator.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/misc/sparse_memory_binding_accumulator.cpp.o.d"
+  "/root/repo/src/misc/sparse_texture_streamer.cpp" "CMakeFiles/Anvil.dir/src/misc/sparse_texture_streamer.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/misc/sparse_texture_streamer.cpp.o.d"
+  "/root/repo/src/misc/staging_ring.cpp" "CMakeFiles/Anvil.dir/src/misc/staging_ring.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/misc/staging_ring.cpp.o.d"
+  "/root/repo/src/misc/swapchain_create_info.cpp" "CMakeFiles/Anvil.dir/src/misc/swapchain_create_info.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/misc/swapchain_create_info.cpp.o.d"
+  "/root/repo/src/misc/time.cpp" "CMakeFiles/Anvil.dir/src/misc/time.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/misc/time.cpp.o.d"
+  "/root/repo/src/misc/types.cpp" "CMakeFiles/Anvil.dir/src/misc/types.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/misc/types.cpp.o.d"
+  "/root/repo/src/misc/types_classes.cpp" "CMakeFiles/Anvil.dir/src/misc/types_classes.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/misc/types_classes.cpp.o.d"
+  "/root/repo/src/misc/types_struct.cpp" "CMakeFiles/Anvil.dir/src/misc/types_struct.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/misc/types_struct.cpp.o.d"
+  "/root/repo/src/misc/types_utils.cpp" "CMakeFiles/Anvil.dir/src/misc/types_utils.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/misc/types_utils.cpp.o.d"
+  "/root/repo/src/misc/vulkan.cpp" "CMakeFiles/Anvil.dir/src/misc/vulkan.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/misc/vulkan.cpp.o.d"
+  "/root/repo/src/misc/window.cpp" "CMakeFiles/Anvil.dir/src/misc/window.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/misc/window.cpp.o.d"
+  "/root/repo/src/misc/window_factory.cpp" "CMakeFiles/Anvil.dir/src/misc/window_factory.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/misc/window_factory.cpp.o.d"
+  "/root/repo/src/wrappers/buffer.cpp" "CMakeFiles/Anvil.dir/src/wrappers/buffer.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/wrappers/buffer.cpp.o.d"
+  "/root/repo/src/wrappers/buffer_view.cpp" "CMakeFiles/Anvil.dir/src/wrappers/buffer_view.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/wrappers/buffer_view.cpp.o.d"
+  "/root/repo/src/wrappers/command_buffer.cpp" "CMakeFiles/Anvil.dir/src/wrappers/command_buffer.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/wrappers/command_buffer.cpp.o.d"
+  "/root/repo/src/wrappers/command_pool.cpp" "CMakeFiles/Anvil.dir/src/wrappers/command_pool.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/wrappers/command_pool.cpp.o.d"
+  "/root/repo/src/wrappers/compute_pipeline_manager.cpp" "CMakeFiles/Anvil.dir/src/wrappers/compute_pipeline_manager.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/wrappers/compute_pipeline_manager.cpp.o.d"
+  "/root/repo/src/wrappers/debug_messenger.cpp" "CMakeFiles/Anvil.dir/src/wrappers/debug_messenger.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/wrappers/debug_messenger.cpp.o.d"
+  "/root/repo/src/wrappers/descriptor_pool.cpp" "CMakeFiles/Anvil.dir/src/wrappers/descriptor_pool.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/wrappers/descriptor_pool.cpp.o.d"
+  "/root/repo/src/wrappers/descriptor_set.cpp" "CMakeFiles/Anvil.dir/src/wrappers/descriptor_set.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/wrappers/descriptor_set.cpp.o.d"
+  "/root/repo/src/wrappers/descriptor_set_group.cpp" "CMakeFiles/Anvil.dir/src/wrappers/descriptor_set_group.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/wrappers/descriptor_set_group.cpp.o.d"
+  "/root/repo/src/wrappers/descriptor_set_layout.cpp" "CMakeFiles/Anvil.dir/src/wrappers/descriptor_set_layout.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/wrappers/descriptor_set_layout.cpp.o.d"
+  "/root/repo/src/wrappers/descriptor_set_layout_manager.cpp" "CMakeFiles/Anvil.dir/src/wrappers/descriptor_set_layout_manager.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/wrappers/descriptor_set_layout_manager.cpp.o.d"
+  "/root/repo/src/wrappers/descriptor_update_template.cpp" "CMakeFiles/Anvil.dir/src/wrappers/descriptor_update_template.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/wrappers/descriptor_update_template.cpp.o.d"
+  "/root/repo/src/wrappers/device.cpp" "CMakeFiles/Anvil.dir/src/wrappers/device.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/wrappers/device.cpp.o.d"
+  "/root/repo/src/wrappers/event.cpp" "CMakeFiles/Anvil.dir/src/wrappers/event.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/wrappers/event.cpp.o.d"
+  "/root/repo/src/wrappers/fence.cpp" "CMakeFiles/Anvil.dir/src/wrappers/fence.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/wrappers/fence.cpp.o.d"
+  "/root/repo/src/wrappers/framebuffer.cpp" "CMakeFiles/Anvil.dir/src/wrappers/framebuffer.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/wrappers/framebuffer.cpp.o.d"
+  "/root/repo/src/wrappers/graphics_pipeline_manager.cpp" "CMakeFiles/Anvil.dir/src/wrappers/graphics_pipeline_manager.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/wrappers/graphics_pipeline_manager.cpp.o.d"
+  "/root/repo/src/wrappers/image.cpp" "CMakeFiles/Anvil.dir/src/wrappers/image.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/wrappers/image.cpp.o.d"
+  "/root/repo/src/wrappers/image_view.cpp" "CMakeFiles/Anvil.dir/src/wrappers/image_view.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/wrappers/image_view.cpp.o.d"
+  "/root/repo/src/wrappers/instance.cpp" "CMakeFiles/Anvil.dir/src/wrappers/instance.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/wrappers/instance.cpp.o.d"
+  "/root/repo/src/wrappers/memory_block.cpp" "CMakeFiles/Anvil.dir/src/wrappers/memory_block.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/wrappers/memory_block.cpp.o.d"
+  "/root/repo/src/wrappers/physical_device.cpp" "CMakeFiles/Anvil.dir/src/wrappers/physical_device.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/wrappers/physical_device.cpp.o.d"
+  "/root/repo/src/wrappers/pipeline_cache.cpp" "CMakeFiles/Anvil.dir/src/wrappers/pipeline_cache.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/wrappers/pipeline_cache.cpp.o.d"
+  "/root/repo/src/wrappers/pipeline_layout.cpp" "CMakeFiles/Anvil.dir/src/wrappers/pipeline_layout.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/wrappers/pipeline_layout.cpp.o.d"
+  "/root/repo/src/wrappers/pipeline_layout_manager.cpp" "CMakeFiles/Anvil.dir/src/wrappers/pipeline_layout_manager.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/wrappers/pipeline_layout_manager.cpp.o.d"
+  "/root/repo/src/wrappers/query_pool.cpp" "CMakeFiles/Anvil.dir/src/wrappers/query_pool.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/wrappers/query_pool.cpp.o.d"
+  "/root/repo/src/wrappers/queue.cpp" "CMakeFiles/Anvil.dir/src/wrappers/queue.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/wrappers/queue.cpp.o.d"
+  "/root/repo/src/wrappers/render_pass.cpp" "CMakeFiles/Anvil.dir/src/wrappers/render_pass.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/wrappers/render_pass.cpp.o.d"
+  "/root/repo/src/wrappers/rendering_surface.cpp" "CMakeFiles/Anvil.dir/src/wrappers/rendering_surface.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/wrappers/rendering_surface.cpp.o.d"
+  "/root/repo/src/wrappers/sampler.cpp" "CMakeFiles/Anvil.dir/src/wrappers/sampler.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/wrappers/sampler.cpp.o.d"
+  "/root/repo/src/wrappers/semaphore.cpp" "CMakeFiles/Anvil.dir/src/wrappers/semaphore.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/wrappers/semaphore.cpp.o.d"
+  "/root/repo/src/wrappers/shader_module.cpp" "CMakeFiles/Anvil.dir/src/wrappers/shader_module.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/wrappers/shader_module.cpp.o.d"
+  "/root/repo/src/wrappers/swapchain.cpp" "CMakeFiles/Anvil.dir/src/wrappers/swapchain.cpp.o" "gcc" "CMakeFiles/Anvil.dir/src/wrappers/swapchain.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_examples_build/deps/glslang/glslang/CMakeFiles/glslang.dir/DependInfo.cmake"
+  "/root/repo/_examples_build/deps/glslang/OGLCompilersDLL/CMakeFiles/OGLCompiler.dir/DependInfo.cmake"
+  "/root/repo/_examples_build/deps/glslang/glslang/OSDependent/Unix/CMakeFiles/OSDependent.dir/DependInfo.cmake"
+  "/root/repo/_examples_build/deps/glslang/SPIRV/CMakeFiles/SPIRV.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,181 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/Anvil.dir/src/misc/base_pipeline_create_info.cpp.o"
+  "CMakeFiles/Anvil.dir/src/misc/base_pipeline_create_info.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/misc/base_pipeline_manager.cpp.o"
+  "CMakeFiles/Anvil.dir/src/misc/base_pipeline_manager.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/misc/buffer_create_info.cpp.o"
+  "CMakeFiles/Anvil.dir/src/misc/buffer_create_info.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/misc/buffer_ring_allocator.cpp.o"
+  "CMakeFiles/Anvil.dir/src/misc/buffer_ring_allocator.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/misc/buffer_view_create_info.cpp.o"
+  "CMakeFiles/Anvil.dir/src/misc/buffer_view_create_info.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/misc/command_stream.cpp.o"
+  "CMakeFiles/Anvil.dir/src/misc/command_stream.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/misc/compute_pipeline_create_info.cpp.o"
+  "CMakeFiles/Anvil.dir/src/misc/compute_pipeline_create_info.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/misc/debug.cpp.o"
+  "CMakeFiles/Anvil.dir/src/misc/debug.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/misc/debug_marker.cpp.o"
+  "CMakeFiles/Anvil.dir/src/misc/debug_marker.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/misc/debug_messenger_create_info.cpp.o"
+  "CMakeFiles/Anvil.dir/src/misc/debug_messenger_create_info.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/misc/descriptor_set_create_info.cpp.o"
+  "CMakeFiles/Anvil.dir/src/misc/descriptor_set_create_info.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/misc/dummy_window.cpp.o"
+  "CMakeFiles/Anvil.dir/src/misc/dummy_window.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/misc/event_create_info.cpp.o"
+  "CMakeFiles/Anvil.dir/src/misc/event_create_info.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/misc/external_handle.cpp.o"
+  "CMakeFiles/Anvil.dir/src/misc/external_handle.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/misc/fence_create_info.cpp.o"
+  "CMakeFiles/Anvil.dir/src/misc/fence_create_info.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/misc/fence_pool.cpp.o"
+  "CMakeFiles/Anvil.dir/src/misc/fence_pool.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/misc/formats.cpp.o"
+  "CMakeFiles/Anvil.dir/src/misc/formats.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/misc/fp16.cpp.o"
+  "CMakeFiles/Anvil.dir/src/misc/fp16.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/misc/frame_context.cpp.o"
+  "CMakeFiles/Anvil.dir/src/misc/frame_context.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/misc/frame_graph.cpp.o"
+  "CMakeFiles/Anvil.dir/src/misc/frame_graph.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/misc/framebuffer_create_info.cpp.o"
+  "CMakeFiles/Anvil.dir/src/misc/framebuffer_create_info.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/misc/glsl_to_spirv.cpp.o"
+  "CMakeFiles/Anvil.dir/src/misc/glsl_to_spirv.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/misc/graphics_pipeline_create_info.cpp.o"
+  "CMakeFiles/Anvil.dir/src/misc/graphics_pipeline_create_info.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/misc/image_create_info.cpp.o"
+  "CMakeFiles/Anvil.dir/src/misc/image_create_info.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/misc/image_view_create_info.cpp.o"
+  "CMakeFiles/Anvil.dir/src/misc/image_view_create_info.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/misc/io.cpp.o"
+  "CMakeFiles/Anvil.dir/src/misc/io.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/misc/library.cpp.o"
+  "CMakeFiles/Anvil.dir/src/misc/library.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/misc/memalloc_backends/backend_oneshot.cpp.o"
+  "CMakeFiles/Anvil.dir/src/misc/memalloc_backends/backend_oneshot.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/misc/memalloc_backends/backend_tlsf.cpp.o"
+  "CMakeFiles/Anvil.dir/src/misc/memalloc_backends/backend_tlsf.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/misc/memalloc_backends/backend_vma.cpp.o"
+  "CMakeFiles/Anvil.dir/src/misc/memalloc_backends/backend_vma.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/misc/memory_allocator.cpp.o"
+  "CMakeFiles/Anvil.dir/src/misc/memory_allocator.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/misc/memory_block_create_info.cpp.o"
+  "CMakeFiles/Anvil.dir/src/misc/memory_block_create_info.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/misc/object_tracker.cpp.o"
+  "CMakeFiles/Anvil.dir/src/misc/object_tracker.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/misc/page_tracker.cpp.o"
+  "CMakeFiles/Anvil.dir/src/misc/page_tracker.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/misc/parallel_command_buffer_recorder.cpp.o"
+  "CMakeFiles/Anvil.dir/src/misc/parallel_command_buffer_recorder.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/misc/pools.cpp.o"
+  "CMakeFiles/Anvil.dir/src/misc/pools.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/misc/render_pass_create_info.cpp.o"
+  "CMakeFiles/Anvil.dir/src/misc/render_pass_create_info.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/misc/resource_state_tracker.cpp.o"
+  "CMakeFiles/Anvil.dir/src/misc/resource_state_tracker.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/misc/sampler_create_info.cpp.o"
+  "CMakeFiles/Anvil.dir/src/misc/sampler_create_info.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/misc/semaphore_create_info.cpp.o"
+  "CMakeFiles/Anvil.dir/src/misc/semaphore_create_info.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/misc/shader_module_cache.cpp.o"
+  "CMakeFiles/Anvil.dir/src/misc/shader_module_cache.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/misc/sparse_memory_binding_accumulator.cpp.o"
+  "CMakeFiles/Anvil.dir/src/misc/sparse_memory_binding_accumulator.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/misc/sparse_texture_streamer.cpp.o"
+  "CMakeFiles/Anvil.dir/src/misc/sparse_texture_streamer.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/misc/staging_ring.cpp.o"
+  "CMakeFiles/Anvil.dir/src/misc/staging_ring.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/misc/swapchain_create_info.cpp.o"
+  "CMakeFiles/Anvil.dir/src/misc/swapchain_create_info.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/misc/time.cpp.o"
+  "CMakeFiles/Anvil.dir/src/misc/time.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/misc/types.cpp.o"
+  "CMakeFiles/Anvil.dir/src/misc/types.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/misc/types_classes.cpp.o"
+  "CMakeFiles/Anvil.dir/src/misc/types_classes.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/misc/types_struct.cpp.o"
+  "CMakeFiles/Anvil.dir/src/misc/types_struct.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/misc/types_utils.cpp.o"
+  "CMakeFiles/Anvil.dir/src/misc/types_utils.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/misc/vulkan.cpp.o"
+  "CMakeFiles/Anvil.dir/src/misc/vulkan.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/misc/window.cpp.o"
+  "CMakeFiles/Anvil.dir/src/misc/window.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/misc/window_factory.cpp.o"
+  "CMakeFiles/Anvil.dir/src/misc/window_factory.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/wrappers/buffer.cpp.o"
+  "CMakeFiles/Anvil.dir/src/wrappers/buffer.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/wrappers/buffer_view.cpp.o"
+  "CMakeFiles/Anvil.dir/src/wrappers/buffer_view.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/wrappers/command_buffer.cpp.o"
+  "CMakeFiles/Anvil.dir/src/wrappers/command_buffer.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/wrappers/command_pool.cpp.o"
+  "CMakeFiles/Anvil.dir/src/wrappers/command_pool.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/wrappers/compute_pipeline_manager.cpp.o"
+  "CMakeFiles/Anvil.dir/src/wrappers/compute_pipeline_manager.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/wrappers/debug_messenger.cpp.o"
+  "CMakeFiles/Anvil.dir/src/wrappers/debug_messenger.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/wrappers/descriptor_pool.cpp.o"
+  "CMakeFiles/Anvil.dir/src/wrappers/descriptor_pool.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/wrappers/descriptor_set.cpp.o"
+  "CMakeFiles/Anvil.dir/src/wrappers/descriptor_set.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/wrappers/descriptor_set_group.cpp.o"
+  "CMakeFiles/Anvil.dir/src/wrappers/descriptor_set_group.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/wrappers/descriptor_set_layout.cpp.o"
+  "CMakeFiles/Anvil.dir/src/wrappers/descriptor_set_layout.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/wrappers/descriptor_set_layout_manager.cpp.o"
+  "CMakeFiles/Anvil.dir/src/wrappers/descriptor_set_layout_manager.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/wrappers/descriptor_update_template.cpp.o"
+  "CMakeFiles/Anvil.dir/src/wrappers/descriptor_update_template.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/wrappers/device.cpp.o"
+  "CMakeFiles/Anvil.dir/src/wrappers/device.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/wrappers/event.cpp.o"
+  "CMakeFiles/Anvil.dir/src/wrappers/event.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/wrappers/fence.cpp.o"
+  "CMakeFiles/Anvil.dir/src/wrappers/fence.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/wrappers/framebuffer.cpp.o"
+  "CMakeFiles/Anvil.dir/src/wrappers/framebuffer.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/wrappers/graphics_pipeline_manager.cpp.o"
+  "CMakeFiles/Anvil.dir/src/wrappers/graphics_pipeline_manager.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/wrappers/image.cpp.o"
+  "CMakeFiles/Anvil.dir/src/wrappers/image.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/wrappers/image_view.cpp.o"
+  "CMakeFiles/Anvil.dir/src/wrappers/image_view.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/wrappers/instance.cpp.o"
+  "CMakeFiles/Anvil.dir/src/wrappers/instance.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/wrappers/memory_block.cpp.o"
+  "CMakeFiles/Anvil.dir/src/wrappers/memory_block.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/wrappers/physical_device.cpp.o"
+  "CMakeFiles/Anvil.dir/src/wrappers/physical_device.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/wrappers/pipeline_cache.cpp.o"
+  "CMakeFiles/Anvil.dir/src/wrappers/pipeline_cache.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/wrappers/pipeline_layout.cpp.o"
+  "CMakeFiles/Anvil.dir/src/wrappers/pipeline_layout.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/wrappers/pipeline_layout_manager.cpp.o"
+  "CMakeFiles/Anvil.dir/src/wrappers/pipeline_layout_manager.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/wrappers/query_pool.cpp.o"
+  "CMakeFiles/Anvil.dir/src/wrappers/query_pool.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/wrappers/queue.cpp.o"
+  "CMakeFiles/Anvil.dir/src/wrappers/queue.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/wrappers/render_pass.cpp.o"
+  "CMakeFiles/Anvil.dir/src/wrappers/render_pass.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/wrappers/rendering_surface.cpp.o"
+  "CMakeFiles/Anvil.dir/src/wrappers/rendering_surface.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/wrappers/sampler.cpp.o"
+  "CMakeFiles/Anvil.dir/src/wrappers/sampler.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/wrappers/semaphore.cpp.o"
+  "CMakeFiles/Anvil.dir/src/wrappers/semaphore.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/wrappers/shader_module.cpp.o"
+  "CMakeFiles/Anvil.dir/src/wrappers/shader_module.cpp.o.d"
+  "CMakeFiles/Anvil.dir/src/wrappers/swapchain.cpp.o"
+  "CMakeFiles/Anvil.dir/src/wrappers/swapchain.cpp.o.d"
+  "libAnvil.a"
+  "libAnvil.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/Anvil.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,103 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/repo/CMakeLists.txt"
+  "CMakeFiles/3.25.1/CMakeCCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/root/repo/deps/glslang/CMakeLists.txt"
+  "/root/repo/deps/glslang/External/CMakeLists.txt"
+  "/root/repo/deps/glslang/OGLCompilersDLL/CMakeLists.txt"
+  "/root/repo/deps/glslang/SPIRV/CMakeLists.txt"
+  "/root/repo/deps/glslang/StandAlone/CMakeLists.txt"
+  "/root/repo/deps/glslang/glslang/CMakeLists.txt"
+  "/root/repo/deps/glslang/glslang/OSDependent/Unix/CMakeLists.txt"
+  "/root/repo/deps/glslang/gtests/CMakeLists.txt"
+  "/root/repo/examples/Benchmarks/CMakeLists.txt"
+  "/root/repo/examples/DynamicBuffers/CMakeLists.txt"
+  "/root/repo/examples/MultiViewport/CMakeLists.txt"
+  "/root/repo/examples/OcclusionQuery/CMakeLists.txt"
+  "/root/repo/examples/OutOfOrderRasterization/CMakeLists.txt"
+  "/root/repo/examples/PushConstants/CMakeLists.txt"
+  "/root/repo/include/config.h.in"
+  "/usr/share/cmake-3.25/Modules/CMakeCInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCheckCompilerFlagCommonPatterns.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/CTest.cmake"
+  "/usr/share/cmake-3.25/Modules/CTestUseLaunchers.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCXXCompilerFlag.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCXXSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/GNUInstallDirs.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckCompilerFlag.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckFlagCommonConfig.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "include/config.h"
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  "deps/glslang/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "deps/glslang/External/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "deps/glslang/glslang/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "deps/glslang/glslang/OSDependent/Unix/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "deps/glslang/OGLCompilersDLL/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "deps/glslang/StandAlone/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "deps/glslang/SPIRV/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "deps/glslang/gtests/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "examples/Benchmarks/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "examples/DynamicBuffers/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "examples/MultiViewport/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "examples/OcclusionQuery/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "examples/OutOfOrderRasterization/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "examples/PushConstants/CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "CMakeFiles/Anvil.dir/DependInfo.cmake"
+  "deps/glslang/glslang/CMakeFiles/glslang.dir/DependInfo.cmake"
+  "deps/glslang/glslang/OSDependent/Unix/CMakeFiles/OSDependent.dir/DependInfo.cmake"
+  "deps/glslang/OGLCompilersDLL/CMakeFiles/OGLCompiler.dir/DependInfo.cmake"
+  "deps/glslang/StandAlone/CMakeFiles/glslang-default-resource-limits.dir/DependInfo.cmake"
+  "deps/glslang/StandAlone/CMakeFiles/glslangValidator.dir/DependInfo.cmake"
+  "deps/glslang/StandAlone/CMakeFiles/spirv-remap.dir/DependInfo.cmake"
+  "deps/glslang/SPIRV/CMakeFiles/SPIRV.dir/DependInfo.cmake"
+  "deps/glslang/SPIRV/CMakeFiles/SPVRemapper.dir/DependInfo.cmake"
+  "examples/Benchmarks/CMakeFiles/AllocatorChurnBenchmark.dir/DependInfo.cmake"
+  "examples/Benchmarks/CMakeFiles/DefragmentationBenchmark.dir/DependInfo.cmake"
+  "examples/Benchmarks/CMakeFiles/RecordingBenchmark.dir/DependInfo.cmake"
+  "examples/Benchmarks/CMakeFiles/SubmissionBenchmark.dir/DependInfo.cmake"
+  "examples/DynamicBuffers/CMakeFiles/DynamicBuffers.dir/DependInfo.cmake"
+  "examples/MultiViewport/CMakeFiles/MultiViewport.dir/DependInfo.cmake"
+  "examples/OcclusionQuery/CMakeFiles/OcclusionQuery.dir/DependInfo.cmake"
+  "examples/OutOfOrderRasterization/CMakeFiles/OutOfOrderRasterization.dir/DependInfo.cmake"
+  "examples/PushConstants/CMakeFiles/PushConstants.dir/DependInfo.cmake"
+  )
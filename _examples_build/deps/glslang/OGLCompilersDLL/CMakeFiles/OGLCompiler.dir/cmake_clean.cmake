@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/OGLCompiler.dir/InitializeDll.cpp.o"
+  "CMakeFiles/OGLCompiler.dir/InitializeDll.cpp.o.d"
+  "libOGLCompiler.a"
+  "libOGLCompiler.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/OGLCompiler.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
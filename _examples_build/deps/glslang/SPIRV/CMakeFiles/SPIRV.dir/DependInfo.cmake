@@ -0,0 +1,29 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/deps/glslang/SPIRV/GlslangToSpv.cpp" "deps/glslang/SPIRV/CMakeFiles/SPIRV.dir/GlslangToSpv.cpp.o" "gcc" "deps/glslang/SPIRV/CMakeFiles/SPIRV.dir/GlslangToSpv.cpp.o.d"
+  "/root/repo/deps/glslang/SPIRV/InReadableOrder.cpp" "deps/glslang/SPIRV/CMakeFiles/SPIRV.dir/InReadableOrder.cpp.o" "gcc" "deps/glslang/SPIRV/CMakeFiles/SPIRV.dir/InReadableOrder.cpp.o.d"
+  "/root/repo/deps/glslang/SPIRV/Logger.cpp" "deps/glslang/SPIRV/CMakeFiles/SPIRV.dir/Logger.cpp.o" "gcc" "deps/glslang/SPIRV/CMakeFiles/SPIRV.dir/Logger.cpp.o.d"
+  "/root/repo/deps/glslang/SPIRV/SpvBuilder.cpp" "deps/glslang/SPIRV/CMakeFiles/SPIRV.dir/SpvBuilder.cpp.o" "gcc" "deps/glslang/SPIRV/CMakeFiles/SPIRV.dir/SpvBuilder.cpp.o.d"
+  "/root/repo/deps/glslang/SPIRV/SpvPostProcess.cpp" "deps/glslang/SPIRV/CMakeFiles/SPIRV.dir/SpvPostProcess.cpp.o" "gcc" "deps/glslang/SPIRV/CMakeFiles/SPIRV.dir/SpvPostProcess.cpp.o.d"
+  "/root/repo/deps/glslang/SPIRV/SpvTools.cpp" "deps/glslang/SPIRV/CMakeFiles/SPIRV.dir/SpvTools.cpp.o" "gcc" "deps/glslang/SPIRV/CMakeFiles/SPIRV.dir/SpvTools.cpp.o.d"
+  "/root/repo/deps/glslang/SPIRV/disassemble.cpp" "deps/glslang/SPIRV/CMakeFiles/SPIRV.dir/disassemble.cpp.o" "gcc" "deps/glslang/SPIRV/CMakeFiles/SPIRV.dir/disassemble.cpp.o.d"
+  "/root/repo/deps/glslang/SPIRV/doc.cpp" "deps/glslang/SPIRV/CMakeFiles/SPIRV.dir/doc.cpp.o" "gcc" "deps/glslang/SPIRV/CMakeFiles/SPIRV.dir/doc.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_examples_build/deps/glslang/glslang/CMakeFiles/glslang.dir/DependInfo.cmake"
+  "/root/repo/_examples_build/deps/glslang/OGLCompilersDLL/CMakeFiles/OGLCompiler.dir/DependInfo.cmake"
+  "/root/repo/_examples_build/deps/glslang/glslang/OSDependent/Unix/CMakeFiles/OSDependent.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,25 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/SPIRV.dir/GlslangToSpv.cpp.o"
+  "CMakeFiles/SPIRV.dir/GlslangToSpv.cpp.o.d"
+  "CMakeFiles/SPIRV.dir/InReadableOrder.cpp.o"
+  "CMakeFiles/SPIRV.dir/InReadableOrder.cpp.o.d"
+  "CMakeFiles/SPIRV.dir/Logger.cpp.o"
+  "CMakeFiles/SPIRV.dir/Logger.cpp.o.d"
+  "CMakeFiles/SPIRV.dir/SpvBuilder.cpp.o"
+  "CMakeFiles/SPIRV.dir/SpvBuilder.cpp.o.d"
+  "CMakeFiles/SPIRV.dir/SpvPostProcess.cpp.o"
+  "CMakeFiles/SPIRV.dir/SpvPostProcess.cpp.o.d"
+  "CMakeFiles/SPIRV.dir/SpvTools.cpp.o"
+  "CMakeFiles/SPIRV.dir/SpvTools.cpp.o.d"
+  "CMakeFiles/SPIRV.dir/disassemble.cpp.o"
+  "CMakeFiles/SPIRV.dir/disassemble.cpp.o.d"
+  "CMakeFiles/SPIRV.dir/doc.cpp.o"
+  "CMakeFiles/SPIRV.dir/doc.cpp.o.d"
+  "libSPIRV.a"
+  "libSPIRV.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/SPIRV.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/SPVRemapper.dir/SPVRemapper.cpp.o"
+  "CMakeFiles/SPVRemapper.dir/SPVRemapper.cpp.o.d"
+  "CMakeFiles/SPVRemapper.dir/doc.cpp.o"
+  "CMakeFiles/SPVRemapper.dir/doc.cpp.o.d"
+  "libSPVRemapper.a"
+  "libSPVRemapper.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/SPVRemapper.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,74 @@
+# Install script for directory: /root/repo/deps/glslang/SPIRV
+
+# Set the install prefix
+if(NOT DEFINED CMAKE_INSTALL_PREFIX)
+  set(CMAKE_INSTALL_PREFIX "/usr/local")
+endif()
+string(REGEX REPLACE "/$" "" CMAKE_INSTALL_PREFIX "${CMAKE_INSTALL_PREFIX}")
+
+# Set the install configuration name.
+if(NOT DEFINED CMAKE_INSTALL_CONFIG_NAME)
+  if(BUILD_TYPE)
+    string(REGEX REPLACE "^[^A-Za-z0-9_]+" ""
+           CMAKE_INSTALL_CONFIG_NAME "${BUILD_TYPE}")
+  else()
+    set(CMAKE_INSTALL_CONFIG_NAME "")
+  endif()
+  message(STATUS "Install configuration: \"${CMAKE_INSTALL_CONFIG_NAME}\"")
+endif()
+
+# Set the component getting installed.
+if(NOT CMAKE_INSTALL_COMPONENT)
+  if(COMPONENT)
+    message(STATUS "Install component: \"${COMPONENT}\"")
+    set(CMAKE_INSTALL_COMPONENT "${COMPONENT}")
+  else()
+    set(CMAKE_INSTALL_COMPONENT)
+  endif()
+endif()
+
+# Install shared libraries without execute permission?
+if(NOT DEFINED CMAKE_INSTALL_SO_NO_EXE)
+  set(CMAKE_INSTALL_SO_NO_EXE "1")
+endif()
+
+# Is this installation the result of a crosscompile?
+if(NOT DEFINED CMAKE_CROSSCOMPILING)
+  set(CMAKE_CROSSCOMPILING "FALSE")
+endif()
+
+# Set default install directory permissions.
+if(NOT DEFINED CMAKE_OBJDUMP)
+  set(CMAKE_OBJDUMP "/usr/bin/objdump")
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/lib" TYPE STATIC_LIBRARY FILES "/root/repo/_examples_build/deps/glslang/SPIRV/libSPVRemapper.a")
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/lib" TYPE STATIC_LIBRARY FILES "/root/repo/_examples_build/deps/glslang/SPIRV/libSPIRV.a")
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/include/SPIRV" TYPE FILE FILES
+    "/root/repo/deps/glslang/SPIRV/bitutils.h"
+    "/root/repo/deps/glslang/SPIRV/spirv.hpp"
+    "/root/repo/deps/glslang/SPIRV/GLSL.std.450.h"
+    "/root/repo/deps/glslang/SPIRV/GLSL.ext.EXT.h"
+    "/root/repo/deps/glslang/SPIRV/GLSL.ext.KHR.h"
+    "/root/repo/deps/glslang/SPIRV/GlslangToSpv.h"
+    "/root/repo/deps/glslang/SPIRV/hex_float.h"
+    "/root/repo/deps/glslang/SPIRV/Logger.h"
+    "/root/repo/deps/glslang/SPIRV/SpvBuilder.h"
+    "/root/repo/deps/glslang/SPIRV/spvIR.h"
+    "/root/repo/deps/glslang/SPIRV/doc.h"
+    "/root/repo/deps/glslang/SPIRV/SpvTools.h"
+    "/root/repo/deps/glslang/SPIRV/disassemble.h"
+    "/root/repo/deps/glslang/SPIRV/GLSL.ext.AMD.h"
+    "/root/repo/deps/glslang/SPIRV/GLSL.ext.NV.h"
+    "/root/repo/deps/glslang/SPIRV/SPVRemapper.h"
+    "/root/repo/deps/glslang/SPIRV/doc.h"
+    )
+endif()
+
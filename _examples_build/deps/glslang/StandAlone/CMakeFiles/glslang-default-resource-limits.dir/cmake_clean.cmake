@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/glslang-default-resource-limits.dir/ResourceLimits.cpp.o"
+  "CMakeFiles/glslang-default-resource-limits.dir/ResourceLimits.cpp.o.d"
+  "libglslang-default-resource-limits.a"
+  "libglslang-default-resource-limits.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/glslang-default-resource-limits.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,3 @@
+file(REMOVE_RECURSE
+  "libglslang-default-resource-limits.a"
+)
@@ -0,0 +1,25 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/deps/glslang/StandAlone/StandAlone.cpp" "deps/glslang/StandAlone/CMakeFiles/glslangValidator.dir/StandAlone.cpp.o" "gcc" "deps/glslang/StandAlone/CMakeFiles/glslangValidator.dir/StandAlone.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_examples_build/deps/glslang/glslang/CMakeFiles/glslang.dir/DependInfo.cmake"
+  "/root/repo/_examples_build/deps/glslang/SPIRV/CMakeFiles/SPIRV.dir/DependInfo.cmake"
+  "/root/repo/_examples_build/deps/glslang/SPIRV/CMakeFiles/SPVRemapper.dir/DependInfo.cmake"
+  "/root/repo/_examples_build/deps/glslang/StandAlone/CMakeFiles/glslang-default-resource-limits.dir/DependInfo.cmake"
+  "/root/repo/_examples_build/deps/glslang/OGLCompilersDLL/CMakeFiles/OGLCompiler.dir/DependInfo.cmake"
+  "/root/repo/_examples_build/deps/glslang/glslang/OSDependent/Unix/CMakeFiles/OSDependent.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
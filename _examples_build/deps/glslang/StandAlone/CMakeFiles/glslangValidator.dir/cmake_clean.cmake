@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/glslangValidator.dir/StandAlone.cpp.o"
+  "CMakeFiles/glslangValidator.dir/StandAlone.cpp.o.d"
+  "glslangValidator"
+  "glslangValidator.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/glslangValidator.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/spirv-remap.dir/spirv-remap.cpp.o"
+  "CMakeFiles/spirv-remap.dir/spirv-remap.cpp.o.d"
+  "spirv-remap"
+  "spirv-remap.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/spirv-remap.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,49 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/deps/glslang/glslang/GenericCodeGen/CodeGen.cpp" "deps/glslang/glslang/CMakeFiles/glslang.dir/GenericCodeGen/CodeGen.cpp.o" "gcc" "deps/glslang/glslang/CMakeFiles/glslang.dir/GenericCodeGen/CodeGen.cpp.o.d"
+  "/root/repo/deps/glslang/glslang/GenericCodeGen/Link.cpp" "deps/glslang/glslang/CMakeFiles/glslang.dir/GenericCodeGen/Link.cpp.o" "gcc" "deps/glslang/glslang/CMakeFiles/glslang.dir/GenericCodeGen/Link.cpp.o.d"
+  "/root/repo/deps/glslang/glslang/MachineIndependent/Constant.cpp" "deps/glslang/glslang/CMakeFiles/glslang.dir/MachineIndependent/Constant.cpp.o" "gcc" "deps/glslang/glslang/CMakeFiles/glslang.dir/MachineIndependent/Constant.cpp.o.d"
+  "/root/repo/deps/glslang/glslang/MachineIndependent/InfoSink.cpp" "deps/glslang/glslang/CMakeFiles/glslang.dir/MachineIndependent/InfoSink.cpp.o" "gcc" "deps/glslang/glslang/CMakeFiles/glslang.dir/MachineIndependent/InfoSink.cpp.o.d"
+  "/root/repo/deps/glslang/glslang/MachineIndependent/Initialize.cpp" "deps/glslang/glslang/CMakeFiles/glslang.dir/MachineIndependent/Initialize.cpp.o" "gcc" "deps/glslang/glslang/CMakeFiles/glslang.dir/MachineIndependent/Initialize.cpp.o.d"
+  "/root/repo/deps/glslang/glslang/MachineIndependent/IntermTraverse.cpp" "deps/glslang/glslang/CMakeFiles/glslang.dir/MachineIndependent/IntermTraverse.cpp.o" "gcc" "deps/glslang/glslang/CMakeFiles/glslang.dir/MachineIndependent/IntermTraverse.cpp.o.d"
+  "/root/repo/deps/glslang/glslang/MachineIndependent/Intermediate.cpp" "deps/glslang/glslang/CMakeFiles/glslang.dir/MachineIndependent/Intermediate.cpp.o" "gcc" "deps/glslang/glslang/CMakeFiles/glslang.dir/MachineIndependent/Intermediate.cpp.o.d"
+  "/root/repo/deps/glslang/glslang/MachineIndependent/ParseContextBase.cpp" "deps/glslang/glslang/CMakeFiles/glslang.dir/MachineIndependent/ParseContextBase.cpp.o" "gcc" "deps/glslang/glslang/CMakeFiles/glslang.dir/MachineIndependent/ParseContextBase.cpp.o.d"
+  "/root/repo/deps/glslang/glslang/MachineIndependent/ParseHelper.cpp" "deps/glslang/glslang/CMakeFiles/glslang.dir/MachineIndependent/ParseHelper.cpp.o" "gcc" "deps/glslang/glslang/CMakeFiles/glslang.dir/MachineIndependent/ParseHelper.cpp.o.d"
+  "/root/repo/deps/glslang/glslang/MachineIndependent/PoolAlloc.cpp" "deps/glslang/glslang/CMakeFiles/glslang.dir/MachineIndependent/PoolAlloc.cpp.o" "gcc" "deps/glslang/glslang/CMakeFiles/glslang.dir/MachineIndependent/PoolAlloc.cpp.o.d"
+  "/root/repo/deps/glslang/glslang/MachineIndependent/RemoveTree.cpp" "deps/glslang/glslang/CMakeFiles/glslang.dir/MachineIndependent/RemoveTree.cpp.o" "gcc" "deps/glslang/glslang/CMakeFiles/glslang.dir/MachineIndependent/RemoveTree.cpp.o.d"
+  "/root/repo/deps/glslang/glslang/MachineIndependent/Scan.cpp" "deps/glslang/glslang/CMakeFiles/glslang.dir/MachineIndependent/Scan.cpp.o" "gcc" "deps/glslang/glslang/CMakeFiles/glslang.dir/MachineIndependent/Scan.cpp.o.d"
+  "/root/repo/deps/glslang/glslang/MachineIndependent/ShaderLang.cpp" "deps/glslang/glslang/CMakeFiles/glslang.dir/MachineIndependent/ShaderLang.cpp.o" "gcc" "deps/glslang/glslang/CMakeFiles/glslang.dir/MachineIndependent/ShaderLang.cpp.o.d"
+  "/root/repo/deps/glslang/glslang/MachineIndependent/SymbolTable.cpp" "deps/glslang/glslang/CMakeFiles/glslang.dir/MachineIndependent/SymbolTable.cpp.o" "gcc" "deps/glslang/glslang/CMakeFiles/glslang.dir/MachineIndependent/SymbolTable.cpp.o.d"
+  "/root/repo/deps/glslang/glslang/MachineIndependent/Versions.cpp" "deps/glslang/glslang/CMakeFiles/glslang.dir/MachineIndependent/Versions.cpp.o" "gcc" "deps/glslang/glslang/CMakeFiles/glslang.dir/MachineIndependent/Versions.cpp.o.d"
+  "/root/repo/deps/glslang/glslang/MachineIndependent/attribute.cpp" "deps/glslang/glslang/CMakeFiles/glslang.dir/MachineIndependent/attribute.cpp.o" "gcc" "deps/glslang/glslang/CMakeFiles/glslang.dir/MachineIndependent/attribute.cpp.o.d"
+  "/root/repo/deps/glslang/glslang/MachineIndependent/glslang_tab.cpp" "deps/glslang/glslang/CMakeFiles/glslang.dir/MachineIndependent/glslang_tab.cpp.o" "gcc" "deps/glslang/glslang/CMakeFiles/glslang.dir/MachineIndependent/glslang_tab.cpp.o.d"
+  "/root/repo/deps/glslang/glslang/MachineIndependent/intermOut.cpp" "deps/glslang/glslang/CMakeFiles/glslang.dir/MachineIndependent/intermOut.cpp.o" "gcc" "deps/glslang/glslang/CMakeFiles/glslang.dir/MachineIndependent/intermOut.cpp.o.d"
+  "/root/repo/deps/glslang/glslang/MachineIndependent/iomapper.cpp" "deps/glslang/glslang/CMakeFiles/glslang.dir/MachineIndependent/iomapper.cpp.o" "gcc" "deps/glslang/glslang/CMakeFiles/glslang.dir/MachineIndependent/iomapper.cpp.o.d"
+  "/root/repo/deps/glslang/glslang/MachineIndependent/limits.cpp" "deps/glslang/glslang/CMakeFiles/glslang.dir/MachineIndependent/limits.cpp.o" "gcc" "deps/glslang/glslang/CMakeFiles/glslang.dir/MachineIndependent/limits.cpp.o.d"
+  "/root/repo/deps/glslang/glslang/MachineIndependent/linkValidate.cpp" "deps/glslang/glslang/CMakeFiles/glslang.dir/MachineIndependent/linkValidate.cpp.o" "gcc" "deps/glslang/glslang/CMakeFiles/glslang.dir/MachineIndependent/linkValidate.cpp.o.d"
+  "/root/repo/deps/glslang/glslang/MachineIndependent/parseConst.cpp" "deps/glslang/glslang/CMakeFiles/glslang.dir/MachineIndependent/parseConst.cpp.o" "gcc" "deps/glslang/glslang/CMakeFiles/glslang.dir/MachineIndependent/parseConst.cpp.o.d"
+  "/root/repo/deps/glslang/glslang/MachineIndependent/preprocessor/Pp.cpp" "deps/glslang/glslang/CMakeFiles/glslang.dir/MachineIndependent/preprocessor/Pp.cpp.o" "gcc" "deps/glslang/glslang/CMakeFiles/glslang.dir/MachineIndependent/preprocessor/Pp.cpp.o.d"
+  "/root/repo/deps/glslang/glslang/MachineIndependent/preprocessor/PpAtom.cpp" "deps/glslang/glslang/CMakeFiles/glslang.dir/MachineIndependent/preprocessor/PpAtom.cpp.o" "gcc" "deps/glslang/glslang/CMakeFiles/glslang.dir/MachineIndependent/preprocessor/PpAtom.cpp.o.d"
+  "/root/repo/deps/glslang/glslang/MachineIndependent/preprocessor/PpContext.cpp" "deps/glslang/glslang/CMakeFiles/glslang.dir/MachineIndependent/preprocessor/PpContext.cpp.o" "gcc" "deps/glslang/glslang/CMakeFiles/glslang.dir/MachineIndependent/preprocessor/PpContext.cpp.o.d"
+  "/root/repo/deps/glslang/glslang/MachineIndependent/preprocessor/PpScanner.cpp" "deps/glslang/glslang/CMakeFiles/glslang.dir/MachineIndependent/preprocessor/PpScanner.cpp.o" "gcc" "deps/glslang/glslang/CMakeFiles/glslang.dir/MachineIndependent/preprocessor/PpScanner.cpp.o.d"
+  "/root/repo/deps/glslang/glslang/MachineIndependent/preprocessor/PpTokens.cpp" "deps/glslang/glslang/CMakeFiles/glslang.dir/MachineIndependent/preprocessor/PpTokens.cpp.o" "gcc" "deps/glslang/glslang/CMakeFiles/glslang.dir/MachineIndependent/preprocessor/PpTokens.cpp.o.d"
+  "/root/repo/deps/glslang/glslang/MachineIndependent/propagateNoContraction.cpp" "deps/glslang/glslang/CMakeFiles/glslang.dir/MachineIndependent/propagateNoContraction.cpp.o" "gcc" "deps/glslang/glslang/CMakeFiles/glslang.dir/MachineIndependent/propagateNoContraction.cpp.o.d"
+  "/root/repo/deps/glslang/glslang/MachineIndependent/reflection.cpp" "deps/glslang/glslang/CMakeFiles/glslang.dir/MachineIndependent/reflection.cpp.o" "gcc" "deps/glslang/glslang/CMakeFiles/glslang.dir/MachineIndependent/reflection.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_examples_build/deps/glslang/OGLCompilersDLL/CMakeFiles/OGLCompiler.dir/DependInfo.cmake"
+  "/root/repo/_examples_build/deps/glslang/glslang/OSDependent/Unix/CMakeFiles/OSDependent.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,67 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/glslang.dir/GenericCodeGen/CodeGen.cpp.o"
+  "CMakeFiles/glslang.dir/GenericCodeGen/CodeGen.cpp.o.d"
+  "CMakeFiles/glslang.dir/GenericCodeGen/Link.cpp.o"
+  "CMakeFiles/glslang.dir/GenericCodeGen/Link.cpp.o.d"
+  "CMakeFiles/glslang.dir/MachineIndependent/Constant.cpp.o"
+  "CMakeFiles/glslang.dir/MachineIndependent/Constant.cpp.o.d"
+  "CMakeFiles/glslang.dir/MachineIndependent/InfoSink.cpp.o"
+  "CMakeFiles/glslang.dir/MachineIndependent/InfoSink.cpp.o.d"
+  "CMakeFiles/glslang.dir/MachineIndependent/Initialize.cpp.o"
+  "CMakeFiles/glslang.dir/MachineIndependent/Initialize.cpp.o.d"
+  "CMakeFiles/glslang.dir/MachineIndependent/IntermTraverse.cpp.o"
+  "CMakeFiles/glslang.dir/MachineIndependent/IntermTraverse.cpp.o.d"
+  "CMakeFiles/glslang.dir/MachineIndependent/Intermediate.cpp.o"
+  "CMakeFiles/glslang.dir/MachineIndependent/Intermediate.cpp.o.d"
+  "CMakeFiles/glslang.dir/MachineIndependent/ParseContextBase.cpp.o"
+  "CMakeFiles/glslang.dir/MachineIndependent/ParseContextBase.cpp.o.d"
+  "CMakeFiles/glslang.dir/MachineIndependent/ParseHelper.cpp.o"
+  "CMakeFiles/glslang.dir/MachineIndependent/ParseHelper.cpp.o.d"
+  "CMakeFiles/glslang.dir/MachineIndependent/PoolAlloc.cpp.o"
+  "CMakeFiles/glslang.dir/MachineIndependent/PoolAlloc.cpp.o.d"
+  "CMakeFiles/glslang.dir/MachineIndependent/RemoveTree.cpp.o"
+  "CMakeFiles/glslang.dir/MachineIndependent/RemoveTree.cpp.o.d"
+  "CMakeFiles/glslang.dir/MachineIndependent/Scan.cpp.o"
+  "CMakeFiles/glslang.dir/MachineIndependent/Scan.cpp.o.d"
+  "CMakeFiles/glslang.dir/MachineIndependent/ShaderLang.cpp.o"
+  "CMakeFiles/glslang.dir/MachineIndependent/ShaderLang.cpp.o.d"
+  "CMakeFiles/glslang.dir/MachineIndependent/SymbolTable.cpp.o"
+  "CMakeFiles/glslang.dir/MachineIndependent/SymbolTable.cpp.o.d"
+  "CMakeFiles/glslang.dir/MachineIndependent/Versions.cpp.o"
+  "CMakeFiles/glslang.dir/MachineIndependent/Versions.cpp.o.d"
+  "CMakeFiles/glslang.dir/MachineIndependent/attribute.cpp.o"
+  "CMakeFiles/glslang.dir/MachineIndependent/attribute.cpp.o.d"
+  "CMakeFiles/glslang.dir/MachineIndependent/glslang_tab.cpp.o"
+  "CMakeFiles/glslang.dir/MachineIndependent/glslang_tab.cpp.o.d"
+  "CMakeFiles/glslang.dir/MachineIndependent/intermOut.cpp.o"
+  "CMakeFiles/glslang.dir/MachineIndependent/intermOut.cpp.o.d"
+  "CMakeFiles/glslang.dir/MachineIndependent/iomapper.cpp.o"
+  "CMakeFiles/glslang.dir/MachineIndependent/iomapper.cpp.o.d"
+  "CMakeFiles/glslang.dir/MachineIndependent/limits.cpp.o"
+  "CMakeFiles/glslang.dir/MachineIndependent/limits.cpp.o.d"
+  "CMakeFiles/glslang.dir/MachineIndependent/linkValidate.cpp.o"
+  "CMakeFiles/glslang.dir/MachineIndependent/linkValidate.cpp.o.d"
+  "CMakeFiles/glslang.dir/MachineIndependent/parseConst.cpp.o"
+  "CMakeFiles/glslang.dir/MachineIndependent/parseConst.cpp.o.d"
+  "CMakeFiles/glslang.dir/MachineIndependent/preprocessor/Pp.cpp.o"
+  "CMakeFiles/glslang.dir/MachineIndependent/preprocessor/Pp.cpp.o.d"
+  "CMakeFiles/glslang.dir/MachineIndependent/preprocessor/PpAtom.cpp.o"
+  "CMakeFiles/glslang.dir/MachineIndependent/preprocessor/PpAtom.cpp.o.d"
+  "CMakeFiles/glslang.dir/MachineIndependent/preprocessor/PpContext.cpp.o"
+  "CMakeFiles/glslang.dir/MachineIndependent/preprocessor/PpContext.cpp.o.d"
+  "CMakeFiles/glslang.dir/MachineIndependent/preprocessor/PpScanner.cpp.o"
+  "CMakeFiles/glslang.dir/MachineIndependent/preprocessor/PpScanner.cpp.o.d"
+  "CMakeFiles/glslang.dir/MachineIndependent/preprocessor/PpTokens.cpp.o"
+  "CMakeFiles/glslang.dir/MachineIndependent/preprocessor/PpTokens.cpp.o.d"
+  "CMakeFiles/glslang.dir/MachineIndependent/propagateNoContraction.cpp.o"
+  "CMakeFiles/glslang.dir/MachineIndependent/propagateNoContraction.cpp.o.d"
+  "CMakeFiles/glslang.dir/MachineIndependent/reflection.cpp.o"
+  "CMakeFiles/glslang.dir/MachineIndependent/reflection.cpp.o.d"
+  "libglslang.a"
+  "libglslang.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/glslang.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/OSDependent.dir/ossource.cpp.o"
+  "CMakeFiles/OSDependent.dir/ossource.cpp.o.d"
+  "libOSDependent.a"
+  "libOSDependent.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/OSDependent.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
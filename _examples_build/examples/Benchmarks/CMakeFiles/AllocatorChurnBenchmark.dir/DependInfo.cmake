@@ -0,0 +1,25 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/examples/Benchmarks/src/allocator_churn_benchmark.cpp" "examples/Benchmarks/CMakeFiles/AllocatorChurnBenchmark.dir/src/allocator_churn_benchmark.cpp.o" "gcc" "examples/Benchmarks/CMakeFiles/AllocatorChurnBenchmark.dir/src/allocator_churn_benchmark.cpp.o.d"
+  "/root/repo/examples/Benchmarks/src/benchmark_utils.cpp" "examples/Benchmarks/CMakeFiles/AllocatorChurnBenchmark.dir/src/benchmark_utils.cpp.o" "gcc" "examples/Benchmarks/CMakeFiles/AllocatorChurnBenchmark.dir/src/benchmark_utils.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_examples_build/CMakeFiles/Anvil.dir/DependInfo.cmake"
+  "/root/repo/_examples_build/deps/glslang/SPIRV/CMakeFiles/SPIRV.dir/DependInfo.cmake"
+  "/root/repo/_examples_build/deps/glslang/glslang/CMakeFiles/glslang.dir/DependInfo.cmake"
+  "/root/repo/_examples_build/deps/glslang/OGLCompilersDLL/CMakeFiles/OGLCompiler.dir/DependInfo.cmake"
+  "/root/repo/_examples_build/deps/glslang/glslang/OSDependent/Unix/CMakeFiles/OSDependent.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "AllocatorChurnBenchmark"
+  "AllocatorChurnBenchmark.pdb"
+  "CMakeFiles/AllocatorChurnBenchmark.dir/src/allocator_churn_benchmark.cpp.o"
+  "CMakeFiles/AllocatorChurnBenchmark.dir/src/allocator_churn_benchmark.cpp.o.d"
+  "CMakeFiles/AllocatorChurnBenchmark.dir/src/benchmark_utils.cpp.o"
+  "CMakeFiles/AllocatorChurnBenchmark.dir/src/benchmark_utils.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/AllocatorChurnBenchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
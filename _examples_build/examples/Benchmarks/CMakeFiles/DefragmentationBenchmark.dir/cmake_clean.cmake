@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/DefragmentationBenchmark.dir/src/benchmark_utils.cpp.o"
+  "CMakeFiles/DefragmentationBenchmark.dir/src/benchmark_utils.cpp.o.d"
+  "CMakeFiles/DefragmentationBenchmark.dir/src/defragmentation_benchmark.cpp.o"
+  "CMakeFiles/DefragmentationBenchmark.dir/src/defragmentation_benchmark.cpp.o.d"
+  "DefragmentationBenchmark"
+  "DefragmentationBenchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/DefragmentationBenchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
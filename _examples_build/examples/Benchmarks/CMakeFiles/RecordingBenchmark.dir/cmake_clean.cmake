@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/RecordingBenchmark.dir/src/benchmark_utils.cpp.o"
+  "CMakeFiles/RecordingBenchmark.dir/src/benchmark_utils.cpp.o.d"
+  "CMakeFiles/RecordingBenchmark.dir/src/recording_benchmark.cpp.o"
+  "CMakeFiles/RecordingBenchmark.dir/src/recording_benchmark.cpp.o.d"
+  "RecordingBenchmark"
+  "RecordingBenchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/RecordingBenchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/SubmissionBenchmark.dir/src/benchmark_utils.cpp.o"
+  "CMakeFiles/SubmissionBenchmark.dir/src/benchmark_utils.cpp.o.d"
+  "CMakeFiles/SubmissionBenchmark.dir/src/submission_benchmark.cpp.o"
+  "CMakeFiles/SubmissionBenchmark.dir/src/submission_benchmark.cpp.o.d"
+  "SubmissionBenchmark"
+  "SubmissionBenchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/SubmissionBenchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
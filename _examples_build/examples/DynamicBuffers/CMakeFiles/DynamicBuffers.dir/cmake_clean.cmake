@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/DynamicBuffers.dir/src/app.cpp.o"
+  "CMakeFiles/DynamicBuffers.dir/src/app.cpp.o.d"
+  "DynamicBuffers"
+  "DynamicBuffers.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/DynamicBuffers.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/MultiViewport.dir/src/app.cpp.o"
+  "CMakeFiles/MultiViewport.dir/src/app.cpp.o.d"
+  "MultiViewport"
+  "MultiViewport.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/MultiViewport.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
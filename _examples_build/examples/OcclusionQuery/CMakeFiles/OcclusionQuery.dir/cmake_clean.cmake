@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/OcclusionQuery.dir/src/app.cpp.o"
+  "CMakeFiles/OcclusionQuery.dir/src/app.cpp.o.d"
+  "OcclusionQuery"
+  "OcclusionQuery.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/OcclusionQuery.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
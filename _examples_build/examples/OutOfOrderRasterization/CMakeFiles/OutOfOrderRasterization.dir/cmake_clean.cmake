@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/OutOfOrderRasterization.dir/src/app.cpp.o"
+  "CMakeFiles/OutOfOrderRasterization.dir/src/app.cpp.o.d"
+  "CMakeFiles/OutOfOrderRasterization.dir/src/teapot_data.cpp.o"
+  "CMakeFiles/OutOfOrderRasterization.dir/src/teapot_data.cpp.o.d"
+  "OutOfOrderRasterization"
+  "OutOfOrderRasterization.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/OutOfOrderRasterization.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/PushConstants.dir/src/app.cpp.o"
+  "CMakeFiles/PushConstants.dir/src/app.cpp.o.d"
+  "PushConstants"
+  "PushConstants.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/PushConstants.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
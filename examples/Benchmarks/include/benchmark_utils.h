@@ -0,0 +1,53 @@
+//
+// Copyright (c) 2017-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/** Helpers shared by the benchmarks. None of the benchmarks needs a window system, so they can be run against
+ *  any ICD, including a null driver such as the mock ICD shipped with Vulkan-Tools, selected with the
+ *  VK_ICD_FILENAMES environment variable. This keeps driver overhead out of the timings.
+ *
+ *  Heap allocations are counted by replacing the global operator new & delete. Allocations made by the driver
+ *  or by the Vulkan loader through malloc() are not counted.
+ **/
+#ifndef BENCHMARK_UTILS_H
+#define BENCHMARK_UTILS_H
+
+#include "misc/types.h"
+
+
+namespace BenchmarkUtils
+{
+    /** Creates an instance and a single-GPU device for the first physical device reported by the instance.
+     *
+     *  @return true if successful, false otherwise.
+     **/
+    bool create_device(const char*                 in_app_name,
+                       Anvil::InstanceUniquePtr*   out_instance_ptr,
+                       Anvil::BaseDeviceUniquePtr* out_device_ptr);
+
+    /** Returns the number of operator new calls issued by the process so far. */
+    uint64_t get_n_heap_allocations();
+
+    /** Returns monotonic time, in microseconds. */
+    uint64_t get_time_usec();
+}; /* namespace BenchmarkUtils */
+
+#endif /* BENCHMARK_UTILS_H */
@@ -0,0 +1,260 @@
+//
+// Copyright (c) 2017-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+/** Compares memory allocator backends under allocation churn.
+ *
+ *  Each round releases a random half of the live buffers and replaces them with new buffers of random sizes,
+ *  which are then assigned memory with a single bake. One-shot allocators only support a single bake, so a new
+ *  one is created for every round. All backends see the same sequence of buffer sizes and releases.
+ *
+ *  Only the time spent in add_buffer(), bake() and buffer release is measured. Buffer creation is not.
+ **/
+#include "misc/buffer_create_info.h"
+#include "misc/memory_allocator.h"
+#include "wrappers/buffer.h"
+#include "wrappers/device.h"
+#include "wrappers/instance.h"
+#include "benchmark_utils.h"
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+
+static const uint32_t N_BUFFERS = 1024;
+static const uint32_t N_ROUNDS  = 32;
+static const uint32_t SEED      = 1;
+
+enum class AllocatorType
+{
+    ONESHOT,
+    TLSF,
+    VMA
+};
+
+
+static Anvil::MemoryAllocatorUniquePtr create_allocator(AllocatorType            in_type,
+                                                        const Anvil::BaseDevice* in_device_ptr)
+{
+    switch (in_type)
+    {
+        case AllocatorType::ONESHOT: return Anvil::MemoryAllocator::create_oneshot(in_device_ptr);
+        case AllocatorType::TLSF:    return Anvil::MemoryAllocator::create_tlsf   (in_device_ptr);
+        case AllocatorType::VMA:     return Anvil::MemoryAllocator::create_vma    (in_device_ptr);
+    }
+
+    return Anvil::MemoryAllocatorUniquePtr(nullptr,
+                                           std::default_delete<Anvil::MemoryAllocator>() );
+}
+
+/** Runs N_ROUNDS rounds of churn against a backend and prints a row of stats.
+ *
+ *  @return true if successful, false otherwise.
+ **/
+static bool run_churn(const char*              in_name,
+                      AllocatorType            in_type,
+                      const Anvil::BaseDevice* in_device_ptr)
+{
+    std::vector<Anvil::MemoryAllocatorUniquePtr> allocator_ptrs;
+    uint64_t                                     bake_time_usec     = 0;
+    std::vector<Anvil::BufferUniquePtr>          buffer_ptrs;
+    Anvil::MemoryAllocator::CounterSnapshot      counters;
+    float                                        fragmentation      = 0.0f;
+    uint64_t                                     n_heap_allocations = 0;
+    std::vector<Anvil::BufferUniquePtr>          new_buffer_ptrs;
+    uint64_t                                     release_time_usec  = 0;
+    bool                                         result             = false;
+    std::mt19937                                 rng                (SEED);
+    std::uniform_int_distribution<uint32_t>      size_distribution  (1, 4096); /* In 256-byte units */
+
+    for (uint32_t n_round = 0;
+                  n_round < N_ROUNDS;
+                ++n_round)
+    {
+        uint64_t n_heap_allocations_before;
+        uint64_t start_time_usec;
+
+        if (n_round > 0)
+        {
+            std::shuffle(buffer_ptrs.begin(),
+                         buffer_ptrs.end  (),
+                         rng);
+
+            n_heap_allocations_before = BenchmarkUtils::get_n_heap_allocations();
+            start_time_usec           = BenchmarkUtils::get_time_usec         ();
+            {
+                buffer_ptrs.resize(N_BUFFERS / 2);
+            }
+            release_time_usec  += BenchmarkUtils::get_time_usec         () - start_time_usec;
+            n_heap_allocations += BenchmarkUtils::get_n_heap_allocations() - n_heap_allocations_before;
+        }
+
+        if (allocator_ptrs.size() == 0            ||
+            in_type               == AllocatorType::ONESHOT)
+        {
+            allocator_ptrs.push_back(
+                create_allocator(in_type,
+                                 in_device_ptr)
+            );
+        }
+
+        while (buffer_ptrs.size() + new_buffer_ptrs.size() < N_BUFFERS)
+        {
+            auto create_info_ptr = Anvil::BufferCreateInfo::create_no_alloc(in_device_ptr,
+                                                                            static_cast<VkDeviceSize>(size_distribution(rng) ) * 256,
+                                                                            Anvil::QueueFamilyFlagBits::GRAPHICS_BIT,
+                                                                            Anvil::SharingMode::EXCLUSIVE,
+                                                                            Anvil::BufferCreateFlagBits::NONE,
+                                                                            Anvil::BufferUsageFlagBits::STORAGE_BUFFER_BIT);
+            auto buffer_ptr      = Anvil::Buffer::create(std::move(create_info_ptr) );
+
+            if (buffer_ptr == nullptr)
+            {
+                goto end;
+            }
+
+            new_buffer_ptrs.push_back(std::move(buffer_ptr) );
+        }
+
+        n_heap_allocations_before = BenchmarkUtils::get_n_heap_allocations();
+        start_time_usec           = BenchmarkUtils::get_time_usec         ();
+        {
+            for (auto& buffer_ptr : new_buffer_ptrs)
+            {
+                if (!allocator_ptrs.back()->add_buffer(buffer_ptr.get(),
+                                                       Anvil::MemoryFeatureFlagBits::NONE) )
+                {
+                    goto end;
+                }
+            }
+
+            if (!allocator_ptrs.back()->bake() )
+            {
+                goto end;
+            }
+        }
+        bake_time_usec     += BenchmarkUtils::get_time_usec         () - start_time_usec;
+        n_heap_allocations += BenchmarkUtils::get_n_heap_allocations() - n_heap_allocations_before;
+
+        for (auto& buffer_ptr : new_buffer_ptrs)
+        {
+            buffer_ptrs.push_back(std::move(buffer_ptr) );
+        }
+
+        new_buffer_ptrs.clear();
+    }
+
+    /* One-shot allocators only know about the buffers they have baked, so their counters need to be summed up */
+    for (const auto& allocator_ptr : allocator_ptrs)
+    {
+        const auto allocator_counters = allocator_ptr->get_counter_snapshot();
+
+        counters.n_allocations           += allocator_counters.n_allocations;
+        counters.n_bytes_allocated       += allocator_counters.n_bytes_allocated;
+        counters.n_bytes_used            += allocator_counters.n_bytes_used;
+        counters.n_device_memory_objects += allocator_counters.n_device_memory_objects;
+    }
+
+    if (allocator_ptrs.size() == 1)
+    {
+        Anvil::MemoryAllocator::MemoryStatisticsReport report;
+
+        allocator_ptrs.at(0)->get_statistics(&report);
+
+        fragmentation = report.total.fragmentation;
+    }
+
+    printf("%-9s  %13.2f  %12.2f  %16llu  %11u  %14.2f  %9.2f  ",
+           in_name,
+           static_cast<double>(bake_time_usec)    / 1000.0,
+           static_cast<double>(release_time_usec) / 1000.0,
+           static_cast<unsigned long long>(n_heap_allocations),
+           counters.n_device_memory_objects,
+           static_cast<double>(counters.n_bytes_allocated) / (1024.0 * 1024.0),
+           static_cast<double>(counters.n_bytes_used)      / (1024.0 * 1024.0) );
+
+    if (allocator_ptrs.size() == 1)
+    {
+        printf("%13.3f\n",
+               fragmentation);
+    }
+    else
+    {
+        printf("%13s\n",
+               "-");
+    }
+
+    result = true;
+end:
+    /* Buffers need to go out of scope before the allocators which have assigned memory to them */
+    new_buffer_ptrs.clear();
+    buffer_ptrs.clear    ();
+    allocator_ptrs.clear ();
+
+    return result;
+}
+
+int main()
+{
+    Anvil::BaseDeviceUniquePtr device_ptr;
+    Anvil::InstanceUniquePtr   instance_ptr;
+    int                        result = 1;
+
+    if (!BenchmarkUtils::create_device("AllocatorChurnBenchmark",
+                                      &instance_ptr,
+                                      &device_ptr) )
+    {
+        fprintf(stderr,
+                "Could not create a Vulkan device.\n");
+
+        goto end;
+    }
+
+    printf("%u rounds, %u live buffers, half of which are replaced per round\n\n"
+           "Allocator  Add+bake [ms]  Release [ms]  Heap allocations  Memory objs  Allocated [MB]  Used [MB]  Fragmentation\n",
+           N_ROUNDS,
+           N_BUFFERS);
+
+    if (!run_churn("One-shot",
+                   AllocatorType::ONESHOT,
+                   device_ptr.get() ) ||
+        !run_churn("TLSF",
+                   AllocatorType::TLSF,
+                   device_ptr.get() ) ||
+        !run_churn("VMA",
+                   AllocatorType::VMA,
+                   device_ptr.get() ))
+    {
+        fprintf(stderr,
+                "Could not assign memory to the buffers.\n");
+
+        goto end;
+    }
+
+    result = 0;
+end:
+    device_ptr.reset  ();
+    instance_ptr.reset();
+
+    return result;
+}
@@ -0,0 +1,110 @@
+//
+// Copyright (c) 2017-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "misc/debug.h"
+#include "wrappers/device.h"
+#include "wrappers/instance.h"
+#include "benchmark_utils.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+
+
+static std::atomic<uint64_t> g_n_heap_allocations(0);
+
+
+void* operator new(std::size_t in_size)
+{
+    void* result_ptr = nullptr;
+
+    ++g_n_heap_allocations;
+
+    result_ptr = malloc((in_size > 0) ? in_size : 1);
+
+    if (result_ptr == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+
+    return result_ptr;
+}
+
+void* operator new(std::size_t in_size, const std::nothrow_t&) noexcept
+{
+    ++g_n_heap_allocations;
+
+    return malloc((in_size > 0) ? in_size : 1);
+}
+
+void operator delete(void* in_ptr) noexcept
+{
+    free(in_ptr);
+}
+
+void operator delete(void* in_ptr, const std::nothrow_t&) noexcept
+{
+    free(in_ptr);
+}
+
+
+/* Please see header for specification */
+bool BenchmarkUtils::create_device(const char*                 in_app_name,
+                                   Anvil::InstanceUniquePtr*   out_instance_ptr,
+                                   Anvil::BaseDeviceUniquePtr* out_device_ptr)
+{
+    bool result = false;
+
+    *out_instance_ptr = Anvil::Instance::create(in_app_name,  /* in_app_name    */
+                                                in_app_name,  /* in_engine_name */
+                                                Anvil::DebugCallbackFunction(),
+                                                false); /* in_mt_safe */
+
+    if (*out_instance_ptr                           == nullptr ||
+        (*out_instance_ptr)->get_n_physical_devices() == 0)
+    {
+        goto end;
+    }
+
+    *out_device_ptr = Anvil::SGPUDevice::create((*out_instance_ptr)->get_physical_device(0),
+                                                false,                      /* in_enable_shader_module_cache           */
+                                                Anvil::DeviceExtensionConfiguration(),
+                                                std::vector<std::string>(), /* in_layers                               */
+                                                false,                      /* in_transient_command_buffer_allocs_only */
+                                                false);                     /* in_support_resettable_command_buffers   */
+
+    result = (*out_device_ptr != nullptr);
+end:
+    return result;
+}
+
+/* Please see header for specification */
+uint64_t BenchmarkUtils::get_n_heap_allocations()
+{
+    return g_n_heap_allocations.load();
+}
+
+/* Please see header for specification */
+uint64_t BenchmarkUtils::get_time_usec()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch() ).count() );
+}
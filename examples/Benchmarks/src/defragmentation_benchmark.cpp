@@ -0,0 +1,174 @@
+//
+// Copyright (c) 2017-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+/** Measures how much MemoryAllocator::defragment() reclaims from a fragmented VMA allocator.
+ *
+ *  Host-visible buffers of varying sizes are assigned memory, after which every other one is released. Memory
+ *  statistics are printed before and after defragmenting the remaining buffers, along with the defragmentation
+ *  stats and the time the call has taken.
+ **/
+#include "misc/buffer_create_info.h"
+#include "misc/memory_allocator.h"
+#include "wrappers/buffer.h"
+#include "wrappers/device.h"
+#include "wrappers/instance.h"
+#include "benchmark_utils.h"
+#include <cstdio>
+#include <vector>
+
+
+static const uint32_t N_BUFFERS = 4096;
+
+
+static void print_statistics(const char*                   in_label,
+                             const Anvil::MemoryAllocator* in_allocator_ptr)
+{
+    Anvil::MemoryAllocator::MemoryStatisticsReport report;
+
+    in_allocator_ptr->get_statistics(&report);
+
+    printf("%-6s  %11u  %14.2f  %9.2f  %9.2f  %11u  %18.2f  %13.3f\n",
+           in_label,
+           report.total.n_device_memory_objects,
+           static_cast<double>(report.total.n_bytes_allocated)  / (1024.0 * 1024.0),
+           static_cast<double>(report.total.n_bytes_used)       / (1024.0 * 1024.0),
+           static_cast<double>(report.total.n_bytes_free)       / (1024.0 * 1024.0),
+           report.total.n_free_ranges,
+           static_cast<double>(report.total.largest_free_range) / (1024.0 * 1024.0),
+           report.total.fragmentation);
+}
+
+int main()
+{
+    Anvil::MemoryAllocatorUniquePtr              allocator_ptr;
+    std::vector<Anvil::BufferUniquePtr>          buffer_ptrs;
+    std::vector<Anvil::Buffer*>                  buffer_raw_ptrs;
+    Anvil::BaseDeviceUniquePtr                   device_ptr;
+    Anvil::InstanceUniquePtr                     instance_ptr;
+    int                                          result = 1;
+    Anvil::MemoryAllocator::DefragmentationStats stats;
+    uint64_t                                     time_usec;
+
+    if (!BenchmarkUtils::create_device("DefragmentationBenchmark",
+                                      &instance_ptr,
+                                      &device_ptr) )
+    {
+        fprintf(stderr,
+                "Could not create a Vulkan device.\n");
+
+        goto end;
+    }
+
+    allocator_ptr = Anvil::MemoryAllocator::create_vma(device_ptr.get() );
+
+    for (uint32_t n_buffer = 0;
+                  n_buffer < N_BUFFERS;
+                ++n_buffer)
+    {
+        /* Sizes cycle between 4 KB and 64 KB, so that the holes left behind differ in size */
+        auto create_info_ptr = Anvil::BufferCreateInfo::create_no_alloc(device_ptr.get(),
+                                                                        static_cast<VkDeviceSize>(1 + n_buffer % 16) * 4096,
+                                                                        Anvil::QueueFamilyFlagBits::GRAPHICS_BIT,
+                                                                        Anvil::SharingMode::EXCLUSIVE,
+                                                                        Anvil::BufferCreateFlagBits::NONE,
+                                                                        Anvil::BufferUsageFlagBits::STORAGE_BUFFER_BIT);
+        auto buffer_ptr      = Anvil::Buffer::create(std::move(create_info_ptr) );
+
+        if (buffer_ptr == nullptr                                           ||
+            !allocator_ptr->add_buffer(buffer_ptr.get(),
+                                       Anvil::MemoryFeatureFlagBits::MAPPABLE_BIT) )
+        {
+            fprintf(stderr,
+                    "Could not create buffer %u.\n",
+                    n_buffer);
+
+            goto end;
+        }
+
+        buffer_ptrs.push_back(std::move(buffer_ptr) );
+    }
+
+    if (!allocator_ptr->bake() )
+    {
+        fprintf(stderr,
+                "Could not assign memory to the buffers.\n");
+
+        goto end;
+    }
+
+    for (uint32_t n_buffer = 0;
+                  n_buffer < N_BUFFERS;
+                ++n_buffer)
+    {
+        if ((n_buffer % 2) == 0)
+        {
+            buffer_ptrs.at(n_buffer).reset();
+        }
+        else
+        {
+            buffer_raw_ptrs.push_back(buffer_ptrs.at(n_buffer).get() );
+        }
+    }
+
+    printf("%u buffers, every other one released\n\n"
+           "        Memory objs  Allocated [MB]  Used [MB]  Free [MB]  Free ranges  Largest free [MB]  Fragmentation\n",
+           N_BUFFERS);
+
+    print_statistics("Before",
+                     allocator_ptr.get() );
+
+    time_usec = BenchmarkUtils::get_time_usec();
+
+    if (!allocator_ptr->defragment(static_cast<uint32_t>(buffer_raw_ptrs.size() ),
+                                   buffer_raw_ptrs.data(),
+                                   nullptr, /* in_opt_buffer_moved_callback_function */
+                                  &stats) )
+    {
+        fprintf(stderr,
+                "Defragmentation failed.\n");
+
+        goto end;
+    }
+
+    time_usec = BenchmarkUtils::get_time_usec() - time_usec;
+
+    print_statistics("After",
+                     allocator_ptr.get() );
+
+    printf("\nDefragmentation took %.2f ms: %u allocations (%.2f MB) moved, %u memory objects (%.2f MB) freed\n",
+           static_cast<double>(time_usec) / 1000.0,
+           stats.n_allocations_moved,
+           static_cast<double>(stats.n_bytes_moved) / (1024.0 * 1024.0),
+           stats.n_device_memory_objects_freed,
+           static_cast<double>(stats.n_bytes_freed) / (1024.0 * 1024.0) );
+
+    result = 0;
+end:
+    buffer_raw_ptrs.clear();
+    buffer_ptrs.clear    ();
+    allocator_ptr.reset  ();
+    device_ptr.reset     ();
+    instance_ptr.reset   ();
+
+    return result;
+}
@@ -0,0 +1,195 @@
+//
+// Copyright (c) 2017-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/** Measures how long it takes to record 100k commands into a primary command buffer, and how many heap
+ *  allocations the recording makes.
+ *
+ *  Commands alternate between vertex buffer bindings, pipeline barriers and event waits. Each of these builds
+ *  an array of Vulkan handles or barrier descriptors per call. The command buffers are never submitted.
+ **/
+#include "misc/buffer_create_info.h"
+#include "misc/event_create_info.h"
+#include "misc/memory_allocator.h"
+#include "wrappers/buffer.h"
+#include "wrappers/command_buffer.h"
+#include "wrappers/command_pool.h"
+#include "wrappers/device.h"
+#include "wrappers/event.h"
+#include "wrappers/instance.h"
+#include "wrappers/queue.h"
+#include "benchmark_utils.h"
+#include <cstdio>
+
+
+static const uint32_t N_COMMANDS   = 100000;
+static const uint32_t N_ITERATIONS = 5;
+
+
+int main()
+{
+    Anvil::MemoryAllocatorUniquePtr allocator_ptr;
+    Anvil::BaseDeviceUniquePtr      device_ptr;
+    Anvil::EventUniquePtr           event_ptr;
+    Anvil::InstanceUniquePtr        instance_ptr;
+    Anvil::BufferUniquePtr          vertex_buffer_ptr;
+    int                             result = 1;
+
+    /* Commands stashed by STORE_COMMAND_BUFFER_COMMANDS builds would dominate the allocation count */
+    Anvil::CommandBufferBase::disable_comand_stashing();
+
+    if (!BenchmarkUtils::create_device("RecordingBenchmark",
+                                      &instance_ptr,
+                                      &device_ptr) )
+    {
+        fprintf(stderr,
+                "Could not create a Vulkan device.\n");
+
+        goto end;
+    }
+
+    {
+        auto create_info_ptr = Anvil::BufferCreateInfo::create_no_alloc(device_ptr.get(),
+                                                                        4096, /* in_size */
+                                                                        Anvil::QueueFamilyFlagBits::GRAPHICS_BIT,
+                                                                        Anvil::SharingMode::EXCLUSIVE,
+                                                                        Anvil::BufferCreateFlagBits::NONE,
+                                                                        Anvil::BufferUsageFlagBits::VERTEX_BUFFER_BIT);
+
+        allocator_ptr     = Anvil::MemoryAllocator::create_oneshot(device_ptr.get() );
+        vertex_buffer_ptr = Anvil::Buffer::create                 (std::move(create_info_ptr) );
+
+        if (vertex_buffer_ptr == nullptr                                                  ||
+            !allocator_ptr->add_buffer(vertex_buffer_ptr.get(),
+                                       Anvil::MemoryFeatureFlagBits::NONE)                ||
+            !allocator_ptr->bake() )
+        {
+            fprintf(stderr,
+                    "Could not create the vertex buffer.\n");
+
+            goto end;
+        }
+    }
+
+    event_ptr = Anvil::Event::create(Anvil::EventCreateInfo::create(device_ptr.get() ));
+
+    if (event_ptr == nullptr)
+    {
+        fprintf(stderr,
+                "Could not create the event.\n");
+
+        goto end;
+    }
+
+    printf("Recording %u commands per command buffer\n\n"
+           "Iteration  Time [ms]  Time per command [ns]  Heap allocations\n",
+           N_COMMANDS);
+
+    for (uint32_t n_iteration = 0;
+                  n_iteration < N_ITERATIONS;
+                ++n_iteration)
+    {
+        const Anvil::MemoryBarrier           barrier               (Anvil::AccessFlagBits::SHADER_READ_BIT,   /* in_destination_access_mask */
+                                                                    Anvil::AccessFlagBits::SHADER_WRITE_BIT); /* in_source_access_mask      */
+        auto                                 universal_queue_ptr   = device_ptr->get_universal_queue(0);
+        Anvil::PrimaryCommandBufferUniquePtr cmd_buffer_ptr        = device_ptr->get_command_pool_for_queue_family_index(universal_queue_ptr->get_queue_family_index() )->alloc_primary_level_command_buffer();
+        Anvil::Event*                        event_raw_ptr         = event_ptr.get();
+        uint64_t                             n_heap_allocations;
+        uint64_t                             start_time_usec;
+        uint64_t                             time_usec;
+        Anvil::Buffer*                       vertex_buffer_raw_ptr = vertex_buffer_ptr.get();
+        const VkDeviceSize                   vertex_buffer_offset  = 0;
+
+        cmd_buffer_ptr->start_recording(true,   /* in_one_time_submit          */
+                                        false); /* in_simultaneous_use_allowed */
+
+        n_heap_allocations = BenchmarkUtils::get_n_heap_allocations();
+        start_time_usec    = BenchmarkUtils::get_time_usec         ();
+
+        for (uint32_t n_command = 0;
+                      n_command < N_COMMANDS;
+                    ++n_command)
+        {
+            switch (n_command % 3)
+            {
+                case 0:
+                {
+                    cmd_buffer_ptr->record_bind_vertex_buffers(0, /* in_start_binding */
+                                                               1, /* in_binding_count */
+                                                              &vertex_buffer_raw_ptr,
+                                                              &vertex_buffer_offset);
+
+                    break;
+                }
+
+                case 1:
+                {
+                    cmd_buffer_ptr->record_pipeline_barrier(Anvil::PipelineStageFlagBits::COMPUTE_SHADER_BIT,
+                                                            Anvil::PipelineStageFlagBits::COMPUTE_SHADER_BIT,
+                                                            Anvil::DependencyFlagBits::NONE,
+                                                            1, /* in_memory_barrier_count */
+                                                           &barrier,
+                                                            0,        /* in_buffer_memory_barrier_count */
+                                                            nullptr,  /* in_buffer_memory_barriers_ptr  */
+                                                            0,        /* in_image_memory_barrier_count  */
+                                                            nullptr); /* in_image_memory_barriers_ptr   */
+
+                    break;
+                }
+
+                default:
+                {
+                    cmd_buffer_ptr->record_wait_events(1, /* in_event_count */
+                                                      &event_raw_ptr,
+                                                       Anvil::PipelineStageFlagBits::COMPUTE_SHADER_BIT,
+                                                       Anvil::PipelineStageFlagBits::COMPUTE_SHADER_BIT,
+                                                       1, /* in_memory_barrier_count */
+                                                      &barrier,
+                                                       0,        /* in_buffer_memory_barrier_count */
+                                                       nullptr,  /* in_buffer_memory_barriers_ptr  */
+                                                       0,        /* in_image_memory_barrier_count  */
+                                                       nullptr); /* in_image_memory_barriers_ptr   */
+                }
+            }
+        }
+
+        time_usec          = BenchmarkUtils::get_time_usec         () - start_time_usec;
+        n_heap_allocations = BenchmarkUtils::get_n_heap_allocations() - n_heap_allocations;
+
+        cmd_buffer_ptr->stop_recording();
+
+        printf("%9u  %9.2f  %21.1f  %16llu\n",
+               n_iteration,
+               static_cast<double>(time_usec) / 1000.0,
+               static_cast<double>(time_usec) * 1000.0 / static_cast<double>(N_COMMANDS),
+               static_cast<unsigned long long>(n_heap_allocations) );
+    }
+
+    result = 0;
+end:
+    event_ptr.reset        ();
+    vertex_buffer_ptr.reset();
+    allocator_ptr.reset    ();
+    device_ptr.reset       ();
+    instance_ptr.reset     ();
+
+    return result;
+}
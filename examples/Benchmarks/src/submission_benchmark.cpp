@@ -0,0 +1,192 @@
+//
+// Copyright (c) 2017-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/** Counts heap allocations made by Queue::submit().
+ *
+ *  A pre-recorded command buffer is submitted many times, first on its own and then chained with semaphores, so
+ *  that each submission waits on the semaphore signalled by the previous one. Each submission blocks until it has
+ *  finished executing. Run the benchmark against a null driver, by pointing VK_ICD_FILENAMES at its ICD manifest,
+ *  to keep the driver's own cost out of the timings and allocation counts.
+ **/
+#include "misc/semaphore_create_info.h"
+#include "wrappers/command_buffer.h"
+#include "wrappers/command_pool.h"
+#include "wrappers/device.h"
+#include "wrappers/instance.h"
+#include "wrappers/queue.h"
+#include "wrappers/semaphore.h"
+#include "benchmark_utils.h"
+#include <cstdio>
+
+
+static const uint32_t N_SUBMISSIONS        = 10000;
+static const uint32_t N_WARMUP_SUBMISSIONS = 16;
+
+
+/** Submits the command buffer N_WARMUP_SUBMISSIONS + N_SUBMISSIONS times and prints stats for the last
+ *  N_SUBMISSIONS submissions.
+ *
+ *  @param in_semaphore_ptrs Two semaphores to chain the submissions with, or nullptr to submit the command buffer
+ *                           on its own.
+ *
+ *  @return true if all submissions have succeeded, false otherwise.
+ **/
+static bool run_submissions(const char*                        in_name,
+                            Anvil::Queue*                      in_queue_ptr,
+                            Anvil::PrimaryCommandBuffer*       in_cmd_buffer_ptr,
+                            Anvil::Semaphore* const*           in_semaphore_ptrs)
+{
+    uint64_t                        n_heap_allocations = 0;
+    bool                            result             = true;
+    uint64_t                        start_time_usec    = 0;
+    const Anvil::PipelineStageFlags wait_stage_mask    = Anvil::PipelineStageFlagBits::ALL_COMMANDS_BIT;
+
+    for (uint32_t n_submission = 0;
+                  n_submission < N_WARMUP_SUBMISSIONS + N_SUBMISSIONS && result;
+                ++n_submission)
+    {
+        if (n_submission == N_WARMUP_SUBMISSIONS)
+        {
+            n_heap_allocations = BenchmarkUtils::get_n_heap_allocations();
+            start_time_usec    = BenchmarkUtils::get_time_usec         ();
+        }
+
+        if (in_semaphore_ptrs == nullptr)
+        {
+            result = in_queue_ptr->submit(
+                Anvil::SubmitInfo::create_execute(in_cmd_buffer_ptr,
+                                                  true) /* in_should_block */
+            );
+        }
+        else
+        {
+            Anvil::Semaphore* signal_semaphore_ptr = in_semaphore_ptrs[n_submission       % 2];
+            Anvil::Semaphore* wait_semaphore_ptr   = in_semaphore_ptrs[(n_submission + 1) % 2];
+
+            /* The first submission has nothing to wait on */
+
+            result = in_queue_ptr->submit(
+                Anvil::SubmitInfo::create_wait_execute_signal(in_cmd_buffer_ptr,
+                                                              1, /* in_n_semaphores_to_signal */
+                                                             &signal_semaphore_ptr,
+                                                              (n_submission > 0) ? 1u : 0u,
+                                                             &wait_semaphore_ptr,
+                                                             &wait_stage_mask,
+                                                              true) /* in_should_block */
+            );
+        }
+    }
+
+    if (result)
+    {
+        const uint64_t time_usec = BenchmarkUtils::get_time_usec() - start_time_usec;
+
+        n_heap_allocations = BenchmarkUtils::get_n_heap_allocations() - n_heap_allocations;
+
+        printf("%-22s  %18.2f  %26.3f\n",
+               in_name,
+               static_cast<double>(time_usec)          / static_cast<double>(N_SUBMISSIONS),
+               static_cast<double>(n_heap_allocations) / static_cast<double>(N_SUBMISSIONS) );
+    }
+
+    return result;
+}
+
+int main()
+{
+    Anvil::PrimaryCommandBufferUniquePtr cmd_buffer_ptr;
+    Anvil::BaseDeviceUniquePtr           device_ptr;
+    Anvil::InstanceUniquePtr             instance_ptr;
+    Anvil::Queue*                        queue_ptr      = nullptr;
+    int                                  result         = 1;
+    Anvil::SemaphoreUniquePtr            semaphore_ptrs[2];
+    Anvil::Semaphore*                    semaphore_raw_ptrs[2];
+
+    if (!BenchmarkUtils::create_device("SubmissionBenchmark",
+                                      &instance_ptr,
+                                      &device_ptr) )
+    {
+        fprintf(stderr,
+                "Could not create a Vulkan device.\n");
+
+        goto end;
+    }
+
+    queue_ptr      = device_ptr->get_universal_queue(0);
+    cmd_buffer_ptr = device_ptr->get_command_pool_for_queue_family_index(queue_ptr->get_queue_family_index() )->alloc_primary_level_command_buffer();
+
+    /* Submissions never overlap, so the command buffer does not need to support simultaneous use */
+    cmd_buffer_ptr->start_recording(false,  /* in_one_time_submit          */
+                                    false); /* in_simultaneous_use_allowed */
+    cmd_buffer_ptr->stop_recording ();
+
+    for (uint32_t n_semaphore = 0;
+                  n_semaphore < 2;
+                ++n_semaphore)
+    {
+        semaphore_ptrs    [n_semaphore] = Anvil::Semaphore::create(Anvil::SemaphoreCreateInfo::create(device_ptr.get() ));
+        semaphore_raw_ptrs[n_semaphore] = semaphore_ptrs[n_semaphore].get();
+
+        if (semaphore_raw_ptrs[n_semaphore] == nullptr)
+        {
+            fprintf(stderr,
+                    "Could not create a semaphore.\n");
+
+            goto end;
+        }
+    }
+
+    printf("Submitting %u times after %u warm-up submissions\n\n"
+           "Submission type         Time per submit [us]  Heap allocations per submit\n",
+           N_SUBMISSIONS,
+           N_WARMUP_SUBMISSIONS);
+
+    if (!run_submissions("Command buffer only",
+                         queue_ptr,
+                         cmd_buffer_ptr.get(),
+                         nullptr) ||
+        !run_submissions("Semaphore chain",
+                         queue_ptr,
+                         cmd_buffer_ptr.get(),
+                         semaphore_raw_ptrs) )
+    {
+        fprintf(stderr,
+                "Submission failed.\n");
+
+        goto end;
+    }
+
+    result = 0;
+end:
+    if (device_ptr != nullptr)
+    {
+        device_ptr->wait_idle();
+    }
+
+    semaphore_ptrs[0].reset();
+    semaphore_ptrs[1].reset();
+    cmd_buffer_ptr.reset   ();
+    device_ptr.reset       ();
+    instance_ptr.reset     ();
+
+    return result;
+}
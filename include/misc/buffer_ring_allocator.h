@@ -0,0 +1,214 @@
+//
+// Copyright (c) 2017-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/** Defines a linear allocator for per-frame uniform & storage data, which lives in a single, persistently mapped,
+ *  host-visible buffer.
+ *
+ *  The buffer is split into N frame slots. Each frame, begin_frame() moves to the next slot and rewinds its bump
+ *  pointer, after waiting for the fence which has been associated with the slot the last time it was used.
+ *  Sub-allocations are then carved out of the slot with allocate(), written directly through the returned pointer,
+ *  and bound with dynamic offsets:
+ *
+ *      ring_ptr->begin_frame();
+ *
+ *      ring_ptr->push(per_draw_data, &dynamic_offset);
+ *      cmd_buffer_ptr->record_bind_descriptor_sets(..., 1, &dynamic_offset);
+ *
+ *      ring_ptr->end_frame(frame_fence_ptr);
+ *
+ *  Descriptor sets should bind get_buffer() as a dynamic uniform or storage buffer, at offset 0 and with a range
+ *  covering the largest sub-allocation which is going to be accessed through them.
+ *
+ *  Not thread-safe.
+ **/
+#ifndef MISC_BUFFER_RING_ALLOCATOR_H
+#define MISC_BUFFER_RING_ALLOCATOR_H
+
+#include "misc/types.h"
+
+
+namespace Anvil
+{
+    class BufferRingAllocator
+    {
+    public:
+        /* Public type definitions */
+        typedef struct Allocation
+        {
+            /* Host pointer to the sub-allocation's storage */
+            void* data_ptr;
+
+            /* Offset of the sub-allocation, relative to the start of the buffer. Always a multiple of get_alignment(). */
+            VkDeviceSize offset;
+
+            VkDeviceSize size;
+
+            Allocation()
+                :data_ptr(nullptr),
+                 offset  (0),
+                 size    (0)
+            {
+                /* Stub */
+            }
+
+            /** Returns the offset in a form which can be passed to record_bind_descriptor_sets() as a dynamic offset. */
+            uint32_t get_dynamic_offset() const
+            {
+                return static_cast<uint32_t>(offset);
+            }
+        } Allocation;
+
+        /* Public functions */
+
+        /** Creates a new ring allocator instance.
+         *
+         *  @param in_device_ptr       Device to create the buffer on. Must not be nullptr.
+         *  @param in_frame_slot_size  Number of bytes which can be allocated per frame. Will be rounded up to
+         *                             the allocator's alignment.
+         *  @param in_n_frame_slots    Number of frame slots. Should be at least the number of frames in flight.
+         *  @param in_usage_flags      Usage flags of the buffer. Sub-allocations are aligned to the requirements
+         *                             of all uniform, storage and texel buffer usages specified here.
+         *  @param in_queue_families   Queue families which are going to read from the buffer.
+         *
+         *  @return New instance or nullptr, if the buffer could not be created or mapped.
+         **/
+        static Anvil::BufferRingAllocatorUniquePtr create(const Anvil::BaseDevice* in_device_ptr,
+                                                          VkDeviceSize             in_frame_slot_size,
+                                                          uint32_t                 in_n_frame_slots,
+                                                          Anvil::BufferUsageFlags  in_usage_flags    = Anvil::BufferUsageFlagBits::UNIFORM_BUFFER_BIT | Anvil::BufferUsageFlagBits::STORAGE_BUFFER_BIT,
+                                                          Anvil::QueueFamilyFlags  in_queue_families = Anvil::QueueFamilyFlagBits::GRAPHICS_BIT);
+
+        /** Destructor. Unmaps and releases the buffer. */
+        ~BufferRingAllocator();
+
+        /** Carves a sub-allocation of the specified size out of the current frame slot.
+         *
+         *  Must be called between begin_frame() and end_frame(). Data written to the sub-allocation becomes
+         *  visible to the device at end_frame() time.
+         *
+         *  @param in_size            Number of bytes to allocate. Must not be 0.
+         *  @param out_allocation_ptr Deref will be set to the sub-allocation's properties. Must not be nullptr.
+         *
+         *  @return true if successful, false if the current frame slot has run out of space.
+         **/
+        bool allocate(VkDeviceSize in_size,
+                      Allocation*  out_allocation_ptr);
+
+        /** Allocates space for the specified data, copies it there and returns the dynamic offset at which
+         *  it can be accessed.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool allocate_and_write(VkDeviceSize in_size,
+                                const void*  in_data_ptr,
+                                uint32_t*    out_dynamic_offset_ptr);
+
+        /** Moves to the next frame slot and makes it available for new sub-allocations.
+         *
+         *  If a fence has been associated with the slot by an earlier end_frame() call, the function blocks until
+         *  the fence is signalled. The fence must not be reset between the end_frame() and begin_frame() calls.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool begin_frame();
+
+        /** Finishes the current frame. Data written to non-coherent memory is flushed with a single call.
+         *
+         *  @param in_opt_fence_ptr Fence which is going to be signalled once the device has finished reading
+         *                          all sub-allocations made in the current frame. If nullptr, the slot is reused
+         *                          without waiting, so the app needs to ensure this is safe on its own.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool end_frame(Anvil::Fence* in_opt_fence_ptr);
+
+        /** Returns the alignment all sub-allocations adhere to. */
+        VkDeviceSize get_alignment() const
+        {
+            return m_alignment;
+        }
+
+        /** Returns the buffer sub-allocations are made from. */
+        Anvil::Buffer* get_buffer() const
+        {
+            return m_buffer_ptr.get();
+        }
+
+        /** Returns the index of the frame slot sub-allocations are currently made from. */
+        uint32_t get_current_frame_slot() const
+        {
+            return m_n_current_frame_slot;
+        }
+
+        /** Returns the size of a single frame slot, in bytes. */
+        VkDeviceSize get_frame_slot_size() const
+        {
+            return m_frame_slot_size;
+        }
+
+        /** Returns the number of bytes which have been allocated in the current frame slot so far, including
+         *  alignment padding. */
+        VkDeviceSize get_n_bytes_used() const
+        {
+            return m_n_bytes_used;
+        }
+
+        /** Convenience wrapper for allocate_and_write(). */
+        template<typename DataType>
+        bool push(const DataType& in_data,
+                  uint32_t*       out_dynamic_offset_ptr)
+        {
+            return allocate_and_write(sizeof(DataType),
+                                     &in_data,
+                                      out_dynamic_offset_ptr);
+        }
+
+    private:
+        /* Private functions */
+        BufferRingAllocator(const Anvil::BaseDevice* in_device_ptr,
+                            VkDeviceSize             in_frame_slot_size,
+                            uint32_t                 in_n_frame_slots);
+
+        bool init(Anvil::BufferUsageFlags in_usage_flags,
+                  Anvil::QueueFamilyFlags in_queue_families);
+
+        /* Private variables */
+        VkDeviceSize                m_alignment;
+        Anvil::BufferUniquePtr      m_buffer_ptr;
+        const Anvil::BaseDevice*    m_device_ptr;
+        std::vector<Anvil::Fence*>  m_frame_slot_fences;
+        VkDeviceSize                m_frame_slot_size;
+        bool                        m_frame_started;
+        bool                        m_is_coherent;
+        uint8_t*                    m_mapped_data_ptr;
+        VkDeviceSize                m_memory_offset;      /* Offset of the buffer's storage within its VkDeviceMemory */
+        Anvil::MemoryBlock*         m_memory_block_ptr;
+        VkDeviceSize                m_memory_size;        /* Size of the VkDeviceMemory region backing the buffer      */
+        VkDeviceSize                m_n_bytes_used;
+        uint32_t                    m_n_current_frame_slot;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(BufferRingAllocator);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(BufferRingAllocator);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_BUFFER_RING_ALLOCATOR_H */
@@ -0,0 +1,255 @@
+//
+// Copyright (c) 2017-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/** Defines a compact, linear command stream which can be recorded once and replayed into any
+ *  number of command buffers.
+ *
+ *  Commands are stored back-to-back in a single byte array. Each command starts with a CommandHeader,
+ *  followed by a fixed-size payload and, optionally, variable-length arrays. The byte array does not
+ *  contain any pointers: Anvil objects are referred to by indices into a separate object table, so the
+ *  byte array (see get_data_ptr()) can be dumped to disk for offline analysis. Streams themselves are
+ *  neither copyable nor assignable.
+ *
+ *  In addition, the stream keeps the object pointers of descriptor set and vertex buffer arrays in the order
+ *  they were recorded, so that replay() can pass them on without any scratch storage.
+ *
+ *  Objects are only resolved to Vulkan handles at replay time. This means that a stream stays valid if,
+ *  for instance, a descriptor set is updated between replays. The objects must stay alive for as long as
+ *  the stream is replayed.
+ **/
+#ifndef MISC_COMMAND_STREAM_H
+#define MISC_COMMAND_STREAM_H
+
+#include "misc/types.h"
+#include <unordered_map>
+
+
+namespace Anvil
+{
+    class CommandStream
+    {
+    public:
+        /* Public type definitions */
+
+        enum class CommandType : uint16_t
+        {
+            BIND_DESCRIPTOR_SETS,
+            BIND_INDEX_BUFFER,
+            BIND_PIPELINE,
+            BIND_VERTEX_BUFFERS,
+            DISPATCH,
+            DISPATCH_INDIRECT,
+            DRAW,
+            DRAW_INDEXED,
+            DRAW_INDEXED_INDIRECT,
+            DRAW_INDIRECT,
+            PUSH_CONSTANTS,
+            SET_BLEND_CONSTANTS,
+            SET_DEPTH_BIAS,
+            SET_LINE_WIDTH,
+            SET_SCISSOR,
+            SET_STENCIL_REFERENCE,
+            SET_VIEWPORT,
+
+            COUNT
+        };
+
+        /** Prefixes each command in the stream. */
+        typedef struct CommandHeader
+        {
+            /* One of CommandType values */
+            uint16_t type;
+            uint16_t padding;
+
+            /* Size of the command in bytes, including the header. Always a multiple of 8. */
+            uint32_t size;
+        } CommandHeader;
+
+        /* Public functions */
+
+        /** Creates a new, empty command stream. */
+        static Anvil::CommandStreamUniquePtr create();
+
+        /** Destructor. */
+        ~CommandStream();
+
+        /** Removes all commands and objects from the stream. Allocated memory is retained. */
+        void clear();
+
+        /** Returns a pointer to the raw command data. Can be used to serialize the stream.
+         *
+         *  The pointer becomes invalid as soon as any new command is recorded.
+         **/
+        const uint8_t* get_data_ptr() const
+        {
+            return (m_data.size() > 0) ? &m_data.at(0)
+                                       : nullptr;
+        }
+
+        /** Returns the number of bytes of command data. */
+        uint32_t get_data_size() const
+        {
+            return static_cast<uint32_t>(m_data.size() );
+        }
+
+        /** Returns the number of commands recorded into the stream. */
+        uint32_t get_n_commands() const
+        {
+            return m_n_commands;
+        }
+
+        /** Returns the number of objects the commands refer to. */
+        uint32_t get_n_objects() const
+        {
+            return static_cast<uint32_t>(m_objects.size() );
+        }
+
+        /** Returns the object with the specified index, along with its type.
+         *
+         *  @param in_n_object      Object index, as stored in the command data.
+         *  @param out_opt_type_ptr If not nullptr, deref will be set to the type of the object.
+         *
+         *  @return Pointer to the object or nullptr if @param in_n_object is invalid.
+         **/
+        const void* get_object(uint32_t           in_n_object,
+                               Anvil::ObjectType* out_opt_type_ptr = nullptr) const;
+
+        /* Recording functions. Arguments are interpreted exactly as by the CommandBufferBase functions
+         * of the same name. All of them return true if the command has been recorded successfully. */
+        bool record_bind_descriptor_sets (Anvil::PipelineBindPoint           in_pipeline_bind_point,
+                                          Anvil::PipelineLayout*             in_layout_ptr,
+                                          uint32_t                           in_first_set,
+                                          uint32_t                           in_set_count,
+                                          const Anvil::DescriptorSet* const* in_descriptor_set_ptrs,
+                                          uint32_t                           in_dynamic_offset_count,
+                                          const uint32_t*                    in_dynamic_offset_ptrs);
+        bool record_bind_index_buffer    (Anvil::Buffer*                     in_buffer_ptr,
+                                          VkDeviceSize                       in_offset,
+                                          Anvil::IndexType                   in_index_type);
+        bool record_bind_pipeline        (Anvil::PipelineBindPoint           in_pipeline_bind_point,
+                                          Anvil::PipelineID                  in_pipeline_id);
+        bool record_bind_vertex_buffers  (uint32_t                           in_start_binding,
+                                          uint32_t                           in_binding_count,
+                                          Anvil::Buffer**                    in_buffer_ptrs,
+                                          const VkDeviceSize*                in_offset_ptrs);
+        bool record_dispatch             (uint32_t                           in_x,
+                                          uint32_t                           in_y,
+                                          uint32_t                           in_z);
+        bool record_dispatch_indirect    (Anvil::Buffer*                     in_buffer_ptr,
+                                          VkDeviceSize                       in_offset);
+        bool record_draw                 (uint32_t                           in_vertex_count,
+                                          uint32_t                           in_instance_count,
+                                          uint32_t                           in_first_vertex,
+                                          uint32_t                           in_first_instance);
+        bool record_draw_indexed         (uint32_t                           in_index_count,
+                                          uint32_t                           in_instance_count,
+                                          uint32_t                           in_first_index,
+                                          int32_t                            in_vertex_offset,
+                                          uint32_t                           in_first_instance);
+        bool record_draw_indexed_indirect(Anvil::Buffer*                     in_buffer_ptr,
+                                          VkDeviceSize                       in_offset,
+                                          uint32_t                           in_draw_count,
+                                          uint32_t                           in_stride);
+        bool record_draw_indirect        (Anvil::Buffer*                     in_buffer_ptr,
+                                          VkDeviceSize                       in_offset,
+                                          uint32_t                           in_count,
+                                          uint32_t                           in_stride);
+        bool record_push_constants       (Anvil::PipelineLayout*             in_layout_ptr,
+                                          Anvil::ShaderStageFlags            in_stage_flags,
+                                          uint32_t                           in_offset,
+                                          uint32_t                           in_size,
+                                          const void*                        in_values);
+        bool record_set_blend_constants  (const float                        in_blend_constants[4]);
+        bool record_set_depth_bias       (float                              in_depth_bias_constant_factor,
+                                          float                              in_depth_bias_clamp,
+                                          float                              in_slope_scaled_depth_bias);
+        bool record_set_line_width       (float                              in_line_width);
+        bool record_set_scissor          (uint32_t                           in_first_scissor,
+                                          uint32_t                           in_scissor_count,
+                                          const VkRect2D*                    in_scissor_ptrs);
+        bool record_set_stencil_reference(Anvil::StencilFaceFlags            in_face_mask,
+                                          uint32_t                           in_stencil_reference);
+        bool record_set_viewport         (uint32_t                           in_first_viewport,
+                                          uint32_t                           in_viewport_count,
+                                          const VkViewport*                  in_viewport_ptrs);
+
+        /** Records all commands stored in the stream into the specified command buffer, in order.
+         *
+         *  Can be called any number of times, for any number of command buffers, including concurrently from
+         *  multiple threads. Does not allocate any memory. The command buffer must be in the recording state.
+         *  CommandBufferBase::record_command_stream() is the usual entry-point. Each command goes through the
+         *  regular CommandBufferBase::record_*() path, so all per-command buffer features (eg. redundant state
+         *  filtering) apply.
+         *
+         *  @param in_command_buffer_ptr Command buffer to replay the stream into. Must not be nullptr.
+         *
+         *  @return true if all commands have been replayed successfully, false otherwise.
+         **/
+        bool replay(Anvil::CommandBufferBase* in_command_buffer_ptr) const;
+
+    private:
+        /* Private type definitions */
+        typedef struct ObjectEntry
+        {
+            const void*       object_ptr;
+            Anvil::ObjectType type;
+
+            ObjectEntry(const void*       in_object_ptr,
+                        Anvil::ObjectType in_type)
+                :object_ptr(in_object_ptr),
+                 type      (in_type)
+            {
+                /* Stub */
+            }
+        } ObjectEntry;
+
+        /* Private functions */
+        CommandStream();
+
+        uint32_t begin_command(CommandType       in_type);
+        void     end_command  (uint32_t          in_command_offset);
+        uint32_t get_object_id(const void*       in_object_ptr,
+                               Anvil::ObjectType in_type);
+        void     write        (const void*       in_data_ptr,
+                               uint32_t          in_n_bytes);
+
+        template<typename PayloadType>
+        void write(const PayloadType& in_payload)
+        {
+            write(&in_payload,
+                  sizeof(PayloadType) );
+        }
+
+        /* Private variables */
+        std::vector<Anvil::Buffer*>               m_buffer_ptrs;
+        std::vector<uint8_t>                      m_data;
+        std::vector<const Anvil::DescriptorSet*>  m_descriptor_set_ptrs;
+        uint32_t                                  m_n_commands;
+        std::unordered_map<const void*, uint32_t> m_object_id_map;
+        std::vector<ObjectEntry>                  m_objects;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(CommandStream);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(CommandStream);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_COMMAND_STREAM_H */
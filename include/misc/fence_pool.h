@@ -0,0 +1,108 @@
+//
+// Copyright (c) 2017-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+/** Defines a pool of reusable fences, owned by a device.
+ *
+ *  Fences handed out by acquire() are unsignalled. Releasing the returned FenceUniquePtr gives the fence back
+ *  to the pool, rather than destroying it. This can happen at any time, including while the work the fence has
+ *  been submitted with is still executing: fences which are not signalled at release time are only reused once
+ *  they become signalled. Signalled fences are reset in batches, with a single Vulkan call.
+ *
+ *  Destroying the FenceUniquePtr assumes the fence has been submitted. Fences which may not have been, for instance
+ *  because the submission failed, must be returned with release(), as they would otherwise never be reused.
+ *
+ *  All fences acquired from a pool must be released before the owning device is destroyed.
+ *
+ *  MT-safe if the pool has been created with MT safety enabled.
+ **/
+#ifndef MISC_FENCE_POOL_H
+#define MISC_FENCE_POOL_H
+
+#include "misc/mt_safety.h"
+#include "misc/types.h"
+#include <deque>
+
+
+namespace Anvil
+{
+    class FencePool : public MTSafetySupportProvider
+    {
+    public:
+        /* Public functions */
+
+        /** Creates a new, empty fence pool. Fences are created on demand.
+         *
+         *  @param in_device_ptr Device to create fences for. Must not be nullptr.
+         *  @param in_mt_safe    true if the pool, and the fences it creates, should be MT-safe.
+         **/
+        static Anvil::FencePoolUniquePtr create(const Anvil::BaseDevice* in_device_ptr,
+                                                bool                     in_mt_safe);
+
+        /** Destructor. Destroys all fences owned by the pool. */
+        ~FencePool();
+
+        /** Returns an unsignalled fence. A new fence is created if none of the pooled ones can be reused.
+         *
+         *  @return Fence wrapper, whose deleter returns the fence to the pool, or nullptr if a new fence was
+         *          needed, but could not be created.
+         **/
+        Anvil::FenceUniquePtr acquire();
+
+        /** Returns the number of fences the pool has created so far. */
+        uint32_t get_n_fences_created() const
+        {
+            return static_cast<uint32_t>(m_fence_ptrs.size() );
+        }
+
+        /** Returns a fence to the pool.
+         *
+         *  @param in_fence_ptr     Fence to return. Must have been acquired from this pool. May be nullptr, in which
+         *                          case the call is a no-op.
+         *  @param in_was_submitted true if the fence has been submitted, false otherwise. Fences which have not been
+         *                          submitted become available straight away.
+         **/
+        void release(Anvil::FenceUniquePtr in_fence_ptr,
+                     bool                  in_was_submitted);
+
+    private:
+        /* Private functions */
+        FencePool(const Anvil::BaseDevice* in_device_ptr,
+                  bool                     in_mt_safe);
+
+        void release_internal(Anvil::Fence* in_fence_ptr,
+                              bool          in_was_submitted);
+
+        /* Private variables */
+        std::vector<Anvil::Fence*>         m_available_fence_ptrs; /* Unsignalled and not in use                 */
+        const Anvil::BaseDevice*           m_device_ptr;
+        std::vector<Anvil::FenceUniquePtr> m_fence_ptrs;           /* All fences created by the pool             */
+        std::deque<Anvil::Fence*>          m_pending_fence_ptrs;   /* Released while unsignalled, oldest first   */
+        std::vector<VkFence>               m_scratch_fences_vk;
+        std::vector<Anvil::Fence*>         m_signalled_fence_ptrs; /* Signalled and not in use, need resetting   */
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(FencePool);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(FencePool);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_FENCE_POOL_H */
@@ -0,0 +1,205 @@
+//
+// Copyright (c) 2017-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/** Defines a frames-in-flight manager, which bundles all per-frame synchronization objects and storage:
+ *
+ *  - a fence, signalled once the device finishes executing the frame's work.
+ *  - a semaphore, signalled once the swapchain image acquired for the frame becomes available.
+ *  - a semaphore, signalled once the frame's work finishes and the image can be presented.
+ *  - a command pool, reset at the beginning of the frame. Command buffers allocated from it and released
+ *    by the app within the frame are recycled.
+ *  - optionally, a slot of a BufferRingAllocator for per-frame uniform & storage data.
+ *
+ *  The manager owns N frame slots, which are used in a round-robin fashion. begin_frame() only waits for the
+ *  fence of the slot it is about to reuse, so the CPU can record up to N frames ahead of the device:
+ *
+ *      frame_context_ptr->begin_frame();
+ *
+ *      image_index = frame_context_ptr->acquire_image(swapchain_ptr);
+ *      cmd_buffer_ptr = frame_context_ptr->get_command_pool()->alloc_primary_level_command_buffer();
+ *      ..
+ *
+ *      frame_context_ptr->end_frame(queue_ptr, 1, &raw_cmd_buffer_ptr, swapchain_ptr, image_index);
+ *
+ *  Not thread-safe.
+ **/
+#ifndef MISC_FRAME_CONTEXT_H
+#define MISC_FRAME_CONTEXT_H
+
+#include "misc/types.h"
+
+
+namespace Anvil
+{
+    class FrameContext
+    {
+    public:
+        /* Public functions */
+
+        /** Creates a new frames-in-flight manager.
+         *
+         *  @param in_device_ptr                      Device to create the objects on. Must not be nullptr.
+         *  @param in_n_frames_in_flight              Number of frame slots. Must be at least 1. Higher values let the
+         *                                            CPU run further ahead of the device, at the cost of latency.
+         *  @param in_queue_family_index              Queue family command pools should be created for. Frames must be
+         *                                            submitted to queues of this family.
+         *  @param in_opt_transient_allocator_size    If not 0, a BufferRingAllocator is created with this many bytes
+         *                                            available per frame.
+         *  @param in_transient_allocator_usage_flags Usage of the transient allocator's buffer. Ignored if
+         *                                            @param in_opt_transient_allocator_size is 0.
+         *
+         *  @return New instance or nullptr, if any of the objects could not be created.
+         **/
+        static Anvil::FrameContextUniquePtr create(Anvil::BaseDevice*      in_device_ptr,
+                                                   uint32_t                in_n_frames_in_flight,
+                                                   uint32_t                in_queue_family_index,
+                                                   VkDeviceSize            in_opt_transient_allocator_size    = 0,
+                                                   Anvil::BufferUsageFlags in_transient_allocator_usage_flags = Anvil::BufferUsageFlagBits::UNIFORM_BUFFER_BIT | Anvil::BufferUsageFlagBits::STORAGE_BUFFER_BIT);
+
+        /** Destructor. Waits until the device finishes executing all frames submitted via end_frame(). */
+        ~FrameContext();
+
+        /** Acquires the next image of the specified swapchain. The current frame slot's acquire semaphore is going
+         *  to be signalled once the image becomes available, and end_frame() is going to wait on it.
+         *
+         *  Must be called between begin_frame() and end_frame(), at most once per frame.
+         *
+         *  @param in_swapchain_ptr Swapchain to acquire the image from. Must not be nullptr.
+         *  @param in_wait_stages   Stages at which the frame's submission should wait for the image.
+         *
+         *  @return Index of the acquired image.
+         **/
+        uint32_t acquire_image(Anvil::Swapchain*         in_swapchain_ptr,
+                               Anvil::PipelineStageFlags in_wait_stages = Anvil::PipelineStageFlagBits::COLOR_ATTACHMENT_OUTPUT_BIT);
+
+        /** Moves to the next frame slot. Blocks until the device finishes executing the frame submitted for
+         *  the slot N frames ago, then resets the slot's fence and command pool.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool begin_frame();
+
+        /** Finishes the current frame:
+         *
+         *  1. Flushes data written to the transient allocator.
+         *  2. Submits the specified command buffers. The submission waits on the acquire semaphore, if an image
+         *     has been acquired with acquire_image(), and signals the slot's fence. If a swapchain is specified,
+         *     it also signals the present semaphore.
+         *  3. Presents the swapchain image, if a swapchain is specified.
+         *
+         *  Work submitted to the same queue earlier within the frame does not need to be passed here, since
+         *  the fence also covers it. 0 command buffers can be specified in that case.
+         *
+         *  @param in_queue_ptr               Queue to submit to. Must belong to the family specified at creation time.
+         *  @param in_n_command_buffers       Number of command buffers under @param in_opt_command_buffer_ptrs.
+         *  @param in_opt_command_buffer_ptrs Command buffers to submit. May be nullptr if @param in_n_command_buffers is 0.
+         *  @param in_opt_swapchain_ptr       Swapchain to present to, or nullptr if nothing should be presented.
+         *  @param in_swapchain_image_index   Index of the image to present. Ignored if @param in_opt_swapchain_ptr is nullptr.
+         *  @param out_opt_present_result_ptr If not nullptr, deref will be set to the result of the present operation.
+         *
+         *  @return true if the submission succeeded, false otherwise.
+         **/
+        bool end_frame(Anvil::Queue*                    in_queue_ptr,
+                       uint32_t                         in_n_command_buffers,
+                       Anvil::CommandBufferBase* const* in_opt_command_buffer_ptrs,
+                       Anvil::Swapchain*                in_opt_swapchain_ptr       = nullptr,
+                       uint32_t                         in_swapchain_image_index   = 0,
+                       VkResult*                        out_opt_present_result_ptr = nullptr);
+
+        /** Returns the acquire semaphore of the current frame slot. */
+        Anvil::Semaphore* get_acquire_semaphore() const
+        {
+            return m_frame_slots.at(m_n_current_frame_slot).acquire_semaphore_ptr.get();
+        }
+
+        /** Returns the command pool of the current frame slot. */
+        Anvil::CommandPool* get_command_pool() const
+        {
+            return m_frame_slots.at(m_n_current_frame_slot).command_pool_ptr.get();
+        }
+
+        /** Returns the index of the current frame slot. */
+        uint32_t get_current_frame_slot() const
+        {
+            return m_n_current_frame_slot;
+        }
+
+        /** Returns the fence of the current frame slot. */
+        Anvil::Fence* get_fence() const
+        {
+            return m_frame_slots.at(m_n_current_frame_slot).fence_ptr.get();
+        }
+
+        /** Returns the number of frame slots. */
+        uint32_t get_n_frames_in_flight() const
+        {
+            return static_cast<uint32_t>(m_frame_slots.size() );
+        }
+
+        /** Returns the present semaphore of the current frame slot. */
+        Anvil::Semaphore* get_present_semaphore() const
+        {
+            return m_frame_slots.at(m_n_current_frame_slot).present_semaphore_ptr.get();
+        }
+
+        /** Returns the transient allocator, or nullptr if none has been requested at creation time.
+         *  Its frames are begun and ended by begin_frame() and end_frame().
+         **/
+        Anvil::BufferRingAllocator* get_transient_allocator() const
+        {
+            return m_transient_allocator_ptr.get();
+        }
+
+    private:
+        /* Private type definitions */
+        typedef struct FrameSlot
+        {
+            Anvil::SemaphoreUniquePtr   acquire_semaphore_ptr;
+            Anvil::CommandPoolUniquePtr command_pool_ptr;
+            Anvil::FenceUniquePtr       fence_ptr;
+            Anvil::SemaphoreUniquePtr   present_semaphore_ptr;
+        } FrameSlot;
+
+        /* Private functions */
+        FrameContext(Anvil::BaseDevice* in_device_ptr,
+                     uint32_t           in_n_frames_in_flight,
+                     uint32_t           in_queue_family_index);
+
+        bool init(VkDeviceSize            in_opt_transient_allocator_size,
+                  Anvil::BufferUsageFlags in_transient_allocator_usage_flags);
+
+        /* Private variables */
+        Anvil::PipelineStageFlags           m_acquire_wait_stages;
+        Anvil::BaseDevice*                  m_device_ptr;
+        bool                                m_frame_started;
+        std::vector<FrameSlot>              m_frame_slots;
+        bool                                m_image_acquired;
+        uint32_t                            m_n_current_frame_slot;
+        uint32_t                            m_queue_family_index;
+        Anvil::BufferRingAllocatorUniquePtr m_transient_allocator_ptr;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(FrameContext);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(FrameContext);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_FRAME_CONTEXT_H */
@@ -0,0 +1,338 @@
+//
+// Copyright (c) 2017-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/** Defines a frame graph, which records a set of passes into a command buffer, deriving the barriers between
+ *  them and the memory backing of the intermediate resources they exchange.
+ *
+ *  Usage:
+ *
+ *  1. Declare resources. Transient resources are created and owned by the graph, and only live for the duration
+ *     of the frame. Imported resources (eg. swapchain images, or buffers filled by the host) are owned by the app.
+ *  2. Declare passes, in the order they would be recorded in if the graph was not used. Each pass declares how
+ *     it accesses resources with add_resource_usage(), and provides a call-back which records its commands.
+ *  3. Mark resources whose contents are consumed outside the graph with mark_as_output().
+ *  4. Call compile(), which:
+ *
+ *     - culls passes whose results are never consumed. A pass is kept if it writes an output, an imported
+ *       resource, or a resource read by another pass which is kept. Passes which do not declare any resource
+ *       usages are always kept.
+ *     - orders the remaining passes, so that consumers follow their producers closely. This shortens
+ *       the lifetimes of transient resources.
+ *     - creates the transient resources, and places them in shared memory blocks. Transient resources whose
+ *       lifetimes do not overlap may share the same memory.
+ *
+ *  5. Call execute() for each frame.
+ *
+ *  Barriers are generated by a ResourceStateTracker instance owned by the graph. Transient resources are
+ *  considered to be discarded at the beginning of their lifetime, so image contents are never preserved
+ *  between frames.
+ *
+ *  Render passes are not begun or ended by the graph. Pass call-backs which render need to do so themselves,
+ *  using the attachments they have declared as COLOR_ATTACHMENT or DEPTH_STENCIL_* usages.
+ *
+ *  Not thread-safe.
+ **/
+#ifndef MISC_FRAME_GRAPH_H
+#define MISC_FRAME_GRAPH_H
+
+#include "misc/resource_state_tracker.h"
+#include "misc/types.h"
+#include <functional>
+
+
+namespace Anvil
+{
+    class FrameGraph
+    {
+    public:
+        /* Public type definitions */
+        typedef uint32_t PassID;
+        typedef uint32_t ResourceID;
+
+        /** Call-back invoked by execute() to record the commands of a pass. All barriers the pass needs for
+         *  the resource usages it has declared have been recorded by the time the call-back is invoked.
+         *
+         *  Use FrameGraph::get_buffer() and FrameGraph::get_image() to retrieve the resources.
+         **/
+        typedef std::function<void(Anvil::CommandBufferBase* in_command_buffer_ptr,
+                                   const Anvil::FrameGraph*  in_frame_graph_ptr)> RecordCallback;
+
+        /* Public functions */
+
+        /** Creates a new, empty frame graph.
+         *
+         *  @param in_device_ptr     Device to create transient resources and memory on. Must not be nullptr.
+         *  @param in_queue_families Queue families transient resources are going to be accessed by.
+         **/
+        static Anvil::FrameGraphUniquePtr create(const Anvil::BaseDevice* in_device_ptr,
+                                                 Anvil::QueueFamilyFlags  in_queue_families = Anvil::QueueFamilyFlagBits::COMPUTE_BIT | Anvil::QueueFamilyFlagBits::GRAPHICS_BIT);
+
+        /** Destructor. Releases all transient resources and the memory backing them. */
+        ~FrameGraph();
+
+        /** Declares a new pass. Passes must be declared in an order which satisfies the dependencies between them.
+         *
+         *  @param in_name     Name of the pass. Only used for debugging purposes.
+         *  @param in_callback Call-back to invoke when the pass is executed. Must not be empty.
+         *
+         *  @return ID of the new pass.
+         **/
+        PassID add_pass(const std::string& in_name,
+                        RecordCallback     in_callback);
+
+        /** Declares that a pass accesses a resource in the specified way. A pass may declare more than one usage
+         *  for the same resource, in which case the usages are applied in declaration order.
+         *
+         *  Resources are always used as a whole: whole buffers, all mips and all layers of images.
+         *
+         *  Fails if the usage is not applicable to the resource type, or if it would require host access
+         *  to a transient resource (HOST_READ), or if the graph has already been compiled.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool add_resource_usage(PassID                             in_pass_id,
+                                ResourceID                         in_resource_id,
+                                Anvil::ResourceStateTracker::Usage in_usage);
+
+        /** Declares a new transient buffer. The buffer is created by compile(), with all the usage flags
+         *  its declared usages need.
+         *
+         *  @return ID of the new resource.
+         **/
+        ResourceID add_transient_buffer(VkDeviceSize in_size);
+
+        /** Declares a new transient image. The image is created by compile() with optimal tiling, exclusive
+         *  sharing mode and all the usage flags its declared usages need.
+         *
+         *  @return ID of the new resource.
+         **/
+        ResourceID add_transient_image(Anvil::ImageType           in_type,
+                                       Anvil::Format              in_format,
+                                       uint32_t                   in_width,
+                                       uint32_t                   in_height,
+                                       uint32_t                   in_depth,
+                                       uint32_t                   in_n_layers,
+                                       Anvil::SampleCountFlagBits in_sample_count,
+                                       bool                       in_use_full_mipmap_chain);
+
+        /** Culls, orders and allocates memory for the declared passes and resources.
+         *
+         *  Must be called exactly once, before the first execute() call. No passes, resources or resource usages
+         *  can be declared afterward.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool compile();
+
+        /** Records all passes which have survived culling into the specified command buffer, along with the
+         *  barriers they need.
+         *
+         *  Barrier batching is enabled on the command buffer for the duration of the call, so that barriers
+         *  generated for all resources accessed by a pass are recorded with a single Vulkan call.
+         *
+         *  Frames must be submitted in the same order as execute() is called for them.
+         *
+         *  @param in_command_buffer_ptr Command buffer to record into. Must be in the recording state, outside
+         *                               a render pass.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool execute(Anvil::CommandBufferBase* in_command_buffer_ptr);
+
+        /** Returns the buffer corresponding to the specified resource, or nullptr if the resource is not a buffer,
+         *  or is a transient buffer which has not been created, because the graph has not been compiled yet or
+         *  all passes accessing it have been culled.
+         **/
+        Anvil::Buffer* get_buffer(ResourceID in_resource_id) const;
+
+        /** Image counterpart of get_buffer(). */
+        Anvil::Image* get_image(ResourceID in_resource_id) const;
+
+        /** Returns the number of passes culled by compile(). */
+        uint32_t get_n_culled_passes() const
+        {
+            return m_n_culled_passes;
+        }
+
+        /** Returns the order in which passes are recorded by execute(). Only valid after compile() has been called. */
+        const std::vector<PassID>& get_pass_order() const
+        {
+            return m_pass_order;
+        }
+
+        /** Returns the tracker used to generate barriers. It can be used to declare accesses to imported
+         *  resources made outside the graph. */
+        Anvil::ResourceStateTracker* get_resource_state_tracker() const
+        {
+            return m_tracker_ptr.get();
+        }
+
+        /** Returns the amount of memory allocated for transient resources, in bytes. */
+        VkDeviceSize get_transient_memory_size() const
+        {
+            return m_transient_memory_size;
+        }
+
+        /** Returns the amount of memory transient resources would need if none of them shared memory, in bytes. */
+        VkDeviceSize get_transient_memory_size_without_aliasing() const
+        {
+            return m_transient_memory_size_without_aliasing;
+        }
+
+        /** Declares a buffer owned by the app. The buffer must outlive the graph. */
+        ResourceID import_buffer(Anvil::Buffer* in_buffer_ptr);
+
+        /** Declares an image owned by the app. The image must outlive the graph. */
+        ResourceID import_image(Anvil::Image* in_image_ptr);
+
+        /** Tells compile() that the contents of the specified resource are consumed outside the graph.
+         *  Imported resources written by any pass are always treated as outputs.
+         **/
+        void mark_as_output(ResourceID in_resource_id);
+
+    private:
+        /* Private type definitions */
+        typedef struct PassUsage
+        {
+            ResourceID                         resource_id;
+            Anvil::ResourceStateTracker::Usage usage;
+
+            PassUsage(ResourceID                         in_resource_id,
+                      Anvil::ResourceStateTracker::Usage in_usage)
+                :resource_id(in_resource_id),
+                 usage      (in_usage)
+            {
+                /* Stub */
+            }
+        } PassUsage;
+
+        typedef struct Pass
+        {
+            RecordCallback         callback;
+            bool                   is_alive;
+            std::string            name;
+            std::vector<PassUsage> usages;
+
+            Pass(const std::string& in_name,
+                 RecordCallback     in_callback)
+                :callback(in_callback),
+                 is_alive(false),
+                 name    (in_name)
+            {
+                /* Stub */
+            }
+        } Pass;
+
+        typedef struct Resource
+        {
+            /* Declaration */
+            bool                       is_image;
+            bool                       is_imported;
+            bool                       is_output;
+
+            VkDeviceSize               buffer_size;
+            Anvil::Format              image_format;
+            uint32_t                   image_n_layers;
+            Anvil::SampleCountFlagBits image_sample_count;
+            uint32_t                   image_size[3];
+            Anvil::ImageType           image_type;
+            bool                       image_use_full_mipmap_chain;
+
+            /* Set for imported resources at declaration time, and by compile() for transient resources */
+            Anvil::Buffer*             buffer_ptr;
+            Anvil::Image*              image_ptr;
+
+            /* Set by compile() for transient resources */
+            VkAccessFlags              alias_src_access;   /* Write accesses of all resources sharing the memory */
+            VkPipelineStageFlags       alias_src_stages;   /* Stages accessing any resource sharing the memory   */
+            uint32_t                   first_pass_index;   /* Index into m_pass_order, UINT32_MAX if never used  */
+            uint32_t                   last_pass_index;
+            VkAccessFlags              lifetime_access;    /* Write accesses made by all passes using the resource */
+            VkPipelineStageFlags       lifetime_stages;    /* Stages of all passes using the resource              */
+            uint32_t                   n_memory_group;
+            VkDeviceSize               memory_offset;
+            VkDeviceSize               memory_size;
+
+            Resource()
+                :is_image                   (false),
+                 is_imported                (false),
+                 is_output                  (false),
+                 buffer_size                (0),
+                 image_format               (Anvil::Format::UNKNOWN),
+                 image_n_layers             (0),
+                 image_sample_count         (Anvil::SampleCountFlagBits::_1_BIT),
+                 image_type                 (Anvil::ImageType::_2D),
+                 image_use_full_mipmap_chain(false),
+                 buffer_ptr                 (nullptr),
+                 image_ptr                  (nullptr),
+                 alias_src_access           (0),
+                 alias_src_stages           (0),
+                 first_pass_index           (UINT32_MAX),
+                 last_pass_index            (UINT32_MAX),
+                 lifetime_access            (0),
+                 lifetime_stages            (0),
+                 n_memory_group             (UINT32_MAX),
+                 memory_offset              (0),
+                 memory_size                (0)
+            {
+                image_size[0] = 0;
+                image_size[1] = 0;
+                image_size[2] = 0;
+            }
+        } Resource;
+
+        /* Private functions */
+        FrameGraph(const Anvil::BaseDevice* in_device_ptr,
+                   Anvil::QueueFamilyFlags  in_queue_families);
+
+        bool alias_transient_resources  ();
+        void cull_passes                ();
+        bool create_transient_resources ();
+        void order_passes               ();
+        bool record_alias_barrier       (Anvil::CommandBufferBase* in_command_buffer_ptr,
+                                         uint32_t                  in_n_pass,
+                                         ResourceID                in_resource_id);
+        void release_transient_resources();
+
+        /* Private variables */
+        bool                                 m_compiled;
+        const Anvil::BaseDevice*             m_device_ptr;
+        uint32_t                             m_n_culled_passes;
+        std::vector<PassID>                  m_pass_order;
+        std::vector<Pass>                    m_passes;
+        Anvil::QueueFamilyFlags              m_queue_families;
+        std::vector<Resource>                m_resources;
+        Anvil::ResourceStateTrackerUniquePtr m_tracker_ptr;
+        VkDeviceSize                         m_transient_memory_size;
+        VkDeviceSize                         m_transient_memory_size_without_aliasing;
+
+        /* Owned objects. Resources need to be released before the memory blocks they are bound to. */
+        std::vector<Anvil::MemoryBlockUniquePtr> m_memory_blocks;
+        std::vector<Anvil::BufferUniquePtr>      m_transient_buffers;
+        std::vector<Anvil::ImageUniquePtr>       m_transient_images;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(FrameGraph);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(FrameGraph);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_FRAME_GRAPH_H */
@@ -62,6 +62,16 @@ namespace Anvil
             /* IMemoryAllocatorBackend functions */
 
             bool     bake                            (Anvil::MemoryAllocator::Items&              in_items) final;
+            void     get_counter_snapshot            (Anvil::MemoryAllocator::CounterSnapshot*    out_result_ptr) const final;
+            void     get_memory_type_statistics      (std::vector<Anvil::MemoryAllocator::MemoryStatistics>* out_result_ptr) const final;
+
+            /* Returns the number of bytes bake() has saved by reordering items, compared to laying them out in the order
+             * they were added in. */
+            VkDeviceSize get_n_bytes_saved_by_item_reordering() const final
+            {
+                return m_n_bytes_saved_by_item_reordering;
+            }
+
             VkResult map                             (void*                                       in_memory_object,
                                                       VkDeviceSize                                in_start_offset,
                                                       VkDeviceSize                                in_size,
@@ -73,10 +83,16 @@ namespace Anvil
 
             /* Private functions */
 
+            VkDeviceSize calculate_item_offsets(const std::vector<Anvil::MemoryAllocator::Item*>&       in_items,
+                                                std::map<Anvil::MemoryAllocator::Item*, VkDeviceSize>* out_item_offsets_ptr) const;
+
             /* Private variables */
             const Anvil::BaseDevice*          m_device_ptr;
             bool                              m_is_baked;
             std::vector<MemoryBlockUniquePtr> m_memory_blocks;
+            VkDeviceSize                      m_n_bytes_saved_by_item_reordering;
+
+            std::shared_ptr<Anvil::MemoryAllocator::UsageTracker> m_usage_tracker_ptr;
         };
     };
 };
@@ -0,0 +1,133 @@
+//
+// Copyright (c) 2017-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/* Implements a memory allocator backend which sub-allocates memory regions out of large, per-memory-type
+ * memory blocks ("pages"), using the Two-Level Segregated Fit algorithm. Both allocation and release of
+ * a region take constant time, irrespective of how many regions have been carved out of a page.
+ *
+ * Regions are returned to the page they come from as soon as the memory block handed out for them
+ * goes out of scope, so the allocator can be baked an arbitrary number of times.
+ *
+ * This class should only be used internally by MemoryAllocator.
+ **/
+#ifndef MISC_MEMORY_ALLOCATOR_BACKEND_TLSF_H
+#define MISC_MEMORY_ALLOCATOR_BACKEND_TLSF_H
+
+#include "misc/types.h"
+#include "misc/memory_allocator.h"
+#include <map>
+#include <mutex>
+
+
+namespace Anvil
+{
+    namespace MemoryAllocatorBackends
+    {
+        /* TLSF memory allocator backend implementation.
+         *
+         * Should only be used by Anvil::MemoryAllocator
+         */
+        class TLSF : public Anvil::MemoryAllocator::IMemoryAllocatorBackend,
+                     public std::enable_shared_from_this<TLSF>
+        {
+        public:
+            /* Public functions */
+
+            /** Creates a new TLSF memory allocator backend instance.
+             *
+             *  Should only be used internally by MemoryAllocator.
+             *
+             *  @param in_device_ptr   Vulkan device the memory allocations are going to be made for.
+             *  @param in_page_size    Size of memory blocks sub-allocations are going to be made from. If 0, 64MB pages
+             *                         are used for heaps larger than 1GB, and pages of 1/8 of the heap size otherwise.
+             *                         Items which do not fit in a page get memory blocks of their own.
+             **/
+            static std::unique_ptr<TLSF> create(const Anvil::BaseDevice* in_device_ptr,
+                                                VkDeviceSize             in_page_size = 0);
+
+            /** Destructor. */
+            virtual ~TLSF();
+
+        private:
+            /* Private type definitions */
+            struct Block;
+            struct Page;
+            struct PageList;
+
+            typedef std::unique_ptr<Page>               PageUniquePtr;
+            typedef std::unique_ptr<PageList>           PageListUniquePtr;
+            typedef std::map<uint64_t, PageListUniquePtr> PageMap;
+
+            /* Private functions */
+
+            TLSF(const Anvil::BaseDevice* in_device_ptr,
+                 VkDeviceSize             in_page_size);
+
+            bool         allocate_from_pages     (Anvil::MemoryAllocator::Item*       in_item_ptr,
+                                                  uint32_t                            in_memory_type_index);
+            bool         allocate_dedicated      (Anvil::MemoryAllocator::Item*       in_item_ptr,
+                                                  uint32_t                            in_memory_type_index);
+            bool         get_memory_type_for_item(const Anvil::MemoryAllocator::Item* in_item_ptr,
+                                                  uint32_t*                           out_memory_type_index_ptr) const;
+            VkDeviceSize get_page_size           (uint32_t                            in_memory_type_index) const;
+            bool         is_item_too_large_for_page(const Anvil::MemoryAllocator::Item* in_item_ptr,
+                                                    uint32_t                            in_memory_type_index) const;
+            void         on_memory_block_released(Anvil::MemoryBlock*                 in_memory_block_ptr,
+                                                  Page*                               in_page_ptr,
+                                                  Block*                              in_block_ptr);
+
+            /* IMemoryAllocatorBackend functions */
+
+            bool     bake                            (Anvil::MemoryAllocator::Items&              in_items) final;
+            void     get_counter_snapshot            (Anvil::MemoryAllocator::CounterSnapshot*    out_result_ptr) const final;
+            void     get_memory_type_statistics      (std::vector<Anvil::MemoryAllocator::MemoryStatistics>* out_result_ptr) const final;
+
+            /* TLSF places items as they are baked, so no reordering takes place. */
+            VkDeviceSize get_n_bytes_saved_by_item_reordering() const final
+            {
+                return 0;
+            }
+
+            VkResult map                             (void*                                       in_memory_object,
+                                                      VkDeviceSize                                in_start_offset,
+                                                      VkDeviceSize                                in_size,
+                                                      void**                                      out_result_ptr) final;
+            bool     supports_baking                 () const final;
+            bool     supports_device_masks           ()                                                                            const final;
+            bool     supports_external_memory_handles(const Anvil::ExternalMemoryHandleTypeFlags& in_external_memory_handle_types) const final;
+            void     unmap                           (void*                                       in_memory_object) final;
+
+            /* Private variables */
+            const Anvil::BaseDevice* m_device_ptr;
+            mutable std::mutex       m_mutex;
+            VkDeviceSize             m_page_size;
+            PageMap                  m_pages;      /* Key: see get_page_key() */
+
+            std::shared_ptr<Anvil::MemoryAllocator::UsageTracker> m_usage_tracker_ptr;
+
+            ANVIL_DISABLE_ASSIGNMENT_OPERATOR(TLSF);
+            ANVIL_DISABLE_COPY_CONSTRUCTOR(TLSF);
+        };
+    };
+};
+
+#endif /* MISC_MEMORY_ALLOCATOR_BACKEND_TLSF_H */
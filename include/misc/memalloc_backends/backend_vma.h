@@ -31,6 +31,8 @@
 #include "misc/types.h"
 #include "misc/memory_allocator.h"
 #include "VulkanMemoryAllocator/vk_mem_alloc.h"
+#include <mutex>
+#include <unordered_map>
 
 
 namespace Anvil
@@ -58,6 +60,14 @@ namespace Anvil
             /** Destructor. */
             virtual ~VMA();
 
+            /** Compacts memory backing the specified buffers. Please see MemoryAllocator::defragment() for specification. */
+            bool defragment(uint32_t                                          in_n_buffers,
+                            Anvil::Buffer* const*                             in_buffers_ptr,
+                            VkDeviceSize                                      in_max_bytes_to_move,
+                            uint32_t                                          in_max_allocations_to_move,
+                            const Anvil::MemoryAllocatorBufferMovedCallback&  in_opt_buffer_moved_callback_function,
+                            Anvil::MemoryAllocator::DefragmentationStats*     out_opt_stats_ptr);
+
         private:
             /* Private type definitions */
 
@@ -79,12 +89,36 @@ namespace Anvil
                 /** Destructor */
                 virtual ~VMAAllocator();
 
+                /** Returns the usage tracker, which is kept up to date with all device memory allocations made
+                 *  by the VMA library and all memory blocks handed out by the VMA backend. */
+                Anvil::MemoryAllocator::UsageTracker* get_usage_tracker() const
+                {
+                    return m_usage_tracker_ptr.get();
+                }
+
                 /** Returns the raw VMA allocator handle. */
                 VmaAllocator get_handle() const
                 {
                     return m_allocator;
                 }
 
+                /** Tells which VMA allocation has been assigned to the specified memory block.
+                 *
+                 *  @return true if the memory block is a live block handed out by the backend, false otherwise.
+                 **/
+                bool get_memory_block_allocation(const Anvil::MemoryBlock* in_memory_block_ptr,
+                                                 VmaAllocation*            out_vma_allocation_ptr) const;
+
+                /** Associates a memory block with the VMA allocation it has been created from. Only registered
+                 *  blocks return their allocation to the library when they go out of scope. */
+                void register_memory_block(const Anvil::MemoryBlock* in_memory_block_ptr,
+                                           VmaAllocation             in_vma_allocation);
+
+                /** Transfers the VMA allocation from one memory block to another. Used after an allocation has been moved,
+                 *  so that release of the superseded block does not return the allocation to the library. */
+                void replace_memory_block(const Anvil::MemoryBlock* in_old_memory_block_ptr,
+                                          const Anvil::MemoryBlock* in_new_memory_block_ptr);
+
                 /** Entry-point which should be called by VMA class every time a new memory block instance is created
                  *  from a memory region returned by the VMA library.
                  */
@@ -108,10 +142,22 @@ namespace Anvil
 
                 bool init();
 
+                static void VKAPI_PTR on_device_memory_alloced(VmaAllocator   in_allocator,
+                                                               uint32_t       in_memory_type,
+                                                               VkDeviceMemory in_memory,
+                                                               VkDeviceSize   in_size);
+                static void VKAPI_PTR on_device_memory_freed  (VmaAllocator   in_allocator,
+                                                               uint32_t       in_memory_type,
+                                                               VkDeviceMemory in_memory,
+                                                               VkDeviceSize   in_size);
+
                 /* Private variables */
-                VmaAllocator                        m_allocator;
-                const Anvil::BaseDevice*            m_device_ptr;
-                std::unique_ptr<VmaVulkanFunctions> m_vma_func_ptrs;
+                VmaAllocator                                          m_allocator;
+                const Anvil::BaseDevice*                              m_device_ptr;
+                std::unordered_map<const MemoryBlock*, VmaAllocation> m_memory_block_allocations;
+                mutable std::mutex                                    m_memory_block_allocations_mutex;
+                std::unique_ptr<Anvil::MemoryAllocator::UsageTracker> m_usage_tracker_ptr;
+                std::unique_ptr<VmaVulkanFunctions>                   m_vma_func_ptrs;
 
                 std::vector<std::shared_ptr<VMAAllocator> > m_refcount_helper;
             };
@@ -125,6 +171,15 @@ namespace Anvil
             /* IMemoryAllocatorBackend functions */
 
             bool     bake                            (Anvil::MemoryAllocator::Items&              in_items) final;
+            void     get_counter_snapshot            (Anvil::MemoryAllocator::CounterSnapshot*    out_result_ptr) const final;
+            void     get_memory_type_statistics      (std::vector<Anvil::MemoryAllocator::MemoryStatistics>* out_result_ptr) const final;
+
+            /* VMA places items as they are baked, so no reordering takes place. */
+            VkDeviceSize get_n_bytes_saved_by_item_reordering() const final
+            {
+                return 0;
+            }
+
             VkResult map                             (void*                                       in_memory_object,
                                                       VkDeviceSize                                in_start_offset,
                                                       VkDeviceSize                                in_size,
@@ -33,6 +33,8 @@
 #include "misc/mt_safety.h"
 #include "misc/types.h"
 #include <functional>
+#include <mutex>
+#include <string>
 #include <vector>
 
 
@@ -41,6 +43,7 @@ namespace Anvil
     typedef std::pair<uint32_t, uint32_t>                                            LocalRemoteDeviceIndexPair;
     typedef std::pair<uint32_t, uint32_t>                                            ResourceMemoryDeviceIndexPair;
     typedef std::function<void (Anvil::MemoryAllocator*) >                           MemoryAllocatorBakeCallbackFunction;
+    typedef std::function<void (Anvil::Buffer*) >                                    MemoryAllocatorBufferMovedCallback;
     typedef std::function<void (Anvil::Buffer*,       Anvil::MemoryBlockUniquePtr) > MemoryAllocatorPostBakePerNonSparseBufferItemMemAssignmentCallback;
     typedef std::function<void (Anvil::Image*,        Anvil::MemoryBlockUniquePtr) > MemoryAllocatorPostBakePerNonSparseImageItemMemAssignmentCallback;
     typedef std::map<LocalRemoteDeviceIndexPair, Anvil::PeerMemoryFeatureFlags>      MGPUPeerMemoryRequirements;
@@ -60,6 +63,121 @@ namespace Anvil
             ITEM_TYPE_SPARSE_IMAGE_SUBRESOURCE,
         } ItemType;
 
+        /* Describes the outcome of a defragment() call. */
+        typedef struct DefragmentationStats
+        {
+            uint32_t     n_allocations_moved;
+            VkDeviceSize n_bytes_freed;                 /* Total size of VkDeviceMemory objects which have been released */
+            VkDeviceSize n_bytes_moved;
+            uint32_t     n_device_memory_objects_freed;
+
+            DefragmentationStats()
+                :n_allocations_moved          (0),
+                 n_bytes_freed                (0),
+                 n_bytes_moved                (0),
+                 n_device_memory_objects_freed(0)
+            {
+                /* Stub */
+            }
+        } DefragmentationStats;
+
+        /* Cheap snapshot of allocator-wide totals, which are maintained incrementally as memory is allocated and
+         * released. Suitable for per-frame use, e.g. in an overlay or for telemetry. */
+        typedef struct CounterSnapshot
+        {
+            uint32_t     n_allocations;           /* Number of live items which have been assigned memory */
+            VkDeviceSize n_bytes_allocated;       /* Total size of all VkDeviceMemory objects the allocator holds */
+            VkDeviceSize n_bytes_used;            /* Total size of memory assigned to live items */
+            uint32_t     n_device_memory_objects;
+
+            CounterSnapshot()
+                :n_allocations          (0),
+                 n_bytes_allocated      (0),
+                 n_bytes_used           (0),
+                 n_device_memory_objects(0)
+            {
+                /* Stub */
+            }
+        } CounterSnapshot;
+
+        /* Memory usage totals for a single memory type or heap, or for the whole allocator. */
+        typedef struct MemoryStatistics
+        {
+            /* 1 - largest_free_range / n_bytes_free. 0 if all free space is contiguous, approaches 1 as free space
+             * gets scattered over many small ranges. */
+            float fragmentation;
+
+            VkDeviceSize largest_free_range;
+            uint32_t     n_allocations;
+            VkDeviceSize n_bytes_allocated;
+            VkDeviceSize n_bytes_free;            /* Bytes which can still be assigned to new items without allocating new VkDeviceMemory */
+            VkDeviceSize n_bytes_used;
+            uint32_t     n_device_memory_objects;
+            uint32_t     n_free_ranges;
+
+            MemoryStatistics()
+                :fragmentation          (0.0f),
+                 largest_free_range     (0),
+                 n_allocations          (0),
+                 n_bytes_allocated      (0),
+                 n_bytes_free           (0),
+                 n_bytes_used           (0),
+                 n_device_memory_objects(0),
+                 n_free_ranges          (0)
+            {
+                /* Stub */
+            }
+
+            /** Adds totals of @param in_statistics to this instance and recalculates the fragmentation ratio. */
+            void accumulate(const MemoryStatistics& in_statistics);
+        } MemoryStatistics;
+
+        typedef struct MemoryStatisticsReport
+        {
+            std::vector<MemoryStatistics> heaps;        /* Indexed by memory heap index */
+            std::vector<MemoryStatistics> memory_types; /* Indexed by memory type index */
+            MemoryStatistics              total;
+        } MemoryStatisticsReport;
+
+        /* Tracks per-memory-type allocation totals for memory allocator backends.
+         *
+         * Backends report each VkDeviceMemory object they allocate & free and each memory region they assign to
+         * or reclaim from an item. Free-range statistics are left for the backends to fill in.
+         *
+         * Thread-safe.
+         */
+        class UsageTracker
+        {
+        public:
+            /* Public functions */
+
+            explicit UsageTracker(uint32_t in_n_memory_types);
+
+            CounterSnapshot get_counter_snapshot      () const;
+            void            get_memory_type_statistics(std::vector<MemoryStatistics>* out_memory_type_statistics_ptr) const;
+
+            void on_allocation_made      (uint32_t     in_memory_type_index,
+                                          VkDeviceSize in_size);
+            void on_allocation_released  (uint32_t     in_memory_type_index,
+                                          VkDeviceSize in_size);
+            void on_device_memory_alloced(uint32_t     in_memory_type_index,
+                                          VkDeviceSize in_size);
+            void on_device_memory_freed  (uint32_t     in_memory_type_index,
+                                          VkDeviceSize in_size);
+
+            /** Reports a regular memory block as a VkDeviceMemory object which has been assigned in full to a single item.
+             *
+             *  on_dedicated_memory_block_released() should be registered as the block's release callback.
+             **/
+            void on_dedicated_memory_block_alloced (const Anvil::MemoryBlock* in_memory_block_ptr);
+            void on_dedicated_memory_block_released(const Anvil::MemoryBlock* in_memory_block_ptr);
+
+        private:
+            /* Private variables */
+            mutable std::mutex            m_mutex;
+            std::vector<MemoryStatistics> m_memory_type_statistics;
+        };
+
         typedef struct Item
         {
             Anvil::Buffer*                                                                        buffer_ptr;
@@ -213,6 +331,14 @@ namespace Anvil
             }
 
             virtual bool bake                            (Items&                                      in_items)                              = 0;
+            virtual void get_counter_snapshot            (CounterSnapshot*                            out_result_ptr)                  const = 0;
+
+            /** Fills @param out_result_ptr with one entry per memory type exposed by the device. Fragmentation ratios
+             *  need not be filled in. */
+            virtual void get_memory_type_statistics      (std::vector<MemoryStatistics>*              out_result_ptr)                  const = 0;
+
+            /** Returns the number of bytes bake() has saved by reordering items. 0 for backends which do not reorder. */
+            virtual VkDeviceSize get_n_bytes_saved_by_item_reordering()                                                                const = 0;
             virtual bool supports_device_masks           ()                                                                            const = 0;
             virtual bool supports_external_memory_handles(const Anvil::ExternalMemoryHandleTypeFlags& in_external_memory_handle_types) const = 0;
         };
@@ -488,6 +614,73 @@ namespace Anvil
         static Anvil::MemoryAllocatorUniquePtr create_vma(const Anvil::BaseDevice* in_device_ptr,
                                                           MTSafety                 in_mt_safety = Anvil::MTSafety::INHERIT_FROM_PARENT_DEVICE);
 
+        /** Creates a new TLSF memory allocator instance.
+         *
+         *  This type of allocator supports an arbitrary number of implicit or explicit bake invocations.
+         *  Memory regions are sub-allocated from large per-memory-type pages in constant time, and returned
+         *  to their page for reuse as soon as the memory block they were assigned to goes out of scope.
+         *  Items which require dedicated allocations or external handles, or which do not fit in a page, get
+         *  memory blocks of their own.
+         *
+         *  @param in_device_ptr Device to use.
+         *  @param in_page_size  Size of pages to sub-allocate from. If 0, a size is picked for each memory heap.
+         **/
+        static Anvil::MemoryAllocatorUniquePtr create_tlsf(const Anvil::BaseDevice* in_device_ptr,
+                                                           MTSafety                 in_mt_safety = Anvil::MTSafety::INHERIT_FROM_PARENT_DEVICE,
+                                                           VkDeviceSize             in_page_size = 0);
+
+        /** Moves memory regions assigned to the specified buffers around, so that free space is consolidated and
+         *  device memory objects which end up empty can be released.
+         *
+         *  Each buffer whose storage has been moved is recreated and bound to its new location with
+         *  Buffer::rebind_nonsparse_memory(). Contents are preserved. Afterward, @param in_opt_buffer_moved_callback_function
+         *  is invoked for the buffer, so that the owner can update buffer views, descriptor sets and child buffers which
+         *  still refer to the old VkBuffer handle.
+         *
+         *  Only supported by VMA allocators. The library only relocates allocations which come from host-visible
+         *  memory types and have not been made as dedicated allocations. The data is copied on the CPU, so no
+         *  command buffers need to be recorded or submitted. Sparse buffers, child buffers and buffers whose memory
+         *  is persistently mapped are skipped.
+         *
+         *  None of the buffers may be in use by the device, or mapped, at call time.
+         *
+         *  @param in_n_buffers                          Number of buffers under @param in_buffers_ptr.
+         *  @param in_buffers_ptr                        Buffers whose memory may be moved. Other allocations are left intact.
+         *  @param in_opt_buffer_moved_callback_function Function to call for each moved buffer. May be nullptr.
+         *  @param out_opt_stats_ptr                     If not nullptr, deref will be set to defragmentation stats.
+         *  @param in_max_bytes_to_move                  Maximum number of bytes to copy.
+         *  @param in_max_allocations_to_move            Maximum number of allocations to move.
+         *
+         *  @return true if successful, false if the allocator uses a different backend or the operation failed.
+         **/
+        bool defragment(uint32_t                           in_n_buffers,
+                        Anvil::Buffer* const*              in_buffers_ptr,
+                        MemoryAllocatorBufferMovedCallback in_opt_buffer_moved_callback_function = nullptr,
+                        DefragmentationStats*              out_opt_stats_ptr                     = nullptr,
+                        VkDeviceSize                       in_max_bytes_to_move                  = VK_WHOLE_SIZE,
+                        uint32_t                           in_max_allocations_to_move            = UINT32_MAX);
+
+        /** Returns the number of bytes bake() invocations have saved by reordering items before laying them out
+         *  in memory, compared to using the order in which the items were added.
+         *
+         *  Only one-shot allocators reorder items. 0 is returned for all other allocator types.
+         **/
+        VkDeviceSize get_n_bytes_saved_by_item_reordering() const;
+
+        /** Returns allocator-wide totals. Cheap enough to be called every frame. */
+        CounterSnapshot get_counter_snapshot() const;
+
+        /** Retrieves per-heap, per-memory-type and total memory usage statistics, including how fragmented
+         *  the free space is.
+         *
+         *  For VMA allocators, this calls vmaCalculateStats(), which walks all allocations. Use
+         *  get_counter_snapshot() for per-frame queries instead.
+         **/
+        void get_statistics(MemoryStatisticsReport* out_result_ptr) const;
+
+        /** Returns the result of get_statistics() formatted as a JSON document. */
+        std::string get_statistics_json() const;
+
         /** By default, once memory regions are baked, memory allocator will bind them to objects specified
          *  at add_*() call time. Use cases exist where apps may prefer to handle this action on their own.
          *
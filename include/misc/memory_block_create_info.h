@@ -327,6 +327,16 @@ namespace Anvil
             m_mt_safety = in_mt_safety;
         }
 
+        /* Specifies a function to call right before a memory block instantiated from this create info is released.
+         *
+         * Memory allocator backends use this to reclaim regions of their own memory blocks, once the derived memory blocks
+         * they have handed out go out of scope. Regular memory blocks still release their memory after the call.
+         */
+        void set_on_release_callback_function(const Anvil::OnMemoryBlockReleaseCallbackFunction& in_callback_function)
+        {
+            m_on_release_callback_function = in_callback_function;
+        }
+
         /* Call to request a dedicated allocation for the memory block. Requirements are:
          *
          * 1) Device must support VK_KHR_dedicated_allocation.
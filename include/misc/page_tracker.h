@@ -28,10 +28,40 @@
 
 namespace Anvil
 {
-    /** Tracks memory page bindings for sparse images & sparse buffers */
+    /** Tracks memory page bindings for sparse images & sparse buffers.
+     *
+     *  Bindings are kept in an ordered map, keyed by their start offsets. Bound regions never overlap,
+     *  so lookups, splits and merges of bindings take logarithmic time.
+     **/
     class PageTracker
     {
     public:
+        /* Public type definitions */
+
+        /* Describes a region of the tracked memory range which has been bound to a memory block. */
+        typedef struct MemoryBlockBinding
+        {
+            MemoryBlock* memory_block_ptr;
+            VkDeviceSize memory_block_start_offset;
+            VkDeviceSize size;
+            VkDeviceSize start_offset;
+
+            MemoryBlockBinding(MemoryBlock* in_memory_block_ptr,
+                               VkDeviceSize in_memory_block_start_offset,
+                               VkDeviceSize in_size,
+                               VkDeviceSize in_start_offset)
+            {
+                memory_block_ptr          = in_memory_block_ptr;
+                memory_block_start_offset = in_memory_block_start_offset;
+                size                      = in_size;
+                start_offset              = in_start_offset;
+            }
+        } MemoryBlockBinding;
+
+        /* Bindings, keyed by their start offsets */
+        typedef std::map<VkDeviceSize, MemoryBlockBinding> MemoryBlockBindingMap;
+        typedef MemoryBlockBindingMap::const_iterator      MemoryBlockBindingMapConstIterator;
+
         /* Public functions */
 
         /** Constructor.
@@ -58,12 +88,26 @@ namespace Anvil
                                              VkDeviceSize  in_size,
                                              VkDeviceSize* out_memory_region_start_offset_ptr) const;
 
+        /** Retrieves all bindings which intersect the region <in_start_offset, in_start_offset + in_size>, ordered by
+         *  their start offsets. Returned bindings are clipped to the region. Unbound parts of the region are skipped.
+         *
+         *  @param in_start_offset  Start offset of the region to query.
+         *  @param in_size          Size of the region to query.
+         *  @param out_bindings_ptr Deref will be cleared and filled with the bindings. Must not be NULL.
+         */
+        void get_memory_blocks(VkDeviceSize                     in_start_offset,
+                               VkDeviceSize                     in_size,
+                               std::vector<MemoryBlockBinding>* out_bindings_ptr) const;
+
         /** The same memory block is often bound to more than just one page. PageTracker
          *  coalesces such occurences into a single descriptor.
          *
          *  This function can be used to retrieve a memory block, bound to a descriptor
          *  at a given index (@param in_n_memory_block).
          *
+         *  NOTE: Takes time linear in @param in_n_memory_block. Use get_memory_block_bindings_begin() and
+         *        get_memory_block_bindings_end() to visit all descriptors.
+         *
          *  @param in_n_memory_block See above. Must not be equal or larger than value returned
          *                           by get_n_memory_blocks().
          *
@@ -73,7 +117,22 @@ namespace Anvil
         {
             anvil_assert(in_n_memory_block < m_memory_blocks.size() );
 
-            return m_memory_blocks.at(in_n_memory_block).memory_block_ptr;
+            return std::next(m_memory_blocks.begin(),
+                             in_n_memory_block)->second.memory_block_ptr;
+        }
+
+        /** Returns an iterator to the first binding. Bindings are visited in ascending order of their start
+         *  offsets. The iterators are invalidated by set_binding() calls.
+         */
+        MemoryBlockBindingMapConstIterator get_memory_block_bindings_begin() const
+        {
+            return m_memory_blocks.cbegin();
+        }
+
+        /** Returns an iterator past the last binding. */
+        MemoryBlockBindingMapConstIterator get_memory_block_bindings_end() const
+        {
+            return m_memory_blocks.cend();
         }
 
         /** Returns the number of disjoint memory blocks */
@@ -101,6 +160,9 @@ namespace Anvil
         }
 
         /** Updates a locally tracked memory binding.
+         *
+         *  Existing bindings which partially overlap with the region are truncated or split. The new binding is
+         *  merged with adjacent bindings which refer to contiguous ranges of the same memory block.
          *
          *  @param in_memory_block_ptr          Memory block that is going to be bound. May be null,
          *                                      in which case it is assumed no physical memory backing
@@ -120,30 +182,13 @@ namespace Anvil
                          VkDeviceSize in_size);
 
     private:
-        /* Private type definitions */
-        typedef struct MemoryBlockBinding
-        {
-            MemoryBlock* memory_block_ptr;
-            VkDeviceSize memory_block_start_offset;
-            VkDeviceSize size;
-            VkDeviceSize start_offset;
-
-            MemoryBlockBinding(MemoryBlock* in_memory_block_ptr,
-                               VkDeviceSize in_memory_block_start_offset,
-                               VkDeviceSize in_size,
-                               VkDeviceSize in_start_offset)
-            {
-                memory_block_ptr          = in_memory_block_ptr;
-                memory_block_start_offset = in_memory_block_start_offset;
-                size                      = in_size;
-                start_offset              = in_start_offset;
-            }
-        } MemoryBlockBinding;
-
         /* Private functions */
+        MemoryBlockBindingMap::const_iterator find_binding (VkDeviceSize                    in_offset) const;
+        void                                  merge_binding(MemoryBlockBindingMap::iterator in_binding_iterator);
+        void                                  split_binding(VkDeviceSize                    in_offset);
 
         /* Private variables */
-        std::vector<MemoryBlockBinding>  m_memory_blocks;
+        MemoryBlockBindingMap            m_memory_blocks; /* Only holds bound regions */
         uint32_t                         m_n_memory_blocks_with_memory_backing;
         uint32_t                         m_n_pages_with_memory_backing;
         uint32_t                         m_n_total_pages;
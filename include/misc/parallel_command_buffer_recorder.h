@@ -0,0 +1,192 @@
+//
+// Copyright (c) 2017-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/** Defines a helper class which records secondary command buffers on multiple threads.
+ *
+ *  Each worker owns a separate command pool for every frame slot. The pools are created with MT safety
+ *  disabled, so recording does not take any lock which is shared between workers. Recording jobs are
+ *  distributed over a work-stealing thread pool, and the resulting secondary command buffers are executed
+ *  from the primary command buffer in the order in which the jobs have been specified.
+ **/
+#ifndef MISC_PARALLEL_COMMAND_BUFFER_RECORDER_H
+#define MISC_PARALLEL_COMMAND_BUFFER_RECORDER_H
+
+#include "misc/types.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+
+namespace Anvil
+{
+    class ParallelCommandBufferRecorder
+    {
+    public:
+        /* Public type definitions */
+
+        /** Recording job.
+         *
+         *  @param in_command_buffer_ptr Secondary command buffer to record commands into. Recording has already
+         *                               been started. The job must not stop it.
+         *  @param in_n_worker           Index of the worker executing the job. Can be used to access per-thread
+         *                               data without synchronization. Always smaller than get_n_workers().
+         **/
+        typedef std::function<void(Anvil::SecondaryCommandBuffer* in_command_buffer_ptr,
+                                   uint32_t                       in_n_worker)> RecordingJob;
+
+        /* Public functions */
+
+        /** Destructor.
+         *
+         *  Stops worker threads and releases all command pools and command buffers.
+         **/
+        ~ParallelCommandBufferRecorder();
+
+        /** Creates a new ParallelCommandBufferRecorder instance.
+         *
+         *  @param in_device_ptr         Device to use. Must not be nullptr.
+         *  @param in_queue_family_index Index of the queue family, to which primary command buffers passed to
+         *                               record() are going to be submitted.
+         *  @param in_n_frame_slots      Number of frames which can be in flight at the same time. Secondary
+         *                               command buffers recorded for a frame slot are kept alive until
+         *                               record() is called for the same slot again.
+         *  @param in_n_worker_threads   Number of worker threads to spawn. The thread calling record() also
+         *                               executes recording jobs, so 0 is a valid value.
+         *
+         *  @return New instance or nullptr if the function failed.
+         **/
+        static Anvil::ParallelCommandBufferRecorderUniquePtr create(Anvil::BaseDevice* in_device_ptr,
+                                                                    uint32_t           in_queue_family_index,
+                                                                    uint32_t           in_n_frame_slots,
+                                                                    uint32_t           in_n_worker_threads);
+
+        /** Returns the number of frame slots the recorder has been created for. */
+        uint32_t get_n_frame_slots() const
+        {
+            return m_n_frame_slots;
+        }
+
+        /** Returns the number of workers executing recording jobs, including the thread calling record(). */
+        uint32_t get_n_workers() const
+        {
+            return static_cast<uint32_t>(m_worker_queue_ptrs.size() );
+        }
+
+        /** Records the specified jobs into secondary command buffers, using all workers, and then records
+         *  a vkCmdExecuteCommands() call into @param in_primary_command_buffer_ptr. The secondary command
+         *  buffers are executed in the order of @param in_job_ptrs, no matter which workers recorded them.
+         *
+         *  Blocks until all jobs have finished.
+         *
+         *  Command buffers previously recorded for @param in_n_frame_slot are recycled by this call. It is
+         *  the caller's responsibility to make sure the GPU has finished executing them.
+         *
+         *  This function must not be called from more than one thread at a time.
+         *
+         *  @param in_primary_command_buffer_ptr Primary command buffer to execute the secondary command buffers from.
+         *                                       Recording must be in progress. If @param in_render_pass_ptr is not
+         *                                       nullptr, the render pass must have been started with the
+         *                                       SECONDARY_COMMAND_BUFFERS subpass contents.
+         *  @param in_n_frame_slot               Frame slot to use. Must be smaller than get_n_frame_slots().
+         *  @param in_render_pass_ptr            Render pass the secondary command buffers are going to be executed in,
+         *                                       or nullptr if they will be executed outside a render pass.
+         *  @param in_subpass_id                 Subpass the secondary command buffers are going to be executed in.
+         *                                       Ignored if @param in_render_pass_ptr is nullptr.
+         *  @param in_framebuffer_ptr            Framebuffer the secondary command buffers are going to render to.
+         *                                       May be nullptr.
+         *  @param in_n_jobs                     Number of jobs under @param in_job_ptrs.
+         *  @param in_job_ptrs                   Array of recording jobs. Each job is recorded into a separate
+         *                                       secondary command buffer.
+         *
+         *  @return true if all jobs have been recorded and executed successfully, false otherwise.
+         **/
+        bool record(Anvil::PrimaryCommandBuffer* in_primary_command_buffer_ptr,
+                    uint32_t                     in_n_frame_slot,
+                    Anvil::RenderPass*           in_render_pass_ptr,
+                    Anvil::SubPassID             in_subpass_id,
+                    Anvil::Framebuffer*          in_framebuffer_ptr,
+                    uint32_t                     in_n_jobs,
+                    const RecordingJob*          in_job_ptrs);
+
+    private:
+        /* Private type definitions */
+
+        /* Per-worker job queue. The owner pops jobs from the back, other workers steal them from the front. */
+        typedef struct WorkerQueue
+        {
+            std::deque<uint32_t> job_indices;
+            std::mutex           mutex;
+        } WorkerQueue;
+
+        /* Per-worker, per-frame slot data. Only ever accessed by the worker which owns it. */
+        typedef struct WorkerFrameSlotData
+        {
+            Anvil::CommandPoolUniquePtr                         command_pool_ptr;
+            std::vector<Anvil::SecondaryCommandBufferUniquePtr> command_buffer_ptrs;
+        } WorkerFrameSlotData;
+
+        /* Private functions */
+        ParallelCommandBufferRecorder(Anvil::BaseDevice* in_device_ptr,
+                                      uint32_t           in_n_frame_slots);
+
+        bool init                (uint32_t  in_queue_family_index,
+                                  uint32_t  in_n_worker_threads);
+        bool pop_job             (uint32_t  in_n_worker,
+                                  uint32_t* out_job_index_ptr);
+        void record_job          (uint32_t  in_n_worker,
+                                  uint32_t  in_n_job);
+        void run_jobs            (uint32_t  in_n_worker);
+        void worker_thread_main  (uint32_t  in_n_worker);
+
+        /* Private variables */
+        Anvil::BaseDevice* m_device_ptr;
+        uint32_t           m_n_frame_slots;
+
+        std::vector<std::unique_ptr<WorkerQueue> > m_worker_queue_ptrs;
+        std::vector<WorkerFrameSlotData>           m_worker_frame_slot_data; /* [n_frame_slot * n_workers + n_worker] */
+        std::vector<std::thread>                   m_worker_threads;
+
+        /* Current batch. Only modified by record() while no worker is busy. */
+        std::atomic<bool>                            m_batch_failed;
+        uint64_t                                     m_batch_id;
+        std::vector<Anvil::SecondaryCommandBuffer*>  m_batch_command_buffer_ptrs;
+        Anvil::Framebuffer*                          m_batch_framebuffer_ptr;
+        const RecordingJob*                          m_batch_job_ptrs;
+        uint32_t                                     m_batch_n_frame_slot;
+        std::atomic<uint32_t>                        m_batch_n_jobs_remaining;
+        Anvil::RenderPass*                           m_batch_render_pass_ptr;
+        Anvil::SubPassID                             m_batch_subpass_id;
+
+        std::condition_variable m_batch_finished_cv;
+        std::mutex              m_batch_mutex;
+        std::condition_variable m_batch_started_cv;
+        uint32_t                m_n_busy_workers;
+        bool                    m_terminating;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(ParallelCommandBufferRecorder);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(ParallelCommandBufferRecorder);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_PARALLEL_COMMAND_BUFFER_RECORDER_H */
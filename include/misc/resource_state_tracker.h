@@ -0,0 +1,263 @@
+//
+// Copyright (c) 2017-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/** Defines a tracker which remembers the layout, pending accesses and queue family ownership of buffer ranges
+ *  and image subresources, and records the minimal pipeline barriers needed to switch them to a new usage.
+ *
+ *  Instead of hand-writing barriers, apps declare how a resource is about to be used by calling use_buffer()
+ *  or use_image() before recording the commands which access it. The tracker then only waits for the pipeline
+ *  stages which have actually accessed the resource, and only flushes the accesses which actually wrote to it:
+ *
+ *  - read after write:  waits for the last write, unless the stage has already been synchronized with it.
+ *  - read after read:   no barrier, unless the layout changes.
+ *  - write after read:  execution dependency on all stages which have read the resource since the last write.
+ *  - write after write: memory dependency on the last write.
+ *
+ *  The tracker assumes command buffers are submitted in the same order as use_*() calls are made for them.
+ *  Barriers are recorded with record_pipeline_barrier(), one call per use_*() invocation. Enable barrier batching
+ *  on the command buffer to fold barriers generated for consecutive use_*() calls into a single Vulkan call.
+ *
+ *  Not thread-safe.
+ **/
+#ifndef MISC_RESOURCE_STATE_TRACKER_H
+#define MISC_RESOURCE_STATE_TRACKER_H
+
+#include "misc/types.h"
+#include <unordered_map>
+
+
+namespace Anvil
+{
+    class ResourceStateTracker
+    {
+    public:
+        /* Public type definitions */
+
+        /** Resource usages which can be declared with use_buffer() and use_image().
+         *
+         *  Image layouts implied by the usages are ignored for buffers.
+         **/
+        enum class Usage
+        {
+            COLOR_ATTACHMENT,         /* COLOR_ATTACHMENT_OPTIMAL, read and written by color attachment output         */
+            DEPTH_STENCIL_ATTACHMENT, /* DEPTH_STENCIL_ATTACHMENT_OPTIMAL, read and written by fragment tests        */
+            DEPTH_STENCIL_READ_ONLY,  /* DEPTH_STENCIL_READ_ONLY_OPTIMAL, read by fragment tests and fragment shaders */
+            HOST_READ,                /* GENERAL, read by the host after the command buffer finishes executing      */
+            INDEX_BUFFER,             /* Read by vertex input as index data                                         */
+            INDIRECT_BUFFER,          /* Read as indirect draw or dispatch arguments                                */
+            PRESENT,                  /* PRESENT_SRC_KHR, handed over to the presentation engine                    */
+            SAMPLED_COMPUTE,          /* SHADER_READ_ONLY_OPTIMAL, read by compute shaders                          */
+            SAMPLED_FRAGMENT,         /* SHADER_READ_ONLY_OPTIMAL, read by fragment shaders                         */
+            SAMPLED_VERTEX,           /* SHADER_READ_ONLY_OPTIMAL, read by vertex shaders                           */
+            STORAGE_READ_COMPUTE,     /* GENERAL, read by compute shaders                                           */
+            STORAGE_READ_FRAGMENT,    /* GENERAL, read by fragment shaders                                          */
+            STORAGE_WRITE_COMPUTE,    /* GENERAL, read and written by compute shaders                               */
+            STORAGE_WRITE_FRAGMENT,   /* GENERAL, read and written by fragment shaders                              */
+            TRANSFER_DST,             /* TRANSFER_DST_OPTIMAL, written by transfer commands                         */
+            TRANSFER_SRC,             /* TRANSFER_SRC_OPTIMAL, read by transfer commands                            */
+            UNIFORM_BUFFER,           /* Read as uniform data by vertex, fragment and compute shaders               */
+            VERTEX_BUFFER,            /* Read by vertex input as vertex attribute data                              */
+
+            COUNT
+        };
+
+        /** Describes how a resource is accessed for a given usage. */
+        typedef struct UsageInfo
+        {
+            VkAccessFlags        access;   /* Access types performed by the usage                  */
+            bool                 is_write; /* true if the usage modifies the resource's contents   */
+            VkImageLayout        layout;   /* Layout images need to be in. Ignored for buffers.     */
+            VkPipelineStageFlags stages;   /* Pipeline stages which access the resource             */
+        } UsageInfo;
+
+        /* Public functions */
+
+        /** Creates a new tracker instance, which does not track any resources yet. */
+        static Anvil::ResourceStateTrackerUniquePtr create();
+
+        /** Destructor. */
+        ~ResourceStateTracker();
+
+        /** Returns the pipeline stages, access types and image layout corresponding to the specified usage. */
+        static UsageInfo get_usage_info(Usage in_usage);
+
+        /** Stops tracking the specified buffer. Must be called before the buffer is released, if it has been
+         *  passed to use_buffer() before. */
+        void forget_buffer(Anvil::Buffer* in_buffer_ptr);
+
+        /** Stops tracking the specified image. Must be called before the image is released, if it has been
+         *  passed to use_image() or set_image_layout() before. */
+        void forget_image(Anvil::Image* in_image_ptr);
+
+        /** Tells the tracker the layout of the whole image has been changed outside of its control, for instance
+         *  after a swapchain image has been acquired (UNDEFINED) or a render pass has transitioned it. Any accesses
+         *  pending for the image are considered complete.
+         *
+         *  Images which have never been passed to the tracker are assumed to be in the post-alloc layout (or the
+         *  post-create layout, if the former is UNDEFINED) specified at creation time.
+         **/
+        void set_image_layout(Anvil::Image*      in_image_ptr,
+                              Anvil::ImageLayout in_layout);
+
+        /** Records a pipeline barrier which makes the specified buffer range safe to use in the specified way,
+         *  if one is needed.
+         *
+         *  If the buffer uses exclusive sharing and has last been used by a different queue family, the barrier
+         *  is the acquire half of a queue family ownership transfer. The matching release operation must be
+         *  recorded by the app on the source queue.
+         *
+         *  Must not be called while a render pass is active.
+         *
+         *  @param in_command_buffer_ptr Command buffer to record the barrier into. Must be in the recording state.
+         *  @param in_buffer_ptr         Buffer to use. Must not be nullptr.
+         *  @param in_usage              Upcoming usage of the buffer range.
+         *  @param in_offset             Start offset of the range.
+         *  @param in_size               Size of the range, or VK_WHOLE_SIZE to use the rest of the buffer.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool use_buffer(Anvil::CommandBufferBase* in_command_buffer_ptr,
+                        Anvil::Buffer*            in_buffer_ptr,
+                        Usage                     in_usage,
+                        VkDeviceSize              in_offset = 0,
+                        VkDeviceSize              in_size   = VK_WHOLE_SIZE);
+
+        /** Records a pipeline barrier which makes the specified image subresources safe to use in the specified way,
+         *  transitioning them to the layout the usage requires. Subresources in different states get separate
+         *  image barriers, all of which are recorded with a single record_pipeline_barrier() call.
+         *
+         *  Queue family ownership is handled as for use_buffer().
+         *
+         *  Must not be called while a render pass is active.
+         *
+         *  @param in_command_buffer_ptr  Command buffer to record the barrier into. Must be in the recording state.
+         *  @param in_image_ptr           Image to use. Must not be nullptr.
+         *  @param in_usage               Upcoming usage of the subresources.
+         *  @param in_opt_subresource_ptr Subresources to use, or nullptr to use the whole image. Aspects are not
+         *                                tracked separately, so the aspect mask is only forwarded to the barrier.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool use_image(Anvil::CommandBufferBase*           in_command_buffer_ptr,
+                       Anvil::Image*                       in_image_ptr,
+                       Usage                               in_usage,
+                       const Anvil::ImageSubresourceRange* in_opt_subresource_ptr = nullptr);
+
+    private:
+        /* Private type definitions */
+
+        /** Synchronization state of a single buffer range or image subresource. */
+        typedef struct AccessState
+        {
+            VkImageLayout        layout;
+            uint32_t             queue_family_index; /* VK_QUEUE_FAMILY_IGNORED if not owned by any queue family yet */
+            VkPipelineStageFlags read_stages;        /* Stages which have been synchronized with the last write      */
+            VkAccessFlags        visible_access;     /* Accesses the last write has been made visible to             */
+            VkAccessFlags        write_access;       /* Access types of the last write                               */
+            VkPipelineStageFlags write_stages;       /* Stages of the last write                                     */
+
+            explicit AccessState(VkImageLayout in_layout)
+                :layout            (in_layout),
+                 queue_family_index(VK_QUEUE_FAMILY_IGNORED),
+                 read_stages       (0),
+                 visible_access    (0),
+                 write_access      (0),
+                 write_stages      (0)
+            {
+                /* Stub */
+            }
+
+            bool operator==(const AccessState& in_state) const
+            {
+                return (layout             == in_state.layout             &&
+                        queue_family_index == in_state.queue_family_index &&
+                        read_stages        == in_state.read_stages        &&
+                        visible_access     == in_state.visible_access     &&
+                        write_access       == in_state.write_access       &&
+                        write_stages       == in_state.write_stages);
+            }
+        } AccessState;
+
+        /** Source half of a barrier generated for a single buffer range or image subresource. */
+        typedef struct BarrierInfo
+        {
+            VkImageLayout        old_layout;
+            VkAccessFlags        src_access;
+            uint32_t             src_queue_family_index;
+            VkPipelineStageFlags src_stages;
+
+            bool operator==(const BarrierInfo& in_info) const
+            {
+                return (old_layout             == in_info.old_layout             &&
+                        src_access             == in_info.src_access             &&
+                        src_queue_family_index == in_info.src_queue_family_index &&
+                        src_stages             == in_info.src_stages);
+            }
+        } BarrierInfo;
+
+        typedef struct BufferRangeState
+        {
+            VkDeviceSize end;
+            VkDeviceSize start;
+            AccessState  state;
+
+            BufferRangeState(VkDeviceSize in_start,
+                             VkDeviceSize in_end)
+                :end  (in_end),
+                 start(in_start),
+                 state(VK_IMAGE_LAYOUT_UNDEFINED)
+            {
+                /* Stub */
+            }
+        } BufferRangeState;
+
+        typedef struct ImageState
+        {
+            uint32_t                 n_layers;
+            std::vector<AccessState> subresource_states; /* [n_mip * n_layers + n_layer] */
+        } ImageState;
+
+        /* Private functions */
+        ResourceStateTracker();
+
+        static bool transition(const UsageInfo& in_usage_info,
+                               uint32_t         in_queue_family_index,
+                               bool             in_is_exclusive,
+                               bool             in_is_image,
+                               AccessState*     inout_state_ptr,
+                               BarrierInfo*     out_barrier_info_ptr);
+
+        ImageState* get_image_state(Anvil::Image* in_image_ptr);
+
+        /* Private variables */
+        std::unordered_map<Anvil::Buffer*, std::vector<BufferRangeState> > m_buffer_states;
+        std::unordered_map<Anvil::Image*,  ImageState>                     m_image_states;
+
+        std::vector<Anvil::BufferBarrier> m_scratch_buffer_barriers;
+        std::vector<Anvil::ImageBarrier>  m_scratch_image_barriers;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(ResourceStateTracker);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(ResourceStateTracker);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_RESOURCE_STATE_TRACKER_H */
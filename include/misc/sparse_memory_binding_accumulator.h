@@ -0,0 +1,175 @@
+//
+// Copyright (c) 2017-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/** Defines an accumulator for sparse memory binding updates, which lets many small updates, possibly issued from
+ *  multiple places in a frame, reach the queue with a single vkQueueBindSparse() call:
+ *
+ *      accumulator_ptr->append_image_memory_update(terrain_image_ptr, ..);
+ *      accumulator_ptr->append_buffer_memory_update(vertex_pool_buffer_ptr, ..);
+ *      ..
+ *      accumulator_ptr->submit(sparse_queue_ptr, fence_ptr);
+ *
+ *  Updates are grouped per resource. An update which continues the previous update of the same resource, both
+ *  in resource and in memory space, is merged into it, so that contiguous page ranges are bound with a single
+ *  VkSparseMemoryBind or VkSparseImageMemoryBind item. Image updates are merged along the X axis, as long as both
+ *  updates cover a single row of tiles of the same subresource. Updates which transfer memory block ownership to
+ *  the resource are never merged.
+ *
+ *  Updates of a single resource are submitted in the order they were appended in. The order in which updates of
+ *  different resources are applied is undefined.
+ *
+ *  All updates are submitted with default memory and resource device indices.
+ *
+ *  MT-safe if the accumulator has been created with MT safety enabled.
+ **/
+#ifndef MISC_SPARSE_MEMORY_BINDING_ACCUMULATOR_H
+#define MISC_SPARSE_MEMORY_BINDING_ACCUMULATOR_H
+
+#include "misc/mt_safety.h"
+#include "misc/types.h"
+#include <map>
+
+
+namespace Anvil
+{
+    class SparseMemoryBindingAccumulator : public MTSafetySupportProvider
+    {
+    public:
+        /* Public functions */
+
+        /** Creates a new accumulator instance.
+         *
+         *  @param in_mt_safe true if the accumulator should be MT-safe.
+         **/
+        static Anvil::SparseMemoryBindingAccumulatorUniquePtr create(bool in_mt_safe);
+
+        /** Destructor. Updates which have not been submitted are dropped. */
+        ~SparseMemoryBindingAccumulator();
+
+        /** Adds a semaphore to signal after the updates are applied at the next submit() call. */
+        void add_signal_semaphore(Anvil::Semaphore* in_semaphore_ptr);
+
+        /** Adds a semaphore to wait on before the updates are applied at the next submit() call. */
+        void add_wait_semaphore(Anvil::Semaphore* in_semaphore_ptr);
+
+        /** Appends a new buffer memory update. Arguments are as per
+         *  SparseMemoryBindingUpdateInfo::append_buffer_memory_update().
+         **/
+        void append_buffer_memory_update(Anvil::Buffer*      in_buffer_ptr,
+                                         VkDeviceSize        in_buffer_memory_start_offset,
+                                         Anvil::MemoryBlock* in_memory_block_ptr,
+                                         VkDeviceSize        in_memory_block_start_offset,
+                                         bool                in_memory_block_owned_by_buffer,
+                                         VkDeviceSize        in_size);
+
+        /** Appends a new non-opaque image memory update. Arguments are as per
+         *  SparseMemoryBindingUpdateInfo::append_image_memory_update().
+         **/
+        void append_image_memory_update(Anvil::Image*                  in_image_ptr,
+                                        const Anvil::ImageSubresource& in_subresource,
+                                        const VkOffset3D&              in_offset,
+                                        const VkExtent3D&              in_extent,
+                                        Anvil::MemoryBlock*            in_opt_memory_block_ptr,
+                                        VkDeviceSize                   in_opt_memory_block_start_offset,
+                                        bool                           in_opt_memory_block_owned_by_image);
+
+        /** Appends a new opaque image memory update. Arguments are as per
+         *  SparseMemoryBindingUpdateInfo::append_opaque_image_memory_update().
+         **/
+        void append_opaque_image_memory_update(Anvil::Image*                in_image_ptr,
+                                               VkDeviceSize                 in_resource_offset,
+                                               VkDeviceSize                 in_size,
+                                               Anvil::SparseMemoryBindFlags in_flags,
+                                               Anvil::MemoryBlock*          in_opt_memory_block_ptr,
+                                               VkDeviceSize                 in_opt_memory_block_start_offset,
+                                               bool                         in_opt_memory_block_owned_by_image);
+
+        /** Drops all updates and semaphores added since the last submit() call. */
+        void reset();
+
+        /** Returns the number of updates appended since the last submit() call. */
+        uint32_t get_n_appended_updates() const
+        {
+            return m_n_appended_updates;
+        }
+
+        /** Returns the number of bind items the next submit() call is going to pass to the driver. Never larger than
+         *  the number of appended updates. */
+        uint32_t get_n_pending_updates() const
+        {
+            return m_n_pending_updates;
+        }
+
+        /** Submits all accumulated updates to the specified queue with a single bind_sparse_memory() call, and
+         *  resets the accumulator. Nothing is submitted if there are no updates, semaphores or fence to submit.
+         *
+         *  @param in_queue_ptr     Queue to use. Must support sparse bindings.
+         *  @param in_opt_fence_ptr Fence to signal after the updates are applied. May be nullptr.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool submit(Anvil::Queue* in_queue_ptr,
+                    Anvil::Fence* in_opt_fence_ptr = nullptr);
+
+    private:
+        /* Private type definitions */
+        typedef struct GeneralUpdate
+        {
+            Anvil::SparseMemoryBindFlags flags;
+            bool                         memory_block_owned_by_target;
+            Anvil::MemoryBlock*          memory_block_ptr;
+            VkDeviceSize                 memory_block_start_offset;
+            VkDeviceSize                 resource_offset;
+            VkDeviceSize                 size;
+        } GeneralUpdate;
+
+        typedef struct ImageUpdate
+        {
+            VkExtent3D              extent;
+            bool                    memory_block_owned_by_image;
+            Anvil::MemoryBlock*     memory_block_ptr;
+            VkDeviceSize            memory_block_start_offset;
+            VkOffset3D              offset;
+            Anvil::ImageSubresource subresource;
+        } ImageUpdate;
+
+        /* Private functions */
+        explicit SparseMemoryBindingAccumulator(bool in_mt_safe);
+
+        bool append_general_update(std::vector<GeneralUpdate>* in_updates_ptr,
+                                   const GeneralUpdate&        in_update);
+
+        /* Private variables */
+        std::map<Anvil::Buffer*, std::vector<GeneralUpdate> > m_buffer_updates;
+        std::map<Anvil::Image*,  std::vector<GeneralUpdate> > m_image_opaque_updates;
+        std::map<Anvil::Image*,  std::vector<ImageUpdate> >   m_image_updates;
+        uint32_t                                              m_n_appended_updates;
+        uint32_t                                              m_n_pending_updates;
+        std::vector<Anvil::Semaphore*>                        m_signal_semaphores;
+        std::vector<Anvil::Semaphore*>                        m_wait_semaphores;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(SparseMemoryBindingAccumulator);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(SparseMemoryBindingAccumulator);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_SPARSE_MEMORY_BINDING_ACCUMULATOR_H */
@@ -0,0 +1,273 @@
+//
+// Copyright (c) 2017-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/** Defines a residency manager for sparse images, which are too large to be fully backed with physical memory.
+ *
+ *  The streamer owns a fixed pool of physical pages, each as large as a single sparse image tile. Apps request
+ *  tiles they are going to sample from, usually based on GPU feedback:
+ *
+ *      for (const auto& tile_id : visible_tiles)
+ *      {
+ *          if (!streamer_ptr->is_tile_resident(tile_id) )
+ *          {
+ *              streamer_ptr->request_tile(tile_id, load_tile_data(tile_id), tile_data_size);
+ *          }
+ *          else
+ *          {
+ *              streamer_ptr->request_tile(tile_id, nullptr, 0);
+ *          }
+ *      }
+ *
+ *      streamer_ptr->flush();
+ *
+ *  A request for a tile which is already resident marks it as recently used. A request for a non-resident tile
+ *  assigns a free page to it. If no page is free, the least recently used tile loses its page. Binding changes
+ *  are accumulated until flush(), which submits them with a single bind_sparse_memory() call, coalesced by
+ *  a SparseMemoryBindingAccumulator, and then uploads tile data through the streamer's staging ring. Uploads
+ *  wait on a semaphore signalled by the binding operations, so flush() does not wait for the binds to execute.
+ *
+ *  Only tiles of mips preceding the mip tail can be streamed. The mip tail, as well as metadata, must be bound by
+ *  the app.
+ *
+ *  If any page is reused for another tile, flush() waits until uploads issued by earlier flush() calls complete.
+ *  Other GPU work is synchronized with semaphores: work which may still access tiles losing their pages should
+ *  signal a semaphore passed to add_wait_semaphore(), and work sampling the streamed tiles should wait on
+ *  a semaphore passed to add_signal_semaphore():
+ *
+ *      streamer_ptr->add_wait_semaphore  (previous_frame_done_semaphore_ptr);
+ *      streamer_ptr->add_signal_semaphore(tiles_ready_semaphore_ptr);
+ *      streamer_ptr->flush();
+ *
+ *  MT-safe if the streamer has been created with MT safety enabled.
+ **/
+#ifndef MISC_SPARSE_TEXTURE_STREAMER_H
+#define MISC_SPARSE_TEXTURE_STREAMER_H
+
+#include "misc/mt_safety.h"
+#include "misc/types.h"
+#include <deque>
+#include <list>
+#include <map>
+
+
+namespace Anvil
+{
+    class SparseTextureStreamer : public MTSafetySupportProvider
+    {
+    public:
+        /* Public type definitions */
+
+        /* Identifies a single tile of a sparse image. Tile coordinates are expressed in units of the aspect's
+         * sparse image granularity. */
+        typedef struct TileID
+        {
+            Anvil::ImageAspectFlagBits aspect;
+            uint32_t                   n_layer;
+            uint32_t                   n_mip;
+            uint32_t                   x;
+            uint32_t                   y;
+            uint32_t                   z;
+
+            TileID()
+                :aspect (Anvil::ImageAspectFlagBits::COLOR_BIT),
+                 n_layer(0),
+                 n_mip  (0),
+                 x      (0),
+                 y      (0),
+                 z      (0)
+            {
+                /* Stub */
+            }
+
+            TileID(Anvil::ImageAspectFlagBits in_aspect,
+                   uint32_t                   in_n_layer,
+                   uint32_t                   in_n_mip,
+                   uint32_t                   in_x,
+                   uint32_t                   in_y,
+                   uint32_t                   in_z = 0)
+                :aspect (in_aspect),
+                 n_layer(in_n_layer),
+                 n_mip  (in_n_mip),
+                 x      (in_x),
+                 y      (in_y),
+                 z      (in_z)
+            {
+                /* Stub */
+            }
+
+            bool operator<(const TileID& in_tile_id) const;
+        } TileID;
+
+        /* Public functions */
+
+        /** Creates a new streamer instance.
+         *
+         *  @param in_image_ptr          Sparse image to manage. Must have been created with the SPARSE_RESIDENCY
+         *                               flag, must not be released before the streamer and must not have any memory
+         *                               bound to the tiles the streamer is going to manage.
+         *  @param in_image_layout       Layout the image is going to be in when tile data is uploaded. Must be
+         *                               GENERAL or TRANSFER_DST_OPTIMAL.
+         *  @param in_n_pages            Number of physical pages to allocate. Determines the streamer's memory
+         *                               footprint. Must not be 0.
+         *  @param in_sparse_queue_ptr   Queue to submit sparse binding operations to. Must support sparse bindings.
+         *  @param in_transfer_queue_ptr Queue to upload tile data on. Must support transfer operations.
+         *  @param in_staging_ring_size  Size of the staging ring tile data is uploaded through, in bytes. Must be
+         *                               large enough to hold a single tile's data.
+         *  @param in_mt_safe            true if the streamer should be MT-safe.
+         *
+         *  @return New instance or nullptr, if the page pool or the staging ring could not be created.
+         **/
+        static Anvil::SparseTextureStreamerUniquePtr create(Anvil::Image*      in_image_ptr,
+                                                            Anvil::ImageLayout in_image_layout,
+                                                            uint32_t           in_n_pages,
+                                                            Anvil::Queue*      in_sparse_queue_ptr,
+                                                            Anvil::Queue*      in_transfer_queue_ptr,
+                                                            VkDeviceSize       in_staging_ring_size,
+                                                            bool               in_mt_safe);
+
+        /** Destructor. Takes pages away from all resident tiles and waits until pending binds and uploads
+         *  complete. */
+        ~SparseTextureStreamer();
+
+        /** Adds a semaphore to signal once the binding changes and uploads submitted by the next flush() call
+         *  finish executing. */
+        void add_signal_semaphore(Anvil::Semaphore* in_semaphore_ptr);
+
+        /** Adds a semaphore for the next flush() call to wait on before any binding changes are applied. */
+        void add_wait_semaphore(Anvil::Semaphore* in_semaphore_ptr);
+
+        /** Submits all binding changes requested since the last call, and uploads data of newly resident tiles.
+         *  Semaphores added since the last call are waited on or signalled, even if there are no changes.
+         *
+         *  @return true if successful, false otherwise. If false is returned, binding changes and semaphores which
+         *          have not been submitted are retried at the next call.
+         **/
+        bool flush();
+
+        /** Returns the number of pages which are not assigned to any tile. */
+        uint32_t get_n_free_pages() const;
+
+        /** Returns the total number of pages in the pool. */
+        uint32_t get_n_pages() const
+        {
+            return m_n_pages;
+        }
+
+        /** Returns the size of a single page, in bytes. */
+        VkDeviceSize get_page_size() const
+        {
+            return m_page_size;
+        }
+
+        /** Tells whether the specified tile has a page assigned, or is going to have one at the next flush() call. */
+        bool is_tile_resident(const TileID& in_tile_id) const;
+
+        /** Takes the page away from the specified tile, if it has one, and returns it to the pool of free pages.
+         *
+         *  The tile is unbound at the next flush() call.
+         **/
+        void release_tile(const TileID& in_tile_id);
+
+        /** Requests the specified tile to become resident.
+         *
+         *  If the tile is already resident, it is marked as the most recently used one and the data is ignored.
+         *  Otherwise, a page is assigned to the tile, and the data is uploaded at the next flush() call.
+         *
+         *  @param in_tile_id   Tile to request. Its mip must precede the aspect's mip tail.
+         *  @param in_data_ptr  Tightly packed data for the tile's texels, clipped to the mip size. Must remain valid
+         *                      until the next flush() call. May be nullptr, in which case the tile's contents are
+         *                      undefined until the app fills them.
+         *  @param in_data_size Number of bytes under @param in_data_ptr.
+         *
+         *  @return true if the tile is resident or is going to become resident at the next flush() call, false if
+         *          all pages are assigned to tiles requested since the last flush() call.
+         **/
+        bool request_tile(const TileID& in_tile_id,
+                          const void*   in_data_ptr,
+                          VkDeviceSize  in_data_size);
+
+    private:
+        /* Private type definitions */
+        typedef struct BindSemaphore
+        {
+            Anvil::SemaphoreUniquePtr semaphore_ptr;
+            uint64_t                  staging_ring_batch_id; /* Batch which waits on the semaphore */
+        } BindSemaphore;
+
+        typedef struct PendingUpload
+        {
+            const void*  data_ptr;
+            VkDeviceSize data_size;
+        } PendingUpload;
+
+        typedef struct ResidentTile
+        {
+            std::list<TileID>::iterator lru_iterator;
+            uint64_t                    n_last_request_batch;
+            uint32_t                    n_page;
+        } ResidentTile;
+
+        /* Private functions */
+        SparseTextureStreamer(Anvil::Image*      in_image_ptr,
+                              Anvil::ImageLayout in_image_layout,
+                              uint32_t           in_n_pages,
+                              Anvil::Queue*      in_sparse_queue_ptr,
+                              Anvil::Queue*      in_transfer_queue_ptr,
+                              bool               in_mt_safe);
+
+        Anvil::SemaphoreUniquePtr acquire_bind_semaphore();
+
+        bool get_tile_region(const TileID& in_tile_id,
+                             VkOffset3D*   out_offset_ptr,
+                             VkExtent3D*   out_bind_extent_ptr,
+                             VkExtent3D*   out_copy_extent_ptr) const;
+        bool init           (VkDeviceSize  in_staging_ring_size);
+        void unassign_page  (std::map<TileID, ResidentTile>::iterator in_resident_tile_iterator);
+
+        /* Private variables */
+        Anvil::SparseMemoryBindingAccumulatorUniquePtr m_bind_accumulator_ptr;
+        std::deque<BindSemaphore>                      m_bind_semaphores; /* Oldest first */
+        std::vector<uint32_t>                          m_free_pages;
+        Anvil::Image*                                  m_image_ptr;
+        Anvil::ImageLayout                             m_image_layout;
+        std::list<TileID>                              m_lru_tiles;     /* Most recently requested tile first */
+        uint64_t                                       m_n_current_batch;
+        uint32_t                                       m_n_pages;
+        VkDeviceSize                                   m_page_size;
+        std::map<TileID, uint32_t>                     m_pending_binds; /* Tile -> page, or UINT32_MAX to unbind the tile */
+        std::map<TileID, PendingUpload>                m_pending_uploads;
+        bool                                           m_pending_page_reuse;
+        Anvil::MemoryBlockUniquePtr                    m_pool_memory_block_ptr;
+        std::map<TileID, ResidentTile>                 m_resident_tiles;
+        std::vector<Anvil::Semaphore*>                 m_signal_semaphores;
+        Anvil::Queue*                                  m_sparse_queue_ptr;
+        Anvil::StagingRingUniquePtr                    m_staging_ring_ptr;
+        Anvil::Queue*                                  m_transfer_queue_ptr;
+        Anvil::SemaphoreUniquePtr                      m_unused_bind_semaphore_ptr; /* Left over by a failed bind submission */
+        std::vector<Anvil::Semaphore*>                 m_wait_semaphores;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(SparseTextureStreamer);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(SparseTextureStreamer);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_SPARSE_TEXTURE_STREAMER_H */
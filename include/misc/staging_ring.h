@@ -0,0 +1,298 @@
+//
+// Copyright (c) 2017-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/** Defines a device-level staging ring, used to transfer data to and from buffers backed by non-mappable memory.
+ *
+ *  The ring is a single, persistently mapped buffer. Each upload copies the data into the next free region of the
+ *  ring and records a buffer->buffer copy into the command buffer of the current batch. Downloads work the other way
+ *  round: the copy is recorded right away, but the data is only copied out of the ring when the batch retires, that is
+ *  once the device has finished executing it and the ring needs its space back, or the app waits for the download.
+ *  This happens whether or not the app waits, so the destination of a download must stay valid until the batch retires.
+ *
+ *  A batch is submitted by flush(), or whenever a transfer needs to be executed on a different queue or device mask,
+ *  or the ring runs out of space. Each submitted batch is associated with a fence. Regions of the ring are only reused
+ *  after the fence of the batch which used them has been signalled, so the CPU only blocks if the ring is full:
+ *
+ *      for (auto& upload : uploads)
+ *      {
+ *          staging_ring_ptr->upload(upload.buffer_ptr, upload.offset, upload.size, upload.data_ptr, queue_ptr);
+ *      }
+ *
+ *      staging_ring_ptr->download(buffer_ptr, 0, size, result_ptr, queue_ptr, UINT32_MAX, nullptr, &download_id);
+ *
+ *      staging_ring_ptr->flush();
+ *      ..
+ *      staging_ring_ptr->wait_for_download(download_id);
+ *
+ *  Transfers are ordered with other work submitted to the same queue, since the batches include pipeline barriers
+ *  against all commands. Work submitted to other queues needs to be synchronized by the app, either with semaphores
+ *  passed to add_wait_semaphore() and add_signal_semaphore(), or with flush(true).
+ *
+ *  Transfers larger than the ring are split into multiple batches. Image uploads are not split, so each of them
+ *  must fit in the ring.
+ *
+ *  MT-safe if the ring has been created with MT safety enabled.
+ **/
+#ifndef MISC_STAGING_RING_H
+#define MISC_STAGING_RING_H
+
+#include "misc/mt_safety.h"
+#include "misc/types.h"
+#include <deque>
+
+
+namespace Anvil
+{
+    /** Call-back invoked when a download retires.
+     *
+     *  @param in_result true if the data has been copied to the download's destination, false otherwise.
+     **/
+    typedef std::function<void (bool in_result)> StagingRingDownloadCallbackFunction;
+
+    class StagingRing : public MTSafetySupportProvider
+    {
+    public:
+        /* Public functions */
+
+        /** Creates a new staging ring.
+         *
+         *  @param in_device_ptr Device to create the ring on. Must not be nullptr.
+         *  @param in_size       Size of the ring, in bytes.
+         *  @param in_mt_safe    true if the ring should be MT-safe.
+         *
+         *  @return New instance or nullptr, if the ring buffer could not be created or mapped.
+         **/
+        static Anvil::StagingRingUniquePtr create(const Anvil::BaseDevice* in_device_ptr,
+                                                  VkDeviceSize             in_size,
+                                                  bool                     in_mt_safe);
+
+        /** Destructor. Submits the pending batch and waits until all batches finish executing. */
+        ~StagingRing();
+
+        /** Adds a semaphore to signal once the next submitted batch finishes executing. */
+        void add_signal_semaphore(Anvil::Semaphore* in_semaphore_ptr);
+
+        /** Adds a semaphore for the next submitted batch to wait on before its copies execute.
+         *
+         *  @param in_semaphore_ptr   Semaphore to wait on. Must not be signalled again before is_batch_retired()
+         *                            returns true for the returned batch ID.
+         *  @param in_wait_stage_mask Stages to block until the semaphore is signalled.
+         *
+         *  @return ID of the batch which is going to wait on the semaphore.
+         **/
+        uint64_t add_wait_semaphore(Anvil::Semaphore*         in_semaphore_ptr,
+                                    Anvil::PipelineStageFlags in_wait_stage_mask);
+
+        /** Records a copy of the specified buffer region into the ring.
+         *
+         *  The data is copied to @param out_data_ptr when the batch holding the copy retires. Retirement happens
+         *  regardless of whether the app waits for the download, for instance when the ring runs out of space or
+         *  flush(true) is called.
+         *
+         *  @param in_src_buffer_ptr          Buffer to read from. Must not be released before the download retires.
+         *  @param in_src_offset              Start offset of the region to read.
+         *  @param in_size                    Number of bytes to read.
+         *  @param out_data_ptr               Data will be stored under this location when the download retires.
+         *                                    Must remain valid until then, even if the app never waits for the
+         *                                    download. Must not be nullptr.
+         *  @param in_queue_ptr               Queue to execute the copy on. Must support transfer operations, and must
+         *                                    be compatible with the buffer's queue families.
+         *  @param in_device_mask             Device mask to execute the copy with. Ignored for single-GPU devices.
+         *  @param in_opt_callback_function   If not nullptr, invoked when the download retires, after the data has
+         *                                    been copied. Called with the ring locked, so it must not call back into
+         *                                    the ring.
+         *  @param out_opt_download_id_ptr    If not nullptr, deref will be set to an ID which can be passed to
+         *                                    wait_for_download().
+         *
+         *  @return true if the copy has been recorded, false otherwise. If false is returned, the call-back is
+         *          never invoked.
+         **/
+        bool download(Anvil::Buffer*                             in_src_buffer_ptr,
+                      VkDeviceSize                               in_src_offset,
+                      VkDeviceSize                               in_size,
+                      void*                                      out_data_ptr,
+                      Anvil::Queue*                              in_queue_ptr,
+                      uint32_t                                   in_device_mask           = UINT32_MAX,
+                      Anvil::StagingRingDownloadCallbackFunction in_opt_callback_function = Anvil::StagingRingDownloadCallbackFunction(),
+                      uint64_t*                                  out_opt_download_id_ptr  = nullptr);
+
+        /** Submits the pending batch, if any. Data written to non-coherent memory is flushed with a single call.
+         *
+         *  @param in_should_block true to wait until all batches submitted so far finish executing.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool flush(bool in_should_block = false);
+
+        /** Tells whether the batch with the specified ID has finished executing and released its region of the ring.
+         *  Batches retire in submission order. Does not block.
+         **/
+        bool is_batch_retired(uint64_t in_batch_id) const;
+
+        /** Returns the size of the ring, in bytes. */
+        VkDeviceSize get_size() const
+        {
+            return m_size;
+        }
+
+        /** Copies the specified data into the ring and records a copy into the specified buffer region.
+         *
+         *  The buffer is updated when the batch executes. The data can be released as soon as the function returns.
+         *
+         *  @param in_dst_buffer_ptr Buffer to write to. Must not be released before the batch finishes executing.
+         *  @param in_dst_offset     Start offset of the region to write.
+         *  @param in_size           Number of bytes to write.
+         *  @param in_data_ptr       Data to write. Must not be nullptr.
+         *  @param in_queue_ptr      As per download().
+         *  @param in_device_mask    As per download().
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool upload(Anvil::Buffer* in_dst_buffer_ptr,
+                    VkDeviceSize   in_dst_offset,
+                    VkDeviceSize   in_size,
+                    const void*    in_data_ptr,
+                    Anvil::Queue*  in_queue_ptr,
+                    uint32_t       in_device_mask = UINT32_MAX);
+
+        /** Copies the specified data into the ring and records a copy into the specified image region.
+         *
+         *  The data must be tightly packed, as if buffer_row_length and buffer_image_height were 0. The image is
+         *  updated when the batch executes. The data can be released as soon as the function returns.
+         *
+         *  NOTE: Ring regions are aligned to max(4, nonCoherentAtomSize) bytes, so formats whose texel block size
+         *        is not a power of two are not supported.
+         *
+         *  @param in_dst_image_ptr    Image to write to. Must not be released before the batch finishes executing.
+         *  @param in_dst_image_layout Layout the image region is going to be in when the batch executes. Must be
+         *                             GENERAL or TRANSFER_DST_OPTIMAL.
+         *  @param in_subresource      Image subresource to write to.
+         *  @param in_offset           Location of the first texel to write.
+         *  @param in_extent           Size of the region to write, in texels.
+         *  @param in_size             Number of bytes to write. Must not be larger than the ring.
+         *  @param in_data_ptr         Data to write. Must not be nullptr.
+         *  @param in_queue_ptr        As per download().
+         *  @param in_device_mask      As per download().
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool upload_to_image(Anvil::Image*                        in_dst_image_ptr,
+                             Anvil::ImageLayout                   in_dst_image_layout,
+                             const Anvil::ImageSubresourceLayers& in_subresource,
+                             const VkOffset3D&                    in_offset,
+                             const VkExtent3D&                    in_extent,
+                             VkDeviceSize                         in_size,
+                             const void*                          in_data_ptr,
+                             Anvil::Queue*                        in_queue_ptr,
+                             uint32_t                             in_device_mask = UINT32_MAX);
+
+        /** Submits the batch holding the specified download, if needed, and waits until the download retires.
+         *
+         *  @param in_download_id ID returned by download().
+         *
+         *  @return true if the data has been copied to the download's destination, false otherwise.
+         **/
+        bool wait_for_download(uint64_t in_download_id);
+
+    private:
+        /* Private type definitions */
+        typedef struct PendingRead
+        {
+            Anvil::StagingRingDownloadCallbackFunction callback_function; /* Only set for the last region of a download */
+            void*                                      out_data_ptr;
+            VkDeviceSize                               ring_offset;
+            VkDeviceSize                               size;
+        } PendingRead;
+
+        typedef struct Batch
+        {
+            Anvil::PrimaryCommandBufferUniquePtr cmd_buffer_ptr;
+            uint32_t                             device_mask;
+            Anvil::FenceUniquePtr                fence_ptr;
+            std::vector<VkMappedMemoryRange>     flush_ranges;
+            uint64_t                             id;
+            Anvil::Queue*                        queue_ptr;
+            std::vector<PendingRead>             reads;
+            VkDeviceSize                         start_offset; /* Ring offset of the batch's first region */
+
+            Batch()
+                :device_mask (0),
+                 id          (0),
+                 queue_ptr   (nullptr),
+                 start_offset(0)
+            {
+                /* Stub */
+            }
+        } Batch;
+
+        typedef std::unique_ptr<Batch> BatchUniquePtr;
+
+        /* Private functions */
+        StagingRing(const Anvil::BaseDevice* in_device_ptr,
+                    VkDeviceSize             in_size,
+                    bool                     in_mt_safe);
+
+        bool allocate        (VkDeviceSize         in_size,
+                              VkDeviceSize*        out_ring_offset_ptr);
+        bool begin_batch     (Anvil::Queue*        in_queue_ptr,
+                              uint32_t             in_device_mask,
+                              VkDeviceSize         in_start_offset);
+        bool init            ();
+        bool prepare_transfer(VkDeviceSize         in_size,
+                              Anvil::Queue*        in_queue_ptr,
+                              uint32_t             in_device_mask,
+                              VkDeviceSize*        out_ring_offset_ptr);
+        bool retire_batch    ();
+        bool submit_batch    ();
+        void write           (VkDeviceSize         in_ring_offset,
+                              const void*          in_data_ptr,
+                              VkDeviceSize         in_size);
+
+        VkMappedMemoryRange get_mapped_memory_range(VkDeviceSize in_ring_offset,
+                                                    VkDeviceSize in_size) const;
+
+        /* Private variables */
+        VkDeviceSize                m_alignment;
+        Anvil::BufferUniquePtr      m_buffer_ptr;
+        const Anvil::BaseDevice*    m_device_ptr;
+        VkDeviceSize                m_head_offset;        /* Ring offset the next region is going to start at, if it fits */
+        bool                        m_is_coherent;
+        std::deque<BatchUniquePtr>  m_in_flight_batches;  /* Submitted batches, oldest first                                */
+        uint8_t*                    m_mapped_data_ptr;
+        VkDeviceSize                m_memory_offset;      /* Offset of the ring's storage within its VkDeviceMemory          */
+        Anvil::MemoryBlock*         m_memory_block_ptr;
+        VkDeviceSize                m_memory_size;        /* Size of the VkDeviceMemory region backing the ring              */
+        uint64_t                    m_n_next_batch_id;
+        BatchUniquePtr              m_pending_batch_ptr;  /* Batch which is being recorded, or nullptr                       */
+
+        /* Semaphores to pass with the next submitted batch */
+        std::vector<Anvil::Semaphore*>         m_pending_signal_semaphores;
+        std::vector<Anvil::PipelineStageFlags> m_pending_wait_stage_masks;
+        std::vector<Anvil::Semaphore*>         m_pending_wait_semaphores;
+        VkDeviceSize                m_size;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(StagingRing);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(StagingRing);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_STAGING_RING_H */
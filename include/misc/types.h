@@ -109,11 +109,13 @@ namespace Anvil
     class  BasePipelineCreateInfo;
     class  Buffer;
     class  BufferCreateInfo;
+    class  BufferRingAllocator;
     class  BufferView;
     class  BufferViewCreateInfo;
     struct CallbackArgument;
     class  CommandBufferBase;
     class  CommandPool;
+    class  CommandStream;
     class  ComputePipelineCreateInfo;
     class  ComputePipelineManager;
     class  DebugMessenger;
@@ -130,7 +132,10 @@ namespace Anvil
     class  EventCreateInfo;
     class  Fence;
     class  FenceCreateInfo;
+    class  FencePool;
+    class  FrameContext;
     class  Framebuffer;
+    class  FrameGraph;
     class  FramebufferCreateInfo;
     class  GLSLShaderToSPIRVGenerator;
     class  GraphicsPipelineCreateInfo;
@@ -147,6 +152,7 @@ namespace Anvil
     struct MemoryProperties;
     struct MemoryType;
     class  MGPUDevice;
+    class  ParallelCommandBufferRecorder;
     class  PhysicalDevice;
     class  PipelineCache;
     class  PipelineLayout;
@@ -157,6 +163,7 @@ namespace Anvil
     class  RenderingSurface;
     class  RenderPass;
     class  RenderPassCreateInfo;
+    class  ResourceStateTracker;
     class  Sampler;
     class  SamplerCreateInfo;
     class  SecondaryCommandBuffer;
@@ -165,6 +172,9 @@ namespace Anvil
     class  SGPUDevice;
     class  ShaderModule;
     class  ShaderModuleCache;
+    class  SparseMemoryBindingAccumulator;
+    class  SparseTextureStreamer;
+    class  StagingRing;
     class  Swapchain;
     class  SwapchainCreateInfo;
     class  Window;
@@ -173,10 +183,12 @@ namespace Anvil
     typedef std::unique_ptr<BasePipelineCreateInfo>                                                                    BasePipelineCreateInfoUniquePtr;
     typedef std::unique_ptr<BufferCreateInfo>                                                                          BufferCreateInfoUniquePtr;
     typedef std::unique_ptr<Buffer,                                std::function<void(Buffer*)> >                      BufferUniquePtr;
+    typedef std::unique_ptr<BufferRingAllocator,                   std::function<void(BufferRingAllocator*)> >         BufferRingAllocatorUniquePtr;
     typedef std::unique_ptr<BufferViewCreateInfo>                                                                      BufferViewCreateInfoUniquePtr;
     typedef std::unique_ptr<BufferView,                            std::function<void(BufferView*)> >                  BufferViewUniquePtr;
     typedef std::unique_ptr<CommandBufferBase,                     std::function<void(CommandBufferBase*)> >           CommandBufferBaseUniquePtr;
     typedef std::unique_ptr<CommandPool,                           std::function<void(CommandPool*)> >                 CommandPoolUniquePtr;
+    typedef std::unique_ptr<CommandStream,                         std::function<void(CommandStream*)> >               CommandStreamUniquePtr;
     typedef std::unique_ptr<ComputePipelineCreateInfo>                                                                 ComputePipelineCreateInfoUniquePtr;
     typedef std::unique_ptr<DebugMessengerCreateInfo>                                                                  DebugMessengerCreateInfoUniquePtr;
     typedef std::unique_ptr<DebugMessenger,                        std::function<void(DebugMessenger*)> >              DebugMessengerUniquePtr;
@@ -192,8 +204,11 @@ namespace Anvil
     typedef std::unique_ptr<Event,                                 std::function<void(Event*)> >                       EventUniquePtr;
     typedef std::unique_ptr<FenceCreateInfo>                                                                           FenceCreateInfoUniquePtr;
     typedef std::unique_ptr<Fence,                                 std::function<void(Fence*)> >                       FenceUniquePtr;
+    typedef std::unique_ptr<FencePool,                             std::function<void(FencePool*)> >                   FencePoolUniquePtr;
+    typedef std::unique_ptr<FrameContext,                          std::function<void(FrameContext*)> >                FrameContextUniquePtr;
     typedef std::unique_ptr<FramebufferCreateInfo>                                                                     FramebufferCreateInfoUniquePtr;
     typedef std::unique_ptr<Framebuffer,                           std::function<void(Framebuffer*)> >                 FramebufferUniquePtr;
+    typedef std::unique_ptr<FrameGraph,                            std::function<void(FrameGraph*)> >                  FrameGraphUniquePtr;
     typedef std::unique_ptr<GLSLShaderToSPIRVGenerator,            std::function<void(GLSLShaderToSPIRVGenerator*)> >  GLSLShaderToSPIRVGeneratorUniquePtr;
     typedef std::unique_ptr<GraphicsPipelineCreateInfo>                                                                GraphicsPipelineCreateInfoUniquePtr;
     typedef std::unique_ptr<GraphicsPipelineManager>                                                                   GraphicsPipelineManagerUniquePtr;
@@ -206,6 +221,7 @@ namespace Anvil
     typedef std::unique_ptr<MemoryBlockCreateInfo>                                                                     MemoryBlockCreateInfoUniquePtr;
     typedef std::unique_ptr<MemoryBlock,                           std::function<void(MemoryBlock*)> >                 MemoryBlockUniquePtr;
     typedef std::unique_ptr<MGPUDevice,                            std::function<void(MGPUDevice*)> >                  MGPUDeviceUniquePtr;
+    typedef std::unique_ptr<ParallelCommandBufferRecorder,         std::function<void(ParallelCommandBufferRecorder*)> > ParallelCommandBufferRecorderUniquePtr;
     typedef std::unique_ptr<PipelineCache,                         std::function<void(PipelineCache*)> >               PipelineCacheUniquePtr;
     typedef std::unique_ptr<PipelineLayoutManager,                 std::function<void(PipelineLayoutManager*)> >       PipelineLayoutManagerUniquePtr;
     typedef std::unique_ptr<PipelineLayout,                        std::function<void(PipelineLayout*)> >              PipelineLayoutUniquePtr;
@@ -214,6 +230,7 @@ namespace Anvil
     typedef std::unique_ptr<RenderingSurface,                      std::function<void(RenderingSurface*)> >            RenderingSurfaceUniquePtr;
     typedef std::unique_ptr<RenderPassCreateInfo>                                                                      RenderPassCreateInfoUniquePtr;
     typedef std::unique_ptr<RenderPass,                            std::function<void(RenderPass*)> >                  RenderPassUniquePtr;
+    typedef std::unique_ptr<ResourceStateTracker,                  std::function<void(ResourceStateTracker*)> >        ResourceStateTrackerUniquePtr;
     typedef std::unique_ptr<SamplerCreateInfo>                                                                         SamplerCreateInfoUniquePtr;
     typedef std::unique_ptr<Sampler,                               std::function<void(Sampler*)> >                     SamplerUniquePtr;
     typedef std::unique_ptr<SecondaryCommandBuffer,                std::function<void(SecondaryCommandBuffer*)> >      SecondaryCommandBufferUniquePtr;
@@ -222,6 +239,9 @@ namespace Anvil
     typedef std::unique_ptr<SGPUDevice,                            std::function<void(SGPUDevice*)> >                  SGPUDeviceUniquePtr;
     typedef std::unique_ptr<ShaderModuleCache,                     std::function<void(ShaderModuleCache*)> >           ShaderModuleCacheUniquePtr;
     typedef std::unique_ptr<ShaderModule,                          std::function<void(ShaderModule*)> >                ShaderModuleUniquePtr;
+    typedef std::unique_ptr<SparseMemoryBindingAccumulator,        std::function<void(SparseMemoryBindingAccumulator*)> > SparseMemoryBindingAccumulatorUniquePtr;
+    typedef std::unique_ptr<SparseTextureStreamer,                 std::function<void(SparseTextureStreamer*)> >       SparseTextureStreamerUniquePtr;
+    typedef std::unique_ptr<StagingRing,                           std::function<void(StagingRing*)> >                 StagingRingUniquePtr;
     typedef std::unique_ptr<SwapchainCreateInfo>                                                                       SwapchainCreateInfoUniquePtr;
     typedef std::unique_ptr<Swapchain,                             std::function<void(Swapchain*)> >                   SwapchainUniquePtr;
     typedef std::unique_ptr<Window,                                std::function<void(Window*)> >                      WindowUniquePtr;
@@ -45,6 +45,8 @@ namespace Anvil
     /** Container for sparse memory binding updates */
     class SparseMemoryBindingUpdateInfo
     {
+        friend class Anvil::Queue;
+
     public:
         /* Public functions */
 
@@ -2695,6 +2695,11 @@ namespace Anvil
                                                      bool                               in_should_block,
                                                      Anvil::Fence*                      in_opt_fence_ptr = nullptr);
 
+        /** Copy constructor. Copies refer to their own copy of the command buffer pointer, if the source instance
+         *  has been created for a single command buffer, so they can safely outlive the source instance.
+         **/
+        SubmitInfo(const SubmitInfo& in_submit_info);
+
         const CommandBufferMGPUSubmission* get_command_buffers_mgpu() const
         {
             return command_buffers_mgpu_ptr;
@@ -2719,9 +2724,9 @@ namespace Anvil
             }
         #endif
 
-        const VkPipelineStageFlags* get_destination_stage_wait_masks() const
+        const Anvil::PipelineStageFlags* get_destination_stage_wait_masks() const
         {
-            return (dst_stage_wait_masks.size() > 0) ? &dst_stage_wait_masks.at(0) : nullptr;
+            return dst_stage_wait_masks_ptr;
         }
 
         Anvil::Fence* get_fence() const
@@ -2855,10 +2860,10 @@ namespace Anvil
         Anvil::Semaphore* const*       signal_semaphores_sgpu_ptr;
         uint32_t                       n_signal_semaphores;
 
-        std::vector<VkPipelineStageFlags> dst_stage_wait_masks;
-        const SemaphoreMGPUSubmission*    wait_semaphores_mgpu_ptr;
-        Anvil::Semaphore* const*          wait_semaphores_sgpu_ptr;
-        uint32_t                          n_wait_semaphores;
+        const Anvil::PipelineStageFlags* dst_stage_wait_masks_ptr;
+        const SemaphoreMGPUSubmission*   wait_semaphores_mgpu_ptr;
+        Anvil::Semaphore* const*         wait_semaphores_sgpu_ptr;
+        uint32_t                         n_wait_semaphores;
 
         Anvil::Fence* fence_ptr;
 
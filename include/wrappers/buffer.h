@@ -38,6 +38,7 @@
 #include "misc/mt_safety.h"
 #include "misc/types.h"
 #include "misc/page_tracker.h"
+#include "misc/staging_ring.h"
 
 namespace Anvil
 {
@@ -118,7 +119,8 @@ namespace Anvil
          *
          *  Sparse buffers do not support implicit bake operations yet.
          *
-         *  Note that resident sparse buffers may have multiple memory blocks assigned.
+         *  Note that resident sparse buffers may have multiple memory blocks assigned. Looking them up by index
+         *  takes linear time, so use the page tracker's binding iterators to visit all of them.
          **/
         Anvil::MemoryBlock* get_memory_block(uint32_t in_n_memory_block);
 
@@ -144,10 +146,9 @@ namespace Anvil
          *  read from, and then unmapped. If the memory region comes from a non-coherent memory heap, it will be
          *  invalidated before the CPU read operation.
          *
-         *  If the buffer object uses non-mappable storage memory, a staging buffer using mappable memory will be created
-         *  instead. User-specified region of the source buffer will then be copied into it by submitting a copy operation,
-         *  executed either on the transfer queue (if available), or on the universal queue. Afterward, the staging buffer
-         *  will be released.
+         *  If the buffer object uses non-mappable storage memory, the region is copied into the device's staging ring
+         *  (see BaseDevice::get_staging_ring() ) by a copy operation, executed either on the transfer queue (if available),
+         *  or on the universal queue.
          *
          *  The function prototype without @param in_device_mask argument should be used for single-GPU devices only.
          *  The function prototype with @param in_device_mask argument should be used for multi-GPU devices only.
@@ -155,7 +156,7 @@ namespace Anvil
          *
          *  This function must not be used to read data from buffers, whose memory backing comes from a multi-instance heap.
          *
-         *  This function blocks until the transfer completes.
+         *  This function blocks until the transfer completes. Use read_async() to avoid the stall.
          *
          *  @param in_start_offset As per description. Must be smaller than the underlying memory object's size.
          *  @param in_size         As per description. @param in_start_offset + @param in_size must be lower than or
@@ -172,6 +173,56 @@ namespace Anvil
                   uint32_t     in_device_mask,
                   void*        out_result_ptr);
 
+        /** Behaves as read(), except that for buffers backed by non-mappable memory, the copy is only recorded into
+         *  the staging ring's current batch. The function returns straight away.
+         *
+         *  For buffers backed by mappable memory, the data is read and the call-back is invoked before the function
+         *  returns.
+         *
+         *  @param out_result_ptr           Retrieved data will be stored under this location when the staging ring's
+         *                                  batch retires. Must remain valid until the call-back is invoked, even if
+         *                                  the app does not need the data anymore.
+         *  @param in_opt_callback_function If not nullptr, invoked once the data is available under
+         *                                  @param out_result_ptr, or the read has failed. See
+         *                                  StagingRing::download() for restrictions.
+         *
+         *  @return true if the read has been issued, false otherwise. If false is returned, the call-back is never
+         *          invoked.
+         **/
+        bool read_async(VkDeviceSize                               in_start_offset,
+                        VkDeviceSize                               in_size,
+                        void*                                      out_result_ptr,
+                        Anvil::StagingRingDownloadCallbackFunction in_opt_callback_function = Anvil::StagingRingDownloadCallbackFunction() );
+        bool read_async(VkDeviceSize                               in_start_offset,
+                        VkDeviceSize                               in_size,
+                        uint32_t                                   in_device_mask,
+                        void*                                      out_result_ptr,
+                        Anvil::StagingRingDownloadCallbackFunction in_opt_callback_function = Anvil::StagingRingDownloadCallbackFunction() );
+
+        /** Moves the buffer to a new memory block, after the contents of the block it has been bound to have been
+         *  relocated, e.g. by MemoryAllocator::defragment().
+         *
+         *  Since Vulkan does not allow a buffer's memory binding to change, a new VkBuffer is created, using the same
+         *  create info, and bound to the new block. The old VkBuffer is only destroyed once that has succeeded, so
+         *  the buffer is left intact if the function fails. The old memory block, if it is owned by the buffer, is
+         *  released afterward, unless @param out_opt_old_memory_block_ptr is specified.
+         *
+         *  The buffer must not be in use by the device at call time. The raw VkBuffer handle changes, so buffer views,
+         *  descriptor sets and child buffers referring to the buffer need to be updated by the app.
+         *
+         *  Can only be used for non-sparse buffers which have already been assigned memory.
+         *
+         *  @param in_memory_block_ptr           New memory block. Must not be nullptr. Its size must not be smaller than
+         *                                       the buffer's memory requirements.
+         *  @param out_opt_old_memory_block_ptr  If not nullptr and the function succeeds, deref will be set to the old
+         *                                       memory block if it is owned by the buffer, or to nullptr otherwise. Lets
+         *                                       the caller control when the old block is released.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool rebind_nonsparse_memory(MemoryBlockUniquePtr  in_memory_block_ptr,
+                                     MemoryBlockUniquePtr* out_opt_old_memory_block_ptr = nullptr);
+
         bool requires_dedicated_allocation() const
         {
             return m_requires_dedicated_allocation;
@@ -230,10 +281,9 @@ namespace Anvil
          *  updated, and then unmapped. If the memory region comes from a non-coherent memory heap, it will be
          *  flushed after the CPU write operation.
          *
-         *  If the buffer object uses non-mappable storage memory, a staging buffer using mappable memory will be created
-         *  instead. It will then be filled with user-specified data and used as a source for a copy operation which will
-         *  transfer the new contents to the target buffer. The operation will be submitted via a transfer queue, if one
-         *  is available, or a universal queue otherwise.
+         *  If the buffer object uses non-mappable storage memory, the data is copied into the device's staging ring
+         *  (see BaseDevice::get_staging_ring() ) and transferred to the target buffer with a copy operation. The operation
+         *  will be submitted via a transfer queue, if one is available, or a universal queue otherwise.
          *
          *  This function must not be used to read data from buffers, whose memory backing comes from a multi-instance heap.
          *
@@ -246,7 +296,7 @@ namespace Anvil
          *  backing the buffer is not mappable, you MUST specify a queue instance that should be used to perform a buffer->buffer
          *  copy op. The queue MUST support transfer ops.
          *
-         *  This function blocks until the transfer completes.
+         *  This function blocks until the transfer completes. Use write_async() to avoid the stall.
          *
          *  @param in_start_offset   As per description. Must be smaller than the underlying memory object's size.
          *  @param in_size           As per description. @param in_start_offset + @param in_size must be lower than or
@@ -265,19 +315,44 @@ namespace Anvil
                    uint32_t                             in_device_mask,
                    Anvil::Queue*                        in_opt_queue_ptr = nullptr);
 
+        /** Behaves as write(), except that for buffers backed by non-mappable memory, the copy is only recorded into
+         *  the staging ring's current batch. The data can be released as soon as the function returns.
+         *
+         *  The buffer is updated once the batch is submitted with StagingRing::flush() and executes. Batches are ordered
+         *  with all other work submitted to the same queue. Work submitted to other queues must be synchronized
+         *  by the app.
+         *
+         *  @return true if the operation was successful, false otherwise.
+         **/
+        bool write_async(VkDeviceSize  in_start_offset,
+                         VkDeviceSize  in_size,
+                         const void*   in_data,
+                         Anvil::Queue* in_opt_queue_ptr = nullptr);
+        bool write_async(VkDeviceSize  in_start_offset,
+                         VkDeviceSize  in_size,
+                         const void*   in_data,
+                         uint32_t      in_device_mask,
+                         Anvil::Queue* in_opt_queue_ptr = nullptr);
+
     private:
         /* Private functions */
 
         Buffer(Anvil::BufferCreateInfoUniquePtr in_create_info_ptr);
 
-        bool init               ();
-        bool init_staging_buffer(const VkDeviceSize& in_size,
-                                 Anvil::Queue*       in_opt_queue_ptr);
-        bool set_memory_sparse  (MemoryBlock*        in_memory_block_ptr,
-                                 bool                in_memory_block_owned_by_buffer,
-                                 VkDeviceSize        in_memory_start_offset,
-                                 VkDeviceSize        in_start_offset,
-                                 VkDeviceSize        in_size);
+        VkResult      create_vk_buffer  ();
+        Anvil::Queue* get_transfer_queue(Anvil::Queue*       in_opt_queue_ptr) const;
+        bool          init              ();
+        bool          read_internal     (VkDeviceSize                               in_start_offset,
+                                         VkDeviceSize                               in_size,
+                                         uint32_t                                   in_device_mask,
+                                         void*                                      out_result_ptr,
+                                         bool                                       in_should_block,
+                                         Anvil::StagingRingDownloadCallbackFunction in_opt_callback_function);
+        bool          set_memory_sparse (MemoryBlock*        in_memory_block_ptr,
+                                         bool                in_memory_block_owned_by_buffer,
+                                         VkDeviceSize        in_memory_start_offset,
+                                         VkDeviceSize        in_start_offset,
+                                         VkDeviceSize        in_size);
 
         bool set_memory_nonsparse_internal(MemoryBlockUniquePtr in_memory_block_ptr,
                                            uint32_t             in_n_device_group_indices,
@@ -292,8 +367,6 @@ namespace Anvil
 
         Anvil::MemoryBlock*                  m_memory_block_ptr; // only used by non-sparse buffers
         std::unique_ptr<Anvil::PageTracker>  m_page_tracker_ptr; // only used by sparse buffers
-        Anvil::BufferUniquePtr               m_staging_buffer_ptr;
-        Anvil::Queue*                        m_staging_buffer_queue_ptr;
 
         std::vector<MemoryBlockUniquePtr> m_owned_memory_blocks;
         bool                              m_prefers_dedicated_allocation;
@@ -40,6 +40,7 @@
 #include "misc/io.h"
 #include "misc/mt_safety.h"
 #include "misc/types.h"
+#include <thread>
 
 #ifdef _DEBUG
     #define STORE_COMMAND_BUFFER_COMMANDS
@@ -363,6 +364,79 @@ namespace Anvil
         }
     } PipelineBarrierCommand;
 
+    /** Holds statistics of a command buffer's pipeline barrier batching.
+     *
+     *  See CommandBufferBase::set_barrier_batching() for more details.
+     **/
+    typedef struct BarrierBatchingStats
+    {
+        /* Number of record_pipeline_barrier() calls which have been deferred */
+        uint32_t n_barrier_commands_deferred;
+
+        /* Number of buffer, image and memory barriers which have been folded into an equivalent barrier
+         * deferred earlier, instead of being passed to Vulkan separately */
+        uint32_t n_barriers_merged;
+
+        /* Number of vkCmdPipelineBarrier() calls issued to flush deferred barriers */
+        uint32_t n_pipeline_barrier_calls;
+
+        /** Constructor. Zeroes all counters. */
+        BarrierBatchingStats()
+        {
+            n_barrier_commands_deferred = 0;
+            n_barriers_merged           = 0;
+            n_pipeline_barrier_calls    = 0;
+        }
+
+        /** Returns the number of vkCmdPipelineBarrier() calls saved by batching. */
+        uint32_t get_n_barrier_commands_merged() const
+        {
+            return n_barrier_commands_deferred - n_pipeline_barrier_calls;
+        }
+    } BarrierBatchingStats;
+
+    /** Holds the number of commands dropped by a command buffer's redundant state filter.
+     *
+     *  See CommandBufferBase::set_redundant_state_filtering() for more details.
+     **/
+    typedef struct RedundantStateFilterStats
+    {
+        uint32_t n_bind_descriptor_sets_commands_elided;
+        uint32_t n_bind_index_buffer_commands_elided;
+        uint32_t n_bind_pipeline_commands_elided;
+        uint32_t n_bind_vertex_buffers_commands_elided;
+        uint32_t n_push_constants_commands_elided;
+        uint32_t n_set_line_width_commands_elided;
+        uint32_t n_set_scissor_commands_elided;
+        uint32_t n_set_viewport_commands_elided;
+
+        /** Constructor. Zeroes all counters. */
+        RedundantStateFilterStats()
+        {
+            n_bind_descriptor_sets_commands_elided = 0;
+            n_bind_index_buffer_commands_elided    = 0;
+            n_bind_pipeline_commands_elided        = 0;
+            n_bind_vertex_buffers_commands_elided  = 0;
+            n_push_constants_commands_elided       = 0;
+            n_set_line_width_commands_elided       = 0;
+            n_set_scissor_commands_elided          = 0;
+            n_set_viewport_commands_elided         = 0;
+        }
+
+        /** Returns the total number of commands which have been elided. */
+        uint32_t get_n_commands_elided() const
+        {
+            return n_bind_descriptor_sets_commands_elided +
+                   n_bind_index_buffer_commands_elided    +
+                   n_bind_pipeline_commands_elided        +
+                   n_bind_vertex_buffers_commands_elided  +
+                   n_push_constants_commands_elided       +
+                   n_set_line_width_commands_elided       +
+                   n_set_scissor_commands_elided          +
+                   n_set_viewport_commands_elided;
+        }
+    } RedundantStateFilterStats;
+
     /** Implements base functionality of a command buffer object, such as common command registration
      *  support or validation. Also encapsulates command wrapper structure declarations.
      *
@@ -408,6 +482,20 @@ namespace Anvil
          */
         void end_debug_utils_label();
 
+        /** Issues a single vkCmdPipelineBarrier() call for all pipeline barriers deferred by the command buffer
+         *  so far. Nop if barrier batching is disabled or if no barriers are pending.
+         *
+         *  Pending barriers are flushed automatically before any other command is recorded. This function only
+         *  needs to be called before commands are recorded into the raw Vulkan command buffer handle directly.
+         **/
+        void flush_deferred_barriers();
+
+        /** Returns statistics of the pipeline barrier batching since the last start_recording() call.
+         *
+         *  All counters are zero if barrier batching has not been enabled for the command buffer.
+         **/
+        BarrierBatchingStats get_barrier_batching_stats() const;
+
         /** Returns a handle to the raw Vulkan command buffer instance, encapsulated by the object */
         VkCommandBuffer get_command_buffer() const
         {
@@ -434,6 +522,13 @@ namespace Anvil
             return m_parent_command_pool_ptr;
         }
 
+        /** Returns the number of commands dropped by the redundant state filter since the last
+         *  start_recording() call.
+         *
+         *  All counters are zero if redundant state filtering has not been enabled for the command buffer.
+         **/
+        RedundantStateFilterStats get_redundant_state_filter_stats() const;
+
         /** Inserts a single queue debug label.
          *
          *  Requires VK_EXT_debug_utils support. Otherwise, the call is moot.
@@ -444,6 +539,24 @@ namespace Anvil
         void insert_debug_utils_label(const char*  in_label_name_ptr,
                                       const float* in_color_vec4_ptr);
 
+        /** Tells whether pipeline barrier batching has been enabled for the command buffer. */
+        bool is_barrier_batching_enabled() const
+        {
+            return (m_deferred_barrier_state_ptr != nullptr);
+        }
+
+        /** Tells whether exclusive recording has been enabled for the command buffer. */
+        bool is_exclusive_recording_enabled() const
+        {
+            return m_exclusive_recording_enabled;
+        }
+
+        /** Tells whether redundant state filtering has been enabled for the command buffer. */
+        bool is_redundant_state_filtering_enabled() const
+        {
+            return (m_shadow_state_ptr != nullptr);
+        }
+
         /** Issues a vkCmdBeginQuery() call and appends it to the internal vector of commands
          *  recorded for the specified command buffer (for builds with STORE_COMMAND_BUFFER_COMMANDS
          *  #define enabled).
@@ -662,6 +775,20 @@ namespace Anvil
                                               uint32_t                            in_range_count,
                                               const Anvil::ImageSubresourceRange* in_range_ptrs);
 
+        /** Records all commands held by a command stream into the command buffer, in order. Each command goes
+         *  through the corresponding record_*() function, so it is stashed (for builds with
+         *  STORE_COMMAND_BUFFER_COMMANDS #define enabled) and filtered exactly as if it had been recorded directly.
+         *
+         *  Calling this function for a command buffer which has not been put into a recording mode
+         *  (by issuing a start_recording() call earlier) will result in an assertion failure.
+         *
+         *  @param in_command_stream_ptr Stream to replay. Must not be nullptr. Objects the stream refers to
+         *                               must still be alive.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool record_command_stream(const Anvil::CommandStream* in_command_stream_ptr);
+
         /** Issues a vkCmdCopyBuffer() call and appends it to the internal vector of commands
          *  recorded for the specified command buffer (for builds with STORE_COMMAND_BUFFER_COMMANDS
          *  #define enabled).
@@ -1134,6 +1261,9 @@ namespace Anvil
          *  recorded for the specified command buffer (for builds with STORE_COMMAND_BUFFER_COMMANDS
          *  #define enabled).
          *
+         *  If barrier batching is enabled, the Vulkan call is deferred. See set_barrier_batching()
+         *  for more details.
+         *
          *  Calling this function for a command buffer which has not been put into a recording mode
          *  (by issuing a start_recording() call earlier) will result in an assertion failure.
          *
@@ -1483,6 +1613,63 @@ namespace Anvil
          **/
         bool reset(bool in_should_release_resources);
 
+        /** Enables or disables pipeline barrier batching for the command buffer. Disabled by default.
+         *
+         *  When enabled, record_pipeline_barrier() calls are not forwarded to Vulkan straight away. Instead,
+         *  consecutive barriers are accumulated and issued with a single vkCmdPipelineBarrier() call right
+         *  before the next command of any other type is recorded, or when recording stops. The stage masks
+         *  of the accumulated barriers are OR-ed together. Buffer and image barriers which cover the same
+         *  range and perform the same layout transition are merged into one by OR-ing their access masks.
+         *  All memory barriers are merged into a single one.
+         *
+         *  Since barriers passed to a single vkCmdPipelineBarrier() call are not ordered against each other,
+         *  the pending barriers are flushed early if a new barrier uses different dependency flags or
+         *  overlaps a pending barrier on the same resource, where either of them performs a layout transition
+         *  or a queue family ownership transfer.
+         *
+         *  Merge statistics can be retrieved with get_barrier_batching_stats(). Disabling batching flushes
+         *  all pending barriers.
+         *
+         *  @param in_enable true to enable batching, false to disable it.
+         **/
+        void set_barrier_batching(bool in_enable);
+
+        /** Enables or disables exclusive recording for the command buffer. Disabled by default.
+         *
+         *  By default, every record_*() call locks the parent command pool and the command buffer for the duration
+         *  of the Vulkan call. With exclusive recording enabled, start_recording() registers the calling thread as
+         *  the owner of the parent pool until stop_recording() is called, and individual record_*() calls do not
+         *  lock anything. No locks are held between the two calls.
+         *
+         *  While exclusive recording is in progress, the app must not use the parent command pool, or any command
+         *  buffer allocated from it, from other threads. Debug builds assert if the command buffer is used from
+         *  a thread other than the one which has started recording, or if the pool is used by another thread.
+         *
+         *  Must not be called while recording is in progress.
+         *
+         *  @param in_enable true to enable exclusive recording, false to disable it.
+         **/
+        void set_exclusive_recording(bool in_enable);
+
+        /** Enables or disables redundant state filtering for the command buffer. Disabled by default.
+         *
+         *  When enabled, the command buffer keeps a shadow copy of the state set by record_bind_pipeline(),
+         *  record_bind_descriptor_sets(), record_bind_vertex_buffers(), record_bind_index_buffer(),
+         *  record_push_constants(), record_set_line_width(), record_set_scissor() and record_set_viewport().
+         *  Calls which would set state that is already bound are dropped instead of being forwarded to
+         *  Vulkan. Dropped calls still return true. The number of dropped calls can be retrieved with
+         *  get_redundant_state_filter_stats().
+         *
+         *  The shadow state is discarded whenever the Vulkan state becomes undefined or could have been
+         *  changed behind the command buffer's back, that is: at recording start, at render pass
+         *  boundaries and after secondary command buffers are executed. Binding a different pipeline also
+         *  discards the dynamic state and push constant data, since the new pipeline may define the former
+         *  statically and use an incompatible push constant layout.
+         *
+         *  @param in_enable true to enable the filter, false to disable it.
+         **/
+        void set_redundant_state_filtering(bool in_enable);
+
         /** Stops an ongoing command recording process.
          *
          *  It is an error to invoke this function if the command buffer has not been put
@@ -2868,6 +3055,45 @@ namespace Anvil
             void clear_commands();
         #endif
 
+        /** Returns a pointer to at least @param in_n_items items stored in @param in_scratch_vec, growing
+         *  the vector if needed. The vector never shrinks, so once the largest array a command buffer
+         *  records has been seen, no further heap allocations are made.
+         *
+         *  Must only be called with the command buffer lock held.
+         *
+         *  @return Pointer to the scratch storage or nullptr, if @param in_n_items is 0.
+         **/
+        template<typename ItemType>
+        ItemType* get_scratch_storage(const uint32_t&        in_n_items,
+                                      std::vector<ItemType>& in_scratch_vec)
+        {
+            if (in_n_items == 0)
+            {
+                return nullptr;
+            }
+
+            if (in_scratch_vec.size() < in_n_items)
+            {
+                in_scratch_vec.resize(in_n_items);
+            }
+
+            return &in_scratch_vec.at(0);
+        }
+
+        void acquire_recording_locks  ();
+        void begin_exclusive_recording();
+        void end_exclusive_recording  ();
+        void release_recording_locks  ();
+
+        /** Zeroes the barrier batching statistics, if barrier batching is enabled. */
+        void reset_barrier_batching_stats();
+
+        /** Discards all state cached by the redundant state filter, if one is enabled.
+         *
+         *  @param in_reset_stats true if the filter's statistics should also be zeroed.
+         **/
+        void invalidate_shadow_state(bool in_reset_stats = false);
+
         /* Protected variables */
         #ifdef STORE_COMMAND_BUFFER_COMMANDS
             Commands m_commands;
@@ -2876,6 +3102,9 @@ namespace Anvil
         VkCommandBuffer          m_command_buffer;
         uint32_t                 m_device_mask;
         const Anvil::BaseDevice* m_device_ptr;
+        bool                     m_exclusive_recording_active;
+        bool                     m_exclusive_recording_enabled;
+        std::thread::id          m_exclusive_recording_thread_id;
         bool                     m_is_renderpass_active;
         uint32_t                 m_n_debug_label_regions_started;
         Anvil::CommandPool*      m_parent_command_pool_ptr;
@@ -2883,16 +3112,161 @@ namespace Anvil
         uint32_t                 m_renderpass_device_mask;
         CommandBufferType        m_type;
 
+        /* Scratch storage used to convert wrapper arrays to raw Vulkan arrays at recording time. */
+        std::vector<VkBufferMemoryBarrier> m_scratch_buffer_barriers_vk;
+        std::vector<VkBuffer>              m_scratch_buffers_vk;
+        std::vector<VkCommandBuffer>       m_scratch_command_buffers_vk;
+        std::vector<VkDescriptorSet>       m_scratch_descriptor_sets_vk;
+        std::vector<VkEvent>               m_scratch_events_vk;
+        std::vector<VkImageMemoryBarrier>  m_scratch_image_barriers_vk;
+        std::vector<VkMemoryBarrier>       m_scratch_memory_barriers_vk;
+
         static bool m_command_stashing_disabled;
 
     private:
         /* Private type definitions */
 
+        /** Shadow copy of the state bound to a single pipeline bind point. */
+        typedef struct ShadowBindPointState
+        {
+            std::vector<VkDescriptorSet> descriptor_sets;
+            std::vector<uint32_t>        dynamic_offsets;
+            uint32_t                     first_set;
+            VkPipelineLayout             layout;
+            uint32_t                     n_sets;
+            VkPipeline                   pipeline;
+
+            ShadowBindPointState()
+            {
+                invalidate();
+            }
+
+            void invalidate()
+            {
+                descriptor_sets.clear();
+                dynamic_offsets.clear();
+
+                first_set = UINT32_MAX;
+                layout    = VK_NULL_HANDLE;
+                n_sets    = 0;
+                pipeline  = VK_NULL_HANDLE;
+            }
+        } ShadowBindPointState;
+
+        /** Shadow copy of the state tracked by the redundant state filter. */
+        typedef struct ShadowState
+        {
+            ShadowBindPointState bind_points[2]; /* indexed with VkPipelineBindPoint */
+
+            VkBuffer         index_buffer;
+            VkDeviceSize     index_buffer_offset;
+            Anvil::IndexType index_type;
+
+            std::vector<VkBuffer>     vertex_buffers;
+            std::vector<VkDeviceSize> vertex_buffer_offsets;
+
+            std::vector<uint8_t> push_constants_data;
+            VkPipelineLayout     push_constants_layout;
+            uint32_t             push_constants_offset;
+            VkShaderStageFlags   push_constants_stages;
+
+            bool                    line_width_valid;
+            float                   line_width;
+            std::vector<VkRect2D>   scissors;
+            std::vector<bool>       scissors_valid;
+            std::vector<VkViewport> viewports;
+            std::vector<bool>       viewports_valid;
+
+            RedundantStateFilterStats stats;
+
+            ShadowState()
+            {
+                invalidate();
+            }
+
+            void invalidate();
+            void invalidate_dynamic_state();
+
+            bool filter_bind_descriptor_sets(Anvil::PipelineBindPoint           in_pipeline_bind_point,
+                                             VkPipelineLayout                   in_layout,
+                                             uint32_t                           in_first_set,
+                                             uint32_t                           in_set_count,
+                                             const Anvil::DescriptorSet* const* in_descriptor_set_ptrs,
+                                             uint32_t                           in_dynamic_offset_count,
+                                             const uint32_t*                    in_dynamic_offset_ptrs);
+            bool filter_bind_index_buffer   (VkBuffer                           in_buffer,
+                                             VkDeviceSize                       in_offset,
+                                             Anvil::IndexType                   in_index_type);
+            bool filter_bind_pipeline       (Anvil::PipelineBindPoint           in_pipeline_bind_point,
+                                             VkPipeline                         in_pipeline);
+            bool filter_bind_vertex_buffers (uint32_t                           in_start_binding,
+                                             uint32_t                           in_binding_count,
+                                             Anvil::Buffer**                    in_buffer_ptrs,
+                                             const VkDeviceSize*                in_offset_ptrs);
+            bool filter_push_constants      (VkPipelineLayout                   in_layout,
+                                             VkShaderStageFlags                 in_stages,
+                                             uint32_t                           in_offset,
+                                             uint32_t                           in_size,
+                                             const void*                        in_values);
+            bool filter_set_line_width      (float                              in_line_width);
+            bool filter_set_scissor         (uint32_t                           in_first_scissor,
+                                             uint32_t                           in_scissor_count,
+                                             const VkRect2D*                    in_scissor_ptrs);
+            bool filter_set_viewport        (uint32_t                           in_first_viewport,
+                                             uint32_t                           in_viewport_count,
+                                             const VkViewport*                  in_viewport_ptrs);
+        } ShadowState;
+
+        /** Pipeline barriers accumulated by a command buffer with barrier batching enabled. */
+        typedef struct DeferredBarrierState
+        {
+            std::vector<VkBufferMemoryBarrier> buffer_barriers;
+            VkDependencyFlags                  dependency_flags;
+            VkPipelineStageFlags               dst_stage_mask;
+            std::vector<VkImageMemoryBarrier>  image_barriers;
+            VkMemoryBarrier                    memory_barrier;
+            bool                               memory_barrier_used;
+            uint32_t                           n_barrier_commands;
+            VkPipelineStageFlags               src_stage_mask;
+
+            BarrierBatchingStats stats;
+
+            DeferredBarrierState()
+            {
+                clear();
+            }
+
+            void append        (VkPipelineStageFlags       in_src_stage_mask,
+                                VkPipelineStageFlags       in_dst_stage_mask,
+                                VkDependencyFlags          in_dependency_flags,
+                                uint32_t                   in_memory_barrier_count,
+                                const MemoryBarrier* const in_memory_barriers_ptr,
+                                uint32_t                   in_buffer_memory_barrier_count,
+                                const BufferBarrier* const in_buffer_memory_barriers_ptr,
+                                uint32_t                   in_image_memory_barrier_count,
+                                const ImageBarrier*  const in_image_memory_barriers_ptr);
+            void clear         ();
+            bool conflicts_with(VkDependencyFlags          in_dependency_flags,
+                                uint32_t                   in_buffer_memory_barrier_count,
+                                const BufferBarrier* const in_buffer_memory_barriers_ptr,
+                                uint32_t                   in_image_memory_barrier_count,
+                                const ImageBarrier*  const in_image_memory_barriers_ptr) const;
+
+            bool is_empty() const
+            {
+                return (n_barrier_commands == 0);
+            }
+        } DeferredBarrierState;
+
         /* Private functions */
         CommandBufferBase           (const CommandBufferBase&);
         CommandBufferBase& operator=(const CommandBufferBase&);
 
+        void emit_deferred_barriers();
+
         /* Private variables */
+        std::unique_ptr<DeferredBarrierState> m_deferred_barrier_state_ptr;
+        std::unique_ptr<ShadowState>          m_shadow_state_ptr;
 
         friend class Anvil::CommandPool;
     };
@@ -3028,11 +3402,15 @@ namespace Anvil
          *
          *  @param in_device_ptr              Device to use.
          *  @param in_parent_command_pool_ptr Command pool to use as a parent. Must not be nullptr.
+         *  @param in_opt_command_buffer      If not VK_NULL_HANDLE, the wrapper is going to adopt the specified
+         *                                    command buffer, instead of allocating a new one. The command buffer
+         *                                    must have been allocated from @param in_parent_command_pool_ptr.
          *
          **/
         PrimaryCommandBuffer(const Anvil::BaseDevice* in_device_ptr,
                              CommandPool*             in_parent_command_pool_ptr,
-                             bool                     in_mt_safe);
+                             bool                     in_mt_safe,
+                             VkCommandBuffer          in_opt_command_buffer = VK_NULL_HANDLE);
 
     private:
         friend class Anvil::CommandPool;
@@ -3092,11 +3470,15 @@ namespace Anvil
          *
          *  @param in_device_ptr              Device to use.
          *  @param in_parent_command_pool_ptr Command pool to use as a parent. Must not be nullptr.
+         *  @param in_opt_command_buffer      If not VK_NULL_HANDLE, the wrapper is going to adopt the specified
+         *                                    command buffer, instead of allocating a new one. The command buffer
+         *                                    must have been allocated from @param in_parent_command_pool_ptr.
          *
          **/
         SecondaryCommandBuffer(const Anvil::BaseDevice* in_device_ptr,
                                CommandPool*             in_parent_command_pool_ptr,
-                               bool                     in_mt_safe);
+                               bool                     in_mt_safe,
+                               VkCommandBuffer          in_opt_command_buffer = VK_NULL_HANDLE);
 
     private:
         friend class Anvil::CommandPool;
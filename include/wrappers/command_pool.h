@@ -32,6 +32,8 @@
 #include "misc/debug_marker.h"
 #include "misc/mt_safety.h"
 #include "misc/types.h"
+#include <atomic>
+#include <thread>
 
 
 namespace Anvil
@@ -41,6 +43,12 @@ namespace Anvil
                         public DebugMarkerSupportProvider<CommandPool>
     {
     public:
+        /* Public constants */
+
+        /** Recycling chunk size which suits pools handing out a few command buffers at a time. Can be passed
+         *  to create(), as well as to functions which create command pools on the app's behalf. */
+        static const uint32_t DEFAULT_RECYCLING_CHUNK_SIZE = 4;
+
         /* Public functions */
 
         /** Destroys the Vulkan object and unregisters the object from the Object Tracker. */
@@ -50,6 +58,9 @@ namespace Anvil
          *
          *  When no longer needed, the returned instance should be released by the app.
          *
+         *  If command buffer recycling is enabled for the pool, the returned wrapper may be one which has been
+         *  released earlier. Please see create() documentation for more details.
+         *
          *  @return As per description.
          **/
         Anvil::PrimaryCommandBufferUniquePtr alloc_primary_level_command_buffer();
@@ -58,6 +69,9 @@ namespace Anvil
          *
          *  When no longer needed, the returned instance should be released by the app.
          *
+         *  If command buffer recycling is enabled for the pool, the returned wrapper may be one which has been
+         *  released earlier. Please see create() documentation for more details.
+         *
          *  @return As per description.
          **/
         Anvil::SecondaryCommandBufferUniquePtr alloc_secondary_level_command_buffer();
@@ -72,12 +86,27 @@ namespace Anvil
          *  @param in_queue_family_index             Index of the Vulkan queue family the command pool should be created for.
          *  @param in_mt_safe                        Enable if your application is going to be calling any of the
          *                                           alloc_*() functions from more than one thread at a time.
+         *  @param in_opt_recycling_chunk_size       If not 0, command buffer recycling is enabled for the pool. Vulkan command
+         *                                           buffers are then allocated in chunks of the specified size, and wrappers
+         *                                           released by the app are not freed but kept by the pool for reuse:
+         *
+         *                                           - if @param in_support_per_cmdbuf_reset_ops is true, a released wrapper
+         *                                             can be handed out again right away, since vkBeginCommandBuffer() resets it
+         *                                             implicitly.
+         *                                           - otherwise, released wrappers become available again after the next
+         *                                             reset() call. This makes it possible to recycle all command buffers used
+         *                                             by a frame with a single vkResetCommandPool() call.
+         *
+         *                                           All command buffers are released in one go when the pool is destroyed.
+         *                                           Note that properties assigned to a wrapper (eg. its debug name, callbacks
+         *                                           or redundant state filtering) are retained when the wrapper is reused.
          **/
         static CommandPoolUniquePtr create(Anvil::BaseDevice* in_device_ptr,
                                            bool               in_transient_allocations_friendly,
                                            bool               in_support_per_cmdbuf_reset_ops,
                                            uint32_t           in_queue_family_index,
-                                           MTSafety           in_mt_safety = MTSafety::INHERIT_FROM_PARENT_DEVICE);
+                                           MTSafety           in_mt_safety                = MTSafety::INHERIT_FROM_PARENT_DEVICE,
+                                           uint32_t           in_opt_recycling_chunk_size = 0);
 
         /** Retrieves the raw Vulkan handle for the encapsulated command pool */
         VkCommandPool get_command_pool() const
@@ -91,6 +120,12 @@ namespace Anvil
             return m_queue_family_index;
         }
 
+        /** Tells whether command buffer recycling has been enabled for the pool at creation time. */
+        bool is_recycling_enabled() const
+        {
+            return m_recycling_chunk_size != 0;
+        }
+
         /** Tells whether the command pool has been created with VK_COMMAND_POOL_CREATE_TRANSIENT_BIT 
          *  flag defined.
          ***/
@@ -100,6 +135,9 @@ namespace Anvil
         }
 
         /** Reset the command pool.
+         *
+         *  If command buffer recycling is enabled, all command buffers released by the app since the previous
+         *  reset() call become available for reuse.
          *
          *  @param in_release_resources true if the vkResetCommandPool() call should be invoked with
          *                              the VK_COMMAND_POOL_RESET_RELEASE_RESOURCES_BIT flag.
@@ -129,11 +167,19 @@ namespace Anvil
                              bool               in_transient_allocations_friendly,
                              bool               in_support_per_cmdbuf_reset_ops,
                              uint32_t           in_queue_family_index,
-                             bool               in_mt_safe);
+                             bool               in_mt_safe,
+                             uint32_t           in_recycling_chunk_size);
 
         CommandPool           (const CommandPool&);
         CommandPool& operator=(const CommandPool&);
 
+        void            assert_no_foreign_exclusive_recording() const;
+        VkCommandBuffer get_free_command_buffer_vk           (VkCommandBufferLevel           in_level);
+        void            on_exclusive_recording_finished      ();
+        void            on_exclusive_recording_started       ();
+        void            on_primary_command_buffer_released   (Anvil::PrimaryCommandBuffer*   in_command_buffer_ptr);
+        void            on_secondary_command_buffer_released (Anvil::SecondaryCommandBuffer* in_command_buffer_ptr);
+
         /* Private variables */
         VkCommandPool      m_command_pool;
         Anvil::BaseDevice* m_device_ptr;
@@ -141,6 +187,22 @@ namespace Anvil
         uint32_t           m_queue_family_index;
         bool               m_supports_per_cmdbuf_reset_ops;
 
+        /* Command buffer recycling. Free wrappers can be handed out right away. Pending wrappers have been released
+         * by the app, but cannot be reused until the pool is reset. Free handles have been allocated in bulk but
+         * have not been assigned to any wrapper yet. */
+        std::vector<Anvil::PrimaryCommandBuffer*>   m_free_primary_command_buffer_ptrs;
+        std::vector<VkCommandBuffer>                m_free_primary_command_buffers_vk;
+        std::vector<Anvil::SecondaryCommandBuffer*> m_free_secondary_command_buffer_ptrs;
+        std::vector<VkCommandBuffer>                m_free_secondary_command_buffers_vk;
+        std::vector<Anvil::PrimaryCommandBuffer*>   m_pending_primary_command_buffer_ptrs;
+        std::vector<Anvil::SecondaryCommandBuffer*> m_pending_secondary_command_buffer_ptrs;
+        uint32_t                                    m_recycling_chunk_size;
+
+        /* Exclusive recording. Only used for validation. The owner is only ever changed by the thread which
+         * records exclusively, but is read by other threads without locking the pool. */
+        std::atomic<std::thread::id> m_exclusive_recording_thread_id;
+        std::atomic<uint32_t>        m_n_exclusive_recordings;
+
         friend class Anvil::CommandBufferBase;
     };
 
@@ -37,6 +37,7 @@
 #include "misc/struct_chainer.h"
 #include "misc/types.h"
 #include <algorithm>
+#include <mutex>
 
 namespace Anvil
 {
@@ -308,6 +309,16 @@ namespace Anvil
             return m_khr_swapchain_extension_entrypoints;
         }
 
+        /** Returns a pool of reusable fences, created for this device instance. Used by queues for blocking
+         *  submissions, and available to applications which need short-lived fences.
+         *
+         *  @return As per description
+         **/
+        Anvil::FencePool* get_fence_pool() const
+        {
+            return m_fence_pool_ptr.get();
+        }
+
         /** Retrieves a graphics pipeline manager, created for this device instance.
          *
          *  @return As per description
@@ -555,6 +566,13 @@ namespace Anvil
         Anvil::Queue* get_sparse_binding_queue(uint32_t          in_n_queue,
                                                Anvil::QueueFlags in_opt_required_queue_flags = Anvil::QueueFlags() ) const;
 
+        /** Returns a staging ring, used to transfer data to and from buffers backed by non-mappable memory.
+         *  The ring is created the first time this function is called.
+         *
+         *  @return As per description, or nullptr if the ring could not be created.
+         **/
+        Anvil::StagingRing* get_staging_ring() const;
+
         /* Tells which memory types can be specified when creating an external memory handle for a Win32 handle @param in_handle
          *
          * For all external memory handle types EXCEPT host pointers:
@@ -692,7 +710,8 @@ namespace Anvil
                                                 const std::vector<std::string>&     in_layers,
                                                 bool                                in_transient_command_buffer_allocs_only,
                                                 bool                                in_support_resettable_command_buffer_allocs,
-                                                bool                                in_enable_shader_module_cache);
+                                                bool                                in_enable_shader_module_cache,
+                                                uint32_t                            in_command_buffer_recycling_chunk_size);
 
         BaseDevice& operator=(const BaseDevice&);
         BaseDevice           (const BaseDevice&);
@@ -765,11 +784,14 @@ namespace Anvil
         DescriptorSetLayoutManagerUniquePtr              m_descriptor_set_layout_manager_ptr;
         Anvil::DescriptorSetGroupUniquePtr               m_dummy_dsg_ptr;
         std::unique_ptr<Anvil::ExtensionInfo<bool> >     m_extension_enabled_info_ptr;
+        Anvil::FencePoolUniquePtr                        m_fence_pool_ptr;
         GraphicsPipelineManagerUniquePtr                 m_graphics_pipeline_manager_ptr;
         const Anvil::Instance*                           m_parent_instance_ptr;
         PipelineCacheUniquePtr                           m_pipeline_cache_ptr;
         PipelineLayoutManagerUniquePtr                   m_pipeline_layout_manager_ptr;
         Anvil::ShaderModuleCacheUniquePtr                m_shader_module_cache_ptr;
+        mutable std::mutex                               m_staging_ring_mutex;
+        mutable Anvil::StagingRingUniquePtr              m_staging_ring_ptr;
 
         std::vector<CommandPoolUniquePtr> m_command_pool_ptr_per_vk_queue_fam;
 
@@ -800,6 +822,11 @@ namespace Anvil
          *  @param in_mt_safe                                  True if command buffer creation and queue submissions should be automatically serialized.
          *                                                     Set to false if your app is never going to use more than one thread at a time for
          *                                                     command buffer creation or submission.
+         *  @param in_opt_command_buffer_recycling_chunk_size  If not 0, command buffer recycling is enabled for the per-queue family
+         *                                                     command pools, with the specified chunk size (eg.
+         *                                                     CommandPool::DEFAULT_RECYCLING_CHUNK_SIZE). Ignored unless
+         *                                                     @param in_support_resettable_command_buffer_allocs is true.
+         *                                                     Please see CommandPool::create() for details.
          *
          *  @return A new Device instance.
          **/
@@ -809,7 +836,8 @@ namespace Anvil
                                           const std::vector<std::string>&      in_layers,
                                           bool                                 in_transient_command_buffer_allocs_only,
                                           bool                                 in_support_resettable_command_buffer_allocs,
-                                          bool                                 in_mt_safe = false);
+                                          bool                                 in_mt_safe                                 = false,
+                                          uint32_t                             in_opt_command_buffer_recycling_chunk_size = 0);
 
         /** Creates a new swapchain instance for the device.
          *
@@ -929,7 +957,8 @@ namespace Anvil
                                                  const std::vector<std::string>&           in_layers,
                                                  bool                                      in_transient_command_buffer_allocs_only,
                                                  bool                                      in_support_resettable_command_buffer_allocs,
-                                                 bool                                      in_mt_safe = false);
+                                                 bool                                      in_mt_safe                                 = false,
+                                                 uint32_t                                  in_opt_command_buffer_recycling_chunk_size = 0);
 
         /** TODO */
         Anvil::SwapchainUniquePtr create_swapchain(Anvil::RenderingSurface*           in_parent_surface_ptr,
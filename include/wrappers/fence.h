@@ -138,6 +138,14 @@ namespace Anvil
         static bool reset_fences(const uint32_t in_n_fences,
                                  Fence*         in_fences);
 
+        /** Blocks until the fence is signalled or the specified timeout elapses.
+         *
+         *  @param in_timeout Timeout, in nanoseconds.
+         *
+         *  @return true if the fence has been signalled, false if the timeout has elapsed or an error occurred.
+         **/
+        bool wait(uint64_t in_timeout = UINT64_MAX) const;
+
     private:
         /* Private functions */
 
@@ -34,6 +34,7 @@
 #include "misc/mt_safety.h"
 #include "misc/types.h"
 #include "misc/page_tracker.h"
+#include <algorithm>
 
 namespace Anvil
 {
@@ -254,6 +255,42 @@ namespace Anvil
          */
         bool has_aspects(const Anvil::ImageAspectFlags& in_aspects) const;
 
+        /** Returns the number of tiles of the specified mip which have been assigned memory backing. Mip tail
+         *  pages are not included.
+         *
+         *  Must only be called for sparse images whose sparse residency is not NONE.
+         *
+         *  @param in_aspect                 Image aspect to use for the query.
+         *  @param in_n_layer                Index of the layer to use for the query.
+         *  @param in_n_mip                  Index of the mip to use for the query. Must be smaller than the aspect's
+         *                                   first mip tail LOD.
+         *  @param out_opt_n_total_tiles_ptr If not nullptr, deref will be set to the total number of tiles in the mip.
+         *
+         *  @return As per description.
+         **/
+        uint32_t get_n_resident_tiles(Anvil::ImageAspectFlagBits in_aspect,
+                                      uint32_t                   in_n_layer,
+                                      uint32_t                   in_n_mip,
+                                      uint32_t*                  out_opt_n_total_tiles_ptr = nullptr) const;
+
+        /** Tells whether physical memory pages are assigned to all tiles covering the specified texel region.
+         *
+         *  Must only be called for sparse images whose sparse residency is not NONE.
+         *
+         *  @param in_aspect  Image aspect to use for the query.
+         *  @param in_n_layer Index of the layer to use for the query.
+         *  @param in_n_mip   Index of the mip to use for the query
+         *  @param in_offset  Location of the region's first texel.
+         *  @param in_extent  Size of the region, in texels. Must not be 0 in any dimension.
+         *
+         *  @return true if physical memory is bound to the whole region, false otherwise.
+         **/
+        bool is_memory_bound_for_region(Anvil::ImageAspectFlagBits in_aspect,
+                                        uint32_t                   in_n_layer,
+                                        uint32_t                   in_n_mip,
+                                        VkOffset3D                 in_offset,
+                                        VkExtent3D                 in_extent) const;
+
         /** Tells whether a physical memory page is assigned to the specified texel location.
          *
          *  Must only be called for sparse images whose sparse residency is not NONE.
@@ -408,17 +445,47 @@ namespace Anvil
         /** Holds information on page occupancy for a single layer-mip for a specific image aspect */
         typedef struct AspectPageOccupancyLayerMipData
         {
-            /* Each item in this vector holds a reference to a MemoryBlock instance, which provides memory
-            *  backing for the corresponding linearized image tile location */
-            std::vector<Anvil::MemoryBlock*> tile_to_block_mappings;
+            /* Bit N of this vector is set if memory backing has been assigned to the tile at linearized location N.
+             * Tiles are linearized in X-Y-Z order, so each row of tiles occupies a contiguous range of bits. */
+            std::vector<uint32_t> tile_occupancy;
 
+            uint32_t n_tiles_with_memory_backing;
             uint32_t n_tiles_x;
             uint32_t n_tiles_y;
             uint32_t n_tiles_z;
+            uint32_t n_total_tiles;
             uint32_t tile_depth;
             uint32_t tile_height;
             uint32_t tile_width;
 
+            /** Tells whether all tiles in the range <in_n_first_tile, in_n_first_tile + in_n_tiles) have been
+             *  assigned memory backing. Whole 32-tile words are checked at a time. */
+            bool are_tiles_bound(uint32_t in_n_first_tile,
+                                 uint32_t in_n_tiles) const
+            {
+                anvil_assert(in_n_first_tile + in_n_tiles <= n_total_tiles);
+
+                for (uint32_t n_tile  = in_n_first_tile;
+                              n_tile  < in_n_first_tile + in_n_tiles;
+                             )
+                {
+                    const uint32_t n_bit   = n_tile % 32;
+                    const uint32_t n_bits  = std::min(32 - n_bit,
+                                                      in_n_first_tile + in_n_tiles - n_tile);
+                    const uint32_t mask    = (n_bits == 32) ? ~0u
+                                                            : (((1u << n_bits) - 1) << n_bit);
+
+                    if ((tile_occupancy[n_tile / 32] & mask) != mask)
+                    {
+                        return false;
+                    }
+
+                    n_tile += n_bits;
+                }
+
+                return true;
+            }
+
             /** Converts user-specified XYZ location to a linearized index.
              *
              *  @param in_x X location of the texel.
@@ -439,7 +506,7 @@ namespace Anvil
                                       + tile_y * n_tiles_x
                                       + tile_x;
 
-                anvil_assert(result < tile_to_block_mappings.size() );
+                anvil_assert(result < n_total_tiles);
 
                 return result;
             }
@@ -460,11 +527,46 @@ namespace Anvil
                                       + in_tile_y * n_tiles_x
                                       + in_tile_x;
 
-                anvil_assert(result < tile_to_block_mappings.size() );
+                anvil_assert(result < n_total_tiles);
 
                 return result;
             }
 
+            /** Marks all tiles in the range <in_n_first_tile, in_n_first_tile + in_n_tiles) as bound or unbound.
+             *
+             *  Bits are updated a 32-tile word at a time. The number of tiles with memory backing is adjusted
+             *  by comparing popcounts of each word before and after the update.
+             **/
+            void set_tiles_bound(uint32_t in_n_first_tile,
+                                 uint32_t in_n_tiles,
+                                 bool     in_is_bound)
+            {
+                anvil_assert(in_n_first_tile + in_n_tiles <= n_total_tiles);
+
+                for (uint32_t n_tile  = in_n_first_tile;
+                              n_tile  < in_n_first_tile + in_n_tiles;
+                             )
+                {
+                    const uint32_t n_bit     = n_tile % 32;
+                    const uint32_t n_bits    = std::min(32 - n_bit,
+                                                        in_n_first_tile + in_n_tiles - n_tile);
+                    const uint32_t mask      = (n_bits == 32) ? ~0u
+                                                              : (((1u << n_bits) - 1) << n_bit);
+                    uint32_t&      word      = tile_occupancy[n_tile / 32];
+                    const uint32_t old_word  = word;
+
+                    word = (in_is_bound) ? (word |  mask)
+                                         : (word & ~mask);
+
+                    n_tiles_with_memory_backing += Anvil::Utils::count_set_bits(word);
+                    n_tiles_with_memory_backing -= Anvil::Utils::count_set_bits(old_word);
+
+                    n_tile += n_bits;
+                }
+
+                anvil_assert(n_tiles_with_memory_backing <= n_total_tiles);
+            }
+
             /** Constructor. Fills the structure and preallocates memory.
              *
              *  @param in_mip_width   Width of the mip to represent.
@@ -490,9 +592,11 @@ namespace Anvil
 
                 anvil_assert(n_tiles_x >= 1 && n_tiles_y >= 1 && n_tiles_z >= 1);
 
-                const uint32_t n_total_tiles = n_tiles_x * n_tiles_y * n_tiles_z;
+                n_tiles_with_memory_backing = 0;
+                n_total_tiles               = n_tiles_x * n_tiles_y * n_tiles_z;
 
-                tile_to_block_mappings.resize(n_total_tiles);
+                tile_occupancy.resize(Anvil::Utils::round_up(n_total_tiles, 32u) / 32,
+                                      0);
             }
         } AspectPageOccupancyLayerMipData;
 
@@ -32,6 +32,8 @@
  *    a number of read & write ops, after which the object can be unmapped.
  *  - provides a way to create derivative memory blocks, whose storage is "carved out" of the
  *    parent memory block's.
+ *  - can keep host-visible storage mapped for the block's lifetime. In this mode, writes to non-coherent
+ *    memory are tracked as dirty ranges and flushed together with a single flush_dirty_ranges() call.
  **/
 #ifndef WRAPPERS_MEMORY_BLOCK_H
 #define WRAPPERS_MEMORY_BLOCK_H
@@ -83,6 +85,18 @@ namespace Anvil
         /** Releases the Vulkan counterpart and unregisters the wrapper instance from the object tracker */
         virtual ~MemoryBlock();
 
+        /** Flushes all regions modified with write() since the last flush, with a single Vulkan call.
+         *
+         *  Only needs to be called for persistently mapped blocks backed by non-coherent memory, since write()
+         *  flushes modified regions right away otherwise. Should be called once per frame, before submitting
+         *  work which reads the written data.
+         *
+         *  Can be called for derived blocks, in which case dirty ranges of the whole root block are flushed.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool flush_dirty_ranges();
+
         const Anvil::MemoryBlockCreateInfo* get_create_info_ptr() const
         {
             return m_create_info_ptr.get();
@@ -103,6 +117,22 @@ namespace Anvil
             }
         }
 
+        /* Returns the root memory block which owns the VkDeviceMemory this block has been carved out of.
+         * For non-derived blocks, this is the block itself. */
+        const Anvil::MemoryBlock* get_root_memory_block() const
+        {
+            const Anvil::MemoryBlock* result_ptr = this;
+
+            while (result_ptr->m_create_info_ptr->get_parent_memory_block() != nullptr)
+            {
+                result_ptr = result_ptr->m_create_info_ptr->get_parent_memory_block();
+            }
+
+            return result_ptr;
+        }
+
+        /* Returns the offset of the memory block within its VkDeviceMemory. Already includes the offsets of all
+         * parent blocks. */
         const VkDeviceSize& get_start_offset() const
         {
             return m_start_offset;
@@ -116,6 +146,9 @@ namespace Anvil
          *  @return true if intersection has been detected, false otherwise. */
         bool intersects(const Anvil::MemoryBlock* in_memory_block_ptr) const;
 
+        /** Tells whether the storage is kept mapped for the block's lifetime. See set_persistent_mapping(). */
+        bool is_persistently_mapped() const;
+
         /** Maps the specified region of the underlying memory object to the process space.
          *
          *  Neither the object, nor its parent(s) is allowed to be mapped
@@ -162,6 +195,23 @@ namespace Anvil
                   VkDeviceSize in_size,
                   void*        out_result_ptr);
 
+        /** Enables or disables persistent mapping of the block's storage.
+         *
+         *  When enabled, the storage is mapped once and kept mapped until the mode is disabled or the block is
+         *  released, so read(), write(), map() and unmap() no longer map & unmap the storage on each call.
+         *  Additionally, for non-coherent memory, write() only records the modified region as dirty. Dirty regions
+         *  are merged and flushed with a single call by flush_dirty_ranges(). They are also flushed before
+         *  the storage is invalidated by read() or map(), and when the mode is disabled.
+         *
+         *  Calls made for derived blocks apply to the root block, so the setting is shared by all blocks carved out
+         *  of the same storage. Only supported for mappable memory.
+         *
+         *  @param in_enable true to enable the mode, false to disable it.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool set_persistent_mapping(bool in_enable);
+
         /** Unmaps the mapped storage from the process space.
          *
          *  The call should only be made after a map() call.
@@ -204,8 +254,11 @@ namespace Anvil
         MemoryBlock& operator=(const MemoryBlock&);
 
         void     close_gpu_memory_access     ();
+        bool     flush_dirty_ranges_internal ();
         uint32_t get_device_memory_type_index(uint32_t                  in_memory_type_bits,
                                               Anvil::MemoryFeatureFlags in_memory_features);
+        void     mark_range_dirty            (VkDeviceSize              in_start_offset,
+                                              VkDeviceSize              in_size);
         bool     open_gpu_memory_access      ();
 
         /* IMemoryBlockBackendSupport */
@@ -235,8 +288,11 @@ namespace Anvil
         }
 
         /* Private members */
-        std::atomic<uint32_t> m_gpu_data_map_count; /* Only set for root memory blocks */
-        void*                 m_gpu_data_ptr;       /* Only set for root memory blocks */
+        std::vector<std::pair<VkDeviceSize, VkDeviceSize> > m_dirty_ranges;           /* Only set for root memory blocks. Sorted, disjoint [start, end) ranges */
+        std::atomic<uint32_t>                               m_gpu_data_map_count;     /* Only set for root memory blocks                                       */
+        void*                                               m_gpu_data_ptr;           /* Only set for root memory blocks                                       */
+        bool                                                m_is_persistently_mapped; /* Only set for root memory blocks                                       */
+        std::vector<VkMappedMemoryRange>                    m_scratch_mapped_memory_ranges;
 
         void*                                 m_backend_object;
         Anvil::MemoryBlockCreateInfoUniquePtr m_create_info_ptr;
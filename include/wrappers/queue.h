@@ -35,6 +35,9 @@
 #include "misc/debug_marker.h"
 #include "misc/mt_safety.h"
 #include "misc/types.h"
+#include <atomic>
+#include <condition_variable>
+#include <thread>
 
 namespace Anvil
 {
@@ -93,6 +96,14 @@ namespace Anvil
                   public MTSafetySupportProvider
     {
     public:
+        /* Public type definitions */
+
+        /** Identifies a request posted to the submission thread. See set_submission_thread_enabled().
+         *
+         *  Tickets are never 0, unless the request has been executed immediately, in the calling thread.
+         **/
+        typedef uint64_t SubmissionTicket;
+
         /* Public functions */
 
         /** Initializes a new Vulkan queue instance.
@@ -263,18 +274,301 @@ namespace Anvil
                                                   uint32_t                       in_n_wait_semaphores,
                                                   Anvil::Semaphore* const*       in_wait_semaphore_ptrs_ptr);
 
+        /** Submits all submissions deferred so far with a single vkQueueSubmit() call.
+         *
+         *  Can be called even if no submissions are pending, in which case the fence (if any) is signalled
+         *  once all work submitted to the queue earlier completes.
+         *
+         *  @param in_opt_fence_ptr Fence to signal once all flushed submissions finish executing. May be nullptr.
+         *  @param in_should_block  true if the function should wait for the flushed submissions to finish
+         *                          executing, false otherwise.
+         *  @param in_timeout       Timeout to use when waiting. Ignored if @param in_should_block is false.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool flush(Anvil::Fence* in_opt_fence_ptr = nullptr,
+                   bool          in_should_block  = false,
+                   uint64_t      in_timeout       = UINT64_MAX);
+
+        /** Tells whether the specified request has already been handed over to the driver by the submission thread.
+         *
+         *  This says nothing about whether the device has finished executing the work. Use fences for that.
+         **/
+        bool is_ticket_processed(SubmissionTicket in_ticket) const
+        {
+            return (in_ticket == 0 || m_n_last_processed_ticket.load() >= in_ticket);
+        }
+
+        /** Tells whether submit and present requests can be posted to a dedicated submission thread.
+         *  See set_submission_thread_enabled().
+         **/
+        bool is_submission_thread_enabled() const
+        {
+            return m_submission_thread_enabled;
+        }
+
+        /** Tells whether submissions are deferred until flush() is called. See set_submission_deferral(). */
+        bool is_submission_deferral_enabled() const
+        {
+            return m_submission_deferral_enabled;
+        }
+
+        /** Enables or disables deferred submission mode.
+         *
+         *  In deferred mode, submit() calls which neither specify a fence, nor request blocking, only record
+         *  the submission. Recorded submissions are passed to the driver with a single vkQueueSubmit() call when:
+         *
+         *  - flush() is called.
+         *  - submit() is called with a fence, or with blocking requested.
+         *  - a present, sparse binding or wait_idle() request is issued for the queue.
+         *  - deferred mode is disabled.
+         *
+         *  Command buffers, semaphores and fences need to stay alive until the submissions which refer to them
+         *  are flushed. Arrays passed via SubmitInfo instances are copied, so they need not.
+         *
+         *  Deferred mode is disabled by default.
+         **/
+        void set_submission_deferral(bool in_enable);
+
+        /** Submits work to the queue. See SubmitInfo for more details.
+         *
+         *  If submission deferral is enabled and the submission neither specifies a fence, nor requests
+         *  blocking, the submission is only recorded. See set_submission_deferral() for more details.
+         *
+         *  @return true if successful, false otherwise.
+         **/
         bool submit(const SubmitInfo& in_submit_info);
 
+        /** Submits multiple batches of work, each with its own command buffers, semaphores and device masks,
+         *  with a single vkQueueSubmit() call. Batches are executed in array order, as if they had been
+         *  submitted one after another.
+         *
+         *  Submissions deferred earlier are included in the same vkQueueSubmit() call, ahead of the new batches.
+         *
+         *  @param in_n_submit_infos   Number of items under @param in_submit_infos_ptr.
+         *  @param in_submit_infos_ptr Array of batches to submit. None of them can specify a fence or request blocking.
+         *  @param in_opt_fence_ptr    Fence to signal once all batches finish executing. May be nullptr.
+         *  @param in_should_block     true if the function should wait for all batches to finish executing.
+         *  @param in_timeout          Timeout to use when waiting. Ignored if @param in_should_block is false.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool submit(uint32_t          in_n_submit_infos,
+                    const SubmitInfo* in_submit_infos_ptr,
+                    Anvil::Fence*     in_opt_fence_ptr = nullptr,
+                    bool              in_should_block  = false,
+                    uint64_t          in_timeout       = UINT64_MAX);
+
+        /** Submits work to the queue without blocking, and returns a fence which is going to be signalled
+         *  once the work finishes executing. The app can do other work in the meantime, and call wait()
+         *  on the fence when it needs the results.
+         *
+         *  The fence is taken from the device's fence pool. Releasing the returned pointer gives it back
+         *  to the pool, which is safe to do even if the work has not finished executing yet.
+         *
+         *  Submissions deferred earlier are flushed together with this one.
+         *
+         *  @param in_submit_info Work to submit. Must neither specify a fence, nor request blocking.
+         *
+         *  @return Fence to wait on, or nullptr if the submission failed.
+         **/
+        Anvil::FenceUniquePtr submit_async(const SubmitInfo& in_submit_info);
+
+        /** Posts a present request to the submission thread and returns immediately.
+         *
+         *  Behaves as present(), except that the Vulkan call is made by the submission thread. The swapchain
+         *  and semaphores need to stay alive until the request is processed. The semaphore array is copied.
+         *
+         *  If the submission thread is disabled, the request is executed immediately and 0 is returned.
+         *
+         *  @param out_opt_result_ptr If not nullptr, deref will be set to the result of the operation by the time
+         *                            the returned ticket is processed.
+         *
+         *  @return Ticket identifying the request.
+         **/
+        SubmissionTicket post_present(Anvil::Swapchain*        in_swapchain_ptr,
+                                      uint32_t                 in_swapchain_image_index,
+                                      uint32_t                 in_n_wait_semaphores,
+                                      Anvil::Semaphore* const* in_wait_semaphore_ptrs_ptr,
+                                      VkResult*                out_opt_result_ptr = nullptr);
+
+        /** Posts a submission to the submission thread and returns immediately.
+         *
+         *  Behaves as submit(), except that the Vulkan call is made by the submission thread. Command buffers,
+         *  semaphores and the fence need to stay alive until the request is processed. All arrays referred to
+         *  by @param in_submit_info are copied, so they need not.
+         *
+         *  If the submission thread is disabled, the request is executed immediately and 0 is returned.
+         *
+         *  @param in_submit_info     Submission to post. Must not request blocking. Use a fence to learn when
+         *                            the work finishes executing.
+         *  @param out_opt_result_ptr If not nullptr, deref will be set to the result of submit() by the time
+         *                            the returned ticket is processed.
+         *
+         *  @return Ticket identifying the request.
+         **/
+        SubmissionTicket post_submit(const SubmitInfo& in_submit_info,
+                                     bool*             out_opt_result_ptr = nullptr);
+
+        /** Enables or disables the submission thread.
+         *
+         *  When enabled, the queue owns a worker thread which drains a lock-free queue of requests posted with
+         *  post_submit() and post_present(). Posting a request does not take any locks, so recording threads
+         *  do not contend with each other, or with the Vulkan calls made by the worker. Requests posted by the
+         *  same thread are executed in the order they were posted in.
+         *
+         *  Other functions which submit work to the queue, present or wait on it, first wait until all requests
+         *  posted so far are processed, so they are ordered after them.
+         *
+         *  Disabling the submission thread waits until all posted requests are processed.
+         *  Must not be called while other threads are using the queue.
+         *
+         *  The worker and threads which call submit() or present() directly share per-queue state, which is
+         *  guarded by the queue's lock. The submission thread can therefore only be enabled for MT-safe queues.
+         *
+         *  @return true if successful, false if the submission thread was to be enabled for a queue which is not
+         *          MT-safe.
+         **/
+        bool set_submission_thread_enabled(bool in_enable);
+
         /** Tells whether the queue supports sparse bindings */
         bool supports_sparse_bindings() const
         {
             return m_supports_sparse_bindings;
         }
 
+        /** Blocks until the specified request is handed over to the driver by the submission thread.
+         *
+         *  Must not be called from the submission thread.
+         **/
+        void wait_for_ticket(SubmissionTicket in_ticket);
+
         void wait_idle();
 
     private:
+        /* Private type definitions */
+
+        /* Describes a single submission which has been recorded, but not yet passed to the driver.
+         * Arrays of Vulkan handles are stored back-to-back in PendingSubmissions. */
+        typedef struct PendingSubmission
+        {
+            bool     is_mgpu;
+            uint32_t n_command_buffers;
+            uint32_t n_signal_semaphores;
+            uint32_t n_wait_semaphores;
+
+            #if defined(_WIN32)
+                bool has_d3d12_fence_semaphore_values;
+            #endif
+        } PendingSubmission;
+
+        typedef struct PendingSubmissions
+        {
+            std::vector<Anvil::CommandBufferBase*> command_buffer_ptrs;
+            std::vector<uint32_t>                  command_buffer_device_masks;
+            std::vector<VkCommandBuffer>           command_buffers_vk;
+            std::vector<Anvil::Semaphore*>         semaphore_ptrs;
+            std::vector<uint32_t>                  signal_semaphore_device_indices;
+            std::vector<VkSemaphore>               signal_semaphores_vk;
+            std::vector<PendingSubmission>         submissions;
+            std::vector<VkPipelineStageFlags>      wait_dst_stage_masks;
+            std::vector<uint32_t>                  wait_semaphore_device_indices;
+            std::vector<VkSemaphore>               wait_semaphores_vk;
+
+            #if defined(_WIN32)
+                std::vector<uint64_t>                  d3d12_fence_signal_semaphore_values;
+                std::vector<uint64_t>                  d3d12_fence_wait_semaphore_values;
+                std::vector<VkD3D12FenceSubmitInfoKHR> d3d12_fence_submit_infos_vk;
+            #endif
+
+            /* Scratch storage for the structures passed to vkQueueSubmit() */
+            std::vector<VkDeviceGroupSubmitInfoKHR> device_group_submit_infos_vk;
+            std::vector<VkSubmitInfo>               submit_infos_vk;
+
+            /* Forgets all pending submissions. Capacity is retained, so that subsequent submissions
+             * do not need to allocate memory. */
+            void clear();
+        } PendingSubmissions;
+
+        enum class PostedRequestType
+        {
+            PRESENT,
+            STUB,
+            SUBMIT
+        };
+
+        /* Describes a request posted to the submission thread. Arrays referred to by the request's SubmitInfo
+         * are copied, so that the poster does not need to keep them alive.
+         *
+         * Processed requests are recycled through the queue's free list. next_ptr links the request into whichever
+         * of the two lists it is on. */
+        typedef struct PostedRequest
+        {
+            std::atomic<PostedRequest*> next_ptr;
+            SubmissionTicket            ticket;
+            PostedRequestType           type;
+
+            std::vector<Anvil::CommandBufferBase*>   command_buffer_ptrs;
+            std::vector<CommandBufferMGPUSubmission> command_buffers_mgpu;
+            Anvil::Fence*                            fence_ptr;
+            bool                                     is_mgpu;
+            std::vector<Anvil::Semaphore*>           signal_semaphore_ptrs;
+            std::vector<SemaphoreMGPUSubmission>     signal_semaphores_mgpu;
+            std::vector<Anvil::PipelineStageFlags>   wait_dst_stage_masks;
+            std::vector<Anvil::Semaphore*>           wait_semaphore_ptrs;
+            std::vector<SemaphoreMGPUSubmission>     wait_semaphores_mgpu;
+
+            #if defined(_WIN32)
+                std::vector<uint64_t> d3d12_fence_signal_semaphore_values;
+                std::vector<uint64_t> d3d12_fence_wait_semaphore_values;
+            #endif
+
+            Anvil::Swapchain* swapchain_ptr;
+            uint32_t          swapchain_image_index;
+
+            VkResult* present_result_ptr;
+            bool*     submit_result_ptr;
+
+            explicit PostedRequest(PostedRequestType in_type)
+                :next_ptr             (nullptr),
+                 ticket               (0),
+                 type                 (in_type),
+                 fence_ptr            (nullptr),
+                 is_mgpu              (false),
+                 swapchain_ptr        (nullptr),
+                 swapchain_image_index(0),
+                 present_result_ptr   (nullptr),
+                 submit_result_ptr    (nullptr)
+            {
+                /* Stub */
+            }
+
+            /* Prepares a recycled request for reuse. Capacity of the arrays is retained, so that subsequent
+             * posts do not need to allocate memory. */
+            void reset(PostedRequestType in_type);
+        } PostedRequest;
+
         /* Private functions */
+        void           drain_submission_thread();
+        bool           has_posted_requests    () const;
+        void           mark_ticket_processed  (SubmissionTicket in_ticket);
+        PostedRequest* acquire_posted_request (PostedRequestType in_type);
+        PostedRequest* pop_posted_request     ();
+        void           process_posted_request (PostedRequest*    in_request_ptr);
+        void           push_posted_request    (PostedRequest*    in_request_ptr);
+        void           release_posted_request (PostedRequest*    in_request_ptr);
+        void           submission_thread_main ();
+
+        void enqueue_submission       (const SubmitInfo& in_submit_info);
+        bool flush_pending_submissions(Anvil::Fence*     in_opt_fence_ptr);
+        void lock_unlock_pending_submissions(Anvil::Fence* in_opt_fence_ptr,
+                                             bool          in_should_lock);
+        bool submit_internal                (uint32_t          in_n_submit_infos,
+                                             const SubmitInfo* in_submit_infos_ptr,
+                                             Anvil::Fence*     in_opt_fence_ptr,
+                                             bool              in_should_block,
+                                             uint64_t          in_timeout);
+
         VkResult present_internal   (Anvil::DeviceGroupPresentModeFlagBits in_presentation_mode,
                                      uint32_t                              in_n_swapchains,
                                      Anvil::Swapchain* const*              in_swapchains,
@@ -288,24 +582,8 @@ namespace Anvil
                                      Anvil::Semaphore* const*              in_wait_semaphore_ptrs,
                                      bool                                  in_should_lock);
 
-        void bind_sparse_memory_lock_unlock    (Anvil::SparseMemoryBindingUpdateInfo& in_update,
-                                                bool                                  in_should_lock);
-        void submit_command_buffers_lock_unlock(uint32_t                              in_n_command_buffers,
-                                                Anvil::CommandBufferBase* const*      in_opt_cmd_buffer_ptrs_ptr,
-                                                uint32_t                              in_n_semaphores_to_signal,
-                                                Anvil::Semaphore* const*              in_opt_semaphore_to_signal_ptrs_ptr,
-                                                uint32_t                              in_n_semaphores_to_wait_on,
-                                                Anvil::Semaphore* const*              in_opt_semaphore_to_wait_on_ptrs_ptr,
-                                                Anvil::Fence*                         in_opt_fence_ptr,
-                                                bool                                  in_should_lock);
-        void submit_command_buffers_lock_unlock(uint32_t                              in_n_command_buffer_submissions,
-                                                const CommandBufferMGPUSubmission*    in_opt_command_buffer_submissions_ptr,
-                                                uint32_t                              in_n_signal_semaphore_submissions,
-                                                const SemaphoreMGPUSubmission*        in_opt_signal_semaphore_submissions_ptr,
-                                                uint32_t                              in_n_wait_semaphore_submissions,
-                                                const SemaphoreMGPUSubmission*        in_opt_wait_semaphore_submissions_ptr,
-                                                Anvil::Fence*                         in_opt_fence_ptr,
-                                                bool                                  in_should_lock);
+        void bind_sparse_memory_lock_unlock(Anvil::SparseMemoryBindingUpdateInfo& in_update,
+                                            bool                                  in_should_lock);
 
         /* Constructor. Please see create() for specification */
         Queue(const Anvil::BaseDevice* in_device_ptr,
@@ -322,8 +600,35 @@ namespace Anvil
         VkQueue                  m_queue;
         uint32_t                 m_queue_family_index;
         uint32_t                 m_queue_index;
-        Anvil::FenceUniquePtr    m_submit_fence_ptr;
+        PendingSubmissions       m_pending_submissions;
+        std::vector<VkSemaphore> m_present_wait_semaphores_vk;
+        bool                     m_submission_deferral_enabled;
         bool                     m_supports_sparse_bindings;
+
+        /* Submission thread state. Posted requests form an intrusive multi-producer, single-consumer queue:
+         * producers append to m_posted_requests_head_ptr, the submission thread pops from m_posted_requests_tail_ptr.
+         *
+         * Processed requests are pushed onto a lock-free stack by the submission thread, and popped by producers.
+         * Only one producer pops at a time, which rules out ABA. Producers which find the stack busy or empty
+         * allocate a new request instead. */
+        std::atomic<SubmissionTicket>   m_n_last_issued_ticket;
+        std::atomic<SubmissionTicket>   m_n_last_processed_ticket;
+        std::atomic<uint32_t>           m_n_ticket_waiters;
+        std::atomic<PostedRequest*>     m_free_posted_requests_head_ptr;
+        std::atomic<bool>               m_free_posted_requests_popping;
+        std::atomic<PostedRequest*>     m_posted_requests_head_ptr;
+        PostedRequest                   m_posted_requests_stub;
+        PostedRequest*                  m_posted_requests_tail_ptr;
+        std::thread                     m_submission_thread;
+        bool                            m_submission_thread_enabled;
+        std::atomic<std::thread::id>    m_submission_thread_id;
+        std::mutex                      m_submission_thread_mutex;
+        std::atomic<bool>               m_submission_thread_sleeping;
+        bool                            m_submission_thread_stop_requested;
+        std::condition_variable         m_submission_thread_wake_cv;
+        std::vector<SubmissionTicket>   m_tickets_processed_out_of_order; /* Sorted; only accessed by the submission thread */
+        std::condition_variable         m_ticket_processed_cv;
+        std::mutex                      m_ticket_processed_mutex;
     };
 }; /* namespace Anvil */
 
@@ -0,0 +1,321 @@
+//
+// Copyright (c) 2017-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "misc/buffer_create_info.h"
+#include "misc/buffer_ring_allocator.h"
+#include "misc/debug.h"
+#include "misc/memory_block_create_info.h"
+#include "wrappers/buffer.h"
+#include "wrappers/device.h"
+#include "wrappers/fence.h"
+#include "wrappers/memory_block.h"
+#include <algorithm>
+#include <cstring>
+
+
+/* Please see header for specification */
+Anvil::BufferRingAllocator::BufferRingAllocator(const Anvil::BaseDevice* in_device_ptr,
+                                                VkDeviceSize             in_frame_slot_size,
+                                                uint32_t                 in_n_frame_slots)
+    :m_alignment           (1),
+     m_device_ptr          (in_device_ptr),
+     m_frame_slot_fences   (in_n_frame_slots,
+                            nullptr),
+     m_frame_slot_size     (in_frame_slot_size),
+     m_frame_started       (false),
+     m_is_coherent         (false),
+     m_mapped_data_ptr     (nullptr),
+     m_memory_offset       (0),
+     m_memory_block_ptr    (nullptr),
+     m_memory_size         (0),
+     m_n_bytes_used        (0),
+     m_n_current_frame_slot(in_n_frame_slots - 1)
+{
+    /* Stub */
+}
+
+/* Please see header for specification */
+Anvil::BufferRingAllocator::~BufferRingAllocator()
+{
+    if (m_mapped_data_ptr != nullptr)
+    {
+        m_memory_block_ptr->unmap();
+
+        m_mapped_data_ptr = nullptr;
+    }
+
+    m_buffer_ptr.reset();
+}
+
+/* Please see header for specification */
+bool Anvil::BufferRingAllocator::allocate(VkDeviceSize in_size,
+                                          Allocation*  out_allocation_ptr)
+{
+    const VkDeviceSize offset = Anvil::Utils::round_up(m_n_bytes_used,
+                                                       m_alignment);
+    bool               result = false;
+
+    anvil_assert(m_frame_started);
+    anvil_assert(in_size > 0);
+
+    if (offset + in_size > m_frame_slot_size)
+    {
+        goto end;
+    }
+
+    out_allocation_ptr->offset   = m_frame_slot_size * m_n_current_frame_slot + offset;
+    out_allocation_ptr->data_ptr = m_mapped_data_ptr + out_allocation_ptr->offset;
+    out_allocation_ptr->size     = in_size;
+
+    m_n_bytes_used = offset + in_size;
+    result         = true;
+end:
+    return result;
+}
+
+/* Please see header for specification */
+bool Anvil::BufferRingAllocator::allocate_and_write(VkDeviceSize in_size,
+                                                    const void*  in_data_ptr,
+                                                    uint32_t*    out_dynamic_offset_ptr)
+{
+    Allocation allocation;
+    bool       result = false;
+
+    if (!allocate(in_size,
+                 &allocation) )
+    {
+        goto end;
+    }
+
+    memcpy(allocation.data_ptr,
+           in_data_ptr,
+           static_cast<size_t>(in_size) );
+
+    *out_dynamic_offset_ptr = allocation.get_dynamic_offset();
+    result                  = true;
+end:
+    return result;
+}
+
+/* Please see header for specification */
+bool Anvil::BufferRingAllocator::begin_frame()
+{
+    Anvil::Fence* fence_ptr = nullptr;
+    bool          result    = true;
+
+    anvil_assert(!m_frame_started);
+
+    m_n_current_frame_slot = (m_n_current_frame_slot + 1) % static_cast<uint32_t>(m_frame_slot_fences.size() );
+    fence_ptr              = m_frame_slot_fences.at(m_n_current_frame_slot);
+
+    if (fence_ptr != nullptr)
+    {
+        VkResult result_vk;
+
+        fence_ptr->lock();
+        {
+            result_vk = Anvil::Vulkan::vkWaitForFences(m_device_ptr->get_device_vk(),
+                                                       1, /* fenceCount */
+                                                       fence_ptr->get_fence_ptr(),
+                                                       VK_TRUE, /* waitAll */
+                                                       UINT64_MAX);
+        }
+        fence_ptr->unlock();
+
+        if (!is_vk_call_successful(result_vk) )
+        {
+            anvil_assert_vk_call_succeeded(result_vk);
+
+            result = false;
+        }
+
+        m_frame_slot_fences.at(m_n_current_frame_slot) = nullptr;
+    }
+
+    m_frame_started = true;
+    m_n_bytes_used  = 0;
+
+    return result;
+}
+
+/* Please see header for specification */
+Anvil::BufferRingAllocatorUniquePtr Anvil::BufferRingAllocator::create(const Anvil::BaseDevice* in_device_ptr,
+                                                                       VkDeviceSize             in_frame_slot_size,
+                                                                       uint32_t                 in_n_frame_slots,
+                                                                       Anvil::BufferUsageFlags  in_usage_flags,
+                                                                       Anvil::QueueFamilyFlags  in_queue_families)
+{
+    Anvil::BufferRingAllocatorUniquePtr result_ptr(nullptr,
+                                                   std::default_delete<Anvil::BufferRingAllocator>() );
+
+    anvil_assert(in_frame_slot_size > 0);
+    anvil_assert(in_n_frame_slots   > 0);
+
+    result_ptr.reset(
+        new Anvil::BufferRingAllocator(in_device_ptr,
+                                       in_frame_slot_size,
+                                       in_n_frame_slots)
+    );
+
+    if (result_ptr != nullptr)
+    {
+        if (!result_ptr->init(in_usage_flags,
+                              in_queue_families) )
+        {
+            result_ptr.reset();
+        }
+    }
+
+    return result_ptr;
+}
+
+/* Please see header for specification */
+bool Anvil::BufferRingAllocator::end_frame(Anvil::Fence* in_opt_fence_ptr)
+{
+    bool result = true;
+
+    anvil_assert(m_frame_started);
+
+    if (!m_is_coherent &&
+         m_n_bytes_used > 0)
+    {
+        /* Flush everything written in this frame with a single call */
+        const auto          non_coherent_atom_size = m_device_ptr->get_physical_device_properties().core_vk1_0_properties_ptr->limits.non_coherent_atom_size;
+        const VkDeviceSize  slot_start_offset      = m_memory_offset + m_frame_slot_size * m_n_current_frame_slot;
+        VkMappedMemoryRange mapped_memory_range;
+        VkResult            result_vk;
+
+        mapped_memory_range.memory = m_memory_block_ptr->get_memory();
+        mapped_memory_range.offset = Anvil::Utils::round_down(slot_start_offset,
+                                                              non_coherent_atom_size);
+        mapped_memory_range.pNext  = nullptr;
+        mapped_memory_range.size   = std::min(Anvil::Utils::round_up(slot_start_offset + m_n_bytes_used, non_coherent_atom_size),
+                                              m_memory_size) - mapped_memory_range.offset;
+        mapped_memory_range.sType  = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+
+        result_vk = Anvil::Vulkan::vkFlushMappedMemoryRanges(m_device_ptr->get_device_vk(),
+                                                             1, /* memRangeCount */
+                                                            &mapped_memory_range);
+
+        if (!is_vk_call_successful(result_vk) )
+        {
+            anvil_assert_vk_call_succeeded(result_vk);
+
+            result = false;
+        }
+    }
+
+    m_frame_slot_fences.at(m_n_current_frame_slot) = in_opt_fence_ptr;
+    m_frame_started                                = false;
+
+    return result;
+}
+
+/** Creates the buffer, maps it for the lifetime of the allocator and works out the sub-allocation alignment.
+ *
+ *  @return true if successful, false otherwise.
+ **/
+bool Anvil::BufferRingAllocator::init(Anvil::BufferUsageFlags in_usage_flags,
+                                      Anvil::QueueFamilyFlags in_queue_families)
+{
+    const auto&                limits          = m_device_ptr->get_physical_device_properties().core_vk1_0_properties_ptr->limits;
+    const Anvil::MemoryBlock*  root_block_ptr  = nullptr;
+    bool                       result          = false;
+    void*                      mapped_data_ptr = nullptr;
+
+    /* Work out the alignment, so that every sub-allocation can be bound as a dynamic descriptor */
+    if ((in_usage_flags & Anvil::BufferUsageFlagBits::UNIFORM_BUFFER_BIT) != 0)
+    {
+        m_alignment = std::max(m_alignment,
+                               limits.min_uniform_buffer_offset_alignment);
+    }
+
+    if ((in_usage_flags & Anvil::BufferUsageFlagBits::STORAGE_BUFFER_BIT) != 0)
+    {
+        m_alignment = std::max(m_alignment,
+                               limits.min_storage_buffer_offset_alignment);
+    }
+
+    if ((in_usage_flags & Anvil::BufferUsageFlagBits::STORAGE_TEXEL_BUFFER_BIT) != 0 ||
+        (in_usage_flags & Anvil::BufferUsageFlagBits::UNIFORM_TEXEL_BUFFER_BIT) != 0)
+    {
+        m_alignment = std::max(m_alignment,
+                               limits.min_texel_buffer_offset_alignment);
+    }
+
+    m_frame_slot_size = Anvil::Utils::round_up(m_frame_slot_size,
+                                               m_alignment);
+
+    {
+        const auto sharing_mode    = Anvil::Utils::is_pow2(static_cast<uint32_t>(in_queue_families.get_vk() ) ) ? Anvil::SharingMode::EXCLUSIVE
+                                                                                                                : Anvil::SharingMode::CONCURRENT;
+        auto       create_info_ptr = Anvil::BufferCreateInfo::create_alloc(m_device_ptr,
+                                                                           m_frame_slot_size * m_frame_slot_fences.size(),
+                                                                           in_queue_families,
+                                                                           sharing_mode,
+                                                                           Anvil::BufferCreateFlagBits::NONE,
+                                                                           in_usage_flags,
+                                                                           Anvil::MemoryFeatureFlagBits::MAPPABLE_BIT);
+
+        create_info_ptr->set_mt_safety(Anvil::MTSafety::DISABLED);
+
+        m_buffer_ptr = Anvil::Buffer::create(std::move(create_info_ptr) );
+    }
+
+    if (m_buffer_ptr == nullptr)
+    {
+        anvil_assert(m_buffer_ptr != nullptr);
+
+        goto end;
+    }
+
+    m_memory_block_ptr = m_buffer_ptr->get_memory_block(0);
+
+    if (m_memory_block_ptr == nullptr)
+    {
+        anvil_assert(m_memory_block_ptr != nullptr);
+
+        goto end;
+    }
+
+    /* The mapping is held until the allocator goes out of scope, so writes never trigger a map/unmap */
+    if (!m_memory_block_ptr->map(0, /* in_start_offset */
+                                 m_buffer_ptr->get_create_info_ptr()->get_size(),
+                                &mapped_data_ptr) )
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    m_mapped_data_ptr = static_cast<uint8_t*>(mapped_data_ptr);
+    m_is_coherent     = ((m_memory_block_ptr->get_create_info_ptr()->get_memory_features() & Anvil::MemoryFeatureFlagBits::HOST_COHERENT_BIT) != 0);
+
+    /* Flushes operate on VkDeviceMemory offsets. The block's start offset is already relative to its VkDeviceMemory. */
+    root_block_ptr  = m_memory_block_ptr->get_root_memory_block();
+    m_memory_offset = m_memory_block_ptr->get_start_offset();
+    m_memory_size   = root_block_ptr->get_start_offset() + root_block_ptr->get_create_info_ptr()->get_size();
+
+    result = true;
+end:
+    return result;
+}
@@ -0,0 +1,931 @@
+//
+// Copyright (c) 2017-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "misc/command_stream.h"
+#include "misc/debug.h"
+#include "wrappers/command_buffer.h"
+#include <string.h>
+
+/* Command payloads, as stored in the stream. Object references are indices into the stream's object table.
+ * Variable-length arrays, if any, directly follow the payload. Payload sizes are chosen so that each array
+ * starts at an offset aligned to its item type, which lets replay() hand the arrays to the command buffer
+ * in-place. */
+namespace
+{
+    typedef struct BindDescriptorSetsPayload
+    {
+        uint32_t pipeline_bind_point;
+        uint32_t layout_id;
+        uint32_t first_set;
+        uint32_t set_count;
+        uint32_t dynamic_offset_count;
+
+        /* Index of the first of set_count items in CommandStream::m_descriptor_set_ptrs */
+        uint32_t first_descriptor_set_ptr;
+
+        /* Followed by: uint32_t descriptor_set_ids[set_count], uint32_t dynamic_offsets[dynamic_offset_count] */
+    } BindDescriptorSetsPayload;
+
+    typedef struct BindIndexBufferPayload
+    {
+        VkDeviceSize offset;
+        uint32_t     buffer_id;
+        uint32_t     index_type;
+    } BindIndexBufferPayload;
+
+    typedef struct BindPipelinePayload
+    {
+        uint32_t pipeline_bind_point;
+        uint32_t pipeline_id;
+    } BindPipelinePayload;
+
+    typedef struct BindVertexBuffersPayload
+    {
+        uint32_t start_binding;
+        uint32_t binding_count;
+
+        /* Index of the first of binding_count items in CommandStream::m_buffer_ptrs */
+        uint32_t first_buffer_ptr;
+        uint32_t padding;
+
+        /* Followed by: VkDeviceSize offsets[binding_count], uint32_t buffer_ids[binding_count] */
+    } BindVertexBuffersPayload;
+
+    typedef struct DispatchPayload
+    {
+        uint32_t x;
+        uint32_t y;
+        uint32_t z;
+    } DispatchPayload;
+
+    typedef struct IndirectPayload
+    {
+        VkDeviceSize offset;
+        uint32_t     buffer_id;
+        uint32_t     count;
+        uint32_t     stride;
+    } IndirectPayload;
+
+    typedef struct DrawPayload
+    {
+        uint32_t vertex_count;
+        uint32_t instance_count;
+        uint32_t first_vertex;
+        uint32_t first_instance;
+    } DrawPayload;
+
+    typedef struct DrawIndexedPayload
+    {
+        uint32_t index_count;
+        uint32_t instance_count;
+        uint32_t first_index;
+        int32_t  vertex_offset;
+        uint32_t first_instance;
+    } DrawIndexedPayload;
+
+    typedef struct PushConstantsPayload
+    {
+        uint32_t layout_id;
+        uint32_t stage_flags;
+        uint32_t offset;
+        uint32_t size;
+
+        /* Followed by: uint8_t values[size] */
+    } PushConstantsPayload;
+
+    typedef struct SetBlendConstantsPayload
+    {
+        float blend_constants[4];
+    } SetBlendConstantsPayload;
+
+    typedef struct SetDepthBiasPayload
+    {
+        float depth_bias_constant_factor;
+        float depth_bias_clamp;
+        float slope_scaled_depth_bias;
+    } SetDepthBiasPayload;
+
+    typedef struct SetLineWidthPayload
+    {
+        float line_width;
+    } SetLineWidthPayload;
+
+    typedef struct SetRectsPayload
+    {
+        uint32_t first;
+        uint32_t count;
+
+        /* Followed by: VkRect2D / VkViewport items[count] */
+    } SetRectsPayload;
+
+    typedef struct SetStencilReferencePayload
+    {
+        uint32_t face_mask;
+        uint32_t stencil_reference;
+    } SetStencilReferencePayload;
+
+    /* Reads consecutive items from a command's data. memcpy() is used for individual items, since the header
+     * and payloads are not necessarily aligned to the alignment requirements of the items they hold. */
+    class CommandReader
+    {
+    public:
+        explicit CommandReader(const uint8_t* in_data_ptr)
+            :m_data_ptr(in_data_ptr)
+        {
+            /* Stub */
+        }
+
+        template<typename ItemType>
+        ItemType read()
+        {
+            ItemType result;
+
+            memcpy(&result,
+                   m_data_ptr,
+                   sizeof(ItemType) );
+
+            m_data_ptr += sizeof(ItemType);
+
+            return result;
+        }
+
+        /** Returns a pointer to an array of @param in_n_items items at the current location and moves past it.
+         *  The array must have been written at an offset aligned to ItemType. */
+        template<typename ItemType>
+        const ItemType* read_array(uint32_t in_n_items)
+        {
+            const ItemType* result_ptr = (in_n_items > 0) ? reinterpret_cast<const ItemType*>(m_data_ptr)
+                                                          : nullptr;
+
+            anvil_assert((reinterpret_cast<uintptr_t>(m_data_ptr) % alignof(ItemType)) == 0);
+
+            m_data_ptr += sizeof(ItemType) * in_n_items;
+
+            return result_ptr;
+        }
+
+    private:
+        const uint8_t* m_data_ptr;
+    };
+};
+
+
+/* Please see header for specification */
+Anvil::CommandStream::CommandStream()
+    :m_n_commands(0)
+{
+    /* Stub */
+}
+
+/* Please see header for specification */
+Anvil::CommandStream::~CommandStream()
+{
+    /* Stub */
+}
+
+/** Appends a header for a new command of the specified type to the stream.
+ *
+ *  @param in_type Type of the command.
+ *
+ *  @return Offset of the command. Should be passed to end_command() once the command's payload
+ *          has been written.
+ **/
+uint32_t Anvil::CommandStream::begin_command(CommandType in_type)
+{
+    CommandHeader  header;
+    const uint32_t result = static_cast<uint32_t>(m_data.size() );
+
+    header.padding = 0;
+    header.size    = 0;
+    header.type    = static_cast<uint16_t>(in_type);
+
+    write(header);
+
+    return result;
+}
+
+/* Please see header for specification */
+void Anvil::CommandStream::clear()
+{
+    m_buffer_ptrs.clear        ();
+    m_data.clear               ();
+    m_descriptor_set_ptrs.clear();
+    m_object_id_map.clear      ();
+    m_objects.clear            ();
+
+    m_n_commands = 0;
+}
+
+/* Please see header for specification */
+Anvil::CommandStreamUniquePtr Anvil::CommandStream::create()
+{
+    Anvil::CommandStreamUniquePtr result_ptr(nullptr,
+                                             std::default_delete<Anvil::CommandStream>() );
+
+    result_ptr.reset(
+        new Anvil::CommandStream()
+    );
+
+    return result_ptr;
+}
+
+/** Pads the command started at @param in_command_offset to a multiple of 8 bytes and stores
+ *  its final size in the header.
+ **/
+void Anvil::CommandStream::end_command(uint32_t in_command_offset)
+{
+    uint32_t command_size = static_cast<uint32_t>(m_data.size() ) - in_command_offset;
+
+    if ((command_size % 8) != 0)
+    {
+        m_data.resize(m_data.size() + (8 - command_size % 8),
+                      0);
+
+        command_size = static_cast<uint32_t>(m_data.size() ) - in_command_offset;
+    }
+
+    memcpy(&m_data.at(in_command_offset) + offsetof(CommandHeader, size),
+           &command_size,
+           sizeof(command_size) );
+
+    ++m_n_commands;
+}
+
+/* Please see header for specification */
+const void* Anvil::CommandStream::get_object(uint32_t           in_n_object,
+                                             Anvil::ObjectType* out_opt_type_ptr) const
+{
+    if (in_n_object >= m_objects.size() )
+    {
+        return nullptr;
+    }
+
+    if (out_opt_type_ptr != nullptr)
+    {
+        *out_opt_type_ptr = m_objects.at(in_n_object).type;
+    }
+
+    return m_objects.at(in_n_object).object_ptr;
+}
+
+/** Returns the index of the specified object in the object table, adding the object to the table
+ *  if it is not there yet.
+ **/
+uint32_t Anvil::CommandStream::get_object_id(const void*       in_object_ptr,
+                                             Anvil::ObjectType in_type)
+{
+    auto     map_iterator = m_object_id_map.find(in_object_ptr);
+    uint32_t result;
+
+    if (map_iterator != m_object_id_map.end() )
+    {
+        anvil_assert(m_objects.at(map_iterator->second).type == in_type);
+
+        result = map_iterator->second;
+    }
+    else
+    {
+        result = static_cast<uint32_t>(m_objects.size() );
+
+        m_objects.push_back      (ObjectEntry(in_object_ptr,
+                                              in_type) );
+        m_object_id_map.insert   (std::make_pair(in_object_ptr,
+                                                 result) );
+    }
+
+    return result;
+}
+
+/* Please see header for specification */
+bool Anvil::CommandStream::record_bind_descriptor_sets(Anvil::PipelineBindPoint           in_pipeline_bind_point,
+                                                       Anvil::PipelineLayout*             in_layout_ptr,
+                                                       uint32_t                           in_first_set,
+                                                       uint32_t                           in_set_count,
+                                                       const Anvil::DescriptorSet* const* in_descriptor_set_ptrs,
+                                                       uint32_t                           in_dynamic_offset_count,
+                                                       const uint32_t*                    in_dynamic_offset_ptrs)
+{
+    const uint32_t            command_offset = begin_command(CommandType::BIND_DESCRIPTOR_SETS);
+    BindDescriptorSetsPayload payload;
+
+    anvil_assert(in_layout_ptr != nullptr);
+
+    payload.dynamic_offset_count     = in_dynamic_offset_count;
+    payload.first_descriptor_set_ptr = static_cast<uint32_t>(m_descriptor_set_ptrs.size() );
+    payload.first_set                = in_first_set;
+    payload.layout_id                = get_object_id(in_layout_ptr,
+                                                     Anvil::ObjectType::PIPELINE_LAYOUT);
+    payload.pipeline_bind_point      = static_cast<uint32_t>(in_pipeline_bind_point);
+    payload.set_count                = in_set_count;
+
+    write(payload);
+
+    for (uint32_t n_set = 0;
+                  n_set < in_set_count;
+                ++n_set)
+    {
+        write(get_object_id(in_descriptor_set_ptrs[n_set],
+                            Anvil::ObjectType::DESCRIPTOR_SET) );
+
+        m_descriptor_set_ptrs.push_back(in_descriptor_set_ptrs[n_set]);
+    }
+
+    if (in_dynamic_offset_count > 0)
+    {
+        write(in_dynamic_offset_ptrs,
+              sizeof(uint32_t) * in_dynamic_offset_count);
+    }
+
+    end_command(command_offset);
+
+    return true;
+}
+
+/* Please see header for specification */
+bool Anvil::CommandStream::record_bind_index_buffer(Anvil::Buffer*   in_buffer_ptr,
+                                                    VkDeviceSize     in_offset,
+                                                    Anvil::IndexType in_index_type)
+{
+    const uint32_t         command_offset = begin_command(CommandType::BIND_INDEX_BUFFER);
+    BindIndexBufferPayload payload;
+
+    payload.buffer_id  = get_object_id(in_buffer_ptr,
+                                       Anvil::ObjectType::BUFFER);
+    payload.index_type = static_cast<uint32_t>(in_index_type);
+    payload.offset     = in_offset;
+
+    write      (payload);
+    end_command(command_offset);
+
+    return true;
+}
+
+/* Please see header for specification */
+bool Anvil::CommandStream::record_bind_pipeline(Anvil::PipelineBindPoint in_pipeline_bind_point,
+                                                Anvil::PipelineID        in_pipeline_id)
+{
+    const uint32_t      command_offset = begin_command(CommandType::BIND_PIPELINE);
+    BindPipelinePayload payload;
+
+    /* Pipeline IDs are resolved to VkPipeline handles at replay time, so pipelines which are baked lazily
+     * only need to be ready by the time the stream is replayed. */
+    payload.pipeline_bind_point = static_cast<uint32_t>(in_pipeline_bind_point);
+    payload.pipeline_id         = in_pipeline_id;
+
+    write      (payload);
+    end_command(command_offset);
+
+    return true;
+}
+
+/* Please see header for specification */
+bool Anvil::CommandStream::record_bind_vertex_buffers(uint32_t            in_start_binding,
+                                                      uint32_t            in_binding_count,
+                                                      Anvil::Buffer**     in_buffer_ptrs,
+                                                      const VkDeviceSize* in_offset_ptrs)
+{
+    const uint32_t           command_offset = begin_command(CommandType::BIND_VERTEX_BUFFERS);
+    BindVertexBuffersPayload payload;
+
+    payload.binding_count    = in_binding_count;
+    payload.first_buffer_ptr = static_cast<uint32_t>(m_buffer_ptrs.size() );
+    payload.padding          = 0;
+    payload.start_binding    = in_start_binding;
+
+    write(payload);
+    write(in_offset_ptrs,
+          static_cast<uint32_t>(sizeof(VkDeviceSize) * in_binding_count) );
+
+    for (uint32_t n_binding = 0;
+                  n_binding < in_binding_count;
+                ++n_binding)
+    {
+        write(get_object_id(in_buffer_ptrs[n_binding],
+                            Anvil::ObjectType::BUFFER) );
+
+        m_buffer_ptrs.push_back(in_buffer_ptrs[n_binding]);
+    }
+
+    end_command(command_offset);
+
+    return true;
+}
+
+/* Please see header for specification */
+bool Anvil::CommandStream::record_dispatch(uint32_t in_x,
+                                           uint32_t in_y,
+                                           uint32_t in_z)
+{
+    const uint32_t  command_offset = begin_command(CommandType::DISPATCH);
+    DispatchPayload payload;
+
+    payload.x = in_x;
+    payload.y = in_y;
+    payload.z = in_z;
+
+    write      (payload);
+    end_command(command_offset);
+
+    return true;
+}
+
+/* Please see header for specification */
+bool Anvil::CommandStream::record_dispatch_indirect(Anvil::Buffer* in_buffer_ptr,
+                                                    VkDeviceSize   in_offset)
+{
+    const uint32_t  command_offset = begin_command(CommandType::DISPATCH_INDIRECT);
+    IndirectPayload payload;
+
+    payload.buffer_id = get_object_id(in_buffer_ptr,
+                                      Anvil::ObjectType::BUFFER);
+    payload.count     = 0;
+    payload.offset    = in_offset;
+    payload.stride    = 0;
+
+    write      (payload);
+    end_command(command_offset);
+
+    return true;
+}
+
+/* Please see header for specification */
+bool Anvil::CommandStream::record_draw(uint32_t in_vertex_count,
+                                       uint32_t in_instance_count,
+                                       uint32_t in_first_vertex,
+                                       uint32_t in_first_instance)
+{
+    const uint32_t command_offset = begin_command(CommandType::DRAW);
+    DrawPayload    payload;
+
+    payload.first_instance = in_first_instance;
+    payload.first_vertex   = in_first_vertex;
+    payload.instance_count = in_instance_count;
+    payload.vertex_count   = in_vertex_count;
+
+    write      (payload);
+    end_command(command_offset);
+
+    return true;
+}
+
+/* Please see header for specification */
+bool Anvil::CommandStream::record_draw_indexed(uint32_t in_index_count,
+                                               uint32_t in_instance_count,
+                                               uint32_t in_first_index,
+                                               int32_t  in_vertex_offset,
+                                               uint32_t in_first_instance)
+{
+    const uint32_t     command_offset = begin_command(CommandType::DRAW_INDEXED);
+    DrawIndexedPayload payload;
+
+    payload.first_index    = in_first_index;
+    payload.first_instance = in_first_instance;
+    payload.index_count    = in_index_count;
+    payload.instance_count = in_instance_count;
+    payload.vertex_offset  = in_vertex_offset;
+
+    write      (payload);
+    end_command(command_offset);
+
+    return true;
+}
+
+/* Please see header for specification */
+bool Anvil::CommandStream::record_draw_indexed_indirect(Anvil::Buffer* in_buffer_ptr,
+                                                        VkDeviceSize   in_offset,
+                                                        uint32_t       in_draw_count,
+                                                        uint32_t       in_stride)
+{
+    const uint32_t  command_offset = begin_command(CommandType::DRAW_INDEXED_INDIRECT);
+    IndirectPayload payload;
+
+    payload.buffer_id = get_object_id(in_buffer_ptr,
+                                      Anvil::ObjectType::BUFFER);
+    payload.count     = in_draw_count;
+    payload.offset    = in_offset;
+    payload.stride    = in_stride;
+
+    write      (payload);
+    end_command(command_offset);
+
+    return true;
+}
+
+/* Please see header for specification */
+bool Anvil::CommandStream::record_draw_indirect(Anvil::Buffer* in_buffer_ptr,
+                                                VkDeviceSize   in_offset,
+                                                uint32_t       in_count,
+                                                uint32_t       in_stride)
+{
+    const uint32_t  command_offset = begin_command(CommandType::DRAW_INDIRECT);
+    IndirectPayload payload;
+
+    payload.buffer_id = get_object_id(in_buffer_ptr,
+                                      Anvil::ObjectType::BUFFER);
+    payload.count     = in_count;
+    payload.offset    = in_offset;
+    payload.stride    = in_stride;
+
+    write      (payload);
+    end_command(command_offset);
+
+    return true;
+}
+
+/* Please see header for specification */
+bool Anvil::CommandStream::record_push_constants(Anvil::PipelineLayout*  in_layout_ptr,
+                                                 Anvil::ShaderStageFlags in_stage_flags,
+                                                 uint32_t                in_offset,
+                                                 uint32_t                in_size,
+                                                 const void*             in_values)
+{
+    const uint32_t       command_offset = begin_command(CommandType::PUSH_CONSTANTS);
+    PushConstantsPayload payload;
+
+    payload.layout_id   = get_object_id(in_layout_ptr,
+                                        Anvil::ObjectType::PIPELINE_LAYOUT);
+    payload.offset      = in_offset;
+    payload.size        = in_size;
+    payload.stage_flags = in_stage_flags.get_vk();
+
+    /* Push constant data is captured at recording time */
+    write(payload);
+    write(in_values,
+          in_size);
+
+    end_command(command_offset);
+
+    return true;
+}
+
+/* Please see header for specification */
+bool Anvil::CommandStream::record_set_blend_constants(const float in_blend_constants[4])
+{
+    const uint32_t           command_offset = begin_command(CommandType::SET_BLEND_CONSTANTS);
+    SetBlendConstantsPayload payload;
+
+    memcpy(payload.blend_constants,
+           in_blend_constants,
+           sizeof(payload.blend_constants) );
+
+    write      (payload);
+    end_command(command_offset);
+
+    return true;
+}
+
+/* Please see header for specification */
+bool Anvil::CommandStream::record_set_depth_bias(float in_depth_bias_constant_factor,
+                                                 float in_depth_bias_clamp,
+                                                 float in_slope_scaled_depth_bias)
+{
+    const uint32_t      command_offset = begin_command(CommandType::SET_DEPTH_BIAS);
+    SetDepthBiasPayload payload;
+
+    payload.depth_bias_clamp           = in_depth_bias_clamp;
+    payload.depth_bias_constant_factor = in_depth_bias_constant_factor;
+    payload.slope_scaled_depth_bias    = in_slope_scaled_depth_bias;
+
+    write      (payload);
+    end_command(command_offset);
+
+    return true;
+}
+
+/* Please see header for specification */
+bool Anvil::CommandStream::record_set_line_width(float in_line_width)
+{
+    const uint32_t      command_offset = begin_command(CommandType::SET_LINE_WIDTH);
+    SetLineWidthPayload payload;
+
+    payload.line_width = in_line_width;
+
+    write      (payload);
+    end_command(command_offset);
+
+    return true;
+}
+
+/* Please see header for specification */
+bool Anvil::CommandStream::record_set_scissor(uint32_t        in_first_scissor,
+                                              uint32_t        in_scissor_count,
+                                              const VkRect2D* in_scissor_ptrs)
+{
+    const uint32_t  command_offset = begin_command(CommandType::SET_SCISSOR);
+    SetRectsPayload payload;
+
+    payload.count = in_scissor_count;
+    payload.first = in_first_scissor;
+
+    write(payload);
+    write(in_scissor_ptrs,
+          static_cast<uint32_t>(sizeof(VkRect2D) * in_scissor_count) );
+
+    end_command(command_offset);
+
+    return true;
+}
+
+/* Please see header for specification */
+bool Anvil::CommandStream::record_set_stencil_reference(Anvil::StencilFaceFlags in_face_mask,
+                                                        uint32_t                in_stencil_reference)
+{
+    const uint32_t             command_offset = begin_command(CommandType::SET_STENCIL_REFERENCE);
+    SetStencilReferencePayload payload;
+
+    payload.face_mask         = in_face_mask.get_vk();
+    payload.stencil_reference = in_stencil_reference;
+
+    write      (payload);
+    end_command(command_offset);
+
+    return true;
+}
+
+/* Please see header for specification */
+bool Anvil::CommandStream::record_set_viewport(uint32_t          in_first_viewport,
+                                               uint32_t          in_viewport_count,
+                                               const VkViewport* in_viewport_ptrs)
+{
+    const uint32_t  command_offset = begin_command(CommandType::SET_VIEWPORT);
+    SetRectsPayload payload;
+
+    payload.count = in_viewport_count;
+    payload.first = in_first_viewport;
+
+    write(payload);
+    write(in_viewport_ptrs,
+          static_cast<uint32_t>(sizeof(VkViewport) * in_viewport_count) );
+
+    end_command(command_offset);
+
+    return true;
+}
+
+/* Please see header for specification */
+bool Anvil::CommandStream::replay(Anvil::CommandBufferBase* in_command_buffer_ptr) const
+{
+    uint32_t current_offset = 0;
+    bool     result         = true;
+
+    /* No scratch storage is needed. Arrays of plain values are passed straight from the command data, and arrays
+     * of objects come from the pointer arrays filled at recording time. */
+    anvil_assert(in_command_buffer_ptr != nullptr);
+
+    while (current_offset < m_data.size() && result)
+    {
+        const uint8_t* command_ptr = &m_data.at(current_offset);
+        CommandReader  reader       (command_ptr);
+        const auto     header       = reader.read<CommandHeader>();
+
+        anvil_assert(header.size                  >= sizeof(CommandHeader) );
+        anvil_assert(current_offset + header.size <= m_data.size() );
+
+        switch (static_cast<CommandType>(header.type) )
+        {
+            case CommandType::BIND_DESCRIPTOR_SETS:
+            {
+                const auto payload = reader.read<BindDescriptorSetsPayload>();
+
+                /* Skip the descriptor set IDs */
+                reader.read_array<uint32_t>(payload.set_count);
+
+                result = in_command_buffer_ptr->record_bind_descriptor_sets(static_cast<Anvil::PipelineBindPoint>(payload.pipeline_bind_point),
+                                                                            static_cast<Anvil::PipelineLayout*>(const_cast<void*>(m_objects.at(payload.layout_id).object_ptr) ),
+                                                                            payload.first_set,
+                                                                            payload.set_count,
+                                                                            (payload.set_count > 0) ? &m_descriptor_set_ptrs.at(payload.first_descriptor_set_ptr) : nullptr,
+                                                                            payload.dynamic_offset_count,
+                                                                            reader.read_array<uint32_t>(payload.dynamic_offset_count) );
+
+                break;
+            }
+
+            case CommandType::BIND_INDEX_BUFFER:
+            {
+                const auto payload = reader.read<BindIndexBufferPayload>();
+
+                result = in_command_buffer_ptr->record_bind_index_buffer(static_cast<Anvil::Buffer*>(const_cast<void*>(m_objects.at(payload.buffer_id).object_ptr) ),
+                                                                         payload.offset,
+                                                                         static_cast<Anvil::IndexType>(payload.index_type) );
+
+                break;
+            }
+
+            case CommandType::BIND_PIPELINE:
+            {
+                const auto payload = reader.read<BindPipelinePayload>();
+
+                result = in_command_buffer_ptr->record_bind_pipeline(static_cast<Anvil::PipelineBindPoint>(payload.pipeline_bind_point),
+                                                                     payload.pipeline_id);
+
+                break;
+            }
+
+            case CommandType::BIND_VERTEX_BUFFERS:
+            {
+                const auto payload = reader.read<BindVertexBuffersPayload>();
+
+                /* CommandBufferBase takes a non-const array of buffer pointers, but does not modify it */
+                result = in_command_buffer_ptr->record_bind_vertex_buffers(payload.start_binding,
+                                                                           payload.binding_count,
+                                                                           (payload.binding_count > 0) ? const_cast<Anvil::Buffer**>(&m_buffer_ptrs.at(payload.first_buffer_ptr) ) : nullptr,
+                                                                           reader.read_array<VkDeviceSize>(payload.binding_count) );
+
+                break;
+            }
+
+            case CommandType::DISPATCH:
+            {
+                const auto payload = reader.read<DispatchPayload>();
+
+                result = in_command_buffer_ptr->record_dispatch(payload.x,
+                                                                payload.y,
+                                                                payload.z);
+
+                break;
+            }
+
+            case CommandType::DISPATCH_INDIRECT:
+            {
+                const auto payload = reader.read<IndirectPayload>();
+
+                result = in_command_buffer_ptr->record_dispatch_indirect(static_cast<Anvil::Buffer*>(const_cast<void*>(m_objects.at(payload.buffer_id).object_ptr) ),
+                                                                         payload.offset);
+
+                break;
+            }
+
+            case CommandType::DRAW:
+            {
+                const auto payload = reader.read<DrawPayload>();
+
+                result = in_command_buffer_ptr->record_draw(payload.vertex_count,
+                                                            payload.instance_count,
+                                                            payload.first_vertex,
+                                                            payload.first_instance);
+
+                break;
+            }
+
+            case CommandType::DRAW_INDEXED:
+            {
+                const auto payload = reader.read<DrawIndexedPayload>();
+
+                result = in_command_buffer_ptr->record_draw_indexed(payload.index_count,
+                                                                    payload.instance_count,
+                                                                    payload.first_index,
+                                                                    payload.vertex_offset,
+                                                                    payload.first_instance);
+
+                break;
+            }
+
+            case CommandType::DRAW_INDEXED_INDIRECT:
+            {
+                const auto payload = reader.read<IndirectPayload>();
+
+                result = in_command_buffer_ptr->record_draw_indexed_indirect(static_cast<Anvil::Buffer*>(const_cast<void*>(m_objects.at(payload.buffer_id).object_ptr) ),
+                                                                             payload.offset,
+                                                                             payload.count,
+                                                                             payload.stride);
+
+                break;
+            }
+
+            case CommandType::DRAW_INDIRECT:
+            {
+                const auto payload = reader.read<IndirectPayload>();
+
+                result = in_command_buffer_ptr->record_draw_indirect(static_cast<Anvil::Buffer*>(const_cast<void*>(m_objects.at(payload.buffer_id).object_ptr) ),
+                                                                     payload.offset,
+                                                                     payload.count,
+                                                                     payload.stride);
+
+                break;
+            }
+
+            case CommandType::PUSH_CONSTANTS:
+            {
+                const auto payload = reader.read<PushConstantsPayload>();
+
+                result = in_command_buffer_ptr->record_push_constants(static_cast<Anvil::PipelineLayout*>(const_cast<void*>(m_objects.at(payload.layout_id).object_ptr) ),
+                                                                      Anvil::ShaderStageFlags(static_cast<Anvil::ShaderStageFlagBits>(payload.stage_flags) ),
+                                                                      payload.offset,
+                                                                      payload.size,
+                                                                      reader.read_array<uint8_t>(payload.size) );
+
+                break;
+            }
+
+            case CommandType::SET_BLEND_CONSTANTS:
+            {
+                const auto payload = reader.read<SetBlendConstantsPayload>();
+
+                result = in_command_buffer_ptr->record_set_blend_constants(payload.blend_constants);
+
+                break;
+            }
+
+            case CommandType::SET_DEPTH_BIAS:
+            {
+                const auto payload = reader.read<SetDepthBiasPayload>();
+
+                result = in_command_buffer_ptr->record_set_depth_bias(payload.depth_bias_constant_factor,
+                                                                      payload.depth_bias_clamp,
+                                                                      payload.slope_scaled_depth_bias);
+
+                break;
+            }
+
+            case CommandType::SET_LINE_WIDTH:
+            {
+                const auto payload = reader.read<SetLineWidthPayload>();
+
+                result = in_command_buffer_ptr->record_set_line_width(payload.line_width);
+
+                break;
+            }
+
+            case CommandType::SET_SCISSOR:
+            {
+                const auto payload = reader.read<SetRectsPayload>();
+
+                result = in_command_buffer_ptr->record_set_scissor(payload.first,
+                                                                   payload.count,
+                                                                   reader.read_array<VkRect2D>(payload.count) );
+
+                break;
+            }
+
+            case CommandType::SET_STENCIL_REFERENCE:
+            {
+                const auto payload = reader.read<SetStencilReferencePayload>();
+
+                result = in_command_buffer_ptr->record_set_stencil_reference(Anvil::StencilFaceFlags(static_cast<Anvil::StencilFaceFlagBits>(payload.face_mask) ),
+                                                                             payload.stencil_reference);
+
+                break;
+            }
+
+            case CommandType::SET_VIEWPORT:
+            {
+                const auto payload = reader.read<SetRectsPayload>();
+
+                result = in_command_buffer_ptr->record_set_viewport(payload.first,
+                                                                    payload.count,
+                                                                    reader.read_array<VkViewport>(payload.count) );
+
+                break;
+            }
+
+            default:
+            {
+                anvil_assert_fail();
+
+                result = false;
+            }
+        }
+
+        current_offset += header.size;
+    }
+
+    return result;
+}
+
+/** Appends raw bytes to the command data. */
+void Anvil::CommandStream::write(const void* in_data_ptr,
+                                 uint32_t    in_n_bytes)
+{
+    const size_t n_bytes_before = m_data.size();
+
+    if (in_n_bytes == 0)
+    {
+        return;
+    }
+
+    m_data.resize(n_bytes_before + in_n_bytes);
+
+    memcpy(&m_data.at(n_bytes_before),
+           in_data_ptr,
+           in_n_bytes);
+}
@@ -0,0 +1,192 @@
+//
+// Copyright (c) 2017-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "misc/debug.h"
+#include "misc/fence_create_info.h"
+#include "misc/fence_pool.h"
+#include "wrappers/device.h"
+#include "wrappers/fence.h"
+
+
+/* Please see header for specification */
+Anvil::FencePool::FencePool(const Anvil::BaseDevice* in_device_ptr,
+                            bool                     in_mt_safe)
+    :MTSafetySupportProvider(in_mt_safe),
+     m_device_ptr           (in_device_ptr)
+{
+    /* Stub */
+}
+
+/* Please see header for specification */
+Anvil::FencePool::~FencePool()
+{
+    /* All fences should have been returned by now */
+    anvil_assert(m_available_fence_ptrs.size() + m_pending_fence_ptrs.size() + m_signalled_fence_ptrs.size() == m_fence_ptrs.size() );
+}
+
+/* Please see header for specification */
+Anvil::FenceUniquePtr Anvil::FencePool::acquire()
+{
+    Anvil::Fence*         fence_ptr (nullptr);
+    Anvil::FenceUniquePtr result_ptr(nullptr,
+                                     std::default_delete<Anvil::Fence>() );
+
+    lock();
+    {
+        /* Fences released while their submissions were still in flight can be reused once they get signalled.
+         * Submissions tend to finish in the order they were released in, so stop polling at the first fence
+         * which is still unsignalled. */
+        if (m_available_fence_ptrs.size() == 0)
+        {
+            while (!m_pending_fence_ptrs.empty()          &&
+                    m_pending_fence_ptrs.front()->is_set() )
+            {
+                m_signalled_fence_ptrs.push_back(m_pending_fence_ptrs.front() );
+
+                m_pending_fence_ptrs.pop_front();
+            }
+        }
+
+        /* Reset all signalled fences at once */
+        if (m_available_fence_ptrs.size() == 0 &&
+            m_signalled_fence_ptrs.size() >  0)
+        {
+            VkResult result;
+
+            m_scratch_fences_vk.clear();
+
+            for (const auto& signalled_fence_ptr : m_signalled_fence_ptrs)
+            {
+                m_scratch_fences_vk.push_back(signalled_fence_ptr->get_fence() );
+            }
+
+            result = Anvil::Vulkan::vkResetFences(m_device_ptr->get_device_vk(),
+                                                  static_cast<uint32_t>(m_scratch_fences_vk.size() ),
+                                                 &m_scratch_fences_vk.at(0) );
+
+            anvil_assert_vk_call_succeeded(result);
+
+            if (is_vk_call_successful(result) )
+            {
+                m_available_fence_ptrs.insert(m_available_fence_ptrs.end(),
+                                              m_signalled_fence_ptrs.begin(),
+                                              m_signalled_fence_ptrs.end  () );
+
+                m_signalled_fence_ptrs.clear();
+            }
+        }
+
+        /* Create a new fence if there's nothing to reuse */
+        if (m_available_fence_ptrs.size() == 0)
+        {
+            auto create_info_ptr = Anvil::FenceCreateInfo::create(m_device_ptr,
+                                                                  false); /* in_create_signalled */
+
+            create_info_ptr->set_mt_safety(Anvil::Utils::convert_boolean_to_mt_safety_enum(is_mt_safe() ) );
+
+            auto new_fence_ptr = Anvil::Fence::create(std::move(create_info_ptr) );
+
+            if (new_fence_ptr != nullptr)
+            {
+                m_available_fence_ptrs.push_back(new_fence_ptr.get() );
+                m_fence_ptrs.push_back          (std::move(new_fence_ptr) );
+            }
+        }
+
+        if (m_available_fence_ptrs.size() > 0)
+        {
+            fence_ptr = m_available_fence_ptrs.back();
+
+            m_available_fence_ptrs.pop_back();
+        }
+    }
+    unlock();
+
+    if (fence_ptr != nullptr)
+    {
+        result_ptr = Anvil::FenceUniquePtr(fence_ptr,
+                                           [this](Anvil::Fence* in_fence_ptr)
+                                           {
+                                               release_internal(in_fence_ptr,
+                                                                true); /* in_was_submitted */
+                                           });
+    }
+
+    return result_ptr;
+}
+
+/* Please see header for specification */
+Anvil::FencePoolUniquePtr Anvil::FencePool::create(const Anvil::BaseDevice* in_device_ptr,
+                                                   bool                     in_mt_safe)
+{
+    Anvil::FencePoolUniquePtr result_ptr(nullptr,
+                                         std::default_delete<Anvil::FencePool>() );
+
+    anvil_assert(in_device_ptr != nullptr);
+
+    result_ptr.reset(
+        new Anvil::FencePool(in_device_ptr,
+                             in_mt_safe)
+    );
+
+    return result_ptr;
+}
+
+/* Please see header for specification */
+void Anvil::FencePool::release(Anvil::FenceUniquePtr in_fence_ptr,
+                               bool                  in_was_submitted)
+{
+    /* Bypass the deleter, which would assume the fence has been submitted */
+    Anvil::Fence* fence_ptr = in_fence_ptr.release();
+
+    if (fence_ptr != nullptr)
+    {
+        release_internal(fence_ptr,
+                         in_was_submitted);
+    }
+}
+
+/** Puts a fence, which is no longer in use, on the list matching its state. */
+void Anvil::FencePool::release_internal(Anvil::Fence* in_fence_ptr,
+                                        bool          in_was_submitted)
+{
+    lock();
+    {
+        if (!in_was_submitted)
+        {
+            /* Fences are unsignalled when acquired, so one which has never been submitted can be reused as is */
+            m_available_fence_ptrs.push_back(in_fence_ptr);
+        }
+        else
+        if (in_fence_ptr->is_set() )
+        {
+            m_signalled_fence_ptrs.push_back(in_fence_ptr);
+        }
+        else
+        {
+            /* Still in flight. Cannot be reset until it gets signalled. */
+            m_pending_fence_ptrs.push_back(in_fence_ptr);
+        }
+    }
+    unlock();
+}
@@ -0,0 +1,312 @@
+//
+// Copyright (c) 2017-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "misc/buffer_ring_allocator.h"
+#include "misc/debug.h"
+#include "misc/fence_create_info.h"
+#include "misc/frame_context.h"
+#include "misc/semaphore_create_info.h"
+#include "wrappers/command_pool.h"
+#include "wrappers/device.h"
+#include "wrappers/fence.h"
+#include "wrappers/queue.h"
+#include "wrappers/semaphore.h"
+#include "wrappers/swapchain.h"
+
+
+/* Please see header for specification */
+Anvil::FrameContext::FrameContext(Anvil::BaseDevice* in_device_ptr,
+                                  uint32_t           in_n_frames_in_flight,
+                                  uint32_t           in_queue_family_index)
+    :m_acquire_wait_stages (Anvil::PipelineStageFlagBits::NONE),
+     m_device_ptr          (in_device_ptr),
+     m_frame_slots         (in_n_frames_in_flight),
+     m_frame_started       (false),
+     m_image_acquired      (false),
+     m_n_current_frame_slot(in_n_frames_in_flight - 1),
+     m_queue_family_index  (in_queue_family_index)
+{
+    /* Stub */
+}
+
+/* Please see header for specification */
+Anvil::FrameContext::~FrameContext()
+{
+    /* Fences of all slots other than the one of an unfinished frame are either signalled, or are going to be
+     * signalled by work submitted with end_frame(). Objects of a slot must not be released before that happens. */
+    for (uint32_t n_frame_slot = 0;
+                  n_frame_slot < static_cast<uint32_t>(m_frame_slots.size() );
+                ++n_frame_slot)
+    {
+        auto& frame_slot = m_frame_slots.at(n_frame_slot);
+
+        if (frame_slot.fence_ptr == nullptr ||
+            (m_frame_started && n_frame_slot == m_n_current_frame_slot) )
+        {
+            continue;
+        }
+
+        frame_slot.fence_ptr->wait();
+    }
+
+    m_frame_slots.clear();
+    m_transient_allocator_ptr.reset();
+}
+
+/* Please see header for specification */
+uint32_t Anvil::FrameContext::acquire_image(Anvil::Swapchain*         in_swapchain_ptr,
+                                            Anvil::PipelineStageFlags in_wait_stages)
+{
+    uint32_t result = UINT32_MAX;
+
+    anvil_assert(m_frame_started);
+    anvil_assert(!m_image_acquired);
+
+    result = in_swapchain_ptr->acquire_image(get_acquire_semaphore(),
+                                             false); /* in_should_block */
+
+    if (result != UINT32_MAX)
+    {
+        m_acquire_wait_stages = in_wait_stages;
+        m_image_acquired      = true;
+    }
+
+    return result;
+}
+
+/* Please see header for specification */
+bool Anvil::FrameContext::begin_frame()
+{
+    FrameSlot* frame_slot_ptr = nullptr;
+    bool       result         = false;
+
+    anvil_assert(!m_frame_started);
+
+    m_n_current_frame_slot = (m_n_current_frame_slot + 1) % static_cast<uint32_t>(m_frame_slots.size() );
+    frame_slot_ptr         = &m_frame_slots.at(m_n_current_frame_slot);
+
+    /* This is the only CPU/GPU sync point. Frames submitted for the other slots may still be executing. */
+    if (!frame_slot_ptr->fence_ptr->wait() )
+    {
+        goto end;
+    }
+
+    if (m_transient_allocator_ptr != nullptr)
+    {
+        /* The allocator has not been given any fences, so it is not going to block here. */
+        if (!m_transient_allocator_ptr->begin_frame() )
+        {
+            goto end;
+        }
+
+        anvil_assert(m_transient_allocator_ptr->get_current_frame_slot() == m_n_current_frame_slot);
+    }
+
+    if (!frame_slot_ptr->fence_ptr->reset() )
+    {
+        goto end;
+    }
+
+    if (!frame_slot_ptr->command_pool_ptr->reset(false /* in_release_resources */) )
+    {
+        goto end;
+    }
+
+    m_acquire_wait_stages = Anvil::PipelineStageFlagBits::NONE;
+    m_frame_started       = true;
+    m_image_acquired      = false;
+    result                = true;
+end:
+    return result;
+}
+
+/* Please see header for specification */
+Anvil::FrameContextUniquePtr Anvil::FrameContext::create(Anvil::BaseDevice*      in_device_ptr,
+                                                         uint32_t                in_n_frames_in_flight,
+                                                         uint32_t                in_queue_family_index,
+                                                         VkDeviceSize            in_opt_transient_allocator_size,
+                                                         Anvil::BufferUsageFlags in_transient_allocator_usage_flags)
+{
+    Anvil::FrameContextUniquePtr result_ptr(nullptr,
+                                            std::default_delete<Anvil::FrameContext>() );
+
+    anvil_assert(in_device_ptr         != nullptr);
+    anvil_assert(in_n_frames_in_flight >  0);
+
+    result_ptr.reset(
+        new Anvil::FrameContext(in_device_ptr,
+                                in_n_frames_in_flight,
+                                in_queue_family_index)
+    );
+
+    if (result_ptr != nullptr)
+    {
+        if (!result_ptr->init(in_opt_transient_allocator_size,
+                              in_transient_allocator_usage_flags) )
+        {
+            result_ptr.reset();
+        }
+    }
+
+    return result_ptr;
+}
+
+/* Please see header for specification */
+bool Anvil::FrameContext::end_frame(Anvil::Queue*                    in_queue_ptr,
+                                    uint32_t                         in_n_command_buffers,
+                                    Anvil::CommandBufferBase* const* in_opt_command_buffer_ptrs,
+                                    Anvil::Swapchain*                in_opt_swapchain_ptr,
+                                    uint32_t                         in_swapchain_image_index,
+                                    VkResult*                        out_opt_present_result_ptr)
+{
+    FrameSlot&        frame_slot            = m_frame_slots.at(m_n_current_frame_slot);
+    Anvil::Semaphore* present_semaphore_ptr = frame_slot.present_semaphore_ptr.get();
+    bool              result                = false;
+    Anvil::Semaphore* wait_semaphore_ptr    = frame_slot.acquire_semaphore_ptr.get();
+
+    anvil_assert(m_frame_started);
+    anvil_assert(in_queue_ptr->get_queue_family_index() == m_queue_family_index);
+
+    m_frame_started = false;
+
+    if (m_transient_allocator_ptr != nullptr)
+    {
+        if (!m_transient_allocator_ptr->end_frame(nullptr) ) /* in_opt_fence_ptr */
+        {
+            goto end;
+        }
+    }
+
+    /* The submission is made even if no command buffers have been specified, so that the fence and the
+     * semaphores are signalled in order with any work submitted by the app within the frame. */
+    if (!in_queue_ptr->submit(
+            Anvil::SubmitInfo::create(in_n_command_buffers,
+                                      in_opt_command_buffer_ptrs,
+                                      (in_opt_swapchain_ptr != nullptr) ? 1u : 0u,
+                                     &present_semaphore_ptr,
+                                      (m_image_acquired)              ? 1u : 0u,
+                                     &wait_semaphore_ptr,
+                                     &m_acquire_wait_stages,
+                                      false, /* in_should_block */
+                                      frame_slot.fence_ptr.get() )
+        ))
+    {
+        goto end;
+    }
+
+    m_image_acquired = false;
+
+    if (in_opt_swapchain_ptr != nullptr)
+    {
+        const VkResult present_result = in_queue_ptr->present(in_opt_swapchain_ptr,
+                                                              in_swapchain_image_index,
+                                                              1, /* in_n_wait_semaphores */
+                                                             &present_semaphore_ptr);
+
+        if (out_opt_present_result_ptr != nullptr)
+        {
+            *out_opt_present_result_ptr = present_result;
+        }
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/* Please see header for specification */
+bool Anvil::FrameContext::init(VkDeviceSize            in_opt_transient_allocator_size,
+                               Anvil::BufferUsageFlags in_transient_allocator_usage_flags)
+{
+    bool result = false;
+
+    for (auto& frame_slot : m_frame_slots)
+    {
+        {
+            auto create_info_ptr = Anvil::FenceCreateInfo::create(m_device_ptr,
+                                                                  true); /* in_create_signalled */
+
+            /* The fence is signalled, so that the first begin_frame() call for the slot does not block. */
+            frame_slot.fence_ptr = Anvil::Fence::create(std::move(create_info_ptr) );
+        }
+
+        frame_slot.acquire_semaphore_ptr = Anvil::Semaphore::create(Anvil::SemaphoreCreateInfo::create(m_device_ptr) );
+        frame_slot.present_semaphore_ptr = Anvil::Semaphore::create(Anvil::SemaphoreCreateInfo::create(m_device_ptr) );
+
+        /* Command buffers are never reset one by one. The whole pool is reset at the start of the frame, after
+         * which wrappers released by the app in the previous use of the slot are recycled. */
+        frame_slot.command_pool_ptr = Anvil::CommandPool::create(m_device_ptr,
+                                                                 true,  /* in_transient_allocations_friendly */
+                                                                 false, /* in_support_per_cmdbuf_reset_ops   */
+                                                                 m_queue_family_index,
+                                                                 Anvil::MTSafety::INHERIT_FROM_PARENT_DEVICE,
+                                                                 Anvil::CommandPool::DEFAULT_RECYCLING_CHUNK_SIZE);
+
+        if (frame_slot.acquire_semaphore_ptr == nullptr ||
+            frame_slot.command_pool_ptr      == nullptr ||
+            frame_slot.fence_ptr             == nullptr ||
+            frame_slot.present_semaphore_ptr == nullptr)
+        {
+            anvil_assert_fail();
+
+            goto end;
+        }
+    }
+
+    if (in_opt_transient_allocator_size > 0)
+    {
+        Anvil::QueueFamilyFlags queue_families;
+
+        switch (m_device_ptr->get_queue_family_type(m_queue_family_index) )
+        {
+            case Anvil::QueueFamilyType::COMPUTE:   queue_families = Anvil::QueueFamilyFlagBits::COMPUTE_BIT;  break;
+            case Anvil::QueueFamilyType::TRANSFER:  queue_families = Anvil::QueueFamilyFlagBits::DMA_BIT;      break;
+            case Anvil::QueueFamilyType::UNIVERSAL: queue_families = Anvil::QueueFamilyFlagBits::GRAPHICS_BIT; break;
+
+            default:
+            {
+                anvil_assert_fail();
+
+                goto end;
+            }
+        }
+
+        /* Frame slots of the allocator are kept in lockstep with ours. Slot fences are waited on by begin_frame(),
+         * so the allocator does not need to know about them. */
+        m_transient_allocator_ptr = Anvil::BufferRingAllocator::create(m_device_ptr,
+                                                                       in_opt_transient_allocator_size,
+                                                                       static_cast<uint32_t>(m_frame_slots.size() ),
+                                                                       in_transient_allocator_usage_flags,
+                                                                       queue_families);
+
+        if (m_transient_allocator_ptr == nullptr)
+        {
+            anvil_assert_fail();
+
+            goto end;
+        }
+    }
+
+    result = true;
+end:
+    return result;
+}
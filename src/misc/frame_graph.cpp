@@ -0,0 +1,1078 @@
+//
+// Copyright (c) 2017-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "misc/buffer_create_info.h"
+#include "misc/debug.h"
+#include "misc/frame_graph.h"
+#include "misc/image_create_info.h"
+#include "misc/memory_block_create_info.h"
+#include "wrappers/buffer.h"
+#include "wrappers/command_buffer.h"
+#include "wrappers/device.h"
+#include "wrappers/image.h"
+#include "wrappers/memory_block.h"
+#include <algorithm>
+
+
+/** Tells which buffer usage flags a buffer needs to support the specified usage.
+ *
+ *  @return true if the usage is applicable to buffers, false otherwise.
+ **/
+static bool get_buffer_usage_flags(Anvil::ResourceStateTracker::Usage in_usage,
+                                   Anvil::BufferUsageFlags*           out_flags_ptr)
+{
+    bool result = true;
+
+    switch (in_usage)
+    {
+        case Anvil::ResourceStateTracker::Usage::HOST_READ:              *out_flags_ptr = Anvil::BufferUsageFlagBits::NONE;                     break;
+        case Anvil::ResourceStateTracker::Usage::INDEX_BUFFER:           *out_flags_ptr = Anvil::BufferUsageFlagBits::INDEX_BUFFER_BIT;         break;
+        case Anvil::ResourceStateTracker::Usage::INDIRECT_BUFFER:        *out_flags_ptr = Anvil::BufferUsageFlagBits::INDIRECT_BUFFER_BIT;      break;
+        case Anvil::ResourceStateTracker::Usage::SAMPLED_COMPUTE:        /* Fall-through */
+        case Anvil::ResourceStateTracker::Usage::SAMPLED_FRAGMENT:       /* Fall-through */
+        case Anvil::ResourceStateTracker::Usage::SAMPLED_VERTEX:         *out_flags_ptr = Anvil::BufferUsageFlagBits::UNIFORM_TEXEL_BUFFER_BIT; break;
+        case Anvil::ResourceStateTracker::Usage::STORAGE_READ_COMPUTE:   /* Fall-through */
+        case Anvil::ResourceStateTracker::Usage::STORAGE_READ_FRAGMENT:  /* Fall-through */
+        case Anvil::ResourceStateTracker::Usage::STORAGE_WRITE_COMPUTE:  /* Fall-through */
+        case Anvil::ResourceStateTracker::Usage::STORAGE_WRITE_FRAGMENT: *out_flags_ptr = Anvil::BufferUsageFlagBits::STORAGE_BUFFER_BIT;       break;
+        case Anvil::ResourceStateTracker::Usage::TRANSFER_DST:           *out_flags_ptr = Anvil::BufferUsageFlagBits::TRANSFER_DST_BIT;         break;
+        case Anvil::ResourceStateTracker::Usage::TRANSFER_SRC:           *out_flags_ptr = Anvil::BufferUsageFlagBits::TRANSFER_SRC_BIT;         break;
+        case Anvil::ResourceStateTracker::Usage::UNIFORM_BUFFER:         *out_flags_ptr = Anvil::BufferUsageFlagBits::UNIFORM_BUFFER_BIT;       break;
+        case Anvil::ResourceStateTracker::Usage::VERTEX_BUFFER:          *out_flags_ptr = Anvil::BufferUsageFlagBits::VERTEX_BUFFER_BIT;        break;
+
+        default:
+        {
+            result = false;
+        }
+    }
+
+    return result;
+}
+
+/** Tells which image usage flags an image needs to support the specified usage.
+ *
+ *  @return true if the usage is applicable to images, false otherwise.
+ **/
+static bool get_image_usage_flags(Anvil::ResourceStateTracker::Usage in_usage,
+                                  Anvil::ImageUsageFlags*            out_flags_ptr)
+{
+    bool result = true;
+
+    switch (in_usage)
+    {
+        case Anvil::ResourceStateTracker::Usage::COLOR_ATTACHMENT:         *out_flags_ptr = Anvil::ImageUsageFlagBits::COLOR_ATTACHMENT_BIT;         break;
+        case Anvil::ResourceStateTracker::Usage::DEPTH_STENCIL_ATTACHMENT: *out_flags_ptr = Anvil::ImageUsageFlagBits::DEPTH_STENCIL_ATTACHMENT_BIT; break;
+        case Anvil::ResourceStateTracker::Usage::HOST_READ:                /* Fall-through */
+        case Anvil::ResourceStateTracker::Usage::PRESENT:                  *out_flags_ptr = Anvil::ImageUsageFlagBits::NONE;                         break;
+        case Anvil::ResourceStateTracker::Usage::SAMPLED_COMPUTE:          /* Fall-through */
+        case Anvil::ResourceStateTracker::Usage::SAMPLED_FRAGMENT:         /* Fall-through */
+        case Anvil::ResourceStateTracker::Usage::SAMPLED_VERTEX:           *out_flags_ptr = Anvil::ImageUsageFlagBits::SAMPLED_BIT;                  break;
+        case Anvil::ResourceStateTracker::Usage::STORAGE_READ_COMPUTE:     /* Fall-through */
+        case Anvil::ResourceStateTracker::Usage::STORAGE_READ_FRAGMENT:    /* Fall-through */
+        case Anvil::ResourceStateTracker::Usage::STORAGE_WRITE_COMPUTE:    /* Fall-through */
+        case Anvil::ResourceStateTracker::Usage::STORAGE_WRITE_FRAGMENT:   *out_flags_ptr = Anvil::ImageUsageFlagBits::STORAGE_BIT;                  break;
+        case Anvil::ResourceStateTracker::Usage::TRANSFER_DST:             *out_flags_ptr = Anvil::ImageUsageFlagBits::TRANSFER_DST_BIT;             break;
+        case Anvil::ResourceStateTracker::Usage::TRANSFER_SRC:             *out_flags_ptr = Anvil::ImageUsageFlagBits::TRANSFER_SRC_BIT;             break;
+
+        case Anvil::ResourceStateTracker::Usage::DEPTH_STENCIL_READ_ONLY:
+        {
+            /* Read-only depth/stencil attachments are also sampled by fragment shaders */
+            *out_flags_ptr = Anvil::ImageUsageFlagBits::DEPTH_STENCIL_ATTACHMENT_BIT | Anvil::ImageUsageFlagBits::SAMPLED_BIT;
+
+            break;
+        }
+
+        default:
+        {
+            result = false;
+        }
+    }
+
+    return result;
+}
+
+
+/* Please see header for specification */
+Anvil::FrameGraph::FrameGraph(const Anvil::BaseDevice* in_device_ptr,
+                              Anvil::QueueFamilyFlags  in_queue_families)
+    :m_compiled                              (false),
+     m_device_ptr                            (in_device_ptr),
+     m_n_culled_passes                       (0),
+     m_queue_families                        (in_queue_families),
+     m_tracker_ptr                           (Anvil::ResourceStateTracker::create() ),
+     m_transient_memory_size                 (0),
+     m_transient_memory_size_without_aliasing(0)
+{
+    /* Stub */
+}
+
+/* Please see header for specification */
+Anvil::FrameGraph::~FrameGraph()
+{
+    release_transient_resources();
+}
+
+/* Please see header for specification */
+Anvil::FrameGraph::PassID Anvil::FrameGraph::add_pass(const std::string& in_name,
+                                                      RecordCallback     in_callback)
+{
+    anvil_assert(!m_compiled);
+    anvil_assert(in_callback != nullptr);
+
+    m_passes.push_back(
+        Pass(in_name,
+             in_callback)
+    );
+
+    return static_cast<PassID>(m_passes.size() - 1);
+}
+
+/* Please see header for specification */
+bool Anvil::FrameGraph::add_resource_usage(PassID                             in_pass_id,
+                                           ResourceID                         in_resource_id,
+                                           Anvil::ResourceStateTracker::Usage in_usage)
+{
+    Anvil::BufferUsageFlags buffer_usage_flags;
+    Anvil::ImageUsageFlags  image_usage_flags;
+    bool                    is_applicable;
+    bool                    result         = false;
+    const Resource*         resource_ptr   = nullptr;
+
+    if (m_compiled)
+    {
+        anvil_assert(!m_compiled);
+
+        goto end;
+    }
+
+    if (in_pass_id     >= m_passes.size()    ||
+        in_resource_id >= m_resources.size() )
+    {
+        anvil_assert(in_pass_id     < m_passes.size   () );
+        anvil_assert(in_resource_id < m_resources.size() );
+
+        goto end;
+    }
+
+    resource_ptr  = &m_resources.at(in_resource_id);
+    is_applicable = (resource_ptr->is_image) ? get_image_usage_flags (in_usage, &image_usage_flags)
+                                             : get_buffer_usage_flags(in_usage, &buffer_usage_flags);
+
+    if (!is_applicable)
+    {
+        anvil_assert(is_applicable);
+
+        goto end;
+    }
+
+    /* Transient resources live in device-local memory and never leave the graph */
+    if (!resource_ptr->is_imported                                      &&
+        (in_usage == Anvil::ResourceStateTracker::Usage::HOST_READ ||
+         in_usage == Anvil::ResourceStateTracker::Usage::PRESENT)        )
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    m_passes.at(in_pass_id).usages.push_back(
+        PassUsage(in_resource_id,
+                  in_usage)
+    );
+
+    result = true;
+end:
+    return result;
+}
+
+/* Please see header for specification */
+Anvil::FrameGraph::ResourceID Anvil::FrameGraph::add_transient_buffer(VkDeviceSize in_size)
+{
+    Resource new_resource;
+
+    anvil_assert(!m_compiled);
+    anvil_assert(in_size > 0);
+
+    new_resource.buffer_size = in_size;
+
+    m_resources.push_back(new_resource);
+
+    return static_cast<ResourceID>(m_resources.size() - 1);
+}
+
+/* Please see header for specification */
+Anvil::FrameGraph::ResourceID Anvil::FrameGraph::add_transient_image(Anvil::ImageType           in_type,
+                                                                     Anvil::Format              in_format,
+                                                                     uint32_t                   in_width,
+                                                                     uint32_t                   in_height,
+                                                                     uint32_t                   in_depth,
+                                                                     uint32_t                   in_n_layers,
+                                                                     Anvil::SampleCountFlagBits in_sample_count,
+                                                                     bool                       in_use_full_mipmap_chain)
+{
+    Resource new_resource;
+
+    anvil_assert(!m_compiled);
+
+    new_resource.is_image                    = true;
+    new_resource.image_format                = in_format;
+    new_resource.image_n_layers              = in_n_layers;
+    new_resource.image_sample_count          = in_sample_count;
+    new_resource.image_size[0]               = in_width;
+    new_resource.image_size[1]               = in_height;
+    new_resource.image_size[2]               = in_depth;
+    new_resource.image_type                  = in_type;
+    new_resource.image_use_full_mipmap_chain = in_use_full_mipmap_chain;
+
+    m_resources.push_back(new_resource);
+
+    return static_cast<ResourceID>(m_resources.size() - 1);
+}
+
+/** Places transient resources in memory and binds them to it.
+ *
+ *  Resources are grouped by kind (images vs buffers, which sidesteps bufferImageGranularity) and by the memory types
+ *  they support. Within each group, resources are placed largest-first, each at the lowest offset at which it does
+ *  not overlap any already placed resource whose lifetime overlaps its own. One memory block is then allocated
+ *  per group.
+ *
+ *  @return true if successful, false otherwise.
+ **/
+bool Anvil::FrameGraph::alias_transient_resources()
+{
+    typedef struct MemoryGroup
+    {
+        bool                    is_image;
+        uint32_t                memory_type_bits;
+        std::vector<ResourceID> resource_ids;
+        VkDeviceSize            size;
+    } MemoryGroup;
+
+    std::vector<MemoryGroup> groups;
+    bool                     result = true;
+
+    /* Group the resources */
+    for (ResourceID n_resource = 0;
+                    n_resource < static_cast<ResourceID>(m_resources.size() );
+                  ++n_resource)
+    {
+        auto&                      current_resource = m_resources.at(n_resource);
+        MemoryGroup*               group_ptr        = nullptr;
+        const VkMemoryRequirements memory_reqs      = (current_resource.image_ptr != nullptr) ? current_resource.image_ptr->get_memory_requirements ()
+                                                                                              : current_resource.buffer_ptr->get_memory_requirements();
+
+        if (current_resource.is_imported                      ||
+            current_resource.first_pass_index == UINT32_MAX)
+        {
+            continue;
+        }
+
+        for (auto& current_group : groups)
+        {
+            if (current_group.is_image         == current_resource.is_image &&
+                current_group.memory_type_bits == memory_reqs.memoryTypeBits)
+            {
+                group_ptr = &current_group;
+
+                break;
+            }
+        }
+
+        if (group_ptr == nullptr)
+        {
+            MemoryGroup new_group;
+
+            new_group.is_image         = current_resource.is_image;
+            new_group.memory_type_bits = memory_reqs.memoryTypeBits;
+            new_group.size             = 0;
+
+            groups.push_back(new_group);
+
+            group_ptr = &groups.back();
+        }
+
+        current_resource.memory_size = memory_reqs.size;
+
+        group_ptr->resource_ids.push_back(n_resource);
+
+        m_transient_memory_size_without_aliasing += memory_reqs.size;
+    }
+
+    /* Place the resources */
+    for (uint32_t n_group = 0;
+                  n_group < static_cast<uint32_t>(groups.size() );
+                ++n_group)
+    {
+        auto&                   current_group = groups.at(n_group);
+        std::vector<ResourceID> placed_resource_ids;
+
+        std::stable_sort(current_group.resource_ids.begin(),
+                         current_group.resource_ids.end  (),
+                         [this](ResourceID in_resource_a_id,
+                                ResourceID in_resource_b_id)
+                         {
+                             return m_resources.at(in_resource_a_id).memory_size > m_resources.at(in_resource_b_id).memory_size;
+                         });
+
+        for (const auto current_resource_id : current_group.resource_ids)
+        {
+            auto&              current_resource = m_resources.at(current_resource_id);
+            const VkDeviceSize alignment        = (current_resource.image_ptr != nullptr) ? current_resource.image_ptr->get_memory_requirements ().alignment
+                                                                                          : current_resource.buffer_ptr->get_memory_requirements().alignment;
+            VkDeviceSize       offset           = 0;
+            bool               offset_changed   = true;
+
+            /* Bump the offset past every conflicting resource until none is left. Each iteration moves the offset
+             * strictly forward, so this terminates. */
+            while (offset_changed)
+            {
+                offset_changed = false;
+
+                for (const auto placed_resource_id : placed_resource_ids)
+                {
+                    const auto& placed_resource = m_resources.at(placed_resource_id);
+
+                    if (placed_resource.first_pass_index > current_resource.last_pass_index ||
+                        placed_resource.last_pass_index  < current_resource.first_pass_index)
+                    {
+                        /* Lifetimes do not overlap */
+                        continue;
+                    }
+
+                    if (placed_resource.memory_offset                              >= offset + current_resource.memory_size ||
+                        placed_resource.memory_offset + placed_resource.memory_size <= offset)
+                    {
+                        /* Memory ranges do not overlap */
+                        continue;
+                    }
+
+                    offset         = Anvil::Utils::round_up(placed_resource.memory_offset + placed_resource.memory_size,
+                                                            alignment);
+                    offset_changed = true;
+                }
+            }
+
+            current_resource.memory_offset  = offset;
+            current_resource.n_memory_group = n_group;
+
+            current_group.size = std::max(current_group.size,
+                                          offset + current_resource.memory_size);
+
+            placed_resource_ids.push_back(current_resource_id);
+        }
+
+        /* A resource may share memory with resources used earlier in the frame, as well as with ones used later
+         * in the previous frame. Its first use needs to wait for all of them. */
+        for (const auto current_resource_id : current_group.resource_ids)
+        {
+            auto& current_resource = m_resources.at(current_resource_id);
+
+            for (const auto other_resource_id : current_group.resource_ids)
+            {
+                const auto& other_resource = m_resources.at(other_resource_id);
+
+                if (other_resource.memory_offset                             >= current_resource.memory_offset + current_resource.memory_size ||
+                    other_resource.memory_offset + other_resource.memory_size <= current_resource.memory_offset)
+                {
+                    continue;
+                }
+
+                current_resource.alias_src_access |= other_resource.lifetime_access;
+                current_resource.alias_src_stages |= other_resource.lifetime_stages;
+            }
+        }
+
+        m_transient_memory_size += current_group.size;
+    }
+
+    /* Allocate memory and bind the resources */
+    for (const auto& current_group : groups)
+    {
+        Anvil::MemoryBlockUniquePtr memory_block_ptr;
+
+        {
+            auto create_info_ptr = Anvil::MemoryBlockCreateInfo::create_regular(m_device_ptr,
+                                                                                current_group.memory_type_bits,
+                                                                                current_group.size,
+                                                                                Anvil::MemoryFeatureFlagBits::DEVICE_LOCAL_BIT);
+
+            create_info_ptr->set_mt_safety(Anvil::Utils::convert_boolean_to_mt_safety_enum(m_device_ptr->is_mt_safe()) );
+
+            memory_block_ptr = Anvil::MemoryBlock::create(std::move(create_info_ptr) );
+        }
+
+        if (memory_block_ptr == nullptr)
+        {
+            anvil_assert(memory_block_ptr != nullptr);
+
+            result = false;
+            goto end;
+        }
+
+        for (const auto current_resource_id : current_group.resource_ids)
+        {
+            const auto& current_resource = m_resources.at(current_resource_id);
+            bool        bind_result;
+
+            auto derived_create_info_ptr = Anvil::MemoryBlockCreateInfo::create_derived(memory_block_ptr.get(),
+                                                                                        current_resource.memory_offset,
+                                                                                        current_resource.memory_size);
+            auto derived_block_ptr       = Anvil::MemoryBlock::create(std::move(derived_create_info_ptr) );
+
+            if (derived_block_ptr == nullptr)
+            {
+                anvil_assert(derived_block_ptr != nullptr);
+
+                result = false;
+                goto end;
+            }
+
+            bind_result = (current_resource.image_ptr != nullptr) ? current_resource.image_ptr->set_memory           (std::move(derived_block_ptr) )
+                                                                  : current_resource.buffer_ptr->set_nonsparse_memory(std::move(derived_block_ptr) );
+
+            if (!bind_result)
+            {
+                anvil_assert(bind_result);
+
+                result = false;
+                goto end;
+            }
+        }
+
+        m_memory_blocks.push_back(
+            std::move(memory_block_ptr)
+        );
+    }
+
+end:
+    return result;
+}
+
+/* Please see header for specification */
+bool Anvil::FrameGraph::compile()
+{
+    bool result = false;
+
+    if (m_compiled)
+    {
+        anvil_assert(!m_compiled);
+
+        goto end;
+    }
+
+    cull_passes ();
+    order_passes();
+
+    /* Work out resource lifetimes, in terms of indices into the pass order */
+    for (uint32_t n_pass = 0;
+                  n_pass < static_cast<uint32_t>(m_pass_order.size() );
+                ++n_pass)
+    {
+        for (const auto& current_usage : m_passes.at(m_pass_order.at(n_pass) ).usages)
+        {
+            auto&      current_resource = m_resources.at(current_usage.resource_id);
+            const auto usage_info       = Anvil::ResourceStateTracker::get_usage_info(current_usage.usage);
+
+            if (current_resource.first_pass_index == UINT32_MAX)
+            {
+                current_resource.first_pass_index = n_pass;
+            }
+
+            current_resource.last_pass_index  = n_pass;
+            current_resource.lifetime_stages |= usage_info.stages;
+
+            if (usage_info.is_write)
+            {
+                current_resource.lifetime_access |= usage_info.access;
+            }
+        }
+    }
+
+    if (!create_transient_resources() ||
+        !alias_transient_resources () )
+    {
+        release_transient_resources();
+
+        goto end;
+    }
+
+    m_compiled = true;
+    result     = true;
+end:
+    return result;
+}
+
+/** Marks passes which contribute to the graph's outputs as alive, and counts the ones which do not.
+ *
+ *  Passes are visited in reverse declaration order. A pass is alive if it writes a resource which is needed at that
+ *  point, in which case all resources it reads become needed too.
+ **/
+void Anvil::FrameGraph::cull_passes()
+{
+    std::vector<bool> is_resource_needed(m_resources.size(),
+                                         false);
+
+    for (uint32_t n_resource = 0;
+                  n_resource < static_cast<uint32_t>(m_resources.size() );
+                ++n_resource)
+    {
+        is_resource_needed.at(n_resource) = (m_resources.at(n_resource).is_imported ||
+                                             m_resources.at(n_resource).is_output);
+    }
+
+    m_n_culled_passes = 0;
+
+    for (auto pass_iterator  = m_passes.rbegin();
+              pass_iterator != m_passes.rend();
+            ++pass_iterator)
+    {
+        pass_iterator->is_alive = pass_iterator->usages.empty();
+
+        for (const auto& current_usage : pass_iterator->usages)
+        {
+            if (Anvil::ResourceStateTracker::get_usage_info(current_usage.usage).is_write &&
+                is_resource_needed.at(current_usage.resource_id) )
+            {
+                pass_iterator->is_alive = true;
+
+                break;
+            }
+        }
+
+        if (!pass_iterator->is_alive)
+        {
+            ++m_n_culled_passes;
+
+            continue;
+        }
+
+        for (const auto& current_usage : pass_iterator->usages)
+        {
+            if (!Anvil::ResourceStateTracker::get_usage_info(current_usage.usage).is_write)
+            {
+                is_resource_needed.at(current_usage.resource_id) = true;
+            }
+        }
+    }
+}
+
+/** Creates images and buffers for all transient resources used by at least one alive pass. Memory is bound to them
+ *  by alias_transient_resources().
+ *
+ *  @return true if successful, false otherwise.
+ **/
+bool Anvil::FrameGraph::create_transient_resources()
+{
+    bool result = true;
+
+    for (ResourceID n_resource = 0;
+                    n_resource < static_cast<ResourceID>(m_resources.size() );
+                  ++n_resource)
+    {
+        auto&                   current_resource = m_resources.at(n_resource);
+        Anvil::BufferUsageFlags buffer_usage_flags;
+        Anvil::ImageUsageFlags  image_usage_flags;
+
+        if (current_resource.is_imported                      ||
+            current_resource.first_pass_index == UINT32_MAX)
+        {
+            continue;
+        }
+
+        for (const auto current_pass_id : m_pass_order)
+        {
+            for (const auto& current_usage : m_passes.at(current_pass_id).usages)
+            {
+                Anvil::BufferUsageFlags usage_buffer_usage_flags;
+                Anvil::ImageUsageFlags  usage_image_usage_flags;
+
+                if (current_usage.resource_id != n_resource)
+                {
+                    continue;
+                }
+
+                if (current_resource.is_image)
+                {
+                    get_image_usage_flags(current_usage.usage,
+                                         &usage_image_usage_flags);
+
+                    image_usage_flags |= usage_image_usage_flags;
+                }
+                else
+                {
+                    get_buffer_usage_flags(current_usage.usage,
+                                          &usage_buffer_usage_flags);
+
+                    buffer_usage_flags |= usage_buffer_usage_flags;
+                }
+            }
+        }
+
+        if (current_resource.is_image)
+        {
+            auto create_info_ptr = Anvil::ImageCreateInfo::create_no_alloc(m_device_ptr,
+                                                                           current_resource.image_type,
+                                                                           current_resource.image_format,
+                                                                           Anvil::ImageTiling::OPTIMAL,
+                                                                           image_usage_flags,
+                                                                           current_resource.image_size[0],
+                                                                           current_resource.image_size[1],
+                                                                           current_resource.image_size[2],
+                                                                           current_resource.image_n_layers,
+                                                                           current_resource.image_sample_count,
+                                                                           m_queue_families,
+                                                                           Anvil::SharingMode::EXCLUSIVE,
+                                                                           current_resource.image_use_full_mipmap_chain,
+                                                                           Anvil::ImageCreateFlagBits::NONE);
+
+            create_info_ptr->set_mt_safety(Anvil::Utils::convert_boolean_to_mt_safety_enum(m_device_ptr->is_mt_safe()) );
+
+            m_transient_images.push_back(
+                Anvil::Image::create(std::move(create_info_ptr) )
+            );
+
+            current_resource.image_ptr = m_transient_images.back().get();
+        }
+        else
+        {
+            auto create_info_ptr = Anvil::BufferCreateInfo::create_no_alloc(m_device_ptr,
+                                                                            current_resource.buffer_size,
+                                                                            m_queue_families,
+                                                                            Anvil::SharingMode::EXCLUSIVE,
+                                                                            Anvil::BufferCreateFlagBits::NONE,
+                                                                            buffer_usage_flags);
+
+            create_info_ptr->set_mt_safety(Anvil::Utils::convert_boolean_to_mt_safety_enum(m_device_ptr->is_mt_safe()) );
+
+            m_transient_buffers.push_back(
+                Anvil::Buffer::create(std::move(create_info_ptr) )
+            );
+
+            current_resource.buffer_ptr = m_transient_buffers.back().get();
+        }
+
+        if (current_resource.buffer_ptr == nullptr &&
+            current_resource.image_ptr  == nullptr)
+        {
+            anvil_assert_fail();
+
+            result = false;
+            goto end;
+        }
+    }
+
+end:
+    return result;
+}
+
+/* Please see header for specification */
+Anvil::FrameGraphUniquePtr Anvil::FrameGraph::create(const Anvil::BaseDevice* in_device_ptr,
+                                                     Anvil::QueueFamilyFlags  in_queue_families)
+{
+    Anvil::FrameGraphUniquePtr result_ptr(nullptr,
+                                          std::default_delete<Anvil::FrameGraph>() );
+
+    result_ptr.reset(
+        new Anvil::FrameGraph(in_device_ptr,
+                              in_queue_families)
+    );
+
+    return result_ptr;
+}
+
+/* Please see header for specification */
+bool Anvil::FrameGraph::execute(Anvil::CommandBufferBase* in_command_buffer_ptr)
+{
+    const bool was_batching_enabled = in_command_buffer_ptr->is_barrier_batching_enabled();
+    bool       result               = true;
+
+    if (!m_compiled)
+    {
+        anvil_assert(m_compiled);
+
+        return false;
+    }
+
+    if (!was_batching_enabled)
+    {
+        in_command_buffer_ptr->set_barrier_batching(true);
+    }
+
+    for (uint32_t n_pass = 0;
+                  n_pass < static_cast<uint32_t>(m_pass_order.size() );
+                ++n_pass)
+    {
+        const auto& current_pass = m_passes.at(m_pass_order.at(n_pass) );
+
+        for (uint32_t n_usage = 0;
+                      n_usage < static_cast<uint32_t>(current_pass.usages.size() );
+                    ++n_usage)
+        {
+            const auto& current_usage    = current_pass.usages.at(n_usage);
+            const auto& current_resource = m_resources.at(current_usage.resource_id);
+
+            if (!current_resource.is_imported                  &&
+                 current_resource.first_pass_index == n_pass)
+            {
+                bool is_first_usage_in_pass = true;
+
+                for (uint32_t n_prev_usage = 0;
+                              n_prev_usage < n_usage;
+                            ++n_prev_usage)
+                {
+                    if (current_pass.usages.at(n_prev_usage).resource_id == current_usage.resource_id)
+                    {
+                        is_first_usage_in_pass = false;
+
+                        break;
+                    }
+                }
+
+                if (is_first_usage_in_pass)
+                {
+                    result &= record_alias_barrier(in_command_buffer_ptr,
+                                                   n_pass,
+                                                   current_usage.resource_id);
+                }
+            }
+
+            if (current_resource.is_image)
+            {
+                result &= m_tracker_ptr->use_image(in_command_buffer_ptr,
+                                                   current_resource.image_ptr,
+                                                   current_usage.usage);
+            }
+            else
+            {
+                result &= m_tracker_ptr->use_buffer(in_command_buffer_ptr,
+                                                    current_resource.buffer_ptr,
+                                                    current_usage.usage);
+            }
+        }
+
+        in_command_buffer_ptr->flush_deferred_barriers();
+
+        current_pass.callback(in_command_buffer_ptr,
+                              this);
+    }
+
+    if (!was_batching_enabled)
+    {
+        in_command_buffer_ptr->set_barrier_batching(false);
+    }
+
+    return result;
+}
+
+/* Please see header for specification */
+Anvil::Buffer* Anvil::FrameGraph::get_buffer(ResourceID in_resource_id) const
+{
+    anvil_assert(in_resource_id < m_resources.size() );
+
+    return m_resources.at(in_resource_id).buffer_ptr;
+}
+
+/* Please see header for specification */
+Anvil::Image* Anvil::FrameGraph::get_image(ResourceID in_resource_id) const
+{
+    anvil_assert(in_resource_id < m_resources.size() );
+
+    return m_resources.at(in_resource_id).image_ptr;
+}
+
+/* Please see header for specification */
+Anvil::FrameGraph::ResourceID Anvil::FrameGraph::import_buffer(Anvil::Buffer* in_buffer_ptr)
+{
+    Resource new_resource;
+
+    anvil_assert(!m_compiled);
+    anvil_assert(in_buffer_ptr != nullptr);
+
+    new_resource.buffer_ptr  = in_buffer_ptr;
+    new_resource.buffer_size = in_buffer_ptr->get_create_info_ptr()->get_size();
+    new_resource.is_imported = true;
+
+    m_resources.push_back(new_resource);
+
+    return static_cast<ResourceID>(m_resources.size() - 1);
+}
+
+/* Please see header for specification */
+Anvil::FrameGraph::ResourceID Anvil::FrameGraph::import_image(Anvil::Image* in_image_ptr)
+{
+    Resource new_resource;
+
+    anvil_assert(!m_compiled);
+    anvil_assert(in_image_ptr != nullptr);
+
+    new_resource.image_ptr   = in_image_ptr;
+    new_resource.is_image    = true;
+    new_resource.is_imported = true;
+
+    m_resources.push_back(new_resource);
+
+    return static_cast<ResourceID>(m_resources.size() - 1);
+}
+
+/* Please see header for specification */
+void Anvil::FrameGraph::mark_as_output(ResourceID in_resource_id)
+{
+    anvil_assert(!m_compiled);
+    anvil_assert(in_resource_id < m_resources.size() );
+
+    m_resources.at(in_resource_id).is_output = true;
+}
+
+/** Sorts alive passes topologically and stores the result in m_pass_order.
+ *
+ *  A pass depends on the last pass which has written each resource it accesses. Passes which write a resource
+ *  also depend on all passes which have read it since. Among the passes whose dependencies have all been scheduled,
+ *  the one whose most recently scheduled producer comes last is picked first, so that intermediate results are
+ *  consumed soon after they are produced. Ties are broken by declaration order.
+ **/
+void Anvil::FrameGraph::order_passes()
+{
+    std::vector<std::vector<PassID> > dependencies        (m_passes.size() );
+    std::vector<std::vector<PassID> > readers_since_write (m_resources.size() );
+    std::vector<PassID>               last_writer         (m_resources.size(),
+                                                           UINT32_MAX);
+    std::vector<bool>                 is_scheduled        (m_passes.size(),
+                                                           false);
+    std::vector<uint32_t>             scheduled_pass_index(m_passes.size(),
+                                                           UINT32_MAX);
+    uint32_t                          n_alive_passes      = 0;
+
+    const auto add_dependency = [&dependencies](PassID in_pass_id,
+                                                PassID in_dependency_pass_id)
+    {
+        auto& pass_dependencies = dependencies.at(in_pass_id);
+
+        if (in_dependency_pass_id != UINT32_MAX                                                                &&
+            in_dependency_pass_id != in_pass_id                                                                &&
+            std::find(pass_dependencies.begin(), pass_dependencies.end(), in_dependency_pass_id) == pass_dependencies.end() )
+        {
+            pass_dependencies.push_back(in_dependency_pass_id);
+        }
+    };
+
+    /* Build the dependency lists */
+    for (PassID n_pass = 0;
+                n_pass < static_cast<PassID>(m_passes.size() );
+              ++n_pass)
+    {
+        const auto& current_pass = m_passes.at(n_pass);
+
+        if (!current_pass.is_alive)
+        {
+            continue;
+        }
+
+        ++n_alive_passes;
+
+        for (const auto& current_usage : current_pass.usages)
+        {
+            const ResourceID resource_id = current_usage.resource_id;
+
+            add_dependency(n_pass,
+                           last_writer.at(resource_id) );
+
+            if (Anvil::ResourceStateTracker::get_usage_info(current_usage.usage).is_write)
+            {
+                for (const auto reader_pass_id : readers_since_write.at(resource_id) )
+                {
+                    add_dependency(n_pass,
+                                   reader_pass_id);
+                }
+
+                last_writer.at        (resource_id) = n_pass;
+                readers_since_write.at(resource_id).clear();
+            }
+            else
+            {
+                readers_since_write.at(resource_id).push_back(n_pass);
+            }
+        }
+    }
+
+    /* Schedule the passes */
+    m_pass_order.clear();
+
+    while (m_pass_order.size() < n_alive_passes)
+    {
+        PassID  best_pass_id       = UINT32_MAX;
+        int64_t best_pass_priority = -2;
+
+        for (PassID n_pass = 0;
+                    n_pass < static_cast<PassID>(m_passes.size() );
+                  ++n_pass)
+        {
+            bool    is_ready = true;
+            int64_t priority = -1;
+
+            if (!m_passes.at(n_pass).is_alive ||
+                 is_scheduled.at(n_pass))
+            {
+                continue;
+            }
+
+            for (const auto dependency_pass_id : dependencies.at(n_pass) )
+            {
+                if (!is_scheduled.at(dependency_pass_id) )
+                {
+                    is_ready = false;
+
+                    break;
+                }
+
+                priority = std::max(priority,
+                                    static_cast<int64_t>(scheduled_pass_index.at(dependency_pass_id) ));
+            }
+
+            if (is_ready                        &&
+                priority > best_pass_priority)
+            {
+                best_pass_id       = n_pass;
+                best_pass_priority = priority;
+            }
+        }
+
+        /* Dependencies always point backward in declaration order, so there is always a ready pass */
+        anvil_assert(best_pass_id != UINT32_MAX);
+
+        is_scheduled.at        (best_pass_id) = true;
+        scheduled_pass_index.at(best_pass_id) = static_cast<uint32_t>(m_pass_order.size() );
+
+        m_pass_order.push_back(best_pass_id);
+    }
+}
+
+/** Records a barrier which starts the lifetime of a transient resource in the specified pass.
+ *
+ *  The barrier waits for all accesses to resources sharing the resource's memory, and discards the resource's
+ *  contents. Images are transitioned from UNDEFINED to the layout required by the first usage. The tracker is then
+ *  told the resource has no pending accesses.
+ *
+ *  @return true if successful, false otherwise.
+ **/
+bool Anvil::FrameGraph::record_alias_barrier(Anvil::CommandBufferBase* in_command_buffer_ptr,
+                                             uint32_t                  in_n_pass,
+                                             ResourceID                in_resource_id)
+{
+    const auto&          current_pass     = m_passes.at(m_pass_order.at(in_n_pass) );
+    const auto&          current_resource = m_resources.at(in_resource_id);
+    VkAccessFlags        dst_access       = 0;
+    VkImageLayout        dst_layout       = VK_IMAGE_LAYOUT_MAX_ENUM;
+    VkPipelineStageFlags dst_stages       = 0;
+    bool                 result;
+    const auto           src_access       = Anvil::AccessFlags(static_cast<Anvil::AccessFlagBits>(current_resource.alias_src_access) );
+    const auto           src_stages       = (current_resource.alias_src_stages != 0) ? Anvil::PipelineStageFlags(static_cast<Anvil::PipelineStageFlagBits>(current_resource.alias_src_stages) )
+                                                                                     : Anvil::PipelineStageFlags(Anvil::PipelineStageFlagBits::TOP_OF_PIPE_BIT);
+
+    for (const auto& current_usage : current_pass.usages)
+    {
+        if (current_usage.resource_id == in_resource_id)
+        {
+            const auto usage_info = Anvil::ResourceStateTracker::get_usage_info(current_usage.usage);
+
+            dst_access |= usage_info.access;
+            dst_stages |= usage_info.stages;
+
+            if (dst_layout == VK_IMAGE_LAYOUT_MAX_ENUM)
+            {
+                dst_layout = usage_info.layout;
+            }
+        }
+    }
+
+    if (current_resource.is_image)
+    {
+        const Anvil::ImageBarrier image_barrier(src_access,
+                                                Anvil::AccessFlags(static_cast<Anvil::AccessFlagBits>(dst_access) ),
+                                                Anvil::ImageLayout::UNDEFINED,
+                                                static_cast<Anvil::ImageLayout>(dst_layout),
+                                                VK_QUEUE_FAMILY_IGNORED,
+                                                VK_QUEUE_FAMILY_IGNORED,
+                                                current_resource.image_ptr,
+                                                current_resource.image_ptr->get_subresource_range() );
+
+        result = in_command_buffer_ptr->record_pipeline_barrier(src_stages,
+                                                                Anvil::PipelineStageFlags(static_cast<Anvil::PipelineStageFlagBits>(dst_stages) ),
+                                                                Anvil::DependencyFlags(),
+                                                                0,       /* in_memory_barrier_count        */
+                                                                nullptr, /* in_memory_barriers_ptr         */
+                                                                0,       /* in_buffer_memory_barrier_count */
+                                                                nullptr, /* in_buffer_memory_barriers_ptr  */
+                                                                1,       /* in_image_memory_barrier_count  */
+                                                               &image_barrier);
+
+        m_tracker_ptr->set_image_layout(current_resource.image_ptr,
+                                        static_cast<Anvil::ImageLayout>(dst_layout) );
+    }
+    else
+    {
+        const Anvil::MemoryBarrier memory_barrier(Anvil::AccessFlags(static_cast<Anvil::AccessFlagBits>(dst_access) ),
+                                                  src_access);
+
+        result = in_command_buffer_ptr->record_pipeline_barrier(src_stages,
+                                                                Anvil::PipelineStageFlags(static_cast<Anvil::PipelineStageFlagBits>(dst_stages) ),
+                                                                Anvil::DependencyFlags(),
+                                                                1,        /* in_memory_barrier_count        */
+                                                               &memory_barrier,
+                                                                0,        /* in_buffer_memory_barrier_count */
+                                                                nullptr,  /* in_buffer_memory_barriers_ptr  */
+                                                                0,        /* in_image_memory_barrier_count  */
+                                                                nullptr); /* in_image_memory_barriers_ptr   */
+
+        m_tracker_ptr->forget_buffer(current_resource.buffer_ptr);
+    }
+
+    return result;
+}
+
+/** Releases all transient resources, followed by the memory blocks they were bound to. */
+void Anvil::FrameGraph::release_transient_resources()
+{
+    for (auto& current_resource : m_resources)
+    {
+        if (current_resource.is_imported)
+        {
+            continue;
+        }
+
+        if (current_resource.buffer_ptr != nullptr)
+        {
+            m_tracker_ptr->forget_buffer(current_resource.buffer_ptr);
+        }
+
+        if (current_resource.image_ptr != nullptr)
+        {
+            m_tracker_ptr->forget_image(current_resource.image_ptr);
+        }
+
+        current_resource.buffer_ptr = nullptr;
+        current_resource.image_ptr  = nullptr;
+    }
+
+    m_transient_buffers.clear();
+    m_transient_images.clear ();
+    m_memory_blocks.clear    ();
+}
@@ -35,10 +35,13 @@
 
 /** Please see header for specification */
 Anvil::MemoryAllocatorBackends::OneShot::OneShot(const Anvil::BaseDevice* in_device_ptr)
-    :m_device_ptr(in_device_ptr),
-     m_is_baked  (false)
+    :m_device_ptr                      (in_device_ptr),
+     m_is_baked                        (false),
+     m_n_bytes_saved_by_item_reordering(0)
 {
-    /* Stub */
+    m_usage_tracker_ptr.reset(
+        new Anvil::MemoryAllocator::UsageTracker(static_cast<uint32_t>(in_device_ptr->get_physical_device_memory_properties().types.size() ))
+    );
 }
 
 /** Please see header for specification */
@@ -47,6 +50,69 @@ Anvil::MemoryAllocatorBackends::OneShot::~OneShot()
     /* Stub */
 }
 
+/** Tells whether an item is laid out linearly in memory, as far as buffer-image granularity is concerned. */
+static bool is_item_linear(const Anvil::MemoryAllocator::Item* in_item_ptr)
+{
+    const bool is_buffer = (in_item_ptr->type == Anvil::MemoryAllocator::ITEM_TYPE_BUFFER                   ||
+                            in_item_ptr->type == Anvil::MemoryAllocator::ITEM_TYPE_SPARSE_BUFFER_REGION);
+    const bool is_image  = (in_item_ptr->type == Anvil::MemoryAllocator::ITEM_TYPE_IMAGE_WHOLE              ||
+                            in_item_ptr->type == Anvil::MemoryAllocator::ITEM_TYPE_SPARSE_IMAGE_MIPTAIL     ||
+                            in_item_ptr->type == Anvil::MemoryAllocator::ITEM_TYPE_SPARSE_IMAGE_SUBRESOURCE);
+
+    return (is_buffer)                                                                                      ||
+           (is_image && in_item_ptr->image_ptr->get_create_info_ptr()->get_tiling() == Anvil::ImageTiling::LINEAR);
+}
+
+/** Lays out the specified items in a single memory block, in the order they are specified in, with respect to
+ *  their alignment requirements and buffer-image granularity.
+ *
+ *  @param in_items             Items to lay out.
+ *  @param out_item_offsets_ptr If not null, deref will be filled with offsets of all items.
+ *
+ *  @return Number of bytes the memory block needs to hold.
+ **/
+VkDeviceSize Anvil::MemoryAllocatorBackends::OneShot::calculate_item_offsets(const std::vector<Anvil::MemoryAllocator::Item*>&       in_items,
+                                                                             std::map<Anvil::MemoryAllocator::Item*, VkDeviceSize>* out_item_offsets_ptr) const
+{
+    const VkDeviceSize            buffer_image_granularity = m_device_ptr->get_physical_device_properties().core_vk1_0_properties_ptr->limits.buffer_image_granularity;
+    bool                          is_prev_item_linear      = false;
+    VkDeviceSize                  n_bytes_required         = 0;
+    Anvil::MemoryAllocator::Item* prev_item_ptr            = nullptr;
+
+    for (auto& current_item_ptr : in_items)
+    {
+        const bool is_current_item_linear = is_item_linear(current_item_ptr);
+
+        anvil_assert(current_item_ptr->alloc_exportable_external_handle_types == 0);
+        anvil_assert(current_item_ptr->alloc_external_nt_handle_info_ptr      == nullptr);
+
+        n_bytes_required = Anvil::Utils::round_up(n_bytes_required,
+                                                  current_item_ptr->alloc_memory_required_alignment);
+
+        if (prev_item_ptr != nullptr)
+        {
+            /* Make sure to adhere to the buffer-image granularity requirement */
+            if (is_prev_item_linear != is_current_item_linear)
+            {
+                n_bytes_required = Anvil::Utils::round_up(n_bytes_required,
+                                                          buffer_image_granularity);
+            }
+        }
+
+        if (out_item_offsets_ptr != nullptr)
+        {
+            (*out_item_offsets_ptr)[current_item_ptr] = n_bytes_required;
+        }
+
+        n_bytes_required += current_item_ptr->alloc_size;
+
+        is_prev_item_linear = is_current_item_linear;
+        prev_item_ptr       = current_item_ptr;
+    }
+
+    return n_bytes_required;
+}
+
 /** Tries to create a memory object of size large enough to capacitate all added objects,
  *  given their alignment, size, and other requirements.
  *
@@ -229,6 +295,12 @@ bool Anvil::MemoryAllocatorBackends::OneShot::bake(Anvil::MemoryAllocator::Items
             }
             #endif
 
+            create_info_ptr->set_on_release_callback_function(
+                std::bind(&Anvil::MemoryAllocator::UsageTracker::on_dedicated_memory_block_released,
+                          m_usage_tracker_ptr,
+                          std::placeholders::_1)
+            );
+
             new_memory_block_ptr_regular = Anvil::MemoryBlock::create(std::move(create_info_ptr) );
         }
 
@@ -240,6 +312,8 @@ bool Anvil::MemoryAllocatorBackends::OneShot::bake(Anvil::MemoryAllocator::Items
             continue;
         }
 
+        m_usage_tracker_ptr->on_dedicated_memory_block_alloced(new_memory_block_ptr_regular.get() );
+
         {
             auto create_info_ptr = Anvil::MemoryBlockCreateInfo::create_derived(new_memory_block_ptr_regular.get(),
                                                                                 0, /* in_start_offset */
@@ -279,42 +353,53 @@ bool Anvil::MemoryAllocatorBackends::OneShot::bake(Anvil::MemoryAllocator::Items
                     VkDeviceSize                n_bytes_required    (0);
 
                     /* Go through the items, calculate offsets and the total amount of memory we're going
-                     * to need to alloc off the heap */
+                     * to need to alloc off the heap.
+                     *
+                     * Items are grouped by linear/non-linear class first, so that buffer-image granularity padding
+                     * is only needed once, and then sorted by descending alignment & size, so that alignment
+                     * padding between consecutive items is minimized. The original order is kept if, for some
+                     * reason, it turns out to be more compact. */
                     {
-                        bool                          is_prev_item_linear = false;
-                        Anvil::MemoryAllocator::Item* prev_item_ptr       = nullptr;
-
-                        for (auto& current_item_ptr : current_items)
+                        std::vector<Anvil::MemoryAllocator::Item*> sorted_items(current_items);
+                        VkDeviceSize                               n_bytes_required_sorted;
+                        VkDeviceSize                               n_bytes_required_unsorted;
+
+                        std::stable_sort(sorted_items.begin(),
+                                         sorted_items.end  (),
+                                         [](const Anvil::MemoryAllocator::Item* in_item1_ptr,
+                                            const Anvil::MemoryAllocator::Item* in_item2_ptr)
+                                         {
+                                             const bool is_item1_linear = is_item_linear(in_item1_ptr);
+                                             const bool is_item2_linear = is_item_linear(in_item2_ptr);
+
+                                             if (is_item1_linear != is_item2_linear)
+                                             {
+                                                 return is_item1_linear;
+                                             }
+
+                                             if (in_item1_ptr->alloc_memory_required_alignment != in_item2_ptr->alloc_memory_required_alignment)
+                                             {
+                                                 return in_item1_ptr->alloc_memory_required_alignment > in_item2_ptr->alloc_memory_required_alignment;
+                                             }
+
+                                             return in_item1_ptr->alloc_size > in_item2_ptr->alloc_size;
+                                         });
+
+                        n_bytes_required_sorted   = calculate_item_offsets(sorted_items,
+                                                                           nullptr); /* out_item_offsets_ptr */
+                        n_bytes_required_unsorted = calculate_item_offsets(current_items,
+                                                                           nullptr); /* out_item_offsets_ptr */
+
+                        if (n_bytes_required_sorted < n_bytes_required_unsorted)
                         {
-                            const bool is_current_item_buffer  = (current_item_ptr->type == Anvil::MemoryAllocator::ITEM_TYPE_BUFFER                   ||
-                                                                  current_item_ptr->type == Anvil::MemoryAllocator::ITEM_TYPE_SPARSE_BUFFER_REGION);
-                            const bool is_current_item_image   = (current_item_ptr->type == Anvil::MemoryAllocator::ITEM_TYPE_IMAGE_WHOLE              ||
-                                                                  current_item_ptr->type == Anvil::MemoryAllocator::ITEM_TYPE_SPARSE_IMAGE_MIPTAIL     ||
-                                                                  current_item_ptr->type == Anvil::MemoryAllocator::ITEM_TYPE_SPARSE_IMAGE_SUBRESOURCE);
-                            const bool is_current_item_linear = (is_current_item_buffer)                                                                                                  ||
-                                                                (is_current_item_image && current_item_ptr->image_ptr->get_create_info_ptr()->get_tiling() == Anvil::ImageTiling::LINEAR);
-
-                            anvil_assert(current_item_ptr->alloc_exportable_external_handle_types == 0);
-                            anvil_assert(current_item_ptr->alloc_external_nt_handle_info_ptr      == nullptr);
-
-                            n_bytes_required = Anvil::Utils::round_up(n_bytes_required,
-                                                                      current_item_ptr->alloc_memory_required_alignment);
-
-                            if (prev_item_ptr != nullptr)
-                            {
-                                /* Make sure to adhere to the buffer-image granularity requirement */
-                                if (is_prev_item_linear != is_current_item_linear)
-                                {
-                                    n_bytes_required = Anvil::Utils::round_up(n_bytes_required,
-                                                                              m_device_ptr->get_physical_device_properties().core_vk1_0_properties_ptr->limits.buffer_image_granularity);
-                                }
-                            }
-
-                            alloc_offset_map[current_item_ptr]  = n_bytes_required;
-                            n_bytes_required                   += current_item_ptr->alloc_size;
-
-                            is_prev_item_linear = is_current_item_linear;
-                            prev_item_ptr       = current_item_ptr;
+                            n_bytes_required                    = calculate_item_offsets(sorted_items,
+                                                                                        &alloc_offset_map);
+                            m_n_bytes_saved_by_item_reordering += n_bytes_required_unsorted - n_bytes_required_sorted;
+                        }
+                        else
+                        {
+                            n_bytes_required = calculate_item_offsets(current_items,
+                                                                     &alloc_offset_map);
                         }
                     }
 
@@ -339,19 +424,37 @@ bool Anvil::MemoryAllocatorBackends::OneShot::bake(Anvil::MemoryAllocator::Items
                         continue;
                     }
 
+                    m_usage_tracker_ptr->on_device_memory_alloced(current_memory_type_index,
+                                                                  n_bytes_required);
+
                     /* Go through the items again and assign the result memory block */
                     for (auto& current_item_ptr : current_items)
                     {
                         {
-                            auto create_info_ptr = Anvil::MemoryBlockCreateInfo::create_derived(new_memory_block_ptr.get(),
-                                                                                                alloc_offset_map.at(current_item_ptr),
-                                                                                                current_item_ptr->alloc_size);
+                            auto                                                  create_info_ptr   = Anvil::MemoryBlockCreateInfo::create_derived(new_memory_block_ptr.get(),
+                                                                                                                                                   alloc_offset_map.at(current_item_ptr),
+                                                                                                                                                   current_item_ptr->alloc_size);
+                            const uint32_t                                        memory_type_index = current_memory_type_index;
+                            const VkDeviceSize                                    size              = current_item_ptr->alloc_size;
+                            std::shared_ptr<Anvil::MemoryAllocator::UsageTracker> usage_tracker_ptr = m_usage_tracker_ptr;
+
+                            /* The region is not reused, but live items should no longer be accounted for once they are gone */
+                            create_info_ptr->set_on_release_callback_function(
+                                [usage_tracker_ptr, memory_type_index, size](Anvil::MemoryBlock*)
+                                {
+                                    usage_tracker_ptr->on_allocation_released(memory_type_index,
+                                                                              size);
+                                }
+                            );
 
                             current_item_ptr->alloc_memory_block_ptr = Anvil::MemoryBlock::create(std::move(create_info_ptr) );
                         }
 
                         if (current_item_ptr->alloc_memory_block_ptr != nullptr)
                         {
+                            m_usage_tracker_ptr->on_allocation_made(current_memory_type_index,
+                                                                    current_item_ptr->alloc_size);
+
                             current_item_ptr->is_baked = true;
                         }
 
@@ -380,6 +483,18 @@ end:
     return result;
 }
 
+void Anvil::MemoryAllocatorBackends::OneShot::get_counter_snapshot(Anvil::MemoryAllocator::CounterSnapshot* out_result_ptr) const
+{
+    *out_result_ptr = m_usage_tracker_ptr->get_counter_snapshot();
+}
+
+/** Memory regions of items which have gone out of scope are never reused by the one-shot backend, so free
+ *  ranges are always reported as empty. */
+void Anvil::MemoryAllocatorBackends::OneShot::get_memory_type_statistics(std::vector<Anvil::MemoryAllocator::MemoryStatistics>* out_result_ptr) const
+{
+    m_usage_tracker_ptr->get_memory_type_statistics(out_result_ptr);
+}
+
 VkResult Anvil::MemoryAllocatorBackends::OneShot::map(void*        in_memory_object,
                                                       VkDeviceSize in_start_offset,
                                                       VkDeviceSize in_size,
@@ -0,0 +1,1117 @@
+//
+// Copyright (c) 2017-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "misc/memalloc_backends/backend_tlsf.h"
+#include "misc/debug.h"
+#include "misc/image_create_info.h"
+#include "misc/memory_allocator.h"
+#include "misc/memory_block_create_info.h"
+#include "wrappers/device.h"
+#include "wrappers/image.h"
+#include "wrappers/memory_block.h"
+#include "wrappers/physical_device.h"
+#include <algorithm>
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+/* Sizes are binned into 2^N_SL_INDICES_LOG2 linearly spaced second-level lists per power of two. Sizes smaller
+ * than N_SL_INDICES are all kept in the zeroth first-level list, with one second-level list per byte count. */
+#define N_SL_INDICES_LOG2 (5)
+#define N_SL_INDICES      (1u << N_SL_INDICES_LOG2)
+#define N_FL_INDICES      (64 - N_SL_INDICES_LOG2 + 1)
+
+/* Default page size, used for heaps larger than 1GB. */
+#define DEFAULT_PAGE_SIZE       (64 * 1024 * 1024)
+#define SMALL_HEAP_SIZE_MAX     (1024ull * 1024 * 1024)
+
+
+/** Describes a single, physically contiguous region of a page. Free blocks are additionally linked into
+ *  the segregated free list matching their size. */
+struct Anvil::MemoryAllocatorBackends::TLSF::Block
+{
+    VkDeviceSize offset;
+    VkDeviceSize size;
+    bool         is_free;
+
+    Block* next_free_ptr;
+    Block* next_physical_ptr;
+    Block* prev_free_ptr;
+    Block* prev_physical_ptr;
+
+    Block(VkDeviceSize in_offset,
+          VkDeviceSize in_size)
+        :offset           (in_offset),
+         size             (in_size),
+         is_free          (true),
+         next_free_ptr    (nullptr),
+         next_physical_ptr(nullptr),
+         prev_free_ptr    (nullptr),
+         prev_physical_ptr(nullptr)
+    {
+        /* Stub */
+    }
+};
+
+/** Holds a single memory block, together with the TLSF structures describing which of its regions are in use. */
+struct Anvil::MemoryAllocatorBackends::TLSF::Page
+{
+    uint64_t                    key;
+    Anvil::MemoryBlockUniquePtr memory_block_ptr;
+    uint32_t                    n_allocations;
+    VkDeviceSize                n_bytes_used;
+
+    uint64_t fl_bitmap;
+    Block*   free_lists[N_FL_INDICES][N_SL_INDICES];
+    Block*   first_block_ptr;
+    uint32_t sl_bitmaps[N_FL_INDICES];
+
+    /* Bin of the owning PageList the page is linked into. Only valid if is_binned is true. */
+    uint32_t bin_fl;
+    uint32_t bin_sl;
+    bool     is_binned;
+    Page*    next_in_bin_ptr;
+    Page*    prev_in_bin_ptr;
+
+    Page(uint64_t                    in_key,
+         Anvil::MemoryBlockUniquePtr in_memory_block_ptr)
+        :key             (in_key),
+         memory_block_ptr(std::move(in_memory_block_ptr) ),
+         n_allocations   (0),
+         n_bytes_used    (0),
+         fl_bitmap       (0),
+         bin_fl          (0),
+         bin_sl          (0),
+         is_binned       (false),
+         next_in_bin_ptr (nullptr),
+         prev_in_bin_ptr (nullptr)
+    {
+        memset(free_lists,
+               0,
+               sizeof(free_lists) );
+        memset(sl_bitmaps,
+               0,
+               sizeof(sl_bitmaps) );
+
+        first_block_ptr = new Block(0, /* in_offset */
+                                    memory_block_ptr->get_create_info_ptr()->get_size() );
+
+        insert_free_block(first_block_ptr);
+    }
+
+    ~Page()
+    {
+        while (first_block_ptr != nullptr)
+        {
+            Block* next_block_ptr = first_block_ptr->next_physical_ptr;
+
+            delete first_block_ptr;
+            first_block_ptr = next_block_ptr;
+        }
+
+        memory_block_ptr.reset();
+    }
+
+    /** Carves a region of the specified size & alignment out of the page.
+     *
+     *  @return Block describing the region, or nullptr if no free block is large enough.
+     **/
+    Block* allocate(VkDeviceSize in_size,
+                    VkDeviceSize in_alignment)
+    {
+        Block*       block_ptr;
+        VkDeviceSize padding;
+        uint32_t     fl;
+        uint32_t     sl;
+
+        /* Any block from a list which the size, rounded up to the next list boundary, maps to, is guaranteed to be
+         * large enough to hold the region after its start has been aligned. */
+        get_indices(round_up_to_list_boundary(in_size + in_alignment - 1),
+                   &fl,
+                   &sl);
+
+        block_ptr = find_free_block(fl,
+                                    sl);
+
+        if (block_ptr == nullptr)
+        {
+            goto end;
+        }
+
+        remove_free_block(block_ptr);
+
+        /* Free blocks are always coalesced, so the leading padding & the trailing remainder can be
+         * returned to the free lists without checking the physical neighbours. */
+        padding = Anvil::Utils::round_up(block_ptr->offset,
+                                         in_alignment) - block_ptr->offset;
+
+        if (padding > 0)
+        {
+            Block* padding_block_ptr = block_ptr;
+
+            block_ptr = split_block(padding_block_ptr,
+                                    padding);
+
+            insert_free_block(padding_block_ptr);
+        }
+
+        if (block_ptr->size > in_size)
+        {
+            insert_free_block(split_block(block_ptr,
+                                          in_size) );
+        }
+
+        block_ptr->is_free  = false;
+        n_bytes_used       += block_ptr->size;
+
+        ++n_allocations;
+
+    end:
+        return block_ptr;
+    }
+
+    /** Returns the region described by @param in_block_ptr to the page, merging it with its physical neighbours. */
+    void free(Block* in_block_ptr)
+    {
+        anvil_assert(!in_block_ptr->is_free);
+        anvil_assert(n_allocations > 0);
+
+        in_block_ptr->is_free  = true;
+        n_bytes_used          -= in_block_ptr->size;
+
+        --n_allocations;
+
+        if (in_block_ptr->prev_physical_ptr != nullptr &&
+            in_block_ptr->prev_physical_ptr->is_free)
+        {
+            Block* prev_block_ptr = in_block_ptr->prev_physical_ptr;
+
+            remove_free_block(prev_block_ptr);
+            merge_with_next  (prev_block_ptr);
+
+            in_block_ptr = prev_block_ptr;
+        }
+
+        if (in_block_ptr->next_physical_ptr != nullptr &&
+            in_block_ptr->next_physical_ptr->is_free)
+        {
+            remove_free_block(in_block_ptr->next_physical_ptr);
+            merge_with_next  (in_block_ptr);
+        }
+
+        insert_free_block(in_block_ptr);
+    }
+
+    /** Returns the first free block from the list matching the specified indices or, if that list is empty,
+     *  from the first non-empty list holding larger blocks. Returns nullptr if there is none. */
+    Block* find_free_block(uint32_t in_fl,
+                           uint32_t in_sl) const
+    {
+        uint32_t fl;
+        uint32_t sl;
+
+        if (!find_list(fl_bitmap,
+                       sl_bitmaps,
+                       in_fl,
+                       in_sl,
+                      &fl,
+                      &sl) )
+        {
+            return nullptr;
+        }
+
+        return free_lists[fl][sl];
+    }
+
+    /** Retrieves indices of the list holding the largest free blocks of the page.
+     *
+     *  @return true if successful, false if the page has no free blocks.
+     **/
+    bool get_largest_free_list(uint32_t* out_fl_ptr,
+                               uint32_t* out_sl_ptr) const
+    {
+        if (fl_bitmap == 0)
+        {
+            return false;
+        }
+
+        *out_fl_ptr = find_msb(fl_bitmap);
+        *out_sl_ptr = find_msb(sl_bitmaps[*out_fl_ptr]);
+
+        return true;
+    }
+
+    void insert_free_block(Block* in_block_ptr)
+    {
+        uint32_t fl;
+        uint32_t sl;
+
+        get_indices(in_block_ptr->size,
+                   &fl,
+                   &sl);
+
+        in_block_ptr->is_free       = true;
+        in_block_ptr->next_free_ptr = free_lists[fl][sl];
+        in_block_ptr->prev_free_ptr = nullptr;
+
+        if (free_lists[fl][sl] != nullptr)
+        {
+            free_lists[fl][sl]->prev_free_ptr = in_block_ptr;
+        }
+
+        free_lists[fl][sl]  = in_block_ptr;
+        fl_bitmap          |= (1ull << fl);
+        sl_bitmaps[fl]     |= (1u   << sl);
+    }
+
+    /** Absorbs the physical successor of @param in_block_ptr, which must be free and off the free lists. */
+    void merge_with_next(Block* in_block_ptr)
+    {
+        Block* next_block_ptr = in_block_ptr->next_physical_ptr;
+
+        in_block_ptr->size              += next_block_ptr->size;
+        in_block_ptr->next_physical_ptr  = next_block_ptr->next_physical_ptr;
+
+        if (next_block_ptr->next_physical_ptr != nullptr)
+        {
+            next_block_ptr->next_physical_ptr->prev_physical_ptr = in_block_ptr;
+        }
+
+        delete next_block_ptr;
+    }
+
+    void remove_free_block(Block* in_block_ptr)
+    {
+        uint32_t fl;
+        uint32_t sl;
+
+        get_indices(in_block_ptr->size,
+                   &fl,
+                   &sl);
+
+        if (in_block_ptr->prev_free_ptr != nullptr)
+        {
+            in_block_ptr->prev_free_ptr->next_free_ptr = in_block_ptr->next_free_ptr;
+        }
+        else
+        {
+            anvil_assert(free_lists[fl][sl] == in_block_ptr);
+
+            free_lists[fl][sl] = in_block_ptr->next_free_ptr;
+
+            if (free_lists[fl][sl] == nullptr)
+            {
+                sl_bitmaps[fl] &= ~(1u << sl);
+
+                if (sl_bitmaps[fl] == 0)
+                {
+                    fl_bitmap &= ~(1ull << fl);
+                }
+            }
+        }
+
+        if (in_block_ptr->next_free_ptr != nullptr)
+        {
+            in_block_ptr->next_free_ptr->prev_free_ptr = in_block_ptr->prev_free_ptr;
+        }
+
+        in_block_ptr->is_free       = false;
+        in_block_ptr->next_free_ptr = nullptr;
+        in_block_ptr->prev_free_ptr = nullptr;
+    }
+
+    /** Shrinks @param in_block_ptr to @param in_size bytes and returns a new block covering the remainder. */
+    Block* split_block(Block*       in_block_ptr,
+                       VkDeviceSize in_size)
+    {
+        Block* new_block_ptr = new Block(in_block_ptr->offset + in_size,
+                                         in_block_ptr->size   - in_size);
+
+        new_block_ptr->next_physical_ptr = in_block_ptr->next_physical_ptr;
+        new_block_ptr->prev_physical_ptr = in_block_ptr;
+
+        if (in_block_ptr->next_physical_ptr != nullptr)
+        {
+            in_block_ptr->next_physical_ptr->prev_physical_ptr = new_block_ptr;
+        }
+
+        in_block_ptr->next_physical_ptr = new_block_ptr;
+        in_block_ptr->size              = in_size;
+
+        return new_block_ptr;
+    }
+
+    /** Finds the non-empty list matching the specified indices or, if that list is empty, the first non-empty list
+     *  holding larger entries, given bitmaps describing which lists are non-empty.
+     *
+     *  @return true if a list has been found, false otherwise.
+     **/
+    static bool find_list(uint64_t        in_fl_bitmap,
+                          const uint32_t* in_sl_bitmaps,
+                          uint32_t        in_fl,
+                          uint32_t        in_sl,
+                          uint32_t*       out_fl_ptr,
+                          uint32_t*       out_sl_ptr)
+    {
+        uint32_t sl_bitmap = (in_fl < N_FL_INDICES) ? (in_sl_bitmaps[in_fl] & (~0u << in_sl) )
+                                                    : 0;
+
+        if (sl_bitmap == 0)
+        {
+            const uint64_t fl_bitmap_larger = (in_fl + 1 < N_FL_INDICES) ? (in_fl_bitmap & (~0ull << (in_fl + 1) ))
+                                                                         : 0;
+
+            if (fl_bitmap_larger == 0)
+            {
+                return false;
+            }
+
+            in_fl     = find_lsb(fl_bitmap_larger);
+            sl_bitmap = in_sl_bitmaps[in_fl];
+        }
+
+        *out_fl_ptr = in_fl;
+        *out_sl_ptr = find_lsb(sl_bitmap);
+
+        return true;
+    }
+
+    static uint32_t find_lsb(uint64_t in_value)
+    {
+        anvil_assert(in_value != 0);
+
+        #if defined(_MSC_VER)
+        {
+            unsigned long result;
+
+            _BitScanForward64(&result,
+                              in_value);
+
+            return static_cast<uint32_t>(result);
+        }
+        #else
+        {
+            return static_cast<uint32_t>(__builtin_ctzll(in_value) );
+        }
+        #endif
+    }
+
+    static uint32_t find_msb(uint64_t in_value)
+    {
+        anvil_assert(in_value != 0);
+
+        #if defined(_MSC_VER)
+        {
+            unsigned long result;
+
+            _BitScanReverse64(&result,
+                              in_value);
+
+            return static_cast<uint32_t>(result);
+        }
+        #else
+        {
+            return static_cast<uint32_t>(63 - __builtin_clzll(in_value) );
+        }
+        #endif
+    }
+
+    static void get_indices(VkDeviceSize in_size,
+                            uint32_t*    out_fl_ptr,
+                            uint32_t*    out_sl_ptr)
+    {
+        if (in_size < N_SL_INDICES)
+        {
+            *out_fl_ptr = 0;
+            *out_sl_ptr = static_cast<uint32_t>(in_size);
+        }
+        else
+        {
+            const uint32_t msb = find_msb(in_size);
+
+            *out_fl_ptr = msb - N_SL_INDICES_LOG2 + 1;
+            *out_sl_ptr = static_cast<uint32_t>(in_size >> (msb - N_SL_INDICES_LOG2) ) & (N_SL_INDICES - 1);
+        }
+    }
+
+    static VkDeviceSize round_up_to_list_boundary(VkDeviceSize in_size)
+    {
+        if (in_size >= N_SL_INDICES)
+        {
+            in_size += (1ull << (find_msb(in_size) - N_SL_INDICES_LOG2) ) - 1;
+        }
+
+        return in_size;
+    }
+};
+
+/** Holds all pages which share a page key. Pages are binned by the list holding their largest free blocks,
+ *  using the same two-level bitmap scheme as free blocks within a page. Any page from a bin at or above the list
+ *  a request maps to is guaranteed to be able to hold it, so finding a page takes constant time. Full pages are
+ *  not binned. */
+struct Anvil::MemoryAllocatorBackends::TLSF::PageList
+{
+    Page*                      bins[N_FL_INDICES][N_SL_INDICES];
+    uint64_t                   fl_bitmap;
+    std::vector<PageUniquePtr> pages;
+    uint32_t                   sl_bitmaps[N_FL_INDICES];
+
+    PageList()
+        :fl_bitmap(0)
+    {
+        memset(bins,
+               0,
+               sizeof(bins) );
+        memset(sl_bitmaps,
+               0,
+               sizeof(sl_bitmaps) );
+    }
+
+    /** Returns a page with a free block in the list matching the specified indices or in a list holding larger
+     *  blocks, or nullptr if there is none. */
+    Page* find_page(uint32_t in_fl,
+                    uint32_t in_sl) const
+    {
+        uint32_t fl;
+        uint32_t sl;
+
+        if (!Page::find_list(fl_bitmap,
+                             sl_bitmaps,
+                             in_fl,
+                             in_sl,
+                            &fl,
+                            &sl) )
+        {
+            return nullptr;
+        }
+
+        return bins[fl][sl];
+    }
+
+    void unbin_page(Page* in_page_ptr)
+    {
+        const uint32_t fl = in_page_ptr->bin_fl;
+        const uint32_t sl = in_page_ptr->bin_sl;
+
+        anvil_assert(in_page_ptr->is_binned);
+
+        if (in_page_ptr->prev_in_bin_ptr != nullptr)
+        {
+            in_page_ptr->prev_in_bin_ptr->next_in_bin_ptr = in_page_ptr->next_in_bin_ptr;
+        }
+        else
+        {
+            anvil_assert(bins[fl][sl] == in_page_ptr);
+
+            bins[fl][sl] = in_page_ptr->next_in_bin_ptr;
+
+            if (bins[fl][sl] == nullptr)
+            {
+                sl_bitmaps[fl] &= ~(1u << sl);
+
+                if (sl_bitmaps[fl] == 0)
+                {
+                    fl_bitmap &= ~(1ull << fl);
+                }
+            }
+        }
+
+        if (in_page_ptr->next_in_bin_ptr != nullptr)
+        {
+            in_page_ptr->next_in_bin_ptr->prev_in_bin_ptr = in_page_ptr->prev_in_bin_ptr;
+        }
+
+        in_page_ptr->is_binned       = false;
+        in_page_ptr->next_in_bin_ptr = nullptr;
+        in_page_ptr->prev_in_bin_ptr = nullptr;
+    }
+
+    /** Moves the page to the bin matching its largest free blocks. Must be called whenever a region is carved out
+     *  of the page or returned to it. */
+    void update_page(Page* in_page_ptr)
+    {
+        uint32_t fl;
+        uint32_t sl;
+
+        if (in_page_ptr->is_binned)
+        {
+            unbin_page(in_page_ptr);
+        }
+
+        if (!in_page_ptr->get_largest_free_list(&fl,
+                                                &sl) )
+        {
+            goto end;
+        }
+
+        in_page_ptr->bin_fl          = fl;
+        in_page_ptr->bin_sl          = sl;
+        in_page_ptr->is_binned       = true;
+        in_page_ptr->next_in_bin_ptr = bins[fl][sl];
+        in_page_ptr->prev_in_bin_ptr = nullptr;
+
+        if (bins[fl][sl] != nullptr)
+        {
+            bins[fl][sl]->prev_in_bin_ptr = in_page_ptr;
+        }
+
+        bins[fl][sl]    = in_page_ptr;
+        fl_bitmap      |= (1ull << fl);
+        sl_bitmaps[fl] |= (1u   << sl);
+
+    end:
+        ;
+    }
+};
+
+
+/** Encodes the properties which need to match for two items to be placed in the same page.
+ *
+ *  Linear and non-linear resources are kept in separate pages, so that buffer-image granularity
+ *  never needs to be taken into account.
+ **/
+static uint64_t get_page_key(uint32_t in_device_mask,
+                             uint32_t in_memory_type_index,
+                             bool     in_is_linear)
+{
+    return (static_cast<uint64_t>(in_device_mask) << 32) |
+           (in_memory_type_index                  << 1)  |
+           ((in_is_linear) ? 1 : 0);
+}
+
+
+/** Please see header for specification */
+Anvil::MemoryAllocatorBackends::TLSF::TLSF(const Anvil::BaseDevice* in_device_ptr,
+                                           VkDeviceSize             in_page_size)
+    :m_device_ptr(in_device_ptr),
+     m_page_size (in_page_size)
+{
+    m_usage_tracker_ptr.reset(
+        new Anvil::MemoryAllocator::UsageTracker(static_cast<uint32_t>(in_device_ptr->get_physical_device_memory_properties().types.size() ))
+    );
+}
+
+/** Please see header for specification */
+Anvil::MemoryAllocatorBackends::TLSF::~TLSF()
+{
+    /* All memory blocks handed out by the backend hold a reference to it, so by now
+     * all pages must be empty. */
+    #ifdef _DEBUG
+    {
+        for (const auto& current_key_pages : m_pages)
+        {
+            for (const auto& current_page_ptr : current_key_pages.second->pages)
+            {
+                anvil_assert(current_page_ptr->n_allocations == 0);
+            }
+        }
+    }
+    #endif
+}
+
+/** Assigns a region of one of the pages matching the item's properties to the item. A new page is allocated
+ *  if none of the existing ones has a large enough free block. The page is looked up through the page list's
+ *  bins, so the cost does not depend on the number of pages.
+ *
+ *  Must be called with m_mutex locked.
+ *
+ *  @return true if successful, false otherwise.
+ **/
+bool Anvil::MemoryAllocatorBackends::TLSF::allocate_from_pages(Anvil::MemoryAllocator::Item* in_item_ptr,
+                                                               uint32_t                      in_memory_type_index)
+{
+    const bool   is_image   = (in_item_ptr->type == Anvil::MemoryAllocator::ITEM_TYPE_IMAGE_WHOLE              ||
+                               in_item_ptr->type == Anvil::MemoryAllocator::ITEM_TYPE_SPARSE_IMAGE_MIPTAIL     ||
+                               in_item_ptr->type == Anvil::MemoryAllocator::ITEM_TYPE_SPARSE_IMAGE_SUBRESOURCE);
+    const bool   is_linear  = (!is_image || in_item_ptr->image_ptr->get_create_info_ptr()->get_tiling() == Anvil::ImageTiling::LINEAR);
+    const auto   alignment  = std::max<VkDeviceSize>(in_item_ptr->alloc_memory_required_alignment,
+                                                     1);
+    Block*       block_ptr  = nullptr;
+    uint32_t     fl         = 0;
+    const auto   key        = get_page_key(in_item_ptr->alloc_device_mask,
+                                           in_memory_type_index,
+                                           is_linear);
+    auto&        page_list  = m_pages[key];
+    Page*        page_ptr   = nullptr;
+    bool         result     = false;
+    uint32_t     sl         = 0;
+
+    if (page_list == nullptr)
+    {
+        page_list.reset(new PageList() );
+    }
+
+    /* Same indices as Page::allocate() uses to look up a free block */
+    Page::get_indices(Page::round_up_to_list_boundary(in_item_ptr->alloc_size + alignment - 1),
+                     &fl,
+                     &sl);
+
+    page_ptr = page_list->find_page(fl,
+                                    sl);
+
+    if (page_ptr != nullptr)
+    {
+        block_ptr = page_ptr->allocate(in_item_ptr->alloc_size,
+                                       alignment);
+
+        anvil_assert(block_ptr != nullptr);
+    }
+
+    if (block_ptr == nullptr)
+    {
+        /* None of the existing pages can hold the item. bake() only sends items which fit in an empty page here */
+        const auto                  memory_features  = m_device_ptr->get_physical_device_memory_properties().types.at(in_memory_type_index).features;
+        Anvil::MemoryBlockUniquePtr memory_block_ptr;
+        const auto                  page_size        = get_page_size(in_memory_type_index);
+
+        {
+            auto create_info_ptr = Anvil::MemoryBlockCreateInfo::create_regular(m_device_ptr,
+                                                                                1u << in_memory_type_index,
+                                                                                page_size,
+                                                                                memory_features);
+
+            create_info_ptr->set_device_mask(in_item_ptr->alloc_device_mask);
+            create_info_ptr->set_mt_safety  (Anvil::Utils::convert_boolean_to_mt_safety_enum(m_device_ptr->is_mt_safe()) );
+
+            memory_block_ptr = Anvil::MemoryBlock::create(std::move(create_info_ptr) );
+        }
+
+        if (memory_block_ptr == nullptr)
+        {
+            goto end;
+        }
+
+        m_usage_tracker_ptr->on_device_memory_alloced(in_memory_type_index,
+                                                      page_size);
+
+        page_list->pages.push_back(
+            PageUniquePtr(new Page(key,
+                                   std::move(memory_block_ptr) ))
+        );
+
+        page_ptr  = page_list->pages.back().get();
+        block_ptr = page_ptr->allocate(in_item_ptr->alloc_size,
+                                       alignment);
+    }
+
+    /* New pages need to be binned even if the allocation has failed */
+    page_list->update_page(page_ptr);
+
+    if (block_ptr == nullptr)
+    {
+        anvil_assert(block_ptr != nullptr);
+
+        goto end;
+    }
+
+    {
+        auto create_info_ptr = Anvil::MemoryBlockCreateInfo::create_derived(page_ptr->memory_block_ptr.get(),
+                                                                            block_ptr->offset,
+                                                                            in_item_ptr->alloc_size);
+
+        create_info_ptr->set_on_release_callback_function(
+            std::bind(&TLSF::on_memory_block_released,
+                      shared_from_this(),
+                      std::placeholders::_1,
+                      page_ptr,
+                      block_ptr)
+        );
+
+        in_item_ptr->alloc_memory_block_ptr = Anvil::MemoryBlock::create(std::move(create_info_ptr) );
+    }
+
+    if (in_item_ptr->alloc_memory_block_ptr == nullptr)
+    {
+        anvil_assert(in_item_ptr->alloc_memory_block_ptr != nullptr);
+
+        page_ptr->free       (block_ptr);
+        page_list->update_page(page_ptr);
+
+        goto end;
+    }
+
+    dynamic_cast<IMemoryBlockBackendSupport*>(in_item_ptr->alloc_memory_block_ptr.get() )->set_parent_memory_allocator_backend_ptr(shared_from_this(),
+                                                                                                                                   reinterpret_cast<void*>(page_ptr->memory_block_ptr->get_memory() ));
+
+    m_usage_tracker_ptr->on_allocation_made(in_memory_type_index,
+                                            in_item_ptr->alloc_size);
+
+    result = true;
+end:
+    return result;
+}
+
+/** Creates a memory block of its own for an item which requested a dedicated allocation or external
+ *  memory handle support. The memory is released as soon as the block goes out of scope.
+ *
+ *  @return true if successful, false otherwise.
+ **/
+bool Anvil::MemoryAllocatorBackends::TLSF::allocate_dedicated(Anvil::MemoryAllocator::Item* in_item_ptr,
+                                                              uint32_t                      in_memory_type_index)
+{
+    const auto memory_features = m_device_ptr->get_physical_device_memory_properties().types.at(in_memory_type_index).features;
+
+    {
+        auto create_info_ptr = Anvil::MemoryBlockCreateInfo::create_regular(m_device_ptr,
+                                                                            1u << in_memory_type_index,
+                                                                            in_item_ptr->alloc_size,
+                                                                            memory_features);
+
+        create_info_ptr->set_device_mask(in_item_ptr->alloc_device_mask);
+        create_info_ptr->set_mt_safety  (Anvil::Utils::convert_boolean_to_mt_safety_enum(m_device_ptr->is_mt_safe()) );
+
+        if (in_item_ptr->alloc_is_dedicated_memory)
+        {
+            create_info_ptr->use_dedicated_allocation(in_item_ptr->buffer_ptr,
+                                                      in_item_ptr->image_ptr);
+        }
+
+        if (in_item_ptr->alloc_exportable_external_handle_types != 0)
+        {
+            create_info_ptr->set_exportable_external_memory_handle_types(in_item_ptr->alloc_exportable_external_handle_types);
+        }
+
+        #if defined(_WIN32)
+        {
+            if (in_item_ptr->alloc_external_nt_handle_info_ptr != nullptr)
+            {
+                create_info_ptr->set_exportable_nt_handle_info(in_item_ptr->alloc_external_nt_handle_info_ptr->attributes_ptr,
+                                                               in_item_ptr->alloc_external_nt_handle_info_ptr->access,
+                                                               in_item_ptr->alloc_external_nt_handle_info_ptr->name);
+            }
+        }
+        #endif
+
+        create_info_ptr->set_on_release_callback_function(
+            std::bind(&Anvil::MemoryAllocator::UsageTracker::on_dedicated_memory_block_released,
+                      m_usage_tracker_ptr,
+                      std::placeholders::_1)
+        );
+
+        in_item_ptr->alloc_memory_block_ptr = Anvil::MemoryBlock::create(std::move(create_info_ptr) );
+    }
+
+    if (in_item_ptr->alloc_memory_block_ptr == nullptr)
+    {
+        anvil_assert(in_item_ptr->alloc_memory_block_ptr != nullptr);
+
+        return false;
+    }
+
+    m_usage_tracker_ptr->on_dedicated_memory_block_alloced(in_item_ptr->alloc_memory_block_ptr.get() );
+
+    dynamic_cast<IMemoryBlockBackendSupport*>(in_item_ptr->alloc_memory_block_ptr.get() )->set_parent_memory_allocator_backend_ptr(shared_from_this(),
+                                                                                                                                   reinterpret_cast<void*>(in_item_ptr->alloc_memory_block_ptr->get_memory() ));
+
+    return true;
+}
+
+/** Assigns memory regions to all specified items. Items which request a dedicated allocation or external
+ *  memory handle support, or which do not fit in a page, get memory blocks of their own. All other items
+ *  are sub-allocated from pages.
+ *
+ *  This function can be called multiple times.
+ *
+ *  @return true if all allocations have been handled successfully, false if there was at least
+ *               one failure.
+ **/
+bool Anvil::MemoryAllocatorBackends::TLSF::bake(Anvil::MemoryAllocator::Items& in_items)
+{
+    std::unique_lock<std::mutex> lock  (m_mutex);
+    bool                         result(true);
+
+    for (auto& current_item_ptr : in_items)
+    {
+        uint32_t memory_type_index = UINT32_MAX;
+
+        if (!get_memory_type_for_item(current_item_ptr.get(),
+                                     &memory_type_index) )
+        {
+            anvil_assert_fail();
+
+            result = false;
+            continue;
+        }
+
+        if (current_item_ptr->alloc_is_dedicated_memory                   ||
+            current_item_ptr->alloc_exportable_external_handle_types != 0 ||
+            is_item_too_large_for_page(current_item_ptr.get(),
+                                       memory_type_index) )
+        {
+            if (!allocate_dedicated(current_item_ptr.get(),
+                                    memory_type_index) )
+            {
+                result = false;
+                continue;
+            }
+        }
+        else
+        {
+            if (!allocate_from_pages(current_item_ptr.get(),
+                                     memory_type_index) )
+            {
+                result = false;
+                continue;
+            }
+        }
+
+        current_item_ptr->is_baked = true;
+    }
+
+    return result;
+}
+
+/** Please see header for specification */
+std::unique_ptr<Anvil::MemoryAllocatorBackends::TLSF> Anvil::MemoryAllocatorBackends::TLSF::create(const Anvil::BaseDevice* in_device_ptr,
+                                                                                                   VkDeviceSize             in_page_size)
+{
+    std::unique_ptr<Anvil::MemoryAllocatorBackends::TLSF> result_ptr;
+
+    result_ptr.reset(
+        new TLSF(in_device_ptr,
+                 in_page_size)
+    );
+
+    return result_ptr;
+}
+
+/** Please see header for specification */
+void Anvil::MemoryAllocatorBackends::TLSF::get_counter_snapshot(Anvil::MemoryAllocator::CounterSnapshot* out_result_ptr) const
+{
+    *out_result_ptr = m_usage_tracker_ptr->get_counter_snapshot();
+}
+
+/** Please see header for specification */
+void Anvil::MemoryAllocatorBackends::TLSF::get_memory_type_statistics(std::vector<Anvil::MemoryAllocator::MemoryStatistics>* out_result_ptr) const
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    m_usage_tracker_ptr->get_memory_type_statistics(out_result_ptr);
+
+    /* Free blocks can only be found by walking the pages */
+    for (const auto& current_key_pages : m_pages)
+    {
+        for (const auto& current_page_ptr : current_key_pages.second->pages)
+        {
+            auto& memory_type_statistics = out_result_ptr->at(current_page_ptr->memory_block_ptr->get_create_info_ptr()->get_memory_type_index() );
+
+            for (const Block* current_block_ptr  = current_page_ptr->first_block_ptr;
+                              current_block_ptr != nullptr;
+                              current_block_ptr  = current_block_ptr->next_physical_ptr)
+            {
+                if (current_block_ptr->is_free)
+                {
+                    memory_type_statistics.largest_free_range  = std::max(memory_type_statistics.largest_free_range,
+                                                                          current_block_ptr->size);
+                    memory_type_statistics.n_bytes_free       += current_block_ptr->size;
+
+                    ++memory_type_statistics.n_free_ranges;
+                }
+            }
+        }
+    }
+}
+
+/** Determines which memory type an item should be assigned memory from. The first memory type which is supported
+ *  by the item, exposes all required memory features and satisfies peer memory requirements, is picked.
+ *
+ *  @return true if a matching memory type was found, false otherwise.
+ **/
+bool Anvil::MemoryAllocatorBackends::TLSF::get_memory_type_for_item(const Anvil::MemoryAllocator::Item* in_item_ptr,
+                                                                    uint32_t*                           out_memory_type_index_ptr) const
+{
+    const auto& memory_props             = m_device_ptr->get_physical_device_memory_properties();
+    const auto& required_memory_features = in_item_ptr->alloc_memory_required_features;
+    const auto& supported_memory_types   = in_item_ptr->alloc_memory_supported_memory_types;
+
+    for (uint32_t n_memory_type = 0;
+                  n_memory_type < static_cast<uint32_t>(memory_props.types.size() );
+                ++n_memory_type)
+    {
+        bool can_continue = true;
+
+        if (!(supported_memory_types & (1 << n_memory_type)) )
+        {
+            continue;
+        }
+
+        if ((memory_props.types.at(n_memory_type).features & static_cast<Anvil::MemoryFeatureFlagBits>(required_memory_features.get_vk() )) != required_memory_features)
+        {
+            continue;
+        }
+
+        if (in_item_ptr->alloc_mgpu_peer_memory_reqs.size() > 0)
+        {
+            auto mgpu_device_ptr = dynamic_cast<const Anvil::MGPUDevice*>(m_device_ptr);
+
+            anvil_assert(m_device_ptr->get_type() == Anvil::DeviceType::MULTI_GPU);
+            anvil_assert(mgpu_device_ptr          != nullptr);
+
+            for (const auto& current_req : in_item_ptr->alloc_mgpu_peer_memory_reqs)
+            {
+                Anvil::PeerMemoryFeatureFlags current_memory_type_peer_memory_features;
+                const auto                    local_device_ptr                         = mgpu_device_ptr->get_physical_device(current_req.first.first);
+                const auto                    remote_device_ptr                        = mgpu_device_ptr->get_physical_device(current_req.first.second);
+                const auto&                   required_peer_memory_features            = current_req.second;
+
+                if (!mgpu_device_ptr->get_peer_memory_features(local_device_ptr,
+                                                               remote_device_ptr,
+                                                               memory_props.types.at(n_memory_type).heap_ptr->index,
+                                                              &current_memory_type_peer_memory_features)                               ||
+                    (current_memory_type_peer_memory_features & required_peer_memory_features) != required_peer_memory_features)
+                {
+                    can_continue = false;
+
+                    break;
+                }
+            }
+        }
+
+        if (can_continue)
+        {
+            *out_memory_type_index_ptr = n_memory_type;
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/** Returns the size of pages which should be allocated from the specified memory type. */
+VkDeviceSize Anvil::MemoryAllocatorBackends::TLSF::get_page_size(uint32_t in_memory_type_index) const
+{
+    const auto heap_size = m_device_ptr->get_physical_device_memory_properties().types.at(in_memory_type_index).heap_ptr->size;
+
+    if (m_page_size != 0)
+    {
+        return m_page_size;
+    }
+
+    return (heap_size <= SMALL_HEAP_SIZE_MAX) ? heap_size / 8
+                                              : DEFAULT_PAGE_SIZE;
+}
+
+/** Tells whether an empty page of the specified memory type would be too small to hold the item.
+ *
+ *  Page::allocate() only looks for free blocks in lists at or above the one the item's size, padded for
+ *  alignment, rounds up to. An empty page holds a single free block which spans the whole page, so that block's
+ *  list must not come before the item's.
+ **/
+bool Anvil::MemoryAllocatorBackends::TLSF::is_item_too_large_for_page(const Anvil::MemoryAllocator::Item* in_item_ptr,
+                                                                      uint32_t                            in_memory_type_index) const
+{
+    const auto alignment = std::max<VkDeviceSize>(in_item_ptr->alloc_memory_required_alignment,
+                                                  1);
+    uint32_t   item_fl   = 0;
+    uint32_t   item_sl   = 0;
+    uint32_t   page_fl   = 0;
+    uint32_t   page_sl   = 0;
+
+    Page::get_indices(Page::round_up_to_list_boundary(in_item_ptr->alloc_size + alignment - 1),
+                     &item_fl,
+                     &item_sl);
+    Page::get_indices(get_page_size(in_memory_type_index),
+                     &page_fl,
+                     &page_sl);
+
+    return (item_fl >  page_fl) ||
+           (item_fl == page_fl && item_sl > page_sl);
+}
+
+VkResult Anvil::MemoryAllocatorBackends::TLSF::map(void*        in_memory_object,
+                                                   VkDeviceSize in_start_offset,
+                                                   VkDeviceSize in_size,
+                                                   void**       out_result_ptr)
+{
+    return Anvil::Vulkan::vkMapMemory(m_device_ptr->get_device_vk(),
+                                      reinterpret_cast<VkDeviceMemory>(in_memory_object),
+                                      in_start_offset,
+                                      in_size,
+                                      0, /* flags */
+                                      out_result_ptr);
+}
+
+/** Called back whenever a memory block carved out of a page is about to be released. Returns the region
+ *  to the page, and releases the page if it has become empty and is not the only page of its kind. */
+void Anvil::MemoryAllocatorBackends::TLSF::on_memory_block_released(Anvil::MemoryBlock* in_memory_block_ptr,
+                                                                    Page*               in_page_ptr,
+                                                                    Block*              in_block_ptr)
+{
+    std::unique_lock<std::mutex> lock             (m_mutex);
+    const uint32_t               memory_type_index(in_page_ptr->memory_block_ptr->get_create_info_ptr()->get_memory_type_index() );
+
+    auto&                        page_list        (*m_pages.at(in_page_ptr->key) );
+
+    in_page_ptr->free    (in_block_ptr);
+    page_list.update_page(in_page_ptr);
+
+    m_usage_tracker_ptr->on_allocation_released(memory_type_index,
+                                                in_memory_block_ptr->get_create_info_ptr()->get_size() );
+
+    if (in_page_ptr->n_allocations == 0                            &&
+        !in_page_ptr->memory_block_ptr->is_persistently_mapped() )
+    {
+        auto& pages = page_list.pages;
+
+        if (pages.size() > 1)
+        {
+            m_usage_tracker_ptr->on_device_memory_freed(memory_type_index,
+                                                        in_page_ptr->memory_block_ptr->get_create_info_ptr()->get_size() );
+
+            page_list.unbin_page(in_page_ptr);
+
+            pages.erase(
+                std::find_if(pages.begin(),
+                             pages.end  (),
+                             [in_page_ptr](const PageUniquePtr& in_current_page_ptr)
+                             {
+                                 return in_current_page_ptr.get() == in_page_ptr;
+                             })
+            );
+        }
+    }
+}
+
+/** Always returns true */
+bool Anvil::MemoryAllocatorBackends::TLSF::supports_baking() const
+{
+    return true;
+}
+
+bool Anvil::MemoryAllocatorBackends::TLSF::supports_device_masks() const
+{
+    return true;
+}
+
+bool Anvil::MemoryAllocatorBackends::TLSF::supports_external_memory_handles(const Anvil::ExternalMemoryHandleTypeFlags&) const
+{
+    /* Items which use external memory handles are assigned memory blocks of their own */
+    return true;
+}
+
+void Anvil::MemoryAllocatorBackends::TLSF::unmap(void* in_memory_object)
+{
+    Anvil::Vulkan::vkUnmapMemory(m_device_ptr->get_device_vk(),
+                                 reinterpret_cast<VkDeviceMemory>(in_memory_object) );
+}
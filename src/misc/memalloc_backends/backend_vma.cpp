@@ -20,8 +20,10 @@
 // THE SOFTWARE.
 //
 
+#include "misc/buffer_create_info.h"
 #include "misc/debug.h"
 #include "misc/memory_block_create_info.h"
+#include "wrappers/buffer.h"
 #include "wrappers/device.h"
 #include "wrappers/memory_block.h"
 #include "wrappers/physical_device.h"
@@ -50,6 +52,14 @@
 
 /* <== */
 
+#include <unordered_map>
+
+
+/* VMA's device memory callbacks do not take user data, so the usage tracker to update is looked up
+ * using the allocator handle instead. */
+static std::mutex                                                               g_vma_usage_trackers_mutex;
+static std::unordered_map<VmaAllocator, Anvil::MemoryAllocator::UsageTracker*> g_vma_usage_trackers;
+
 
 /* Please see header for specification */
 Anvil::MemoryAllocatorBackends::VMA::VMAAllocator::VMAAllocator(const Anvil::BaseDevice* in_device_ptr)
@@ -64,6 +74,12 @@ Anvil::MemoryAllocatorBackends::VMA::VMAAllocator::~VMAAllocator()
 {
     if (m_allocator != nullptr)
     {
+        {
+            std::unique_lock<std::mutex> lock(g_vma_usage_trackers_mutex);
+
+            g_vma_usage_trackers.erase(m_allocator);
+        }
+
         vmaDestroyAllocator(m_allocator);
 
         m_allocator = nullptr;
@@ -96,9 +112,14 @@ std::shared_ptr<Anvil::MemoryAllocatorBackends::VMA::VMAAllocator> Anvil::Memory
  **/
 bool Anvil::MemoryAllocatorBackends::VMA::VMAAllocator::init()
 {
-    VmaAllocatorCreateInfo create_info                        = {};
-    const bool             khr_dedicated_allocation_supported = m_device_ptr->get_extension_info()->khr_dedicated_allocation();
-    VkResult               result                             = VK_ERROR_DEVICE_LOST;
+    VmaAllocatorCreateInfo   create_info                        = {};
+    VmaDeviceMemoryCallbacks device_memory_callbacks            = {};
+    const bool               khr_dedicated_allocation_supported = m_device_ptr->get_extension_info()->khr_dedicated_allocation();
+    VkResult                 result                             = VK_ERROR_DEVICE_LOST;
+
+    m_usage_tracker_ptr.reset(
+        new Anvil::MemoryAllocator::UsageTracker(static_cast<uint32_t>(m_device_ptr->get_physical_device_memory_properties().types.size() ))
+    );
 
     /* Prepare VK func ptr array */
     m_vma_func_ptrs.reset(
@@ -169,9 +190,13 @@ bool Anvil::MemoryAllocatorBackends::VMA::VMAAllocator::init()
         }
     }
 
+    device_memory_callbacks.pfnAllocate = on_device_memory_alloced;
+    device_memory_callbacks.pfnFree     = on_device_memory_freed;
+
     create_info.flags                       = (khr_dedicated_allocation_supported) ? VMA_ALLOCATOR_CREATE_KHR_DEDICATED_ALLOCATION_BIT : 0;
     create_info.device                      = m_device_ptr->get_device_vk();
     create_info.pAllocationCallbacks        = nullptr;
+    create_info.pDeviceMemoryCallbacks      = &device_memory_callbacks;
     create_info.preferredLargeHeapBlockSize = 0;
     create_info.pVulkanFunctions            = m_vma_func_ptrs.get();
 
@@ -179,10 +204,101 @@ bool Anvil::MemoryAllocatorBackends::VMA::VMAAllocator::init()
                                 &m_allocator);
 
     anvil_assert_vk_call_succeeded(result);
+
+    if (is_vk_call_successful(result) )
+    {
+        std::unique_lock<std::mutex> lock(g_vma_usage_trackers_mutex);
+
+        g_vma_usage_trackers[m_allocator] = m_usage_tracker_ptr.get();
+    }
+
 end:
     return is_vk_call_successful(result);
 }
 
+/** Please see header for specification */
+bool Anvil::MemoryAllocatorBackends::VMA::VMAAllocator::get_memory_block_allocation(const Anvil::MemoryBlock* in_memory_block_ptr,
+                                                                                   VmaAllocation*            out_vma_allocation_ptr) const
+{
+    std::unique_lock<std::mutex> lock           (m_memory_block_allocations_mutex);
+    auto                         block_iterator = m_memory_block_allocations.find(in_memory_block_ptr);
+
+    if (block_iterator == m_memory_block_allocations.end() )
+    {
+        return false;
+    }
+
+    *out_vma_allocation_ptr = block_iterator->second;
+
+    return true;
+}
+
+/** Please see header for specification */
+void Anvil::MemoryAllocatorBackends::VMA::VMAAllocator::register_memory_block(const Anvil::MemoryBlock* in_memory_block_ptr,
+                                                                             VmaAllocation             in_vma_allocation)
+{
+    std::unique_lock<std::mutex> lock(m_memory_block_allocations_mutex);
+
+    anvil_assert(m_memory_block_allocations.find(in_memory_block_ptr) == m_memory_block_allocations.end() );
+
+    m_memory_block_allocations[in_memory_block_ptr] = in_vma_allocation;
+}
+
+/** Please see header for specification */
+void Anvil::MemoryAllocatorBackends::VMA::VMAAllocator::replace_memory_block(const Anvil::MemoryBlock* in_old_memory_block_ptr,
+                                                                            const Anvil::MemoryBlock* in_new_memory_block_ptr)
+{
+    std::unique_lock<std::mutex> lock           (m_memory_block_allocations_mutex);
+    auto                         block_iterator = m_memory_block_allocations.find(in_old_memory_block_ptr);
+
+    anvil_assert(block_iterator != m_memory_block_allocations.end() );
+
+    if (block_iterator != m_memory_block_allocations.end() )
+    {
+        const VmaAllocation allocation = block_iterator->second;
+
+        m_memory_block_allocations.erase(block_iterator);
+
+        m_memory_block_allocations[in_new_memory_block_ptr] = allocation;
+    }
+}
+
+/** Called back by VMA right after it allocates a new VkDeviceMemory object. */
+void VKAPI_PTR Anvil::MemoryAllocatorBackends::VMA::VMAAllocator::on_device_memory_alloced(VmaAllocator   in_allocator,
+                                                                                          uint32_t       in_memory_type,
+                                                                                          VkDeviceMemory in_memory,
+                                                                                          VkDeviceSize   in_size)
+{
+    std::unique_lock<std::mutex> lock             (g_vma_usage_trackers_mutex);
+    auto                         tracker_iterator = g_vma_usage_trackers.find(in_allocator);
+
+    ANVIL_REDUNDANT_ARGUMENT(in_memory);
+
+    if (tracker_iterator != g_vma_usage_trackers.end() )
+    {
+        tracker_iterator->second->on_device_memory_alloced(in_memory_type,
+                                                           in_size);
+    }
+}
+
+/** Called back by VMA right before it frees a VkDeviceMemory object. */
+void VKAPI_PTR Anvil::MemoryAllocatorBackends::VMA::VMAAllocator::on_device_memory_freed(VmaAllocator   in_allocator,
+                                                                                        uint32_t       in_memory_type,
+                                                                                        VkDeviceMemory in_memory,
+                                                                                        VkDeviceSize   in_size)
+{
+    std::unique_lock<std::mutex> lock             (g_vma_usage_trackers_mutex);
+    auto                         tracker_iterator = g_vma_usage_trackers.find(in_allocator);
+
+    ANVIL_REDUNDANT_ARGUMENT(in_memory);
+
+    if (tracker_iterator != g_vma_usage_trackers.end() )
+    {
+        tracker_iterator->second->on_device_memory_freed(in_memory_type,
+                                                         in_size);
+    }
+}
+
 /** Please see header for specification */
 Anvil::MemoryAllocatorBackends::VMA::VMA(const Anvil::BaseDevice* in_device_ptr)
     :m_device_ptr(in_device_ptr)
@@ -316,10 +432,16 @@ bool Anvil::MemoryAllocatorBackends::VMA::bake(Anvil::MemoryAllocator::Items& in
         dynamic_cast<IMemoryBlockBackendSupport*>(new_memory_block_ptr.get() )->set_parent_memory_allocator_backend_ptr(shared_from_this(),
                                                                                                                         allocation);
 
+        m_vma_allocator_ptr->register_memory_block(new_memory_block_ptr.get(),
+                                                   allocation);
+
         current_item_ptr->alloc_memory_block_ptr = std::move(new_memory_block_ptr);
         current_item_ptr->alloc_size             = memory_requirements_vk.size;
         current_item_ptr->is_baked               = true;
 
+        m_vma_allocator_ptr->get_usage_tracker()->on_allocation_made(allocation_info.memoryType,
+                                                                     memory_requirements_vk.size);
+
         m_vma_allocator_ptr->on_new_vma_mem_block_alloced();
     }
 
@@ -346,6 +468,204 @@ std::unique_ptr<Anvil::MemoryAllocatorBackends::VMA> Anvil::MemoryAllocatorBacke
     return result_ptr;
 }
 
+/** Please see header for specification */
+bool Anvil::MemoryAllocatorBackends::VMA::defragment(uint32_t                                         in_n_buffers,
+                                                     Anvil::Buffer* const*                            in_buffers_ptr,
+                                                     VkDeviceSize                                     in_max_bytes_to_move,
+                                                     uint32_t                                         in_max_allocations_to_move,
+                                                     const Anvil::MemoryAllocatorBufferMovedCallback& in_opt_buffer_moved_callback_function,
+                                                     Anvil::MemoryAllocator::DefragmentationStats*    out_opt_stats_ptr)
+{
+    std::vector<VkBool32>       allocations_changed;
+    std::vector<VmaAllocation>  allocations;
+    std::vector<Anvil::Buffer*> buffers;
+    VmaDefragmentationInfo      defragmentation_info;
+    VmaDefragmentationStats     defragmentation_stats = {};
+    bool                        result                = false;
+    VkResult                    result_vk;
+
+    allocations.reserve(in_n_buffers);
+    buffers.reserve    (in_n_buffers);
+
+    /* Gather VMA allocations backing the buffers which can be moved */
+    for (uint32_t n_buffer = 0;
+                  n_buffer < in_n_buffers;
+                ++n_buffer)
+    {
+        auto          buffer_ptr       = in_buffers_ptr[n_buffer];
+        const auto    create_flags     = buffer_ptr->get_create_info_ptr()->get_create_flags();
+        VmaAllocation allocation       = VK_NULL_HANDLE;
+        MemoryBlock*  memory_block_ptr = nullptr;
+
+        if ((create_flags & Anvil::BufferCreateFlagBits::SPARSE_BINDING_BIT) != 0       ||
+             buffer_ptr->get_create_info_ptr()->get_parent_buffer_ptr()      != nullptr)
+        {
+            continue;
+        }
+
+        memory_block_ptr = buffer_ptr->get_memory_block(0 /* in_n_memory_block */);
+
+        if ( memory_block_ptr == nullptr                                ||
+             memory_block_ptr->is_persistently_mapped()                 ||
+           !m_vma_allocator_ptr->get_memory_block_allocation(memory_block_ptr,
+                                                            &allocation) )
+        {
+            continue;
+        }
+
+        allocations.push_back(allocation);
+        buffers.push_back    (buffer_ptr);
+    }
+
+    allocations_changed.resize(allocations.size(),
+                               VK_FALSE);
+
+    if (allocations.size() == 0)
+    {
+        result = true;
+
+        goto end;
+    }
+
+    defragmentation_info.maxAllocationsToMove = in_max_allocations_to_move;
+    defragmentation_info.maxBytesToMove       = in_max_bytes_to_move;
+
+    result_vk = vmaDefragment(m_vma_allocator_ptr->get_handle(),
+                             &allocations.at(0),
+                              allocations.size(),
+                             &allocations_changed.at(0),
+                             &defragmentation_info,
+                             &defragmentation_stats);
+
+    if (!is_vk_call_successful(result_vk) )
+    {
+        anvil_assert_vk_call_succeeded(result_vk);
+
+        goto end;
+    }
+
+    result = true;
+
+    /* Move each relocated buffer over to a memory block describing the allocation's new location */
+    for (uint32_t n_allocation = 0;
+                  n_allocation < static_cast<uint32_t>(allocations.size() );
+                ++n_allocation)
+    {
+        VmaAllocationInfo    allocation_info;
+        auto                 buffer_ptr                 = buffers.at(n_allocation);
+        MemoryBlockUniquePtr new_memory_block_ptr      (nullptr,
+                                                        std::default_delete<Anvil::MemoryBlock>() );
+        Anvil::MemoryBlock*  new_memory_block_raw_ptr   = nullptr;
+        auto                 old_memory_block_ptr       = buffer_ptr->get_memory_block(0 /* in_n_memory_block */);
+        const auto           old_create_info_ptr        = old_memory_block_ptr->get_create_info_ptr();
+        MemoryBlockUniquePtr old_owned_memory_block_ptr(nullptr,
+                                                        std::default_delete<Anvil::MemoryBlock>() );
+
+        if (allocations_changed.at(n_allocation) == VK_FALSE)
+        {
+            continue;
+        }
+
+        vmaGetAllocationInfo(m_vma_allocator_ptr->get_handle(),
+                             allocations.at(n_allocation),
+                            &allocation_info);
+
+        {
+            auto create_info_ptr = Anvil::MemoryBlockCreateInfo::create_derived_with_custom_delete_proc(m_device_ptr,
+                                                                                                        allocation_info.deviceMemory,
+                                                                                                        old_create_info_ptr->get_allowed_memory_bits         (),
+                                                                                                        old_create_info_ptr->get_memory_features             (),
+                                                                                                        allocation_info.memoryType,
+                                                                                                        old_create_info_ptr->get_size                        (),
+                                                                                                        allocation_info.offset,
+                                                                                                        old_create_info_ptr->get_on_release_callback_function() );
+
+            new_memory_block_ptr = Anvil::MemoryBlock::create(std::move(create_info_ptr) );
+        }
+
+        if (new_memory_block_ptr == nullptr)
+        {
+            anvil_assert(new_memory_block_ptr != nullptr);
+
+            result = false;
+            continue;
+        }
+
+        dynamic_cast<IMemoryBlockBackendSupport*>(new_memory_block_ptr.get() )->set_parent_memory_allocator_backend_ptr(shared_from_this(),
+                                                                                                                        allocations.at(n_allocation) );
+
+        /* The new block is not registered yet, so it does not return the allocation to VMA if the rebind fails and
+         * the block gets released. The old block is held onto until ownership has been transferred. */
+        new_memory_block_raw_ptr = new_memory_block_ptr.get();
+
+        if (!buffer_ptr->rebind_nonsparse_memory(std::move(new_memory_block_ptr),
+                                                &old_owned_memory_block_ptr) )
+        {
+            anvil_assert_fail();
+
+            result = false;
+            continue;
+        }
+
+        /* From now on, only the new block returns the allocation to VMA when released. */
+        m_vma_allocator_ptr->replace_memory_block(old_memory_block_ptr,
+                                                  new_memory_block_raw_ptr);
+
+        old_owned_memory_block_ptr.reset();
+
+        if (in_opt_buffer_moved_callback_function != nullptr)
+        {
+            in_opt_buffer_moved_callback_function(buffer_ptr);
+        }
+    }
+
+end:
+    if (out_opt_stats_ptr != nullptr)
+    {
+        out_opt_stats_ptr->n_allocations_moved           = defragmentation_stats.allocationsMoved;
+        out_opt_stats_ptr->n_bytes_freed                 = defragmentation_stats.bytesFreed;
+        out_opt_stats_ptr->n_bytes_moved                 = defragmentation_stats.bytesMoved;
+        out_opt_stats_ptr->n_device_memory_objects_freed = defragmentation_stats.deviceMemoryBlocksFreed;
+    }
+
+    return result;
+}
+
+/** Please see header for specification */
+void Anvil::MemoryAllocatorBackends::VMA::get_counter_snapshot(Anvil::MemoryAllocator::CounterSnapshot* out_result_ptr) const
+{
+    *out_result_ptr = m_vma_allocator_ptr->get_usage_tracker()->get_counter_snapshot();
+}
+
+/** Retrieves per-memory-type statistics from the VMA library. Walks all allocations, so can be expensive. */
+void Anvil::MemoryAllocatorBackends::VMA::get_memory_type_statistics(std::vector<Anvil::MemoryAllocator::MemoryStatistics>* out_result_ptr) const
+{
+    const uint32_t n_memory_types = static_cast<uint32_t>(m_device_ptr->get_physical_device_memory_properties().types.size() );
+    VmaStats       stats;
+
+    vmaCalculateStats(m_vma_allocator_ptr->get_handle(),
+                     &stats);
+
+    out_result_ptr->clear ();
+    out_result_ptr->resize(n_memory_types);
+
+    for (uint32_t n_memory_type = 0;
+                  n_memory_type < n_memory_types;
+                ++n_memory_type)
+    {
+        auto&       result_statistics = out_result_ptr->at(n_memory_type);
+        const auto& vma_statistics    = stats.memoryType[n_memory_type];
+
+        result_statistics.largest_free_range      = (vma_statistics.unusedRangeCount > 0) ? vma_statistics.unusedRangeSizeMax : 0;
+        result_statistics.n_allocations           = vma_statistics.allocationCount;
+        result_statistics.n_bytes_allocated       = vma_statistics.usedBytes + vma_statistics.unusedBytes;
+        result_statistics.n_bytes_free            = vma_statistics.unusedBytes;
+        result_statistics.n_bytes_used            = vma_statistics.usedBytes;
+        result_statistics.n_device_memory_objects = vma_statistics.blockCount;
+        result_statistics.n_free_ranges           = vma_statistics.unusedRangeCount;
+    }
+}
+
 /** Creates and stores a new VMAAllocator instance.
  *
  *  @return true if successful, false otherwise.
@@ -393,6 +713,23 @@ void Anvil::MemoryAllocatorBackends::VMA::VMAAllocator::on_vma_alloced_mem_block
     /* Only physically deallocate those memory blocks that are not derivatives of another memory blocks! */
     if (in_memory_block_ptr->get_create_info_ptr()->get_parent_memory_block() == nullptr)
     {
+        /* Blocks which have been superseded after their allocation was moved by defragment() no longer
+         * own the allocation. */
+        {
+            std::unique_lock<std::mutex> lock           (m_memory_block_allocations_mutex);
+            auto                         block_iterator = m_memory_block_allocations.find(in_memory_block_ptr);
+
+            if (block_iterator == m_memory_block_allocations.end() )
+            {
+                return;
+            }
+
+            m_memory_block_allocations.erase(block_iterator);
+        }
+
+        m_usage_tracker_ptr->on_allocation_released(in_memory_block_ptr->get_create_info_ptr()->get_memory_type_index(),
+                                                     in_memory_block_ptr->get_create_info_ptr()->get_size             () );
+
         vmaFreeMemory(get_handle(),
                       in_vma_allocation);
 
@@ -26,6 +26,7 @@
 #include "misc/image_create_info.h"
 #include "misc/memory_allocator.h"
 #include "misc/memalloc_backends/backend_oneshot.h"
+#include "misc/memalloc_backends/backend_tlsf.h"
 #include "misc/memalloc_backends/backend_vma.h"
 #include "wrappers/buffer.h"
 #include "wrappers/device.h"
@@ -34,6 +35,7 @@
 #include "wrappers/memory_block.h"
 #include "wrappers/queue.h"
 #include <set>
+#include <sstream>
 
 /* Please see header for specification */
 Anvil::MemoryAllocator::Item::Item(Anvil::MemoryAllocator*                     in_memory_allocator_ptr,
@@ -2023,6 +2025,160 @@ Anvil::MemoryAllocatorUniquePtr Anvil::MemoryAllocator::create_vma(const Anvil::
     return std::move(result_ptr);
 }
 
+/* Please see header for specification */
+void Anvil::MemoryAllocator::MemoryStatistics::accumulate(const MemoryStatistics& in_statistics)
+{
+    largest_free_range       = std::max(largest_free_range,
+                                        in_statistics.largest_free_range);
+    n_allocations           += in_statistics.n_allocations;
+    n_bytes_allocated       += in_statistics.n_bytes_allocated;
+    n_bytes_free            += in_statistics.n_bytes_free;
+    n_bytes_used            += in_statistics.n_bytes_used;
+    n_device_memory_objects += in_statistics.n_device_memory_objects;
+    n_free_ranges           += in_statistics.n_free_ranges;
+
+    fragmentation = (n_bytes_free > 0) ? 1.0f - static_cast<float>(largest_free_range) / static_cast<float>(n_bytes_free)
+                                       : 0.0f;
+}
+
+/* Please see header for specification */
+Anvil::MemoryAllocator::UsageTracker::UsageTracker(uint32_t in_n_memory_types)
+    :m_memory_type_statistics(in_n_memory_types)
+{
+    /* Stub */
+}
+
+/* Please see header for specification */
+Anvil::MemoryAllocator::CounterSnapshot Anvil::MemoryAllocator::UsageTracker::get_counter_snapshot() const
+{
+    std::unique_lock<std::mutex> lock  (m_mutex);
+    CounterSnapshot              result;
+
+    for (const auto& current_memory_type_statistics : m_memory_type_statistics)
+    {
+        result.n_allocations           += current_memory_type_statistics.n_allocations;
+        result.n_bytes_allocated       += current_memory_type_statistics.n_bytes_allocated;
+        result.n_bytes_used            += current_memory_type_statistics.n_bytes_used;
+        result.n_device_memory_objects += current_memory_type_statistics.n_device_memory_objects;
+    }
+
+    return result;
+}
+
+/* Please see header for specification */
+void Anvil::MemoryAllocator::UsageTracker::get_memory_type_statistics(std::vector<MemoryStatistics>* out_memory_type_statistics_ptr) const
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    *out_memory_type_statistics_ptr = m_memory_type_statistics;
+}
+
+/* Please see header for specification */
+void Anvil::MemoryAllocator::UsageTracker::on_allocation_made(uint32_t     in_memory_type_index,
+                                                              VkDeviceSize in_size)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    auto&                        memory_type_statistics = m_memory_type_statistics.at(in_memory_type_index);
+
+    memory_type_statistics.n_bytes_used += in_size;
+
+    ++memory_type_statistics.n_allocations;
+}
+
+/* Please see header for specification */
+void Anvil::MemoryAllocator::UsageTracker::on_allocation_released(uint32_t     in_memory_type_index,
+                                                                  VkDeviceSize in_size)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    auto&                        memory_type_statistics = m_memory_type_statistics.at(in_memory_type_index);
+
+    anvil_assert(memory_type_statistics.n_allocations >  0);
+    anvil_assert(memory_type_statistics.n_bytes_used  >= in_size);
+
+    memory_type_statistics.n_bytes_used -= in_size;
+
+    --memory_type_statistics.n_allocations;
+}
+
+/* Please see header for specification */
+void Anvil::MemoryAllocator::UsageTracker::on_device_memory_alloced(uint32_t     in_memory_type_index,
+                                                                    VkDeviceSize in_size)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    auto&                        memory_type_statistics = m_memory_type_statistics.at(in_memory_type_index);
+
+    memory_type_statistics.n_bytes_allocated += in_size;
+
+    ++memory_type_statistics.n_device_memory_objects;
+}
+
+/* Please see header for specification */
+void Anvil::MemoryAllocator::UsageTracker::on_device_memory_freed(uint32_t     in_memory_type_index,
+                                                                  VkDeviceSize in_size)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    auto&                        memory_type_statistics = m_memory_type_statistics.at(in_memory_type_index);
+
+    anvil_assert(memory_type_statistics.n_device_memory_objects >  0);
+    anvil_assert(memory_type_statistics.n_bytes_allocated       >= in_size);
+
+    memory_type_statistics.n_bytes_allocated -= in_size;
+
+    --memory_type_statistics.n_device_memory_objects;
+}
+
+/* Please see header for specification */
+void Anvil::MemoryAllocator::UsageTracker::on_dedicated_memory_block_alloced(const Anvil::MemoryBlock* in_memory_block_ptr)
+{
+    const uint32_t     memory_type_index = in_memory_block_ptr->get_create_info_ptr()->get_memory_type_index();
+    const VkDeviceSize size              = in_memory_block_ptr->get_create_info_ptr()->get_size();
+
+    anvil_assert(in_memory_block_ptr->get_create_info_ptr()->get_type() == Anvil::MemoryBlockType::REGULAR);
+
+    on_device_memory_alloced(memory_type_index,
+                             size);
+    on_allocation_made      (memory_type_index,
+                             size);
+}
+
+/* Please see header for specification */
+void Anvil::MemoryAllocator::UsageTracker::on_dedicated_memory_block_released(const Anvil::MemoryBlock* in_memory_block_ptr)
+{
+    const uint32_t     memory_type_index = in_memory_block_ptr->get_create_info_ptr()->get_memory_type_index();
+    const VkDeviceSize size              = in_memory_block_ptr->get_create_info_ptr()->get_size();
+
+    on_allocation_released(memory_type_index,
+                           size);
+    on_device_memory_freed(memory_type_index,
+                           size);
+}
+
+/* Please see header for specification */
+Anvil::MemoryAllocatorUniquePtr Anvil::MemoryAllocator::create_tlsf(const Anvil::BaseDevice* in_device_ptr,
+                                                                    MTSafety                 in_mt_safety,
+                                                                    VkDeviceSize             in_page_size)
+{
+    std::shared_ptr<IMemoryAllocatorBackend> backend_ptr;
+    const bool                               mt_safe    (Anvil::Utils::convert_mt_safety_enum_to_boolean(in_mt_safety,
+                                                                                                         in_device_ptr) );
+    std::unique_ptr<MemoryAllocator>         result_ptr(nullptr,
+                                                        std::default_delete<MemoryAllocator>() );
+
+    backend_ptr = Anvil::MemoryAllocatorBackends::TLSF::create(in_device_ptr,
+                                                               in_page_size);
+
+    if (backend_ptr != nullptr)
+    {
+        result_ptr.reset(
+            new Anvil::MemoryAllocator(in_device_ptr,
+                                       std::move(backend_ptr),
+                                       mt_safe)
+        );
+    }
+
+    return std::move(result_ptr);
+}
+
 bool Anvil::MemoryAllocator::do_external_memory_handle_type_sanity_checks(const Anvil::ExternalMemoryHandleTypeFlags& in_external_memory_handle_types) const
 {
     bool result = true;
@@ -2040,6 +2196,161 @@ bool Anvil::MemoryAllocator::do_external_memory_handle_type_sanity_checks(const
     return result;
 }
 
+/* Please see header for specification */
+bool Anvil::MemoryAllocator::defragment(uint32_t                           in_n_buffers,
+                                        Anvil::Buffer* const*              in_buffers_ptr,
+                                        MemoryAllocatorBufferMovedCallback in_opt_buffer_moved_callback_function,
+                                        DefragmentationStats*              out_opt_stats_ptr,
+                                        VkDeviceSize                       in_max_bytes_to_move,
+                                        uint32_t                           in_max_allocations_to_move)
+{
+    std::unique_lock<std::recursive_mutex> mutex_lock;
+    auto                                   mutex_ptr       = get_mutex();
+    bool                                   result          = false;
+    auto                                   vma_backend_ptr = dynamic_cast<Anvil::MemoryAllocatorBackends::VMA*>(m_backend_ptr.get() );
+
+    if (vma_backend_ptr == nullptr)
+    {
+        goto end;
+    }
+
+    if (mutex_ptr != nullptr)
+    {
+        mutex_lock = std::move(
+            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
+        );
+    }
+
+    result = vma_backend_ptr->defragment(in_n_buffers,
+                                         in_buffers_ptr,
+                                         in_max_bytes_to_move,
+                                         in_max_allocations_to_move,
+                                         in_opt_buffer_moved_callback_function,
+                                         out_opt_stats_ptr);
+
+end:
+    if (mutex_lock.owns_lock() )
+    {
+        mutex_lock.unlock();
+    }
+
+    return result;
+}
+
+/* Please see header for specification */
+Anvil::MemoryAllocator::CounterSnapshot Anvil::MemoryAllocator::get_counter_snapshot() const
+{
+    CounterSnapshot result;
+
+    m_backend_ptr->get_counter_snapshot(&result);
+
+    return result;
+}
+
+/* Please see header for specification */
+void Anvil::MemoryAllocator::get_statistics(MemoryStatisticsReport* out_result_ptr) const
+{
+    const auto& memory_props = m_device_ptr->get_physical_device_memory_properties();
+
+    *out_result_ptr = MemoryStatisticsReport();
+
+    m_backend_ptr->get_memory_type_statistics(&out_result_ptr->memory_types);
+
+    anvil_assert(out_result_ptr->memory_types.size() == memory_props.types.size() );
+
+    out_result_ptr->heaps.resize(memory_props.n_heaps);
+
+    for (uint32_t n_memory_type = 0;
+                  n_memory_type < static_cast<uint32_t>(out_result_ptr->memory_types.size() );
+                ++n_memory_type)
+    {
+        auto& memory_type_statistics = out_result_ptr->memory_types.at(n_memory_type);
+
+        /* Recalculates the fragmentation ratio */
+        memory_type_statistics.accumulate(MemoryStatistics() );
+
+        out_result_ptr->heaps.at(memory_props.types.at(n_memory_type).heap_ptr->index).accumulate(memory_type_statistics);
+        out_result_ptr->total.accumulate                                                         (memory_type_statistics);
+    }
+}
+
+/** Appends @param in_statistics to @param out_stream_ptr as a sequence of JSON object members. */
+static void write_memory_statistics_json(const Anvil::MemoryAllocator::MemoryStatistics& in_statistics,
+                                         std::stringstream*                              out_stream_ptr)
+{
+    *out_stream_ptr << "\"bytes_allocated\": "       << in_statistics.n_bytes_allocated       << ", "
+                    << "\"bytes_used\": "            << in_statistics.n_bytes_used            << ", "
+                    << "\"bytes_free\": "            << in_statistics.n_bytes_free            << ", "
+                    << "\"largest_free_range\": "    << in_statistics.largest_free_range      << ", "
+                    << "\"free_ranges\": "           << in_statistics.n_free_ranges           << ", "
+                    << "\"fragmentation\": "         << in_statistics.fragmentation           << ", "
+                    << "\"allocations\": "           << in_statistics.n_allocations           << ", "
+                    << "\"device_memory_objects\": " << in_statistics.n_device_memory_objects;
+}
+
+/* Please see header for specification */
+std::string Anvil::MemoryAllocator::get_statistics_json() const
+{
+    const auto&            memory_props = m_device_ptr->get_physical_device_memory_properties();
+    std::stringstream      result;
+    MemoryStatisticsReport statistics;
+
+    get_statistics(&statistics);
+
+    result << "{\n"
+              "    \"total\": {";
+
+    write_memory_statistics_json(statistics.total,
+                                &result);
+
+    result << "},\n"
+              "    \"heaps\": [";
+
+    for (uint32_t n_heap = 0;
+                  n_heap < static_cast<uint32_t>(statistics.heaps.size() );
+                ++n_heap)
+    {
+        result << ((n_heap == 0) ? "\n" : ",\n")
+               << "        {\"index\": "        << n_heap                                                                           << ", "
+               << "\"size\": "                  << memory_props.heaps[n_heap].size                                                  << ", "
+               << "\"device_local\": "          << (((memory_props.heaps[n_heap].flags & Anvil::MemoryHeapFlagBits::DEVICE_LOCAL_BIT) != 0) ? "true" : "false") << ", ";
+
+        write_memory_statistics_json(statistics.heaps.at(n_heap),
+                                    &result);
+
+        result << "}";
+    }
+
+    result << "\n    ],\n"
+              "    \"memory_types\": [";
+
+    for (uint32_t n_memory_type = 0;
+                  n_memory_type < static_cast<uint32_t>(statistics.memory_types.size() );
+                ++n_memory_type)
+    {
+        result << ((n_memory_type == 0) ? "\n" : ",\n")
+               << "        {\"index\": "      << n_memory_type                                            << ", "
+               << "\"heap_index\": "          << memory_props.types.at(n_memory_type).heap_ptr->index     << ", "
+               << "\"property_flags\": "      << memory_props.types.at(n_memory_type).flags.get_vk()      << ", ";
+
+        write_memory_statistics_json(statistics.memory_types.at(n_memory_type),
+                                    &result);
+
+        result << "}";
+    }
+
+    result << "\n    ]\n"
+              "}\n";
+
+    return result.str();
+}
+
+/* Please see header for specification */
+VkDeviceSize Anvil::MemoryAllocator::get_n_bytes_saved_by_item_reordering() const
+{
+    return m_backend_ptr->get_n_bytes_saved_by_item_reordering();
+}
+
 /** Tells whether or not a given set of memory types supports the requested memory features. */
 bool Anvil::MemoryAllocator::is_alloc_supported(uint32_t                  in_memory_types,
                                                 Anvil::MemoryFeatureFlags in_memory_features,
@@ -23,6 +23,7 @@
 #include "wrappers/memory_block.h"
 #include "misc/debug.h"
 #include "misc/page_tracker.h"
+#include <algorithm>
 
 /** Please see header for specification */
 Anvil::PageTracker::PageTracker(VkDeviceSize in_region_size,
@@ -38,12 +39,46 @@ Anvil::PageTracker::PageTracker(VkDeviceSize in_region_size,
 
 }
 
+/** Tells whether two bindings, the first of which ends where the second one starts, refer to contiguous
+ *  ranges of the same memory block and can be represented with a single binding.
+ **/
+static bool can_bindings_be_merged(const Anvil::PageTracker::MemoryBlockBinding& in_left_binding,
+                                   const Anvil::PageTracker::MemoryBlockBinding& in_right_binding)
+{
+    return (in_left_binding.memory_block_ptr                                  == in_right_binding.memory_block_ptr          &&
+            in_left_binding.start_offset              + in_left_binding.size == in_right_binding.start_offset              &&
+            in_left_binding.memory_block_start_offset + in_left_binding.size == in_right_binding.memory_block_start_offset);
+}
+
+/** Returns an iterator pointing at the binding which covers @param in_offset, or end() if the offset
+ *  is not bound to any memory block.
+ **/
+Anvil::PageTracker::MemoryBlockBindingMap::const_iterator Anvil::PageTracker::find_binding(VkDeviceSize in_offset) const
+{
+    auto binding_iterator = m_memory_blocks.upper_bound(in_offset);
+
+    if (binding_iterator == m_memory_blocks.begin() )
+    {
+        return m_memory_blocks.end();
+    }
+
+    --binding_iterator;
+
+    if (binding_iterator->second.start_offset + binding_iterator->second.size <= in_offset)
+    {
+        return m_memory_blocks.end();
+    }
+
+    return binding_iterator;
+}
+
 /** Please see header for specification */
 Anvil::MemoryBlock* Anvil::PageTracker::get_memory_block(VkDeviceSize  in_start_offset,
                                                          VkDeviceSize  in_size,
                                                          VkDeviceSize* out_memory_region_start_offset_ptr) const
 {
-    Anvil::MemoryBlock* result_ptr = nullptr;
+    MemoryBlockBindingMap::const_iterator binding_iterator;
+    Anvil::MemoryBlock*                   result_ptr       = nullptr;
 
     if (in_size > m_page_size)
     {
@@ -53,22 +88,88 @@ Anvil::MemoryBlock* Anvil::PageTracker::get_memory_block(VkDeviceSize  in_start_
     }
 
     /* Handle the request */
-    for (const auto& current_memory_block : m_memory_blocks)
+    binding_iterator = find_binding(in_start_offset);
+
+    if (binding_iterator                                                      != m_memory_blocks.end() &&
+        binding_iterator->second.start_offset + binding_iterator->second.size >= in_start_offset + in_size)
     {
-        if (current_memory_block.start_offset                             <= in_start_offset           &&
-            current_memory_block.start_offset + current_memory_block.size >= in_start_offset + in_size)
-        {
-            result_ptr                          = current_memory_block.memory_block_ptr;
-            *out_memory_region_start_offset_ptr = in_start_offset - current_memory_block.start_offset;
+        const auto& binding = binding_iterator->second;
 
-            break;
-        }
+        result_ptr                          = binding.memory_block_ptr;
+        *out_memory_region_start_offset_ptr = binding.memory_block_start_offset + (in_start_offset - binding.start_offset);
     }
 
 end:
     return result_ptr;
 }
 
+/** Please see header for specification */
+void Anvil::PageTracker::get_memory_blocks(VkDeviceSize                     in_start_offset,
+                                           VkDeviceSize                     in_size,
+                                           std::vector<MemoryBlockBinding>* out_bindings_ptr) const
+{
+    const VkDeviceSize end_offset       = in_start_offset + in_size;
+    auto               binding_iterator = find_binding(in_start_offset);
+
+    out_bindings_ptr->clear();
+
+    if (binding_iterator == m_memory_blocks.end() )
+    {
+        binding_iterator = m_memory_blocks.lower_bound(in_start_offset);
+    }
+
+    for (;
+         binding_iterator        != m_memory_blocks.end() &&
+         binding_iterator->first <  end_offset;
+       ++binding_iterator)
+    {
+        const auto&        binding              = binding_iterator->second;
+        const VkDeviceSize clipped_start_offset = std::max(binding.start_offset,                in_start_offset);
+        const VkDeviceSize clipped_end_offset   = std::min(binding.start_offset + binding.size, end_offset);
+
+        out_bindings_ptr->push_back(
+            MemoryBlockBinding(binding.memory_block_ptr,
+                               binding.memory_block_start_offset + (clipped_start_offset - binding.start_offset),
+                               clipped_end_offset - clipped_start_offset, /* in_size         */
+                               clipped_start_offset)                      /* in_start_offset */
+        );
+    }
+}
+
+/** Merges the specified binding with its neighbours, if they refer to contiguous ranges of the same memory block. */
+void Anvil::PageTracker::merge_binding(MemoryBlockBindingMap::iterator in_binding_iterator)
+{
+    auto binding_iterator = in_binding_iterator;
+
+    if (binding_iterator != m_memory_blocks.begin() )
+    {
+        auto prev_binding_iterator = std::prev(binding_iterator);
+
+        if (can_bindings_be_merged(prev_binding_iterator->second,
+                                   binding_iterator->second) )
+        {
+            prev_binding_iterator->second.size += binding_iterator->second.size;
+
+            m_memory_blocks.erase(binding_iterator);
+
+            binding_iterator = prev_binding_iterator;
+        }
+    }
+
+    {
+        auto next_binding_iterator = std::next(binding_iterator);
+
+        if (next_binding_iterator != m_memory_blocks.end() &&
+            can_bindings_be_merged(binding_iterator->second,
+                                   next_binding_iterator->second) )
+        {
+            binding_iterator->second.size += next_binding_iterator->second.size;
+
+            m_memory_blocks.erase(next_binding_iterator);
+        }
+    }
+}
+
 /** Please see header for specification */
 bool Anvil::PageTracker::set_binding(MemoryBlock* in_memory_block_ptr,
                                      VkDeviceSize in_memory_block_start_offset,
@@ -106,95 +207,30 @@ bool Anvil::PageTracker::set_binding(MemoryBlock* in_memory_block_ptr,
         goto end;
     }
 
-    /* Store the memory block binding */
-    for (auto mem_binding_iterator  = m_memory_blocks.begin();
-              mem_binding_iterator != m_memory_blocks.end();
-            ++mem_binding_iterator)
-    {
-        auto& mem_binding = *mem_binding_iterator;
+    /* Truncate bindings which stick out of the region and drop all bindings inside it. */
+    split_binding(in_start_offset);
+    split_binding(in_start_offset + in_size);
 
-        const bool does_not_overlap = (in_start_offset + in_size -1                    < mem_binding.start_offset || /* XXYY , X = new binding, Y = this binding */
-                                       mem_binding.start_offset + mem_binding.size - 1 < in_start_offset);           /* YYXX */
+    m_memory_blocks.erase(m_memory_blocks.lower_bound(in_start_offset),
+                          m_memory_blocks.lower_bound(in_start_offset + in_size) );
 
-        if (does_not_overlap)
-        {
-            continue;
-        }
-
-        /* There are four cases we need to handle separately :
-         *
-         * 1)  ###      - The new block _ interleaves with current memory block # from the left side.
-         *    __          Need to truncate # from the left side.
-         *
-         * 2)  ###      - The new block _ splits current memory block # in half.
-         *      _         Need to split # to two separate memory blocks.
-         *
-         * 3)  ###      - The new block _ interleaves with current memory block # from the right side.
-         *       __       Need to truncate # from the right side.
-         *
-         * 4)  ###      - The new block _ is going to be completely overwritten by _
-         *    _____       Need to remove it.
-         */
-        if ( in_start_offset            <=  mem_binding.start_offset                     &&
-             in_start_offset            <  (mem_binding.start_offset + mem_binding.size) &&
-            (in_start_offset + in_size) >=  mem_binding.start_offset                     &&
-            (in_start_offset + in_size) <  (mem_binding.start_offset + mem_binding.size) )
-        {
-            /* Case 1 */
-            mem_binding.size         -= in_start_offset + in_size - (mem_binding.start_offset);
-            mem_binding.start_offset  = in_start_offset + in_size;
-        }
-        else
-        if ( in_start_offset            >  mem_binding.start_offset                     &&
-             in_start_offset            < (mem_binding.start_offset + mem_binding.size) &&
-            (in_start_offset + in_size) >  mem_binding.start_offset                     &&
-            (in_start_offset + in_size) < (mem_binding.start_offset + mem_binding.size))
-        {
-            /* Case 2 */
-            MemoryBlockBinding left_half (mem_binding.memory_block_ptr,
-                                          mem_binding.memory_block_start_offset,
-                                          in_start_offset - mem_binding.start_offset, /* in_size         */
-                                          mem_binding.start_offset);                  /* in_start_offset */
-            MemoryBlockBinding right_half(mem_binding.memory_block_ptr,
-                                          mem_binding.memory_block_start_offset,
-                                          mem_binding.start_offset + mem_binding.size - (in_start_offset + in_size) + 1, /* in_size         */
-                                          in_start_offset + in_size);                                                    /* in_start_offset */
-
-            m_memory_blocks.push_back(left_half);
-            m_memory_blocks.push_back(right_half);
-
-            m_memory_blocks.erase(mem_binding_iterator);
-        }
-        else
-        if ( in_start_offset            >  mem_binding.start_offset                     &&
-             in_start_offset            > (mem_binding.start_offset + mem_binding.size) &&
-            (in_start_offset + in_size) >  mem_binding.start_offset                     &&
-            (in_start_offset + in_size) > (mem_binding.start_offset + mem_binding.size) )
-        {
-            /* Case 3 */
-            mem_binding.size = (mem_binding.start_offset + mem_binding.size) - in_start_offset + 1;
-        }
-        else
-        {
-            /* Must be case 4 */
-            anvil_assert( in_start_offset            <=  mem_binding.start_offset                     &&
-                         (in_start_offset + in_size) >= (mem_binding.start_offset + mem_binding.size) );
+    /* Store the memory block binding */
+    if (in_memory_block_ptr != nullptr &&
+        in_size             != 0)
+    {
+        auto insert_result = m_memory_blocks.insert(
+            std::make_pair(in_start_offset,
+                           MemoryBlockBinding(in_memory_block_ptr,
+                                              in_memory_block_start_offset,
+                                              in_size,
+                                              in_start_offset) )
+        );
 
-            m_memory_blocks.erase(mem_binding_iterator);
-        }
+        anvil_assert(insert_result.second);
 
-        /* No more than one memory binding can be assigned to the same memory region */
-        break;
+        merge_binding(insert_result.first);
     }
 
-    m_memory_blocks.push_back(
-        MemoryBlockBinding(
-            in_memory_block_ptr,
-            in_memory_block_start_offset,
-            in_size,
-            in_start_offset)
-        );
-
     /* Update page occupancy info */
     n_pages                    = static_cast<uint32_t>(in_size         / m_page_size);
     occupancy_item_start_index = static_cast<uint32_t>(in_start_offset / m_page_size);
@@ -233,4 +269,42 @@ bool Anvil::PageTracker::set_binding(MemoryBlock* in_memory_block_ptr,
     result = true;
 end:
     return result;
-}
\ No newline at end of file
+}
+
+/** Splits the binding which covers @param in_offset into two, so that one of them starts at @param in_offset.
+ *  Does nothing if no binding covers the offset, or if a binding already starts there.
+ **/
+void Anvil::PageTracker::split_binding(VkDeviceSize in_offset)
+{
+    auto binding_iterator = m_memory_blocks.upper_bound(in_offset);
+
+    if (binding_iterator == m_memory_blocks.begin() )
+    {
+        return;
+    }
+
+    --binding_iterator;
+
+    {
+        auto& binding = binding_iterator->second;
+
+        if (binding.start_offset                == in_offset ||
+            binding.start_offset + binding.size <= in_offset)
+        {
+            return;
+        }
+
+        {
+            const VkDeviceSize left_size = in_offset - binding.start_offset;
+
+            m_memory_blocks.insert(std::next(binding_iterator),
+                                   std::make_pair(in_offset,
+                                                  MemoryBlockBinding(binding.memory_block_ptr,
+                                                                     binding.memory_block_start_offset + left_size,
+                                                                     binding.size                      - left_size,
+                                                                     in_offset) ));
+
+            binding.size = left_size;
+        }
+    }
+}
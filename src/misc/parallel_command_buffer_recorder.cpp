@@ -0,0 +1,437 @@
+//
+// Copyright (c) 2017-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "misc/debug.h"
+#include "misc/parallel_command_buffer_recorder.h"
+#include "wrappers/command_buffer.h"
+#include "wrappers/command_pool.h"
+#include "wrappers/device.h"
+
+/* Number of secondary command buffers allocated in one go by per-worker command pools */
+static const uint32_t g_n_command_buffers_per_recycling_chunk = 16;
+
+
+/* Please see header for specification */
+Anvil::ParallelCommandBufferRecorder::ParallelCommandBufferRecorder(Anvil::BaseDevice* in_device_ptr,
+                                                                    uint32_t           in_n_frame_slots)
+    :m_device_ptr            (in_device_ptr),
+     m_n_frame_slots         (in_n_frame_slots),
+     m_batch_failed          (false),
+     m_batch_id              (0),
+     m_batch_framebuffer_ptr (nullptr),
+     m_batch_job_ptrs        (nullptr),
+     m_batch_n_frame_slot    (0),
+     m_batch_n_jobs_remaining(0),
+     m_batch_render_pass_ptr (nullptr),
+     m_batch_subpass_id      (0),
+     m_n_busy_workers        (0),
+     m_terminating           (false)
+{
+    /* Stub */
+}
+
+/* Please see header for specification */
+Anvil::ParallelCommandBufferRecorder::~ParallelCommandBufferRecorder()
+{
+    {
+        std::unique_lock<std::mutex> lock(m_batch_mutex);
+
+        m_terminating = true;
+    }
+
+    m_batch_started_cv.notify_all();
+
+    for (auto& current_thread : m_worker_threads)
+    {
+        current_thread.join();
+    }
+
+    /* Command buffers need to go back to their parent pools before the pools are released */
+    for (auto& current_data : m_worker_frame_slot_data)
+    {
+        current_data.command_buffer_ptrs.clear();
+        current_data.command_pool_ptr.reset   ();
+    }
+}
+
+/* Please see header for specification */
+Anvil::ParallelCommandBufferRecorderUniquePtr Anvil::ParallelCommandBufferRecorder::create(Anvil::BaseDevice* in_device_ptr,
+                                                                                            uint32_t           in_queue_family_index,
+                                                                                            uint32_t           in_n_frame_slots,
+                                                                                            uint32_t           in_n_worker_threads)
+{
+    Anvil::ParallelCommandBufferRecorderUniquePtr result_ptr(nullptr,
+                                                             std::default_delete<Anvil::ParallelCommandBufferRecorder>() );
+
+    anvil_assert(in_device_ptr    != nullptr);
+    anvil_assert(in_n_frame_slots >  0);
+
+    result_ptr.reset(
+        new Anvil::ParallelCommandBufferRecorder(in_device_ptr,
+                                                 in_n_frame_slots)
+    );
+
+    if (!result_ptr->init(in_queue_family_index,
+                          in_n_worker_threads) )
+    {
+        result_ptr.reset();
+    }
+
+    return result_ptr;
+}
+
+/** Creates per-worker command pools and job queues, and spawns worker threads.
+ *
+ *  @param in_queue_family_index Queue family to create the command pools for.
+ *  @param in_n_worker_threads   Number of worker threads to spawn.
+ *
+ *  @return true if successful, false otherwise.
+ **/
+bool Anvil::ParallelCommandBufferRecorder::init(uint32_t in_queue_family_index,
+                                                uint32_t in_n_worker_threads)
+{
+    const uint32_t n_workers = in_n_worker_threads + 1; /* Thread calling record() also executes jobs */
+    bool           result    = false;
+
+    m_worker_frame_slot_data.resize(m_n_frame_slots * n_workers);
+
+    for (auto& current_data : m_worker_frame_slot_data)
+    {
+        /* Each pool is only ever accessed by a single worker, so there is no need for any synchronization.
+         * Command buffers are recycled in bulk with a single pool reset per frame. */
+        current_data.command_pool_ptr = Anvil::CommandPool::create(m_device_ptr,
+                                                                   true,  /* in_transient_allocations_friendly */
+                                                                   false, /* in_support_per_cmdbuf_reset_ops   */
+                                                                   in_queue_family_index,
+                                                                   Anvil::MTSafety::DISABLED,
+                                                                   g_n_command_buffers_per_recycling_chunk);
+
+        if (current_data.command_pool_ptr == nullptr)
+        {
+            anvil_assert(current_data.command_pool_ptr != nullptr);
+
+            goto end;
+        }
+    }
+
+    for (uint32_t n_worker = 0;
+                  n_worker < n_workers;
+                ++n_worker)
+    {
+        m_worker_queue_ptrs.push_back(
+            std::unique_ptr<WorkerQueue>(new WorkerQueue() )
+        );
+    }
+
+    for (uint32_t n_worker_thread = 0;
+                  n_worker_thread < in_n_worker_threads;
+                ++n_worker_thread)
+    {
+        m_worker_threads.push_back(
+            std::thread(&ParallelCommandBufferRecorder::worker_thread_main,
+                        this,
+                        n_worker_thread + 1) /* in_n_worker */
+        );
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Retrieves the next job to execute for the specified worker. Jobs are taken from the back of the
+ *  worker's own queue first. Once it runs dry, jobs are stolen from the front of other workers' queues.
+ *
+ *  @param in_n_worker       Index of the worker to retrieve a job for.
+ *  @param out_job_index_ptr Deref will be set to the index of the job to execute. Must not be nullptr.
+ *
+ *  @return true if a job has been retrieved, false if there are no more jobs to execute.
+ **/
+bool Anvil::ParallelCommandBufferRecorder::pop_job(uint32_t  in_n_worker,
+                                                   uint32_t* out_job_index_ptr)
+{
+    const uint32_t n_workers = static_cast<uint32_t>(m_worker_queue_ptrs.size() );
+    bool           result    = false;
+
+    {
+        auto&                        own_queue = *m_worker_queue_ptrs.at(in_n_worker);
+        std::unique_lock<std::mutex> lock     (own_queue.mutex);
+
+        if (!own_queue.job_indices.empty() )
+        {
+            *out_job_index_ptr = own_queue.job_indices.back();
+            result             = true;
+
+            own_queue.job_indices.pop_back();
+
+            goto end;
+        }
+    }
+
+    for (uint32_t n_victim = 1;
+                  n_victim < n_workers;
+                ++n_victim)
+    {
+        auto&                        victim_queue = *m_worker_queue_ptrs.at( (in_n_worker + n_victim) % n_workers);
+        std::unique_lock<std::mutex> lock        (victim_queue.mutex);
+
+        if (!victim_queue.job_indices.empty() )
+        {
+            *out_job_index_ptr = victim_queue.job_indices.front();
+            result             = true;
+
+            victim_queue.job_indices.pop_front();
+
+            goto end;
+        }
+    }
+
+end:
+    return result;
+}
+
+/* Please see header for specification */
+bool Anvil::ParallelCommandBufferRecorder::record(Anvil::PrimaryCommandBuffer* in_primary_command_buffer_ptr,
+                                                  uint32_t                     in_n_frame_slot,
+                                                  Anvil::RenderPass*           in_render_pass_ptr,
+                                                  Anvil::SubPassID             in_subpass_id,
+                                                  Anvil::Framebuffer*          in_framebuffer_ptr,
+                                                  uint32_t                     in_n_jobs,
+                                                  const RecordingJob*          in_job_ptrs)
+{
+    const uint32_t n_workers = static_cast<uint32_t>(m_worker_queue_ptrs.size() );
+    bool           result    = false;
+
+    if (in_n_frame_slot >= m_n_frame_slots)
+    {
+        anvil_assert(in_n_frame_slot < m_n_frame_slots);
+
+        goto end;
+    }
+
+    if (in_n_jobs == 0)
+    {
+        result = true;
+
+        goto end;
+    }
+
+    /* Recycle command buffers recorded the last time this frame slot was used. */
+    for (uint32_t n_worker = 0;
+                  n_worker < n_workers;
+                ++n_worker)
+    {
+        auto& current_data = m_worker_frame_slot_data.at(in_n_frame_slot * n_workers + n_worker);
+
+        current_data.command_buffer_ptrs.clear();
+
+        if (!current_data.command_pool_ptr->reset(false /* in_release_resources */) )
+        {
+            anvil_assert_fail();
+
+            goto end;
+        }
+    }
+
+    /* Set up the batch. Workers which are still finishing the previous batch must not observe the new state
+     * until it is complete. */
+    {
+        std::unique_lock<std::mutex> lock(m_batch_mutex);
+
+        m_batch_finished_cv.wait(lock,
+                                 [this]()
+                                 {
+                                     return m_n_busy_workers == 0;
+                                 });
+
+        m_batch_command_buffer_ptrs.assign(in_n_jobs,
+                                           nullptr);
+
+        m_batch_failed           = false;
+        m_batch_framebuffer_ptr  = in_framebuffer_ptr;
+        m_batch_job_ptrs         = in_job_ptrs;
+        m_batch_n_frame_slot     = in_n_frame_slot;
+        m_batch_n_jobs_remaining = in_n_jobs;
+        m_batch_render_pass_ptr  = in_render_pass_ptr;
+        m_batch_subpass_id       = in_subpass_id;
+
+        /* Distribute jobs round-robin. Workers will steal from each other if the load turns out to be uneven. */
+        for (uint32_t n_job = 0;
+                      n_job < in_n_jobs;
+                    ++n_job)
+        {
+            m_worker_queue_ptrs.at(n_job % n_workers)->job_indices.push_front(n_job);
+        }
+
+        ++m_batch_id;
+        ++m_n_busy_workers;
+    }
+
+    m_batch_started_cv.notify_all();
+
+    run_jobs(0 /* in_n_worker */);
+
+    {
+        std::unique_lock<std::mutex> lock(m_batch_mutex);
+
+        --m_n_busy_workers;
+
+        m_batch_finished_cv.wait(lock,
+                                 [this]()
+                                 {
+                                     return m_batch_n_jobs_remaining == 0;
+                                 });
+    }
+
+    if (m_batch_failed)
+    {
+        goto end;
+    }
+
+    /* Execute the command buffers in the order of jobs, no matter which worker recorded them */
+    result = in_primary_command_buffer_ptr->record_execute_commands(in_n_jobs,
+                                                                    &m_batch_command_buffer_ptrs.at(0) );
+
+end:
+    return result;
+}
+
+/** Records a single job into a new secondary command buffer, allocated from the worker's command
+ *  pool for the current frame slot.
+ *
+ *  @param in_n_worker Index of the worker executing the job.
+ *  @param in_n_job    Index of the job to execute.
+ **/
+void Anvil::ParallelCommandBufferRecorder::record_job(uint32_t in_n_worker,
+                                                      uint32_t in_n_job)
+{
+    const uint32_t                         n_workers          = static_cast<uint32_t>(m_worker_queue_ptrs.size() );
+    auto&                                  worker_data        = m_worker_frame_slot_data.at(m_batch_n_frame_slot * n_workers + in_n_worker);
+    Anvil::SecondaryCommandBufferUniquePtr command_buffer_ptr = worker_data.command_pool_ptr->alloc_secondary_level_command_buffer();
+    bool                                   result             = false;
+
+    if (command_buffer_ptr == nullptr)
+    {
+        anvil_assert(command_buffer_ptr != nullptr);
+
+        goto end;
+    }
+
+    if (!command_buffer_ptr->start_recording(true,  /* in_one_time_submit          */
+                                             false, /* in_simultaneous_use_allowed */
+                                             (m_batch_render_pass_ptr != nullptr),
+                                             m_batch_framebuffer_ptr,
+                                             m_batch_render_pass_ptr,
+                                             m_batch_subpass_id,
+                                             Anvil::OcclusionQuerySupportScope::NOT_REQUIRED,
+                                             false, /* in_occlusion_query_used_by_primary_command_buffer */
+                                             Anvil::QueryPipelineStatisticFlags() ))
+    {
+        goto end;
+    }
+
+    m_batch_job_ptrs[in_n_job](command_buffer_ptr.get(),
+                               in_n_worker);
+
+    if (!command_buffer_ptr->stop_recording() )
+    {
+        goto end;
+    }
+
+    m_batch_command_buffer_ptrs.at(in_n_job) = command_buffer_ptr.get();
+
+    worker_data.command_buffer_ptrs.push_back(
+        std::move(command_buffer_ptr)
+    );
+
+    result = true;
+end:
+    if (!result)
+    {
+        m_batch_failed = true;
+    }
+
+    if (--m_batch_n_jobs_remaining == 0)
+    {
+        std::unique_lock<std::mutex> lock(m_batch_mutex);
+
+        m_batch_finished_cv.notify_all();
+    }
+}
+
+/** Executes jobs until none are left in any of the queues.
+ *
+ *  @param in_n_worker Index of the worker executing the jobs.
+ **/
+void Anvil::ParallelCommandBufferRecorder::run_jobs(uint32_t in_n_worker)
+{
+    uint32_t n_job = UINT32_MAX;
+
+    while (pop_job(in_n_worker,
+                  &n_job) )
+    {
+        record_job(in_n_worker,
+                   n_job);
+    }
+}
+
+/** Entry-point for worker threads.
+ *
+ *  @param in_n_worker Index of the worker the thread represents.
+ **/
+void Anvil::ParallelCommandBufferRecorder::worker_thread_main(uint32_t in_n_worker)
+{
+    uint64_t last_batch_id = 0;
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_batch_mutex);
+
+            m_batch_started_cv.wait(lock,
+                                    [this, last_batch_id]()
+                                    {
+                                        return m_terminating || m_batch_id != last_batch_id;
+                                    });
+
+            if (m_terminating)
+            {
+                break;
+            }
+
+            last_batch_id = m_batch_id;
+
+            ++m_n_busy_workers;
+        }
+
+        run_jobs(in_n_worker);
+
+        {
+            std::unique_lock<std::mutex> lock(m_batch_mutex);
+
+            if (--m_n_busy_workers == 0)
+            {
+                m_batch_finished_cv.notify_all();
+            }
+        }
+    }
+}
@@ -0,0 +1,623 @@
+//
+// Copyright (c) 2017-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "misc/buffer_create_info.h"
+#include "misc/debug.h"
+#include "misc/image_create_info.h"
+#include "misc/resource_state_tracker.h"
+#include "wrappers/buffer.h"
+#include "wrappers/command_buffer.h"
+#include "wrappers/command_pool.h"
+#include "wrappers/image.h"
+
+
+/* Please see header for specification */
+Anvil::ResourceStateTracker::ResourceStateTracker()
+{
+    /* Stub */
+}
+
+/* Please see header for specification */
+Anvil::ResourceStateTracker::~ResourceStateTracker()
+{
+    /* Stub */
+}
+
+/* Please see header for specification */
+Anvil::ResourceStateTrackerUniquePtr Anvil::ResourceStateTracker::create()
+{
+    Anvil::ResourceStateTrackerUniquePtr result_ptr(nullptr,
+                                                    std::default_delete<Anvil::ResourceStateTracker>() );
+
+    result_ptr.reset(
+        new Anvil::ResourceStateTracker()
+    );
+
+    return result_ptr;
+}
+
+/* Please see header for specification */
+void Anvil::ResourceStateTracker::forget_buffer(Anvil::Buffer* in_buffer_ptr)
+{
+    m_buffer_states.erase(in_buffer_ptr);
+}
+
+/* Please see header for specification */
+void Anvil::ResourceStateTracker::forget_image(Anvil::Image* in_image_ptr)
+{
+    m_image_states.erase(in_image_ptr);
+}
+
+/** Returns tracking state of the specified image, creating it if the image has not been seen before. */
+Anvil::ResourceStateTracker::ImageState* Anvil::ResourceStateTracker::get_image_state(Anvil::Image* in_image_ptr)
+{
+    auto state_iterator = m_image_states.find(in_image_ptr);
+
+    if (state_iterator == m_image_states.end() )
+    {
+        const Anvil::ImageCreateInfo* create_info_ptr = in_image_ptr->get_create_info_ptr();
+        Anvil::ImageLayout            initial_layout  = create_info_ptr->get_post_alloc_image_layout();
+        ImageState                    new_state;
+
+        if (initial_layout == Anvil::ImageLayout::UNDEFINED)
+        {
+            initial_layout = create_info_ptr->get_post_create_image_layout();
+        }
+
+        new_state.n_layers = create_info_ptr->get_n_layers();
+
+        new_state.subresource_states.resize(in_image_ptr->get_n_mipmaps() * new_state.n_layers,
+                                            AccessState(static_cast<VkImageLayout>(initial_layout) ));
+
+        state_iterator = m_image_states.insert(std::make_pair(in_image_ptr,
+                                                              new_state) ).first;
+    }
+
+    return &state_iterator->second;
+}
+
+/* Please see header for specification */
+Anvil::ResourceStateTracker::UsageInfo Anvil::ResourceStateTracker::get_usage_info(Usage in_usage)
+{
+    UsageInfo result;
+
+    result.access   = 0;
+    result.is_write = false;
+    result.layout   = VK_IMAGE_LAYOUT_GENERAL;
+    result.stages   = 0;
+
+    switch (in_usage)
+    {
+        case Usage::COLOR_ATTACHMENT:
+        {
+            result.access   = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+            result.is_write = true;
+            result.layout   = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+            result.stages   = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+
+            break;
+        }
+
+        case Usage::DEPTH_STENCIL_ATTACHMENT:
+        {
+            result.access   = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+            result.is_write = true;
+            result.layout   = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+            result.stages   = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+
+            break;
+        }
+
+        case Usage::DEPTH_STENCIL_READ_ONLY:
+        {
+            result.access = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
+            result.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+            result.stages = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+
+            break;
+        }
+
+        case Usage::HOST_READ:
+        {
+            result.access = VK_ACCESS_HOST_READ_BIT;
+            result.layout = VK_IMAGE_LAYOUT_GENERAL;
+            result.stages = VK_PIPELINE_STAGE_HOST_BIT;
+
+            break;
+        }
+
+        case Usage::INDEX_BUFFER:
+        {
+            result.access = VK_ACCESS_INDEX_READ_BIT;
+            result.stages = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
+
+            break;
+        }
+
+        case Usage::INDIRECT_BUFFER:
+        {
+            result.access = VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+            result.stages = VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
+
+            break;
+        }
+
+        case Usage::PRESENT:
+        {
+            /* Presentation engine accesses are synchronized with semaphores, so only the layout transition needs
+             * to be ordered against prior accesses. */
+            result.access = 0;
+            result.layout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+            result.stages = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+
+            break;
+        }
+
+        case Usage::SAMPLED_COMPUTE:
+        case Usage::SAMPLED_FRAGMENT:
+        case Usage::SAMPLED_VERTEX:
+        {
+            result.access = VK_ACCESS_SHADER_READ_BIT;
+            result.layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            result.stages = (in_usage == Usage::SAMPLED_COMPUTE)  ? VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT
+                          : (in_usage == Usage::SAMPLED_FRAGMENT) ? VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT
+                                                                  : VK_PIPELINE_STAGE_VERTEX_SHADER_BIT;
+
+            break;
+        }
+
+        case Usage::STORAGE_READ_COMPUTE:
+        case Usage::STORAGE_READ_FRAGMENT:
+        {
+            result.access = VK_ACCESS_SHADER_READ_BIT;
+            result.layout = VK_IMAGE_LAYOUT_GENERAL;
+            result.stages = (in_usage == Usage::STORAGE_READ_COMPUTE) ? VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT
+                                                                      : VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+
+            break;
+        }
+
+        case Usage::STORAGE_WRITE_COMPUTE:
+        case Usage::STORAGE_WRITE_FRAGMENT:
+        {
+            result.access   = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+            result.is_write = true;
+            result.layout   = VK_IMAGE_LAYOUT_GENERAL;
+            result.stages   = (in_usage == Usage::STORAGE_WRITE_COMPUTE) ? VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT
+                                                                         : VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+
+            break;
+        }
+
+        case Usage::TRANSFER_DST:
+        {
+            result.access   = VK_ACCESS_TRANSFER_WRITE_BIT;
+            result.is_write = true;
+            result.layout   = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            result.stages   = VK_PIPELINE_STAGE_TRANSFER_BIT;
+
+            break;
+        }
+
+        case Usage::TRANSFER_SRC:
+        {
+            result.access = VK_ACCESS_TRANSFER_READ_BIT;
+            result.layout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+            result.stages = VK_PIPELINE_STAGE_TRANSFER_BIT;
+
+            break;
+        }
+
+        case Usage::UNIFORM_BUFFER:
+        {
+            result.access = VK_ACCESS_UNIFORM_READ_BIT;
+            result.stages = VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+
+            break;
+        }
+
+        case Usage::VERTEX_BUFFER:
+        {
+            result.access = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT;
+            result.stages = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
+
+            break;
+        }
+
+        default:
+        {
+            anvil_assert_fail();
+        }
+    }
+
+    return result;
+}
+
+/* Please see header for specification */
+void Anvil::ResourceStateTracker::set_image_layout(Anvil::Image*      in_image_ptr,
+                                                  Anvil::ImageLayout in_layout)
+{
+    ImageState* image_state_ptr = get_image_state(in_image_ptr);
+
+    for (auto& subresource_state : image_state_ptr->subresource_states)
+    {
+        const uint32_t queue_family_index = subresource_state.queue_family_index;
+
+        subresource_state                    = AccessState(static_cast<VkImageLayout>(in_layout) );
+        subresource_state.queue_family_index = queue_family_index;
+    }
+}
+
+/** Updates the state of a single buffer range or image subresource for the specified usage, and tells
+ *  whether a barrier is needed before the resource can be used that way.
+ *
+ *  @param in_usage_info         Upcoming usage.
+ *  @param in_queue_family_index Queue family the resource is going to be used on.
+ *  @param in_is_exclusive       true if the resource uses exclusive sharing mode.
+ *  @param in_is_image           true if the state belongs to an image subresource. Layouts are ignored otherwise.
+ *  @param inout_state_ptr       State to update. Must not be nullptr.
+ *  @param out_barrier_info_ptr  If the function returns true, deref will be set to the source half of
+ *                               the barrier to record. Must not be nullptr.
+ *
+ *  @return true if a barrier is needed, false otherwise.
+ **/
+bool Anvil::ResourceStateTracker::transition(const UsageInfo& in_usage_info,
+                                             uint32_t         in_queue_family_index,
+                                             bool             in_is_exclusive,
+                                             bool             in_is_image,
+                                             AccessState*     inout_state_ptr,
+                                             BarrierInfo*     out_barrier_info_ptr)
+{
+    AccessState& state          = *inout_state_ptr;
+    const bool   changes_layout = (in_is_image && state.layout != in_usage_info.layout);
+    const bool   changes_owner  = (in_is_exclusive                                     &&
+                                   state.queue_family_index != VK_QUEUE_FAMILY_IGNORED &&
+                                   state.queue_family_index != in_queue_family_index);
+    bool         result         = false;
+
+    out_barrier_info_ptr->old_layout             = state.layout;
+    out_barrier_info_ptr->src_access             = state.write_access;
+    out_barrier_info_ptr->src_queue_family_index = (changes_owner) ? state.queue_family_index : VK_QUEUE_FAMILY_IGNORED;
+    out_barrier_info_ptr->src_stages             = state.write_stages;
+
+    if (!in_usage_info.is_write &&
+        !changes_layout         &&
+        !changes_owner)
+    {
+        /* Read after read needs no synchronization. Read after write only needs it if the stage has not been
+         * synchronized with the last write yet. */
+        if (state.write_stages != 0                                &&
+            ((in_usage_info.stages & ~state.read_stages)    != 0 ||
+             (in_usage_info.access & ~state.visible_access) != 0) )
+        {
+            result = true;
+        }
+
+        state.read_stages    |= in_usage_info.stages;
+        state.visible_access |= in_usage_info.access;
+    }
+    else
+    {
+        /* Writes and layout transitions need to wait for all prior accesses. Reads only need an execution
+         * dependency, so only the last write's accesses are made available. */
+        out_barrier_info_ptr->src_stages = state.write_stages | state.read_stages;
+
+        if (out_barrier_info_ptr->src_stages == 0)
+        {
+            out_barrier_info_ptr->src_stages = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+            result                           = (changes_layout || changes_owner);
+        }
+        else
+        {
+            result = true;
+        }
+
+        if (in_usage_info.is_write)
+        {
+            state.read_stages    = 0;
+            state.visible_access = 0;
+            state.write_access   = in_usage_info.access;
+            state.write_stages   = in_usage_info.stages;
+        }
+        else
+        {
+            /* The layout transition acts as the last write. Its results are visible to the stages of this barrier
+             * only, so other readers need to wait for these. */
+            state.read_stages    = in_usage_info.stages;
+            state.visible_access = in_usage_info.access;
+            state.write_access   = 0;
+            state.write_stages   = in_usage_info.stages;
+        }
+
+        if (in_is_image)
+        {
+            state.layout = in_usage_info.layout;
+        }
+    }
+
+    if (in_is_exclusive)
+    {
+        state.queue_family_index = in_queue_family_index;
+    }
+
+    return result;
+}
+
+/* Please see header for specification */
+bool Anvil::ResourceStateTracker::use_buffer(Anvil::CommandBufferBase* in_command_buffer_ptr,
+                                             Anvil::Buffer*            in_buffer_ptr,
+                                             Usage                     in_usage,
+                                             VkDeviceSize              in_offset,
+                                             VkDeviceSize              in_size)
+{
+    const VkDeviceSize   buffer_size        = in_buffer_ptr->get_create_info_ptr()->get_size();
+    VkDeviceSize         end;
+    const bool           is_exclusive       = (in_buffer_ptr->get_create_info_ptr()->get_sharing_mode() == Anvil::SharingMode::EXCLUSIVE);
+    const uint32_t       queue_family_index = in_command_buffer_ptr->get_parent_command_pool()->get_queue_family_index();
+    bool                 result             = true;
+    VkPipelineStageFlags src_stages         = 0;
+    const UsageInfo      usage_info         = get_usage_info(in_usage);
+
+    end = (in_size == VK_WHOLE_SIZE) ? buffer_size
+                                     : in_offset + in_size;
+
+    if (in_offset >= end ||
+        end       >  buffer_size)
+    {
+        anvil_assert(in_offset <  end);
+        anvil_assert(end       <= buffer_size);
+
+        result = false;
+        goto end;
+    }
+
+    {
+        auto&              ranges           = m_buffer_states[in_buffer_ptr];
+        const VkDeviceSize split_offsets[2] = {in_offset, end};
+
+        m_scratch_buffer_barriers.clear();
+
+        if (ranges.size() == 0)
+        {
+            ranges.push_back(BufferRangeState(0,
+                                              buffer_size) );
+        }
+
+        /* Split the ranges which straddle either end of the used region, so that each range is either fully
+         * inside or fully outside it. */
+        for (size_t n_range = 0;
+                    n_range < ranges.size();
+                  ++n_range)
+        {
+            for (uint32_t n_split_offset = 0;
+                          n_split_offset < sizeof(split_offsets) / sizeof(split_offsets[0]);
+                        ++n_split_offset)
+            {
+                const VkDeviceSize split_offset = split_offsets[n_split_offset];
+
+                if (ranges.at(n_range).start < split_offset &&
+                    ranges.at(n_range).end   > split_offset)
+                {
+                    BufferRangeState tail_range = ranges.at(n_range);
+
+                    tail_range.start       = split_offset;
+                    ranges.at(n_range).end = split_offset;
+
+                    ranges.insert(ranges.begin() + n_range + 1,
+                                  tail_range);
+                }
+            }
+        }
+
+        for (auto& current_range : ranges)
+        {
+            BarrierInfo barrier_info = BarrierInfo();
+
+            if (current_range.start <  in_offset ||
+                current_range.end   >  end)
+            {
+                continue;
+            }
+
+            if (!transition(usage_info,
+                            queue_family_index,
+                            is_exclusive,
+                            false, /* in_is_image */
+                           &current_range.state,
+                           &barrier_info) )
+            {
+                continue;
+            }
+
+            src_stages |= barrier_info.src_stages;
+
+            m_scratch_buffer_barriers.push_back(
+                Anvil::BufferBarrier(Anvil::AccessFlags(static_cast<Anvil::AccessFlagBits>(barrier_info.src_access) ),
+                                     Anvil::AccessFlags(static_cast<Anvil::AccessFlagBits>(usage_info.access) ),
+                                     barrier_info.src_queue_family_index,
+                                     (barrier_info.src_queue_family_index != VK_QUEUE_FAMILY_IGNORED) ? queue_family_index : VK_QUEUE_FAMILY_IGNORED,
+                                     in_buffer_ptr,
+                                     current_range.start,
+                                     current_range.end - current_range.start)
+            );
+        }
+
+        /* Coalesce neighbouring ranges which have ended up in the same state */
+        for (size_t n_range = 1;
+                    n_range < ranges.size();
+                    )
+        {
+            if (ranges.at(n_range - 1).state == ranges.at(n_range).state)
+            {
+                ranges.at(n_range - 1).end = ranges.at(n_range).end;
+
+                ranges.erase(ranges.begin() + n_range);
+            }
+            else
+            {
+                ++n_range;
+            }
+        }
+
+        if (m_scratch_buffer_barriers.size() > 0)
+        {
+            result = in_command_buffer_ptr->record_pipeline_barrier(Anvil::PipelineStageFlags(static_cast<Anvil::PipelineStageFlagBits>(src_stages) ),
+                                                                    Anvil::PipelineStageFlags(static_cast<Anvil::PipelineStageFlagBits>(usage_info.stages) ),
+                                                                    Anvil::DependencyFlags(),
+                                                                    0,       /* in_memory_barrier_count */
+                                                                    nullptr, /* in_memory_barriers_ptr  */
+                                                                    static_cast<uint32_t>(m_scratch_buffer_barriers.size() ),
+                                                                   &m_scratch_buffer_barriers.at(0),
+                                                                    0,        /* in_image_memory_barrier_count */
+                                                                    nullptr); /* in_image_memory_barriers_ptr  */
+        }
+    }
+
+end:
+    return result;
+}
+
+/* Please see header for specification */
+bool Anvil::ResourceStateTracker::use_image(Anvil::CommandBufferBase*           in_command_buffer_ptr,
+                                            Anvil::Image*                       in_image_ptr,
+                                            Usage                               in_usage,
+                                            const Anvil::ImageSubresourceRange* in_opt_subresource_ptr)
+{
+    ImageState*                  image_state_ptr    = get_image_state(in_image_ptr);
+    const bool                   is_exclusive       = (in_image_ptr->get_create_info_ptr()->get_sharing_mode() == Anvil::SharingMode::EXCLUSIVE);
+    const uint32_t               n_mips             = in_image_ptr->get_n_mipmaps();
+    const uint32_t               queue_family_index = in_command_buffer_ptr->get_parent_command_pool()->get_queue_family_index();
+    Anvil::ImageSubresourceRange range              = (in_opt_subresource_ptr != nullptr) ? *in_opt_subresource_ptr
+                                                                                          : in_image_ptr->get_subresource_range();
+    bool                         result             = true;
+    VkPipelineStageFlags         src_stages         = 0;
+    const UsageInfo              usage_info         = get_usage_info(in_usage);
+
+    if (range.layer_count == VK_REMAINING_ARRAY_LAYERS)
+    {
+        range.layer_count = image_state_ptr->n_layers - range.base_array_layer;
+    }
+
+    if (range.level_count == VK_REMAINING_MIP_LEVELS)
+    {
+        range.level_count = n_mips - range.base_mip_level;
+    }
+
+    if (range.base_array_layer + range.layer_count > image_state_ptr->n_layers ||
+        range.base_mip_level   + range.level_count > n_mips)
+    {
+        anvil_assert(range.base_array_layer + range.layer_count <= image_state_ptr->n_layers);
+        anvil_assert(range.base_mip_level   + range.level_count <= n_mips);
+
+        result = false;
+        goto end;
+    }
+
+    m_scratch_image_barriers.clear();
+
+    for (uint32_t n_mip = range.base_mip_level;
+                  n_mip < range.base_mip_level + range.level_count;
+                ++n_mip)
+    {
+        /* Subresources are processed layer by layer. Consecutive layers which need the same barrier share
+         * a single image barrier. */
+        BarrierInfo run_barrier_info = BarrierInfo();
+        uint32_t    run_n_layers     = 0;
+        uint32_t    run_start_layer  = 0;
+
+        for (uint32_t n_layer = range.base_array_layer;
+                      n_layer < range.base_array_layer + range.layer_count + 1;
+                    ++n_layer)
+        {
+            BarrierInfo barrier_info  = BarrierInfo();
+            bool        needs_barrier = false;
+
+            if (n_layer < range.base_array_layer + range.layer_count)
+            {
+                needs_barrier = transition(usage_info,
+                                           queue_family_index,
+                                           is_exclusive,
+                                           true, /* in_is_image */
+                                          &image_state_ptr->subresource_states.at(n_mip * image_state_ptr->n_layers + n_layer),
+                                          &barrier_info);
+            }
+
+            if (run_n_layers > 0 &&
+                needs_barrier    &&
+                run_barrier_info == barrier_info)
+            {
+                ++run_n_layers;
+
+                continue;
+            }
+
+            if (run_n_layers > 0)
+            {
+                Anvil::ImageSubresourceRange run_range;
+
+                run_range.aspect_mask      = range.aspect_mask;
+                run_range.base_array_layer = run_start_layer;
+                run_range.base_mip_level   = n_mip;
+                run_range.layer_count      = run_n_layers;
+                run_range.level_count      = 1;
+
+                src_stages |= run_barrier_info.src_stages;
+
+                m_scratch_image_barriers.push_back(
+                    Anvil::ImageBarrier(Anvil::AccessFlags(static_cast<Anvil::AccessFlagBits>(run_barrier_info.src_access) ),
+                                        Anvil::AccessFlags(static_cast<Anvil::AccessFlagBits>(usage_info.access) ),
+                                        static_cast<Anvil::ImageLayout>(run_barrier_info.old_layout),
+                                        static_cast<Anvil::ImageLayout>(usage_info.layout),
+                                        run_barrier_info.src_queue_family_index,
+                                        (run_barrier_info.src_queue_family_index != VK_QUEUE_FAMILY_IGNORED) ? queue_family_index : VK_QUEUE_FAMILY_IGNORED,
+                                        in_image_ptr,
+                                        run_range)
+                );
+
+                run_n_layers = 0;
+            }
+
+            if (needs_barrier)
+            {
+                run_barrier_info = barrier_info;
+                run_n_layers     = 1;
+                run_start_layer  = n_layer;
+            }
+        }
+    }
+
+    if (m_scratch_image_barriers.size() > 0)
+    {
+        result = in_command_buffer_ptr->record_pipeline_barrier(Anvil::PipelineStageFlags(static_cast<Anvil::PipelineStageFlagBits>(src_stages) ),
+                                                                Anvil::PipelineStageFlags(static_cast<Anvil::PipelineStageFlagBits>(usage_info.stages) ),
+                                                                Anvil::DependencyFlags(),
+                                                                0,       /* in_memory_barrier_count        */
+                                                                nullptr, /* in_memory_barriers_ptr         */
+                                                                0,       /* in_buffer_memory_barrier_count */
+                                                                nullptr, /* in_buffer_memory_barriers_ptr  */
+                                                                static_cast<uint32_t>(m_scratch_image_barriers.size() ),
+                                                               &m_scratch_image_barriers.at(0) );
+    }
+
+end:
+    return result;
+}
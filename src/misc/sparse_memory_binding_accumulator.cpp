@@ -0,0 +1,359 @@
+//
+// Copyright (c) 2017-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "misc/debug.h"
+#include "misc/sparse_memory_binding_accumulator.h"
+#include "wrappers/image.h"
+#include "wrappers/queue.h"
+
+
+/* Please see header for specification */
+Anvil::SparseMemoryBindingAccumulator::SparseMemoryBindingAccumulator(bool in_mt_safe)
+    :MTSafetySupportProvider(in_mt_safe),
+     m_n_appended_updates   (0),
+     m_n_pending_updates    (0)
+{
+    /* Stub */
+}
+
+/* Please see header for specification */
+Anvil::SparseMemoryBindingAccumulator::~SparseMemoryBindingAccumulator()
+{
+    /* Stub */
+}
+
+/* Please see header for specification */
+void Anvil::SparseMemoryBindingAccumulator::add_signal_semaphore(Anvil::Semaphore* in_semaphore_ptr)
+{
+    anvil_assert(in_semaphore_ptr != nullptr);
+
+    lock();
+    {
+        m_signal_semaphores.push_back(in_semaphore_ptr);
+    }
+    unlock();
+}
+
+/* Please see header for specification */
+void Anvil::SparseMemoryBindingAccumulator::add_wait_semaphore(Anvil::Semaphore* in_semaphore_ptr)
+{
+    anvil_assert(in_semaphore_ptr != nullptr);
+
+    lock();
+    {
+        m_wait_semaphores.push_back(in_semaphore_ptr);
+    }
+    unlock();
+}
+
+/* Please see header for specification */
+void Anvil::SparseMemoryBindingAccumulator::append_buffer_memory_update(Anvil::Buffer*      in_buffer_ptr,
+                                                                        VkDeviceSize        in_buffer_memory_start_offset,
+                                                                        Anvil::MemoryBlock* in_memory_block_ptr,
+                                                                        VkDeviceSize        in_memory_block_start_offset,
+                                                                        bool                in_memory_block_owned_by_buffer,
+                                                                        VkDeviceSize        in_size)
+{
+    GeneralUpdate update;
+
+    anvil_assert(in_buffer_ptr != nullptr);
+
+    update.flags                        = Anvil::SparseMemoryBindFlagBits::NONE;
+    update.memory_block_owned_by_target = in_memory_block_owned_by_buffer;
+    update.memory_block_ptr             = in_memory_block_ptr;
+    update.memory_block_start_offset    = in_memory_block_start_offset;
+    update.resource_offset              = in_buffer_memory_start_offset;
+    update.size                         = in_size;
+
+    lock();
+    {
+        if (!append_general_update(&m_buffer_updates[in_buffer_ptr],
+                                    update) )
+        {
+            ++m_n_pending_updates;
+        }
+
+        ++m_n_appended_updates;
+    }
+    unlock();
+}
+
+/** Merges the specified update into the last update of the vector if the former continues the latter, both in
+ *  resource and in memory space. Otherwise, appends the update to the vector.
+ *
+ *  @return true if the update has been merged, false if it has been appended.
+ **/
+bool Anvil::SparseMemoryBindingAccumulator::append_general_update(std::vector<GeneralUpdate>* in_updates_ptr,
+                                                                  const GeneralUpdate&        in_update)
+{
+    bool result = false;
+
+    if (!in_updates_ptr->empty() )
+    {
+        GeneralUpdate& last_update = in_updates_ptr->back();
+
+        if (!last_update.memory_block_owned_by_target                                   &&
+            !in_update.memory_block_owned_by_target                                     &&
+             last_update.flags            == in_update.flags                            &&
+             last_update.memory_block_ptr == in_update.memory_block_ptr                 &&
+             last_update.resource_offset + last_update.size == in_update.resource_offset)
+        {
+            /* Unbind operations do not refer to any memory, so only the resource ranges need to line up for them */
+            if (in_update.memory_block_ptr                                        == nullptr ||
+                last_update.memory_block_start_offset + last_update.size == in_update.memory_block_start_offset)
+            {
+                last_update.size += in_update.size;
+
+                result = true;
+            }
+        }
+    }
+
+    if (!result)
+    {
+        in_updates_ptr->push_back(in_update);
+    }
+
+    return result;
+}
+
+/* Please see header for specification */
+void Anvil::SparseMemoryBindingAccumulator::append_image_memory_update(Anvil::Image*                  in_image_ptr,
+                                                                       const Anvil::ImageSubresource& in_subresource,
+                                                                       const VkOffset3D&              in_offset,
+                                                                       const VkExtent3D&              in_extent,
+                                                                       Anvil::MemoryBlock*            in_opt_memory_block_ptr,
+                                                                       VkDeviceSize                   in_opt_memory_block_start_offset,
+                                                                       bool                           in_opt_memory_block_owned_by_image)
+{
+    const Anvil::SparseImageAspectProperties* aspect_props_ptr = nullptr;
+    bool                                      is_merged        = false;
+    ImageUpdate                               update;
+
+    anvil_assert(in_image_ptr != nullptr);
+
+    update.extent                      = in_extent;
+    update.memory_block_owned_by_image = in_opt_memory_block_owned_by_image;
+    update.memory_block_ptr            = in_opt_memory_block_ptr;
+    update.memory_block_start_offset   = in_opt_memory_block_start_offset;
+    update.offset                      = in_offset;
+    update.subresource                 = in_subresource;
+
+    in_image_ptr->get_sparse_image_aspect_properties(static_cast<Anvil::ImageAspectFlagBits>(in_subresource.aspect_mask.get_vk() ),
+                                                    &aspect_props_ptr);
+
+    lock();
+    {
+        auto& image_updates = m_image_updates[in_image_ptr];
+
+        if (!image_updates.empty()    &&
+             aspect_props_ptr != nullptr)
+        {
+            ImageUpdate&      last_update = image_updates.back();
+            const VkExtent3D& granularity = aspect_props_ptr->granularity;
+
+            /* Memory is bound to tiles in X-Y-Z order, so two updates can only be merged into one if they both cover
+             * a single row of tiles, and the tiles of the second one follow the tiles of the first one. Only the last
+             * update of a row can end with a partial tile. */
+            if (!last_update.memory_block_owned_by_image                                     &&
+                !update.memory_block_owned_by_image                                          &&
+                 last_update.memory_block_ptr          == update.memory_block_ptr            &&
+                 last_update.subresource.aspect_mask   == update.subresource.aspect_mask     &&
+                 last_update.subresource.array_layer   == update.subresource.array_layer     &&
+                 last_update.subresource.mip_level     == update.subresource.mip_level       &&
+                 last_update.offset.y                  == update.offset.y                    &&
+                 last_update.offset.z                  == update.offset.z                    &&
+                 last_update.extent.height             == update.extent.height               &&
+                 last_update.extent.depth              == update.extent.depth                &&
+                 last_update.extent.height             <= granularity.height                 &&
+                 last_update.extent.depth              <= granularity.depth                  &&
+                (last_update.extent.width % granularity.width) == 0                          &&
+                 last_update.offset.x + static_cast<int32_t>(last_update.extent.width) == update.offset.x)
+            {
+                const VkDeviceSize last_update_size = (last_update.extent.width / granularity.width) * in_image_ptr->get_memory_requirements().alignment;
+
+                if (update.memory_block_ptr                                        == nullptr ||
+                    last_update.memory_block_start_offset + last_update_size == update.memory_block_start_offset)
+                {
+                    last_update.extent.width += update.extent.width;
+
+                    is_merged = true;
+                }
+            }
+        }
+
+        if (!is_merged)
+        {
+            image_updates.push_back(update);
+
+            ++m_n_pending_updates;
+        }
+
+        ++m_n_appended_updates;
+    }
+    unlock();
+}
+
+/* Please see header for specification */
+void Anvil::SparseMemoryBindingAccumulator::append_opaque_image_memory_update(Anvil::Image*                in_image_ptr,
+                                                                              VkDeviceSize                 in_resource_offset,
+                                                                              VkDeviceSize                 in_size,
+                                                                              Anvil::SparseMemoryBindFlags in_flags,
+                                                                              Anvil::MemoryBlock*          in_opt_memory_block_ptr,
+                                                                              VkDeviceSize                 in_opt_memory_block_start_offset,
+                                                                              bool                         in_opt_memory_block_owned_by_image)
+{
+    GeneralUpdate update;
+
+    anvil_assert(in_image_ptr != nullptr);
+
+    update.flags                        = in_flags;
+    update.memory_block_owned_by_target = in_opt_memory_block_owned_by_image;
+    update.memory_block_ptr             = in_opt_memory_block_ptr;
+    update.memory_block_start_offset    = in_opt_memory_block_start_offset;
+    update.resource_offset              = in_resource_offset;
+    update.size                         = in_size;
+
+    lock();
+    {
+        if (!append_general_update(&m_image_opaque_updates[in_image_ptr],
+                                    update) )
+        {
+            ++m_n_pending_updates;
+        }
+
+        ++m_n_appended_updates;
+    }
+    unlock();
+}
+
+/* Please see header for specification */
+Anvil::SparseMemoryBindingAccumulatorUniquePtr Anvil::SparseMemoryBindingAccumulator::create(bool in_mt_safe)
+{
+    Anvil::SparseMemoryBindingAccumulatorUniquePtr result_ptr(nullptr,
+                                                              std::default_delete<Anvil::SparseMemoryBindingAccumulator>() );
+
+    result_ptr.reset(
+        new Anvil::SparseMemoryBindingAccumulator(in_mt_safe)
+    );
+
+    return result_ptr;
+}
+
+/* Please see header for specification */
+bool Anvil::SparseMemoryBindingAccumulator::submit(Anvil::Queue* in_queue_ptr,
+                                                   Anvil::Fence* in_opt_fence_ptr)
+{
+    Anvil::SparseMemoryBindInfoID        bind_info_id;
+    bool                                 result       = true;
+    Anvil::SparseMemoryBindingUpdateInfo update;
+
+    anvil_assert(in_queue_ptr != nullptr);
+
+    lock();
+    {
+        if (m_n_pending_updates == 0       &&
+            m_signal_semaphores.empty()    &&
+            m_wait_semaphores.empty()      &&
+            in_opt_fence_ptr    == nullptr)
+        {
+            goto end;
+        }
+
+        bind_info_id = update.add_bind_info(static_cast<uint32_t>(m_signal_semaphores.size() ),
+                                            (m_signal_semaphores.size() > 0) ? &m_signal_semaphores.at(0) : nullptr,
+                                            static_cast<uint32_t>(m_wait_semaphores.size() ),
+                                            (m_wait_semaphores.size()   > 0) ? &m_wait_semaphores.at(0)   : nullptr);
+
+        for (const auto& buffer_updates : m_buffer_updates)
+        {
+            for (const auto& current_update : buffer_updates.second)
+            {
+                update.append_buffer_memory_update(bind_info_id,
+                                                   buffer_updates.first,
+                                                   current_update.resource_offset,
+                                                   current_update.memory_block_ptr,
+                                                   current_update.memory_block_start_offset,
+                                                   current_update.memory_block_owned_by_target,
+                                                   current_update.size);
+            }
+        }
+
+        for (const auto& image_updates : m_image_updates)
+        {
+            for (const auto& current_update : image_updates.second)
+            {
+                update.append_image_memory_update(bind_info_id,
+                                                  image_updates.first,
+                                                  current_update.subresource,
+                                                  current_update.offset,
+                                                  current_update.extent,
+                                                  Anvil::SparseMemoryBindFlagBits::NONE,
+                                                  current_update.memory_block_ptr,
+                                                  current_update.memory_block_start_offset,
+                                                  current_update.memory_block_owned_by_image);
+            }
+        }
+
+        for (const auto& image_opaque_updates : m_image_opaque_updates)
+        {
+            for (const auto& current_update : image_opaque_updates.second)
+            {
+                update.append_opaque_image_memory_update(bind_info_id,
+                                                         image_opaque_updates.first,
+                                                         current_update.resource_offset,
+                                                         current_update.size,
+                                                         current_update.flags,
+                                                         current_update.memory_block_ptr,
+                                                         current_update.memory_block_start_offset,
+                                                         current_update.memory_block_owned_by_target);
+            }
+        }
+
+        update.set_fence(in_opt_fence_ptr);
+
+        result = in_queue_ptr->bind_sparse_memory(update);
+
+        reset();
+    }
+end:
+    unlock();
+
+    return result;
+}
+
+/* Please see header for specification */
+void Anvil::SparseMemoryBindingAccumulator::reset()
+{
+    lock();
+    {
+        m_buffer_updates.clear      ();
+        m_image_opaque_updates.clear();
+        m_image_updates.clear       ();
+        m_signal_semaphores.clear   ();
+        m_wait_semaphores.clear     ();
+
+        m_n_appended_updates = 0;
+        m_n_pending_updates  = 0;
+    }
+    unlock();
+}
@@ -0,0 +1,672 @@
+//
+// Copyright (c) 2017-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "misc/debug.h"
+#include "misc/image_create_info.h"
+#include "misc/memory_block_create_info.h"
+#include "misc/semaphore_create_info.h"
+#include "misc/sparse_memory_binding_accumulator.h"
+#include "misc/sparse_texture_streamer.h"
+#include "misc/staging_ring.h"
+#include "wrappers/device.h"
+#include "wrappers/image.h"
+#include "wrappers/memory_block.h"
+#include "wrappers/queue.h"
+#include "wrappers/semaphore.h"
+#include <algorithm>
+
+
+/* Please see header for specification */
+bool Anvil::SparseTextureStreamer::TileID::operator<(const TileID& in_tile_id) const
+{
+    if (aspect != in_tile_id.aspect)
+    {
+        return (static_cast<uint32_t>(aspect) < static_cast<uint32_t>(in_tile_id.aspect) );
+    }
+
+    if (n_layer != in_tile_id.n_layer)
+    {
+        return (n_layer < in_tile_id.n_layer);
+    }
+
+    if (n_mip != in_tile_id.n_mip)
+    {
+        return (n_mip < in_tile_id.n_mip);
+    }
+
+    /* Order tiles the same way Image linearizes them, so that tiles of a single row end up next to each other */
+    if (z != in_tile_id.z)
+    {
+        return (z < in_tile_id.z);
+    }
+
+    if (y != in_tile_id.y)
+    {
+        return (y < in_tile_id.y);
+    }
+
+    return (x < in_tile_id.x);
+}
+
+/* Please see header for specification */
+Anvil::SparseTextureStreamer::SparseTextureStreamer(Anvil::Image*      in_image_ptr,
+                                                    Anvil::ImageLayout in_image_layout,
+                                                    uint32_t           in_n_pages,
+                                                    Anvil::Queue*      in_sparse_queue_ptr,
+                                                    Anvil::Queue*      in_transfer_queue_ptr,
+                                                    bool               in_mt_safe)
+    :MTSafetySupportProvider(in_mt_safe),
+     m_image_ptr            (in_image_ptr),
+     m_image_layout         (in_image_layout),
+     m_n_current_batch      (0),
+     m_n_pages              (in_n_pages),
+     m_page_size            (0),
+     m_pending_page_reuse   (false),
+     m_sparse_queue_ptr     (in_sparse_queue_ptr),
+     m_transfer_queue_ptr   (in_transfer_queue_ptr)
+{
+    /* Stub */
+}
+
+/* Please see header for specification */
+Anvil::SparseTextureStreamer::~SparseTextureStreamer()
+{
+    /* The staging ring is the last object init() creates */
+    if (m_pool_memory_block_ptr != nullptr &&
+        m_staging_ring_ptr      != nullptr)
+    {
+        /* Do not leave the image's tiles bound to pages which are about to be released */
+        while (!m_resident_tiles.empty() )
+        {
+            unassign_page(m_resident_tiles.begin() );
+        }
+
+        flush();
+
+        /* flush() does not wait for the binds to execute. Bind semaphores must also be idle before they are
+         * released. */
+        m_staging_ring_ptr->flush(true); /* in_should_block */
+        m_sparse_queue_ptr->wait_idle();
+    }
+}
+
+/** Returns a semaphore for a bind submission to signal and a staging ring batch to wait on. Semaphores are
+ *  recycled once the batch which waited on them retires, so that they are never signalled twice without being
+ *  waited on in between.
+ *
+ *  The caller takes ownership of the semaphore. flush() hands it back to m_bind_semaphores once the bind
+ *  submission has succeeded, or to m_unused_bind_semaphore_ptr if it has failed.
+ **/
+Anvil::SemaphoreUniquePtr Anvil::SparseTextureStreamer::acquire_bind_semaphore()
+{
+    Anvil::SemaphoreUniquePtr result_ptr;
+
+    if (m_unused_bind_semaphore_ptr != nullptr)
+    {
+        result_ptr = std::move(m_unused_bind_semaphore_ptr);
+    }
+    else
+    if (!m_bind_semaphores.empty()                                                             &&
+         m_staging_ring_ptr->is_batch_retired(m_bind_semaphores.front().staging_ring_batch_id) )
+    {
+        result_ptr = std::move(m_bind_semaphores.front().semaphore_ptr);
+
+        m_bind_semaphores.pop_front();
+    }
+    else
+    {
+        result_ptr = Anvil::Semaphore::create(Anvil::SemaphoreCreateInfo::create(m_image_ptr->get_create_info_ptr()->get_device() ));
+
+        anvil_assert(result_ptr != nullptr);
+    }
+
+    return result_ptr;
+}
+
+/* Please see header for specification */
+void Anvil::SparseTextureStreamer::add_signal_semaphore(Anvil::Semaphore* in_semaphore_ptr)
+{
+    anvil_assert(in_semaphore_ptr != nullptr);
+
+    lock();
+    {
+        m_signal_semaphores.push_back(in_semaphore_ptr);
+    }
+    unlock();
+}
+
+/* Please see header for specification */
+void Anvil::SparseTextureStreamer::add_wait_semaphore(Anvil::Semaphore* in_semaphore_ptr)
+{
+    anvil_assert(in_semaphore_ptr != nullptr);
+
+    lock();
+    {
+        m_wait_semaphores.push_back(in_semaphore_ptr);
+    }
+    unlock();
+}
+
+/* Please see header for specification */
+Anvil::SparseTextureStreamerUniquePtr Anvil::SparseTextureStreamer::create(Anvil::Image*      in_image_ptr,
+                                                                           Anvil::ImageLayout in_image_layout,
+                                                                           uint32_t           in_n_pages,
+                                                                           Anvil::Queue*      in_sparse_queue_ptr,
+                                                                           Anvil::Queue*      in_transfer_queue_ptr,
+                                                                           VkDeviceSize       in_staging_ring_size,
+                                                                           bool               in_mt_safe)
+{
+    Anvil::SparseTextureStreamerUniquePtr result_ptr(nullptr,
+                                                     std::default_delete<Anvil::SparseTextureStreamer>() );
+
+    anvil_assert(in_image_ptr          != nullptr);
+    anvil_assert(in_n_pages            >  0);
+    anvil_assert(in_sparse_queue_ptr   != nullptr);
+    anvil_assert(in_transfer_queue_ptr != nullptr);
+    anvil_assert(in_image_layout       == Anvil::ImageLayout::GENERAL             ||
+                 in_image_layout       == Anvil::ImageLayout::TRANSFER_DST_OPTIMAL);
+
+    result_ptr.reset(
+        new Anvil::SparseTextureStreamer(in_image_ptr,
+                                         in_image_layout,
+                                         in_n_pages,
+                                         in_sparse_queue_ptr,
+                                         in_transfer_queue_ptr,
+                                         in_mt_safe)
+    );
+
+    if (result_ptr != nullptr)
+    {
+        if (!result_ptr->init(in_staging_ring_size) )
+        {
+            result_ptr.reset();
+        }
+    }
+
+    return result_ptr;
+}
+
+/* Please see header for specification */
+bool Anvil::SparseTextureStreamer::flush()
+{
+    Anvil::SemaphoreUniquePtr bind_semaphore_ptr;
+    bool                      result             = false;
+
+    lock();
+    {
+        if (m_pending_binds.empty() )
+        {
+            /* Uploads are only scheduled for tiles which are about to be bound, so only semaphores need to be
+             * submitted, if any */
+            for (auto& current_semaphore_ptr : m_signal_semaphores)
+            {
+                m_bind_accumulator_ptr->add_signal_semaphore(current_semaphore_ptr);
+            }
+
+            for (auto& current_semaphore_ptr : m_wait_semaphores)
+            {
+                m_bind_accumulator_ptr->add_wait_semaphore(current_semaphore_ptr);
+            }
+
+            result = m_bind_accumulator_ptr->submit(m_sparse_queue_ptr);
+
+            if (result)
+            {
+                m_signal_semaphores.clear();
+                m_wait_semaphores.clear  ();
+            }
+
+            goto end;
+        }
+
+        /* Pages which have been taken away from tiles may still be written to by uploads issued by earlier flush()
+         * calls. Wait for these to complete before the pages are bound to other tiles. */
+        if (m_pending_page_reuse)
+        {
+            if (!m_staging_ring_ptr->flush(true) ) /* in_should_block */
+            {
+                goto end;
+            }
+
+            m_pending_page_reuse = false;
+        }
+
+        /* Binds are visited in tile order and pages tend to be handed out in ascending order, so the accumulator
+         * is often able to bind whole rows of tiles with a single bind item */
+        for (const auto& current_bind : m_pending_binds)
+        {
+            VkExtent3D              bind_extent;
+            VkOffset3D              offset;
+            Anvil::ImageSubresource subresource;
+
+            if (!get_tile_region(current_bind.first,
+                                &offset,
+                                &bind_extent,
+                                 nullptr) ) /* out_copy_extent_ptr */
+            {
+                anvil_assert_fail();
+
+                goto end;
+            }
+
+            subresource.array_layer = current_bind.first.n_layer;
+            subresource.aspect_mask = current_bind.first.aspect;
+            subresource.mip_level   = current_bind.first.n_mip;
+
+            m_bind_accumulator_ptr->append_image_memory_update(m_image_ptr,
+                                                               subresource,
+                                                               offset,
+                                                               bind_extent,
+                                                               (current_bind.second != UINT32_MAX) ? m_pool_memory_block_ptr.get() : nullptr,
+                                                               (current_bind.second != UINT32_MAX) ? current_bind.second * m_page_size : 0,
+                                                               false); /* in_opt_memory_block_owned_by_image */
+        }
+
+        /* Copies must not start before the pages are bound. Rather than waiting for the binds on the CPU, make the
+         * staging ring batch holding the copies wait on a semaphore the binds signal. */
+        if (!m_pending_uploads.empty() )
+        {
+            bind_semaphore_ptr = acquire_bind_semaphore();
+
+            if (bind_semaphore_ptr == nullptr)
+            {
+                goto end;
+            }
+
+            m_bind_accumulator_ptr->add_signal_semaphore(bind_semaphore_ptr.get() );
+        }
+        else
+        {
+            for (auto& current_semaphore_ptr : m_signal_semaphores)
+            {
+                m_bind_accumulator_ptr->add_signal_semaphore(current_semaphore_ptr);
+            }
+        }
+
+        for (auto& current_semaphore_ptr : m_wait_semaphores)
+        {
+            m_bind_accumulator_ptr->add_wait_semaphore(current_semaphore_ptr);
+        }
+
+        if (!m_bind_accumulator_ptr->submit(m_sparse_queue_ptr) )
+        {
+            /* The semaphore has not been signalled, so the next call can use it right away */
+            m_unused_bind_semaphore_ptr = std::move(bind_semaphore_ptr);
+
+            goto end;
+        }
+
+        m_pending_binds.clear  ();
+        m_wait_semaphores.clear();
+
+        if (bind_semaphore_ptr == nullptr)
+        {
+            m_signal_semaphores.clear();
+
+            result = true;
+            goto end;
+        }
+
+        {
+            BindSemaphore bind_semaphore;
+
+            bind_semaphore.staging_ring_batch_id = m_staging_ring_ptr->add_wait_semaphore(bind_semaphore_ptr.get(),
+                                                                                          Anvil::PipelineStageFlagBits::TRANSFER_BIT);
+            bind_semaphore.semaphore_ptr         = std::move(bind_semaphore_ptr);
+
+            m_bind_semaphores.push_back(std::move(bind_semaphore) );
+        }
+
+        result = true;
+
+        for (const auto& current_upload : m_pending_uploads)
+        {
+            VkExtent3D                    copy_extent;
+            VkOffset3D                    offset;
+            Anvil::ImageSubresourceLayers subresource_layers;
+
+            get_tile_region(current_upload.first,
+                           &offset,
+                            nullptr, /* out_bind_extent_ptr */
+                           &copy_extent);
+
+            subresource_layers.aspect_mask      = current_upload.first.aspect;
+            subresource_layers.base_array_layer = current_upload.first.n_layer;
+            subresource_layers.layer_count      = 1;
+            subresource_layers.mip_level        = current_upload.first.n_mip;
+
+            result &= m_staging_ring_ptr->upload_to_image(m_image_ptr,
+                                                          m_image_layout,
+                                                          subresource_layers,
+                                                          offset,
+                                                          copy_extent,
+                                                          current_upload.second.data_size,
+                                                          current_upload.second.data_ptr,
+                                                          m_transfer_queue_ptr);
+        }
+
+        m_pending_uploads.clear();
+
+        /* The last batch is only submitted by the flush() call below, so it signals the app's semaphores after all
+         * earlier batches, which are executed in order on the same queue */
+        for (auto& current_semaphore_ptr : m_signal_semaphores)
+        {
+            m_staging_ring_ptr->add_signal_semaphore(current_semaphore_ptr);
+        }
+
+        m_signal_semaphores.clear();
+
+        result &= m_staging_ring_ptr->flush(false); /* in_should_block */
+    }
+end:
+    if (!result)
+    {
+        /* Do not leave a partially filled accumulator behind. Binds and semaphores which have not been submitted
+         * are kept, so that the next call retries them. */
+        m_bind_accumulator_ptr->reset();
+    }
+
+    ++m_n_current_batch;
+
+    unlock();
+
+    return result;
+}
+
+/** Computes the texel region covered by the specified tile.
+ *
+ *  @param in_tile_id          Tile to use for the query.
+ *  @param out_offset_ptr      Deref will be set to the location of the tile's first texel. Must not be nullptr.
+ *  @param out_bind_extent_ptr If not nullptr, deref will be set to the extent to use for binding operations. Extents
+ *                             of tiles at mip edges are rounded up to the sparse image granularity.
+ *  @param out_copy_extent_ptr If not nullptr, deref will be set to the extent of the tile, clipped to the mip size.
+ *
+ *  @return true if the tile lies within a mip which precedes the mip tail, false otherwise.
+ **/
+bool Anvil::SparseTextureStreamer::get_tile_region(const TileID& in_tile_id,
+                                                   VkOffset3D*   out_offset_ptr,
+                                                   VkExtent3D*   out_bind_extent_ptr,
+                                                   VkExtent3D*   out_copy_extent_ptr) const
+{
+    const Anvil::SparseImageAspectProperties* aspect_props_ptr = nullptr;
+    uint32_t                                  mip_size[3]      = {0, 0, 0};
+    bool                                      result           = false;
+
+    if (!m_image_ptr->get_sparse_image_aspect_properties(in_tile_id.aspect,
+                                                        &aspect_props_ptr) )
+    {
+        goto end;
+    }
+
+    if (in_tile_id.n_layer >= m_image_ptr->get_create_info_ptr()->get_n_layers() ||
+        in_tile_id.n_mip   >= aspect_props_ptr->mip_tail_first_lod)
+    {
+        goto end;
+    }
+
+    if (!m_image_ptr->get_image_mipmap_size(in_tile_id.n_mip,
+                                           mip_size + 0,
+                                           mip_size + 1,
+                                           mip_size + 2) )
+    {
+        goto end;
+    }
+
+    out_offset_ptr->x = static_cast<int32_t>(in_tile_id.x * aspect_props_ptr->granularity.width);
+    out_offset_ptr->y = static_cast<int32_t>(in_tile_id.y * aspect_props_ptr->granularity.height);
+    out_offset_ptr->z = static_cast<int32_t>(in_tile_id.z * aspect_props_ptr->granularity.depth);
+
+    if (static_cast<uint32_t>(out_offset_ptr->x) >= mip_size[0] ||
+        static_cast<uint32_t>(out_offset_ptr->y) >= mip_size[1] ||
+        static_cast<uint32_t>(out_offset_ptr->z) >= mip_size[2])
+    {
+        goto end;
+    }
+
+    if (out_bind_extent_ptr != nullptr)
+    {
+        *out_bind_extent_ptr = aspect_props_ptr->granularity;
+    }
+
+    if (out_copy_extent_ptr != nullptr)
+    {
+        out_copy_extent_ptr->width  = std::min(aspect_props_ptr->granularity.width,
+                                               mip_size[0] - static_cast<uint32_t>(out_offset_ptr->x) );
+        out_copy_extent_ptr->height = std::min(aspect_props_ptr->granularity.height,
+                                               mip_size[1] - static_cast<uint32_t>(out_offset_ptr->y) );
+        out_copy_extent_ptr->depth  = std::min(aspect_props_ptr->granularity.depth,
+                                               mip_size[2] - static_cast<uint32_t>(out_offset_ptr->z) );
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Allocates the page pool and the staging ring.
+ *
+ *  @return true if successful, false otherwise.
+ **/
+bool Anvil::SparseTextureStreamer::init(VkDeviceSize in_staging_ring_size)
+{
+    const Anvil::BaseDevice* device_ptr = m_image_ptr->get_create_info_ptr()->get_device();
+    bool                     result     = false;
+
+    if ((m_image_ptr->get_create_info_ptr()->get_create_flags() & Anvil::ImageCreateFlagBits::SPARSE_RESIDENCY_BIT) == 0)
+    {
+        anvil_assert((m_image_ptr->get_create_info_ptr()->get_create_flags() & Anvil::ImageCreateFlagBits::SPARSE_RESIDENCY_BIT) != 0);
+
+        goto end;
+    }
+
+    if (!m_sparse_queue_ptr->supports_sparse_bindings() )
+    {
+        anvil_assert(m_sparse_queue_ptr->supports_sparse_bindings() );
+
+        goto end;
+    }
+
+    /* For sparse images, memory requirements' alignment is the size of a single sparse block */
+    m_page_size = m_image_ptr->get_memory_requirements().alignment;
+
+    m_pool_memory_block_ptr = Anvil::MemoryBlock::create(
+        Anvil::MemoryBlockCreateInfo::create_regular(device_ptr,
+                                                     m_image_ptr->get_image_memory_types(),
+                                                     m_page_size * m_n_pages,
+                                                     Anvil::MemoryFeatureFlagBits::NONE)
+    );
+
+    if (m_pool_memory_block_ptr == nullptr)
+    {
+        anvil_assert(m_pool_memory_block_ptr != nullptr);
+
+        goto end;
+    }
+
+    m_bind_accumulator_ptr = Anvil::SparseMemoryBindingAccumulator::create(false); /* in_mt_safe */
+    m_staging_ring_ptr     = Anvil::StagingRing::create(device_ptr,
+                                                        in_staging_ring_size,
+                                                        false); /* in_mt_safe */
+
+    if (m_staging_ring_ptr == nullptr)
+    {
+        anvil_assert(m_staging_ring_ptr != nullptr);
+
+        goto end;
+    }
+
+    /* Hand out pages in ascending order */
+    m_free_pages.reserve(m_n_pages);
+
+    for (uint32_t n_page = m_n_pages;
+                  n_page > 0;
+                --n_page)
+    {
+        m_free_pages.push_back(n_page - 1);
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/* Please see header for specification */
+uint32_t Anvil::SparseTextureStreamer::get_n_free_pages() const
+{
+    uint32_t result;
+
+    lock();
+    {
+        result = static_cast<uint32_t>(m_free_pages.size() );
+    }
+    unlock();
+
+    return result;
+}
+
+/* Please see header for specification */
+bool Anvil::SparseTextureStreamer::is_tile_resident(const TileID& in_tile_id) const
+{
+    bool result;
+
+    lock();
+    {
+        result = (m_resident_tiles.find(in_tile_id) != m_resident_tiles.end() );
+    }
+    unlock();
+
+    return result;
+}
+
+/* Please see header for specification */
+void Anvil::SparseTextureStreamer::release_tile(const TileID& in_tile_id)
+{
+    lock();
+    {
+        auto resident_tile_iterator = m_resident_tiles.find(in_tile_id);
+
+        if (resident_tile_iterator != m_resident_tiles.end() )
+        {
+            unassign_page(resident_tile_iterator);
+        }
+    }
+    unlock();
+}
+
+/* Please see header for specification */
+bool Anvil::SparseTextureStreamer::request_tile(const TileID& in_tile_id,
+                                                const void*   in_data_ptr,
+                                                VkDeviceSize  in_data_size)
+{
+    VkOffset3D   dummy_offset;
+    uint32_t     n_page                 = UINT32_MAX;
+    ResidentTile new_resident_tile;
+    bool         result                 = false;
+    auto         resident_tile_iterator = m_resident_tiles.end();
+
+    lock();
+    {
+        resident_tile_iterator = m_resident_tiles.find(in_tile_id);
+
+        if (resident_tile_iterator != m_resident_tiles.end() )
+        {
+            /* Mark the tile as the most recently used one */
+            m_lru_tiles.splice(m_lru_tiles.begin(),
+                               m_lru_tiles,
+                               resident_tile_iterator->second.lru_iterator);
+
+            resident_tile_iterator->second.n_last_request_batch = m_n_current_batch;
+
+            result = true;
+            goto end;
+        }
+
+        if (!get_tile_region(in_tile_id,
+                            &dummy_offset,
+                             nullptr,  /* out_bind_extent_ptr */
+                             nullptr)) /* out_copy_extent_ptr */
+        {
+            anvil_assert_fail();
+
+            goto end;
+        }
+
+        if (m_free_pages.empty() )
+        {
+            auto lru_tile_iterator = m_resident_tiles.find(m_lru_tiles.back() );
+
+            anvil_assert(lru_tile_iterator != m_resident_tiles.end() );
+
+            /* All tiles requested since the last flush() need to stay resident */
+            if (lru_tile_iterator->second.n_last_request_batch == m_n_current_batch)
+            {
+                goto end;
+            }
+
+            unassign_page(lru_tile_iterator);
+        }
+
+        n_page = m_free_pages.back();
+
+        m_free_pages.pop_back();
+        m_lru_tiles.push_front(in_tile_id);
+
+        new_resident_tile.lru_iterator         = m_lru_tiles.begin();
+        new_resident_tile.n_last_request_batch = m_n_current_batch;
+        new_resident_tile.n_page               = n_page;
+
+        m_pending_binds [in_tile_id] = n_page;
+        m_resident_tiles[in_tile_id] = new_resident_tile;
+
+        if (in_data_ptr != nullptr)
+        {
+            PendingUpload pending_upload;
+
+            pending_upload.data_ptr  = in_data_ptr;
+            pending_upload.data_size = in_data_size;
+
+            m_pending_uploads[in_tile_id] = pending_upload;
+        }
+
+        result = true;
+    }
+end:
+    unlock();
+
+    return result;
+}
+
+/** Returns the page assigned to the specified resident tile to the pool of free pages, and schedules the tile
+ *  to be unbound at the next flush() call.
+ **/
+void Anvil::SparseTextureStreamer::unassign_page(std::map<TileID, ResidentTile>::iterator in_resident_tile_iterator)
+{
+    const TileID tile_id = in_resident_tile_iterator->first;
+
+    m_free_pages.push_back (in_resident_tile_iterator->second.n_page);
+    m_lru_tiles.erase      (in_resident_tile_iterator->second.lru_iterator);
+    m_pending_uploads.erase(tile_id);
+    m_resident_tiles.erase (in_resident_tile_iterator);
+
+    m_pending_binds[tile_id] = UINT32_MAX;
+    m_pending_page_reuse     = true;
+}
@@ -0,0 +1,909 @@
+//
+// Copyright (c) 2017-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "misc/buffer_create_info.h"
+#include "misc/debug.h"
+#include "misc/fence_pool.h"
+#include "misc/memory_block_create_info.h"
+#include "misc/staging_ring.h"
+#include "wrappers/buffer.h"
+#include "wrappers/command_buffer.h"
+#include "wrappers/command_pool.h"
+#include "wrappers/device.h"
+#include "wrappers/fence.h"
+#include "wrappers/image.h"
+#include "wrappers/memory_block.h"
+#include "wrappers/queue.h"
+#include <algorithm>
+#include <cstring>
+
+
+/* Please see header for specification */
+Anvil::StagingRing::StagingRing(const Anvil::BaseDevice* in_device_ptr,
+                                VkDeviceSize             in_size,
+                                bool                     in_mt_safe)
+    :MTSafetySupportProvider(in_mt_safe),
+     m_alignment            (4),
+     m_device_ptr           (in_device_ptr),
+     m_head_offset          (0),
+     m_is_coherent          (false),
+     m_mapped_data_ptr      (nullptr),
+     m_memory_offset        (0),
+     m_memory_block_ptr     (nullptr),
+     m_memory_size          (0),
+     m_n_next_batch_id      (1),
+     m_size                 (in_size)
+{
+    /* Stub */
+}
+
+/* Please see header for specification */
+Anvil::StagingRing::~StagingRing()
+{
+    flush(true); /* in_should_block */
+
+    if (m_mapped_data_ptr != nullptr)
+    {
+        m_memory_block_ptr->unmap();
+
+        m_mapped_data_ptr = nullptr;
+    }
+
+    m_buffer_ptr.reset();
+}
+
+/* Please see header for specification */
+void Anvil::StagingRing::add_signal_semaphore(Anvil::Semaphore* in_semaphore_ptr)
+{
+    anvil_assert(in_semaphore_ptr != nullptr);
+
+    lock();
+    {
+        m_pending_signal_semaphores.push_back(in_semaphore_ptr);
+    }
+    unlock();
+}
+
+/* Please see header for specification */
+uint64_t Anvil::StagingRing::add_wait_semaphore(Anvil::Semaphore*         in_semaphore_ptr,
+                                                Anvil::PipelineStageFlags in_wait_stage_mask)
+{
+    uint64_t result;
+
+    anvil_assert(in_semaphore_ptr != nullptr);
+
+    lock();
+    {
+        m_pending_wait_semaphores.push_back (in_semaphore_ptr);
+        m_pending_wait_stage_masks.push_back(in_wait_stage_mask);
+
+        /* The semaphores are consumed by the batch which is submitted next */
+        result = (m_pending_batch_ptr != nullptr) ? m_pending_batch_ptr->id
+                                                  : m_n_next_batch_id;
+    }
+    unlock();
+
+    return result;
+}
+
+/** Reserves a region of the specified size in the ring. If there is not enough free space, in-flight batches are
+ *  retired, oldest first, and the pending batch is submitted if that is not enough.
+ *
+ *  @return true if successful, false otherwise.
+ **/
+bool Anvil::StagingRing::allocate(VkDeviceSize  in_size,
+                                  VkDeviceSize* out_ring_offset_ptr)
+{
+    const VkDeviceSize aligned_size = Anvil::Utils::round_up(in_size,
+                                                             m_alignment);
+    bool               result       = false;
+
+    anvil_assert(aligned_size <= m_size);
+
+    while (true)
+    {
+        if (m_pending_batch_ptr == nullptr &&
+            m_in_flight_batches.empty() )
+        {
+            /* The whole ring is free */
+            *out_ring_offset_ptr = 0;
+
+            break;
+        }
+        else
+        {
+            /* Free space spans from the head to the start of the oldest batch, possibly wrapping around the end of
+             * the ring. The head never catches up with the tail, so that a full ring can be told apart from an empty one. */
+            const VkDeviceSize tail_offset = (!m_in_flight_batches.empty() ) ? m_in_flight_batches.front()->start_offset
+                                                                             : m_pending_batch_ptr->start_offset;
+
+            if (m_head_offset >= tail_offset)
+            {
+                if (m_head_offset + aligned_size <= m_size)
+                {
+                    *out_ring_offset_ptr = m_head_offset;
+
+                    break;
+                }
+                else
+                if (aligned_size < tail_offset)
+                {
+                    *out_ring_offset_ptr = 0;
+
+                    break;
+                }
+            }
+            else
+            if (m_head_offset + aligned_size < tail_offset)
+            {
+                *out_ring_offset_ptr = m_head_offset;
+
+                break;
+            }
+        }
+
+        if (!m_in_flight_batches.empty() )
+        {
+            retire_batch();
+        }
+        else
+        if (!submit_batch() )
+        {
+            goto end;
+        }
+    }
+
+    m_head_offset = *out_ring_offset_ptr + aligned_size;
+    result        = true;
+end:
+    return result;
+}
+
+/** Allocates a command buffer for a new batch, starts recording it and makes sure the copies it is going to hold
+ *  are ordered with all earlier commands submitted to the queue.
+ *
+ *  @return true if successful, false otherwise.
+ **/
+bool Anvil::StagingRing::begin_batch(Anvil::Queue* in_queue_ptr,
+                                     uint32_t      in_device_mask,
+                                     VkDeviceSize  in_start_offset)
+{
+    BatchUniquePtr       batch_ptr(new Batch() );
+    Anvil::MemoryBarrier pre_copy_barrier(Anvil::AccessFlagBits::TRANSFER_READ_BIT | Anvil::AccessFlagBits::TRANSFER_WRITE_BIT, /* in_destination_access_mask */
+                                          Anvil::AccessFlagBits::MEMORY_WRITE_BIT);                                             /* in_source_access_mask      */
+    bool                 result = false;
+
+    anvil_assert(m_pending_batch_ptr == nullptr);
+
+    batch_ptr->cmd_buffer_ptr = m_device_ptr->get_command_pool_for_queue_family_index(in_queue_ptr->get_queue_family_index() )->alloc_primary_level_command_buffer();
+    batch_ptr->device_mask    = in_device_mask;
+    batch_ptr->id             = m_n_next_batch_id++;
+    batch_ptr->queue_ptr      = in_queue_ptr;
+    batch_ptr->start_offset   = in_start_offset;
+
+    if (batch_ptr->cmd_buffer_ptr == nullptr)
+    {
+        anvil_assert(batch_ptr->cmd_buffer_ptr != nullptr);
+
+        goto end;
+    }
+
+    if (m_device_ptr->get_type() == Anvil::DeviceType::SINGLE_GPU)
+    {
+        batch_ptr->cmd_buffer_ptr->start_recording(true,   /* one_time_submit          */
+                                                   false); /* simultaneous_use_allowed */
+    }
+    else
+    {
+        anvil_assert(m_device_ptr->get_type() == Anvil::DeviceType::MULTI_GPU);
+
+        batch_ptr->cmd_buffer_ptr->start_recording(true,            /* one_time_submit          */
+                                                   false,           /* simultaneous_use_allowed */
+                                                   in_device_mask); /* in_opt_device_mask       */
+    }
+
+    batch_ptr->cmd_buffer_ptr->record_pipeline_barrier(Anvil::PipelineStageFlagBits::ALL_COMMANDS_BIT, /* in_src_stage_mask */
+                                                       Anvil::PipelineStageFlagBits::TRANSFER_BIT,     /* in_dst_stage_mask */
+                                                       Anvil::DependencyFlagBits::NONE,
+                                                       1, /* in_memory_barrier_count */
+                                                      &pre_copy_barrier,
+                                                       0,        /* in_buffer_memory_barrier_count */
+                                                       nullptr,  /* in_buffer_memory_barriers_ptr  */
+                                                       0,        /* in_image_memory_barrier_count  */
+                                                       nullptr); /* in_image_memory_barriers_ptr   */
+
+    m_pending_batch_ptr = std::move(batch_ptr);
+    result              = true;
+end:
+    return result;
+}
+
+/* Please see header for specification */
+Anvil::StagingRingUniquePtr Anvil::StagingRing::create(const Anvil::BaseDevice* in_device_ptr,
+                                                       VkDeviceSize             in_size,
+                                                       bool                     in_mt_safe)
+{
+    Anvil::StagingRingUniquePtr result_ptr(nullptr,
+                                           std::default_delete<Anvil::StagingRing>() );
+
+    anvil_assert(in_device_ptr != nullptr);
+    anvil_assert(in_size       >  0);
+
+    result_ptr.reset(
+        new Anvil::StagingRing(in_device_ptr,
+                               in_size,
+                               in_mt_safe)
+    );
+
+    if (result_ptr != nullptr)
+    {
+        if (!result_ptr->init() )
+        {
+            result_ptr.reset();
+        }
+    }
+
+    return result_ptr;
+}
+
+/* Please see header for specification */
+bool Anvil::StagingRing::download(Anvil::Buffer*                             in_src_buffer_ptr,
+                                  VkDeviceSize                               in_src_offset,
+                                  VkDeviceSize                               in_size,
+                                  void*                                      out_data_ptr,
+                                  Anvil::Queue*                              in_queue_ptr,
+                                  uint32_t                                   in_device_mask,
+                                  Anvil::StagingRingDownloadCallbackFunction in_opt_callback_function,
+                                  uint64_t*                                  out_opt_download_id_ptr)
+{
+    VkDeviceSize n_bytes_done = 0;
+    bool         result       = false;
+
+    anvil_assert(out_data_ptr != nullptr);
+
+    lock();
+    {
+        while (n_bytes_done < in_size)
+        {
+            const VkDeviceSize n_bytes_to_copy = std::min(in_size - n_bytes_done,
+                                                          m_size);
+            Anvil::BufferCopy  copy_region;
+            PendingRead        pending_read;
+            VkDeviceSize       ring_offset     = 0;
+
+            if (!prepare_transfer(n_bytes_to_copy,
+                                  in_queue_ptr,
+                                  in_device_mask,
+                                 &ring_offset) )
+            {
+                goto end;
+            }
+
+            copy_region.dst_offset = ring_offset;
+            copy_region.size       = n_bytes_to_copy;
+            copy_region.src_offset = in_src_offset + n_bytes_done;
+
+            m_pending_batch_ptr->cmd_buffer_ptr->record_copy_buffer(in_src_buffer_ptr,
+                                                                    m_buffer_ptr.get(),
+                                                                    1, /* in_region_count */
+                                                                   &copy_region);
+
+            pending_read.out_data_ptr = static_cast<uint8_t*>(out_data_ptr) + n_bytes_done;
+            pending_read.ring_offset  = ring_offset;
+            pending_read.size         = n_bytes_to_copy;
+
+            n_bytes_done += n_bytes_to_copy;
+
+            if (n_bytes_done == in_size)
+            {
+                /* Regions of a download retire in order, so the call-back fires once all of them have been copied */
+                pending_read.callback_function = std::move(in_opt_callback_function);
+
+                if (out_opt_download_id_ptr != nullptr)
+                {
+                    *out_opt_download_id_ptr = m_pending_batch_ptr->id;
+                }
+            }
+
+            m_pending_batch_ptr->reads.push_back(std::move(pending_read) );
+        }
+
+        result = true;
+    }
+end:
+    unlock();
+
+    return result;
+}
+
+/* Please see header for specification */
+bool Anvil::StagingRing::flush(bool in_should_block)
+{
+    bool result = true;
+
+    lock();
+    {
+        if (m_pending_batch_ptr != nullptr)
+        {
+            result = submit_batch();
+        }
+
+        if (in_should_block)
+        {
+            while (!m_in_flight_batches.empty() )
+            {
+                result &= retire_batch();
+            }
+        }
+    }
+    unlock();
+
+    return result;
+}
+
+/* Please see header for specification */
+bool Anvil::StagingRing::is_batch_retired(uint64_t in_batch_id) const
+{
+    bool result;
+
+    lock();
+    {
+        result = (in_batch_id < m_n_next_batch_id)                                                  &&
+                 (m_pending_batch_ptr == nullptr || m_pending_batch_ptr->id           > in_batch_id) &&
+                 (m_in_flight_batches.empty()    || m_in_flight_batches.front()->id > in_batch_id);
+    }
+    unlock();
+
+    return result;
+}
+
+/** Converts a ring region to a mapped memory range, which can be used for flushes and invalidations. */
+VkMappedMemoryRange Anvil::StagingRing::get_mapped_memory_range(VkDeviceSize in_ring_offset,
+                                                                VkDeviceSize in_size) const
+{
+    const auto          non_coherent_atom_size = m_device_ptr->get_physical_device_properties().core_vk1_0_properties_ptr->limits.non_coherent_atom_size;
+    const VkDeviceSize  start_offset           = m_memory_offset + in_ring_offset;
+    VkMappedMemoryRange result;
+
+    result.memory = m_memory_block_ptr->get_memory();
+    result.offset = Anvil::Utils::round_down(start_offset,
+                                             non_coherent_atom_size);
+    result.pNext  = nullptr;
+    result.size   = std::min(Anvil::Utils::round_up(start_offset + in_size, non_coherent_atom_size),
+                             m_memory_size) - result.offset;
+    result.sType  = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+
+    return result;
+}
+
+/** Creates the ring buffer and maps it for the lifetime of the ring.
+ *
+ *  @return true if successful, false otherwise.
+ **/
+bool Anvil::StagingRing::init()
+{
+    Anvil::QueueFamilyFlags   queue_families;
+    const Anvil::MemoryBlock* root_block_ptr  = nullptr;
+    bool                      result          = false;
+    void*                     mapped_data_ptr = nullptr;
+
+    /* Regions are aligned to the non-coherent atom size, so that flushing or invalidating one region never
+     * touches another */
+    m_alignment = std::max(m_alignment,
+                           m_device_ptr->get_physical_device_properties().core_vk1_0_properties_ptr->limits.non_coherent_atom_size);
+    m_size      = Anvil::Utils::round_up(m_size,
+                                         m_alignment);
+
+    /* Buffers can be transferred on any queue, so make the ring accessible to all queue families */
+    if (m_device_ptr->get_n_queues(Anvil::QueueFamilyType::COMPUTE) > 0)
+    {
+        queue_families |= Anvil::QueueFamilyFlagBits::COMPUTE_BIT;
+    }
+
+    if (m_device_ptr->get_n_queues(Anvil::QueueFamilyType::TRANSFER) > 0)
+    {
+        queue_families |= Anvil::QueueFamilyFlagBits::DMA_BIT;
+    }
+
+    if (m_device_ptr->get_n_queues(Anvil::QueueFamilyType::UNIVERSAL) > 0)
+    {
+        queue_families |= Anvil::QueueFamilyFlagBits::GRAPHICS_BIT;
+    }
+
+    {
+        const auto sharing_mode    = Anvil::Utils::is_pow2(static_cast<uint32_t>(queue_families.get_vk() ) ) ? Anvil::SharingMode::EXCLUSIVE
+                                                                                                             : Anvil::SharingMode::CONCURRENT;
+        auto       create_info_ptr = Anvil::BufferCreateInfo::create_alloc(m_device_ptr,
+                                                                           m_size,
+                                                                           queue_families,
+                                                                           sharing_mode,
+                                                                           Anvil::BufferCreateFlagBits::NONE,
+                                                                           Anvil::BufferUsageFlagBits::TRANSFER_DST_BIT | Anvil::BufferUsageFlagBits::TRANSFER_SRC_BIT,
+                                                                           Anvil::MemoryFeatureFlagBits::MAPPABLE_BIT);
+
+        create_info_ptr->set_mt_safety(Anvil::MTSafety::DISABLED);
+
+        m_buffer_ptr = Anvil::Buffer::create(std::move(create_info_ptr) );
+    }
+
+    if (m_buffer_ptr == nullptr)
+    {
+        anvil_assert(m_buffer_ptr != nullptr);
+
+        goto end;
+    }
+
+    m_memory_block_ptr = m_buffer_ptr->get_memory_block(0);
+
+    if (m_memory_block_ptr == nullptr)
+    {
+        anvil_assert(m_memory_block_ptr != nullptr);
+
+        goto end;
+    }
+
+    if (!m_memory_block_ptr->map(0, /* in_start_offset */
+                                 m_size,
+                                &mapped_data_ptr) )
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    m_mapped_data_ptr = static_cast<uint8_t*>(mapped_data_ptr);
+    m_is_coherent     = ((m_memory_block_ptr->get_create_info_ptr()->get_memory_features() & Anvil::MemoryFeatureFlagBits::HOST_COHERENT_BIT) != 0);
+
+    /* Flushes operate on VkDeviceMemory offsets. The block's start offset is already relative to its VkDeviceMemory. */
+    root_block_ptr  = m_memory_block_ptr->get_root_memory_block();
+    m_memory_offset = m_memory_block_ptr->get_start_offset();
+    m_memory_size   = root_block_ptr->get_start_offset() + root_block_ptr->get_create_info_ptr()->get_size();
+
+    result = true;
+end:
+    return result;
+}
+
+/** Makes sure the pending batch can hold a transfer for the specified queue and device mask, and reserves
+ *  a region of the ring for it. Starts a new batch if needed.
+ *
+ *  @return true if successful, false otherwise.
+ **/
+bool Anvil::StagingRing::prepare_transfer(VkDeviceSize  in_size,
+                                          Anvil::Queue* in_queue_ptr,
+                                          uint32_t      in_device_mask,
+                                          VkDeviceSize* out_ring_offset_ptr)
+{
+    bool result = false;
+
+    anvil_assert(in_queue_ptr != nullptr);
+
+    /* A batch is submitted as a single command buffer, so all of its transfers must target the same queue and devices */
+    if (m_pending_batch_ptr != nullptr)
+    {
+        if (m_pending_batch_ptr->queue_ptr   != in_queue_ptr ||
+            m_pending_batch_ptr->device_mask != in_device_mask)
+        {
+            if (!submit_batch() )
+            {
+                goto end;
+            }
+        }
+    }
+
+    if (!allocate(in_size,
+                  out_ring_offset_ptr) )
+    {
+        goto end;
+    }
+
+    if (m_pending_batch_ptr == nullptr)
+    {
+        if (!begin_batch(in_queue_ptr,
+                         in_device_mask,
+                        *out_ring_offset_ptr) )
+        {
+            goto end;
+        }
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Waits for the oldest in-flight batch to finish executing, copies its reads out of the ring and releases its
+ *  region of the ring, as well as its command buffer and fence.
+ *
+ *  @return true if the batch executed successfully, false otherwise.
+ **/
+bool Anvil::StagingRing::retire_batch()
+{
+    BatchUniquePtr batch_ptr = std::move(m_in_flight_batches.front() );
+    bool           result    = false;
+
+    m_in_flight_batches.pop_front();
+
+    if (batch_ptr->fence_ptr == nullptr)
+    {
+        /* The batch could not be submitted */
+        goto end;
+    }
+
+    if (!batch_ptr->fence_ptr->wait() )
+    {
+        goto end;
+    }
+
+    if (!batch_ptr->reads.empty() )
+    {
+        if (!m_is_coherent)
+        {
+            std::vector<VkMappedMemoryRange> invalidate_ranges;
+            VkResult                         result_vk;
+
+            invalidate_ranges.reserve(batch_ptr->reads.size() );
+
+            for (const auto& current_read : batch_ptr->reads)
+            {
+                invalidate_ranges.push_back(
+                    get_mapped_memory_range(current_read.ring_offset,
+                                            current_read.size)
+                );
+            }
+
+            result_vk = Anvil::Vulkan::vkInvalidateMappedMemoryRanges(m_device_ptr->get_device_vk(),
+                                                                      static_cast<uint32_t>(invalidate_ranges.size() ),
+                                                                     &invalidate_ranges.at(0) );
+
+            if (!is_vk_call_successful(result_vk) )
+            {
+                anvil_assert_vk_call_succeeded(result_vk);
+
+                goto end;
+            }
+        }
+
+        for (const auto& current_read : batch_ptr->reads)
+        {
+            memcpy(current_read.out_data_ptr,
+                   m_mapped_data_ptr + current_read.ring_offset,
+                   static_cast<size_t>(current_read.size) );
+        }
+    }
+
+    result = true;
+end:
+    for (const auto& current_read : batch_ptr->reads)
+    {
+        if (current_read.callback_function != nullptr)
+        {
+            current_read.callback_function(result);
+        }
+    }
+
+    return result;
+}
+
+/** Flushes host writes made for the pending batch, finishes recording its command buffer and submits it with
+ *  a pooled fence. The batch is moved to the in-flight list, even if the submission fails.
+ *
+ *  @return true if successful, false otherwise.
+ **/
+bool Anvil::StagingRing::submit_batch()
+{
+    BatchUniquePtr       batch_ptr = std::move(m_pending_batch_ptr);
+    Anvil::MemoryBarrier post_copy_barrier(Anvil::AccessFlagBits::HOST_READ_BIT | Anvil::AccessFlagBits::MEMORY_READ_BIT | Anvil::AccessFlagBits::MEMORY_WRITE_BIT, /* in_destination_access_mask */
+                                           Anvil::AccessFlagBits::TRANSFER_WRITE_BIT);                                                                            /* in_source_access_mask      */
+    bool                 result = false;
+
+    anvil_assert(batch_ptr != nullptr);
+
+    /* Retire batches which have already finished executing, so that reads become available as early as possible */
+    while (!m_in_flight_batches.empty()                       &&
+            m_in_flight_batches.front()->fence_ptr != nullptr &&
+            m_in_flight_batches.front()->fence_ptr->is_set() )
+    {
+        retire_batch();
+    }
+
+    if (!m_is_coherent                  &&
+        !batch_ptr->flush_ranges.empty() )
+    {
+        const VkResult result_vk = Anvil::Vulkan::vkFlushMappedMemoryRanges(m_device_ptr->get_device_vk(),
+                                                                            static_cast<uint32_t>(batch_ptr->flush_ranges.size() ),
+                                                                           &batch_ptr->flush_ranges.at(0) );
+
+        if (!is_vk_call_successful(result_vk) )
+        {
+            anvil_assert_vk_call_succeeded(result_vk);
+
+            goto end;
+        }
+    }
+
+    batch_ptr->cmd_buffer_ptr->record_pipeline_barrier(Anvil::PipelineStageFlagBits::TRANSFER_BIT,                                        /* in_src_stage_mask */
+                                                       Anvil::PipelineStageFlagBits::ALL_COMMANDS_BIT | Anvil::PipelineStageFlagBits::HOST_BIT, /* in_dst_stage_mask */
+                                                       Anvil::DependencyFlagBits::NONE,
+                                                       1, /* in_memory_barrier_count */
+                                                      &post_copy_barrier,
+                                                       0,        /* in_buffer_memory_barrier_count */
+                                                       nullptr,  /* in_buffer_memory_barriers_ptr  */
+                                                       0,        /* in_image_memory_barrier_count  */
+                                                       nullptr); /* in_image_memory_barriers_ptr   */
+    batch_ptr->cmd_buffer_ptr->stop_recording();
+
+    batch_ptr->fence_ptr = m_device_ptr->get_fence_pool()->acquire();
+
+    if (batch_ptr->fence_ptr == nullptr)
+    {
+        anvil_assert(batch_ptr->fence_ptr != nullptr);
+
+        goto end;
+    }
+
+    if (m_device_ptr->get_type() == Anvil::DeviceType::SINGLE_GPU)
+    {
+        result = batch_ptr->queue_ptr->submit(
+            Anvil::SubmitInfo::create(batch_ptr->cmd_buffer_ptr.get(),
+                                      static_cast<uint32_t>(m_pending_signal_semaphores.size() ),
+                                      (m_pending_signal_semaphores.size() > 0) ? &m_pending_signal_semaphores.at(0) : nullptr,
+                                      static_cast<uint32_t>(m_pending_wait_semaphores.size() ),
+                                      (m_pending_wait_semaphores.size()   > 0) ? &m_pending_wait_semaphores.at(0)   : nullptr,
+                                      (m_pending_wait_semaphores.size()   > 0) ? &m_pending_wait_stage_masks.at(0)  : nullptr,
+                                      false, /* in_should_block */
+                                      batch_ptr->fence_ptr.get() )
+        );
+    }
+    else
+    {
+        Anvil::CommandBufferMGPUSubmission          cmd_buffer_submission;
+        std::vector<Anvil::SemaphoreMGPUSubmission> signal_semaphore_submissions(m_pending_signal_semaphores.size() );
+        std::vector<Anvil::SemaphoreMGPUSubmission> wait_semaphore_submissions  (m_pending_wait_semaphores.size() );
+
+        cmd_buffer_submission.cmd_buffer_ptr = batch_ptr->cmd_buffer_ptr.get();
+        cmd_buffer_submission.device_mask    = batch_ptr->device_mask;
+
+        /* Semaphore operations are executed on the first device of the group, as they would be if no device group
+         * info was specified at submission time */
+        for (uint32_t n_semaphore = 0;
+                      n_semaphore < static_cast<uint32_t>(m_pending_signal_semaphores.size() );
+                    ++n_semaphore)
+        {
+            signal_semaphore_submissions.at(n_semaphore).device_index  = 0;
+            signal_semaphore_submissions.at(n_semaphore).semaphore_ptr = m_pending_signal_semaphores.at(n_semaphore);
+        }
+
+        for (uint32_t n_semaphore = 0;
+                      n_semaphore < static_cast<uint32_t>(m_pending_wait_semaphores.size() );
+                    ++n_semaphore)
+        {
+            wait_semaphore_submissions.at(n_semaphore).device_index  = 0;
+            wait_semaphore_submissions.at(n_semaphore).semaphore_ptr = m_pending_wait_semaphores.at(n_semaphore);
+        }
+
+        result = batch_ptr->queue_ptr->submit(
+            Anvil::SubmitInfo::create_wait_execute_signal(&cmd_buffer_submission,
+                                                          1, /* in_n_command_buffer_submissions */
+                                                          static_cast<uint32_t>(signal_semaphore_submissions.size() ),
+                                                          (signal_semaphore_submissions.size() > 0) ? &signal_semaphore_submissions.at(0) : nullptr,
+                                                          static_cast<uint32_t>(wait_semaphore_submissions.size() ),
+                                                          (wait_semaphore_submissions.size()   > 0) ? &wait_semaphore_submissions.at(0)   : nullptr,
+                                                          (wait_semaphore_submissions.size()   > 0) ? &m_pending_wait_stage_masks.at(0)   : nullptr,
+                                                          false, /* in_should_block */
+                                                          batch_ptr->fence_ptr.get() )
+        );
+    }
+
+    m_pending_signal_semaphores.clear();
+    m_pending_wait_semaphores.clear  ();
+    m_pending_wait_stage_masks.clear ();
+
+end:
+    if (!result)
+    {
+        /* Make sure nobody waits on a fence which is never going to be signalled */
+        m_device_ptr->get_fence_pool()->release(std::move(batch_ptr->fence_ptr),
+                                                false); /* in_was_submitted */
+    }
+
+    /* The batch still holds a region of the ring, which is released when the batch retires */
+    m_in_flight_batches.push_back(std::move(batch_ptr) );
+
+    return result;
+}
+
+/* Please see header for specification */
+bool Anvil::StagingRing::upload(Anvil::Buffer* in_dst_buffer_ptr,
+                                VkDeviceSize   in_dst_offset,
+                                VkDeviceSize   in_size,
+                                const void*    in_data_ptr,
+                                Anvil::Queue*  in_queue_ptr,
+                                uint32_t       in_device_mask)
+{
+    VkDeviceSize n_bytes_done = 0;
+    bool         result       = false;
+
+    anvil_assert(in_data_ptr != nullptr);
+
+    lock();
+    {
+        while (n_bytes_done < in_size)
+        {
+            const VkDeviceSize n_bytes_to_copy = std::min(in_size - n_bytes_done,
+                                                          m_size);
+            Anvil::BufferCopy  copy_region;
+            VkDeviceSize       ring_offset     = 0;
+
+            if (!prepare_transfer(n_bytes_to_copy,
+                                  in_queue_ptr,
+                                  in_device_mask,
+                                 &ring_offset) )
+            {
+                goto end;
+            }
+
+            write(ring_offset,
+                  static_cast<const uint8_t*>(in_data_ptr) + n_bytes_done,
+                  n_bytes_to_copy);
+
+            copy_region.dst_offset = in_dst_offset + n_bytes_done;
+            copy_region.size       = n_bytes_to_copy;
+            copy_region.src_offset = ring_offset;
+
+            m_pending_batch_ptr->cmd_buffer_ptr->record_copy_buffer(m_buffer_ptr.get(),
+                                                                    in_dst_buffer_ptr,
+                                                                    1, /* in_region_count */
+                                                                   &copy_region);
+
+            n_bytes_done += n_bytes_to_copy;
+        }
+
+        result = true;
+    }
+end:
+    unlock();
+
+    return result;
+}
+
+/* Please see header for specification */
+bool Anvil::StagingRing::upload_to_image(Anvil::Image*                        in_dst_image_ptr,
+                                         Anvil::ImageLayout                   in_dst_image_layout,
+                                         const Anvil::ImageSubresourceLayers& in_subresource,
+                                         const VkOffset3D&                    in_offset,
+                                         const VkExtent3D&                    in_extent,
+                                         VkDeviceSize                         in_size,
+                                         const void*                          in_data_ptr,
+                                         Anvil::Queue*                        in_queue_ptr,
+                                         uint32_t                             in_device_mask)
+{
+    Anvil::BufferImageCopy copy_region;
+    bool                   result      = false;
+    VkDeviceSize           ring_offset = 0;
+
+    anvil_assert(in_data_ptr         != nullptr);
+    anvil_assert(in_dst_image_layout == Anvil::ImageLayout::GENERAL             ||
+                 in_dst_image_layout == Anvil::ImageLayout::TRANSFER_DST_OPTIMAL);
+
+    lock();
+    {
+        if (in_size > m_size)
+        {
+            anvil_assert(in_size <= m_size);
+
+            goto end;
+        }
+
+        if (!prepare_transfer(in_size,
+                              in_queue_ptr,
+                              in_device_mask,
+                             &ring_offset) )
+        {
+            goto end;
+        }
+
+        write(ring_offset,
+              in_data_ptr,
+              in_size);
+
+        copy_region.buffer_image_height = 0;
+        copy_region.buffer_offset       = ring_offset;
+        copy_region.buffer_row_length   = 0;
+        copy_region.image_extent        = in_extent;
+        copy_region.image_offset        = in_offset;
+        copy_region.image_subresource   = in_subresource;
+
+        m_pending_batch_ptr->cmd_buffer_ptr->record_copy_buffer_to_image(m_buffer_ptr.get(),
+                                                                         in_dst_image_ptr,
+                                                                         in_dst_image_layout,
+                                                                         1, /* in_region_count */
+                                                                        &copy_region);
+
+        result = true;
+    }
+end:
+    unlock();
+
+    return result;
+}
+
+/** Copies host data into the specified region of the ring. For non-coherent memory, the region is also scheduled
+ *  for a flush at pending batch submission time.
+ **/
+void Anvil::StagingRing::write(VkDeviceSize in_ring_offset,
+                               const void*  in_data_ptr,
+                               VkDeviceSize in_size)
+{
+    memcpy(m_mapped_data_ptr + in_ring_offset,
+           in_data_ptr,
+           static_cast<size_t>(in_size) );
+
+    if (!m_is_coherent)
+    {
+        auto&                     flush_ranges = m_pending_batch_ptr->flush_ranges;
+        const VkMappedMemoryRange flush_range  = get_mapped_memory_range(in_ring_offset,
+                                                                         in_size);
+
+        /* Consecutive uploads usually land next to each other, so extend the last range if possible */
+        if (!flush_ranges.empty()                                           &&
+             flush_ranges.back().offset + flush_ranges.back().size == flush_range.offset)
+        {
+            flush_ranges.back().size += flush_range.size;
+        }
+        else
+        {
+            flush_ranges.push_back(flush_range);
+        }
+    }
+}
+
+/* Please see header for specification */
+bool Anvil::StagingRing::wait_for_download(uint64_t in_download_id)
+{
+    bool result = true;
+
+    lock();
+    {
+        /* Download IDs are IDs of the batch holding the last region of the download */
+        if (m_pending_batch_ptr != nullptr &&
+            m_pending_batch_ptr->id <= in_download_id)
+        {
+            submit_batch();
+        }
+
+        while (!m_in_flight_batches.empty()                    &&
+                m_in_flight_batches.front()->id <= in_download_id)
+        {
+            const bool is_requested_batch = (m_in_flight_batches.front()->id == in_download_id);
+            const bool retire_result      = retire_batch();
+
+            if (is_requested_batch)
+            {
+                result = retire_result;
+            }
+        }
+    }
+    unlock();
+
+    return result;
+}
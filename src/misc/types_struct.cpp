@@ -3223,7 +3223,7 @@ Anvil::SubmitInfo::SubmitInfo(uint32_t                         in_n_command_buff
      d3d12_fence_signal_semaphore_values_ptr(nullptr),
      d3d12_fence_wait_semaphore_values_ptr  (nullptr),
 #endif
-     dst_stage_wait_masks                   (in_n_semaphores_to_wait_on),
+     dst_stage_wait_masks_ptr               (in_opt_dst_stage_masks_to_wait_on_ptrs),
      fence_ptr                              (in_opt_fence_ptr),
      n_command_buffers                      (in_n_command_buffers),
      n_signal_semaphores                    (in_n_semaphores_to_signal),
@@ -3236,13 +3236,6 @@ Anvil::SubmitInfo::SubmitInfo(uint32_t                         in_n_command_buff
      wait_semaphores_mgpu_ptr               (nullptr),
      wait_semaphores_sgpu_ptr               (in_opt_semaphore_to_wait_on_ptrs_ptr)
 {
-    for (uint32_t n_wait_mask = 0;
-                  n_wait_mask < in_n_semaphores_to_wait_on;
-                ++n_wait_mask)
-    {
-        dst_stage_wait_masks.at(n_wait_mask) = in_opt_dst_stage_masks_to_wait_on_ptrs[n_wait_mask].get_vk();
-    }
-
     if (in_opt_single_cmd_buffer_ptr)
     {
         anvil_assert(in_n_command_buffers == 1);
@@ -3263,6 +3256,34 @@ Anvil::SubmitInfo::SubmitInfo(uint32_t                         in_n_command_buff
                  (in_n_semaphores_to_wait_on != 0 && in_opt_semaphore_to_wait_on_ptrs_ptr != nullptr && in_opt_dst_stage_masks_to_wait_on_ptrs != nullptr) );
 }
 
+Anvil::SubmitInfo::SubmitInfo(const SubmitInfo& in_submit_info)
+    :helper_cmd_buffer_raw_ptr              (in_submit_info.helper_cmd_buffer_raw_ptr),
+     command_buffers_mgpu_ptr               (in_submit_info.command_buffers_mgpu_ptr),
+     command_buffers_sgpu_ptr               (in_submit_info.command_buffers_sgpu_ptr),
+     n_command_buffers                      (in_submit_info.n_command_buffers),
+     signal_semaphores_mgpu_ptr             (in_submit_info.signal_semaphores_mgpu_ptr),
+     signal_semaphores_sgpu_ptr             (in_submit_info.signal_semaphores_sgpu_ptr),
+     n_signal_semaphores                    (in_submit_info.n_signal_semaphores),
+     dst_stage_wait_masks_ptr               (in_submit_info.dst_stage_wait_masks_ptr),
+     wait_semaphores_mgpu_ptr               (in_submit_info.wait_semaphores_mgpu_ptr),
+     wait_semaphores_sgpu_ptr               (in_submit_info.wait_semaphores_sgpu_ptr),
+     n_wait_semaphores                      (in_submit_info.n_wait_semaphores),
+     fence_ptr                              (in_submit_info.fence_ptr),
+#if defined(_WIN32)
+     d3d12_fence_signal_semaphore_values_ptr(in_submit_info.d3d12_fence_signal_semaphore_values_ptr),
+     d3d12_fence_wait_semaphore_values_ptr  (in_submit_info.d3d12_fence_wait_semaphore_values_ptr),
+#endif
+     should_block                           (in_submit_info.should_block),
+     timeout                                (in_submit_info.timeout),
+     type                                   (in_submit_info.type)
+{
+    /* Do not point at the helper storage of the source instance, which may go out of scope before this one */
+    if (in_submit_info.command_buffers_sgpu_ptr == &in_submit_info.helper_cmd_buffer_raw_ptr)
+    {
+        command_buffers_sgpu_ptr = &helper_cmd_buffer_raw_ptr;
+    }
+}
+
 Anvil::SubmitInfo::SubmitInfo(uint32_t                           in_n_command_buffer_submissions,
                               const CommandBufferMGPUSubmission* in_opt_command_buffer_submissions_ptr,
                               uint32_t                           in_n_signal_semaphore_submissions,
@@ -3278,7 +3299,7 @@ Anvil::SubmitInfo::SubmitInfo(uint32_t                           in_n_command_bu
      d3d12_fence_signal_semaphore_values_ptr(nullptr),
      d3d12_fence_wait_semaphore_values_ptr  (nullptr),
 #endif
-     dst_stage_wait_masks                   (in_n_wait_semaphore_submissions),
+     dst_stage_wait_masks_ptr               (in_opt_dst_stage_masks_to_wait_on_ptr),
      fence_ptr                              (in_opt_fence_ptr),
      n_command_buffers                      (in_n_command_buffer_submissions),
      n_signal_semaphores                    (in_n_signal_semaphore_submissions),
@@ -3291,13 +3312,6 @@ Anvil::SubmitInfo::SubmitInfo(uint32_t                           in_n_command_bu
      wait_semaphores_mgpu_ptr               (in_opt_wait_semaphore_submissions_ptr),
      wait_semaphores_sgpu_ptr               (nullptr)
 {
-    for (uint32_t n_wait_mask = 0;
-                  n_wait_mask < in_n_wait_semaphore_submissions;
-                ++n_wait_mask)
-    {
-        dst_stage_wait_masks.at(n_wait_mask) = in_opt_dst_stage_masks_to_wait_on_ptr[n_wait_mask].get_vk();
-    }
-
     anvil_assert((in_n_command_buffer_submissions == 0)                                                     ||
                  (in_n_command_buffer_submissions != 0 && in_opt_command_buffer_submissions_ptr != nullptr) );
 
@@ -23,6 +23,7 @@
 #include "misc/buffer_create_info.h"
 #include "misc/debug.h"
 #include "misc/object_tracker.h"
+#include "misc/staging_ring.h"
 #include "misc/struct_chainer.h"
 #include "wrappers/buffer.h"
 #include "wrappers/command_buffer.h"
@@ -42,8 +43,7 @@ Anvil::Buffer::Buffer(Anvil::BufferCreateInfoUniquePtr in_create_info_ptr)
      m_buffer                          (VK_NULL_HANDLE),
      m_memory_block_ptr                (nullptr),
      m_prefers_dedicated_allocation    (false),
-     m_requires_dedicated_allocation   (false),
-     m_staging_buffer_queue_ptr        (nullptr)
+     m_requires_dedicated_allocation   (false)
 {
     if (in_create_info_ptr->get_type() == BufferType::NO_ALLOC)
     {
@@ -112,6 +112,77 @@ Anvil::BufferUniquePtr Anvil::Buffer::create(Anvil::BufferCreateInfoUniquePtr in
     return new_buffer_ptr;
 }
 
+/** Creates a new VkBuffer object, using properties specified in the create info structure, and
+ *  stores its handle in m_buffer.
+ *
+ *  @return Result of the vkCreateBuffer() call.
+ **/
+VkResult Anvil::Buffer::create_vk_buffer()
+{
+    uint32_t                                 n_queue_family_indices;
+    uint32_t                                 queue_family_indices[8];
+    VkResult                                 result              (VK_ERROR_INITIALIZATION_FAILED);
+    Anvil::StructChainer<VkBufferCreateInfo> struct_chainer;
+
+    /* Determine which queues the buffer should be available to. */
+    Anvil::Utils::convert_queue_family_bits_to_family_indices(m_device_ptr,
+                                                              m_create_info_ptr->get_queue_families(),
+                                                              queue_family_indices,
+                                                             &n_queue_family_indices);
+
+    anvil_assert(n_queue_family_indices > 0);
+    anvil_assert(n_queue_family_indices < sizeof(queue_family_indices) / sizeof(queue_family_indices[0]) );
+
+    /* Prepare the create info structure */
+    {
+        VkBufferCreateInfo buffer_create_info;
+
+        buffer_create_info.flags                 = m_create_info_ptr->get_create_flags().get_vk();
+        buffer_create_info.pNext                 = nullptr;
+        buffer_create_info.pQueueFamilyIndices   = queue_family_indices;
+        buffer_create_info.queueFamilyIndexCount = n_queue_family_indices;
+        buffer_create_info.sharingMode           = static_cast<VkSharingMode>(m_create_info_ptr->get_sharing_mode() );
+        buffer_create_info.size                  = m_create_info_ptr->get_size();
+        buffer_create_info.sType                 = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        buffer_create_info.usage                 = m_create_info_ptr->get_usage_flags().get_vk();
+
+        struct_chainer.append_struct(buffer_create_info);
+    }
+
+    {
+        const auto& external_memory_handle_types = m_create_info_ptr->get_exportable_external_memory_handle_types();
+
+        if (external_memory_handle_types != 0)
+        {
+            VkExternalMemoryBufferCreateInfoKHR external_memory_buffer_create_info;
+
+            external_memory_buffer_create_info.handleTypes = external_memory_handle_types.get_vk();
+            external_memory_buffer_create_info.pNext       = nullptr;
+            external_memory_buffer_create_info.sType       = VK_STRUCTURE_TYPE_EXTERNAL_MEMORY_BUFFER_CREATE_INFO_KHR;
+
+            struct_chainer.append_struct(external_memory_buffer_create_info);
+        }
+    }
+
+    /* Create the buffer object */
+    {
+        auto struct_chain_ptr = struct_chainer.create_chain();
+
+        result = Anvil::Vulkan::vkCreateBuffer(m_device_ptr->get_device_vk(),
+                                               struct_chain_ptr->get_root_struct(),
+                                               nullptr, /* pAllocator */
+                                              &m_buffer);
+    }
+
+    anvil_assert_vk_call_succeeded(result);
+    if (is_vk_call_successful(result) )
+    {
+        set_vk_handle(m_buffer);
+    }
+
+    return result;
+}
+
 /* Please see header for specification */
 const Anvil::Buffer* Anvil::Buffer::get_base_buffer()
 {
@@ -221,11 +292,8 @@ uint32_t Anvil::Buffer::get_n_memory_blocks() const
 
 bool Anvil::Buffer::init()
 {
-    uint32_t                                 n_queue_family_indices;
-    uint32_t                                 queue_family_indices   [8];
-    VkResult                                 result                  (VK_ERROR_INITIALIZATION_FAILED);
-    Anvil::StructChainer<VkBufferCreateInfo> struct_chainer;
-    bool                                     use_dedicated_allocation(false);
+    VkResult result                  (VK_ERROR_INITIALIZATION_FAILED);
+    bool     use_dedicated_allocation(false);
 
     if ( m_create_info_ptr->get_client_data    ()                                               != nullptr &&
         (m_create_info_ptr->get_memory_features() & Anvil::MemoryFeatureFlagBits::MAPPABLE_BIT) == 0)
@@ -235,61 +303,10 @@ bool Anvil::Buffer::init()
 
     if (m_create_info_ptr->get_type() != BufferType::NO_ALLOC_CHILD)
     {
-        /* Determine which queues the buffer should be available to. */
-        Anvil::Utils::convert_queue_family_bits_to_family_indices(m_device_ptr,
-                                                                  m_create_info_ptr->get_queue_families(),
-                                                                  queue_family_indices,
-                                                                 &n_queue_family_indices);
-
-        anvil_assert(n_queue_family_indices > 0);
-        anvil_assert(n_queue_family_indices < sizeof(queue_family_indices) / sizeof(queue_family_indices[0]) );
-
-        /* Prepare the create info structure */
-        {
-            VkBufferCreateInfo buffer_create_info;
-
-            buffer_create_info.flags                 = m_create_info_ptr->get_create_flags().get_vk();
-            buffer_create_info.pNext                 = nullptr;
-            buffer_create_info.pQueueFamilyIndices   = queue_family_indices;
-            buffer_create_info.queueFamilyIndexCount = n_queue_family_indices;
-            buffer_create_info.sharingMode           = static_cast<VkSharingMode>(m_create_info_ptr->get_sharing_mode() );
-            buffer_create_info.size                  = m_create_info_ptr->get_size();
-            buffer_create_info.sType                 = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-            buffer_create_info.usage                 = m_create_info_ptr->get_usage_flags().get_vk();
-
-            struct_chainer.append_struct(buffer_create_info);
-        }
-
-        {
-            const auto& external_memory_handle_types = m_create_info_ptr->get_exportable_external_memory_handle_types();
+        result = create_vk_buffer();
 
-            if (external_memory_handle_types != 0)
-            {
-                VkExternalMemoryBufferCreateInfoKHR external_memory_buffer_create_info;
-
-                external_memory_buffer_create_info.handleTypes = external_memory_handle_types.get_vk();
-                external_memory_buffer_create_info.pNext       = nullptr;
-                external_memory_buffer_create_info.sType       = VK_STRUCTURE_TYPE_EXTERNAL_MEMORY_BUFFER_CREATE_INFO_KHR;
-
-                struct_chainer.append_struct(external_memory_buffer_create_info);
-            }
-        }
-
-        /* Create the buffer object */
-        {
-            auto struct_chain_ptr = struct_chainer.create_chain();
-
-            result = Anvil::Vulkan::vkCreateBuffer(m_device_ptr->get_device_vk(),
-                                                   struct_chain_ptr->get_root_struct(),
-                                                   nullptr, /* pAllocator */
-                                                  &m_buffer);
-        }
-
-        anvil_assert_vk_call_succeeded(result);
         if (is_vk_call_successful(result) )
         {
-            set_vk_handle(m_buffer);
-
             /* Cache buffer data memory requirements.
              *
              * Prefer facility exposed by VK_KHR_get_memory_requirements2, unless the extension is unavailable.
@@ -479,17 +496,17 @@ end:
     return is_vk_call_successful(result);
 }
 
-/* TODO */
-bool Anvil::Buffer::init_staging_buffer(const VkDeviceSize& in_size,
-                                        Anvil::Queue*       in_opt_queue_ptr)
+/** Picks the queue copies between the buffer and the device's staging ring should be executed on.
+ *
+ *  @param in_opt_queue_ptr Queue to use if the buffer uses exclusive sharing and supports more than one queue
+ *                          family type.
+ *
+ *  @return As per description.
+ **/
+Anvil::Queue* Anvil::Buffer::get_transfer_queue(Anvil::Queue* in_opt_queue_ptr) const
 {
-    Anvil::PrimaryCommandBufferUniquePtr      copy_cmdbuf_ptr;
-    std::vector<const Anvil::PhysicalDevice*> helper_vec;
-    const auto                                queue_fams                    = m_create_info_ptr->get_queue_families();
-    Anvil::QueueFamilyFlagBits                staging_buffer_queue_fam_bits = Anvil::QueueFamilyFlagBits::NONE;
-
-    m_staging_buffer_ptr.reset();
-    m_staging_buffer_queue_ptr = nullptr;
+    const auto    queue_fams = m_create_info_ptr->get_queue_families();
+    Anvil::Queue* result_ptr = nullptr;
 
     if (m_create_info_ptr->get_sharing_mode() == Anvil::SharingMode::EXCLUSIVE)
     {
@@ -501,9 +518,9 @@ bool Anvil::Buffer::init_staging_buffer(const VkDeviceSize& in_size,
         {
             switch (queue_fams.get_vk() )
             {
-                case static_cast<uint32_t>(Anvil::QueueFamilyFlagBits::COMPUTE_BIT):  m_staging_buffer_queue_ptr = m_device_ptr->get_compute_queue  (0); break;
-                case static_cast<uint32_t>(Anvil::QueueFamilyFlagBits::DMA_BIT):      m_staging_buffer_queue_ptr = m_device_ptr->get_transfer_queue (0); break;
-                case static_cast<uint32_t>(Anvil::QueueFamilyFlagBits::GRAPHICS_BIT): m_staging_buffer_queue_ptr = m_device_ptr->get_universal_queue(0); break;
+                case static_cast<uint32_t>(Anvil::QueueFamilyFlagBits::COMPUTE_BIT):  result_ptr = m_device_ptr->get_compute_queue  (0); break;
+                case static_cast<uint32_t>(Anvil::QueueFamilyFlagBits::DMA_BIT):      result_ptr = m_device_ptr->get_transfer_queue (0); break;
+                case static_cast<uint32_t>(Anvil::QueueFamilyFlagBits::GRAPHICS_BIT): result_ptr = m_device_ptr->get_universal_queue(0); break;
 
                 default:
                 {
@@ -515,21 +532,7 @@ bool Anvil::Buffer::init_staging_buffer(const VkDeviceSize& in_size,
         {
             anvil_assert(in_opt_queue_ptr != nullptr);
 
-            m_staging_buffer_queue_ptr = in_opt_queue_ptr;
-        }
-
-        anvil_assert(m_staging_buffer_queue_ptr != nullptr);
-
-        switch (m_device_ptr->get_queue_family_type(m_staging_buffer_queue_ptr->get_queue_family_index() ) )
-        {
-            case Anvil::QueueFamilyType::COMPUTE:   staging_buffer_queue_fam_bits = Anvil::QueueFamilyFlagBits::COMPUTE_BIT;  break;
-            case Anvil::QueueFamilyType::TRANSFER:  staging_buffer_queue_fam_bits = Anvil::QueueFamilyFlagBits::DMA_BIT;      break;
-            case Anvil::QueueFamilyType::UNIVERSAL: staging_buffer_queue_fam_bits = Anvil::QueueFamilyFlagBits::GRAPHICS_BIT; break;
-
-            default:
-            {
-                anvil_assert_fail();
-            }
+            result_ptr = in_opt_queue_ptr;
         }
     }
     else
@@ -537,51 +540,24 @@ bool Anvil::Buffer::init_staging_buffer(const VkDeviceSize& in_size,
         /* We can use any queue from the list of queue fams this buffer is compatible with, in order to perform the copy op. */
         if ((queue_fams & Anvil::QueueFamilyFlagBits::GRAPHICS_BIT) != 0)
         {
-            m_staging_buffer_queue_ptr    = m_device_ptr->get_universal_queue(0);
-            staging_buffer_queue_fam_bits = Anvil::QueueFamilyFlagBits::GRAPHICS_BIT;
+            result_ptr = m_device_ptr->get_universal_queue(0);
         }
         else
         if ((queue_fams & Anvil::QueueFamilyFlagBits::DMA_BIT) != 0)
         {
-            m_staging_buffer_queue_ptr    = m_device_ptr->get_transfer_queue(0);
-            staging_buffer_queue_fam_bits = Anvil::QueueFamilyFlagBits::DMA_BIT;
+            result_ptr = m_device_ptr->get_transfer_queue(0);
         }
         else
         {
             anvil_assert((queue_fams & Anvil::QueueFamilyFlagBits::COMPUTE_BIT) != 0)
 
-            m_staging_buffer_queue_ptr    = m_device_ptr->get_compute_queue(0);
-            staging_buffer_queue_fam_bits = Anvil::QueueFamilyFlagBits::COMPUTE_BIT;
+            result_ptr = m_device_ptr->get_compute_queue(0);
         }
     }
 
-    if (m_staging_buffer_ptr == nullptr                                   ||
-        m_staging_buffer_ptr->get_create_info_ptr()->get_size() < in_size)
-    {
-        {
-            const auto sharing_mode    = Anvil::Utils::is_pow2(static_cast<uint32_t>(staging_buffer_queue_fam_bits) ) ? Anvil::SharingMode::EXCLUSIVE
-                                                                                                                      : Anvil::SharingMode::CONCURRENT;
-
-            auto       create_info_ptr = Anvil::BufferCreateInfo::create_alloc(m_device_ptr,
-                                                                               in_size,
-                                                                               staging_buffer_queue_fam_bits,
-                                                                               sharing_mode,
-                                                                               Anvil::BufferCreateFlagBits::NONE,
-                                                                               Anvil::BufferUsageFlagBits::TRANSFER_DST_BIT | Anvil::BufferUsageFlagBits::TRANSFER_SRC_BIT,
-                                                                               Anvil::MemoryFeatureFlagBits::MAPPABLE_BIT);
-
-            create_info_ptr->set_mt_safety  (Anvil::MTSafety::DISABLED);
-
-            m_staging_buffer_ptr = Anvil::Buffer::create(std::move(create_info_ptr) );
-        }
-
-        if (m_staging_buffer_ptr == nullptr)
-        {
-            anvil_assert(m_staging_buffer_ptr != nullptr);
-        }
-    }
+    anvil_assert(result_ptr != nullptr);
 
-    return (m_staging_buffer_ptr != nullptr);
+    return result_ptr;
 }
 
 /* Please see header for specification */
@@ -600,139 +576,231 @@ bool Anvil::Buffer::read(VkDeviceSize in_start_offset,
                          VkDeviceSize in_size,
                          uint32_t     in_device_mask,
                          void*        out_result_ptr)
+{
+    return read_internal(in_start_offset,
+                         in_size,
+                         in_device_mask,
+                         out_result_ptr,
+                         true, /* in_should_block */
+                         Anvil::StagingRingDownloadCallbackFunction() );
+}
+
+/* Please see header for specification */
+bool Anvil::Buffer::read_async(VkDeviceSize                               in_start_offset,
+                               VkDeviceSize                               in_size,
+                               void*                                      out_result_ptr,
+                               Anvil::StagingRingDownloadCallbackFunction in_opt_callback_function)
+{
+    return read_internal(in_start_offset,
+                         in_size,
+                         UINT32_MAX, /* in_device_mask */
+                         out_result_ptr,
+                         false, /* in_should_block */
+                         std::move(in_opt_callback_function) );
+}
+
+/* Please see header for specification */
+bool Anvil::Buffer::read_async(VkDeviceSize                               in_start_offset,
+                               VkDeviceSize                               in_size,
+                               uint32_t                                   in_device_mask,
+                               void*                                      out_result_ptr,
+                               Anvil::StagingRingDownloadCallbackFunction in_opt_callback_function)
+{
+    return read_internal(in_start_offset,
+                         in_size,
+                         in_device_mask,
+                         out_result_ptr,
+                         false, /* in_should_block */
+                         std::move(in_opt_callback_function) );
+}
+
+/** Reads data from the buffer, either directly from mappable memory, or through the device's staging ring.
+ *
+ *  @param in_should_block          true to wait until the data is available under @param out_result_ptr.
+ *  @param in_opt_callback_function Call-back to invoke once the read completes, or nullptr.
+ *
+ *  @return true if successful, false otherwise. If @param in_should_block is false, only tells whether the read
+ *          has been issued.
+ **/
+bool Anvil::Buffer::read_internal(VkDeviceSize                               in_start_offset,
+                                  VkDeviceSize                               in_size,
+                                  uint32_t                                   in_device_mask,
+                                  void*                                      out_result_ptr,
+                                  bool                                       in_should_block,
+                                  Anvil::StagingRingDownloadCallbackFunction in_opt_callback_function)
 {
     const Anvil::DeviceType device_type      (m_device_ptr->get_type() );
+    uint64_t                download_id      (0);
     auto                    memory_block_ptr (get_memory_block(0 /* in_n_memory_block */) );
     bool                    result           (false);
+    Anvil::StagingRing*     staging_ring_ptr (nullptr);
 
     /* TODO: Support for sparse buffers */
     anvil_assert(m_create_info_ptr->get_create_flags() == Anvil::BufferCreateFlagBits::NONE);
 
-    if ((memory_block_ptr->get_create_info_ptr()->get_memory_features() & Anvil::MemoryFeatureFlagBits::MAPPABLE_BIT) != 0)
+    if ((memory_block_ptr->get_create_info_ptr()->get_memory_features() & Anvil::MemoryFeatureFlagBits::MAPPABLE_BIT) == 0)
     {
-        result = memory_block_ptr->read(in_start_offset,
-                                        in_size,
-                                        out_result_ptr);
+        /* The buffer memory is not mappable. Data needs to be copied to the staging ring, and read back from there
+         * once the copy op has executed. */
+        staging_ring_ptr = m_device_ptr->get_staging_ring();
     }
-    else
-    {
-        /* The buffer memory is not mappable. We need to create a staging buffer,
-         * do a non-mappable->mappable memory copy, and then read back data from the mappable buffer. */
-        Anvil::PrimaryCommandBufferUniquePtr copy_cmdbuf_ptr;
-
-        if (m_staging_buffer_ptr                                    == nullptr ||
-            m_staging_buffer_ptr->get_create_info_ptr()->get_size() <  in_size)
-        {
-            if (!init_staging_buffer(in_size,
-                                     nullptr) ) /* in_opt_queue_ptr */
-            {
-                result = false;
 
-                goto end;
-            }
-        }
-
-        if (m_staging_buffer_ptr == nullptr)
+    if (staging_ring_ptr != nullptr)
+    {
+        if (device_type == Anvil::DeviceType::MULTI_GPU)
         {
-            anvil_assert(m_staging_buffer_ptr != nullptr);
-
-            goto end;
+            anvil_assert(Utils::count_set_bits(in_device_mask) == 1);
+            anvil_assert((in_device_mask != 0) && (in_device_mask != UINT32_MAX));
         }
 
-        copy_cmdbuf_ptr = m_device_ptr->get_command_pool_for_queue_family_index(m_staging_buffer_queue_ptr->get_queue_family_index() )->alloc_primary_level_command_buffer();
-
-        if (copy_cmdbuf_ptr == nullptr)
+        result = staging_ring_ptr->download(this,
+                                            in_start_offset,
+                                            in_size,
+                                            out_result_ptr,
+                                            get_transfer_queue(nullptr), /* in_opt_queue_ptr */
+                                            in_device_mask,
+                                            std::move(in_opt_callback_function),
+                                           &download_id);
+
+        if (result          &&
+            in_should_block)
         {
-            anvil_assert(copy_cmdbuf_ptr != nullptr);
-
-            goto end;
-
+            result = staging_ring_ptr->wait_for_download(download_id);
         }
-        if (device_type == Anvil::DeviceType::SINGLE_GPU)
+    }
+    else
+    {
+        if ((memory_block_ptr->get_create_info_ptr()->get_memory_features() & Anvil::MemoryFeatureFlagBits::MAPPABLE_BIT) != 0)
         {
-            copy_cmdbuf_ptr->start_recording(true,   /* one_time_submit          */
-                                             false); /* simultaneous_use_allowed */
+            result = memory_block_ptr->read(in_start_offset,
+                                            in_size,
+                                            out_result_ptr);
         }
         else
         {
-            anvil_assert(device_type == Anvil::DeviceType::MULTI_GPU);
-            anvil_assert(Utils::count_set_bits(in_device_mask) == 1);
-
-            copy_cmdbuf_ptr->start_recording(true,  /* one_time_submit          */
-                                             false, /* simultaneous_use_allowed */
-                                             in_device_mask); /* in_opt_device_mask */
+            anvil_assert(staging_ring_ptr != nullptr);
         }
+
+        if (in_opt_callback_function != nullptr)
         {
-            Anvil::BufferBarrier buffer_barrier(Anvil::AccessFlagBits::TRANSFER_WRITE_BIT,
-                                                Anvil::AccessFlagBits::HOST_READ_BIT,
-                                                VK_QUEUE_FAMILY_IGNORED,
-                                                VK_QUEUE_FAMILY_IGNORED,
-                                                m_staging_buffer_ptr.get(),
-                                                0, /* in_offset */
-                                                in_size);
-            Anvil::BufferCopy    copy_region;
-            Anvil::MemoryBarrier pre_copy_barrier(Anvil::AccessFlagBits::TRANSFER_READ_BIT, /* in_destination_access_mask */
-                                                  Anvil::AccessFlagBits::HOST_WRITE_BIT | Anvil::AccessFlagBits::MEMORY_WRITE_BIT | Anvil::AccessFlagBits::SHADER_WRITE_BIT | Anvil::AccessFlagBits::TRANSFER_WRITE_BIT);
-
-            copy_region.dst_offset = 0;
-            copy_region.size       = in_size;
-            copy_region.src_offset = in_start_offset;
-
-            copy_cmdbuf_ptr->record_pipeline_barrier(Anvil::PipelineStageFlagBits::ALL_COMMANDS_BIT, /* in_src_stage_mask */
-                                                     Anvil::PipelineStageFlagBits::TRANSFER_BIT,     /* in_dst_stage_mask */
-                                                     Anvil::DependencyFlagBits::NONE,
-                                                     1, /* in_memory_barrier_count */
-                                                    &pre_copy_barrier,
-                                                     0,        /* in_buffer_memory_barrier_count */
-                                                     nullptr,  /* in_buffer_memory_barriers_ptr  */
-                                                     0,        /* in_image_memory_barrier_count  */
-                                                     nullptr); /* in_iamge_memory_barriers_ptr   */
-
-            copy_cmdbuf_ptr->record_copy_buffer     (this,
-                                                     m_staging_buffer_ptr.get(),
-                                                     1, /* in_region_count */
-                                                    &copy_region);
-            copy_cmdbuf_ptr->record_pipeline_barrier(Anvil::PipelineStageFlagBits::TRANSFER_BIT,
-                                                     Anvil::PipelineStageFlagBits::HOST_BIT,
-                                                     Anvil::DependencyFlagBits::NONE,
-                                                     0,               /* in_memory_barrier_count        */
-                                                     nullptr,         /* in_memory_barriers_ptr         */
-                                                     1,               /* in_buffer_memory_barrier_count */
-                                                     &buffer_barrier,
-                                                     0,               /* in_image_memory_barrier_count */
-                                                     nullptr);        /* in_image_memory_barriers_ptr  */
+            in_opt_callback_function(result);
         }
-        copy_cmdbuf_ptr->stop_recording();
+    }
+
+    return result;
+}
 
-        if (device_type == Anvil::DeviceType::SINGLE_GPU)
+/* Please see header for specification */
+bool Anvil::Buffer::rebind_nonsparse_memory(MemoryBlockUniquePtr  in_memory_block_ptr,
+                                            MemoryBlockUniquePtr* out_opt_old_memory_block_ptr)
+{
+    bool                is_old_buffer_detached = false;
+    const std::string   object_name            = m_worker_ptr->get_name();
+    VkBuffer            old_buffer             = m_buffer;
+    Anvil::MemoryBlock* old_memory_block_ptr   = m_memory_block_ptr;
+    bool                result                 = false;
+    VkResult            result_vk;
+
+    if (in_memory_block_ptr == nullptr)
+    {
+        anvil_assert(!(in_memory_block_ptr == nullptr) );
+
+        goto end;
+    }
+
+    if (old_memory_block_ptr                       == nullptr ||
+        m_page_tracker_ptr                         != nullptr ||
+        m_create_info_ptr->get_parent_buffer_ptr() != nullptr)
+    {
+        /* Only non-sparse buffers which own their VkBuffer and have already been bound to memory can be moved */
+        anvil_assert(old_memory_block_ptr                       != nullptr &&
+                     m_page_tracker_ptr                         == nullptr &&
+                     m_create_info_ptr->get_parent_buffer_ptr() == nullptr);
+
+        goto end;
+    }
+
+    if (in_memory_block_ptr->get_create_info_ptr()->get_size() < m_buffer_memory_reqs.size)
+    {
+        anvil_assert(in_memory_block_ptr->get_create_info_ptr()->get_size() >= m_buffer_memory_reqs.size);
+
+        goto end;
+    }
+
+    /* Memory bindings are immutable, so a new buffer object needs to be created. The old one is kept until the new
+     * one has been bound, so that the buffer can be restored if that fails. */
+    is_old_buffer_detached = true;
+    m_buffer               = VK_NULL_HANDLE;
+    m_memory_block_ptr     = nullptr;
+
+    result_vk = create_vk_buffer();
+
+    if (!is_vk_call_successful(result_vk) )
+    {
+        goto end;
+    }
+
+    if (!set_memory_nonsparse_internal(std::move(in_memory_block_ptr),
+                                       0,         /* in_n_device_group_indices   */
+                                       nullptr) ) /* in_device_group_indices_ptr */
+    {
+        lock();
         {
-            m_staging_buffer_queue_ptr->submit(
-                Anvil::SubmitInfo::create_execute(copy_cmdbuf_ptr.get(),
-                                                  true /* should_block */)
-            );
+            Anvil::Vulkan::vkDestroyBuffer(m_device_ptr->get_device_vk(),
+                                           m_buffer,
+                                           nullptr /* pAllocator */);
         }
-        else
-        {
-            Anvil::CommandBufferMGPUSubmission cmd_buffer_submission;
+        unlock();
 
-            anvil_assert((in_device_mask != 0) && (in_device_mask != UINT32_MAX));
+        goto end;
+    }
 
-            cmd_buffer_submission.cmd_buffer_ptr = copy_cmdbuf_ptr.get();
-            cmd_buffer_submission.device_mask    = in_device_mask;
+    lock();
+    {
+        Anvil::Vulkan::vkDestroyBuffer(m_device_ptr->get_device_vk(),
+                                       old_buffer,
+                                       nullptr /* pAllocator */);
+    }
+    unlock();
 
-            m_staging_buffer_queue_ptr->submit(
-                Anvil::SubmitInfo::create_execute(&cmd_buffer_submission,
-                                                  1, /* in_n_command_buffer_submissions */
-                                                  true /* should_block */)
-            );
-        }
+    if (object_name.size() != 0)
+    {
+        set_name(object_name);
+    }
 
-        result = m_staging_buffer_ptr->read(0,
-                                            in_size,
-                                            out_result_ptr);
+    if (out_opt_old_memory_block_ptr != nullptr)
+    {
+        out_opt_old_memory_block_ptr->reset();
     }
 
+    /* The old memory block is no longer referred to by the buffer. */
+    for (auto memory_block_ptr_iter  = m_owned_memory_blocks.begin();
+              memory_block_ptr_iter != m_owned_memory_blocks.end();
+            ++memory_block_ptr_iter)
+    {
+        if (memory_block_ptr_iter->get() == old_memory_block_ptr)
+        {
+            if (out_opt_old_memory_block_ptr != nullptr)
+            {
+                *out_opt_old_memory_block_ptr = std::move(*memory_block_ptr_iter);
+            }
+
+            m_owned_memory_blocks.erase(memory_block_ptr_iter);
+
+            break;
+        }
+    }
+
+    result = true;
 end:
+    if (!result && is_old_buffer_detached)
+    {
+        m_buffer           = old_buffer;
+        m_memory_block_ptr = old_memory_block_ptr;
+
+        set_vk_handle(m_buffer);
+    }
+
     return result;
 }
 
@@ -1102,6 +1170,45 @@ bool Anvil::Buffer::write(VkDeviceSize  in_start_offset,
                           const void*   in_data,
                           uint32_t      in_device_mask,
                           Anvil::Queue* in_opt_queue_ptr)
+{
+    Anvil::MemoryBlock* memory_block_ptr(get_memory_block(0) );
+    bool                result          (false);
+
+    result = write_async(in_start_offset,
+                         in_size,
+                         in_data,
+                         in_device_mask,
+                         in_opt_queue_ptr);
+
+    if (result                                                                                                        &&
+        (memory_block_ptr->get_create_info_ptr()->get_memory_features() & Anvil::MemoryFeatureFlagBits::MAPPABLE_BIT) == 0)
+    {
+        /* Submit the staging ring's batch and wait until the copy op executes */
+        result = m_device_ptr->get_staging_ring()->flush(true); /* in_should_block */
+    }
+
+    return result;
+}
+
+/* Please see header for specification */
+bool Anvil::Buffer::write_async(VkDeviceSize  in_start_offset,
+                                VkDeviceSize  in_size,
+                                const void*   in_data,
+                                Anvil::Queue* in_opt_queue_ptr)
+{
+    return write_async(in_start_offset,
+                       in_size,
+                       in_data,
+                       UINT32_MAX, /* in_device_mask */
+                       in_opt_queue_ptr);
+}
+
+/* Please see header for specification */
+bool Anvil::Buffer::write_async(VkDeviceSize  in_start_offset,
+                                VkDeviceSize  in_size,
+                                const void*   in_data,
+                                uint32_t      in_device_mask,
+                                Anvil::Queue* in_opt_queue_ptr)
 {
     const Anvil::DeviceType device_type(m_device_ptr->get_type() );
     bool                    result     (false);
@@ -1128,118 +1235,40 @@ bool Anvil::Buffer::write(VkDeviceSize  in_start_offset,
     }
     else
     {
-        /* The buffer memory is not mappable. We need to create a staging memory,
-         * upload user's data there, and then issue a copy op. */
-        Anvil::PrimaryCommandBufferUniquePtr      copy_cmdbuf_ptr;
-
-        if (m_staging_buffer_ptr == nullptr                                    ||
-            m_staging_buffer_ptr->get_create_info_ptr()->get_size() < in_size)
-        {
-            if (!init_staging_buffer(in_size,
-                                     in_opt_queue_ptr) )
-            {
-                result = false;
-
-                goto end;
-            }
-
-            anvil_assert(m_staging_buffer_ptr != nullptr);
-        }
-
-        m_staging_buffer_ptr->write(0, /* in_start_offset */
-                                    in_size,
-                                    in_data);
+        /* The buffer memory is not mappable. Upload user's data to the staging ring, and record a copy op
+         * which is going to be submitted with the ring's current batch. */
+        uint32_t            device_mask      = in_device_mask;
+        Anvil::StagingRing* staging_ring_ptr = m_device_ptr->get_staging_ring();
 
-        copy_cmdbuf_ptr = m_device_ptr->get_command_pool_for_queue_family_index(m_staging_buffer_queue_ptr->get_queue_family_index() )->alloc_primary_level_command_buffer();
-
-        if (copy_cmdbuf_ptr == nullptr)
+        if (staging_ring_ptr == nullptr)
         {
-            anvil_assert(copy_cmdbuf_ptr != nullptr);
+            anvil_assert(staging_ring_ptr != nullptr);
 
             goto end;
         }
 
-        if (device_type == Anvil::DeviceType::SINGLE_GPU)
-        {
-            copy_cmdbuf_ptr->start_recording(true,   /* one_time_submit          */
-                                             false); /* simultaneous_use_allowed */
-        }
-        else
-        {
-            anvil_assert(device_type == Anvil::DeviceType::MULTI_GPU);
-
-            copy_cmdbuf_ptr->start_recording(true,   /* one_time_submit          */
-                                             false,  /* simultaneous_use_allowed */
-                                             in_device_mask);
-        }
+        if (device_type == Anvil::DeviceType::MULTI_GPU)
         {
-            BufferBarrier        buffer_barrier(Anvil::AccessFlagBits::HOST_WRITE_BIT, /* in_source_access_mask */
-                                                (Anvil::AccessFlagBits::HOST_READ_BIT  | Anvil::AccessFlagBits::MEMORY_READ_BIT  | Anvil::AccessFlagBits::SHADER_READ_BIT  | Anvil::AccessFlagBits::TRANSFER_READ_BIT   |
-                                                 Anvil::AccessFlagBits::HOST_WRITE_BIT | Anvil::AccessFlagBits::MEMORY_WRITE_BIT | Anvil::AccessFlagBits::SHADER_WRITE_BIT | Anvil::AccessFlagBits::TRANSFER_WRITE_BIT),
-                                                VK_QUEUE_FAMILY_IGNORED,
-                                                VK_QUEUE_FAMILY_IGNORED,
-                                                m_staging_buffer_ptr.get(),
-                                                0, /* in_offset */
-                                                in_size);
-            Anvil::BufferCopy    copy_region;
-
-            copy_region.dst_offset = in_start_offset;
-            copy_region.size       = in_size;
-            copy_region.src_offset = 0;
-
-
-            copy_cmdbuf_ptr->record_pipeline_barrier(Anvil::PipelineStageFlagBits::HOST_BIT,
-                                                     Anvil::PipelineStageFlagBits::ALL_COMMANDS_BIT,
-                                                     Anvil::DependencyFlagBits::NONE,
-                                                     0,               /* in_memory_barrier_count        */
-                                                     nullptr,         /* in_memory_barriers_ptr         */
-                                                     1,               /* in_buffer_memory_barrier_count */
-                                                     &buffer_barrier,
-                                                     0,               /* in_image_memory_barrier_count */
-                                                     nullptr);        /* in_image_memory_barriers_ptr  */
-            copy_cmdbuf_ptr->record_copy_buffer     (m_staging_buffer_ptr.get(),
-                                                     this,
-                                                     1, /* in_region_count */
-                                                    &copy_region);
-        }
-        copy_cmdbuf_ptr->stop_recording();
-
-        if (device_type == Anvil::DeviceType::SINGLE_GPU)
-        {
-            m_staging_buffer_queue_ptr->submit(
-                Anvil::SubmitInfo::create_execute(copy_cmdbuf_ptr.get(),
-                                                  true /* should_block */)
-            );
-        }
-        else
-        {
-            Anvil::CommandBufferMGPUSubmission copy_cmdbuf_submission;
-
-            copy_cmdbuf_submission.cmd_buffer_ptr = copy_cmdbuf_ptr.get();
-            copy_cmdbuf_submission.device_mask    = in_device_mask;
-
             /* Need to update all memory instances */
             if ((memory_block_ptr->get_create_info_ptr()->get_memory_features() & Anvil::MemoryFeatureFlagBits::MULTI_INSTANCE_BIT) != 0)
             {
-                auto                     device_mask     = memory_block_ptr->get_create_info_ptr()->get_device_mask();
                 const Anvil::MGPUDevice* mgpu_device_ptr = dynamic_cast<const Anvil::MGPUDevice*>(m_device_ptr);
 
+                device_mask = memory_block_ptr->get_create_info_ptr()->get_device_mask();
+
                 if (device_mask == 0)
                 {
                     device_mask = (1 << mgpu_device_ptr->get_n_physical_devices()) - 1;
                 }
-
-                copy_cmdbuf_submission.device_mask = device_mask;
             }
-
-            m_staging_buffer_queue_ptr->submit(
-                Anvil::SubmitInfo::create_execute(&copy_cmdbuf_submission,
-                                                  1, /* in_n_command_buffer_submissions */
-                                                  true /* should_block */)
-            );
         }
 
-        result = true;
+        result = staging_ring_ptr->upload(this,
+                                          in_start_offset,
+                                          in_size,
+                                          in_data,
+                                          get_transfer_queue(in_opt_queue_ptr),
+                                          device_mask);
     }
 
 end:
@@ -21,6 +21,7 @@
 //
 
 #include "misc/callbacks.h"
+#include "misc/command_stream.h"
 #include "misc/debug.h"
 #include "misc/descriptor_set_create_info.h"
 #include "misc/memory_block_create_info.h"
@@ -1052,6 +1053,622 @@ Anvil::CommandBufferBase::WriteTimestampCommand::WriteTimestampCommand(Anvil::Pi
 }
 
 
+/** Tells whether two buffer memory barriers refer to overlapping regions of the same buffer. */
+static bool do_buffer_barriers_overlap(const VkBufferMemoryBarrier& in_barrier1,
+                                       const VkBufferMemoryBarrier& in_barrier2)
+{
+    const VkDeviceSize end1 = (in_barrier1.size == VK_WHOLE_SIZE) ? UINT64_MAX : in_barrier1.offset + in_barrier1.size;
+    const VkDeviceSize end2 = (in_barrier2.size == VK_WHOLE_SIZE) ? UINT64_MAX : in_barrier2.offset + in_barrier2.size;
+
+    return (in_barrier1.buffer == in_barrier2.buffer &&
+            in_barrier1.offset <  end2               &&
+            in_barrier2.offset <  end1);
+}
+
+/** Tells whether two image memory barriers refer to overlapping subresources of the same image. */
+static bool do_image_barriers_overlap(const VkImageMemoryBarrier& in_barrier1,
+                                      const VkImageMemoryBarrier& in_barrier2)
+{
+    const VkImageSubresourceRange& range1      = in_barrier1.subresourceRange;
+    const VkImageSubresourceRange& range2      = in_barrier2.subresourceRange;
+    const uint32_t                 layer_end1  = (range1.layerCount == VK_REMAINING_ARRAY_LAYERS) ? UINT32_MAX : range1.baseArrayLayer + range1.layerCount;
+    const uint32_t                 layer_end2  = (range2.layerCount == VK_REMAINING_ARRAY_LAYERS) ? UINT32_MAX : range2.baseArrayLayer + range2.layerCount;
+    const uint32_t                 mip_end1    = (range1.levelCount == VK_REMAINING_MIP_LEVELS)   ? UINT32_MAX : range1.baseMipLevel   + range1.levelCount;
+    const uint32_t                 mip_end2    = (range2.levelCount == VK_REMAINING_MIP_LEVELS)   ? UINT32_MAX : range2.baseMipLevel   + range2.levelCount;
+
+    return (in_barrier1.image               == in_barrier2.image &&
+            (range1.aspectMask & range2.aspectMask) != 0         &&
+            range1.baseArrayLayer           <  layer_end2        &&
+            range2.baseArrayLayer           <  layer_end1        &&
+            range1.baseMipLevel             <  mip_end2          &&
+            range2.baseMipLevel             <  mip_end1);
+}
+
+/** Tells whether the specified barrier transfers ownership between queue families. */
+template<typename BarrierType>
+static bool is_ownership_transfer(const BarrierType& in_barrier)
+{
+    return (in_barrier.srcQueueFamilyIndex != in_barrier.dstQueueFamilyIndex);
+}
+
+/** Tells whether two buffer memory barriers can be merged into one by OR-ing their access masks. */
+static bool are_buffer_barriers_mergeable(const VkBufferMemoryBarrier& in_barrier1,
+                                          const VkBufferMemoryBarrier& in_barrier2)
+{
+    return (in_barrier1.buffer              == in_barrier2.buffer              &&
+            in_barrier1.dstQueueFamilyIndex == in_barrier2.dstQueueFamilyIndex &&
+            in_barrier1.offset              == in_barrier2.offset              &&
+            in_barrier1.pNext               == nullptr                         &&
+            in_barrier2.pNext               == nullptr                         &&
+            in_barrier1.size                == in_barrier2.size                &&
+            in_barrier1.srcQueueFamilyIndex == in_barrier2.srcQueueFamilyIndex);
+}
+
+/** Tells whether two image memory barriers can be merged into one by OR-ing their access masks. */
+static bool are_image_barriers_mergeable(const VkImageMemoryBarrier& in_barrier1,
+                                         const VkImageMemoryBarrier& in_barrier2)
+{
+    return (in_barrier1.dstQueueFamilyIndex             == in_barrier2.dstQueueFamilyIndex             &&
+            in_barrier1.image                           == in_barrier2.image                           &&
+            in_barrier1.newLayout                       == in_barrier2.newLayout                       &&
+            in_barrier1.oldLayout                       == in_barrier2.oldLayout                       &&
+            in_barrier1.pNext                           == nullptr                                     &&
+            in_barrier2.pNext                           == nullptr                                     &&
+            in_barrier1.srcQueueFamilyIndex             == in_barrier2.srcQueueFamilyIndex             &&
+            in_barrier1.subresourceRange.aspectMask     == in_barrier2.subresourceRange.aspectMask     &&
+            in_barrier1.subresourceRange.baseArrayLayer == in_barrier2.subresourceRange.baseArrayLayer &&
+            in_barrier1.subresourceRange.baseMipLevel   == in_barrier2.subresourceRange.baseMipLevel   &&
+            in_barrier1.subresourceRange.layerCount     == in_barrier2.subresourceRange.layerCount     &&
+            in_barrier1.subresourceRange.levelCount     == in_barrier2.subresourceRange.levelCount);
+}
+
+/** Adds the specified barriers to the pending batch. Barriers equivalent to ones which are already
+ *  pending are merged into the latter.
+ *
+ *  The caller must make sure the barriers do not conflict with the pending batch, as reported by
+ *  conflicts_with().
+ **/
+void Anvil::CommandBufferBase::DeferredBarrierState::append(VkPipelineStageFlags       in_src_stage_mask,
+                                                            VkPipelineStageFlags       in_dst_stage_mask,
+                                                            VkDependencyFlags          in_dependency_flags,
+                                                            uint32_t                   in_memory_barrier_count,
+                                                            const MemoryBarrier* const in_memory_barriers_ptr,
+                                                            uint32_t                   in_buffer_memory_barrier_count,
+                                                            const BufferBarrier* const in_buffer_memory_barriers_ptr,
+                                                            uint32_t                   in_image_memory_barrier_count,
+                                                            const ImageBarrier*  const in_image_memory_barriers_ptr)
+{
+    anvil_assert(is_empty() || dependency_flags == in_dependency_flags);
+
+    dependency_flags  = in_dependency_flags;
+    dst_stage_mask   |= in_dst_stage_mask;
+    src_stage_mask   |= in_src_stage_mask;
+
+    for (uint32_t n_memory_barrier = 0;
+                  n_memory_barrier < in_memory_barrier_count;
+                ++n_memory_barrier)
+    {
+        const VkMemoryBarrier barrier_vk = in_memory_barriers_ptr[n_memory_barrier].get_barrier_vk();
+
+        if (memory_barrier_used)
+        {
+            memory_barrier.dstAccessMask |= barrier_vk.dstAccessMask;
+            memory_barrier.srcAccessMask |= barrier_vk.srcAccessMask;
+
+            ++stats.n_barriers_merged;
+        }
+        else
+        {
+            memory_barrier      = barrier_vk;
+            memory_barrier_used = true;
+        }
+    }
+
+    for (uint32_t n_buffer_barrier = 0;
+                  n_buffer_barrier < in_buffer_memory_barrier_count;
+                ++n_buffer_barrier)
+    {
+        const VkBufferMemoryBarrier barrier_vk = in_buffer_memory_barriers_ptr[n_buffer_barrier].get_barrier_vk();
+        bool                        merged     = false;
+
+        for (auto& pending_barrier_vk : buffer_barriers)
+        {
+            if (are_buffer_barriers_mergeable(pending_barrier_vk,
+                                              barrier_vk) )
+            {
+                pending_barrier_vk.dstAccessMask |= barrier_vk.dstAccessMask;
+                pending_barrier_vk.srcAccessMask |= barrier_vk.srcAccessMask;
+                merged                            = true;
+
+                ++stats.n_barriers_merged;
+                break;
+            }
+        }
+
+        if (!merged)
+        {
+            buffer_barriers.push_back(barrier_vk);
+        }
+    }
+
+    for (uint32_t n_image_barrier = 0;
+                  n_image_barrier < in_image_memory_barrier_count;
+                ++n_image_barrier)
+    {
+        const VkImageMemoryBarrier barrier_vk = in_image_memory_barriers_ptr[n_image_barrier].get_barrier_vk();
+        bool                       merged     = false;
+
+        for (auto& pending_barrier_vk : image_barriers)
+        {
+            if (are_image_barriers_mergeable(pending_barrier_vk,
+                                             barrier_vk) )
+            {
+                pending_barrier_vk.dstAccessMask |= barrier_vk.dstAccessMask;
+                pending_barrier_vk.srcAccessMask |= barrier_vk.srcAccessMask;
+                merged                            = true;
+
+                ++stats.n_barriers_merged;
+                break;
+            }
+        }
+
+        if (!merged)
+        {
+            image_barriers.push_back(barrier_vk);
+        }
+    }
+
+    ++n_barrier_commands;
+    ++stats.n_barrier_commands_deferred;
+}
+
+/** Drops all pending barriers. Statistics are left intact. */
+void Anvil::CommandBufferBase::DeferredBarrierState::clear()
+{
+    buffer_barriers.clear();
+    image_barriers.clear ();
+
+    dependency_flags    = 0;
+    dst_stage_mask      = 0;
+    memory_barrier_used = false;
+    n_barrier_commands  = 0;
+    src_stage_mask      = 0;
+}
+
+/** Tells whether the specified barriers must not be issued in the same vkCmdPipelineBarrier() call as the
+ *  pending ones.
+ *
+ *  This is the case if dependency flags differ, or if a barrier overlaps a pending barrier on the same
+ *  resource without being mergeable with it, and either of the two performs a layout transition or
+ *  a queue family ownership transfer. Such barriers need to execute in order, which Vulkan does not
+ *  guarantee for barriers passed to a single call.
+ **/
+bool Anvil::CommandBufferBase::DeferredBarrierState::conflicts_with(VkDependencyFlags          in_dependency_flags,
+                                                                    uint32_t                   in_buffer_memory_barrier_count,
+                                                                    const BufferBarrier* const in_buffer_memory_barriers_ptr,
+                                                                    uint32_t                   in_image_memory_barrier_count,
+                                                                    const ImageBarrier*  const in_image_memory_barriers_ptr) const
+{
+    if (is_empty() )
+    {
+        return false;
+    }
+
+    if (dependency_flags != in_dependency_flags)
+    {
+        return true;
+    }
+
+    for (uint32_t n_buffer_barrier = 0;
+                  n_buffer_barrier < in_buffer_memory_barrier_count;
+                ++n_buffer_barrier)
+    {
+        const VkBufferMemoryBarrier* barrier_vk_ptr = in_buffer_memory_barriers_ptr[n_buffer_barrier].get_barrier_vk_ptr();
+
+        for (const auto& pending_barrier_vk : buffer_barriers)
+        {
+            if (!do_buffer_barriers_overlap   (pending_barrier_vk,
+                                               *barrier_vk_ptr) ||
+                 are_buffer_barriers_mergeable(pending_barrier_vk,
+                                               *barrier_vk_ptr) )
+            {
+                continue;
+            }
+
+            if (is_ownership_transfer(pending_barrier_vk) ||
+                is_ownership_transfer(*barrier_vk_ptr) )
+            {
+                return true;
+            }
+        }
+    }
+
+    for (uint32_t n_image_barrier = 0;
+                  n_image_barrier < in_image_memory_barrier_count;
+                ++n_image_barrier)
+    {
+        const VkImageMemoryBarrier* barrier_vk_ptr = in_image_memory_barriers_ptr[n_image_barrier].get_barrier_vk_ptr();
+
+        for (const auto& pending_barrier_vk : image_barriers)
+        {
+            if (!do_image_barriers_overlap   (pending_barrier_vk,
+                                              *barrier_vk_ptr) ||
+                 are_image_barriers_mergeable(pending_barrier_vk,
+                                              *barrier_vk_ptr) )
+            {
+                continue;
+            }
+
+            if (is_ownership_transfer(pending_barrier_vk)                   ||
+                is_ownership_transfer(*barrier_vk_ptr)                      ||
+                pending_barrier_vk.oldLayout != pending_barrier_vk.newLayout ||
+                barrier_vk_ptr->oldLayout    != barrier_vk_ptr->newLayout)
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+/** Discards all cached state. */
+void Anvil::CommandBufferBase::ShadowState::invalidate()
+{
+    bind_points[0].invalidate();
+    bind_points[1].invalidate();
+
+    index_buffer        = VK_NULL_HANDLE;
+    index_buffer_offset = 0;
+    index_type          = Anvil::IndexType::UNKNOWN;
+
+    vertex_buffers.clear       ();
+    vertex_buffer_offsets.clear();
+
+    invalidate_dynamic_state();
+}
+
+/** Discards cached dynamic state & push constant data. */
+void Anvil::CommandBufferBase::ShadowState::invalidate_dynamic_state()
+{
+    line_width_valid = false;
+    line_width       = 0.0f;
+
+    push_constants_data.clear();
+
+    push_constants_layout = VK_NULL_HANDLE;
+    push_constants_offset = 0;
+    push_constants_stages = 0;
+
+    scissors.clear       ();
+    scissors_valid.clear ();
+    viewports.clear      ();
+    viewports_valid.clear();
+}
+
+/** Returns true if the vkCmdBindDescriptorSets() call described by the arguments would not change
+ *  the bound state. Otherwise, updates the shadow state and returns false.
+ **/
+bool Anvil::CommandBufferBase::ShadowState::filter_bind_descriptor_sets(Anvil::PipelineBindPoint           in_pipeline_bind_point,
+                                                                        VkPipelineLayout                   in_layout,
+                                                                        uint32_t                           in_first_set,
+                                                                        uint32_t                           in_set_count,
+                                                                        const Anvil::DescriptorSet* const* in_descriptor_set_ptrs,
+                                                                        uint32_t                           in_dynamic_offset_count,
+                                                                        const uint32_t*                    in_dynamic_offset_ptrs)
+{
+    const uint32_t bind_point_index = static_cast<uint32_t>(in_pipeline_bind_point);
+    bool           is_redundant     = false;
+
+    if (bind_point_index >= sizeof(bind_points) / sizeof(bind_points[0]) )
+    {
+        goto end;
+    }
+
+    {
+        auto& bind_point = bind_points[bind_point_index];
+
+        /* Sets bound with a different pipeline layout may be disturbed. Be conservative and forget
+         * about all sets bound so far. */
+        if (bind_point.layout != in_layout)
+        {
+            bind_point.descriptor_sets.clear();
+            bind_point.dynamic_offsets.clear();
+
+            bind_point.first_set = UINT32_MAX;
+            bind_point.layout    = in_layout;
+            bind_point.n_sets    = 0;
+        }
+
+        if (bind_point.descriptor_sets.size() < in_first_set + in_set_count)
+        {
+            bind_point.descriptor_sets.resize(in_first_set + in_set_count,
+                                              VK_NULL_HANDLE);
+        }
+
+        is_redundant = true;
+
+        for (uint32_t n_set = 0;
+                      n_set < in_set_count && is_redundant;
+                    ++n_set)
+        {
+            is_redundant = (bind_point.descriptor_sets.at(in_first_set + n_set) == in_descriptor_set_ptrs[n_set]->get_descriptor_set_vk() );
+        }
+
+        /* Dynamic offsets cannot be attributed to individual sets without inspecting their layouts. The call
+         * is only considered redundant if it exactly matches the most recent one for this bind point. */
+        if (is_redundant            &&
+            in_dynamic_offset_count != 0)
+        {
+            is_redundant = (bind_point.first_set              == in_first_set            &&
+                            bind_point.n_sets                 == in_set_count            &&
+                            bind_point.dynamic_offsets.size() == in_dynamic_offset_count &&
+                            memcmp(&bind_point.dynamic_offsets.at(0),
+                                   in_dynamic_offset_ptrs,
+                                   sizeof(uint32_t) * in_dynamic_offset_count) == 0);
+        }
+
+        if (is_redundant)
+        {
+            ++stats.n_bind_descriptor_sets_commands_elided;
+
+            goto end;
+        }
+
+        for (uint32_t n_set = 0;
+                      n_set < in_set_count;
+                    ++n_set)
+        {
+            bind_point.descriptor_sets.at(in_first_set + n_set) = in_descriptor_set_ptrs[n_set]->get_descriptor_set_vk();
+        }
+
+        bind_point.dynamic_offsets.assign(in_dynamic_offset_ptrs,
+                                          in_dynamic_offset_ptrs + in_dynamic_offset_count);
+
+        bind_point.first_set = in_first_set;
+        bind_point.n_sets    = in_set_count;
+    }
+
+end:
+    return is_redundant;
+}
+
+/** Returns true if the vkCmdBindIndexBuffer() call described by the arguments would not change
+ *  the bound state. Otherwise, updates the shadow state and returns false.
+ **/
+bool Anvil::CommandBufferBase::ShadowState::filter_bind_index_buffer(VkBuffer         in_buffer,
+                                                                     VkDeviceSize     in_offset,
+                                                                     Anvil::IndexType in_index_type)
+{
+    if (index_buffer        == in_buffer &&
+        index_buffer_offset == in_offset &&
+        index_type          == in_index_type)
+    {
+        ++stats.n_bind_index_buffer_commands_elided;
+
+        return true;
+    }
+
+    index_buffer        = in_buffer;
+    index_buffer_offset = in_offset;
+    index_type          = in_index_type;
+
+    return false;
+}
+
+/** Returns true if the vkCmdBindPipeline() call described by the arguments would not change
+ *  the bound state. Otherwise, updates the shadow state and returns false.
+ **/
+bool Anvil::CommandBufferBase::ShadowState::filter_bind_pipeline(Anvil::PipelineBindPoint in_pipeline_bind_point,
+                                                                 VkPipeline               in_pipeline)
+{
+    const uint32_t bind_point_index = static_cast<uint32_t>(in_pipeline_bind_point);
+
+    if (bind_point_index >= sizeof(bind_points) / sizeof(bind_points[0]) )
+    {
+        return false;
+    }
+
+    if (bind_points[bind_point_index].pipeline == in_pipeline)
+    {
+        ++stats.n_bind_pipeline_commands_elided;
+
+        return true;
+    }
+
+    bind_points[bind_point_index].pipeline = in_pipeline;
+
+    /* The new pipeline may specify some of the dynamic states statically, or use a push constant layout
+     * which is incompatible with the one used so far. */
+    invalidate_dynamic_state();
+
+    return false;
+}
+
+/** Returns true if the vkCmdBindVertexBuffers() call described by the arguments would not change
+ *  the bound state. Otherwise, updates the shadow state and returns false.
+ **/
+bool Anvil::CommandBufferBase::ShadowState::filter_bind_vertex_buffers(uint32_t            in_start_binding,
+                                                                       uint32_t            in_binding_count,
+                                                                       Anvil::Buffer**     in_buffer_ptrs,
+                                                                       const VkDeviceSize* in_offset_ptrs)
+{
+    bool is_redundant = true;
+
+    if (vertex_buffers.size() < in_start_binding + in_binding_count)
+    {
+        vertex_buffers.resize       (in_start_binding + in_binding_count,
+                                     VK_NULL_HANDLE);
+        vertex_buffer_offsets.resize(in_start_binding + in_binding_count,
+                                     0);
+    }
+
+    for (uint32_t n_binding = 0;
+                  n_binding < in_binding_count && is_redundant;
+                ++n_binding)
+    {
+        is_redundant = (vertex_buffers.at       (in_start_binding + n_binding) == in_buffer_ptrs[n_binding]->get_buffer() &&
+                        vertex_buffer_offsets.at(in_start_binding + n_binding) == in_offset_ptrs[n_binding]);
+    }
+
+    if (is_redundant)
+    {
+        ++stats.n_bind_vertex_buffers_commands_elided;
+
+        return true;
+    }
+
+    for (uint32_t n_binding = 0;
+                  n_binding < in_binding_count;
+                ++n_binding)
+    {
+        vertex_buffers.at       (in_start_binding + n_binding) = in_buffer_ptrs[n_binding]->get_buffer();
+        vertex_buffer_offsets.at(in_start_binding + n_binding) = in_offset_ptrs[n_binding];
+    }
+
+    return false;
+}
+
+/** Returns true if the vkCmdPushConstants() call described by the arguments is identical to the
+ *  most recent one. Otherwise, updates the shadow state and returns false.
+ **/
+bool Anvil::CommandBufferBase::ShadowState::filter_push_constants(VkPipelineLayout   in_layout,
+                                                                  VkShaderStageFlags in_stages,
+                                                                  uint32_t           in_offset,
+                                                                  uint32_t           in_size,
+                                                                  const void*        in_values)
+{
+    if (push_constants_layout      == in_layout &&
+        push_constants_stages      == in_stages &&
+        push_constants_offset      == in_offset &&
+        push_constants_data.size() == in_size   &&
+        in_size                    >  0         &&
+        memcmp(&push_constants_data.at(0),
+               in_values,
+               in_size) == 0)
+    {
+        ++stats.n_push_constants_commands_elided;
+
+        return true;
+    }
+
+    push_constants_data.assign(static_cast<const uint8_t*>(in_values),
+                               static_cast<const uint8_t*>(in_values) + in_size);
+
+    push_constants_layout = in_layout;
+    push_constants_offset = in_offset;
+    push_constants_stages = in_stages;
+
+    return false;
+}
+
+/** Returns true if the vkCmdSetLineWidth() call described by the arguments would not change
+ *  the bound state. Otherwise, updates the shadow state and returns false.
+ **/
+bool Anvil::CommandBufferBase::ShadowState::filter_set_line_width(float in_line_width)
+{
+    if (line_width_valid             &&
+        line_width == in_line_width)
+    {
+        ++stats.n_set_line_width_commands_elided;
+
+        return true;
+    }
+
+    line_width       = in_line_width;
+    line_width_valid = true;
+
+    return false;
+}
+
+/** Returns true if the vkCmdSetScissor() call described by the arguments would not change
+ *  the bound state. Otherwise, updates the shadow state and returns false.
+ **/
+bool Anvil::CommandBufferBase::ShadowState::filter_set_scissor(uint32_t        in_first_scissor,
+                                                               uint32_t        in_scissor_count,
+                                                               const VkRect2D* in_scissor_ptrs)
+{
+    bool is_redundant = true;
+
+    if (scissors.size() < in_first_scissor + in_scissor_count)
+    {
+        scissors.resize      (in_first_scissor + in_scissor_count);
+        scissors_valid.resize(in_first_scissor + in_scissor_count,
+                              false);
+    }
+
+    for (uint32_t n_scissor = 0;
+                  n_scissor < in_scissor_count && is_redundant;
+                ++n_scissor)
+    {
+        is_redundant = scissors_valid.at(in_first_scissor + n_scissor) &&
+                       memcmp(&scissors.at(in_first_scissor + n_scissor),
+                              in_scissor_ptrs + n_scissor,
+                              sizeof(VkRect2D) ) == 0;
+    }
+
+    if (is_redundant)
+    {
+        ++stats.n_set_scissor_commands_elided;
+
+        return true;
+    }
+
+    for (uint32_t n_scissor = 0;
+                  n_scissor < in_scissor_count;
+                ++n_scissor)
+    {
+        scissors.at      (in_first_scissor + n_scissor) = in_scissor_ptrs[n_scissor];
+        scissors_valid.at(in_first_scissor + n_scissor) = true;
+    }
+
+    return false;
+}
+
+/** Returns true if the vkCmdSetViewport() call described by the arguments would not change
+ *  the bound state. Otherwise, updates the shadow state and returns false.
+ **/
+bool Anvil::CommandBufferBase::ShadowState::filter_set_viewport(uint32_t          in_first_viewport,
+                                                                uint32_t          in_viewport_count,
+                                                                const VkViewport* in_viewport_ptrs)
+{
+    bool is_redundant = true;
+
+    if (viewports.size() < in_first_viewport + in_viewport_count)
+    {
+        viewports.resize      (in_first_viewport + in_viewport_count);
+        viewports_valid.resize(in_first_viewport + in_viewport_count,
+                               false);
+    }
+
+    for (uint32_t n_viewport = 0;
+                  n_viewport < in_viewport_count && is_redundant;
+                ++n_viewport)
+    {
+        is_redundant = viewports_valid.at(in_first_viewport + n_viewport) &&
+                       memcmp(&viewports.at(in_first_viewport + n_viewport),
+                              in_viewport_ptrs + n_viewport,
+                              sizeof(VkViewport) ) == 0;
+    }
+
+    if (is_redundant)
+    {
+        ++stats.n_set_viewport_commands_elided;
+
+        return true;
+    }
+
+    for (uint32_t n_viewport = 0;
+                  n_viewport < in_viewport_count;
+                ++n_viewport)
+    {
+        viewports.at      (in_first_viewport + n_viewport) = in_viewport_ptrs[n_viewport];
+        viewports_valid.at(in_first_viewport + n_viewport) = true;
+    }
+
+    return false;
+}
+
 /** Constructor.
  *
  *  @param device_ptr              Device to use.
@@ -1069,6 +1686,8 @@ Anvil::CommandBufferBase::CommandBufferBase(const Anvil::BaseDevice* in_device_p
      m_command_buffer               (VK_NULL_HANDLE),
      m_device_mask                  (0),
      m_device_ptr                   (in_device_ptr),
+     m_exclusive_recording_active   (false),
+     m_exclusive_recording_enabled  (false),
      m_is_renderpass_active         (false),
      m_n_debug_label_regions_started(0),
      m_parent_command_pool_ptr      (in_parent_command_pool_ptr),
@@ -1089,20 +1708,21 @@ Anvil::CommandBufferBase::~CommandBufferBase()
 {
     anvil_assert(!m_recording_in_progress);
 
+    /* Do not leave the parent pool owned by this thread if the command buffer is destroyed mid-recording */
+    end_exclusive_recording();
+
     if (m_command_buffer          != VK_NULL_HANDLE &&
         m_parent_command_pool_ptr != nullptr)
     {
         /* Physically free the command buffer we own */
-        m_parent_command_pool_ptr->lock();
-        lock();
+        acquire_recording_locks();
         {
             Anvil::Vulkan::vkFreeCommandBuffers(m_device_ptr->get_device_vk(),
                                                 m_parent_command_pool_ptr->get_command_pool(),
                                                 1, /* commandBufferCount */
                                                &m_command_buffer);
         }
-        unlock();
-        m_parent_command_pool_ptr->unlock();
+        release_recording_locks();
 
         m_command_buffer = VK_NULL_HANDLE;
     }
@@ -1114,6 +1734,52 @@ Anvil::CommandBufferBase::~CommandBufferBase()
     #endif
 }
 
+/** Locks the parent command pool and the command buffer for the duration of a Vulkan call.
+ *
+ *  No locks are taken if exclusive recording is in progress, since the recording thread is then the only one
+ *  which is allowed to use the pool.
+ *
+ *  Since every command goes through this function before it is passed to Vulkan, this is also where
+ *  barriers deferred by barrier batching are flushed.
+ **/
+void Anvil::CommandBufferBase::acquire_recording_locks()
+{
+    if (m_exclusive_recording_active)
+    {
+        anvil_assert(m_exclusive_recording_thread_id == std::this_thread::get_id() );
+    }
+    else
+    {
+        m_parent_command_pool_ptr->lock();
+        lock();
+    }
+
+    if (m_deferred_barrier_state_ptr != nullptr &&
+        m_recording_in_progress)
+    {
+        emit_deferred_barriers();
+    }
+}
+
+/** Starts exclusive recording, if it has been requested for the command buffer. Until end_exclusive_recording()
+ *  is called, the calling thread is registered as the owner of the parent command pool, and record_*() calls do
+ *  not lock the pool or the command buffer.
+ **/
+void Anvil::CommandBufferBase::begin_exclusive_recording()
+{
+    if (!m_exclusive_recording_enabled)
+    {
+        return;
+    }
+
+    anvil_assert(!m_exclusive_recording_active);
+
+    m_parent_command_pool_ptr->on_exclusive_recording_started();
+
+    m_exclusive_recording_active    = true;
+    m_exclusive_recording_thread_id = std::this_thread::get_id();
+}
+
 /** Please see header for specification */
 void Anvil::CommandBufferBase::begin_debug_utils_label(const char*  in_label_name_ptr,
                                                        const float* in_color_vec4_ptr)
@@ -1123,6 +1789,8 @@ void Anvil::CommandBufferBase::begin_debug_utils_label(const char*  in_label_nam
         goto end;
     }
 
+    flush_deferred_barriers();
+
     {
         const auto&          entrypoints = m_device_ptr->get_parent_instance()->get_extension_ext_debug_utils_entrypoints();
         VkDebugUtilsLabelEXT label_info;
@@ -1167,6 +1835,8 @@ void Anvil::CommandBufferBase::end_debug_utils_label()
         goto end;
     }
 
+    flush_deferred_barriers();
+
     {
         const auto& entrypoints = m_device_ptr->get_parent_instance()->get_extension_ext_debug_utils_entrypoints();
 
@@ -1178,6 +1848,82 @@ end:
     ;
 }
 
+/** Issues a single vkCmdPipelineBarrier() call for all pending deferred barriers and empties the batch.
+ *
+ *  The recording locks must be held by the caller.
+ **/
+void Anvil::CommandBufferBase::emit_deferred_barriers()
+{
+    DeferredBarrierState* state_ptr = m_deferred_barrier_state_ptr.get();
+
+    if (state_ptr->is_empty() )
+    {
+        return;
+    }
+
+    Anvil::Vulkan::vkCmdPipelineBarrier(m_command_buffer,
+                                        state_ptr->src_stage_mask,
+                                        state_ptr->dst_stage_mask,
+                                        state_ptr->dependency_flags,
+                                        (state_ptr->memory_barrier_used)        ? 1u                                 : 0u,
+                                        (state_ptr->memory_barrier_used)        ? &state_ptr->memory_barrier         : nullptr,
+                                        static_cast<uint32_t>(state_ptr->buffer_barriers.size() ),
+                                        (state_ptr->buffer_barriers.size() > 0) ? &state_ptr->buffer_barriers.at(0) : nullptr,
+                                        static_cast<uint32_t>(state_ptr->image_barriers.size() ),
+                                        (state_ptr->image_barriers.size()  > 0) ? &state_ptr->image_barriers.at(0)  : nullptr);
+
+    ++state_ptr->stats.n_pipeline_barrier_calls;
+
+    state_ptr->clear();
+}
+
+/** Ends exclusive recording started with begin_exclusive_recording(). No-op if exclusive recording is not
+ *  in progress.
+ **/
+void Anvil::CommandBufferBase::end_exclusive_recording()
+{
+    if (!m_exclusive_recording_active)
+    {
+        return;
+    }
+
+    anvil_assert(m_exclusive_recording_thread_id == std::this_thread::get_id() );
+
+    m_exclusive_recording_active    = false;
+    m_exclusive_recording_thread_id = std::thread::id();
+
+    m_parent_command_pool_ptr->on_exclusive_recording_finished();
+}
+
+/* Please see header for specification */
+void Anvil::CommandBufferBase::flush_deferred_barriers()
+{
+    if (m_deferred_barrier_state_ptr == nullptr    ||
+        m_deferred_barrier_state_ptr->is_empty() ||
+        !m_recording_in_progress)
+    {
+        return;
+    }
+
+    /* acquire_recording_locks() flushes the pending barriers on our behalf */
+    acquire_recording_locks();
+    release_recording_locks();
+}
+
+/* Please see header for specification */
+Anvil::BarrierBatchingStats Anvil::CommandBufferBase::get_barrier_batching_stats() const
+{
+    return (m_deferred_barrier_state_ptr != nullptr) ? m_deferred_barrier_state_ptr->stats
+                                                     : BarrierBatchingStats();
+}
+
+/* Please see header for specification */
+Anvil::RedundantStateFilterStats Anvil::CommandBufferBase::get_redundant_state_filter_stats() const
+{
+    return (m_shadow_state_ptr != nullptr) ? m_shadow_state_ptr->stats
+                                           : RedundantStateFilterStats();
+}
+
 /** Please see header for specification */
 void Anvil::CommandBufferBase::insert_debug_utils_label(const char*  in_label_name_ptr,
                                                         const float* in_color_vec4_ptr)
@@ -1187,6 +1933,8 @@ void Anvil::CommandBufferBase::insert_debug_utils_label(const char*  in_label_na
         goto end;
     }
 
+    flush_deferred_barriers();
+
     {
         const auto&          entrypoints = m_device_ptr->get_parent_instance()->get_extension_ext_debug_utils_entrypoints();
         VkDebugUtilsLabelEXT label_info;
@@ -1207,6 +1955,20 @@ end:
     ;
 }
 
+/* Please see header for specification */
+void Anvil::CommandBufferBase::invalidate_shadow_state(bool in_reset_stats)
+{
+    if (m_shadow_state_ptr != nullptr)
+    {
+        m_shadow_state_ptr->invalidate();
+
+        if (in_reset_stats)
+        {
+            m_shadow_state_ptr->stats = Anvil::RedundantStateFilterStats();
+        }
+    }
+}
+
 /* Please see header for specification */
 bool Anvil::CommandBufferBase::record_begin_query(Anvil::QueryPool*        in_query_pool_ptr,
                                                   Anvil::QueryIndex        in_entry,
@@ -1233,16 +1995,14 @@ bool Anvil::CommandBufferBase::record_begin_query(Anvil::QueryPool*        in_qu
     }
     #endif
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    acquire_recording_locks();
     {
         Anvil::Vulkan::vkCmdBeginQuery(m_command_buffer,
                                        in_query_pool_ptr->get_query_pool(),
                                        in_entry,
                                        in_flags.get_vk() );
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     result = true;
 end:
@@ -1278,8 +2038,7 @@ bool Anvil::CommandBufferBase::record_begin_query_indexed(Anvil::QueryPool*
     }
     #endif
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    acquire_recording_locks();
     {
         entrypoints.vkCmdBeginQueryIndexedEXT(m_command_buffer,
                                               in_query_pool_ptr->get_query_pool(),
@@ -1287,8 +2046,7 @@ bool Anvil::CommandBufferBase::record_begin_query_indexed(Anvil::QueryPool*
                                               in_flags.get_vk(),
                                               in_index);
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     result = true;
 end:
@@ -1301,9 +2059,9 @@ bool Anvil::CommandBufferBase::record_begin_transform_feedback_EXT(const uint32_
                                                                    Anvil::Buffer**     in_opt_counter_buffer_ptrs,
                                                                    const VkDeviceSize* in_opt_counter_buffer_offsets)
 {
-    auto        counter_buffer_ptrs = std::vector<VkBuffer>(in_n_counter_buffers);
-    const auto& entrypoints         = m_device_ptr->get_extension_ext_transform_feedback_entrypoints();
-    bool        result              = false;
+    VkBuffer*   counter_buffers_vk_ptr = nullptr;
+    const auto& entrypoints            = m_device_ptr->get_extension_ext_transform_feedback_entrypoints();
+    bool        result                 = false;
 
     if (!m_is_renderpass_active)
     {
@@ -1319,13 +2077,6 @@ bool Anvil::CommandBufferBase::record_begin_transform_feedback_EXT(const uint32_
         goto end;
     }
 
-    for (uint32_t n_counter_buffer = 0;
-                  n_counter_buffer < in_n_counter_buffers;
-                ++n_counter_buffer)
-    {
-        counter_buffer_ptrs.at(n_counter_buffer) = in_opt_counter_buffer_ptrs[n_counter_buffer]->get_buffer();
-    }
-
     #ifdef STORE_COMMAND_BUFFER_COMMANDS
     {
         if (!m_command_stashing_disabled)
@@ -1348,17 +2099,25 @@ bool Anvil::CommandBufferBase::record_begin_transform_feedback_EXT(const uint32_
     }
     #endif
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    acquire_recording_locks();
     {
+        counter_buffers_vk_ptr = get_scratch_storage(in_n_counter_buffers,
+                                                    m_scratch_buffers_vk);
+
+        for (uint32_t n_counter_buffer = 0;
+                      n_counter_buffer < in_n_counter_buffers;
+                    ++n_counter_buffer)
+        {
+            counter_buffers_vk_ptr[n_counter_buffer] = in_opt_counter_buffer_ptrs[n_counter_buffer]->get_buffer();
+        }
+
         entrypoints.vkCmdBeginTransformFeedbackEXT(m_command_buffer,
                                                    in_first_counter_buffer,
                                                    in_n_counter_buffers,
-                                                   (in_n_counter_buffers > 0) ? &counter_buffer_ptrs.at(0) : nullptr,
+                                                   counter_buffers_vk_ptr,
                                                    in_opt_counter_buffer_offsets);
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     result = true;
 end:
@@ -1375,19 +2134,26 @@ bool Anvil::CommandBufferBase::record_bind_descriptor_sets(Anvil::PipelineBindPo
                                                            const uint32_t*                    in_dynamic_offset_ptrs)
 {
     /* Note: Command supported inside and outside the renderpass. */
-    auto dss_vk = std::vector<VkDescriptorSet>(in_set_count);
-    bool result = false;
+    VkDescriptorSet* dss_vk_ptr = nullptr;
+    bool             result     = false;
 
-    for (uint32_t n_set = 0;
-                  n_set < in_set_count;
-                ++n_set)
+    if (!m_recording_in_progress)
     {
-        dss_vk.at(n_set) = in_descriptor_set_ptrs[n_set]->get_descriptor_set_vk();
+        anvil_assert(m_recording_in_progress);
+
+        goto end;
     }
 
-    if (!m_recording_in_progress)
+    if (m_shadow_state_ptr != nullptr                                                      &&
+        m_shadow_state_ptr->filter_bind_descriptor_sets(in_pipeline_bind_point,
+                                                        in_layout_ptr->get_pipeline_layout(),
+                                                        in_first_set,
+                                                        in_set_count,
+                                                        in_descriptor_set_ptrs,
+                                                        in_dynamic_offset_count,
+                                                        in_dynamic_offset_ptrs) )
     {
-        anvil_assert(m_recording_in_progress);
+        result = true;
 
         goto end;
     }
@@ -1407,20 +2173,28 @@ bool Anvil::CommandBufferBase::record_bind_descriptor_sets(Anvil::PipelineBindPo
     }
     #endif
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    acquire_recording_locks();
     {
+        dss_vk_ptr = get_scratch_storage(in_set_count,
+                                         m_scratch_descriptor_sets_vk);
+
+        for (uint32_t n_set = 0;
+                      n_set < in_set_count;
+                    ++n_set)
+        {
+            dss_vk_ptr[n_set] = in_descriptor_set_ptrs[n_set]->get_descriptor_set_vk();
+        }
+
         Anvil::Vulkan::vkCmdBindDescriptorSets(m_command_buffer,
                                                static_cast<VkPipelineBindPoint>(in_pipeline_bind_point),
                                                in_layout_ptr->get_pipeline_layout(),
                                                in_first_set,
                                                in_set_count,
-                                               (in_set_count > 0) ? &dss_vk.at(0) : nullptr,
+                                               dss_vk_ptr,
                                                in_dynamic_offset_count,
                                                in_dynamic_offset_ptrs);
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     result = true;
 end:
@@ -1442,6 +2216,16 @@ bool Anvil::CommandBufferBase::record_bind_index_buffer(Anvil::Buffer*   in_buff
         goto end;
     }
 
+    if (m_shadow_state_ptr != nullptr                                             &&
+        m_shadow_state_ptr->filter_bind_index_buffer(in_buffer_ptr->get_buffer(),
+                                                     in_offset,
+                                                     in_index_type) )
+    {
+        result = true;
+
+        goto end;
+    }
+
     #ifdef STORE_COMMAND_BUFFER_COMMANDS
     {
         if (!m_command_stashing_disabled)
@@ -1453,16 +2237,14 @@ bool Anvil::CommandBufferBase::record_bind_index_buffer(Anvil::Buffer*   in_buff
     }
     #endif
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    acquire_recording_locks();
     {
         Anvil::Vulkan::vkCmdBindIndexBuffer(m_command_buffer,
                                             in_buffer_ptr->get_buffer(),
                                             in_offset,
                                             static_cast<VkIndexType>(in_index_type) );
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     result = true;
 end:
@@ -1490,6 +2272,15 @@ bool Anvil::CommandBufferBase::record_bind_pipeline(Anvil::PipelineBindPoint in_
     pipeline_vk = (in_pipeline_bind_point == Anvil::PipelineBindPoint::COMPUTE) ? m_device_ptr->get_compute_pipeline_manager ()->get_pipeline(in_pipeline_id)
                                                                                 : m_device_ptr->get_graphics_pipeline_manager()->get_pipeline(in_pipeline_id);
 
+    if (m_shadow_state_ptr != nullptr                                   &&
+        m_shadow_state_ptr->filter_bind_pipeline(in_pipeline_bind_point,
+                                                 pipeline_vk) )
+    {
+        result = true;
+
+        goto end;
+    }
+
     #ifdef STORE_COMMAND_BUFFER_COMMANDS
     {
         if (!m_command_stashing_disabled)
@@ -1500,15 +2291,13 @@ bool Anvil::CommandBufferBase::record_bind_pipeline(Anvil::PipelineBindPoint in_
     }
     #endif
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    acquire_recording_locks();
     {
         Anvil::Vulkan::vkCmdBindPipeline(m_command_buffer,
                                          static_cast<VkPipelineBindPoint>(in_pipeline_bind_point),
                                          pipeline_vk);
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     result = true;
 end:
@@ -1523,9 +2312,9 @@ bool Anvil::CommandBufferBase::record_bind_transform_feedback_buffers_EXT(const
                                                                           const VkDeviceSize* in_sizes_ptr)
 {
     /* Note: Command supported inside and outside the renderpass. */
-    auto        buffers     = std::vector<VkBuffer>(in_n_bindings);
-    const auto& entrypoints = m_device_ptr->get_extension_ext_transform_feedback_entrypoints ();
-    bool        result      = false;
+    VkBuffer*   buffers_vk_ptr = nullptr;
+    const auto& entrypoints    = m_device_ptr->get_extension_ext_transform_feedback_entrypoints ();
+    bool        result         = false;
 
     if (!m_recording_in_progress)
     {
@@ -1560,25 +2349,26 @@ bool Anvil::CommandBufferBase::record_bind_transform_feedback_buffers_EXT(const
     }
     #endif
 
-    for (uint32_t n_binding = 0;
-                  n_binding < in_n_bindings;
-                ++n_binding)
+    acquire_recording_locks();
     {
-        buffers.at(n_binding) = in_buffer_ptrs[n_binding]->get_buffer();
-    }
+        buffers_vk_ptr = get_scratch_storage(in_n_bindings,
+                                             m_scratch_buffers_vk);
+
+        for (uint32_t n_binding = 0;
+                      n_binding < in_n_bindings;
+                    ++n_binding)
+        {
+            buffers_vk_ptr[n_binding] = in_buffer_ptrs[n_binding]->get_buffer();
+        }
 
-    m_parent_command_pool_ptr->lock();
-    lock();
-    {
         entrypoints.vkCmdBindTransformFeedbackBuffersEXT(m_command_buffer,
                                                          in_first_binding,
                                                          in_n_bindings,
-                                                         (in_n_bindings > 0) ? &buffers.at(0) : nullptr,
+                                                         buffers_vk_ptr,
                                                          in_offsets_ptr,
                                                          in_sizes_ptr);
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     result = true;
 end:
@@ -1592,8 +2382,8 @@ bool Anvil::CommandBufferBase::record_bind_vertex_buffers(uint32_t            in
                                                           const VkDeviceSize* in_offset_ptrs)
 {
     /* Note: Command supported inside and outside the renderpass. */
-    auto buffers = std::vector<VkBuffer>(in_binding_count);
-    bool result  = false;
+    VkBuffer* buffers_vk_ptr = nullptr;
+    bool      result         = false;
 
     if (!m_recording_in_progress)
     {
@@ -1602,6 +2392,17 @@ bool Anvil::CommandBufferBase::record_bind_vertex_buffers(uint32_t            in
         goto end;
     }
 
+    if (m_shadow_state_ptr != nullptr                                 &&
+        m_shadow_state_ptr->filter_bind_vertex_buffers(in_start_binding,
+                                                       in_binding_count,
+                                                       in_buffer_ptrs,
+                                                       in_offset_ptrs) )
+    {
+        result = true;
+
+        goto end;
+    }
+
     #ifdef STORE_COMMAND_BUFFER_COMMANDS
     {
         if (!m_command_stashing_disabled)
@@ -1614,24 +2415,25 @@ bool Anvil::CommandBufferBase::record_bind_vertex_buffers(uint32_t            in
     }
     #endif
 
-    for (uint32_t n_binding = 0;
-                  n_binding < in_binding_count;
-                ++n_binding)
+    acquire_recording_locks();
     {
-        buffers.at(n_binding) = in_buffer_ptrs[n_binding]->get_buffer();
-    }
+        buffers_vk_ptr = get_scratch_storage(in_binding_count,
+                                             m_scratch_buffers_vk);
+
+        for (uint32_t n_binding = 0;
+                      n_binding < in_binding_count;
+                    ++n_binding)
+        {
+            buffers_vk_ptr[n_binding] = in_buffer_ptrs[n_binding]->get_buffer();
+        }
 
-    m_parent_command_pool_ptr->lock();
-    lock();
-    {
         Anvil::Vulkan::vkCmdBindVertexBuffers(m_command_buffer,
                                               in_start_binding,
                                               in_binding_count,
-                                              (in_binding_count > 0) ? &buffers.at(0) : nullptr,
+                                              buffers_vk_ptr,
                                               in_offset_ptrs);
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     result = true;
 end:
@@ -1678,8 +2480,7 @@ bool Anvil::CommandBufferBase::record_blit_image(Anvil::Image*           in_src_
     }
     #endif
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    acquire_recording_locks();
     {
         Anvil::Vulkan::vkCmdBlitImage(m_command_buffer,
                                       in_src_image_ptr->get_image(),
@@ -1690,8 +2491,7 @@ bool Anvil::CommandBufferBase::record_blit_image(Anvil::Image*           in_src_
                                       reinterpret_cast<const VkImageBlit*>(in_region_ptrs),
                                       static_cast<VkFilter>(in_filter) );
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     result = true;
 end:
@@ -1732,8 +2532,7 @@ bool Anvil::CommandBufferBase::record_clear_attachments(uint32_t
     }
     #endif
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    acquire_recording_locks();
     {
         Anvil::Vulkan::vkCmdClearAttachments(m_command_buffer,
                                              in_n_attachments,
@@ -1741,8 +2540,7 @@ bool Anvil::CommandBufferBase::record_clear_attachments(uint32_t
                                              in_n_rects,
                                              in_rect_ptrs);
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     result = true;
 end:
@@ -1785,8 +2583,7 @@ bool Anvil::CommandBufferBase::record_clear_color_image(Anvil::Image*
     }
     #endif
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    acquire_recording_locks();
     {
         Anvil::Vulkan::vkCmdClearColorImage(m_command_buffer,
                                             in_image_ptr->get_image(),
@@ -1795,8 +2592,7 @@ bool Anvil::CommandBufferBase::record_clear_color_image(Anvil::Image*
                                             in_range_count,
                                             reinterpret_cast<const VkImageSubresourceRange*>(in_range_ptrs) );
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     result = true;
 end:
@@ -1839,8 +2635,7 @@ bool Anvil::CommandBufferBase::record_clear_depth_stencil_image(Anvil::Image*
     }
     #endif
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    acquire_recording_locks();
     {
         Anvil::Vulkan::vkCmdClearDepthStencilImage(m_command_buffer,
                                                    in_image_ptr->get_image(),
@@ -1849,14 +2644,37 @@ bool Anvil::CommandBufferBase::record_clear_depth_stencil_image(Anvil::Image*
                                                    in_range_count,
                                                    reinterpret_cast<const VkImageSubresourceRange*>(in_range_ptrs) );
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     result = true;
 end:
     return result;
 }
 
+/* Please see header for specification */
+bool Anvil::CommandBufferBase::record_command_stream(const Anvil::CommandStream* in_command_stream_ptr)
+{
+    bool result = false;
+
+    if (in_command_stream_ptr == nullptr)
+    {
+        anvil_assert(in_command_stream_ptr != nullptr);
+
+        goto end;
+    }
+
+    if (!m_recording_in_progress)
+    {
+        anvil_assert(m_recording_in_progress);
+
+        goto end;
+    }
+
+    result = in_command_stream_ptr->replay(this);
+end:
+    return result;
+}
+
 /* Please see header for specification */
 bool Anvil::CommandBufferBase::record_copy_buffer(Anvil::Buffer*           in_src_buffer_ptr,
                                                   Anvil::Buffer*           in_dst_buffer_ptr,
@@ -1891,8 +2709,7 @@ bool Anvil::CommandBufferBase::record_copy_buffer(Anvil::Buffer*           in_sr
     }
     #endif
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    acquire_recording_locks();
     {
         Anvil::Vulkan::vkCmdCopyBuffer(m_command_buffer,
                                        in_src_buffer_ptr->get_buffer(),
@@ -1900,8 +2717,7 @@ bool Anvil::CommandBufferBase::record_copy_buffer(Anvil::Buffer*           in_sr
                                        in_region_count,
                                        reinterpret_cast<const VkBufferCopy*>(in_region_ptrs) );
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     result = true;
 end:
@@ -1944,8 +2760,7 @@ bool Anvil::CommandBufferBase::record_copy_buffer_to_image(Anvil::Buffer*
     }
     #endif
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    acquire_recording_locks();
     {
         Anvil::Vulkan::vkCmdCopyBufferToImage(m_command_buffer,
                                               in_src_buffer_ptr->get_buffer(),
@@ -1954,8 +2769,7 @@ bool Anvil::CommandBufferBase::record_copy_buffer_to_image(Anvil::Buffer*
                                               in_region_count,
                                               reinterpret_cast<const VkBufferImageCopy*>(in_region_ptrs) );
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     result = true;
 end:
@@ -2000,8 +2814,7 @@ bool Anvil::CommandBufferBase::record_copy_image(Anvil::Image*           in_src_
     }
     #endif
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    acquire_recording_locks();
     {
         Anvil::Vulkan::vkCmdCopyImage(m_command_buffer,
                                       in_src_image_ptr->get_image(),
@@ -2011,8 +2824,7 @@ bool Anvil::CommandBufferBase::record_copy_image(Anvil::Image*           in_src_
                                       in_region_count,
                                       reinterpret_cast<const VkImageCopy*>(in_region_ptrs) );
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     result = true;
 end:
@@ -2055,8 +2867,7 @@ bool Anvil::CommandBufferBase::record_copy_image_to_buffer(Anvil::Image*
     }
     #endif
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    acquire_recording_locks();
     {
         Anvil::Vulkan::vkCmdCopyImageToBuffer(m_command_buffer,
                                               in_src_image_ptr->get_image(),
@@ -2065,8 +2876,7 @@ bool Anvil::CommandBufferBase::record_copy_image_to_buffer(Anvil::Image*
                                               in_region_count,
                                               reinterpret_cast<const VkBufferImageCopy*>(in_region_ptrs) );
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     result = true;
 end:
@@ -2113,8 +2923,7 @@ bool Anvil::CommandBufferBase::record_copy_query_pool_results(Anvil::QueryPool*
     }
     #endif
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    acquire_recording_locks();
     {
         Anvil::Vulkan::vkCmdCopyQueryPoolResults(m_command_buffer,
                                                  in_query_pool_ptr->get_query_pool(),
@@ -2125,8 +2934,7 @@ bool Anvil::CommandBufferBase::record_copy_query_pool_results(Anvil::QueryPool*
                                                  in_dst_stride,
                                                  in_flags);
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     result = true;
 end:
@@ -2165,16 +2973,14 @@ bool Anvil::CommandBufferBase::record_dispatch(uint32_t in_x,
     }
     #endif
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    acquire_recording_locks();
     {
         Anvil::Vulkan::vkCmdDispatch(m_command_buffer,
                                      in_x,
                                      in_y,
                                      in_z);
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     result = true;
 end:
@@ -2226,12 +3032,12 @@ bool Anvil::CommandBufferBase::record_debug_marker_begin_EXT(const std::string&
     marker_info.pNext       = nullptr;
     marker_info.sType       = VK_STRUCTURE_TYPE_DEBUG_MARKER_MARKER_INFO_EXT;
 
-    m_parent_command_pool_ptr->lock();
+    acquire_recording_locks();
     {
         entrypoints.vkCmdDebugMarkerBeginEXT(m_command_buffer,
                                             &marker_info);
     }
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     result = true;
 end:
@@ -2263,11 +3069,11 @@ bool Anvil::CommandBufferBase::record_debug_marker_end_EXT()
     }
     #endif
 
-    m_parent_command_pool_ptr->lock();
+    acquire_recording_locks();
     {
         entrypoints.vkCmdDebugMarkerEndEXT(m_command_buffer);
     }
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     result = true;
 end:
@@ -2320,12 +3126,12 @@ bool Anvil::CommandBufferBase::record_debug_marker_insert_EXT(const std::string&
     marker_info.pNext       = nullptr;
     marker_info.sType       = VK_STRUCTURE_TYPE_DEBUG_MARKER_MARKER_INFO_EXT;
 
-    m_parent_command_pool_ptr->lock();
+    acquire_recording_locks();
     {
         entrypoints.vkCmdDebugMarkerInsertEXT(m_command_buffer,
                                              &marker_info);
     }
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     result = true;
 end:
@@ -2374,8 +3180,7 @@ bool Anvil::CommandBufferBase::record_dispatch_base_KHR(uint32_t in_base_group_x
     }
     #endif
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    acquire_recording_locks();
     {
         entrypoints.vkCmdDispatchBaseKHR(m_command_buffer,
                                          in_base_group_x,
@@ -2385,8 +3190,7 @@ bool Anvil::CommandBufferBase::record_dispatch_base_KHR(uint32_t in_base_group_x
                                          in_group_count_y,
                                          in_group_count_z);
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     result = true;
 end:
@@ -2423,15 +3227,13 @@ bool Anvil::CommandBufferBase::record_dispatch_indirect(Anvil::Buffer* in_buffer
     }
     #endif
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    acquire_recording_locks();
     {
         Anvil::Vulkan::vkCmdDispatchIndirect(m_command_buffer,
                                              in_buffer_ptr->get_buffer(),
                                              in_offset);
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     result = true;
 end:
@@ -2472,8 +3274,7 @@ bool Anvil::CommandBufferBase::record_draw(uint32_t in_vertex_count,
     }
     #endif
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    acquire_recording_locks();
     {
         Anvil::Vulkan::vkCmdDraw(m_command_buffer,
                                  in_vertex_count,
@@ -2481,8 +3282,7 @@ bool Anvil::CommandBufferBase::record_draw(uint32_t in_vertex_count,
                                  in_first_vertex,
                                  in_first_instance);
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     result = true;
 end:
@@ -2525,8 +3325,7 @@ bool Anvil::CommandBufferBase::record_draw_indexed(uint32_t in_index_count,
     }
     #endif
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    acquire_recording_locks();
     {
         Anvil::Vulkan::vkCmdDrawIndexed(m_command_buffer,
                                         in_index_count,
@@ -2535,8 +3334,7 @@ bool Anvil::CommandBufferBase::record_draw_indexed(uint32_t in_index_count,
                                         in_vertex_offset,
                                         in_first_instance);
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     result = true;
 end:
@@ -2577,8 +3375,7 @@ bool Anvil::CommandBufferBase::record_draw_indexed_indirect(Anvil::Buffer* in_bu
     }
     #endif
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    acquire_recording_locks();
     {
         Anvil::Vulkan::vkCmdDrawIndexedIndirect(m_command_buffer,
                                                 in_buffer_ptr->get_buffer(),
@@ -2586,8 +3383,7 @@ bool Anvil::CommandBufferBase::record_draw_indexed_indirect(Anvil::Buffer* in_bu
                                                 in_count,
                                                 in_stride);
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     result = true;
 end:
@@ -2633,8 +3429,7 @@ bool Anvil::CommandBufferBase::record_draw_indirect_byte_count_EXT(const uint32_
     }
     #endif
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    acquire_recording_locks();
     {
         entrypoints.vkCmdDrawIndirectByteCountEXT(m_command_buffer,
                                                   in_instance_count,
@@ -2644,8 +3439,7 @@ bool Anvil::CommandBufferBase::record_draw_indirect_byte_count_EXT(const uint32_
                                                   in_counter_offset,
                                                   in_vertex_stride);
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     result = true;
 end:
@@ -2696,8 +3490,7 @@ bool Anvil::CommandBufferBase::record_draw_indexed_indirect_count_AMD(Anvil::Buf
 
     entrypoints = m_device_ptr->get_extension_amd_draw_indirect_count_entrypoints();
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    acquire_recording_locks();
     {
         entrypoints.vkCmdDrawIndexedIndirectCountAMD(m_command_buffer,
                                                      in_buffer_ptr->get_buffer(),
@@ -2707,8 +3500,7 @@ bool Anvil::CommandBufferBase::record_draw_indexed_indirect_count_AMD(Anvil::Buf
                                                      in_max_draw_count,
                                                      in_stride);
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     result = true;
 end:
@@ -2759,8 +3551,7 @@ bool Anvil::CommandBufferBase::record_draw_indexed_indirect_count_KHR(Anvil::Buf
 
     entrypoints = m_device_ptr->get_extension_khr_draw_indirect_count_entrypoints();
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    acquire_recording_locks();
     {
         entrypoints.vkCmdDrawIndexedIndirectCountKHR(m_command_buffer,
                                                      in_buffer_ptr->get_buffer(),
@@ -2770,8 +3561,7 @@ bool Anvil::CommandBufferBase::record_draw_indexed_indirect_count_KHR(Anvil::Buf
                                                      in_max_draw_count,
                                                      in_stride);
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     result = true;
 end:
@@ -2812,8 +3602,7 @@ bool Anvil::CommandBufferBase::record_draw_indirect(Anvil::Buffer* in_buffer_ptr
     }
     #endif
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    acquire_recording_locks();
     {
         Anvil::Vulkan::vkCmdDrawIndirect(m_command_buffer,
                                          in_buffer_ptr->get_buffer(),
@@ -2821,8 +3610,7 @@ bool Anvil::CommandBufferBase::record_draw_indirect(Anvil::Buffer* in_buffer_ptr
                                          in_count,
                                          in_stride);
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     result = true;
 end:
@@ -2873,8 +3661,7 @@ bool Anvil::CommandBufferBase::record_draw_indirect_count_AMD(Anvil::Buffer* in_
 
     entrypoints = m_device_ptr->get_extension_amd_draw_indirect_count_entrypoints();
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    acquire_recording_locks();
     {
         entrypoints.vkCmdDrawIndirectCountAMD(m_command_buffer,
                                               in_buffer_ptr->get_buffer(),
@@ -2884,8 +3671,7 @@ bool Anvil::CommandBufferBase::record_draw_indirect_count_AMD(Anvil::Buffer* in_
                                               in_max_draw_count,
                                               in_stride);
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     result = true;
 end:
@@ -2936,8 +3722,7 @@ bool Anvil::CommandBufferBase::record_draw_indirect_count_KHR(Anvil::Buffer* in_
 
     entrypoints = m_device_ptr->get_extension_khr_draw_indirect_count_entrypoints();
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    acquire_recording_locks();
     {
         entrypoints.vkCmdDrawIndirectCountKHR(m_command_buffer,
                                               in_buffer_ptr->get_buffer(),
@@ -2947,8 +3732,7 @@ bool Anvil::CommandBufferBase::record_draw_indirect_count_KHR(Anvil::Buffer* in_
                                               in_max_draw_count,
                                               in_stride);
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     result = true;
 end:
@@ -2979,15 +3763,13 @@ bool Anvil::CommandBufferBase::record_end_query(Anvil::QueryPool* in_query_pool_
     }
     #endif
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    acquire_recording_locks();
     {
         Anvil::Vulkan::vkCmdEndQuery(m_command_buffer,
                                      in_query_pool_ptr->get_query_pool(),
                                      in_entry);
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     result = true;
 end:
@@ -3021,16 +3803,14 @@ bool Anvil::CommandBufferBase::record_end_query_indexed_EXT(Anvil::QueryPool*
     }
     #endif
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    acquire_recording_locks();
     {
         entrypoints.vkCmdEndQueryIndexedEXT(m_command_buffer,
                                             in_query_pool_ptr->get_query_pool(),
                                             in_query,
                                             in_index);
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     result = true;
 end:
@@ -3043,9 +3823,9 @@ bool Anvil::CommandBufferBase::record_end_transform_feedback_EXT(const uint32_t&
                                                                  Anvil::Buffer**     in_opt_counter_buffer_ptrs,
                                                                  const VkDeviceSize* in_opt_counter_buffer_offsets)
 {
-    auto        counter_buffer_ptrs = std::vector<VkBuffer>(in_n_counter_buffers);
-    const auto& entrypoints         = m_device_ptr->get_extension_ext_transform_feedback_entrypoints();
-    bool        result              = false;
+    VkBuffer*   counter_buffers_vk_ptr = nullptr;
+    const auto& entrypoints            = m_device_ptr->get_extension_ext_transform_feedback_entrypoints();
+    bool        result                 = false;
 
     if (!m_is_renderpass_active)
     {
@@ -3061,13 +3841,6 @@ bool Anvil::CommandBufferBase::record_end_transform_feedback_EXT(const uint32_t&
         goto end;
     }
 
-    for (uint32_t n_counter_buffer = 0;
-                  n_counter_buffer < in_n_counter_buffers;
-                ++n_counter_buffer)
-    {
-        counter_buffer_ptrs.at(n_counter_buffer) = in_opt_counter_buffer_ptrs[n_counter_buffer]->get_buffer();
-    }
-
     #ifdef STORE_COMMAND_BUFFER_COMMANDS
     {
         if (!m_command_stashing_disabled)
@@ -3090,17 +3863,25 @@ bool Anvil::CommandBufferBase::record_end_transform_feedback_EXT(const uint32_t&
     }
     #endif
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    acquire_recording_locks();
     {
+        counter_buffers_vk_ptr = get_scratch_storage(in_n_counter_buffers,
+                                                    m_scratch_buffers_vk);
+
+        for (uint32_t n_counter_buffer = 0;
+                      n_counter_buffer < in_n_counter_buffers;
+                    ++n_counter_buffer)
+        {
+            counter_buffers_vk_ptr[n_counter_buffer] = in_opt_counter_buffer_ptrs[n_counter_buffer]->get_buffer();
+        }
+
         entrypoints.vkCmdEndTransformFeedbackEXT(m_command_buffer,
                                                  in_first_counter_buffer,
                                                  in_n_counter_buffers,
-                                                 (in_n_counter_buffers > 0) ? &counter_buffer_ptrs.at(0) : nullptr,
+                                                 counter_buffers_vk_ptr,
                                                  in_opt_counter_buffer_offsets);
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     result = true;
 end:
@@ -3141,8 +3922,7 @@ bool Anvil::CommandBufferBase::record_fill_buffer(Anvil::Buffer* in_dst_buffer_p
     }
     #endif
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    acquire_recording_locks();
     {
         Anvil::Vulkan::vkCmdFillBuffer(m_command_buffer,
                                        in_dst_buffer_ptr->get_buffer(),
@@ -3150,8 +3930,7 @@ bool Anvil::CommandBufferBase::record_fill_buffer(Anvil::Buffer* in_dst_buffer_p
                                        in_size,
                                        in_data);
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     result = true;
 end:
@@ -3170,10 +3949,10 @@ bool Anvil::CommandBufferBase::record_pipeline_barrier(Anvil::PipelineStageFlags
                                                        const ImageBarrier*  const in_image_memory_barriers_ptr)
 {
     /* NOTE: The command can be executed both inside and outside a renderpass */
-    auto buffer_barriers_vk = std::vector<VkBufferMemoryBarrier>(in_buffer_memory_barrier_count);
-    auto image_barriers_vk  = std::vector<VkImageMemoryBarrier> (in_image_memory_barrier_count);
-    auto memory_barriers_vk = std::vector<VkMemoryBarrier>      (in_memory_barrier_count);
-    bool result             = false;
+    VkBufferMemoryBarrier* buffer_barriers_vk_ptr = nullptr;
+    VkImageMemoryBarrier*  image_barriers_vk_ptr  = nullptr;
+    VkMemoryBarrier*       memory_barriers_vk_ptr = nullptr;
+    bool                   result                 = false;
 
     if (!m_recording_in_progress)
     {
@@ -3220,43 +3999,73 @@ bool Anvil::CommandBufferBase::record_pipeline_barrier(Anvil::PipelineStageFlags
                 &callback_data);
     }
 
-    for (uint32_t n_buffer_barrier = 0;
-                  n_buffer_barrier < in_buffer_memory_barrier_count;
-                ++n_buffer_barrier)
+    if (m_deferred_barrier_state_ptr != nullptr)
     {
-        buffer_barriers_vk.at(n_buffer_barrier) = in_buffer_memory_barriers_ptr[n_buffer_barrier].get_barrier_vk();
-    }
+        if (m_deferred_barrier_state_ptr->conflicts_with(in_dependency_flags.get_vk(),
+                                                         in_buffer_memory_barrier_count,
+                                                         in_buffer_memory_barriers_ptr,
+                                                         in_image_memory_barrier_count,
+                                                         in_image_memory_barriers_ptr) )
+        {
+            flush_deferred_barriers();
+        }
 
-    for (uint32_t n_image_barrier = 0;
-                  n_image_barrier < in_image_memory_barrier_count;
-                ++n_image_barrier)
-    {
-        image_barriers_vk.at(n_image_barrier) = in_image_memory_barriers_ptr[n_image_barrier].get_barrier_vk();
+        m_deferred_barrier_state_ptr->append(in_src_stage_mask.get_vk  (),
+                                             in_dst_stage_mask.get_vk  (),
+                                             in_dependency_flags.get_vk(),
+                                             in_memory_barrier_count,
+                                             in_memory_barriers_ptr,
+                                             in_buffer_memory_barrier_count,
+                                             in_buffer_memory_barriers_ptr,
+                                             in_image_memory_barrier_count,
+                                             in_image_memory_barriers_ptr);
+
+        result = true;
+        goto end;
     }
 
-    for (uint32_t n_memory_barrier = 0;
-                  n_memory_barrier < in_memory_barrier_count;
-                ++n_memory_barrier)
+    acquire_recording_locks();
     {
-        memory_barriers_vk.at(n_memory_barrier) = in_memory_barriers_ptr[n_memory_barrier].get_barrier_vk();
-    }
+        buffer_barriers_vk_ptr = get_scratch_storage(in_buffer_memory_barrier_count,
+                                                     m_scratch_buffer_barriers_vk);
+        image_barriers_vk_ptr  = get_scratch_storage(in_image_memory_barrier_count,
+                                                     m_scratch_image_barriers_vk);
+        memory_barriers_vk_ptr = get_scratch_storage(in_memory_barrier_count,
+                                                     m_scratch_memory_barriers_vk);
+
+        for (uint32_t n_buffer_barrier = 0;
+                      n_buffer_barrier < in_buffer_memory_barrier_count;
+                    ++n_buffer_barrier)
+        {
+            buffer_barriers_vk_ptr[n_buffer_barrier] = in_buffer_memory_barriers_ptr[n_buffer_barrier].get_barrier_vk();
+        }
+
+        for (uint32_t n_image_barrier = 0;
+                      n_image_barrier < in_image_memory_barrier_count;
+                    ++n_image_barrier)
+        {
+            image_barriers_vk_ptr[n_image_barrier] = in_image_memory_barriers_ptr[n_image_barrier].get_barrier_vk();
+        }
+
+        for (uint32_t n_memory_barrier = 0;
+                      n_memory_barrier < in_memory_barrier_count;
+                    ++n_memory_barrier)
+        {
+            memory_barriers_vk_ptr[n_memory_barrier] = in_memory_barriers_ptr[n_memory_barrier].get_barrier_vk();
+        }
 
-    m_parent_command_pool_ptr->lock();
-    lock();
-    {
         Anvil::Vulkan::vkCmdPipelineBarrier(m_command_buffer,
                                             in_src_stage_mask.get_vk  (),
                                             in_dst_stage_mask.get_vk  (),
                                             in_dependency_flags.get_vk(),
                                             in_memory_barrier_count,
-                                            (in_memory_barrier_count > 0) ? &memory_barriers_vk.at(0) : nullptr,
+                                            memory_barriers_vk_ptr,
                                             in_buffer_memory_barrier_count,
-                                            (in_buffer_memory_barrier_count > 0) ? &buffer_barriers_vk.at(0) : nullptr,
+                                            buffer_barriers_vk_ptr,
                                             in_image_memory_barrier_count,
-                                            (in_image_memory_barrier_count > 0) ? &image_barriers_vk.at(0) : nullptr);
+                                            image_barriers_vk_ptr);
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     result = true;
 end:
@@ -3280,6 +4089,18 @@ bool Anvil::CommandBufferBase::record_push_constants(Anvil::PipelineLayout*  in_
         goto end;
     }
 
+    if (m_shadow_state_ptr != nullptr                                                &&
+        m_shadow_state_ptr->filter_push_constants(in_layout_ptr->get_pipeline_layout(),
+                                                  in_stage_flags.get_vk(),
+                                                  in_offset,
+                                                  in_size,
+                                                  in_values) )
+    {
+        result = true;
+
+        goto end;
+    }
+
     #ifdef STORE_COMMAND_BUFFER_COMMANDS
     {
         if (!m_command_stashing_disabled)
@@ -3293,8 +4114,7 @@ bool Anvil::CommandBufferBase::record_push_constants(Anvil::PipelineLayout*  in_
     }
     #endif
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    acquire_recording_locks();
     {
         Anvil::Vulkan::vkCmdPushConstants(m_command_buffer,
                                           in_layout_ptr->get_pipeline_layout(),
@@ -3303,8 +4123,7 @@ bool Anvil::CommandBufferBase::record_push_constants(Anvil::PipelineLayout*  in_
                                           in_size,
                                           in_values);
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     result = true;
 end:
@@ -3341,15 +4160,13 @@ bool Anvil::CommandBufferBase::record_reset_event(Anvil::Event*             in_e
     }
     #endif
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    acquire_recording_locks();
     {
         Anvil::Vulkan::vkCmdResetEvent(m_command_buffer,
                                        in_event_ptr->get_event(),
                                        in_stage_mask.get_vk() );
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     result = true;
 end:
@@ -3388,16 +4205,14 @@ bool Anvil::CommandBufferBase::record_reset_query_pool(Anvil::QueryPool* in_quer
     }
     #endif
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    acquire_recording_locks();
     {
         Anvil::Vulkan::vkCmdResetQueryPool(m_command_buffer,
                                            in_query_pool_ptr->get_query_pool(),
                                            in_start_query,
                                            in_query_count);
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     result = true;
 end:
@@ -3442,8 +4257,7 @@ bool Anvil::CommandBufferBase::record_resolve_image(Anvil::Image*              i
     }
     #endif
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    acquire_recording_locks();
     {
         Anvil::Vulkan::vkCmdResolveImage(m_command_buffer,
                                          in_src_image_ptr->get_image(),
@@ -3453,8 +4267,7 @@ bool Anvil::CommandBufferBase::record_resolve_image(Anvil::Image*              i
                                          in_region_count,
                                          reinterpret_cast<const VkImageResolve*>(in_region_ptrs) );
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     result = true;
 end:
@@ -3484,14 +4297,12 @@ bool Anvil::CommandBufferBase::record_set_blend_constants(const float in_blend_c
     }
     #endif
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    acquire_recording_locks();
     {
         Anvil::Vulkan::vkCmdSetBlendConstants(m_command_buffer,
                                               in_blend_constants);
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     result = true;
 end:
@@ -3524,16 +4335,14 @@ bool Anvil::CommandBufferBase::record_set_depth_bias(float in_depth_bias_constan
     }
     #endif
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    acquire_recording_locks();
     {
         Anvil::Vulkan::vkCmdSetDepthBias(m_command_buffer,
                                          in_depth_bias_constant_factor,
                                          in_depth_bias_clamp,
                                          in_slope_scaled_depth_bias);
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     result = true;
 end:
@@ -3564,15 +4373,13 @@ bool Anvil::CommandBufferBase::record_set_depth_bounds(float in_min_depth_bounds
     }
     #endif
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    acquire_recording_locks();
     {
         Anvil::Vulkan::vkCmdSetDepthBounds(m_command_buffer,
                                            in_min_depth_bounds,
                                            in_max_depth_bounds);
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     result = true;
 end:
@@ -3624,14 +4431,12 @@ bool Anvil::CommandBufferBase::record_set_device_mask_KHR(uint32_t in_device_mas
         }
     }
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    acquire_recording_locks();
     {
         entrypoints.vkCmdSetDeviceMaskKHR(m_command_buffer,
                                           in_device_mask);
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     m_device_mask = in_device_mask;
     result        = true;
@@ -3679,15 +4484,13 @@ bool Anvil::CommandBufferBase::record_set_event(Anvil::Event*             in_eve
     }
     #endif
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    acquire_recording_locks();
     {
         Anvil::Vulkan::vkCmdSetEvent(m_command_buffer,
                                      in_event_ptr->get_event(),
                                      in_stage_mask.get_vk() );
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     result = true;
 end:
@@ -3707,6 +4510,14 @@ bool Anvil::CommandBufferBase::record_set_line_width(float in_line_width)
         goto end;
     }
 
+    if (m_shadow_state_ptr != nullptr                          &&
+        m_shadow_state_ptr->filter_set_line_width(in_line_width) )
+    {
+        result = true;
+
+        goto end;
+    }
+
     #ifdef STORE_COMMAND_BUFFER_COMMANDS
     {
         if (!m_command_stashing_disabled)
@@ -3716,14 +4527,12 @@ bool Anvil::CommandBufferBase::record_set_line_width(float in_line_width)
     }
     #endif
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    acquire_recording_locks();
     {
         Anvil::Vulkan::vkCmdSetLineWidth(m_command_buffer,
                                          in_line_width);
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     result = true;
 end:
@@ -3756,14 +4565,12 @@ bool Anvil::CommandBufferBase::record_set_sample_locations_EXT(const Anvil::Samp
 
     sample_locations_info_vk = in_sample_locations_info.get_vk();
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    acquire_recording_locks();
     {
         sl_entrypoints.vkCmdSetSampleLocationsEXT(m_command_buffer,
                                                  &sample_locations_info_vk);
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     result = true;
 end:
@@ -3785,6 +4592,16 @@ bool Anvil::CommandBufferBase::record_set_scissor(uint32_t        in_first_sciss
         goto end;
     }
 
+    if (m_shadow_state_ptr != nullptr                         &&
+        m_shadow_state_ptr->filter_set_scissor(in_first_scissor,
+                                               in_scissor_count,
+                                               in_scissor_ptrs) )
+    {
+        result = true;
+
+        goto end;
+    }
+
     #ifdef STORE_COMMAND_BUFFER_COMMANDS
     {
         if (!m_command_stashing_disabled)
@@ -3796,16 +4613,14 @@ bool Anvil::CommandBufferBase::record_set_scissor(uint32_t        in_first_sciss
     }
     #endif
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    acquire_recording_locks();
     {
         Anvil::Vulkan::vkCmdSetScissor(m_command_buffer,
                                        in_first_scissor,
                                        in_scissor_count,
                                        in_scissor_ptrs);
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     result = true;
 end:
@@ -3836,15 +4651,13 @@ bool Anvil::CommandBufferBase::record_set_stencil_compare_mask(Anvil::StencilFac
     }
     #endif
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    acquire_recording_locks();
     {
         Anvil::Vulkan::vkCmdSetStencilCompareMask(m_command_buffer,
                                                   in_face_mask.get_vk(),
                                                   in_stencil_compare_mask);
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     result = true;
 end:
@@ -3875,15 +4688,13 @@ bool Anvil::CommandBufferBase::record_set_stencil_reference(Anvil::StencilFaceFl
     }
     #endif
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    acquire_recording_locks();
     {
         Anvil::Vulkan::vkCmdSetStencilReference(m_command_buffer,
                                                 in_face_mask.get_vk(),
                                                 in_stencil_reference);
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     result = true;
 end:
@@ -3914,15 +4725,13 @@ bool Anvil::CommandBufferBase::record_set_stencil_write_mask(Anvil::StencilFaceF
     }
     #endif
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    acquire_recording_locks();
     {
         Anvil::Vulkan::vkCmdSetStencilWriteMask(m_command_buffer,
                                                 in_face_mask.get_vk(),
                                                 in_stencil_write_mask);
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     result = true;
 end:
@@ -3944,6 +4753,16 @@ bool Anvil::CommandBufferBase::record_set_viewport(uint32_t          in_first_vi
         goto end;
     }
 
+    if (m_shadow_state_ptr != nullptr                           &&
+        m_shadow_state_ptr->filter_set_viewport(in_first_viewport,
+                                                in_viewport_count,
+                                                in_viewport_ptrs) )
+    {
+        result = true;
+
+        goto end;
+    }
+
     #ifdef STORE_COMMAND_BUFFER_COMMANDS
     {
         if (!m_command_stashing_disabled)
@@ -3955,16 +4774,14 @@ bool Anvil::CommandBufferBase::record_set_viewport(uint32_t          in_first_vi
     }
     #endif
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    acquire_recording_locks();
     {
         Anvil::Vulkan::vkCmdSetViewport(m_command_buffer,
                                         in_first_viewport,
                                         in_viewport_count,
                                         in_viewport_ptrs);
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     result = true;
 end:
@@ -4006,8 +4823,7 @@ bool Anvil::CommandBufferBase::record_update_buffer(Anvil::Buffer* in_dst_buffer
     #endif
 
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    acquire_recording_locks();
     {
         Anvil::Vulkan::vkCmdUpdateBuffer(m_command_buffer,
                                          in_dst_buffer_ptr->get_buffer(),
@@ -4015,8 +4831,7 @@ bool Anvil::CommandBufferBase::record_update_buffer(Anvil::Buffer* in_dst_buffer
                                          in_data_size,
                                          in_data_ptr);
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     result = true;
 end:
@@ -4037,11 +4852,11 @@ bool Anvil::CommandBufferBase::record_wait_events(uint32_t                   in_
 
 {
     /* NOTE: The command can be executed both inside and outside a renderpass */
-    std::vector<VkEvent>               events            (in_event_count);
-    std::vector<VkBufferMemoryBarrier> buffer_barriers_vk(in_buffer_memory_barrier_count);
-    std::vector<VkImageMemoryBarrier>  image_barriers_vk (in_image_memory_barrier_count);
-    std::vector<VkMemoryBarrier>       memory_barriers_vk(in_memory_barrier_count);
-    bool                               result            (false);
+    VkBufferMemoryBarrier* buffer_barriers_vk_ptr(nullptr);
+    VkEvent*               events_vk_ptr         (nullptr);
+    VkImageMemoryBarrier*  image_barriers_vk_ptr (nullptr);
+    VkMemoryBarrier*       memory_barriers_vk_ptr(nullptr);
+    bool                   result                (false);
 
     anvil_assert(in_event_count > 0); /* as per spec - easy to miss */
 
@@ -4070,52 +4885,59 @@ bool Anvil::CommandBufferBase::record_wait_events(uint32_t                   in_
     }
     #endif
 
-
-    for (uint32_t n_event = 0;
-                  n_event < in_event_count;
-                ++n_event)
+    acquire_recording_locks();
     {
-        events.at(n_event) = in_events[n_event]->get_event();
-    }
+        events_vk_ptr = get_scratch_storage(in_event_count,
+                                            m_scratch_events_vk);
 
-    for (uint32_t n_buffer_barrier = 0;
-                  n_buffer_barrier < in_buffer_memory_barrier_count;
-                ++n_buffer_barrier)
-    {
-        buffer_barriers_vk.at(n_buffer_barrier) = in_buffer_memory_barriers_ptr[n_buffer_barrier].get_barrier_vk();
-    }
+        for (uint32_t n_event = 0;
+                      n_event < in_event_count;
+                    ++n_event)
+        {
+            events_vk_ptr[n_event] = in_events[n_event]->get_event();
+        }
 
-    for (uint32_t n_image_barrier = 0;
-                  n_image_barrier < in_image_memory_barrier_count;
-                ++n_image_barrier)
-    {
-        image_barriers_vk.at(n_image_barrier) = in_image_memory_barriers_ptr[n_image_barrier].get_barrier_vk();
-    }
+        buffer_barriers_vk_ptr = get_scratch_storage(in_buffer_memory_barrier_count,
+                                                     m_scratch_buffer_barriers_vk);
+        image_barriers_vk_ptr  = get_scratch_storage(in_image_memory_barrier_count,
+                                                     m_scratch_image_barriers_vk);
+        memory_barriers_vk_ptr = get_scratch_storage(in_memory_barrier_count,
+                                                     m_scratch_memory_barriers_vk);
 
-    for (uint32_t n_memory_barrier = 0;
-                  n_memory_barrier < in_memory_barrier_count;
-                ++n_memory_barrier)
-    {
-        memory_barriers_vk.at(n_memory_barrier) = in_memory_barriers_ptr[n_memory_barrier].get_barrier_vk();
-    }
+        for (uint32_t n_buffer_barrier = 0;
+                      n_buffer_barrier < in_buffer_memory_barrier_count;
+                    ++n_buffer_barrier)
+        {
+            buffer_barriers_vk_ptr[n_buffer_barrier] = in_buffer_memory_barriers_ptr[n_buffer_barrier].get_barrier_vk();
+        }
+
+        for (uint32_t n_image_barrier = 0;
+                      n_image_barrier < in_image_memory_barrier_count;
+                    ++n_image_barrier)
+        {
+            image_barriers_vk_ptr[n_image_barrier] = in_image_memory_barriers_ptr[n_image_barrier].get_barrier_vk();
+        }
+
+        for (uint32_t n_memory_barrier = 0;
+                      n_memory_barrier < in_memory_barrier_count;
+                    ++n_memory_barrier)
+        {
+            memory_barriers_vk_ptr[n_memory_barrier] = in_memory_barriers_ptr[n_memory_barrier].get_barrier_vk();
+        }
 
-    m_parent_command_pool_ptr->lock();
-    lock();
-    {
         Anvil::Vulkan::vkCmdWaitEvents(m_command_buffer,
                                        in_event_count,
-                                       (in_event_count > 0) ? &events.at(0) : nullptr,
+                                       events_vk_ptr,
                                        in_src_stage_mask.get_vk(),
                                        in_dst_stage_mask.get_vk(),
                                        in_memory_barrier_count,
-                                       (in_memory_barrier_count > 0) ? &memory_barriers_vk.at(0) : nullptr,
+                                       memory_barriers_vk_ptr,
                                        in_buffer_memory_barrier_count,
-                                       (in_buffer_memory_barrier_count > 0) ? &buffer_barriers_vk.at(0) : nullptr,
+                                       buffer_barriers_vk_ptr,
                                        in_image_memory_barrier_count,
-                                       (in_image_memory_barrier_count > 0) ? &image_barriers_vk.at(0) : nullptr);
+                                       image_barriers_vk_ptr);
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     result = true;
 end:
@@ -4151,8 +4973,7 @@ bool Anvil::CommandBufferBase::record_write_buffer_marker_AMD(const Anvil::Pipel
     }
     #endif
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    acquire_recording_locks();
     {
         entrypoints.vkCmdWriteBufferMarkerAMD(m_command_buffer,
                                               static_cast<VkPipelineStageFlagBits>(in_pipeline_stage),
@@ -4160,8 +4981,7 @@ bool Anvil::CommandBufferBase::record_write_buffer_marker_AMD(const Anvil::Pipel
                                               in_dst_offset,
                                               in_marker);
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     result = true;
 end:
@@ -4194,22 +5014,41 @@ bool Anvil::CommandBufferBase::record_write_timestamp(Anvil::PipelineStageFlagBi
     }
     #endif
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    acquire_recording_locks();
     {
         Anvil::Vulkan::vkCmdWriteTimestamp(m_command_buffer,
                                            static_cast<VkPipelineStageFlagBits>(in_pipeline_stage),
                                            in_query_pool_ptr->get_query_pool(),
                                            in_query_index);
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     result = true;
 end:
     return result;
 }
 
+/** Releases the locks taken by acquire_recording_locks(). */
+void Anvil::CommandBufferBase::release_recording_locks()
+{
+    if (m_exclusive_recording_active)
+    {
+        return;
+    }
+
+    unlock();
+    m_parent_command_pool_ptr->unlock();
+}
+
+/* Please see header for specification */
+void Anvil::CommandBufferBase::reset_barrier_batching_stats()
+{
+    if (m_deferred_barrier_state_ptr != nullptr)
+    {
+        m_deferred_barrier_state_ptr->stats = Anvil::BarrierBatchingStats();
+    }
+}
+
 /* Please see header for specification */
 bool Anvil::CommandBufferBase::reset(bool in_should_release_resources)
 {
@@ -4223,14 +5062,12 @@ bool Anvil::CommandBufferBase::reset(bool in_should_release_resources)
         goto end;
     }
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    acquire_recording_locks();
     {
         result_vk = Anvil::Vulkan::vkResetCommandBuffer(m_command_buffer,
                                                         (in_should_release_resources) ? VK_COMMAND_BUFFER_RESET_RELEASE_RESOURCES_BIT : 0u);
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     if (!is_vk_call_successful(result_vk) )
     {
@@ -4245,11 +5082,55 @@ bool Anvil::CommandBufferBase::reset(bool in_should_release_resources)
     }
     #endif
 
+    invalidate_shadow_state();
+
     result = true;
 end:
     return result;
 }
 
+/* Please see header for specification */
+void Anvil::CommandBufferBase::set_barrier_batching(bool in_enable)
+{
+    if (in_enable)
+    {
+        if (m_deferred_barrier_state_ptr == nullptr)
+        {
+            m_deferred_barrier_state_ptr.reset(new DeferredBarrierState() );
+        }
+    }
+    else
+    {
+        flush_deferred_barriers();
+
+        m_deferred_barrier_state_ptr.reset();
+    }
+}
+
+/* Please see header for specification */
+void Anvil::CommandBufferBase::set_exclusive_recording(bool in_enable)
+{
+    anvil_assert(!m_recording_in_progress);
+
+    m_exclusive_recording_enabled = in_enable;
+}
+
+/* Please see header for specification */
+void Anvil::CommandBufferBase::set_redundant_state_filtering(bool in_enable)
+{
+    if (in_enable)
+    {
+        if (m_shadow_state_ptr == nullptr)
+        {
+            m_shadow_state_ptr.reset(new ShadowState() );
+        }
+    }
+    else
+    {
+        m_shadow_state_ptr.reset();
+    }
+}
+
 /* Please see header for specification */
 bool Anvil::CommandBufferBase::stop_recording()
 {
@@ -4263,13 +5144,15 @@ bool Anvil::CommandBufferBase::stop_recording()
         goto end;
     }
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    acquire_recording_locks();
     {
         result_vk = Anvil::Vulkan::vkEndCommandBuffer(m_command_buffer);
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
+
+    /* End exclusive recording even if the call failed, so that the parent pool does not remain owned by this
+     * thread for good. */
+    end_exclusive_recording();
 
     if (!is_vk_call_successful(result_vk))
     {
@@ -4287,7 +5170,8 @@ end:
 /* Please see header for specification */
 Anvil::PrimaryCommandBuffer::PrimaryCommandBuffer(const Anvil::BaseDevice* in_device_ptr,
                                                   Anvil::CommandPool*      in_parent_command_pool_ptr,
-                                                  bool                     in_mt_safe)
+                                                  bool                     in_mt_safe,
+                                                  VkCommandBuffer          in_opt_command_buffer)
     :CommandBufferBase(in_device_ptr,
                        in_parent_command_pool_ptr,
                        COMMAND_BUFFER_TYPE_PRIMARY,
@@ -4298,6 +5182,14 @@ Anvil::PrimaryCommandBuffer::PrimaryCommandBuffer(const Anvil::BaseDevice* in_de
 
     ANVIL_REDUNDANT_VARIABLE(result_vk);
 
+    if (in_opt_command_buffer != VK_NULL_HANDLE)
+    {
+        /* Command buffer has been pre-allocated by the parent command pool */
+        m_command_buffer = in_opt_command_buffer;
+
+        return;
+    }
+
     alloc_info.commandBufferCount = 1;
     alloc_info.commandPool        = in_parent_command_pool_ptr->get_command_pool();
     alloc_info.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
@@ -4479,8 +5371,7 @@ bool Anvil::PrimaryCommandBuffer::record_begin_render_pass(uint32_t
         render_pass_begin_info_chain.append_struct(sl_begin_info);
     }
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    acquire_recording_locks();
     {
         auto chain_ptr = render_pass_begin_info_chain.create_chain();
 
@@ -4488,8 +5379,9 @@ bool Anvil::PrimaryCommandBuffer::record_begin_render_pass(uint32_t
                                             chain_ptr->get_root_struct(),
                                             static_cast<VkSubpassContents>(in_contents) );
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
+
+    invalidate_shadow_state();
 
     m_is_renderpass_active = true;
     result                 = true;
@@ -4525,13 +5417,13 @@ bool Anvil::PrimaryCommandBuffer::record_end_render_pass()
     }
     #endif
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    acquire_recording_locks();
     {
         Anvil::Vulkan::vkCmdEndRenderPass(m_command_buffer);
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
+
+    invalidate_shadow_state();
 
     m_is_renderpass_active = false;
     result                 = true;
@@ -4544,8 +5436,8 @@ bool Anvil::PrimaryCommandBuffer::record_execute_commands(uint32_t
                                                           Anvil::SecondaryCommandBuffer** in_cmd_buffer_ptrs)
 {
     /* NOTE: The command can be executed both inside and outside a renderpass */
-    auto cmd_buffers = std::vector<VkCommandBuffer>(in_cmd_buffers_count);
-    bool result      = false;
+    VkCommandBuffer* cmd_buffers_vk_ptr = nullptr;
+    bool             result             = false;
 
     if (!m_recording_in_progress)
     {
@@ -4564,22 +5456,26 @@ bool Anvil::PrimaryCommandBuffer::record_execute_commands(uint32_t
     }
     #endif
 
-    for (uint32_t n_cmd_buffer = 0;
-                  n_cmd_buffer < in_cmd_buffers_count;
-                ++n_cmd_buffer)
+    acquire_recording_locks();
     {
-        cmd_buffers.at(n_cmd_buffer) = in_cmd_buffer_ptrs[n_cmd_buffer]->get_command_buffer();
-    }
+        cmd_buffers_vk_ptr = get_scratch_storage(in_cmd_buffers_count,
+                                                 m_scratch_command_buffers_vk);
+
+        for (uint32_t n_cmd_buffer = 0;
+                      n_cmd_buffer < in_cmd_buffers_count;
+                    ++n_cmd_buffer)
+        {
+            cmd_buffers_vk_ptr[n_cmd_buffer] = in_cmd_buffer_ptrs[n_cmd_buffer]->get_command_buffer();
+        }
 
-    m_parent_command_pool_ptr->lock();
-    lock();
-    {
         Anvil::Vulkan::vkCmdExecuteCommands(m_command_buffer,
                                             in_cmd_buffers_count,
-                                            (in_cmd_buffers_count > 0) ? &cmd_buffers.at(0) : nullptr);
+                                            cmd_buffers_vk_ptr);
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
+
+    /* Executed secondary command buffers leave the bound state undefined. */
+    invalidate_shadow_state();
 
     result = true;
 end:
@@ -4614,14 +5510,12 @@ bool Anvil::PrimaryCommandBuffer::record_next_subpass(Anvil::SubpassContents in_
     }
     #endif
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    acquire_recording_locks();
     {
         Anvil::Vulkan::vkCmdNextSubpass(m_command_buffer,
                                         static_cast<VkSubpassContents>(in_contents) );
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     result = true;
 end:
@@ -4680,21 +5574,23 @@ bool Anvil::PrimaryCommandBuffer::start_recording(bool
         anvil_assert(device_type == Anvil::DeviceType::SINGLE_GPU);
     }
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    begin_exclusive_recording();
+
+    acquire_recording_locks();
     {
         auto chain_ptr = struct_chainer.create_chain();
 
         result_vk = Anvil::Vulkan::vkBeginCommandBuffer(m_command_buffer,
                                                         chain_ptr->get_root_struct() );
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     if (!is_vk_call_successful(result_vk) )
     {
         anvil_assert_vk_call_succeeded(result_vk);
 
+        end_exclusive_recording();
+
         goto end;
     }
 
@@ -4705,6 +5601,10 @@ bool Anvil::PrimaryCommandBuffer::start_recording(bool
     }
     #endif
 
+    /* Any state bound in a previous recording session is gone at this point. */
+    invalidate_shadow_state     (true /* in_reset_stats */);
+    reset_barrier_batching_stats();
+
     m_device_mask           = in_opt_device_mask;
     m_recording_in_progress = true;
     result                  = true;
@@ -4717,7 +5617,8 @@ end:
 /* Please see header for specification */
 Anvil::SecondaryCommandBuffer::SecondaryCommandBuffer(const Anvil::BaseDevice* in_device_ptr,
                                                       Anvil::CommandPool*      in_parent_command_pool_ptr,
-                                                      bool                     in_mt_safe)
+                                                      bool                     in_mt_safe,
+                                                      VkCommandBuffer          in_opt_command_buffer)
     :CommandBufferBase(in_device_ptr,
                        in_parent_command_pool_ptr,
                        COMMAND_BUFFER_TYPE_SECONDARY,
@@ -4728,6 +5629,14 @@ Anvil::SecondaryCommandBuffer::SecondaryCommandBuffer(const Anvil::BaseDevice* i
 
     ANVIL_REDUNDANT_VARIABLE(result_vk);
 
+    if (in_opt_command_buffer != VK_NULL_HANDLE)
+    {
+        /* Command buffer has been pre-allocated by the parent command pool */
+        m_command_buffer = in_opt_command_buffer;
+
+        return;
+    }
+
     command_buffer_alloc_info.commandBufferCount = 1;
     command_buffer_alloc_info.commandPool        = in_parent_command_pool_ptr->get_command_pool();
     command_buffer_alloc_info.level              = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
@@ -4816,21 +5725,23 @@ bool Anvil::SecondaryCommandBuffer::start_recording(bool
         m_device_mask = 0;
     }
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    begin_exclusive_recording();
+
+    acquire_recording_locks();
     {
         auto chain_ptr = struct_chainer.create_chain();
 
         result_vk = Anvil::Vulkan::vkBeginCommandBuffer(m_command_buffer,
                                                         chain_ptr->get_root_struct() );
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
+    release_recording_locks();
 
     if (!is_vk_call_successful(result_vk) )
     {
         anvil_assert_vk_call_succeeded(result_vk);
 
+        end_exclusive_recording();
+
         goto end;
     }
 
@@ -4841,6 +5752,10 @@ bool Anvil::SecondaryCommandBuffer::start_recording(bool
     }
     #endif
 
+    /* Any state bound in a previous recording session is gone at this point. */
+    invalidate_shadow_state     (true /* in_reset_stats */);
+    reset_barrier_batching_stats();
+
     m_is_renderpass_active  = in_renderpass_usage_only;
     m_recording_in_progress = true;
     result                  = true;
@@ -34,7 +34,8 @@ Anvil::CommandPool::CommandPool(Anvil::BaseDevice* in_device_ptr,
                                 bool               in_transient_allocations_friendly,
                                 bool               in_support_per_cmdbuf_reset_ops,
                                 uint32_t           in_queue_family_index,
-                                bool               in_mt_safe)
+                                bool               in_mt_safe,
+                                uint32_t           in_recycling_chunk_size)
 
     :DebugMarkerSupportProvider         (in_device_ptr,
                                          Anvil::ObjectType::COMMAND_POOL),
@@ -43,7 +44,9 @@ Anvil::CommandPool::CommandPool(Anvil::BaseDevice* in_device_ptr,
      m_device_ptr                       (in_device_ptr),
      m_is_transient_allocations_friendly(in_transient_allocations_friendly),
      m_queue_family_index               (in_queue_family_index),
-     m_supports_per_cmdbuf_reset_ops    (in_support_per_cmdbuf_reset_ops)
+     m_supports_per_cmdbuf_reset_ops    (in_support_per_cmdbuf_reset_ops),
+     m_recycling_chunk_size             (in_recycling_chunk_size),
+     m_n_exclusive_recordings           (0)
 {
     VkCommandPoolCreateInfo command_pool_create_info;
     VkResult                result_vk               (VK_ERROR_INITIALIZATION_FAILED);
@@ -85,6 +88,43 @@ Anvil::CommandPool::~CommandPool()
     {
         lock();
         {
+            /* Recycled wrappers must not free their command buffers one by one. All command buffers
+             * allocated from the pool are released by the vkDestroyCommandPool() call below. */
+            for (auto current_command_buffer_ptr : m_free_primary_command_buffer_ptrs)
+            {
+                current_command_buffer_ptr->m_command_buffer = VK_NULL_HANDLE;
+
+                delete current_command_buffer_ptr;
+            }
+
+            for (auto current_command_buffer_ptr : m_pending_primary_command_buffer_ptrs)
+            {
+                current_command_buffer_ptr->m_command_buffer = VK_NULL_HANDLE;
+
+                delete current_command_buffer_ptr;
+            }
+
+            for (auto current_command_buffer_ptr : m_free_secondary_command_buffer_ptrs)
+            {
+                current_command_buffer_ptr->m_command_buffer = VK_NULL_HANDLE;
+
+                delete current_command_buffer_ptr;
+            }
+
+            for (auto current_command_buffer_ptr : m_pending_secondary_command_buffer_ptrs)
+            {
+                current_command_buffer_ptr->m_command_buffer = VK_NULL_HANDLE;
+
+                delete current_command_buffer_ptr;
+            }
+
+            m_free_primary_command_buffer_ptrs.clear     ();
+            m_free_primary_command_buffers_vk.clear      ();
+            m_free_secondary_command_buffer_ptrs.clear   ();
+            m_free_secondary_command_buffers_vk.clear    ();
+            m_pending_primary_command_buffer_ptrs.clear  ();
+            m_pending_secondary_command_buffer_ptrs.clear();
+
             Anvil::Vulkan::vkDestroyCommandPool(m_device_ptr->get_device_vk(),
                                                 m_command_pool,
                                                 nullptr /* pAllocator */);
@@ -101,12 +141,50 @@ Anvil::PrimaryCommandBufferUniquePtr Anvil::CommandPool::alloc_primary_level_com
     Anvil::PrimaryCommandBufferUniquePtr new_buffer_ptr(nullptr,
                                                         std::default_delete<PrimaryCommandBuffer>() );
 
+    assert_no_foreign_exclusive_recording();
+
+    if (m_recycling_chunk_size != 0)
+    {
+        Anvil::PrimaryCommandBuffer* command_buffer_ptr = nullptr;
+
+        lock();
+        {
+            if (!m_free_primary_command_buffer_ptrs.empty() )
+            {
+                command_buffer_ptr = m_free_primary_command_buffer_ptrs.back();
+
+                m_free_primary_command_buffer_ptrs.pop_back();
+            }
+            else
+            {
+                VkCommandBuffer command_buffer_vk = get_free_command_buffer_vk(VK_COMMAND_BUFFER_LEVEL_PRIMARY);
+
+                if (command_buffer_vk != VK_NULL_HANDLE)
+                {
+                    command_buffer_ptr = new PrimaryCommandBuffer(m_device_ptr,
+                                                                  this,
+                                                                  is_mt_safe(),
+                                                                  command_buffer_vk);
+                }
+            }
+        }
+        unlock();
+
+        new_buffer_ptr = Anvil::PrimaryCommandBufferUniquePtr(command_buffer_ptr,
+                                                              std::bind(&CommandPool::on_primary_command_buffer_released,
+                                                                        this,
+                                                                        std::placeholders::_1) );
+
+        goto end;
+    }
+
     new_buffer_ptr.reset(
         new PrimaryCommandBuffer(m_device_ptr,
                                  this,
                                  is_mt_safe() )
     );
 
+end:
     return new_buffer_ptr;
 }
 
@@ -116,21 +194,76 @@ Anvil::SecondaryCommandBufferUniquePtr Anvil::CommandPool::alloc_secondary_level
     Anvil::SecondaryCommandBufferUniquePtr new_buffer_ptr(nullptr,
                                                           std::default_delete<Anvil::SecondaryCommandBuffer>() );
 
+    assert_no_foreign_exclusive_recording();
+
+    if (m_recycling_chunk_size != 0)
+    {
+        Anvil::SecondaryCommandBuffer* command_buffer_ptr = nullptr;
+
+        lock();
+        {
+            if (!m_free_secondary_command_buffer_ptrs.empty() )
+            {
+                command_buffer_ptr = m_free_secondary_command_buffer_ptrs.back();
+
+                m_free_secondary_command_buffer_ptrs.pop_back();
+            }
+            else
+            {
+                VkCommandBuffer command_buffer_vk = get_free_command_buffer_vk(VK_COMMAND_BUFFER_LEVEL_SECONDARY);
+
+                if (command_buffer_vk != VK_NULL_HANDLE)
+                {
+                    command_buffer_ptr = new SecondaryCommandBuffer(m_device_ptr,
+                                                                    this,
+                                                                    is_mt_safe(),
+                                                                    command_buffer_vk);
+                }
+            }
+        }
+        unlock();
+
+        new_buffer_ptr = Anvil::SecondaryCommandBufferUniquePtr(command_buffer_ptr,
+                                                                std::bind(&CommandPool::on_secondary_command_buffer_released,
+                                                                          this,
+                                                                          std::placeholders::_1) );
+
+        goto end;
+    }
+
     new_buffer_ptr.reset(
         new SecondaryCommandBuffer(m_device_ptr,
                                    this,
                                    is_mt_safe() )
     );
 
+end:
     return new_buffer_ptr;
 }
 
+/** Debug builds only: asserts if a command buffer allocated from this pool is being recorded exclusively
+ *  by a thread other than the calling one.
+ **/
+void Anvil::CommandPool::assert_no_foreign_exclusive_recording() const
+{
+    #ifdef _DEBUG
+    {
+        /* The pool is not locked during exclusive recording, so the check can't block on the recording thread */
+        const std::thread::id owner_thread_id = m_exclusive_recording_thread_id.load();
+
+        anvil_assert(owner_thread_id == std::thread::id()         ||
+                     owner_thread_id == std::this_thread::get_id() );
+    }
+    #endif
+}
+
 /* Please see header for specification */
 Anvil::CommandPoolUniquePtr Anvil::CommandPool::create(Anvil::BaseDevice* in_device_ptr,
                                                        bool               in_transient_allocations_friendly,
                                                        bool               in_support_per_cmdbuf_reset_ops,
                                                        uint32_t           in_queue_family_index,
-                                                       MTSafety           in_mt_safety)
+                                                       MTSafety           in_mt_safety,
+                                                       uint32_t           in_opt_recycling_chunk_size)
 {
     const bool                  is_mt_safe = Anvil::Utils::convert_mt_safety_enum_to_boolean(in_mt_safety,
                                                                                              in_device_ptr);
@@ -142,23 +275,200 @@ Anvil::CommandPoolUniquePtr Anvil::CommandPool::create(Anvil::BaseDevice* in_dev
                                in_transient_allocations_friendly,
                                in_support_per_cmdbuf_reset_ops,
                                in_queue_family_index,
-                               is_mt_safe)
+                               is_mt_safe,
+                               in_opt_recycling_chunk_size)
     );
 
     return result_ptr;
 }
 
+/** Returns a Vulkan command buffer handle of the requested level, which has not been assigned to any
+ *  wrapper yet. If none is available, a new chunk of command buffers is allocated.
+ *
+ *  Must be called with the pool locked.
+ *
+ *  @param in_level Level of the command buffer to return.
+ *
+ *  @return Command buffer handle or VK_NULL_HANDLE if the allocation failed.
+ **/
+VkCommandBuffer Anvil::CommandPool::get_free_command_buffer_vk(VkCommandBufferLevel in_level)
+{
+    auto&           free_command_buffers_vk = (in_level == VK_COMMAND_BUFFER_LEVEL_PRIMARY) ? m_free_primary_command_buffers_vk
+                                                                                            : m_free_secondary_command_buffers_vk;
+    VkCommandBuffer result                  = VK_NULL_HANDLE;
+
+    anvil_assert(m_recycling_chunk_size != 0);
+
+    if (free_command_buffers_vk.empty() )
+    {
+        VkCommandBufferAllocateInfo alloc_info;
+        VkResult                    result_vk;
+
+        alloc_info.commandBufferCount = m_recycling_chunk_size;
+        alloc_info.commandPool        = m_command_pool;
+        alloc_info.level              = in_level;
+        alloc_info.pNext              = nullptr;
+        alloc_info.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+
+        free_command_buffers_vk.resize(m_recycling_chunk_size);
+
+        result_vk = Anvil::Vulkan::vkAllocateCommandBuffers(m_device_ptr->get_device_vk(),
+                                                           &alloc_info,
+                                                           &free_command_buffers_vk.at(0) );
+
+        if (!is_vk_call_successful(result_vk) )
+        {
+            anvil_assert_vk_call_succeeded(result_vk);
+
+            free_command_buffers_vk.clear();
+
+            goto end;
+        }
+    }
+
+    result = free_command_buffers_vk.back();
+
+    free_command_buffers_vk.pop_back();
+
+end:
+    return result;
+}
+
+/** Called by command buffers when exclusive recording finishes. Must be called from the thread which started it. */
+void Anvil::CommandPool::on_exclusive_recording_finished()
+{
+    anvil_assert(m_n_exclusive_recordings               >  0);
+    anvil_assert(m_exclusive_recording_thread_id.load() == std::this_thread::get_id() );
+
+    if (--m_n_exclusive_recordings == 0)
+    {
+        m_exclusive_recording_thread_id.store(std::thread::id() );
+    }
+}
+
+/** Called by command buffers when exclusive recording starts. A thread can record multiple command buffers
+ *  allocated from the pool exclusively at the same time.
+ **/
+void Anvil::CommandPool::on_exclusive_recording_started()
+{
+    const std::thread::id current_thread_id = std::this_thread::get_id();
+    std::thread::id       owner_thread_id;
+
+    if (!m_exclusive_recording_thread_id.compare_exchange_strong(owner_thread_id,
+                                                                 current_thread_id) )
+    {
+        /* Command buffers allocated from the same pool must not be recorded by different threads at the same time */
+        anvil_assert(owner_thread_id == current_thread_id);
+    }
+
+    ++m_n_exclusive_recordings;
+}
+
+/** Called back whenever the app releases a primary-level command buffer, allocated from a pool
+ *  which has command buffer recycling enabled.
+ *
+ *  @param in_command_buffer_ptr Command buffer wrapper to recycle.
+ **/
+void Anvil::CommandPool::on_primary_command_buffer_released(Anvil::PrimaryCommandBuffer* in_command_buffer_ptr)
+{
+    if (in_command_buffer_ptr == nullptr)
+    {
+        goto end;
+    }
+
+    if (in_command_buffer_ptr->m_recording_in_progress)
+    {
+        /* Command buffers left in the recording state cannot be reused. Let the wrapper free its command buffer. */
+        anvil_assert(!in_command_buffer_ptr->m_recording_in_progress);
+
+        delete in_command_buffer_ptr;
+
+        goto end;
+    }
+
+    lock();
+    {
+        if (m_supports_per_cmdbuf_reset_ops)
+        {
+            m_free_primary_command_buffer_ptrs.push_back(in_command_buffer_ptr);
+        }
+        else
+        {
+            m_pending_primary_command_buffer_ptrs.push_back(in_command_buffer_ptr);
+        }
+    }
+    unlock();
+
+end:
+    ;
+}
+
+/** Called back whenever the app releases a secondary-level command buffer, allocated from a pool
+ *  which has command buffer recycling enabled.
+ *
+ *  @param in_command_buffer_ptr Command buffer wrapper to recycle.
+ **/
+void Anvil::CommandPool::on_secondary_command_buffer_released(Anvil::SecondaryCommandBuffer* in_command_buffer_ptr)
+{
+    if (in_command_buffer_ptr == nullptr)
+    {
+        goto end;
+    }
+
+    if (in_command_buffer_ptr->m_recording_in_progress)
+    {
+        /* Command buffers left in the recording state cannot be reused. Let the wrapper free its command buffer. */
+        anvil_assert(!in_command_buffer_ptr->m_recording_in_progress);
+
+        delete in_command_buffer_ptr;
+
+        goto end;
+    }
+
+    lock();
+    {
+        if (m_supports_per_cmdbuf_reset_ops)
+        {
+            m_free_secondary_command_buffer_ptrs.push_back(in_command_buffer_ptr);
+        }
+        else
+        {
+            m_pending_secondary_command_buffer_ptrs.push_back(in_command_buffer_ptr);
+        }
+    }
+    unlock();
+
+end:
+    ;
+}
+
 /* Please see header for specification */
 bool Anvil::CommandPool::reset(bool in_release_resources)
 {
     std::unique_lock<std::mutex> mutex_lock;
     VkResult                     result_vk;
 
+    assert_no_foreign_exclusive_recording();
+
     lock();
     {
         result_vk = Anvil::Vulkan::vkResetCommandPool(m_device_ptr->get_device_vk(),
                                                       m_command_pool,
                                                       ((in_release_resources) ? VK_COMMAND_POOL_RESET_RELEASE_RESOURCES_BIT : 0u) );
+
+        if (is_vk_call_successful(result_vk) )
+        {
+            /* All command buffers released since the last reset are now in the initial state and can be reused */
+            m_free_primary_command_buffer_ptrs.insert  (m_free_primary_command_buffer_ptrs.end(),
+                                                        m_pending_primary_command_buffer_ptrs.begin(),
+                                                        m_pending_primary_command_buffer_ptrs.end() );
+            m_free_secondary_command_buffer_ptrs.insert(m_free_secondary_command_buffer_ptrs.end(),
+                                                        m_pending_secondary_command_buffer_ptrs.begin(),
+                                                        m_pending_secondary_command_buffer_ptrs.end() );
+
+            m_pending_primary_command_buffer_ptrs.clear  ();
+            m_pending_secondary_command_buffer_ptrs.clear();
+        }
     }
     unlock();
 
@@ -170,6 +480,8 @@ bool Anvil::CommandPool::reset(bool in_release_resources)
 /* Please see header for specification */
 void Anvil::CommandPool::trim()
 {
+    assert_no_foreign_exclusive_recording();
+
     if (m_device_ptr->get_extension_info()->khr_maintenance1() )
     {
         lock();
@@ -21,8 +21,10 @@
 //
 
 #include "misc/debug.h"
+#include "misc/fence_pool.h"
 #include "misc/object_tracker.h"
 #include "misc/shader_module_cache.h"
+#include "misc/staging_ring.h"
 #include "misc/struct_chainer.h"
 #include "misc/swapchain_create_info.h"
 #include "wrappers/command_pool.h"
@@ -45,6 +47,9 @@
 #undef max
 #endif
 
+/* Size of the staging ring used for transfers to and from non-mappable buffers */
+static const VkDeviceSize g_staging_ring_size = 8 * 1024 * 1024;
+
 /* Please see header for specification */
 Anvil::BaseDevice::BaseDevice(const Anvil::Instance* in_parent_instance_ptr,
                               bool                   in_mt_safe)
@@ -67,6 +72,9 @@ Anvil::BaseDevice::~BaseDevice()
     Anvil::ObjectTracker::get()->unregister_object(Anvil::ObjectType::DEVICE,
                                                     this);
 
+    /* The staging ring waits for its own batches, which hold command buffers and fences owned by the device */
+    m_staging_ring_ptr.reset();
+
     if (m_device != VK_NULL_HANDLE)
     {
         wait_idle();
@@ -80,6 +88,7 @@ Anvil::BaseDevice::~BaseDevice()
     m_pipeline_cache_ptr.reset               ();
     m_pipeline_layout_manager_ptr.reset      ();
     m_owned_queues.clear                     ();
+    m_fence_pool_ptr.reset                   ();
 
     if (m_device != VK_NULL_HANDLE)
     {
@@ -609,12 +618,30 @@ Anvil::Queue* Anvil::BaseDevice::get_sparse_binding_queue(uint32_t          in_n
     return result_ptr;
 }
 
+/** Please see header for specification */
+Anvil::StagingRing* Anvil::BaseDevice::get_staging_ring() const
+{
+    std::unique_lock<std::mutex> mutex_lock(m_staging_ring_mutex);
+
+    if (m_staging_ring_ptr == nullptr)
+    {
+        m_staging_ring_ptr = Anvil::StagingRing::create(this,
+                                                        g_staging_ring_size,
+                                                        is_mt_safe() );
+
+        anvil_assert(m_staging_ring_ptr != nullptr);
+    }
+
+    return m_staging_ring_ptr.get();
+}
+
 /* Initializes a new Device instance */
 void Anvil::BaseDevice::init(const DeviceExtensionConfiguration& in_extensions,
                              const std::vector<std::string>&     in_layers,
                              bool                                in_transient_command_buffer_allocs_only,
                              bool                                in_support_resettable_command_buffer_allocs,
-                             bool                                in_enable_shader_module_cache)
+                             bool                                in_enable_shader_module_cache,
+                             uint32_t                            in_command_buffer_recycling_chunk_size)
 {
     std::map<std::string, bool> extensions_final_enabled_status;
     VkPhysicalDeviceFeatures    features_to_enable;
@@ -1068,7 +1095,8 @@ void Anvil::BaseDevice::init(const DeviceExtensionConfiguration& in_extensions,
                                                in_transient_command_buffer_allocs_only,
                                                in_support_resettable_command_buffer_allocs,
                                                current_queue_fam_queue.family_index,
-                                               mt_safety);
+                                               mt_safety,
+                                               (in_support_resettable_command_buffer_allocs) ? in_command_buffer_recycling_chunk_size : 0);
             }
         }
     }
@@ -1104,6 +1132,10 @@ void Anvil::BaseDevice::init(const DeviceExtensionConfiguration& in_extensions,
         m_shader_module_cache_ptr = Anvil::ShaderModuleCache::create();
     }
 
+    /* Set up the fence pool, used for blocking submissions */
+    m_fence_pool_ptr = Anvil::FencePool::create(this,
+                                                is_mt_safe() );
+
     /* Set up the pipeline cache */
     m_pipeline_cache_ptr = Anvil::PipelineCache::create(this,
                                                         is_mt_safe() );
@@ -1264,7 +1296,8 @@ Anvil::BaseDeviceUniquePtr Anvil::MGPUDevice::create(std::vector<const Anvil::Ph
                                                      const std::vector<std::string>&           in_layers,
                                                      bool                                      in_transient_command_buffer_allocs_only,
                                                      bool                                      in_support_resettable_command_buffer_allocs,
-                                                     bool                                      in_mt_safe)
+                                                     bool                                      in_mt_safe,
+                                                     uint32_t                                  in_opt_command_buffer_recycling_chunk_size)
 {
     Anvil::BaseDeviceUniquePtr result_ptr;
 
@@ -1286,7 +1319,8 @@ Anvil::BaseDeviceUniquePtr Anvil::MGPUDevice::create(std::vector<const Anvil::Ph
                                                               in_layers,
                                                               in_transient_command_buffer_allocs_only,
                                                               in_support_resettable_command_buffer_allocs,
-                                                              in_enable_shader_module_cache);
+                                                              in_enable_shader_module_cache,
+                                                              in_opt_command_buffer_recycling_chunk_size);
 
     return result_ptr;
 }
@@ -1910,7 +1944,8 @@ Anvil::BaseDeviceUniquePtr Anvil::SGPUDevice::create(const Anvil::PhysicalDevice
                                                      const std::vector<std::string>&      in_layers,
                                                      bool                                 in_transient_command_buffer_allocs_only,
                                                      bool                                 in_support_resettable_command_buffer_allocs,
-                                                     bool                                 in_mt_safe)
+                                                     bool                                 in_mt_safe,
+                                                     uint32_t                             in_opt_command_buffer_recycling_chunk_size)
 {
     BaseDeviceUniquePtr result_ptr(nullptr,
                                    std::default_delete<Anvil::BaseDevice>() );
@@ -1924,7 +1959,8 @@ Anvil::BaseDeviceUniquePtr Anvil::SGPUDevice::create(const Anvil::PhysicalDevice
                                                               in_layers,
                                                               in_transient_command_buffer_allocs_only,
                                                               in_support_resettable_command_buffer_allocs,
-                                                              in_enable_shader_module_cache);
+                                                              in_enable_shader_module_cache,
+                                                              in_opt_command_buffer_recycling_chunk_size);
 
     return result_ptr;
 }
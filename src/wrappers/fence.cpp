@@ -457,3 +457,20 @@ bool Anvil::Fence::reset_fences(const uint32_t in_n_fences,
 end:
     return result;
 }
+
+/* Please see header for specification */
+bool Anvil::Fence::wait(uint64_t in_timeout) const
+{
+    VkResult result;
+
+    result = Anvil::Vulkan::vkWaitForFences(m_device_ptr->get_device_vk(),
+                                            1, /* fenceCount */
+                                           &m_fence,
+                                            VK_TRUE, /* waitAll */
+                                            in_timeout);
+
+    anvil_assert(result == VK_SUCCESS ||
+                 result == VK_TIMEOUT);
+
+    return (result == VK_SUCCESS);
+}
@@ -1232,6 +1232,29 @@ end:
     return result;
 }
 
+/** Please see header for specification */
+uint32_t Anvil::Image::get_n_resident_tiles(Anvil::ImageAspectFlagBits in_aspect,
+                                            uint32_t                   in_n_layer,
+                                            uint32_t                   in_n_mip,
+                                            uint32_t*                  out_opt_n_total_tiles_ptr) const
+{
+    /* Sanity checks */
+    anvil_assert((m_create_info_ptr->get_create_flags() & Anvil::ImageCreateFlagBits::SPARSE_RESIDENCY_BIT) != 0);
+
+    anvil_assert(m_create_info_ptr->get_n_layers() > in_n_layer);
+    anvil_assert(m_sparse_aspect_page_occupancy.find(in_aspect) != m_sparse_aspect_page_occupancy.end() );
+    anvil_assert(m_sparse_aspect_props.at(in_aspect).mip_tail_first_lod > in_n_mip);
+
+    const auto& mip_data = m_sparse_aspect_page_occupancy.at(in_aspect)->layers.at(in_n_layer).mips.at(in_n_mip);
+
+    if (out_opt_n_total_tiles_ptr != nullptr)
+    {
+        *out_opt_n_total_tiles_ptr = mip_data.n_total_tiles;
+    }
+
+    return mip_data.n_tiles_with_memory_backing;
+}
+
 /** Please see header for specification */
 bool Anvil::Image::get_SFR_tile_size(VkExtent2D* out_result_ptr) const
 {
@@ -1549,12 +1572,81 @@ bool Anvil::Image::is_memory_bound_for_texel(Anvil::ImageAspectFlagBits in_aspec
         const auto&    mip_data   = layer_data.mips.at(in_n_mip);
         const uint32_t tile_index = mip_data.get_texture_space_xyz_to_block_mapping_index(in_x, in_y, in_z);
 
-        result = (mip_data.tile_to_block_mappings.at(tile_index) != nullptr);
+        result = mip_data.are_tiles_bound(tile_index,
+                                          1); /* in_n_tiles */
     }
 
     return result;
 }
 
+/* Please see header for specification */
+bool Anvil::Image::is_memory_bound_for_region(Anvil::ImageAspectFlagBits in_aspect,
+                                              uint32_t                   in_n_layer,
+                                              uint32_t                   in_n_mip,
+                                              VkOffset3D                 in_offset,
+                                              VkExtent3D                 in_extent) const
+{
+    /* Sanity checks */
+    anvil_assert((m_create_info_ptr->get_create_flags() & Anvil::ImageCreateFlagBits::SPARSE_RESIDENCY_BIT) != 0);
+
+    anvil_assert(m_create_info_ptr->get_n_layers () > in_n_layer);
+    anvil_assert(m_n_mipmaps                        > in_n_mip);
+
+    anvil_assert(in_extent.width  > 0 &&
+                 in_extent.height > 0 &&
+                 in_extent.depth  > 0);
+
+    anvil_assert(m_sparse_aspect_page_occupancy.find(in_aspect) != m_sparse_aspect_page_occupancy.end() );
+
+    const auto& aspect_data = m_sparse_aspect_props.at(in_aspect);
+    const auto& layer_data  = m_sparse_aspect_page_occupancy.at(in_aspect)->layers.at(in_n_layer);
+
+    if (in_n_mip >= aspect_data.mip_tail_first_lod)
+    {
+        /* Tails are tracked at layer granularity. See is_memory_bound_for_texel() */
+        return true;
+    }
+
+    {
+        const auto&    mip_data   = layer_data.mips.at(in_n_mip);
+        const uint32_t first_tile[] =
+        {
+            static_cast<uint32_t>(in_offset.x) / mip_data.tile_width,
+            static_cast<uint32_t>(in_offset.y) / mip_data.tile_height,
+            static_cast<uint32_t>(in_offset.z) / mip_data.tile_depth
+        };
+        const uint32_t last_tile[] =
+        {
+            (static_cast<uint32_t>(in_offset.x) + in_extent.width  - 1) / mip_data.tile_width,
+            (static_cast<uint32_t>(in_offset.y) + in_extent.height - 1) / mip_data.tile_height,
+            (static_cast<uint32_t>(in_offset.z) + in_extent.depth  - 1) / mip_data.tile_depth
+        };
+
+        /* Each row of tiles is a contiguous bit range, so check whole rows at a time. */
+        for (uint32_t current_z_tile = first_tile[2];
+                      current_z_tile <= last_tile[2];
+                    ++current_z_tile)
+        {
+            for (uint32_t current_y_tile = first_tile[1];
+                          current_y_tile <= last_tile[1];
+                        ++current_y_tile)
+            {
+                const uint32_t row_start_tile_index = mip_data.get_tile_space_xyz_to_block_mapping_index(first_tile[0],
+                                                                                                         current_y_tile,
+                                                                                                         current_z_tile);
+
+                if (!mip_data.are_tiles_bound(row_start_tile_index,
+                                              last_tile[0] - first_tile[0] + 1) )
+                {
+                    return false;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
 /** Updates page tracker (for non-resident images) OR tile-to-block mappings & tail page counteres,
  *  as per the specified opaque image memory update properties.
  *
@@ -1693,14 +1785,9 @@ void Anvil::Image::on_memory_backing_opaque_update(VkDeviceSize        in_resour
                     {
                         for (auto& current_mip : current_layer.mips)
                         {
-                            const uint32_t n_mip_tiles = static_cast<uint32_t>(current_mip.tile_to_block_mappings.size() );
-
-                            for (uint32_t n_mip_tile = 0;
-                                          n_mip_tile < n_mip_tiles;
-                                        ++n_mip_tile)
-                            {
-                                current_mip.tile_to_block_mappings.at(n_mip_tile) = in_memory_block_ptr;
-                            }
+                            current_mip.set_tiles_bound(0, /* in_n_first_tile */
+                                                        current_mip.n_total_tiles,
+                                                        !is_unbinding);
                         }
                     }
                 }
@@ -1784,28 +1871,23 @@ void Anvil::Image::on_memory_backing_update(const Anvil::ImageSubresource& in_su
         in_offset.z / aspect_props_iterator->second.granularity.depth
     };
 
-    /* We're going to favor readability over performance in the loops below. */
-    for (uint32_t current_x_tile = offset_tile[0];
-                  current_x_tile < offset_tile[0] + extent_tile[0];
-                ++current_x_tile)
+    /* Tiles are linearized in X-Y-Z order, so each row of tiles covered by the update maps to a contiguous
+     * bit range, which can be updated a word at a time. */
+    for (uint32_t current_z_tile = offset_tile[2];
+                  current_z_tile < offset_tile[2] + extent_tile[2];
+                ++current_z_tile)
     {
         for (uint32_t current_y_tile = offset_tile[1];
                       current_y_tile < offset_tile[1] + extent_tile[1];
                     ++current_y_tile)
         {
-            for (uint32_t current_z_tile = offset_tile[2];
-                          current_z_tile < offset_tile[2] + extent_tile[2];
-                        ++current_z_tile)
-            {
-                const uint32_t tile_index = aspect_layer_mip_ptr->get_tile_space_xyz_to_block_mapping_index(current_x_tile,
-                                                                                                            current_y_tile,
-                                                                                                            current_z_tile);
-
-                anvil_assert(aspect_layer_mip_ptr->tile_to_block_mappings.size() > tile_index);
+            const uint32_t row_start_tile_index = aspect_layer_mip_ptr->get_tile_space_xyz_to_block_mapping_index(offset_tile[0],
+                                                                                                                  current_y_tile,
+                                                                                                                  current_z_tile);
 
-                /* Assign the memory block (potentially null) to the tile */
-                aspect_layer_mip_ptr->tile_to_block_mappings.at(tile_index) = in_memory_block_ptr;
-            }
+            aspect_layer_mip_ptr->set_tiles_bound(row_start_tile_index,
+                                                  extent_tile[0],
+                                                  (in_memory_block_ptr != nullptr) );
         }
     }
 
@@ -2467,7 +2549,7 @@ void Anvil::Image::upload_mipmaps(const std::vector<MipmapRawData>* in_mipmaps_p
     std::map<Anvil::ImageAspectFlagBits, std::vector<const Anvil::MipmapRawData*> > image_aspect_to_mipmap_raw_data_map;
     Anvil::ImageAspectFlags                                                         image_aspects_touched;
     Anvil::ImageSubresourceRange                                                    image_subresource_range;
-    const VkDeviceSize                                                              sparse_page_size                   ( (m_page_tracker_ptr != nullptr) ? m_page_tracker_ptr->get_page_size() : 0);
+    std::vector<Anvil::PageTracker::MemoryBlockBinding>                             sparse_row_bindings;
     Anvil::Queue*                                                                   universal_queue_ptr                (m_device_ptr->get_universal_queue(0) );
 
     /* Make sure image has been assigned at least one memory block before we go ahead with the upload process */
@@ -2591,32 +2673,24 @@ void Anvil::Image::upload_mipmaps(const std::vector<MipmapRawData>* in_mipmaps_p
                         if ((m_create_info_ptr->get_create_flags() & Anvil::ImageCreateFlagBits::SPARSE_BINDING_BIT)   != 0 &&
                             (m_create_info_ptr->get_create_flags() & Anvil::ImageCreateFlagBits::SPARSE_RESIDENCY_BIT) == 0)
                         {
-                            const VkDeviceSize dst_slice_offset_page_aligned = Anvil::Utils::round_down(dst_slice_offset,
-                                                                                                        sparse_page_size);
-                            VkDeviceSize       memory_region_start_offset    = UINT32_MAX;
+                            /* The row may straddle pages bound to different memory blocks, in which case each part
+                             * needs to be written separately. */
+                            const unsigned char* src_row_ptr = src_slice_ptr + current_row_size * n_row;
 
-                            anvil_assert(sparse_page_size                                     != 0);
-                            anvil_assert(( dst_slice_offset_page_aligned % sparse_page_size)  == 0);
+                            m_page_tracker_ptr->get_memory_blocks(dst_slice_offset,
+                                                                  current_row_size,
+                                                                 &sparse_row_bindings);
 
-                            mem_block_ptr = m_page_tracker_ptr->get_memory_block(dst_slice_offset_page_aligned,
-                                                                                 sparse_page_size,
-                                                                                &memory_region_start_offset);
-                            anvil_assert(mem_block_ptr != nullptr);
+                            anvil_assert(sparse_row_bindings.size() != 0);
 
-                            if (dst_slice_offset + image_subresource_layout.row_pitch > dst_slice_offset_page_aligned + sparse_page_size)
+                            for (const auto& current_binding : sparse_row_bindings)
                             {
-                                VkDeviceSize dummy;
-                                auto         mem_block2_ptr = m_page_tracker_ptr->get_memory_block(dst_slice_offset_page_aligned + sparse_page_size,
-                                                                                                   sparse_page_size,
-                                                                                                  &dummy);
-
-                                ANVIL_REDUNDANT_VARIABLE(mem_block2_ptr);
-
-                                // todo: the slice spans across >1 memory blocks. need more than just one write op to handle this case correctly.
-                                anvil_assert(mem_block2_ptr == mem_block_ptr);
+                                current_binding.memory_block_ptr->write(current_binding.memory_block_start_offset,
+                                                                        current_binding.size,
+                                                                        src_row_ptr + (current_binding.start_offset - dst_slice_offset) );
                             }
 
-                            write_dst_slice_offset = memory_region_start_offset + (dst_slice_offset - dst_slice_offset_page_aligned);
+                            continue;
                         }
                         else
                         {
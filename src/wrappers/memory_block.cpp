@@ -29,6 +29,7 @@
 #include "wrappers/image.h"
 #include "wrappers/memory_block.h"
 #include "wrappers/physical_device.h"
+#include <algorithm>
 
 /* Please see header for specification */
 Anvil::MemoryBlock::MemoryBlock(Anvil::MemoryBlockCreateInfoUniquePtr in_create_info_ptr)
@@ -37,6 +38,7 @@ Anvil::MemoryBlock::MemoryBlock(Anvil::MemoryBlockCreateInfoUniquePtr in_create_
      m_backend_object                     (nullptr),
      m_gpu_data_map_count                 (0),
      m_gpu_data_ptr                       (nullptr),
+     m_is_persistently_mapped             (false),
      m_memory                             (VK_NULL_HANDLE),
      m_parent_memory_allocator_backend_ptr(nullptr)
 {
@@ -61,6 +63,11 @@ Anvil::MemoryBlock::~MemoryBlock()
 {
     auto on_release_callback_function = m_create_info_ptr->get_on_release_callback_function();
 
+    if (m_is_persistently_mapped)
+    {
+        set_persistent_mapping(false);
+    }
+
     #ifdef _DEBUG
     {
         auto parent_memory_block_ptr = m_create_info_ptr->get_parent_memory_block();
@@ -83,7 +90,8 @@ Anvil::MemoryBlock::~MemoryBlock()
 
     if (m_memory != VK_NULL_HANDLE)
     {
-        if (on_release_callback_function == nullptr)
+        /* Memory of blocks instantiated with a custom delete proc belongs to whoever has provided it */
+        if (m_create_info_ptr->get_type() != Anvil::MemoryBlockType::DERIVED_WITH_CUSTOM_DELETE_PROC)
         {
             lock();
             {
@@ -304,6 +312,71 @@ end:
     return result_returned_ptr;
 }
 
+/* Please see header for specification */
+bool Anvil::MemoryBlock::flush_dirty_ranges()
+{
+    bool result = false;
+
+    if (m_create_info_ptr->get_parent_memory_block() != nullptr)
+    {
+        result = m_create_info_ptr->get_parent_memory_block()->flush_dirty_ranges();
+    }
+    else
+    {
+        lock();
+        {
+            result = flush_dirty_ranges_internal();
+        }
+        unlock();
+    }
+
+    return result;
+}
+
+/** Flushes all dirty ranges of a root memory block with a single vkFlushMappedMemoryRanges() call.
+ *
+ *  The caller must hold the block's lock.
+ *
+ *  @return true if successful, false otherwise.
+ **/
+bool Anvil::MemoryBlock::flush_dirty_ranges_internal()
+{
+    bool result = true;
+
+    anvil_assert(m_create_info_ptr->get_parent_memory_block() == nullptr);
+
+    if (!m_dirty_ranges.empty() )
+    {
+        VkResult result_vk;
+
+        m_scratch_mapped_memory_ranges.clear();
+
+        for (const auto& current_range : m_dirty_ranges)
+        {
+            VkMappedMemoryRange mapped_memory_range;
+
+            mapped_memory_range.memory = m_memory;
+            mapped_memory_range.offset = current_range.first;
+            mapped_memory_range.pNext  = nullptr;
+            mapped_memory_range.size   = current_range.second - current_range.first;
+            mapped_memory_range.sType  = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+
+            m_scratch_mapped_memory_ranges.push_back(mapped_memory_range);
+        }
+
+        result_vk = Anvil::Vulkan::vkFlushMappedMemoryRanges(m_create_info_ptr->get_device()->get_device_vk(),
+                                                             static_cast<uint32_t>(m_scratch_mapped_memory_ranges.size() ),
+                                                            &m_scratch_mapped_memory_ranges.at(0) );
+        anvil_assert_vk_call_succeeded(result_vk);
+
+        result = is_vk_call_successful(result_vk);
+
+        m_dirty_ranges.clear();
+    }
+
+    return result;
+}
+
 /** Returns index of a memory type which meets the specified requirements
  *
  *  NOTE: @param coherent_memory_required may only be true if @param mappable_memory_required is also true.
@@ -578,6 +651,21 @@ bool Anvil::MemoryBlock::intersects(const Anvil::MemoryBlock* in_memory_block_pt
     return result;
 }
 
+/* Please see header for specification */
+bool Anvil::MemoryBlock::is_persistently_mapped() const
+{
+    auto parent_memory_block_ptr = m_create_info_ptr->get_parent_memory_block();
+
+    if (parent_memory_block_ptr != nullptr)
+    {
+        return parent_memory_block_ptr->is_persistently_mapped();
+    }
+    else
+    {
+        return m_is_persistently_mapped;
+    }
+}
+
 /* Please see header for specification */
 bool Anvil::MemoryBlock::map(VkDeviceSize in_start_offset,
                              VkDeviceSize in_size,
@@ -611,6 +699,9 @@ bool Anvil::MemoryBlock::map(VkDeviceSize in_start_offset,
 
             ANVIL_REDUNDANT_VARIABLE(result_vk);
 
+            /* Invalidation would discard writes which have not been flushed yet */
+            flush_dirty_ranges();
+
             mapped_memory_range.memory = get_memory();
             mapped_memory_range.offset = Anvil::Utils::round_down(in_start_offset,
                                                                   non_coherent_atom_size);
@@ -641,6 +732,58 @@ end:
     return result;
 }
 
+/** Adds the specified region of a root memory block to the list of dirty ranges, merging it with the ranges
+ *  it overlaps or touches. Region boundaries are aligned to the non-coherent atom size first.
+ *
+ *  The caller must hold the block's lock.
+ **/
+void Anvil::MemoryBlock::mark_range_dirty(VkDeviceSize in_start_offset,
+                                          VkDeviceSize in_size)
+{
+    const auto   mem_block_size         = m_create_info_ptr->get_size();
+    const auto   non_coherent_atom_size = m_create_info_ptr->get_device()->get_physical_device_properties().core_vk1_0_properties_ptr->limits.non_coherent_atom_size;
+    VkDeviceSize range_end              = std::min(Anvil::Utils::round_up(in_start_offset + in_size, non_coherent_atom_size),
+                                                   mem_block_size);
+    VkDeviceSize range_start            = Anvil::Utils::round_down(in_start_offset,
+                                                                   non_coherent_atom_size);
+
+    /* Find the first range which ends at or after the new range's start. All ranges which start at or before
+     * the new range's end, starting from that one, are merged into a single range. */
+    auto first_range_iterator = std::lower_bound(m_dirty_ranges.begin(),
+                                                 m_dirty_ranges.end  (),
+                                                 range_start,
+                                                 [](const std::pair<VkDeviceSize, VkDeviceSize>& in_range,
+                                                    VkDeviceSize                                 in_offset)
+                                                 {
+                                                     return in_range.second < in_offset;
+                                                 });
+    auto last_range_iterator  = first_range_iterator;
+
+    while (last_range_iterator        != m_dirty_ranges.end() &&
+           last_range_iterator->first <= range_end)
+    {
+        range_end   = std::max(range_end,   last_range_iterator->second);
+        range_start = std::min(range_start, last_range_iterator->first);
+
+        ++last_range_iterator;
+    }
+
+    if (first_range_iterator == last_range_iterator)
+    {
+        m_dirty_ranges.insert(first_range_iterator,
+                              std::make_pair(range_start,
+                                             range_end) );
+    }
+    else
+    {
+        first_range_iterator->first  = range_start;
+        first_range_iterator->second = range_end;
+
+        m_dirty_ranges.erase(first_range_iterator + 1,
+                             last_range_iterator);
+    }
+}
+
 /** Maps the specified region of the underlying memory object into process space and stores the
  *  pointer in m_gpu_data_ptr.
  *
@@ -748,6 +891,9 @@ bool Anvil::MemoryBlock::read(VkDeviceSize in_start_offset,
             anvil_assert            (m_start_offset == 0);
             ANVIL_REDUNDANT_VARIABLE(result_vk);
 
+            /* Invalidation would discard writes which have not been flushed yet */
+            flush_dirty_ranges();
+
             mapped_memory_range.memory = m_memory;
             mapped_memory_range.offset = Anvil::Utils::round_down(in_start_offset,
                                                                   non_coherent_atom_size);
@@ -780,6 +926,48 @@ end:
     return result;
 }
 
+/* Please see header for specification */
+bool Anvil::MemoryBlock::set_persistent_mapping(bool in_enable)
+{
+    bool result = false;
+
+    if (m_create_info_ptr->get_parent_memory_block() != nullptr)
+    {
+        result = m_create_info_ptr->get_parent_memory_block()->set_persistent_mapping(in_enable);
+    }
+    else
+    {
+        lock();
+        {
+            if (in_enable == m_is_persistently_mapped)
+            {
+                result = true;
+            }
+            else
+            if (in_enable)
+            {
+                /* The reference taken here keeps the storage mapped until the mode is disabled */
+                if (open_gpu_memory_access() )
+                {
+                    m_is_persistently_mapped = true;
+                    result                   = true;
+                }
+            }
+            else
+            {
+                result = flush_dirty_ranges_internal();
+
+                close_gpu_memory_access();
+
+                m_is_persistently_mapped = false;
+            }
+        }
+        unlock();
+    }
+
+    return result;
+}
+
 /* Please see header for specification */
 bool Anvil::MemoryBlock::unmap()
 {
@@ -837,6 +1025,18 @@ bool Anvil::MemoryBlock::write(VkDeviceSize in_start_offset,
                in_data,
                static_cast<size_t>(in_size));
 
+        if ((m_create_info_ptr->get_memory_features() & Anvil::MemoryFeatureFlagBits::HOST_COHERENT_BIT) == 0 &&
+             m_is_persistently_mapped)
+        {
+            /* Defer the flush until flush_dirty_ranges() is called */
+            lock();
+            {
+                mark_range_dirty(in_start_offset,
+                                 in_size);
+            }
+            unlock();
+        }
+        else
         if ((m_create_info_ptr->get_memory_features() & Anvil::MemoryFeatureFlagBits::HOST_COHERENT_BIT) == 0)
         {
             VkMappedMemoryRange mapped_memory_range;
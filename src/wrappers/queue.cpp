@@ -21,9 +21,8 @@
 //
 
 #include "misc/debug.h"
-#include "misc/fence_create_info.h"
+#include "misc/fence_pool.h"
 #include "misc/object_tracker.h"
-#include "misc/struct_chainer.h"
 #include "misc/swapchain_create_info.h"
 #include "misc/window.h"
 #include "wrappers/buffer.h"
@@ -35,6 +34,7 @@
 #include "wrappers/rendering_surface.h"
 #include "wrappers/semaphore.h"
 #include "wrappers/swapchain.h"
+#include <algorithm>
 
 #define MAX_SWAPCHAINS (32)
 
@@ -45,15 +45,28 @@ Anvil::Queue::Queue(const Anvil::BaseDevice* in_device_ptr,
                     uint32_t                 in_queue_index,
                     bool                     in_mt_safe)
 
-    :CallbacksSupportProvider       (QUEUE_CALLBACK_ID_COUNT),
-     DebugMarkerSupportProvider     (in_device_ptr,
-                                     Anvil::ObjectType::QUEUE),
-     MTSafetySupportProvider        (in_mt_safe),
-     m_device_ptr                   (in_device_ptr),
-     m_n_debug_label_regions_started(0),
-     m_queue                        (VK_NULL_HANDLE),
-     m_queue_family_index           (in_queue_family_index),
-     m_queue_index                  (in_queue_index)
+    :CallbacksSupportProvider          (QUEUE_CALLBACK_ID_COUNT),
+     DebugMarkerSupportProvider        (in_device_ptr,
+                                        Anvil::ObjectType::QUEUE),
+     MTSafetySupportProvider           (in_mt_safe),
+     m_device_ptr                      (in_device_ptr),
+     m_n_debug_label_regions_started   (0),
+     m_queue                           (VK_NULL_HANDLE),
+     m_queue_family_index              (in_queue_family_index),
+     m_queue_index                     (in_queue_index),
+     m_submission_deferral_enabled     (false),
+     m_n_last_issued_ticket            (0),
+     m_n_last_processed_ticket         (0),
+     m_n_ticket_waiters                (0),
+     m_free_posted_requests_head_ptr   (nullptr),
+     m_free_posted_requests_popping    (false),
+     m_posted_requests_head_ptr        (&m_posted_requests_stub),
+     m_posted_requests_stub            (PostedRequestType::STUB),
+     m_posted_requests_tail_ptr        (&m_posted_requests_stub),
+     m_submission_thread_enabled       (false),
+     m_submission_thread_id            (std::thread::id() ),
+     m_submission_thread_sleeping      (false),
+     m_submission_thread_stop_requested(false)
 {
     /* Retrieve the Vulkan handle */
     Anvil::Vulkan::vkGetDeviceQueue(m_device_ptr->get_device_vk(),
@@ -66,16 +79,6 @@ Anvil::Queue::Queue(const Anvil::BaseDevice* in_device_ptr,
     /* Determine whether the queue supports sparse bindings */
     m_supports_sparse_bindings = (m_device_ptr->get_queue_family_info(in_queue_family_index)->flags & Anvil::QueueFlagBits::SPARSE_BINDING_BIT) != 0;
 
-    /* Cache a fence that may be optionally used for submissions */
-    {
-        auto create_info_ptr = Anvil::FenceCreateInfo::create(m_device_ptr,
-                                                              false); /* create_signalled */
-
-        create_info_ptr->set_mt_safety(Anvil::Utils::convert_boolean_to_mt_safety_enum(is_mt_safe()) );
-
-        m_submit_fence_ptr = Anvil::Fence::create(std::move(create_info_ptr) );
-    }
-
     /* OK, register the wrapper instance and leave */
     Anvil::ObjectTracker::get()->register_object(Anvil::ObjectType::QUEUE,
                                                   this);
@@ -84,7 +87,20 @@ Anvil::Queue::Queue(const Anvil::BaseDevice* in_device_ptr,
 /** Please see header for specification */
 Anvil::Queue::~Queue()
 {
+    set_submission_thread_enabled(false);
+
+    /* All posted requests have been processed by now, so the free list holds every request ever allocated */
+    while (m_free_posted_requests_head_ptr.load() != nullptr)
+    {
+        PostedRequest* request_ptr = m_free_posted_requests_head_ptr.load();
+
+        m_free_posted_requests_head_ptr.store(request_ptr->next_ptr.load() );
+
+        delete request_ptr;
+    }
+
     anvil_assert(m_n_debug_label_regions_started == 0);
+    anvil_assert(m_pending_submissions.submissions.size() == 0);
 
     Anvil::ObjectTracker::get()->unregister_object(Anvil::ObjectType::QUEUE,
                                                     this);
@@ -120,6 +136,41 @@ end:
     ;
 }
 
+/** Returns a request to post to the submission thread. Recycles a processed request, if one is available.
+ *
+ *  Can be called from any thread.
+ **/
+Anvil::Queue::PostedRequest* Anvil::Queue::acquire_posted_request(PostedRequestType in_type)
+{
+    PostedRequest* result_ptr = nullptr;
+
+    /* Another thread is popping. Rather than wait, fall back to an allocation. */
+    if (!m_free_posted_requests_popping.exchange(true) )
+    {
+        result_ptr = m_free_posted_requests_head_ptr.load();
+
+        while (result_ptr != nullptr                                                            &&
+              !m_free_posted_requests_head_ptr.compare_exchange_weak(result_ptr,
+                                                                     result_ptr->next_ptr.load() ))
+        {
+            /* result_ptr has been updated to the new head. Try again. */
+        }
+
+        m_free_posted_requests_popping.store(false);
+    }
+
+    if (result_ptr != nullptr)
+    {
+        result_ptr->reset(in_type);
+    }
+    else
+    {
+        result_ptr = new PostedRequest(in_type);
+    }
+
+    return result_ptr;
+}
+
 /** Please see header for specification */
 bool Anvil::Queue::bind_sparse_memory(Anvil::SparseMemoryBindingUpdateInfo& in_update)
 {
@@ -129,6 +180,8 @@ bool Anvil::Queue::bind_sparse_memory(Anvil::SparseMemoryBindingUpdateInfo& in_u
     uint32_t                n_bind_info_items = 0;
     VkResult                result            = VK_ERROR_INITIALIZATION_FAILED;
 
+    drain_submission_thread();
+
     in_update.get_bind_sparse_call_args(&n_bind_info_items,
                                         &bind_info_items,
                                         &fence_ptr);
@@ -160,6 +213,9 @@ bool Anvil::Queue::bind_sparse_memory(Anvil::SparseMemoryBindingUpdateInfo& in_u
                                        true); /* in_should_lock */
     }
     {
+        /* Deferred submissions need to reach the queue before any work submitted after them */
+        flush_pending_submissions(nullptr); /* in_opt_fence_ptr */
+
         result = Anvil::Vulkan::vkQueueBindSparse(m_queue,
                                                   n_bind_info_items,
                                                   bind_info_items,
@@ -173,109 +229,44 @@ bool Anvil::Queue::bind_sparse_memory(Anvil::SparseMemoryBindingUpdateInfo& in_u
 
     anvil_assert(result == VK_SUCCESS);
 
-    for (uint32_t n_bind_info = 0;
-                  n_bind_info < n_bind_info_items;
-                ++n_bind_info)
-    {
-        uint32_t n_buffer_memory_updates       = 0;
-        uint32_t n_image_memory_updates        = 0;
-        uint32_t n_image_opaque_memory_updates = 0;
-
-        in_update.get_bind_info_properties(n_bind_info,
-                                          &n_buffer_memory_updates,
-                                          &n_image_memory_updates,
-                                          &n_image_opaque_memory_updates,
-                                           nullptr,  /* out_opt_n_signal_semaphores_ptr   */
-                                           nullptr,  /* out_opt_signal_semaphores_ptr_ptr */
-                                           nullptr,  /* out_opt_n_wait_semaphores_ptr     */
-                                           nullptr); /* out_opt_wait_semaphores_ptr_ptr   */
-
-        for (uint32_t n_buffer_memory_update = 0;
-                      n_buffer_memory_update < n_buffer_memory_updates;
-                    ++n_buffer_memory_update)
+    /* Walk the cached updates directly, so that the bookkeeping takes a single pass over all updates */
+    for (const auto& current_binding : in_update.m_bindings)
+    {
+        for (const auto& buffer_updates : current_binding.buffer_updates)
         {
-            VkDeviceSize        alloc_size                   = UINT64_MAX;
-            VkDeviceSize        buffer_memory_start_offset   = UINT64_MAX;
-            Anvil::Buffer*      buffer_ptr                   = nullptr;
-            bool                memory_block_owned_by_buffer = false;
-            Anvil::MemoryBlock* memory_block_ptr             = nullptr;
-            VkDeviceSize        memory_block_start_offset;
-
-            in_update.get_buffer_memory_update_properties(n_bind_info,
-                                                          n_buffer_memory_update,
-                                                         &buffer_ptr,
-                                                         &buffer_memory_start_offset,
-                                                         &memory_block_ptr,
-                                                         &memory_block_start_offset,
-                                                         &memory_block_owned_by_buffer,
-                                                          &alloc_size);
-
-            buffer_ptr->set_memory_sparse(memory_block_ptr,
-                                          memory_block_owned_by_buffer,
-                                          memory_block_start_offset,
-                                          buffer_memory_start_offset,
-                                          alloc_size);
+            for (const auto& current_update : buffer_updates.second.first)
+            {
+                buffer_updates.first->set_memory_sparse(current_update.memory_block_ptr,
+                                                        current_update.memory_block_owned_by_target,
+                                                        current_update.memory_block_start_offset,
+                                                        current_update.start_offset,
+                                                        current_update.size);
+            }
         }
 
-        for (uint32_t n_image_memory_update = 0;
-                      n_image_memory_update < n_image_memory_updates;
-                    ++n_image_memory_update)
+        for (const auto& image_updates : current_binding.image_updates)
         {
-            Anvil::Image*                image_ptr                   = nullptr;
-            VkExtent3D                   extent;
-            Anvil::SparseMemoryBindFlags flags;
-            bool                         memory_block_owned_by_image = false;
-            Anvil::MemoryBlock*          memory_block_ptr            = nullptr;
-            VkDeviceSize                 memory_block_start_offset;
-            VkOffset3D                   offset;
-            Anvil::ImageSubresource      subresource;
-
-            in_update.get_image_memory_update_properties(n_bind_info,
-                                                         n_image_memory_update,
-                                                        &image_ptr,
-                                                        &subresource,
-                                                        &offset,
-                                                        &extent,
-                                                        &flags,
-                                                        &memory_block_ptr,
-                                                        &memory_block_start_offset,
-                                                        &memory_block_owned_by_image);
-
-            image_ptr->on_memory_backing_update(subresource,
-                                                offset,
-                                                extent,
-                                                memory_block_ptr,
-                                                memory_block_start_offset,
-                                                memory_block_owned_by_image);
+            for (const auto& current_update : image_updates.second.first)
+            {
+                image_updates.first->on_memory_backing_update(current_update.subresource,
+                                                              current_update.offset,
+                                                              current_update.extent,
+                                                              current_update.memory_block_ptr,
+                                                              current_update.memory_block_start_offset,
+                                                              current_update.memory_block_owned_by_image);
+            }
         }
 
-        for (uint32_t n_image_opaque_memory_update = 0;
-                      n_image_opaque_memory_update < n_image_opaque_memory_updates;
-                    ++n_image_opaque_memory_update)
+        for (const auto& image_opaque_updates : current_binding.image_opaque_updates)
         {
-            Anvil::SparseMemoryBindFlags flags;
-            Anvil::Image*                image_ptr                   = nullptr;
-            bool                         memory_block_owned_by_image = false;
-            Anvil::MemoryBlock*          memory_block_ptr            = nullptr;
-            VkDeviceSize                 memory_block_start_offset;
-            VkDeviceSize                 resource_offset;
-            VkDeviceSize                 size;
-
-            in_update.get_image_opaque_memory_update_properties(n_bind_info,
-                                                                n_image_opaque_memory_update,
-                                                               &image_ptr,
-                                                               &resource_offset,
-                                                               &size,
-                                                               &flags,
-                                                               &memory_block_ptr,
-                                                               &memory_block_start_offset,
-                                                               &memory_block_owned_by_image);
-
-            image_ptr->on_memory_backing_opaque_update(resource_offset,
-                                                       size,
-                                                       memory_block_ptr,
-                                                       memory_block_start_offset,
-                                                       memory_block_owned_by_image);
+            for (const auto& current_update : image_opaque_updates.second.first)
+            {
+                image_opaque_updates.first->on_memory_backing_opaque_update(current_update.start_offset,
+                                                                            current_update.size,
+                                                                            current_update.memory_block_ptr,
+                                                                            current_update.memory_block_start_offset,
+                                                                            current_update.memory_block_owned_by_target);
+            }
         }
     }
 
@@ -286,13 +277,7 @@ end:
 void Anvil::Queue::bind_sparse_memory_lock_unlock(Anvil::SparseMemoryBindingUpdateInfo& in_update,
                                                   bool                                  in_should_lock)
 {
-    const VkBindSparseInfo* bind_info_items   = nullptr;
-    Anvil::Fence*           fence_ptr         = nullptr;
-    uint32_t                n_bind_info_items = 0;
-
-    in_update.get_bind_sparse_call_args(&n_bind_info_items,
-                                        &bind_info_items,
-                                        &fence_ptr);
+    Anvil::Fence* fence_ptr = in_update.m_fence_ptr;
 
     if (in_should_lock)
     {
@@ -315,130 +300,66 @@ void Anvil::Queue::bind_sparse_memory_lock_unlock(Anvil::SparseMemoryBindingUpda
         }
     }
 
-    for (uint32_t n_bind_info_item = 0;
-                  n_bind_info_item < n_bind_info_items;
-                ++n_bind_info_item)
-    {
-        uint32_t           n_buffer_memory_updates       = 0;
-        uint32_t           n_image_memory_updates        = 0;
-        uint32_t           n_image_opaque_memory_updates = 0;
-        uint32_t           n_signal_sems                 = 0;
-        uint32_t           n_wait_sems                   = 0;
-        Anvil::Semaphore** signal_sem_ptrs               = nullptr;
-        Anvil::Semaphore** wait_sem_ptrs                 = nullptr;
-
-        in_update.get_bind_info_properties(n_bind_info_item,
-                                          &n_buffer_memory_updates,
-                                          &n_image_memory_updates,
-                                          &n_image_opaque_memory_updates,
-                                          &n_signal_sems,
-                                          &signal_sem_ptrs,
-                                          &n_wait_sems,
-                                          &wait_sem_ptrs);
-
-        for (uint32_t n_signal_sem = 0;
-                      n_signal_sem < n_signal_sems;
-                    ++n_signal_sem)
+    /* Updates are grouped per resource, so each resource only needs to be locked once per bind info */
+    for (const auto& current_binding : in_update.m_bindings)
+    {
+        for (auto signal_sem_ptr : current_binding.signal_semaphores)
         {
             if (in_should_lock)
             {
-                signal_sem_ptrs[n_signal_sem]->lock();
+                signal_sem_ptr->lock();
             }
             else
             {
-                signal_sem_ptrs[n_signal_sem]->unlock();
+                signal_sem_ptr->unlock();
             }
         }
 
-        for (uint32_t n_wait_sem = 0;
-                      n_wait_sem < n_wait_sems;
-                    ++n_wait_sem)
+        for (auto wait_sem_ptr : current_binding.wait_semaphores)
         {
             if (in_should_lock)
             {
-                wait_sem_ptrs[n_wait_sem]->lock();
+                wait_sem_ptr->lock();
             }
             else
             {
-                wait_sem_ptrs[n_wait_sem]->unlock();
+                wait_sem_ptr->unlock();
             }
         }
 
-        for (uint32_t n_buffer_memory_update = 0;
-                      n_buffer_memory_update < n_buffer_memory_updates;
-                    ++n_buffer_memory_update)
+        for (const auto& buffer_updates : current_binding.buffer_updates)
         {
-            Anvil::Buffer* buffer_ptr = nullptr;
-
-            in_update.get_buffer_memory_update_properties(n_bind_info_item,
-                                                          n_buffer_memory_update,
-                                                         &buffer_ptr,
-                                                          nullptr,  /* out_opt_buffer_memory_start_offset_ptr   */
-                                                          nullptr,  /* out_opt_memory_block_ptr                 */
-                                                          nullptr,  /* out_opt_memory_block_start_offset_ptr    */
-                                                          nullptr,  /* out_opt_memory_block_owned_by_buffer_ptr */
-                                                          nullptr); /* out_opt_size_ptr                         */
-
             if (in_should_lock)
             {
-                buffer_ptr->lock();
+                buffer_updates.first->lock();
             }
             else
             {
-                buffer_ptr->unlock();
+                buffer_updates.first->unlock();
             }
         }
 
-        for (uint32_t n_image_memory_update = 0;
-                      n_image_memory_update < n_image_memory_updates;
-                    ++n_image_memory_update)
+        for (const auto& image_updates : current_binding.image_updates)
         {
-            Anvil::Image* image_ptr = nullptr;
-
-            in_update.get_image_memory_update_properties(n_bind_info_item,
-                                                         n_image_memory_update,
-                                                        &image_ptr,
-                                                         nullptr,  /* out_opt_subresource_ptr                 */
-                                                         nullptr,  /* out_opt_offset_ptr                      */
-                                                         nullptr,  /* out_opt_extent_ptr                      */
-                                                         nullptr,  /* out_opt_flags_ptr                       */
-                                                         nullptr,  /* out_opt_memory_block_ptr_ptr            */
-                                                         nullptr,  /* out_opt_memory_block_start_offset_ptr   */
-                                                         nullptr); /* out_opt_memory_block_owned_by_image_ptr */
-
             if (in_should_lock)
             {
-                image_ptr->lock();
+                image_updates.first->lock();
             }
             else
             {
-                image_ptr->unlock();
+                image_updates.first->unlock();
             }
         }
 
-        for (uint32_t n_opaque_image_memory_update = 0;
-                      n_opaque_image_memory_update < n_image_opaque_memory_updates;
-                    ++n_opaque_image_memory_update)
+        for (const auto& image_opaque_updates : current_binding.image_opaque_updates)
         {
-            Anvil::Image* image_ptr = nullptr;
-
-            in_update.get_image_opaque_memory_update_properties(n_bind_info_item,
-                                                                n_opaque_image_memory_update,
-                                                               &image_ptr,
-                                                                nullptr,  /* out_opt_resource_offset_ptr             */
-                                                                nullptr,  /* out_opt_size_ptr                        */
-                                                                nullptr,  /* out_opt_flags_ptr                       */
-                                                                nullptr,  /* out_opt_memory_block_ptr_ptr            */
-                                                                nullptr,  /* out_opt_memory_block_start_offset_ptr   */
-                                                                nullptr); /* out_opt_memory_block_owned_by_image_ptr */
-
             if (in_should_lock)
             {
-                image_ptr->lock();
+                image_opaque_updates.first->lock();
             }
             else
             {
-                image_ptr->unlock();
+                image_opaque_updates.first->unlock();
             }
         }
     }
@@ -805,13 +726,13 @@ VkResult Anvil::Queue::present_internal(DeviceGroupPresentModeFlagBits in_presen
                                         uint32_t                       in_n_wait_semaphores,
                                         Anvil::Semaphore* const*       in_wait_semaphore_ptrs)
 {
+    VkDeviceGroupPresentInfoKHR             device_group_present_info;
     const Anvil::DeviceType                 device_type            (m_device_ptr->get_type() );
+    VkPresentInfoKHR                        image_presentation_info;
     VkResult                                presentation_results   [MAX_SWAPCHAINS];
     VkResult                                result;
-    Anvil::StructChainer<VkPresentInfoKHR>  struct_chainer;
     const ExtensionKHRSwapchainEntrypoints* swapchain_entrypoints_ptr(nullptr);
     VkSwapchainKHR                          swapchains_vk          [MAX_SWAPCHAINS];
-    std::vector<VkSemaphore>                wait_semaphores_vk     (in_n_wait_semaphores);
 
     /* Sanity checks */
     anvil_assert(in_n_swapchains      <  MAX_SWAPCHAINS);
@@ -824,6 +745,8 @@ VkResult Anvil::Queue::present_internal(DeviceGroupPresentModeFlagBits in_presen
         anvil_assert(in_presentation_mode == Anvil::DeviceGroupPresentModeFlagBits::LOCAL_BIT_KHR);
     }
 
+    drain_submission_thread();
+
     /* If the application is only interested in off-screen rendering, do *not* post the present request,
      * since the fake swapchain image is not presentable. We still have to wait on the user-specified
      * semaphores though. */
@@ -874,40 +797,27 @@ VkResult Anvil::Queue::present_internal(DeviceGroupPresentModeFlagBits in_presen
         swapchains_vk[n_swapchain] = in_swapchains[n_swapchain]->get_swapchain_vk();
     }
 
-    for (uint32_t n_wait_semaphore = 0;
-                  n_wait_semaphore < in_n_wait_semaphores;
-                ++n_wait_semaphore)
-    {
-        wait_semaphores_vk[n_wait_semaphore] = in_wait_semaphore_ptrs[n_wait_semaphore]->get_semaphore();
-    }
-
-    {
-        VkPresentInfoKHR image_presentation_info;
-
-        image_presentation_info.pImageIndices      = in_swapchain_image_indices;
-        image_presentation_info.pNext              = nullptr;
-        image_presentation_info.pResults           = presentation_results;
-        image_presentation_info.pSwapchains        = swapchains_vk;
-        image_presentation_info.pWaitSemaphores    = (in_n_wait_semaphores != 0) ? &wait_semaphores_vk.at(0) : nullptr;
-        image_presentation_info.sType              = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
-        image_presentation_info.swapchainCount     = in_n_swapchains;
-        image_presentation_info.waitSemaphoreCount = in_n_wait_semaphores;
-
-        struct_chainer.append_struct(image_presentation_info);
-    }
+    /* The structures are chained by hand, rather than with a StructChainer, so that presentation
+     * does not need to allocate memory. */
+    image_presentation_info.pImageIndices      = in_swapchain_image_indices;
+    image_presentation_info.pNext              = nullptr;
+    image_presentation_info.pResults           = presentation_results;
+    image_presentation_info.pSwapchains        = swapchains_vk;
+    image_presentation_info.pWaitSemaphores    = nullptr;
+    image_presentation_info.sType              = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+    image_presentation_info.swapchainCount     = in_n_swapchains;
+    image_presentation_info.waitSemaphoreCount = in_n_wait_semaphores;
 
     /* For multi-GPU support, we're likely going to need to attach the VkDeviceGroupPresentInfoKHR struct */
     if (device_type == Anvil::DeviceType::MULTI_GPU)
     {
-        VkDeviceGroupPresentInfoKHR device_group_present_info;
-
         device_group_present_info.mode           = static_cast<VkDeviceGroupPresentModeFlagBitsKHR>(in_presentation_mode);
         device_group_present_info.pDeviceMasks   = in_device_masks;
         device_group_present_info.pNext          = nullptr;
         device_group_present_info.sType          = VK_STRUCTURE_TYPE_DEVICE_GROUP_PRESENT_INFO_KHR;
         device_group_present_info.swapchainCount = in_n_swapchains;
 
-        struct_chainer.append_struct(device_group_present_info);
+        image_presentation_info.pNext = &device_group_present_info;
     }
 
     swapchain_entrypoints_ptr = &m_device_ptr->get_extension_khr_swapchain_entrypoints();
@@ -918,10 +828,27 @@ VkResult Anvil::Queue::present_internal(DeviceGroupPresentModeFlagBits in_presen
                         in_wait_semaphore_ptrs,
                         true);
     {
-        auto chain_ptr = struct_chainer.create_chain();
+        /* Deferred submissions may signal the semaphores the presentation waits on */
+        flush_pending_submissions(nullptr); /* in_opt_fence_ptr */
+
+        /* Wait semaphore handles go to per-queue storage. Queues which are not MT-safe are only used by one thread
+         * at a time, since set_submission_thread_enabled() does not start a worker for them. */
+        m_present_wait_semaphores_vk.clear();
+
+        for (uint32_t n_wait_semaphore = 0;
+                      n_wait_semaphore < in_n_wait_semaphores;
+                    ++n_wait_semaphore)
+        {
+            m_present_wait_semaphores_vk.push_back(in_wait_semaphore_ptrs[n_wait_semaphore]->get_semaphore() );
+        }
+
+        if (in_n_wait_semaphores != 0)
+        {
+            image_presentation_info.pWaitSemaphores = &m_present_wait_semaphores_vk.at(0);
+        }
 
         result = swapchain_entrypoints_ptr->vkQueuePresentKHR(m_queue,
-                                                              chain_ptr->get_root_struct() );
+                                                             &image_presentation_info);
     }
     present_lock_unlock(in_n_swapchains,
                         in_swapchains,
@@ -1050,413 +977,770 @@ void Anvil::Queue::present_lock_unlock(uint32_t                       in_n_swapc
 }
 
 /** Please see header for specification */
-bool Anvil::Queue::submit(const Anvil::SubmitInfo& in_submit_info)
+void Anvil::Queue::drain_submission_thread()
 {
-    Anvil::Fence*                      fence_ptr        (in_submit_info.get_fence() );
-    bool                               needs_fence_reset(false);
-    VkResult                           result           (VK_ERROR_INITIALIZATION_FAILED);
-    Anvil::StructChainer<VkSubmitInfo> struct_chainer;
+    /* Requests posted by the submission thread itself, if any, are processed as soon as it gets to them */
+    if (!m_submission_thread_enabled                                     ||
+         std::this_thread::get_id() == m_submission_thread_id.load() )
+    {
+        goto end;
+    }
 
-    std::vector<VkCommandBuffer> cmd_buffers_vk      (in_submit_info.get_n_command_buffers  () );
-    std::vector<VkSemaphore>     signal_semaphores_vk(in_submit_info.get_n_signal_semaphores() );
-    std::vector<VkSemaphore>     wait_semaphores_vk  (in_submit_info.get_n_wait_semaphores  () );
+    wait_for_ticket(m_n_last_issued_ticket.load() );
 
-    std::vector<uint32_t> cmd_buffer_device_masks         = std::vector<uint32_t>(in_submit_info.get_n_command_buffers() );
-    std::vector<uint32_t> signal_semaphore_device_indices = std::vector<uint32_t>(in_submit_info.get_n_signal_semaphores() );
-    std::vector<uint32_t> wait_semaphore_device_indices   = std::vector<uint32_t>(in_submit_info.get_n_wait_semaphores  () );
+end:
+    ;
+}
 
-    ANVIL_REDUNDANT_VARIABLE(result);
+/** Please see header for specification */
+bool Anvil::Queue::has_posted_requests() const
+{
+    /* May report pending requests a producer has not finished linking yet. pop_posted_request() is going to
+     * return them as soon as it does. */
+    return (m_posted_requests_tail_ptr                  != &m_posted_requests_stub ||
+            m_posted_requests_stub.next_ptr.load()      != nullptr);
+}
 
-    /* Prepare for the submission */
-    switch (in_submit_info.get_type() )
+/** Please see header for specification */
+void Anvil::Queue::mark_ticket_processed(SubmissionTicket in_ticket)
+{
+    SubmissionTicket n_last_processed_ticket = m_n_last_processed_ticket.load();
+
+    /* Tickets are issued before requests are linked into the queue, so requests posted concurrently by
+     * different threads may arrive out of ticket order. Only advance past tickets, all predecessors of
+     * which have been processed. */
+    if (in_ticket != n_last_processed_ticket + 1)
     {
-        case SubmissionType::MGPU:
-        {
-            uint32_t n_cmd_buffers = 0;
+        m_tickets_processed_out_of_order.insert(std::upper_bound(m_tickets_processed_out_of_order.begin(),
+                                                                 m_tickets_processed_out_of_order.end  (),
+                                                                 in_ticket),
+                                                in_ticket);
 
-            for (uint32_t n_command_buffer_submission = 0;
-                          n_command_buffer_submission < in_submit_info.get_n_command_buffers();
-                        ++n_command_buffer_submission)
-            {
-                const auto& current_submission = in_submit_info.get_command_buffers_mgpu()[n_command_buffer_submission];
+        goto end;
+    }
 
-                if (current_submission.cmd_buffer_ptr != nullptr)
-                {
-                    cmd_buffers_vk.at         (n_cmd_buffers) = current_submission.cmd_buffer_ptr->get_command_buffer();
-                    cmd_buffer_device_masks.at(n_cmd_buffers) = current_submission.device_mask;
+    n_last_processed_ticket = in_ticket;
 
-                    ++n_cmd_buffers;
-                }
-            }
+    while (m_tickets_processed_out_of_order.size()  > 0                           &&
+           m_tickets_processed_out_of_order.front() == n_last_processed_ticket + 1)
+    {
+        n_last_processed_ticket = m_tickets_processed_out_of_order.front();
 
-            for (uint32_t n_signal_semaphore_submission = 0;
-                          n_signal_semaphore_submission < in_submit_info.get_n_signal_semaphores();
-                        ++n_signal_semaphore_submission)
-            {
-                const auto& current_submission = in_submit_info.get_signal_semaphores_mgpu()[n_signal_semaphore_submission];
+        m_tickets_processed_out_of_order.erase(m_tickets_processed_out_of_order.begin() );
+    }
 
-                signal_semaphore_device_indices.at(n_signal_semaphore_submission) = current_submission.device_index;
-                signal_semaphores_vk.at           (n_signal_semaphore_submission) = current_submission.semaphore_ptr->get_semaphore();
-            }
+    m_n_last_processed_ticket.store(n_last_processed_ticket);
 
-            for (uint32_t n_wait_semaphore_submission = 0;
-                          n_wait_semaphore_submission < in_submit_info.get_n_wait_semaphores();
-                        ++n_wait_semaphore_submission)
-            {
-                const auto& current_submission = in_submit_info.get_wait_semaphores_mgpu()[n_wait_semaphore_submission];
+    if (m_n_ticket_waiters.load() > 0)
+    {
+        std::lock_guard<std::mutex> lock(m_ticket_processed_mutex);
 
-                wait_semaphore_device_indices.at(n_wait_semaphore_submission) = current_submission.device_index;
-                wait_semaphores_vk.at           (n_wait_semaphore_submission) = current_submission.semaphore_ptr->get_semaphore();
-            }
+        m_ticket_processed_cv.notify_all();
+    }
 
-            {
-                VkSubmitInfo submit_info;
-
-                submit_info.commandBufferCount   = in_submit_info.get_n_command_buffers();
-                submit_info.pCommandBuffers      = (submit_info.commandBufferCount           != 0) ? &cmd_buffers_vk.at(0)       : nullptr;
-                submit_info.pNext                = nullptr;
-                submit_info.pSignalSemaphores    = (in_submit_info.get_n_signal_semaphores() != 0) ? &signal_semaphores_vk.at(0) : nullptr;
-                submit_info.pWaitDstStageMask    = in_submit_info.get_destination_stage_wait_masks();
-                submit_info.pWaitSemaphores      = (in_submit_info.get_n_wait_semaphores()   != 0) ? &wait_semaphores_vk.at(0)   : nullptr;
-                submit_info.signalSemaphoreCount = in_submit_info.get_n_signal_semaphores();
-                submit_info.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-                submit_info.waitSemaphoreCount   = in_submit_info.get_n_wait_semaphores();
-
-                struct_chainer.append_struct(submit_info);
-            }
+end:
+    ;
+}
 
-            {
-                VkDeviceGroupSubmitInfoKHR submit_info_device_group;
-
-                submit_info_device_group.commandBufferCount            = n_cmd_buffers;
-                submit_info_device_group.pCommandBufferDeviceMasks     = (n_cmd_buffers != 0) ? &cmd_buffer_device_masks.at(0) : nullptr;
-                submit_info_device_group.pNext                         = nullptr;
-                submit_info_device_group.pSignalSemaphoreDeviceIndices = (in_submit_info.get_n_signal_semaphores() != 0) ? &signal_semaphore_device_indices.at(0) : nullptr;
-                submit_info_device_group.pWaitSemaphoreDeviceIndices   = (in_submit_info.get_n_wait_semaphores  () != 0) ? &wait_semaphore_device_indices.at  (0) : nullptr;
-                submit_info_device_group.signalSemaphoreCount          = in_submit_info.get_n_signal_semaphores();
-                submit_info_device_group.sType                         = VK_STRUCTURE_TYPE_DEVICE_GROUP_SUBMIT_INFO_KHR;
-                submit_info_device_group.waitSemaphoreCount            = in_submit_info.get_n_wait_semaphores();
-
-                struct_chainer.append_struct(submit_info_device_group);
-            }
+/** Please see header for specification */
+Anvil::Queue::PostedRequest* Anvil::Queue::pop_posted_request()
+{
+    PostedRequest* next_ptr   = nullptr;
+    PostedRequest* result_ptr = nullptr;
+    PostedRequest* tail_ptr   = m_posted_requests_tail_ptr;
 
-            break;
-        }
+    next_ptr = tail_ptr->next_ptr.load();
 
-        case SubmissionType::SGPU:
+    /* Skip the stub, if it's at the front of the queue */
+    if (tail_ptr == &m_posted_requests_stub)
+    {
+        if (next_ptr == nullptr)
         {
-            VkSubmitInfo submit_info;
-
-            for (uint32_t n_command_buffer = 0;
-                          n_command_buffer < in_submit_info.get_n_command_buffers();
-                        ++n_command_buffer)
-            {
-                cmd_buffers_vk.at(n_command_buffer) = in_submit_info.get_command_buffers_sgpu()[n_command_buffer]->get_command_buffer();
-            }
-
-            for (uint32_t n_signal_semaphore = 0;
-                          n_signal_semaphore < in_submit_info.get_n_signal_semaphores();
-                        ++n_signal_semaphore)
-            {
-                auto sem_ptr = in_submit_info.get_signal_semaphores_sgpu()[n_signal_semaphore];
-
-                signal_semaphores_vk.at(n_signal_semaphore) = sem_ptr->get_semaphore();
-            }
+            goto end;
+        }
 
-            for (uint32_t n_wait_semaphore = 0;
-                          n_wait_semaphore < in_submit_info.get_n_wait_semaphores();
-                        ++n_wait_semaphore)
-            {
-                wait_semaphores_vk.at(n_wait_semaphore) = in_submit_info.get_wait_semaphores_sgpu()[n_wait_semaphore]->get_semaphore();
-            }
+        m_posted_requests_tail_ptr = next_ptr;
+        tail_ptr                   = next_ptr;
+        next_ptr                   = next_ptr->next_ptr.load();
+    }
 
-            submit_info.commandBufferCount   = in_submit_info.get_n_command_buffers ();
-            submit_info.pCommandBuffers      = (in_submit_info.get_n_command_buffers()   != 0) ? &cmd_buffers_vk.at(0)       : nullptr;
-            submit_info.pNext                = nullptr;
-            submit_info.pSignalSemaphores    = (in_submit_info.get_n_signal_semaphores() != 0) ? &signal_semaphores_vk.at(0) : nullptr;
-            submit_info.pWaitDstStageMask    = in_submit_info.get_destination_stage_wait_masks();
-            submit_info.pWaitSemaphores      = (in_submit_info.get_n_wait_semaphores()   != 0) ? &wait_semaphores_vk.at(0)   : nullptr;
-            submit_info.signalSemaphoreCount = in_submit_info.get_n_signal_semaphores();
-            submit_info.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-            submit_info.waitSemaphoreCount   = in_submit_info.get_n_wait_semaphores();
+    if (next_ptr == nullptr)
+    {
+        /* The tail is the last request in the queue, or a producer is in the middle of linking a new one */
+        if (tail_ptr != m_posted_requests_head_ptr.load() )
+        {
+            goto end;
+        }
 
-            struct_chainer.append_struct(submit_info);
+        /* Re-insert the stub, so that the last request can be detached from the queue */
+        push_posted_request(&m_posted_requests_stub);
 
-            break;
-        }
+        next_ptr = tail_ptr->next_ptr.load();
 
-        default:
+        if (next_ptr == nullptr)
         {
-            anvil_assert_fail();
+            goto end;
         }
     }
 
-    /* Any additional structs to chain? */
-    #if defined(_WIN32)
-    {
-        const uint64_t* d3d12_fence_signal_semaphore_values_ptr = nullptr;
-        const uint64_t* d3d12_fence_wait_semaphore_values_ptr   = nullptr;
-
-        if (in_submit_info.get_d3d12_fence_semaphore_values(&d3d12_fence_signal_semaphore_values_ptr,
-                                                            &d3d12_fence_wait_semaphore_values_ptr) )
-        {
-            VkD3D12FenceSubmitInfoKHR fence_info;
+    m_posted_requests_tail_ptr = next_ptr;
+    result_ptr                 = tail_ptr;
 
-            fence_info.pNext                      = nullptr;
-            fence_info.pSignalSemaphoreValues     = d3d12_fence_signal_semaphore_values_ptr;
-            fence_info.pWaitSemaphoreValues       = d3d12_fence_wait_semaphore_values_ptr;
-            fence_info.signalSemaphoreValuesCount = in_submit_info.get_n_signal_semaphores();
-            fence_info.sType                      = VK_STRUCTURE_TYPE_D3D12_FENCE_SUBMIT_INFO_KHR;
-            fence_info.waitSemaphoreValuesCount   = in_submit_info.get_n_wait_semaphores();
+end:
+    return result_ptr;
+}
 
-            struct_chainer.append_struct(fence_info);
-        }
-    }
-    #endif
+/** Please see header for specification */
+Anvil::Queue::SubmissionTicket Anvil::Queue::post_present(Anvil::Swapchain*        in_swapchain_ptr,
+                                                          uint32_t                 in_swapchain_image_index,
+                                                          uint32_t                 in_n_wait_semaphores,
+                                                          Anvil::Semaphore* const* in_wait_semaphore_ptrs_ptr,
+                                                          VkResult*                out_opt_result_ptr)
+{
+    PostedRequest*   request_ptr = nullptr;
+    SubmissionTicket result      = 0;
 
-    /* Go for it */
-    if (fence_ptr                         == nullptr &&
-        in_submit_info.get_should_block() )
+    if (!m_submission_thread_enabled)
     {
-        fence_ptr         = m_submit_fence_ptr.get();
-        needs_fence_reset = true;
-    }
+        const VkResult present_result = present(in_swapchain_ptr,
+                                                in_swapchain_image_index,
+                                                in_n_wait_semaphores,
+                                                in_wait_semaphore_ptrs_ptr);
 
-    switch (in_submit_info.get_type() )
-    {
-        case SubmissionType::MGPU:
+        if (out_opt_result_ptr != nullptr)
         {
-            submit_command_buffers_lock_unlock(in_submit_info.get_n_command_buffers     (),
-                                               in_submit_info.get_command_buffers_mgpu  (),
-                                               in_submit_info.get_n_signal_semaphores   (),
-                                               in_submit_info.get_signal_semaphores_mgpu(),
-                                               in_submit_info.get_n_wait_semaphores     (),
-                                               in_submit_info.get_wait_semaphores_mgpu  (),
-                                               fence_ptr,
-                                               true);
-
-            break;
+            *out_opt_result_ptr = present_result;
         }
 
-        case SubmissionType::SGPU:
-        {
-             submit_command_buffers_lock_unlock(in_submit_info.get_n_command_buffers     (),
-                                                in_submit_info.get_command_buffers_sgpu  (),
-                                                in_submit_info.get_n_signal_semaphores   (),
-                                                in_submit_info.get_signal_semaphores_sgpu(),
-                                                in_submit_info.get_n_wait_semaphores     (),
-                                                in_submit_info.get_wait_semaphores_sgpu  (),
-                                                fence_ptr,
-                                                true); /* in_should_lock */
-
-             break;
-        }
+        goto end;
+    }
 
-        default:
-        {
-            anvil_assert_fail();
-        }
-     }
+    request_ptr = acquire_posted_request(PostedRequestType::PRESENT);
 
-     {
-        auto chain_ptr = struct_chainer.create_chain();
+    request_ptr->present_result_ptr    = out_opt_result_ptr;
+    request_ptr->swapchain_image_index = in_swapchain_image_index;
+    request_ptr->swapchain_ptr         = in_swapchain_ptr;
 
-        if (needs_fence_reset)
-        {
-            m_submit_fence_ptr->reset();
-        }
+    if (in_n_wait_semaphores > 0)
+    {
+        request_ptr->wait_semaphore_ptrs.assign(in_wait_semaphore_ptrs_ptr,
+                                                in_wait_semaphore_ptrs_ptr + in_n_wait_semaphores);
+    }
 
-         result = Anvil::Vulkan::vkQueueSubmit(m_queue,
-                                               1, /* submitCount */
-                                               chain_ptr->get_root_struct(),
-                                              (fence_ptr != nullptr) ? fence_ptr->get_fence()
-                                                                     : VK_NULL_HANDLE);
+    result              = ++m_n_last_issued_ticket;
+    request_ptr->ticket = result;
 
-        if (in_submit_info.get_should_block() )
-        {
-            /* Wait till initialization finishes GPU-side */
-            result = Anvil::Vulkan::vkWaitForFences(m_device_ptr->get_device_vk(),
-                                                    1, /* fenceCount */
-                                                    fence_ptr->get_fence_ptr(),
-                                                    VK_TRUE,     /* waitAll */
-                                                    in_submit_info.get_timeout() );
-        }
-     }
-
-     switch (in_submit_info.get_type() )
-     {
-         case SubmissionType::MGPU:
-         {
-             submit_command_buffers_lock_unlock(in_submit_info.get_n_command_buffers     (),
-                                                in_submit_info.get_command_buffers_mgpu  (),
-                                                in_submit_info.get_n_signal_semaphores   (),
-                                                in_submit_info.get_signal_semaphores_mgpu(),
-                                                in_submit_info.get_n_wait_semaphores     (),
-                                                in_submit_info.get_wait_semaphores_mgpu  (),
-                                                fence_ptr,
-                                                false); /* in_should_lock */
-
-             break;
-         }
-
-         case SubmissionType::SGPU:
-         {
-             submit_command_buffers_lock_unlock(in_submit_info.get_n_command_buffers     (),
-                                                in_submit_info.get_command_buffers_sgpu  (),
-                                                in_submit_info.get_n_signal_semaphores   (),
-                                                in_submit_info.get_signal_semaphores_sgpu(),
-                                                in_submit_info.get_n_wait_semaphores     (),
-                                                in_submit_info.get_wait_semaphores_sgpu  (),
-                                                fence_ptr,
-                                                false); /* in_should_lock */
-
-             break;
-         }
-
-         default:
-         {
-             anvil_assert_fail();
-         }
-     }
-
-     return (result == VK_SUCCESS);
+    push_posted_request(request_ptr);
+
+end:
+    return result;
 }
 
-void Anvil::Queue::submit_command_buffers_lock_unlock(uint32_t                         in_n_command_buffers,
-                                                      Anvil::CommandBufferBase* const* in_opt_cmd_buffer_ptrs,
-                                                      uint32_t                         in_n_semaphores_to_signal,
-                                                      Anvil::Semaphore* const*         in_opt_semaphore_to_signal_ptr_ptrs,
-                                                      uint32_t                         in_n_semaphores_to_wait_on,
-                                                      Anvil::Semaphore* const*         in_opt_semaphore_to_wait_on_ptr_ptrs,
-                                                      Anvil::Fence*                    in_opt_fence_ptr,
-                                                      bool                             in_should_lock)
+/** Please see header for specification */
+Anvil::Queue::SubmissionTicket Anvil::Queue::post_submit(const Anvil::SubmitInfo& in_submit_info,
+                                                         bool*                    out_opt_result_ptr)
 {
-    if (in_should_lock)
-    {
-        lock();
-    }
-    else
-    {
-        unlock();
-    }
+    const uint32_t   n_command_buffers  (in_submit_info.get_n_command_buffers  () );
+    const uint32_t   n_signal_semaphores(in_submit_info.get_n_signal_semaphores() );
+    const uint32_t   n_wait_semaphores  (in_submit_info.get_n_wait_semaphores  () );
+    PostedRequest*   request_ptr        (nullptr);
+    SubmissionTicket result             (0);
+
+    /* The submission thread must not be stalled by blocking submissions */
+    anvil_assert(!in_submit_info.get_should_block() );
 
-    for (uint32_t n_command_buffer = 0;
-                  n_command_buffer < in_n_command_buffers;
-                ++n_command_buffer)
+    if (!m_submission_thread_enabled)
     {
-        if (in_should_lock)
-        {
-            in_opt_cmd_buffer_ptrs[n_command_buffer]->lock();
-        }
-        else
+        const bool submit_result = submit(in_submit_info);
+
+        if (out_opt_result_ptr != nullptr)
         {
-            in_opt_cmd_buffer_ptrs[n_command_buffer]->unlock();
+            *out_opt_result_ptr = submit_result;
         }
+
+        goto end;
     }
 
-    for (uint32_t n_signal_semaphore = 0;
-                  n_signal_semaphore < in_n_semaphores_to_signal;
-                ++n_signal_semaphore)
+    request_ptr = acquire_posted_request(PostedRequestType::SUBMIT);
+
+    request_ptr->fence_ptr         = in_submit_info.get_fence();
+    request_ptr->is_mgpu           = (in_submit_info.get_type() == SubmissionType::MGPU);
+    request_ptr->submit_result_ptr = out_opt_result_ptr;
+
+    if (request_ptr->is_mgpu)
     {
-        if (in_should_lock)
+        if (n_command_buffers > 0)
         {
-            in_opt_semaphore_to_signal_ptr_ptrs[n_signal_semaphore]->lock();
+            request_ptr->command_buffers_mgpu.assign(in_submit_info.get_command_buffers_mgpu(),
+                                                     in_submit_info.get_command_buffers_mgpu() + n_command_buffers);
         }
-        else
+
+        if (n_signal_semaphores > 0)
         {
-            in_opt_semaphore_to_signal_ptr_ptrs[n_signal_semaphore]->unlock();
+            request_ptr->signal_semaphores_mgpu.assign(in_submit_info.get_signal_semaphores_mgpu(),
+                                                       in_submit_info.get_signal_semaphores_mgpu() + n_signal_semaphores);
         }
-    }
 
-    for (uint32_t n_wait_semaphore = 0;
-                  n_wait_semaphore < in_n_semaphores_to_wait_on;
-                ++n_wait_semaphore)
-    {
-        if (in_should_lock)
+        if (n_wait_semaphores > 0)
         {
-            in_opt_semaphore_to_wait_on_ptr_ptrs[n_wait_semaphore]->lock();
+            request_ptr->wait_semaphores_mgpu.assign(in_submit_info.get_wait_semaphores_mgpu(),
+                                                     in_submit_info.get_wait_semaphores_mgpu() + n_wait_semaphores);
         }
-        else
+    }
+    else
+    {
+        if (n_command_buffers > 0)
         {
-            in_opt_semaphore_to_wait_on_ptr_ptrs[n_wait_semaphore]->unlock();
+            request_ptr->command_buffer_ptrs.assign(in_submit_info.get_command_buffers_sgpu(),
+                                                    in_submit_info.get_command_buffers_sgpu() + n_command_buffers);
         }
-    }
 
-    if (in_opt_fence_ptr != nullptr)
-    {
-        if (in_should_lock)
+        if (n_signal_semaphores > 0)
         {
-            in_opt_fence_ptr->lock();
+            request_ptr->signal_semaphore_ptrs.assign(in_submit_info.get_signal_semaphores_sgpu(),
+                                                      in_submit_info.get_signal_semaphores_sgpu() + n_signal_semaphores);
         }
-        else
+
+        if (n_wait_semaphores > 0)
         {
-            in_opt_fence_ptr->unlock();
+            request_ptr->wait_semaphore_ptrs.assign(in_submit_info.get_wait_semaphores_sgpu(),
+                                                    in_submit_info.get_wait_semaphores_sgpu() + n_wait_semaphores);
         }
     }
-}
 
-void Anvil::Queue::submit_command_buffers_lock_unlock(uint32_t                           in_n_command_buffer_submissions,
-                                                      const CommandBufferMGPUSubmission* in_opt_command_buffer_submissions_ptr,
-                                                      uint32_t                           in_n_signal_semaphore_submissions,
-                                                      const SemaphoreMGPUSubmission*     in_opt_signal_semaphore_submissions_ptr,
-                                                      uint32_t                           in_n_wait_semaphore_submissions,
-                                                      const SemaphoreMGPUSubmission*     in_opt_wait_semaphore_submissions_ptr,
-                                                      Anvil::Fence*                      in_opt_fence_ptr,
-                                                      bool                               in_should_lock)
-{
-    if (in_should_lock)
-    {
-        lock();
-    }
-    else
+    if (n_wait_semaphores > 0)
     {
-        unlock();
+        request_ptr->wait_dst_stage_masks.assign(in_submit_info.get_destination_stage_wait_masks(),
+                                                 in_submit_info.get_destination_stage_wait_masks() + n_wait_semaphores);
     }
 
-    for (uint32_t n_command_buffer_submission = 0;
-                  n_command_buffer_submission < in_n_command_buffer_submissions;
-                ++n_command_buffer_submission)
+    #if defined(_WIN32)
     {
-        const auto& current_submission = in_opt_command_buffer_submissions_ptr[n_command_buffer_submission];
+        const uint64_t* d3d12_fence_signal_semaphore_values_ptr = nullptr;
+        const uint64_t* d3d12_fence_wait_semaphore_values_ptr   = nullptr;
 
-        if (current_submission.cmd_buffer_ptr != nullptr)
+        if (in_submit_info.get_d3d12_fence_semaphore_values(&d3d12_fence_signal_semaphore_values_ptr,
+                                                            &d3d12_fence_wait_semaphore_values_ptr) )
         {
-            if (in_should_lock)
+            if (d3d12_fence_signal_semaphore_values_ptr != nullptr)
             {
-                current_submission.cmd_buffer_ptr->lock();
+                request_ptr->d3d12_fence_signal_semaphore_values.assign(d3d12_fence_signal_semaphore_values_ptr,
+                                                                        d3d12_fence_signal_semaphore_values_ptr + n_signal_semaphores);
             }
-            else
+
+            if (d3d12_fence_wait_semaphore_values_ptr != nullptr)
             {
-                current_submission.cmd_buffer_ptr->unlock();
+                request_ptr->d3d12_fence_wait_semaphore_values.assign(d3d12_fence_wait_semaphore_values_ptr,
+                                                                      d3d12_fence_wait_semaphore_values_ptr + n_wait_semaphores);
             }
         }
     }
+    #endif
 
-    for (uint32_t n_signal_semaphore_submission = 0;
-                  n_signal_semaphore_submission < in_n_signal_semaphore_submissions;
-                ++n_signal_semaphore_submission)
-    {
-        if (in_should_lock)
-        {
-            in_opt_signal_semaphore_submissions_ptr[n_signal_semaphore_submission].semaphore_ptr->lock();
-        }
-        else
-        {
-            in_opt_signal_semaphore_submissions_ptr[n_signal_semaphore_submission].semaphore_ptr->unlock();
-        }
-    }
+    result              = ++m_n_last_issued_ticket;
+    request_ptr->ticket = result;
 
-    for (uint32_t n_wait_semaphore_submission = 0;
-                  n_wait_semaphore_submission < in_n_wait_semaphore_submissions;
-                ++n_wait_semaphore_submission)
+    push_posted_request(request_ptr);
+
+end:
+    return result;
+}
+
+/** Please see header for specification */
+void Anvil::Queue::process_posted_request(PostedRequest* in_request_ptr)
+{
+    switch (in_request_ptr->type)
+    {
+        case PostedRequestType::PRESENT:
+        {
+            const uint32_t n_wait_semaphores = static_cast<uint32_t>(in_request_ptr->wait_semaphore_ptrs.size() );
+            VkResult       result;
+
+            result = present(in_request_ptr->swapchain_ptr,
+                             in_request_ptr->swapchain_image_index,
+                             n_wait_semaphores,
+                             (n_wait_semaphores > 0) ? &in_request_ptr->wait_semaphore_ptrs.at(0) : nullptr);
+
+            if (in_request_ptr->present_result_ptr != nullptr)
+            {
+                *in_request_ptr->present_result_ptr = result;
+            }
+
+            break;
+        }
+
+        case PostedRequestType::SUBMIT:
+        {
+            const auto& request             = *in_request_ptr;
+            const bool  has_wait_semaphores = (request.wait_dst_stage_masks.size() > 0);
+            bool        result;
+
+            auto submit_info = (request.is_mgpu) ? Anvil::SubmitInfo::create_wait_execute_signal((request.command_buffers_mgpu.size()   > 0) ? &request.command_buffers_mgpu.at  (0) : nullptr,
+                                                                                                 static_cast<uint32_t>(request.command_buffers_mgpu.size  () ),
+                                                                                                 static_cast<uint32_t>(request.signal_semaphores_mgpu.size() ),
+                                                                                                 (request.signal_semaphores_mgpu.size() > 0) ? &request.signal_semaphores_mgpu.at(0) : nullptr,
+                                                                                                 static_cast<uint32_t>(request.wait_semaphores_mgpu.size  () ),
+                                                                                                 (request.wait_semaphores_mgpu.size()   > 0) ? &request.wait_semaphores_mgpu.at  (0) : nullptr,
+                                                                                                 (has_wait_semaphores)                       ? &request.wait_dst_stage_masks.at  (0) : nullptr,
+                                                                                                 false, /* in_should_block */
+                                                                                                 request.fence_ptr)
+                                                 : Anvil::SubmitInfo::create                    (static_cast<uint32_t>(request.command_buffer_ptrs.size() ),
+                                                                                                 (request.command_buffer_ptrs.size()    > 0) ? &request.command_buffer_ptrs.at   (0) : nullptr,
+                                                                                                 static_cast<uint32_t>(request.signal_semaphore_ptrs.size() ),
+                                                                                                 (request.signal_semaphore_ptrs.size()  > 0) ? &request.signal_semaphore_ptrs.at (0) : nullptr,
+                                                                                                 static_cast<uint32_t>(request.wait_semaphore_ptrs.size() ),
+                                                                                                 (request.wait_semaphore_ptrs.size()    > 0) ? &request.wait_semaphore_ptrs.at   (0) : nullptr,
+                                                                                                 (has_wait_semaphores)                       ? &request.wait_dst_stage_masks.at  (0) : nullptr,
+                                                                                                 false, /* in_should_block */
+                                                                                                 request.fence_ptr);
+
+            #if defined(_WIN32)
+            {
+                if (request.d3d12_fence_signal_semaphore_values.size() > 0 ||
+                    request.d3d12_fence_wait_semaphore_values.size  () > 0)
+                {
+                    submit_info.set_d3d12_fence_semaphore_values((request.d3d12_fence_signal_semaphore_values.size() > 0) ? &request.d3d12_fence_signal_semaphore_values.at(0) : nullptr,
+                                                                 static_cast<uint32_t>(request.d3d12_fence_signal_semaphore_values.size() ),
+                                                                 (request.d3d12_fence_wait_semaphore_values.size  () > 0) ? &request.d3d12_fence_wait_semaphore_values.at  (0) : nullptr,
+                                                                 static_cast<uint32_t>(request.d3d12_fence_wait_semaphore_values.size  () ));
+                }
+            }
+            #endif
+
+            result = submit(submit_info);
+
+            if (request.submit_result_ptr != nullptr)
+            {
+                *request.submit_result_ptr = result;
+            }
+
+            break;
+        }
+
+        default:
+        {
+            anvil_assert_fail();
+        }
+    }
+}
+
+/** Please see header for specification */
+void Anvil::Queue::push_posted_request(PostedRequest* in_request_ptr)
+{
+    PostedRequest* prev_request_ptr;
+
+    in_request_ptr->next_ptr.store(nullptr);
+
+    prev_request_ptr = m_posted_requests_head_ptr.exchange(in_request_ptr);
+
+    /* Until the following store completes, the consumer may not see the new request. If it goes to sleep in the
+     * meantime, m_submission_thread_sleeping is guaranteed to be visible below. */
+    prev_request_ptr->next_ptr.store(in_request_ptr);
+
+    if (m_submission_thread_sleeping.load() )
+    {
+        std::lock_guard<std::mutex> lock(m_submission_thread_mutex);
+
+        m_submission_thread_wake_cv.notify_one();
+    }
+}
+
+/** Returns a processed request to the free list. Only called by the submission thread. */
+void Anvil::Queue::release_posted_request(PostedRequest* in_request_ptr)
+{
+    PostedRequest* head_ptr = m_free_posted_requests_head_ptr.load();
+
+    do
+    {
+        in_request_ptr->next_ptr.store(head_ptr);
+    }
+    while (!m_free_posted_requests_head_ptr.compare_exchange_weak(head_ptr,
+                                                                  in_request_ptr) );
+}
+
+/** Please see header for specification */
+bool Anvil::Queue::set_submission_thread_enabled(bool in_enable)
+{
+    bool result = false;
+
+    if (in_enable == m_submission_thread_enabled)
+    {
+        result = true;
+
+        goto end;
+    }
+
+    if (in_enable)
+    {
+        /* lock() is a no-op for queues which are not MT-safe, so the worker would race with direct callers */
+        if (!is_mt_safe() )
+        {
+            anvil_assert(is_mt_safe() );
+
+            goto end;
+        }
+
+        m_submission_thread_stop_requested = false;
+        m_submission_thread                = std::thread(&Queue::submission_thread_main,
+                                                          this);
+        m_submission_thread_enabled        = true;
+    }
+    else
+    {
+        drain_submission_thread();
+
+        {
+            std::lock_guard<std::mutex> lock(m_submission_thread_mutex);
+
+            m_submission_thread_stop_requested = true;
+        }
+
+        m_submission_thread_wake_cv.notify_one();
+        m_submission_thread.join              ();
+
+        m_submission_thread_enabled = false;
+        m_submission_thread_id.store(std::thread::id() );
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+void Anvil::Queue::submission_thread_main()
+{
+    m_submission_thread_id.store(std::this_thread::get_id() );
+
+    while (true)
+    {
+        PostedRequest* request_ptr = pop_posted_request();
+
+        if (request_ptr != nullptr)
+        {
+            process_posted_request(request_ptr);
+            mark_ticket_processed (request_ptr->ticket);
+            release_posted_request(request_ptr);
+
+            continue;
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(m_submission_thread_mutex);
+
+            m_submission_thread_sleeping.store(true);
+            {
+                m_submission_thread_wake_cv.wait(lock,
+                                                 [this]()
+                                                 {
+                                                     return has_posted_requests() || m_submission_thread_stop_requested;
+                                                 });
+            }
+            m_submission_thread_sleeping.store(false);
+
+            if (m_submission_thread_stop_requested &&
+               !has_posted_requests() )
+            {
+                break;
+            }
+        }
+    }
+}
+
+/** Please see header for specification */
+void Anvil::Queue::enqueue_submission(const Anvil::SubmitInfo& in_submit_info)
+{
+    const uint32_t    n_signal_semaphores(in_submit_info.get_n_signal_semaphores() );
+    const uint32_t    n_wait_semaphores  (in_submit_info.get_n_wait_semaphores  () );
+    PendingSubmission new_submission;
+    auto&             pending            (m_pending_submissions);
+
+    new_submission.is_mgpu             = (in_submit_info.get_type() == SubmissionType::MGPU);
+    new_submission.n_command_buffers   = 0;
+    new_submission.n_signal_semaphores = n_signal_semaphores;
+    new_submission.n_wait_semaphores   = n_wait_semaphores;
+
+    switch (in_submit_info.get_type() )
+    {
+        case SubmissionType::MGPU:
+        {
+            for (uint32_t n_command_buffer_submission = 0;
+                          n_command_buffer_submission < in_submit_info.get_n_command_buffers();
+                        ++n_command_buffer_submission)
+            {
+                const auto& current_submission = in_submit_info.get_command_buffers_mgpu()[n_command_buffer_submission];
+
+                if (current_submission.cmd_buffer_ptr != nullptr)
+                {
+                    pending.command_buffer_device_masks.push_back(current_submission.device_mask);
+                    pending.command_buffer_ptrs.push_back        (current_submission.cmd_buffer_ptr);
+                    pending.command_buffers_vk.push_back         (current_submission.cmd_buffer_ptr->get_command_buffer() );
+
+                    ++new_submission.n_command_buffers;
+                }
+            }
+
+            for (uint32_t n_signal_semaphore_submission = 0;
+                          n_signal_semaphore_submission < n_signal_semaphores;
+                        ++n_signal_semaphore_submission)
+            {
+                const auto& current_submission = in_submit_info.get_signal_semaphores_mgpu()[n_signal_semaphore_submission];
+
+                pending.semaphore_ptrs.push_back                 (current_submission.semaphore_ptr);
+                pending.signal_semaphore_device_indices.push_back(current_submission.device_index);
+                pending.signal_semaphores_vk.push_back           (current_submission.semaphore_ptr->get_semaphore() );
+            }
+
+            for (uint32_t n_wait_semaphore_submission = 0;
+                          n_wait_semaphore_submission < n_wait_semaphores;
+                        ++n_wait_semaphore_submission)
+            {
+                const auto& current_submission = in_submit_info.get_wait_semaphores_mgpu()[n_wait_semaphore_submission];
+
+                pending.semaphore_ptrs.push_back               (current_submission.semaphore_ptr);
+                pending.wait_semaphore_device_indices.push_back(current_submission.device_index);
+                pending.wait_semaphores_vk.push_back           (current_submission.semaphore_ptr->get_semaphore() );
+            }
+
+            break;
+        }
+
+        case SubmissionType::SGPU:
+        {
+            for (uint32_t n_command_buffer = 0;
+                          n_command_buffer < in_submit_info.get_n_command_buffers();
+                        ++n_command_buffer)
+            {
+                auto cmd_buffer_ptr = in_submit_info.get_command_buffers_sgpu()[n_command_buffer];
+
+                pending.command_buffer_device_masks.push_back(1);
+                pending.command_buffer_ptrs.push_back        (cmd_buffer_ptr);
+                pending.command_buffers_vk.push_back         (cmd_buffer_ptr->get_command_buffer() );
+            }
+
+            for (uint32_t n_signal_semaphore = 0;
+                          n_signal_semaphore < n_signal_semaphores;
+                        ++n_signal_semaphore)
+            {
+                auto sem_ptr = in_submit_info.get_signal_semaphores_sgpu()[n_signal_semaphore];
+
+                pending.semaphore_ptrs.push_back                 (sem_ptr);
+                pending.signal_semaphore_device_indices.push_back(0);
+                pending.signal_semaphores_vk.push_back           (sem_ptr->get_semaphore() );
+            }
+
+            for (uint32_t n_wait_semaphore = 0;
+                          n_wait_semaphore < n_wait_semaphores;
+                        ++n_wait_semaphore)
+            {
+                auto sem_ptr = in_submit_info.get_wait_semaphores_sgpu()[n_wait_semaphore];
+
+                pending.semaphore_ptrs.push_back               (sem_ptr);
+                pending.wait_semaphore_device_indices.push_back(0);
+                pending.wait_semaphores_vk.push_back           (sem_ptr->get_semaphore() );
+            }
+
+            new_submission.n_command_buffers = in_submit_info.get_n_command_buffers();
+
+            break;
+        }
+
+        default:
+        {
+            anvil_assert_fail();
+        }
+    }
+
+    for (uint32_t n_wait_semaphore = 0;
+                  n_wait_semaphore < n_wait_semaphores;
+                ++n_wait_semaphore)
+    {
+        pending.wait_dst_stage_masks.push_back(in_submit_info.get_destination_stage_wait_masks()[n_wait_semaphore].get_vk() );
+    }
+
+    #if defined(_WIN32)
+    {
+        const uint64_t* d3d12_fence_signal_semaphore_values_ptr = nullptr;
+        const uint64_t* d3d12_fence_wait_semaphore_values_ptr   = nullptr;
+
+        new_submission.has_d3d12_fence_semaphore_values = in_submit_info.get_d3d12_fence_semaphore_values(&d3d12_fence_signal_semaphore_values_ptr,
+                                                                                                          &d3d12_fence_wait_semaphore_values_ptr);
+
+        if (new_submission.has_d3d12_fence_semaphore_values)
+        {
+            /* Both arrays are stored in full, so that values can be located with semaphore offsets at flush time */
+            for (uint32_t n_signal_semaphore = 0;
+                          n_signal_semaphore < n_signal_semaphores;
+                        ++n_signal_semaphore)
+            {
+                pending.d3d12_fence_signal_semaphore_values.push_back((d3d12_fence_signal_semaphore_values_ptr != nullptr) ? d3d12_fence_signal_semaphore_values_ptr[n_signal_semaphore]
+                                                                                                                            : 0);
+            }
+
+            for (uint32_t n_wait_semaphore = 0;
+                          n_wait_semaphore < n_wait_semaphores;
+                        ++n_wait_semaphore)
+            {
+                pending.d3d12_fence_wait_semaphore_values.push_back((d3d12_fence_wait_semaphore_values_ptr != nullptr) ? d3d12_fence_wait_semaphore_values_ptr[n_wait_semaphore]
+                                                                                                                        : 0);
+            }
+        }
+        else
+        {
+            pending.d3d12_fence_signal_semaphore_values.resize(pending.d3d12_fence_signal_semaphore_values.size() + n_signal_semaphores);
+            pending.d3d12_fence_wait_semaphore_values.resize  (pending.d3d12_fence_wait_semaphore_values.size  () + n_wait_semaphores);
+        }
+    }
+    #endif
+
+    pending.submissions.push_back(new_submission);
+}
+
+/** Please see header for specification */
+bool Anvil::Queue::flush(Anvil::Fence* in_opt_fence_ptr,
+                         bool          in_should_block,
+                         uint64_t      in_timeout)
+{
+    return submit_internal(0,       /* in_n_submit_infos   */
+                           nullptr, /* in_submit_infos_ptr */
+                           in_opt_fence_ptr,
+                           in_should_block,
+                           in_timeout);
+}
+
+/** Please see header for specification */
+bool Anvil::Queue::flush_pending_submissions(Anvil::Fence* in_opt_fence_ptr)
+{
+    auto&          pending      (m_pending_submissions);
+    const uint32_t n_submissions(static_cast<uint32_t>(pending.submissions.size() ));
+    VkResult       result       (VK_SUCCESS);
+
+    /* Nothing to do if there's no work to submit and no fence to signal */
+    if (n_submissions    == 0       &&
+        in_opt_fence_ptr == nullptr)
+    {
+        goto end;
+    }
+
+    /* Convert the accumulated submissions to Vulkan descriptors. Scratch arrays are sized up-front, so that
+     * pointers to their items stay valid while the chains are being built. */
+    {
+        uint32_t n_command_buffers_used    = 0;
+        uint32_t n_signal_semaphores_used  = 0;
+        uint32_t n_wait_semaphores_used    = 0;
+
+        pending.device_group_submit_infos_vk.resize(n_submissions);
+        pending.submit_infos_vk.resize             (n_submissions);
+
+        #if defined(_WIN32)
+        {
+            pending.d3d12_fence_submit_infos_vk.resize(n_submissions);
+        }
+        #endif
+
+        for (uint32_t n_submission = 0;
+                      n_submission < n_submissions;
+                    ++n_submission)
+        {
+            const auto& current_submission   = pending.submissions.at(n_submission);
+            auto&       device_group_info_vk = pending.device_group_submit_infos_vk.at(n_submission);
+            auto&       submit_info_vk       = pending.submit_infos_vk.at(n_submission);
+            const void* chain_ptr            = nullptr;
+
+            #if defined(_WIN32)
+            {
+                if (current_submission.has_d3d12_fence_semaphore_values)
+                {
+                    auto& fence_info_vk = pending.d3d12_fence_submit_infos_vk.at(n_submission);
+
+                    fence_info_vk.pNext                      = chain_ptr;
+                    fence_info_vk.pSignalSemaphoreValues     = (current_submission.n_signal_semaphores != 0) ? &pending.d3d12_fence_signal_semaphore_values.at(n_signal_semaphores_used) : nullptr;
+                    fence_info_vk.pWaitSemaphoreValues       = (current_submission.n_wait_semaphores   != 0) ? &pending.d3d12_fence_wait_semaphore_values.at  (n_wait_semaphores_used)   : nullptr;
+                    fence_info_vk.signalSemaphoreValuesCount = current_submission.n_signal_semaphores;
+                    fence_info_vk.sType                      = VK_STRUCTURE_TYPE_D3D12_FENCE_SUBMIT_INFO_KHR;
+                    fence_info_vk.waitSemaphoreValuesCount   = current_submission.n_wait_semaphores;
+
+                    chain_ptr = &fence_info_vk;
+                }
+            }
+            #endif
+
+            if (current_submission.is_mgpu)
+            {
+                device_group_info_vk.commandBufferCount            = current_submission.n_command_buffers;
+                device_group_info_vk.pCommandBufferDeviceMasks     = (current_submission.n_command_buffers   != 0) ? &pending.command_buffer_device_masks.at    (n_command_buffers_used)   : nullptr;
+                device_group_info_vk.pNext                         = chain_ptr;
+                device_group_info_vk.pSignalSemaphoreDeviceIndices = (current_submission.n_signal_semaphores != 0) ? &pending.signal_semaphore_device_indices.at(n_signal_semaphores_used) : nullptr;
+                device_group_info_vk.pWaitSemaphoreDeviceIndices   = (current_submission.n_wait_semaphores   != 0) ? &pending.wait_semaphore_device_indices.at  (n_wait_semaphores_used)   : nullptr;
+                device_group_info_vk.signalSemaphoreCount          = current_submission.n_signal_semaphores;
+                device_group_info_vk.sType                         = VK_STRUCTURE_TYPE_DEVICE_GROUP_SUBMIT_INFO_KHR;
+                device_group_info_vk.waitSemaphoreCount            = current_submission.n_wait_semaphores;
+
+                chain_ptr = &device_group_info_vk;
+            }
+
+            submit_info_vk.commandBufferCount   = current_submission.n_command_buffers;
+            submit_info_vk.pCommandBuffers      = (current_submission.n_command_buffers   != 0) ? &pending.command_buffers_vk.at  (n_command_buffers_used)   : nullptr;
+            submit_info_vk.pNext                = chain_ptr;
+            submit_info_vk.pSignalSemaphores    = (current_submission.n_signal_semaphores != 0) ? &pending.signal_semaphores_vk.at(n_signal_semaphores_used) : nullptr;
+            submit_info_vk.pWaitDstStageMask    = (current_submission.n_wait_semaphores   != 0) ? &pending.wait_dst_stage_masks.at(n_wait_semaphores_used)   : nullptr;
+            submit_info_vk.pWaitSemaphores      = (current_submission.n_wait_semaphores   != 0) ? &pending.wait_semaphores_vk.at  (n_wait_semaphores_used)   : nullptr;
+            submit_info_vk.signalSemaphoreCount = current_submission.n_signal_semaphores;
+            submit_info_vk.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+            submit_info_vk.waitSemaphoreCount   = current_submission.n_wait_semaphores;
+
+            n_command_buffers_used   += current_submission.n_command_buffers;
+            n_signal_semaphores_used += current_submission.n_signal_semaphores;
+            n_wait_semaphores_used   += current_submission.n_wait_semaphores;
+        }
+    }
+
+    /* Go for it */
+    lock_unlock_pending_submissions(in_opt_fence_ptr,
+                                    true); /* in_should_lock */
+    {
+        result = Anvil::Vulkan::vkQueueSubmit(m_queue,
+                                              n_submissions,
+                                              (n_submissions    != 0)       ? &pending.submit_infos_vk.at(0) : nullptr,
+                                              (in_opt_fence_ptr != nullptr) ? in_opt_fence_ptr->get_fence()
+                                                                            : VK_NULL_HANDLE);
+
+        anvil_assert_vk_call_succeeded(result);
+    }
+    lock_unlock_pending_submissions(in_opt_fence_ptr,
+                                    false); /* in_should_lock */
+
+    pending.clear();
+
+end:
+    return (result == VK_SUCCESS);
+}
+
+/** Please see header for specification */
+void Anvil::Queue::lock_unlock_pending_submissions(Anvil::Fence* in_opt_fence_ptr,
+                                                   bool          in_should_lock)
+{
+    for (auto cmd_buffer_ptr : m_pending_submissions.command_buffer_ptrs)
+    {
+        if (in_should_lock)
+        {
+            cmd_buffer_ptr->lock();
+        }
+        else
+        {
+            cmd_buffer_ptr->unlock();
+        }
+    }
+
+    for (auto semaphore_ptr : m_pending_submissions.semaphore_ptrs)
     {
         if (in_should_lock)
         {
-            in_opt_wait_semaphore_submissions_ptr[n_wait_semaphore_submission].semaphore_ptr->lock();
+            semaphore_ptr->lock();
         }
         else
         {
-            in_opt_wait_semaphore_submissions_ptr[n_wait_semaphore_submission].semaphore_ptr->unlock();
+            semaphore_ptr->unlock();
         }
     }
 
@@ -1473,10 +1757,261 @@ void Anvil::Queue::submit_command_buffers_lock_unlock(uint32_t
     }
 }
 
+/** Please see header for specification */
+void Anvil::Queue::PendingSubmissions::clear()
+{
+    command_buffer_ptrs.clear            ();
+    command_buffer_device_masks.clear    ();
+    command_buffers_vk.clear             ();
+    semaphore_ptrs.clear                 ();
+    signal_semaphore_device_indices.clear();
+    signal_semaphores_vk.clear           ();
+    submissions.clear                    ();
+    wait_dst_stage_masks.clear           ();
+    wait_semaphore_device_indices.clear  ();
+    wait_semaphores_vk.clear             ();
+
+    #if defined(_WIN32)
+    {
+        d3d12_fence_signal_semaphore_values.clear();
+        d3d12_fence_wait_semaphore_values.clear  ();
+    }
+    #endif
+}
+
+/** Please see header for specification */
+void Anvil::Queue::PostedRequest::reset(PostedRequestType in_type)
+{
+    next_ptr.store(nullptr);
+
+    fence_ptr             = nullptr;
+    is_mgpu               = false;
+    present_result_ptr    = nullptr;
+    submit_result_ptr     = nullptr;
+    swapchain_image_index = 0;
+    swapchain_ptr         = nullptr;
+    ticket                = 0;
+    type                  = in_type;
+
+    command_buffer_ptrs.clear   ();
+    command_buffers_mgpu.clear  ();
+    signal_semaphore_ptrs.clear ();
+    signal_semaphores_mgpu.clear();
+    wait_dst_stage_masks.clear  ();
+    wait_semaphore_ptrs.clear   ();
+    wait_semaphores_mgpu.clear  ();
+
+    #if defined(_WIN32)
+    {
+        d3d12_fence_signal_semaphore_values.clear();
+        d3d12_fence_wait_semaphore_values.clear  ();
+    }
+    #endif
+}
+
+/** Please see header for specification */
+void Anvil::Queue::set_submission_deferral(bool in_enable)
+{
+    drain_submission_thread();
+
+    lock();
+    {
+        if (m_submission_deferral_enabled && !in_enable)
+        {
+            flush_pending_submissions(nullptr); /* in_opt_fence_ptr */
+        }
+
+        m_submission_deferral_enabled = in_enable;
+    }
+    unlock();
+}
+
+/** Please see header for specification */
+bool Anvil::Queue::submit(const Anvil::SubmitInfo& in_submit_info)
+{
+    bool result = true;
+
+    drain_submission_thread();
+
+    if (m_submission_deferral_enabled                 &&
+        in_submit_info.get_fence       () == nullptr  &&
+       !in_submit_info.get_should_block()             )
+    {
+        lock();
+        {
+            enqueue_submission(in_submit_info);
+
+            /* Another thread may have disabled deferral before the lock was taken */
+            if (!m_submission_deferral_enabled)
+            {
+                result = flush_pending_submissions(nullptr); /* in_opt_fence_ptr */
+            }
+        }
+        unlock();
+    }
+    else
+    {
+        result = submit_internal(1, /* in_n_submit_infos */
+                                &in_submit_info,
+                                 in_submit_info.get_fence       (),
+                                 in_submit_info.get_should_block(),
+                                 in_submit_info.get_timeout     () );
+    }
+
+    return result;
+}
+
+/** Please see header for specification */
+bool Anvil::Queue::submit(uint32_t                 in_n_submit_infos,
+                          const Anvil::SubmitInfo* in_submit_infos_ptr,
+                          Anvil::Fence*            in_opt_fence_ptr,
+                          bool                     in_should_block,
+                          uint64_t                 in_timeout)
+{
+    anvil_assert(in_n_submit_infos == 0 || in_submit_infos_ptr != nullptr);
+
+    for (uint32_t n_submit_info = 0;
+                  n_submit_info < in_n_submit_infos;
+                ++n_submit_info)
+    {
+        /* Fences and blocking can only be requested for the whole batch */
+        anvil_assert(in_submit_infos_ptr[n_submit_info].get_fence       () == nullptr);
+        anvil_assert(in_submit_infos_ptr[n_submit_info].get_should_block() == false);
+    }
+
+    return submit_internal(in_n_submit_infos,
+                           in_submit_infos_ptr,
+                           in_opt_fence_ptr,
+                           in_should_block,
+                           in_timeout);
+}
+
+/** Please see header for specification */
+Anvil::FenceUniquePtr Anvil::Queue::submit_async(const Anvil::SubmitInfo& in_submit_info)
+{
+    Anvil::FenceUniquePtr fence_ptr(m_device_ptr->get_fence_pool()->acquire() );
+
+    anvil_assert(in_submit_info.get_fence       () == nullptr);
+    anvil_assert(in_submit_info.get_should_block() == false);
+
+    if (fence_ptr == nullptr)
+    {
+        anvil_assert(fence_ptr != nullptr);
+
+        goto end;
+    }
+
+    if (!submit_internal(1, /* in_n_submit_infos */
+                        &in_submit_info,
+                         fence_ptr.get(),
+                         false, /* in_should_block */
+                         UINT64_MAX) )
+    {
+        m_device_ptr->get_fence_pool()->release(std::move(fence_ptr),
+                                                false); /* in_was_submitted */
+    }
+
+end:
+    return fence_ptr;
+}
+
+/** Please see header for specification */
+bool Anvil::Queue::submit_internal(uint32_t                 in_n_submit_infos,
+                                   const Anvil::SubmitInfo* in_submit_infos_ptr,
+                                   Anvil::Fence*            in_opt_fence_ptr,
+                                   bool                     in_should_block,
+                                   uint64_t                 in_timeout)
+{
+    Anvil::Fence*         fence_ptr       (in_opt_fence_ptr);
+    Anvil::FenceUniquePtr pooled_fence_ptr;
+    bool                  result;
+
+    drain_submission_thread();
+
+    /* Blocking submissions, for which no fence has been specified, use a fence taken from the device's pool.
+     * This lets multiple threads wait on their submissions independently of each other. */
+    if (in_should_block       &&
+        fence_ptr == nullptr)
+    {
+        pooled_fence_ptr = m_device_ptr->get_fence_pool()->acquire();
+        fence_ptr        = pooled_fence_ptr.get();
+
+        if (fence_ptr == nullptr)
+        {
+            anvil_assert(fence_ptr != nullptr);
+
+            result = false;
+            goto end;
+        }
+    }
+
+    lock();
+    {
+        for (uint32_t n_submit_info = 0;
+                      n_submit_info < in_n_submit_infos;
+                    ++n_submit_info)
+        {
+            enqueue_submission(in_submit_infos_ptr[n_submit_info]);
+        }
+
+        result = flush_pending_submissions(fence_ptr);
+    }
+    unlock();
+
+    if (!result                    &&
+        pooled_fence_ptr != nullptr)
+    {
+        m_device_ptr->get_fence_pool()->release(std::move(pooled_fence_ptr),
+                                                false); /* in_was_submitted */
+    }
+
+    /* Wait till the submitted work finishes GPU-side. The queue is not locked at this point, so other threads
+     * can keep submitting work while this one waits. */
+    if (result          &&
+        in_should_block)
+    {
+        result = fence_ptr->wait(in_timeout);
+    }
+
+end:
+    return result;
+}
+
+/** Please see header for specification */
+void Anvil::Queue::wait_for_ticket(SubmissionTicket in_ticket)
+{
+    if (is_ticket_processed(in_ticket) )
+    {
+        goto end;
+    }
+
+    anvil_assert(std::this_thread::get_id() != m_submission_thread_id.load() );
+
+    ++m_n_ticket_waiters;
+    {
+        std::unique_lock<std::mutex> lock(m_ticket_processed_mutex);
+
+        m_ticket_processed_cv.wait(lock,
+                                   [this, in_ticket]()
+                                   {
+                                       return m_n_last_processed_ticket.load() >= in_ticket;
+                                   });
+    }
+    --m_n_ticket_waiters;
+
+end:
+    ;
+}
+
+/** Please see header for specification */
 void Anvil::Queue::wait_idle()
 {
+    drain_submission_thread();
+
     lock();
     {
+        flush_pending_submissions(nullptr); /* in_opt_fence_ptr */
+
         Anvil::Vulkan::vkQueueWaitIdle(m_queue);
     }
     unlock();